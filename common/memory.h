@@ -61,6 +61,14 @@ extern "C" {
 #define memory_allocate_structure_as_value( type ) \
 	(intptr_t *) memory_allocate( sizeof( type ) )
 
+/* Aligned memory allocation
+ * Returns 0 if successful, the buffer is freed with memory_free
+ */
+#if !defined( HAVE_GLIB_H ) && !defined( WINAPI ) && defined( HAVE_POSIX_MEMALIGN )
+#define memory_allocate_aligned( buffer, size, alignment ) \
+	posix_memalign( buffer, alignment, size )
+#endif
+
 /* Memory reallocation
  */
 #if defined( HAVE_GLIB_H )
@@ -512,6 +512,7 @@ int device_handle_open_smdev_input(
      libcerror_error_t **error )
 {
 	static char *function = "device_handle_open_smdev_input";
+	int access_flags      = LIBSMDEV_OPEN_READ;
 
 	if( device_handle == NULL )
 	{
@@ -570,17 +571,21 @@ int device_handle_open_smdev_input(
 
 		goto on_error;
 	}
+	if( device_handle->use_direct_io != 0 )
+	{
+		access_flags |= LIBSMDEV_ACCESS_FLAG_DIRECT_IO;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libsmdev_handle_open_wide(
 	     device_handle->smdev_input_handle,
 	     filenames[ 0 ],
-	     LIBSMDEV_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #else
 	if( libsmdev_handle_open(
 	     device_handle->smdev_input_handle,
 	     filenames[ 0 ],
-	     LIBSMDEV_OPEN_READ,
+	     access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -111,6 +111,10 @@ struct device_handle
 	 */
 	uint8_t zero_buffer_on_error;
 
+	/* Value to indicate the device should be read using direct IO
+	 */
+	uint8_t use_direct_io;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
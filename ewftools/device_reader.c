@@ -0,0 +1,609 @@
+/*
+ * Device reader that reads the input of a device handle in a separate thread
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "device_handle.h"
+#include "device_reader.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a device reader
+ * Make sure the value device_reader is referencing, is set to NULL
+ * The device reader reads into buffers grabbed from the storage media buffer queue
+ * and keeps up to the maximum number of read buffers ahead of the consumer
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_initialize(
+     device_reader_t **device_reader,
+     device_handle_t *device_handle,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_read_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_initialize";
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *device_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_read_buffers <= 0 )
+	 || ( maximum_number_of_read_buffers > (int) ( INT_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of read buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*device_reader = memory_allocate_structure(
+	                  device_reader_t );
+
+	if( *device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create device reader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *device_reader,
+	     0,
+	     sizeof( device_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear device reader.",
+		 function );
+
+		memory_free(
+		 *device_reader );
+
+		*device_reader = NULL;
+
+		return( -1 );
+	}
+	/* Add 1 for the end of input marker
+	 */
+	if( libcthreads_queue_initialize(
+	     &( ( *device_reader )->read_queue ),
+	     maximum_number_of_read_buffers + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read queue.",
+		 function );
+
+		goto on_error;
+	}
+	( *device_reader )->device_handle              = device_handle;
+	( *device_reader )->storage_media_buffer_queue = storage_media_buffer_queue;
+
+	return( 1 );
+
+on_error:
+	if( *device_reader != NULL )
+	{
+		memory_free(
+		 *device_reader );
+
+		*device_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a device reader
+ * If the reader thread is still running it is stopped and the buffers
+ * that were read but not consumed are released onto the storage media buffer queue
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_free(
+     device_reader_t **device_reader,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "device_reader_free";
+	int result                                   = 1;
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *device_reader != NULL )
+	{
+		if( ( *device_reader )->thread != NULL )
+		{
+			( *device_reader )->abort = 1;
+
+			/* Drain the read queue so that a reader thread blocked on a full
+			 * read queue can reach the end of input marker
+			 */
+			while( ( *device_reader )->end_of_input == 0 )
+			{
+				if( libcthreads_queue_pop(
+				     ( *device_reader )->read_queue,
+				     (intptr_t **) &storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+					 "%s: unable to pop storage media buffer from read queue.",
+					 function );
+
+					result = -1;
+
+					break;
+				}
+				if( (intptr_t *) storage_media_buffer == (intptr_t *) *device_reader )
+				{
+					( *device_reader )->end_of_input = 1;
+				}
+				else if( storage_media_buffer_queue_release_buffer(
+				          ( *device_reader )->storage_media_buffer_queue,
+				          storage_media_buffer,
+				          error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release storage media buffer onto queue.",
+					 function );
+
+					result = -1;
+				}
+				storage_media_buffer = NULL;
+			}
+			/* The thread cannot be joined if the end of input marker was not reached
+			 * since it might remain blocked on the read queue
+			 */
+			if( ( *device_reader )->end_of_input != 0 )
+			{
+				/* A failed read is not reported after an abort
+				 */
+				libcthreads_thread_join(
+				 &( ( *device_reader )->thread ),
+				 NULL );
+			}
+			/* Do not free the read queue while the reader thread might still use it
+			 */
+			if( ( *device_reader )->thread != NULL )
+			{
+				return( -1 );
+			}
+		}
+		if( ( *device_reader )->read_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( ( *device_reader )->read_queue ),
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *device_reader )->error != NULL )
+		{
+			libcerror_error_free(
+			 &( ( *device_reader )->error ) );
+		}
+		memory_free(
+		 *device_reader );
+
+		*device_reader = NULL;
+	}
+	return( result );
+}
+
+/* Starts the reader thread
+ * The device handle is expected to be positioned at the storage media offset
+ * and should not be used by any other thread until the end of input was read
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_start(
+     device_reader_t *device_reader,
+     off64_t storage_media_offset,
+     size64_t read_size,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "device_reader_start";
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( device_reader->thread != NULL )
+	 || ( device_reader->end_of_input != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device reader - already started.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid storage media offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	device_reader->storage_media_offset = storage_media_offset;
+	device_reader->remaining_read_size  = read_size;
+	device_reader->buffer_size          = buffer_size;
+
+	if( libcthreads_thread_create(
+	     &( device_reader->thread ),
+	     NULL,
+	     (int (*)(void *)) &device_reader_thread_callback,
+	     (void *) device_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reader thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the next storage media buffer that was read by the reader thread
+ * The buffers are returned in order of their storage media offset
+ * Returns the number of bytes read, 0 when no more data is available or -1 on error
+ */
+ssize_t device_reader_read_storage_media_buffer(
+         device_reader_t *device_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error )
+{
+	storage_media_buffer_t *safe_storage_media_buffer = NULL;
+	static char *function                             = "device_reader_read_storage_media_buffer";
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_reader->end_of_input != 0 )
+	{
+		return( 0 );
+	}
+	if( libcthreads_queue_pop(
+	     device_reader->read_queue,
+	     (intptr_t **) &safe_storage_media_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop storage media buffer from read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( (intptr_t *) safe_storage_media_buffer != (intptr_t *) device_reader )
+	{
+		*storage_media_buffer = safe_storage_media_buffer;
+
+		return( (ssize_t) safe_storage_media_buffer->raw_buffer_data_size );
+	}
+	device_reader->end_of_input = 1;
+
+	/* Pass the error of the reader thread on to the caller
+	 */
+	if( device_reader->error != NULL )
+	{
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error = device_reader->error;
+
+			device_reader->error = NULL;
+		}
+	}
+	if( libcthreads_thread_join(
+	     &( device_reader->thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read storage media buffer in reader thread.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Reads the input of the device handle into buffers and pushes them onto the read queue
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_read_input(
+     device_reader_t *device_reader,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "device_reader_read_input";
+	size_t read_size                             = 0;
+	ssize_t read_count                           = 0;
+
+	if( device_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device reader.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( device_reader->remaining_read_size > 0 )
+	    && ( device_reader->abort == 0 ) )
+	{
+		if( storage_media_buffer_queue_grab_buffer(
+		     device_reader->storage_media_buffer_queue,
+		     &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer from queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		read_size = device_reader->buffer_size;
+
+		if( device_reader->remaining_read_size < (size64_t) read_size )
+		{
+			read_size = (size_t) device_reader->remaining_read_size;
+		}
+		read_count = device_handle_read_storage_media_buffer(
+			      device_reader->device_handle,
+			      storage_media_buffer,
+			      device_reader->storage_media_offset,
+			      read_size,
+			      error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: error reading data from input.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of input.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     device_reader->read_queue,
+		     (intptr_t *) storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto read queue.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+
+		device_reader->storage_media_offset += read_count;
+		device_reader->remaining_read_size  -= read_count;
+	}
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 device_reader->storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Callback function for the reader thread
+ * Returns 1 if successful or -1 on error
+ */
+int device_reader_thread_callback(
+     device_reader_t *device_reader )
+{
+	int result = 0;
+
+	if( device_reader == NULL )
+	{
+		return( -1 );
+	}
+	result = device_reader_read_input(
+	          device_reader,
+	          &( device_reader->error ) );
+
+	/* The device reader itself is used as the end of input marker
+	 * since the read queue does not allow NULL values
+	 */
+	if( libcthreads_queue_push(
+	     device_reader->read_queue,
+	     (intptr_t *) device_reader,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,123 @@
+/*
+ * Device reader that reads the input of a device handle in a separate thread
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DEVICE_READER_H )
+#define _DEVICE_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "device_handle.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct device_reader device_reader_t;
+
+struct device_reader
+{
+	/* The device handle
+	 */
+	device_handle_t *device_handle;
+
+	/* The storage media buffer queue the buffers are grabbed from
+	 */
+	libcthreads_queue_t *storage_media_buffer_queue;
+
+	/* The read queue that contains the buffers that were read
+	 * in order of their storage media offset
+	 */
+	libcthreads_queue_t *read_queue;
+
+	/* The reader thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The storage media offset of the next read
+	 */
+	off64_t storage_media_offset;
+
+	/* The size of the storage media that remains to be read
+	 */
+	size64_t remaining_read_size;
+
+	/* The size of the buffer of a single read
+	 */
+	size_t buffer_size;
+
+	/* The error of the reader thread
+	 */
+	libcerror_error_t *error;
+
+	/* Value to indicate the reader thread pushed the end of input marker
+	 * onto the read queue and the marker was popped
+	 */
+	uint8_t end_of_input;
+
+	/* Value to indicate the reader thread should stop
+	 */
+	uint8_t abort;
+};
+
+int device_reader_initialize(
+     device_reader_t **device_reader,
+     device_handle_t *device_handle,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     int maximum_number_of_read_buffers,
+     libcerror_error_t **error );
+
+int device_reader_free(
+     device_reader_t **device_reader,
+     libcerror_error_t **error );
+
+int device_reader_start(
+     device_reader_t *device_reader,
+     off64_t storage_media_offset,
+     size64_t read_size,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+ssize_t device_reader_read_storage_media_buffer(
+         device_reader_t *device_reader,
+         storage_media_buffer_t **storage_media_buffer,
+         libcerror_error_t **error );
+
+int device_reader_read_input(
+     device_reader_t *device_reader,
+     libcerror_error_t **error );
+
+int device_reader_thread_callback(
+     device_reader_t *device_reader );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DEVICE_READER_H ) */
+
@@ -0,0 +1,1126 @@
+/*
+ * Digest context that calculates multiple digest hashes in a single pass
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_context.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+/* Creates a digest context
+ * Make sure the value digest_context is referencing, is set to NULL
+ * If the number of threads is not 0 and more than one digest hash is calculated
+ * the digest hashes are calculated concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_initialize(
+     digest_context_t **digest_context,
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_initialize";
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int thread_index      = 0;
+#endif
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_context = memory_allocate_structure(
+	                   digest_context_t );
+
+	if( *digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_context,
+	     0,
+	     sizeof( digest_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest context.",
+		 function );
+
+		memory_free(
+		 *digest_context );
+
+		*digest_context = NULL;
+
+		return( -1 );
+	}
+	if( calculate_md5 != 0 )
+	{
+		if( libhmac_md5_initialize(
+		     &( ( *digest_context )->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_context )->hash_types[ ( *digest_context )->number_of_hash_types++ ] = DIGEST_CONTEXT_HASH_TYPE_MD5;
+	}
+	if( calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_initialize(
+		     &( ( *digest_context )->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_context )->hash_types[ ( *digest_context )->number_of_hash_types++ ] = DIGEST_CONTEXT_HASH_TYPE_SHA1;
+	}
+	if( calculate_sha256 != 0 )
+	{
+		if( libhmac_sha256_initialize(
+		     &( ( *digest_context )->sha256_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_context )->hash_types[ ( *digest_context )->number_of_hash_types++ ] = DIGEST_CONTEXT_HASH_TYPE_SHA256;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( number_of_threads > 0 )
+	 && ( ( *digest_context )->number_of_hash_types > 1 ) )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( ( *digest_context )->condition_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create condition mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( ( *digest_context )->update_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create update condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( ( *digest_context )->updated_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create updated condition.",
+			 function );
+
+			goto on_error;
+		}
+		/* The thread that calls digest_context_update calculates one of the digest hashes
+		 */
+		for( thread_index = 0;
+		     thread_index < ( *digest_context )->number_of_hash_types - 1;
+		     thread_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( ( *digest_context )->threads[ thread_index ] ),
+			     NULL,
+			     (int (*)(void *)) &digest_context_thread_callback,
+			     (void *) *digest_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 thread_index );
+
+				goto on_error;
+			}
+			( *digest_context )->number_of_threads += 1;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+
+on_error:
+	if( *digest_context != NULL )
+	{
+		digest_context_free(
+		 digest_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_free(
+     digest_context_t **digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_free";
+	int result            = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int thread_index      = 0;
+#endif
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_context != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *digest_context )->number_of_threads > 0 )
+		{
+			if( libcthreads_mutex_grab(
+			     ( *digest_context )->condition_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab condition mutex.",
+				 function );
+
+				return( -1 );
+			}
+			( *digest_context )->abort = 1;
+
+			if( libcthreads_condition_broadcast(
+			     ( *digest_context )->update_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast update condition.",
+				 function );
+
+				result = -1;
+			}
+			if( libcthreads_mutex_release(
+			     ( *digest_context )->condition_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release condition mutex.",
+				 function );
+
+				return( -1 );
+			}
+			for( thread_index = 0;
+			     thread_index < ( *digest_context )->number_of_threads;
+			     thread_index++ )
+			{
+				if( libcthreads_thread_join(
+				     &( ( *digest_context )->threads[ thread_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join thread: %d.",
+					 function,
+					 thread_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( ( *digest_context )->updated_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *digest_context )->updated_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free updated condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_context )->update_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *digest_context )->update_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free update condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_context )->condition_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *digest_context )->condition_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+		if( ( *digest_context )->md5_context != NULL )
+		{
+			if( libhmac_md5_free(
+			     &( ( *digest_context )->md5_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free MD5 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_context )->sha1_context != NULL )
+		{
+			if( libhmac_sha1_free(
+			     &( ( *digest_context )->sha1_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA1 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_context )->sha256_context != NULL )
+		{
+			if( libhmac_sha256_free(
+			     &( ( *digest_context )->sha256_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free SHA256 context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *digest_context );
+
+		*digest_context = NULL;
+	}
+	return( result );
+}
+
+/* Updates a specific digest hash
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_update_hash(
+     digest_context_t *digest_context,
+     int hash_type,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_update_hash";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	switch( hash_type )
+	{
+		case DIGEST_CONTEXT_HASH_TYPE_MD5:
+			if( libhmac_md5_update(
+			     digest_context->md5_context,
+			     buffer,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update MD5 digest hash.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case DIGEST_CONTEXT_HASH_TYPE_SHA1:
+			if( libhmac_sha1_update(
+			     digest_context->sha1_context,
+			     buffer,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update SHA1 digest hash.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case DIGEST_CONTEXT_HASH_TYPE_SHA256:
+			if( libhmac_sha256_update(
+			     digest_context->sha256_context,
+			     buffer,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update SHA256 digest hash.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported hash type.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Updates the digest hashes
+ * Without threads the buffer is passed to every digest hash in turn
+ * in blocks of DIGEST_CONTEXT_BLOCK_SIZE, so that the buffer is
+ * streamed through the CPU cache only once
+ * With threads every digest hash is updated with the entire buffer
+ * by a different thread
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_update(
+     digest_context_t *digest_context,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_update";
+	size_t block_size     = 0;
+	size_t buffer_offset  = 0;
+	int hash_type_index   = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcerror_error_t *local_error = NULL;
+	int result                     = 0;
+#endif
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( digest_context->number_of_threads > 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     digest_context->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		digest_context->buffer                       = buffer;
+		digest_context->buffer_size                  = buffer_size;
+		digest_context->next_hash_type_index         = 0;
+		digest_context->number_of_updated_hash_types = 0;
+		digest_context->update_result                = 1;
+		digest_context->number_of_updates           += 1;
+
+		if( libcthreads_condition_broadcast(
+		     digest_context->update_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast update condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 digest_context->condition_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+		if( libcthreads_mutex_release(
+		     digest_context->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* The calling thread updates the digest hashes that have not
+		 * been claimed by the other threads
+		 */
+		do
+		{
+			result = digest_context_update_next_hash(
+			          digest_context,
+			          &local_error );
+		}
+		while( result == 1 );
+
+		if( local_error != NULL )
+		{
+			libcerror_error_free(
+			 &local_error );
+		}
+		/* The buffer is in use until all the digest hashes were updated
+		 */
+		if( libcthreads_mutex_grab(
+		     digest_context->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( digest_context->number_of_updated_hash_types < digest_context->number_of_hash_types )
+		{
+			if( libcthreads_condition_wait(
+			     digest_context->updated_condition,
+			     digest_context->condition_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for updated condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 digest_context->condition_mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		result = digest_context->update_result;
+
+		digest_context->buffer      = NULL;
+		digest_context->buffer_size = 0;
+
+		if( libcthreads_mutex_release(
+		     digest_context->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash(es).",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	while( buffer_offset < buffer_size )
+	{
+		block_size = buffer_size - buffer_offset;
+
+		if( block_size > DIGEST_CONTEXT_BLOCK_SIZE )
+		{
+			block_size = DIGEST_CONTEXT_BLOCK_SIZE;
+		}
+		for( hash_type_index = 0;
+		     hash_type_index < digest_context->number_of_hash_types;
+		     hash_type_index++ )
+		{
+			if( digest_context_update_hash(
+			     digest_context,
+			     digest_context->hash_types[ hash_type_index ],
+			     &( buffer[ buffer_offset ] ),
+			     block_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update digest hash.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset += block_size;
+	}
+	return( 1 );
+}
+
+/* Finalizes the digest hashes
+ * The hash buffers of the digest hashes that are not calculated are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_finalize(
+     digest_context_t *digest_context,
+     uint8_t *md5_hash,
+     size_t md5_hash_size,
+     uint8_t *sha1_hash,
+     size_t sha1_hash_size,
+     uint8_t *sha256_hash,
+     size_t sha256_hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_finalize";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context->md5_context != NULL )
+	{
+		if( libhmac_md5_finalize(
+		     digest_context->md5_context,
+		     md5_hash,
+		     md5_hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->sha1_context != NULL )
+	{
+		if( libhmac_sha1_finalize(
+		     digest_context->sha1_context,
+		     sha1_hash,
+		     sha1_hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( digest_context->sha256_context != NULL )
+	{
+		if( libhmac_sha256_finalize(
+		     digest_context->sha256_context,
+		     sha256_hash,
+		     sha256_hash_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Updates the next digest hash that has not been claimed by another thread
+ * with the buffer of the current update
+ * Returns 1 if successful, 0 if no digest hash remains or -1 on error
+ */
+int digest_context_update_next_hash(
+     digest_context_t *digest_context,
+     libcerror_error_t **error )
+{
+	const uint8_t *buffer = NULL;
+	static char *function = "digest_context_update_next_hash";
+	size_t buffer_size    = 0;
+	int hash_type         = -1;
+	int result            = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_context->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context->next_hash_type_index < digest_context->number_of_hash_types )
+	{
+		hash_type   = digest_context->hash_types[ digest_context->next_hash_type_index ];
+		buffer      = digest_context->buffer;
+		buffer_size = digest_context->buffer_size;
+
+		digest_context->next_hash_type_index += 1;
+	}
+	if( libcthreads_mutex_release(
+	     digest_context->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_type == -1 )
+	{
+		return( 0 );
+	}
+	result = digest_context_update_hash(
+	          digest_context,
+	          hash_type,
+	          buffer,
+	          buffer_size,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash.",
+		 function );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_context->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		digest_context->update_result = -1;
+	}
+	digest_context->number_of_updated_hash_types += 1;
+
+	if( digest_context->number_of_updated_hash_types == digest_context->number_of_hash_types )
+	{
+		if( libcthreads_condition_broadcast(
+		     digest_context->updated_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast updated condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     digest_context->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Updates the digest hashes for every update until the digest context is freed
+ * Callback function for the digest context threads
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_thread_callback(
+     digest_context_t *digest_context )
+{
+	libcerror_error_t *error   = NULL;
+	static char *function      = "digest_context_thread_callback";
+	uint64_t number_of_updates = 0;
+	int result                 = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_grab(
+	     digest_context->condition_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( digest_context->abort == 0 )
+	{
+		if( digest_context->number_of_updates == number_of_updates )
+		{
+			if( libcthreads_condition_wait(
+			     digest_context->update_condition,
+			     digest_context->condition_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for update condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 digest_context->condition_mutex,
+				 NULL );
+
+				goto on_error;
+			}
+			continue;
+		}
+		number_of_updates = digest_context->number_of_updates;
+
+		if( libcthreads_mutex_release(
+		     digest_context->condition_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			goto on_error;
+		}
+		do
+		{
+			result = digest_context_update_next_hash(
+			          digest_context,
+			          &error );
+		}
+		while( result == 1 );
+
+		/* A failed update is reported by digest_context_update
+		 */
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     digest_context->condition_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     digest_context->condition_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
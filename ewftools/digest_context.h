@@ -0,0 +1,176 @@
+/*
+ * Digest context that calculates multiple digest hashes in a single pass
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_CONTEXT_H )
+#define _DIGEST_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the blocks that are passed to every digest hash in turn
+ * so that the data remains in the CPU cache
+ */
+#define DIGEST_CONTEXT_BLOCK_SIZE		16384
+
+enum DIGEST_CONTEXT_HASH_TYPES
+{
+	DIGEST_CONTEXT_HASH_TYPE_MD5		= 0,
+	DIGEST_CONTEXT_HASH_TYPE_SHA1		= 1,
+	DIGEST_CONTEXT_HASH_TYPE_SHA256		= 2
+};
+
+typedef struct digest_context digest_context_t;
+
+struct digest_context
+{
+	/* The MD5 digest context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The SHA1 digest context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA256 digest context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The types of the digest hashes that are calculated
+	 */
+	int hash_types[ 3 ];
+
+	/* The number of digest hashes that are calculated
+	 */
+	int number_of_hash_types;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The threads that calculate the digest hashes together with
+	 * the thread that calls digest_context_update
+	 */
+	libcthreads_thread_t *threads[ 2 ];
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The update condition, signalled when there is data to hash
+	 */
+	libcthreads_condition_t *update_condition;
+
+	/* The updated condition, signalled when all digest hashes were updated
+	 */
+	libcthreads_condition_t *updated_condition;
+
+	/* The buffer of the current update
+	 */
+	const uint8_t *buffer;
+
+	/* The size of the buffer of the current update
+	 */
+	size_t buffer_size;
+
+	/* The number of updates
+	 */
+	uint64_t number_of_updates;
+
+	/* The index of the next hash type to update
+	 */
+	int next_hash_type_index;
+
+	/* The number of hash types that were updated
+	 */
+	int number_of_updated_hash_types;
+
+	/* The result of the current update
+	 */
+	int update_result;
+
+	/* Value to indicate the threads should stop
+	 */
+	uint8_t abort;
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+};
+
+int digest_context_initialize(
+     digest_context_t **digest_context,
+     uint8_t calculate_md5,
+     uint8_t calculate_sha1,
+     uint8_t calculate_sha256,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int digest_context_free(
+     digest_context_t **digest_context,
+     libcerror_error_t **error );
+
+int digest_context_update_hash(
+     digest_context_t *digest_context,
+     int hash_type,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int digest_context_update(
+     digest_context_t *digest_context,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int digest_context_finalize(
+     digest_context_t *digest_context,
+     uint8_t *md5_hash,
+     size_t md5_hash_size,
+     uint8_t *sha1_hash,
+     size_t sha1_hash_size,
+     uint8_t *sha256_hash,
+     size_t sha256_hash_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int digest_context_update_next_hash(
+     digest_context_t *digest_context,
+     libcerror_error_t **error );
+
+int digest_context_thread_callback(
+     digest_context_t *digest_context );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_CONTEXT_H ) */
+
@@ -36,6 +36,7 @@
 
 #include "byte_size_string.h"
 #include "device_handle.h"
+#include "device_reader.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_getopt.h"
@@ -52,6 +53,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder_ring.h"
 
 #if defined( __BORLANDC__ ) && ( __BORLANDC__ < 0x0560 )
 #define EWFACQUIRE_2_TIB			0x20000000000UL
@@ -127,7 +129,7 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -2 secondary_target ] [ -hOqRsuvVwx ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
@@ -169,6 +171,8 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     use direct IO to read the device and write the segment files\n"
+	                 "\t        (bypasses the system cache)\n" );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
@@ -605,6 +609,10 @@ int ewfacquire_read_input(
 	int read_error_iterator                      = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	device_reader_t *device_reader               = NULL;
+#endif
+
 	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
@@ -795,13 +803,14 @@ int ewfacquire_read_input(
 	{
 		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
 
-		if( libcthreads_thread_pool_create(
+		if( libcthreads_thread_pool_create_with_flags(
 		     &( imaging_handle->process_thread_pool ),
 		     NULL,
 		     imaging_handle->number_of_threads,
 		     maximum_number_of_queued_items,
 		     (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer_callback,
 		     (void *) imaging_handle,
+		     LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -813,50 +822,65 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
-		if( libcthreads_thread_pool_create(
-		     &( imaging_handle->output_thread_pool ),
-		     NULL,
-		     1,
+		if( storage_media_buffer_reorder_ring_initialize(
+		     &( imaging_handle->output_reorder_ring ),
 		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &imaging_handle_output_storage_media_buffer_callback,
-		     (void *) imaging_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize output thread pool.",
+			 "%s: unable to initialize output reorder ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( imaging_handle->output_list ),
+		if( storage_media_buffer_queue_initialize(
+		     &( imaging_handle->storage_media_buffer_queue ),
+		     imaging_handle->output_handle,
+		     maximum_number_of_queued_items,
+		     storage_media_buffer_mode,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to initialize storage media buffer queue.",
 			 function );
 
 			goto on_error;
 		}
-		if( storage_media_buffer_queue_initialize(
-		     &( imaging_handle->storage_media_buffer_queue ),
-		     imaging_handle->output_handle,
+		if( libcthreads_thread_create(
+		     &( imaging_handle->output_thread ),
+		     NULL,
+		     (int (*)(void *)) &imaging_handle_output_thread_callback,
+		     (void *) imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output thread.",
+			 function );
+
+			goto on_error;
+		}
+		if( device_reader_initialize(
+		     &device_reader,
+		     device_handle,
+		     imaging_handle->storage_media_buffer_queue,
 		     maximum_number_of_queued_items,
-		     storage_media_buffer_mode,
-		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize storage media buffer queue.",
+			 "%s: unable to initialize device reader.",
 			 function );
 
 			goto on_error;
@@ -935,8 +959,52 @@ int ewfacquire_read_input(
 			break;
 		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The device is read by the reader thread once the data to resume
+		 * has been read back from the output
+		 */
+		if( ( device_reader != NULL )
+		 && ( device_reader->thread == NULL )
+		 && ( device_reader->end_of_input == 0 )
+		 && ( imaging_handle->last_offset_written >= resume_acquiry_offset ) )
+		{
+			if( storage_media_buffer != NULL )
+			{
+				if( storage_media_buffer_queue_release_buffer(
+				     imaging_handle->storage_media_buffer_queue,
+				     storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release storage media buffer onto queue.",
+					 function );
+
+					goto on_error;
+				}
+				storage_media_buffer = NULL;
+			}
+			if( device_reader_start(
+			     device_reader,
+			     storage_media_offset,
+			     remaining_aquiry_size,
+			     process_buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to start device reader.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( ( storage_media_buffer == NULL )
-		 && ( imaging_handle->number_of_threads != 0 ) )
+		 && ( imaging_handle->number_of_threads != 0 )
+		 && ( imaging_handle->last_offset_written < resume_acquiry_offset ) )
 		{
 			if( storage_media_buffer_queue_grab_buffer(
 			     imaging_handle->storage_media_buffer_queue,
@@ -1042,6 +1110,40 @@ int ewfacquire_read_input(
 			storage_media_offset  += read_count;
 			remaining_aquiry_size -= read_count;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		else if( device_reader != NULL )
+		{
+			read_count = device_reader_read_storage_media_buffer(
+			              device_reader,
+			              &storage_media_buffer,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: error reading data from input.",
+				 function );
+
+				goto on_error;
+			}
+			if( read_count == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unexpected end of input.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_offset  += read_count;
+			remaining_aquiry_size -= read_count;
+		}
+#endif
 		else
 		{
 			read_count = device_handle_read_storage_media_buffer(
@@ -1152,6 +1254,20 @@ int ewfacquire_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		else if( imaging_handle->number_of_threads != 0 )
 		{
+			if( storage_media_buffer_reorder_ring_set_sequence_number(
+			     imaging_handle->output_reorder_ring,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sequence number of storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
 			if( libcthreads_thread_pool_push(
 			     imaging_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -1239,6 +1355,22 @@ int ewfacquire_read_input(
 		}
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_reader != NULL )
+	{
+		if( device_reader_free(
+		     &device_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free device reader.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( imaging_handle->process_thread_pool != NULL )
 	{
 		if( libcthreads_thread_pool_join(
@@ -1255,47 +1387,50 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_thread_pool != NULL )
+	if( imaging_handle->output_reorder_ring != NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->output_thread_pool ),
+		if( storage_media_buffer_reorder_ring_close(
+		     imaging_handle->output_reorder_ring,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 "%s: unable to close output reorder ring.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_thread != NULL )
 	{
-		if( imaging_handle_empty_output_list(
-		     imaging_handle,
+		if( libcthreads_thread_join(
+		     &( imaging_handle->output_thread ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to join output thread.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+	}
+	if( imaging_handle->output_reorder_ring != NULL )
+	{
+		if( storage_media_buffer_reorder_ring_free(
+		     &( imaging_handle->output_reorder_ring ),
+		     imaging_handle->storage_media_buffer_queue,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output reorder ring.",
 			 function );
 
 			goto on_error;
@@ -1518,26 +1653,35 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_reader != NULL )
+	{
+		device_reader_free(
+		 &device_reader,
+		 NULL );
+	}
 	if( imaging_handle->process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
 		 &( imaging_handle->process_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_thread_pool != NULL )
+	if( imaging_handle->output_reorder_ring != NULL )
 	{
-		libcthreads_thread_pool_join(
-		 &( imaging_handle->output_thread_pool ),
+		storage_media_buffer_reorder_ring_close(
+		 imaging_handle->output_reorder_ring,
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_thread != NULL )
 	{
-		imaging_handle_empty_output_list(
-		 imaging_handle,
+		libcthreads_thread_join(
+		 &( imaging_handle->output_thread ),
 		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
+	}
+	if( imaging_handle->output_reorder_ring != NULL )
+	{
+		storage_media_buffer_reorder_ring_free(
+		 &( imaging_handle->output_reorder_ring ),
+		 imaging_handle->storage_media_buffer_queue,
 		 NULL );
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
@@ -1598,6 +1742,7 @@ int main( int argc, char * const argv[] )
 	uint8_t resume_acquiry                               = 0;
 	uint8_t swap_byte_pairs                              = 0;
 	uint8_t use_chunk_data_functions                     = 0;
+	uint8_t use_direct_io                                = 0;
 	uint8_t verbose                                      = 0;
 	uint8_t zero_buffer_on_error                         = 0;
 	int8_t acquiry_parameters_confirmed                  = 0;
@@ -1637,7 +1782,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:Op:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1752,6 +1897,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				use_direct_io = 1;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1951,6 +2101,10 @@ int main( int argc, char * const argv[] )
 	{
 		ewfacquire_device_handle->zero_buffer_on_error = 1;
 	}
+	if( use_direct_io != 0 )
+	{
+		ewfacquire_device_handle->use_direct_io = 1;
+	}
 	/* Open the input file or device size
 	 */
 	if( device_handle_open_input(
@@ -1993,6 +2147,10 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( use_direct_io != 0 )
+	{
+		ewfacquire_imaging_handle->use_direct_io = 1;
+	}
 	if( device_handle_get_media_size(
 	     ewfacquire_device_handle,
 	     &( ewfacquire_imaging_handle->input_media_size ),
@@ -2549,8 +2707,7 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
-		else if( ( result == 0 )
-		      || ( ewfacquire_imaging_handle->number_of_threads > (int) 32 ) )
+		else if( result == 0 )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfacquire_imaging_handle->number_of_threads = 4;
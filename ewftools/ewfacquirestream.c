@@ -59,6 +59,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder_ring.h"
 
 imaging_handle_t *ewfacquirestream_imaging_handle = NULL;
 int ewfacquirestream_abort                        = 0;
@@ -606,13 +607,14 @@ int ewfacquirestream_read_input(
 	{
 		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
 
-		if( libcthreads_thread_pool_create(
+		if( libcthreads_thread_pool_create_with_flags(
 		     &( imaging_handle->process_thread_pool ),
 		     NULL,
 		     imaging_handle->number_of_threads,
 		     maximum_number_of_queued_items,
 		     (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer_callback,
 		     (void *) imaging_handle,
+		     LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -624,50 +626,49 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
-		if( libcthreads_thread_pool_create(
-		     &( imaging_handle->output_thread_pool ),
-		     NULL,
-		     1,
+		if( storage_media_buffer_reorder_ring_initialize(
+		     &( imaging_handle->output_reorder_ring ),
 		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &imaging_handle_output_storage_media_buffer_callback,
-		     (void *) imaging_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize output thread pool.",
+			 "%s: unable to initialize output reorder ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( imaging_handle->output_list ),
+		if( storage_media_buffer_queue_initialize(
+		     &( imaging_handle->storage_media_buffer_queue ),
+		     imaging_handle->output_handle,
+		     maximum_number_of_queued_items,
+		     storage_media_buffer_mode,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to initialize storage media buffer queue.",
 			 function );
 
 			goto on_error;
 		}
-		if( storage_media_buffer_queue_initialize(
-		     &( imaging_handle->storage_media_buffer_queue ),
-		     imaging_handle->output_handle,
-		     maximum_number_of_queued_items,
-		     storage_media_buffer_mode,
-		     process_buffer_size,
+		if( libcthreads_thread_create(
+		     &( imaging_handle->output_thread ),
+		     NULL,
+		     (int (*)(void *)) &imaging_handle_output_thread_callback,
+		     (void *) imaging_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize storage media buffer queue.",
+			 "%s: unable to create output thread.",
 			 function );
 
 			goto on_error;
@@ -886,6 +887,20 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads != 0 )
 		{
+			if( storage_media_buffer_reorder_ring_set_sequence_number(
+			     imaging_handle->output_reorder_ring,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sequence number of storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
 			if( libcthreads_thread_pool_push(
 			     imaging_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -988,47 +1003,50 @@ int ewfacquirestream_read_input(
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_thread_pool != NULL )
+	if( imaging_handle->output_reorder_ring != NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->output_thread_pool ),
+		if( storage_media_buffer_reorder_ring_close(
+		     imaging_handle->output_reorder_ring,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 "%s: unable to close output reorder ring.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_thread != NULL )
 	{
-		if( imaging_handle_empty_output_list(
-		     imaging_handle,
+		if( libcthreads_thread_join(
+		     &( imaging_handle->output_thread ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to join output thread.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+	}
+	if( imaging_handle->output_reorder_ring != NULL )
+	{
+		if( storage_media_buffer_reorder_ring_free(
+		     &( imaging_handle->output_reorder_ring ),
+		     imaging_handle->storage_media_buffer_queue,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output reorder ring.",
 			 function );
 
 			goto on_error;
@@ -1175,20 +1193,23 @@ on_error:
 		 &( imaging_handle->process_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_thread_pool != NULL )
+	if( imaging_handle->output_reorder_ring != NULL )
 	{
-		libcthreads_thread_pool_join(
-		 &( imaging_handle->output_thread_pool ),
+		storage_media_buffer_reorder_ring_close(
+		 imaging_handle->output_reorder_ring,
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_thread != NULL )
 	{
-		imaging_handle_empty_output_list(
-		 imaging_handle,
+		libcthreads_thread_join(
+		 &( imaging_handle->output_thread ),
 		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
+	}
+	if( imaging_handle->output_reorder_ring != NULL )
+	{
+		storage_media_buffer_reorder_ring_free(
+		 &( imaging_handle->output_reorder_ring ),
+		 imaging_handle->storage_media_buffer_queue,
 		 NULL );
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
@@ -1963,8 +1984,7 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
-		else if( ( result == 0 )
-		      || ( ewfacquirestream_imaging_handle->number_of_threads > (int) 32 ) )
+		else if( result == 0 )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfacquirestream_imaging_handle->number_of_threads = 4;
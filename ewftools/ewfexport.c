@@ -887,8 +887,7 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
-		else if( ( result == 0 )
-		      || ( ewfexport_export_handle->number_of_threads > (int) 32 ) )
+		else if( result == 0 )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfexport_export_handle->number_of_threads = 4;
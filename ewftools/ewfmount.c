@@ -177,11 +177,12 @@ int ewfmount_fuse_open(
      const char *path,
      struct fuse_file_info *file_info )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_file_entry_t *file_entry = NULL;
-	static char *function           = "ewfmount_fuse_open";
-	size_t path_length              = 0;
-	int result                      = 0;
+	libcerror_error_t *error              = NULL;
+	mount_path_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "ewfmount_fuse_open";
+	size_t path_length                    = 0;
+	uint64_t file_handle                  = 0;
+	int result                            = 0;
 
 	if( path == NULL )
 	{
@@ -214,12 +215,12 @@ int ewfmount_fuse_open(
 
 	if( ewfmount_mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_FILES )
 	{
-		if( mount_handle_get_file_entry_by_path(
+		if( mount_handle_get_cached_file_entry_by_path(
 		     ewfmount_mount_handle,
 		     path,
 		     path_length,
 		     (system_character_t) '/',
-		     &file_entry,
+		     &cache_entry,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
@@ -232,21 +233,6 @@ int ewfmount_fuse_open(
 
 			result = -ENOENT;
 
-			goto on_error;
-		}
-		if( libewf_file_entry_free(
-		     &file_entry,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file entry.",
-			 function );
-
-			result = -EIO;
-
 			goto on_error;
 		}
 	}
@@ -285,6 +271,30 @@ int ewfmount_fuse_open(
 
 		goto on_error;
 	}
+	if( cache_entry != NULL )
+	{
+		/* The open file keeps the file entry so that read does not have to resolve the path again
+		 */
+		if( mount_handle_open_file(
+		     ewfmount_mount_handle,
+		     &cache_entry,
+		     &file_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to open file: %s.",
+			 function,
+			 path );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		file_info->fh = file_handle;
+	}
 	return( 0 );
 
 on_error:
@@ -295,10 +305,11 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_entry != NULL )
+	if( cache_entry != NULL )
 	{
-		libewf_file_entry_free(
-		 &file_entry,
+		mount_handle_release_cached_file_entry(
+		 ewfmount_mount_handle,
+		 &cache_entry,
 		 NULL );
 	}
 	return( result );
@@ -312,16 +323,17 @@ int ewfmount_fuse_read(
      char *buffer,
      size_t size,
      off_t offset,
-     struct fuse_file_info *file_info EWFTOOLS_ATTRIBUTE_UNUSED )
+     struct fuse_file_info *file_info )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_file_entry_t *file_entry = NULL;
-	static char *function           = "ewfmount_fuse_read";
-	size_t path_length              = 0;
-	ssize_t read_count              = 0;
-	int input_handle_index          = 0;
-	int result                      = 0;
-	int string_index                = 0;
+	libcerror_error_t *error              = NULL;
+	libewf_file_entry_t *file_entry       = NULL;
+	mount_path_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "ewfmount_fuse_read";
+	size_t path_length                    = 0;
+	ssize_t read_count                    = 0;
+	int input_handle_index                = 0;
+	int result                            = 0;
+	int string_index                      = 0;
 
 	if( path == NULL )
 	{
@@ -367,47 +379,55 @@ int ewfmount_fuse_read(
 
 	if( ewfmount_mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_FILES )
 	{
-		if( mount_handle_get_file_entry_by_path(
-		     ewfmount_mount_handle,
-		     path,
-		     path_length,
-		     (system_character_t) '/',
-		     &file_entry,
-		     &error ) != 1 )
+		result = mount_handle_get_open_file_entry(
+		          ewfmount_mount_handle,
+		          (uint64_t) file_info->fh,
+		          &file_entry,
+		          &error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file entry for: %s.",
+			 "%s: unable to retrieve open file entry for: %s.",
 			 function,
 			 path );
 
-			result = -ENOENT;
+			result = -EIO;
 
 			goto on_error;
 		}
-		if( libewf_file_entry_seek_offset(
-		     file_entry,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
+		else if( result == 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in file entry.",
-			 function );
+			if( mount_handle_get_cached_file_entry_by_path(
+			     ewfmount_mount_handle,
+			     path,
+			     path_length,
+			     (system_character_t) '/',
+			     &cache_entry,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file entry for: %s.",
+				 function,
+				 path );
 
-			result = -EIO;
+				result = -ENOENT;
 
-			goto on_error;
+				goto on_error;
+			}
+			file_entry = cache_entry->file_entry;
 		}
-		read_count = libewf_file_entry_read_buffer(
+		read_count = libewf_file_entry_read_buffer_at_offset(
 			      file_entry,
 			      (uint8_t *) buffer,
 			      size,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -423,15 +443,16 @@ int ewfmount_fuse_read(
 
 			goto on_error;
 		}
-		if( libewf_file_entry_free(
-		     &file_entry,
+		if( mount_handle_release_cached_file_entry(
+		     ewfmount_mount_handle,
+		     &cache_entry,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file entry.",
+			 "%s: unable to release file entry.",
 			 function );
 
 			result = -EIO;
@@ -489,27 +510,11 @@ int ewfmount_fuse_read(
 
 			goto on_error;
 		}
-		if( mount_handle_seek_offset(
-		     ewfmount_mount_handle,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in mount handle.",
-			 function );
-
-			result = -EIO;
-
-			goto on_error;
-		}
-		read_count = mount_handle_read_buffer(
+		read_count = mount_handle_read_buffer_at_offset(
 			      ewfmount_mount_handle,
 			      (uint8_t *) buffer,
 			      size,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -536,10 +541,11 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_entry != NULL )
+	if( cache_entry != NULL )
 	{
-		libewf_file_entry_free(
-		 &file_entry,
+		mount_handle_release_cached_file_entry(
+		 ewfmount_mount_handle,
+		 &cache_entry,
 		 NULL );
 	}
 	return( result );
@@ -557,20 +563,21 @@ int ewfmount_fuse_readdir(
 {
 	char ewfmount_fuse_path[ 10 ];
 
-	libcerror_error_t *error            = NULL;
-	libewf_file_entry_t *file_entry     = NULL;
-	libewf_file_entry_t *sub_file_entry = NULL;
-	char *name                          = NULL;
-	static char *function               = "ewfmount_fuse_readdir";
-	size_t name_index                   = 0;
-	size_t name_size                    = 0;
-	size_t path_length                  = 0;
-	int input_handle_index              = 0;
-	int number_of_input_handles         = 0;
-	int number_of_sub_file_entries      = 0;
-	int result                          = 0;
-	int sub_file_entry_index            = 0;
-	int string_index                    = 0;
+	libcerror_error_t *error              = NULL;
+	libewf_file_entry_t *file_entry       = NULL;
+	libewf_file_entry_t *sub_file_entry   = NULL;
+	mount_path_cache_entry_t *cache_entry = NULL;
+	char *name                            = NULL;
+	static char *function                 = "ewfmount_fuse_readdir";
+	size_t name_index                     = 0;
+	size_t name_size                      = 0;
+	size_t path_length                    = 0;
+	int input_handle_index                = 0;
+	int number_of_input_handles           = 0;
+	int number_of_sub_file_entries        = 0;
+	int result                            = 0;
+	int sub_file_entry_index              = 0;
+	int string_index                      = 0;
 
 	EWFTOOLS_UNREFERENCED_PARAMETER( offset )
 	EWFTOOLS_UNREFERENCED_PARAMETER( file_info )
@@ -593,12 +600,12 @@ int ewfmount_fuse_readdir(
 
 	if( ewfmount_mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_FILES )
 	{
-		if( mount_handle_get_file_entry_by_path(
+		if( mount_handle_get_cached_file_entry_by_path(
 		     ewfmount_mount_handle,
 		     path,
 		     path_length,
 		     (system_character_t) '/',
-		     &file_entry,
+		     &cache_entry,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
@@ -613,6 +620,7 @@ int ewfmount_fuse_readdir(
 
 			goto on_error;
 		}
+		file_entry = cache_entry->file_entry;
 	}
 	else if( ewfmount_mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_RAW )
 	{
@@ -870,15 +878,18 @@ int ewfmount_fuse_readdir(
 				goto on_error;
 			}
 		}
-		if( libewf_file_entry_free(
-		     &file_entry,
+		file_entry = NULL;
+
+		if( mount_handle_release_cached_file_entry(
+		     ewfmount_mount_handle,
+		     &cache_entry,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file entry.",
+			 "%s: unable to release file entry.",
 			 function );
 
 			result = -EIO;
@@ -945,10 +956,11 @@ on_error:
 		 &sub_file_entry,
 		 NULL );
 	}
-	if( file_entry != NULL )
+	if( cache_entry != NULL )
 	{
-		libewf_file_entry_free(
-		 &file_entry,
+		mount_handle_release_cached_file_entry(
+		 ewfmount_mount_handle,
+		 &cache_entry,
 		 NULL );
 	}
 	return( result );
@@ -961,20 +973,21 @@ int ewfmount_fuse_getattr(
      const char *path,
      struct stat *stat_info )
 {
-	libcerror_error_t *error        = NULL;
-	libewf_file_entry_t *file_entry = NULL;
-	static char *function           = "ewfmount_fuse_getattr";
-	size64_t file_size              = 0;
-	size64_t media_size             = 0;
-	size_t path_length              = 0;
-	uint32_t value_32bit            = 0;
-	int input_handle_index          = 0;
-	int number_of_sub_file_entries  = 0;
-	int result                      = -ENOENT;
-	int string_index                = 0;
+	libcerror_error_t *error              = NULL;
+	libewf_file_entry_t *file_entry       = NULL;
+	mount_path_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "ewfmount_fuse_getattr";
+	size64_t file_size                    = 0;
+	size64_t media_size                   = 0;
+	size_t path_length                    = 0;
+	uint32_t value_32bit                  = 0;
+	int input_handle_index                = 0;
+	int number_of_sub_file_entries        = 0;
+	int result                            = -ENOENT;
+	int string_index                      = 0;
 
 #if defined( HAVE_TIME )
-	time_t timestamp                = 0;
+	time_t timestamp                      = 0;
 #endif
 
 	if( path == NULL )
@@ -1034,12 +1047,12 @@ int ewfmount_fuse_getattr(
 	}
 	else if( ewfmount_mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_FILES )
 	{
-		result = mount_handle_get_file_entry_by_path(
+		result = mount_handle_get_cached_file_entry_by_path(
 		          ewfmount_mount_handle,
 		          path,
 		          path_length,
 		          (system_character_t) '/',
-		          &file_entry,
+		          &cache_entry,
 		          &error );
 
 		if( result == -1 )
@@ -1058,6 +1071,8 @@ int ewfmount_fuse_getattr(
 		}
 		else if( result == 1 )
 		{
+			file_entry = cache_entry->file_entry;
+
 			if( libewf_file_entry_get_number_of_sub_file_entries(
 			     file_entry,
 			     &number_of_sub_file_entries,
@@ -1171,15 +1186,18 @@ int ewfmount_fuse_getattr(
 			}
 			stat_info->st_ctime = value_32bit;
 
-			if( libewf_file_entry_free(
-			     &file_entry,
+			file_entry = NULL;
+
+			if( mount_handle_release_cached_file_entry(
+			     ewfmount_mount_handle,
+			     &cache_entry,
 			     &error ) != 1 )
 			{
 				libcerror_error_set(
 				 &error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free file entry.",
+				 "%s: unable to release file entry.",
 				 function );
 
 				result = -EIO;
@@ -1303,15 +1321,76 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( file_entry != NULL )
+	if( cache_entry != NULL )
 	{
-		libewf_file_entry_free(
-		 &file_entry,
+		mount_handle_release_cached_file_entry(
+		 ewfmount_mount_handle,
+		 &cache_entry,
 		 NULL );
 	}
 	return( result );
 }
 
+/* Releases a file opened by open
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int ewfmount_fuse_release(
+     const char *path EWFTOOLS_ATTRIBUTE_UNUSED,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewfmount_fuse_release";
+	int result               = 0;
+
+	EWFTOOLS_UNREFERENCED_PARAMETER( path )
+
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( ( ewfmount_mount_handle->input_format == MOUNT_HANDLE_INPUT_FORMAT_FILES )
+	 && ( file_info->fh != 0 ) )
+	{
+		if( mount_handle_close_file(
+		     ewfmount_mount_handle,
+		     (uint64_t) file_info->fh,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		file_info->fh = 0;
+	}
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
 /* Cleans up when fuse is done
  */
 void ewfmount_fuse_destroy(
@@ -1780,27 +1859,11 @@ int __stdcall ewfmount_dokan_ReadFile(
 
 			goto on_error;
 		}
-		if( libewf_file_entry_seek_offset(
-		     file_entry,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in file entry.",
-			 function );
-
-			result = -ERROR_SEEK_ON_DEVICE;
-
-			goto on_error;
-		}
-		read_count = libewf_file_entry_read_buffer(
+		read_count = libewf_file_entry_read_buffer_at_offset(
 			      file_entry,
 			      (uint8_t *) buffer,
 			      (size_t) number_of_bytes_to_read,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -1882,27 +1945,11 @@ int __stdcall ewfmount_dokan_ReadFile(
 
 			goto on_error;
 		}
-		if( mount_handle_seek_offset(
-		     ewfmount_mount_handle,
-		     (off64_t) offset,
-		     SEEK_SET,
-		     &error ) == -1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in mount handle.",
-			 function );
-
-			result = -ERROR_SEEK_ON_DEVICE;
-
-			goto on_error;
-		}
-		read_count = mount_handle_read_buffer(
+		read_count = mount_handle_read_buffer_at_offset(
 			      ewfmount_mount_handle,
 			      (uint8_t *) buffer,
 			      (size_t) number_of_bytes_to_read,
+			      (off64_t) offset,
 			      &error );
 
 		if( read_count == -1 )
@@ -3104,7 +3151,6 @@ int main( int argc, char * const argv[] )
 
 	libewf_error_t *error                        = NULL;
 	system_character_t *mount_point              = NULL;
-	system_character_t *option_extended_options  = NULL;
 	system_character_t *option_format            = NULL;
 	system_character_t *program                  = _SYSTEM_STRING( "ewfmount" );
 	system_integer_t option                      = 0;
@@ -3120,6 +3166,7 @@ int main( int argc, char * const argv[] )
 	struct fuse_operations ewfmount_fuse_operations;
 
 	struct fuse_args ewfmount_fuse_arguments     = FUSE_ARGS_INIT(0, NULL);
+	system_character_t *option_extended_options  = NULL;
 	struct fuse_chan *ewfmount_fuse_channel      = NULL;
 	struct fuse *ewfmount_fuse_handle            = NULL;
 
@@ -3200,8 +3247,9 @@ int main( int argc, char * const argv[] )
 				return( EXIT_SUCCESS );
 
 			case (system_integer_t) 'X':
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 				option_extended_options = optarg;
-
+#endif
 				break;
 		}
 	}
@@ -3402,6 +3450,7 @@ int main( int argc, char * const argv[] )
 	ewfmount_fuse_operations.read    = &ewfmount_fuse_read;
 	ewfmount_fuse_operations.readdir = &ewfmount_fuse_readdir;
 	ewfmount_fuse_operations.getattr = &ewfmount_fuse_getattr;
+	ewfmount_fuse_operations.release = &ewfmount_fuse_release;
 	ewfmount_fuse_operations.destroy = &ewfmount_fuse_destroy;
 
 	ewfmount_fuse_channel = fuse_mount(
@@ -3443,8 +3492,16 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The reads are done at an offset, which allows to serve
+	 * the fuse requests from multiple threads
+	 */
+	result = fuse_loop_mt(
+	          ewfmount_fuse_handle );
+#else
 	result = fuse_loop(
 	          ewfmount_fuse_handle );
+#endif
 
 	if( result != 0 )
 	{
@@ -3584,7 +3641,8 @@ int main( int argc, char * const argv[] )
 #else
 	fprintf(
 	 stderr,
-	 "No sub system to mount EWF format.\n" );
+	 "No sub system to mount EWF format on: %" PRIs_SYSTEM ".\n",
+	 mount_point );
 
 	return( EXIT_FAILURE );
 #endif
@@ -409,8 +409,7 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
-		else if( ( result == 0 )
-		      || ( ewfverify_verification_handle->number_of_threads > (int) 32 ) )
+		else if( result == 0 )
 		{
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 			ewfverify_verification_handle->number_of_threads = 4;
@@ -42,6 +42,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "digest_context.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -59,6 +60,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder_ring.h"
 
 #define EXPORT_HANDLE_BUFFER_SIZE		8192
 #define EXPORT_HANDLE_INPUT_BUFFER_SIZE		64
@@ -309,17 +311,17 @@ int export_handle_free(
 				result = -1;
 			}
 		}
-		if( ( *export_handle )->md5_context != NULL )
+		if( ( *export_handle )->digest_context != NULL )
 		{
-			if( libhmac_md5_free(
-			     &( ( *export_handle )->md5_context ),
+			if( digest_context_free(
+			     &( ( *export_handle )->digest_context ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free MD5 context.",
+				 "%s: unable to free digest context.",
 				 function );
 
 				result = -1;
@@ -330,43 +332,11 @@ int export_handle_free(
 			memory_free(
 			 ( *export_handle )->calculated_md5_hash_string );
 		}
-		if( ( *export_handle )->sha1_context != NULL )
-		{
-			if( libhmac_sha1_free(
-			     &( ( *export_handle )->sha1_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA1 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *export_handle )->calculated_sha1_hash_string != NULL )
 		{
 			memory_free(
 			 ( *export_handle )->calculated_sha1_hash_string );
 		}
-		if( ( *export_handle )->sha256_context != NULL )
-		{
-			if( libhmac_sha256_free(
-			     &( ( *export_handle )->sha256_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA256 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *export_handle )->calculated_sha256_hash_string != NULL )
 		{
 			memory_free(
@@ -1320,73 +1290,35 @@ int export_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_initialize(
-		     &( export_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create MD5 context.",
-			 function );
-
-			goto on_error;
-		}
-		export_handle->md5_context_initialized = 1;
-	}
-	if( export_handle->calculate_sha1 != 0 )
+	if( export_handle->digest_context != NULL )
 	{
-		if( libhmac_sha1_initialize(
-		     &( export_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create SHA1 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - digest context value already set.",
+		 function );
 
-			goto on_error;
-		}
-		export_handle->sha1_context_initialized = 1;
+		return( -1 );
 	}
-	if( export_handle->calculate_sha256 != 0 )
+	if( digest_context_initialize(
+	     &( export_handle->digest_context ),
+	     export_handle->calculate_md5,
+	     export_handle->calculate_sha1,
+	     export_handle->calculate_sha256,
+	     export_handle->number_of_threads,
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_initialize(
-		     &( export_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create SHA256 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest context.",
+		 function );
 
-			goto on_error;
-		}
-		export_handle->sha256_context_initialized = 1;
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( export_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( export_handle->sha1_context ),
-		 NULL );
-	}
-	if( export_handle->md5_context != NULL )
-	{
-		libhmac_md5_free(
-		 &( export_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Updates the integrity hash(es)
@@ -1434,59 +1366,20 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_update(
-		     export_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( export_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_update(
-		     export_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( export_handle->calculate_sha256 != 0 )
+	if( digest_context_update(
+	     export_handle->digest_context,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_update(
-		     export_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash(es).",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
 	return( 1 );
 }
@@ -1515,6 +1408,25 @@ int export_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+	if( digest_context_finalize(
+	     export_handle->digest_context,
+	     calculated_md5_hash,
+	     LIBHMAC_MD5_HASH_SIZE,
+	     calculated_sha1_hash,
+	     LIBHMAC_SHA1_HASH_SIZE,
+	     calculated_sha256_hash,
+	     LIBHMAC_SHA256_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize digest hash(es).",
+		 function );
+
+		return( -1 );
+	}
 	if( export_handle->calculate_md5 != 0 )
 	{
 		if( export_handle->calculated_md5_hash_string == NULL )
@@ -1528,21 +1440,6 @@ int export_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_md5_finalize(
-		     export_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_md5_hash,
 		     LIBHMAC_MD5_HASH_SIZE,
@@ -1573,21 +1470,6 @@ int export_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
-		     export_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_sha1_hash,
 		     LIBHMAC_SHA1_HASH_SIZE,
@@ -1618,21 +1500,6 @@ int export_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
-		     export_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_sha256_hash,
 		     LIBHMAC_SHA256_HASH_SIZE,
@@ -3213,7 +3080,7 @@ int export_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > (uint64_t) INT32_MAX )
 		{
 			result = 0;
 		}
@@ -4504,18 +4371,16 @@ int export_handle_process_storage_media_buffer_callback(
 			goto on_error;
 		}
 	}
-	if( libcthreads_thread_pool_push_sorted(
-	     export_handle->output_thread_pool,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
+	if( storage_media_buffer_reorder_ring_insert(
+	     export_handle->output_reorder_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 "%s: unable to insert storage media buffer into output reorder ring.",
 		 function );
 
 		goto on_error;
@@ -4559,260 +4424,224 @@ on_error:
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for export
- * Callback function for the process thread pool
+/* Outputs a processed storage media buffer
+ * The byte pairs are swapped and the integrity hash is updated before the data is written
  * Returns 1 if successful or -1 on error
  */
-int export_handle_output_storage_media_buffer_callback(
+int export_handle_output_storage_media_buffer(
+     export_handle_t *export_handle,
      storage_media_buffer_t *storage_media_buffer,
-     export_handle_t *export_handle )
+     libcerror_error_t **error )
 {
-	libcdata_list_element_t *element                    = NULL;
-	libcdata_list_element_t *next_element               = NULL;
-        libcerror_error_t *error                            = NULL;
 	storage_media_buffer_t *output_storage_media_buffer = NULL;
 	uint8_t *data                                       = NULL;
-        static char *function                               = "export_handle_process_storage_media_buffer_callback";
+        static char *function                               = "export_handle_output_storage_media_buffer";
 	size_t data_size                                    = 0;
 	ssize_t write_count                                 = 0;
 
 	if( export_handle == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid export handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid storage media buffer.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_list_insert_value(
-	     export_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
+	if( storage_media_buffer_get_data(
+	     storage_media_buffer,
+	     &data,
+	     &data_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine storage media buffer data.",
 		 function );
 
 		goto on_error;
 	}
-	storage_media_buffer = NULL;
+	/* Swap byte pairs
+	 */
+	if( export_handle->swap_byte_pairs == 1 )
+	{
+		if( export_handle_swap_byte_pairs(
+		     export_handle,
+		     data,
+		     storage_media_buffer->processed_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_GENERIC,
+			 "%s: unable to swap byte pairs.",
+			 function );
 
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+			goto on_error;
+		}
+	}
+	/* Digest hashes are calcultated after swap
+	 */
+	if( export_handle_update_integrity_hash(
+	     export_handle,
+	     data,
+	     storage_media_buffer->processed_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to update integrity hash(es).",
 		 function );
 
 		goto on_error;
 	}
-	while( element != NULL )
+	export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+
+	if( export_handle->use_chunk_data_functions != 0 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( storage_media_buffer_initialize(
+		     &output_storage_media_buffer,
+		     export_handle->ewf_output_handle,
+		     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
+		     export_handle->output_chunk_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output storage media buffer.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
+	}
+	write_count = export_handle_write(
+		       export_handle,
+		       storage_media_buffer,
+		       output_storage_media_buffer,
+		       storage_media_buffer->processed_size,
+		       error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to export handle.",
+		 function );
+
+		goto on_error;
+	}
+/* TODO: if storage media buffer can be passed on do not free it */
+	if( output_storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_free(
+		     &output_storage_media_buffer,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output storage media buffer.",
 			 function );
 
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != export_handle->last_offset_hashed )
-		{
-			break;
+			goto on_error;
 		}
-		if( storage_media_buffer_get_data(
-		     storage_media_buffer,
-		     &data,
-		     &data_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine storage media buffer data.",
-			 function );
+	}
+	return( 1 );
 
-			storage_media_buffer = NULL;
+on_error:
+	if( output_storage_media_buffer != NULL )
+	{
+		storage_media_buffer_free(
+		 &output_storage_media_buffer,
+		 NULL );
+	}
+	return( -1 );
+}
 
-			goto on_error;
-		}
-		/* Swap byte pairs
-		 */
-		if( export_handle->swap_byte_pairs == 1 )
-		{
-			if( export_handle_swap_byte_pairs(
-			     export_handle,
-			     data,
-			     storage_media_buffer->processed_size,
-			     &error ) != 1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-				 LIBCERROR_CONVERSION_ERROR_GENERIC,
-				 "%s: unable to swap byte pairs.",
-				 function );
+/* Outputs the processed storage media buffers in order of their sequence number
+ * Callback function for the output thread
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_output_thread_callback(
+     export_handle_t *export_handle )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        libcerror_error_t *error                     = NULL;
+        static char *function                        = "export_handle_output_thread_callback";
+	int pop_result                               = 0;
+	int result                                   = 1;
 
-				storage_media_buffer = NULL;
+	if( export_handle == NULL )
+	{
+		return( -1 );
+	}
+	do
+	{
+		pop_result = storage_media_buffer_reorder_ring_pop(
+		              export_handle->output_reorder_ring,
+		              &storage_media_buffer,
+		              &error );
 
-				goto on_error;
-			}
-		}
-		/* Digest hashes are calcultated after swap
-		 */
-		if( export_handle_update_integrity_hash(
-		     export_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
+		if( pop_result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop storage media buffer from output reorder ring.",
 			 function );
 
-			storage_media_buffer = NULL;
+			result = -1;
 
-			goto on_error;
+			break;
 		}
-		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
-		if( export_handle->use_chunk_data_functions != 0 )
+		else if( pop_result == 0 )
 		{
-			if( storage_media_buffer_initialize(
-			     &output_storage_media_buffer,
-			     export_handle->ewf_output_handle,
-			     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
-			     export_handle->output_chunk_size,
+			break;
+		}
+		/* After an error the remaining buffers are released without writing them
+		 * so that the threads that wait for a free storage media buffer do not block
+		 */
+		if( result == 1 )
+		{
+			if( export_handle_output_storage_media_buffer(
+			     export_handle,
+			     storage_media_buffer,
 			     &error ) != 1 )
 			{
 				libcerror_error_set(
 				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create output storage media buffer.",
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to output storage media buffer.",
 				 function );
 
-				storage_media_buffer = NULL;
-
-				goto on_error;
+				result = -1;
 			}
 		}
-		write_count = export_handle_write(
-			       export_handle,
-			       storage_media_buffer,
-			       output_storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write to export handle.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			goto on_error;
-		}
-/* TODO: if storage media buffer can be passed on do not release it */
 		if( storage_media_buffer_queue_release_buffer(
 		     export_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
@@ -4825,74 +4654,35 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			goto on_error;
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+
+			result = -1;
 		}
 		storage_media_buffer = NULL;
 
-/* TODO: if storage media buffer can be passed on do not free it */
-		if( output_storage_media_buffer != NULL )
+		if( result == 1 )
 		{
-			if( storage_media_buffer_free(
-			     &output_storage_media_buffer,
+			if( process_status_update(
+			     export_handle->process_status,
+			     export_handle->last_offset_hashed,
+			     export_handle->input_media_size,
 			     &error ) != 1 )
 			{
 				libcerror_error_set(
 				 &error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free output storage media buffer.",
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
 				 function );
 
-				goto on_error;
+				result = -1;
 			}
 		}
-		element = next_element;
-
-		if( process_status_update(
-		     export_handle->process_status,
-		     export_handle->last_offset_hashed,
-		     export_handle->input_media_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update process status.",
-			 function );
-
-			goto on_error;
-		}
 	}
-	return( 1 );
-
-on_error:
-	if( storage_media_buffer != NULL )
-	{
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+	while( pop_result == 1 );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
-		}
-	}
-/* TODO move to queue */
-	if( output_storage_media_buffer != NULL )
-	{
-		storage_media_buffer_free(
-		 &output_storage_media_buffer,
-		 NULL );
-	}
 	if( error != NULL )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -4905,136 +4695,7 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	return( -1 );
-}
-
-/* Empties the output list
- * Returns 1 if successful or -1 on error
- */
-int export_handle_empty_output_list(
-     export_handle_t *export_handle,
-     libcerror_error_t **error )
-{
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "export_handle_empty_output_list";
-
-	if( export_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		return( -1 );
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			return( -1 );
-		}
-		element = next_element;
-	}
-	return( 1 );
+	return( result );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -5210,13 +4871,14 @@ int export_handle_export_input(
 	{
 		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
 
-		if( libcthreads_thread_pool_create(
+		if( libcthreads_thread_pool_create_with_flags(
 		     &( export_handle->input_process_thread_pool ),
 		     NULL,
 		     export_handle->number_of_threads,
 		     maximum_number_of_queued_items,
 		     (int (*)(intptr_t *, void *)) &export_handle_process_storage_media_buffer_callback,
 		     (void *) export_handle,
+		     LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -5228,33 +4890,16 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
-		if( libcthreads_thread_pool_create(
-		     &( export_handle->output_thread_pool ),
-		     NULL,
-		     1,
+		if( storage_media_buffer_reorder_ring_initialize(
+		     &( export_handle->output_reorder_ring ),
 		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &export_handle_output_storage_media_buffer_callback,
-		     (void *) export_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize output thread pool.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_list_initialize(
-		     &( export_handle->output_list ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to initialize output reorder ring.",
 			 function );
 
 			goto on_error;
@@ -5324,6 +4969,29 @@ int export_handle_export_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
+	{
+		/* The output thread updates the process status hence it is created after the process status was started
+		 */
+		if( libcthreads_thread_create(
+		     &( export_handle->output_thread ),
+		     NULL,
+		     (int (*)(void *)) &export_handle_output_thread_callback,
+		     (void *) export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output thread.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( export_handle->number_of_threads == 0 )
 	{
 		if( storage_media_buffer_initialize(
@@ -5423,6 +5091,20 @@ int export_handle_export_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( export_handle->number_of_threads != 0 )
 		{
+			if( storage_media_buffer_reorder_ring_set_sequence_number(
+			     export_handle->output_reorder_ring,
+			     input_storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sequence number of storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
 			if( libcthreads_thread_pool_push(
 			     export_handle->input_process_thread_pool,
 			     (intptr_t *) input_storage_media_buffer,
@@ -5635,47 +5317,50 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
-	if( export_handle->output_thread_pool != NULL )
+	if( export_handle->output_reorder_ring != NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( export_handle->output_thread_pool ),
+		if( storage_media_buffer_reorder_ring_close(
+		     export_handle->output_reorder_ring,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 "%s: unable to close output reorder ring.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_thread != NULL )
 	{
-		if( export_handle_empty_output_list(
-		     export_handle,
+		if( libcthreads_thread_join(
+		     &( export_handle->output_thread ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to join output thread.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( export_handle->output_list ),
-		     NULL,
+	}
+	if( export_handle->output_reorder_ring != NULL )
+	{
+		if( storage_media_buffer_reorder_ring_free(
+		     &( export_handle->output_reorder_ring ),
+		     export_handle->storage_media_buffer_queue,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output reorder ring.",
 			 function );
 
 			goto on_error;
@@ -5836,17 +5521,6 @@ on_error:
 		 &input_storage_media_buffer,
 		 NULL );
 	}
-	if( export_handle->process_status != NULL )
-	{
-		process_status_stop(
-		 export_handle->process_status,
-		 export_handle->last_offset_hashed,
-		 PROCESS_STATUS_FAILED,
-		 NULL );
-		process_status_free(
-		 &( export_handle->process_status ),
-		 NULL );
-	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( export_handle->input_process_thread_pool != NULL )
 	{
@@ -5854,20 +5528,23 @@ on_error:
 		 &( export_handle->input_process_thread_pool ),
 		 NULL );
 	}
-	if( export_handle->output_thread_pool != NULL )
+	if( export_handle->output_reorder_ring != NULL )
 	{
-		libcthreads_thread_pool_join(
-		 &( export_handle->output_thread_pool ),
+		storage_media_buffer_reorder_ring_close(
+		 export_handle->output_reorder_ring,
 		 NULL );
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_thread != NULL )
 	{
-		export_handle_empty_output_list(
-		 export_handle,
+		libcthreads_thread_join(
+		 &( export_handle->output_thread ),
 		 NULL );
-		libcdata_list_free(
-		 &( export_handle->output_list ),
-		 NULL,
+	}
+	if( export_handle->output_reorder_ring != NULL )
+	{
+		storage_media_buffer_reorder_ring_free(
+		 &( export_handle->output_reorder_ring ),
+		 export_handle->storage_media_buffer_queue,
 		 NULL );
 	}
 	if( export_handle->storage_media_buffer_queue != NULL )
@@ -5877,6 +5554,17 @@ on_error:
 		 NULL );
 	}
 #endif
+	if( export_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 export_handle->process_status,
+		 export_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( export_handle->process_status ),
+		 NULL );
+	}
 	return( -1 );
 }
 
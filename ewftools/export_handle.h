@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "digest_context.h"
 #include "digest_hash.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
@@ -35,6 +36,7 @@
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_reorder_ring.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -103,17 +105,13 @@ struct export_handle
 	 */
 	int header_codepage;
 
-	/* Value to indicate if the MD5 digest hash should be calculated
+	/* The digest context
 	 */
-	uint8_t calculate_md5;
+	digest_context_t *digest_context;
 
-	/* The MD5 digest context
-	 */
-	libhmac_md5_context_t *md5_context;
-
-	/* Value to indicate the MD5 digest context was initialized
+	/* Value to indicate if the MD5 digest hash should be calculated
 	 */
-	uint8_t md5_context_initialized;
+	uint8_t calculate_md5;
 
 	/* The calculated MD5 digest hash string
 	 */
@@ -123,14 +121,6 @@ struct export_handle
 	 */
 	uint8_t calculate_sha1;
 
-	/* The SHA1 digest context
-	 */
-	libhmac_sha1_context_t *sha1_context;
-
-	/* Value to indicate the SHA1 digest context was initialized
-	 */
-	uint8_t sha1_context_initialized;
-
 	/* The calculated SHA1 digest hash string
 	 */
 	system_character_t *calculated_sha1_hash_string;
@@ -139,14 +129,6 @@ struct export_handle
 	 */
 	uint8_t calculate_sha256;
 
-	/* The SHA256 digest context
-	 */
-	libhmac_sha256_context_t *sha256_context;
-
-	/* Value to indicate the SHA256 digest context was initialized
-	 */
-	uint8_t sha256_context_initialized;
-
 	/* The calculated SHA256 digest hash string
 	 */
 	system_character_t *calculated_sha256_hash_string;
@@ -169,13 +151,13 @@ struct export_handle
 	 */
 	libcthreads_thread_pool_t *input_process_thread_pool;
 
-	/* The output thread pool
+	/* The output thread
 	 */
-	libcthreads_thread_pool_t *output_thread_pool;
+	libcthreads_thread_t *output_thread;
 
-	/* The output list
+	/* The output reorder ring
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_reorder_ring_t *output_reorder_ring;
 
 	/* The storage media buffer queue
 	 */
@@ -478,14 +460,14 @@ int export_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
 
-int export_handle_output_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     export_handle_t *export_handle );
-
-int export_handle_empty_output_list(
+int export_handle_output_storage_media_buffer(
      export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
      libcerror_error_t **error );
 
+int export_handle_output_thread_callback(
+     export_handle_t *export_handle );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int export_handle_export_input(
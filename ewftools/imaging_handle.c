@@ -34,6 +34,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "digest_context.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -49,6 +50,7 @@
 #include "platform.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder_ring.h"
 
 #define IMAGING_HANDLE_INPUT_BUFFER_SIZE	64
 #define IMAGING_HANDLE_STRING_SIZE		1024
@@ -290,17 +292,17 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
-		if( ( *imaging_handle )->md5_context != NULL )
+		if( ( *imaging_handle )->digest_context != NULL )
 		{
-			if( libhmac_md5_free(
-			     &( ( *imaging_handle )->md5_context ),
+			if( digest_context_free(
+			     &( ( *imaging_handle )->digest_context ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free MD5 context.",
+				 "%s: unable to free digest context.",
 				 function );
 
 				result = -1;
@@ -311,43 +313,11 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->calculated_md5_hash_string );
 		}
-		if( ( *imaging_handle )->sha1_context != NULL )
-		{
-			if( libhmac_sha1_free(
-			     &( ( *imaging_handle )->sha1_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA1 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *imaging_handle )->calculated_sha1_hash_string != NULL )
 		{
 			memory_free(
 			 ( *imaging_handle )->calculated_sha1_hash_string );
 		}
-		if( ( *imaging_handle )->sha256_context != NULL )
-		{
-			if( libhmac_sha256_free(
-			     &( ( *imaging_handle )->sha256_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA256 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *imaging_handle )->calculated_sha256_hash_string != NULL )
 		{
 			memory_free(
@@ -639,6 +609,11 @@ int imaging_handle_open_output(
 	{
 		libewf_filenames = filenames;
 		access_flags     = LIBEWF_OPEN_WRITE;
+
+		if( imaging_handle->use_direct_io != 0 )
+		{
+			access_flags |= LIBEWF_ACCESS_FLAG_DIRECT_IO;
+		}
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
@@ -799,6 +774,11 @@ int imaging_handle_open_secondary_output(
 	{
 		libewf_filenames = filenames;
 		access_flags     = LIBEWF_OPEN_WRITE;
+
+		if( imaging_handle->use_direct_io != 0 )
+		{
+			access_flags |= LIBEWF_ACCESS_FLAG_DIRECT_IO;
+		}
 	}
 	if( libewf_handle_initialize(
 	     &( imaging_handle->secondary_output_handle ),
@@ -1298,73 +1278,35 @@ int imaging_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
+	if( imaging_handle->digest_context != NULL )
 	{
-		if( libhmac_md5_initialize(
-		     &( imaging_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize MD5 context.",
-			 function );
-
-			goto on_error;
-		}
-		imaging_handle->md5_context_initialized = 1;
-	}
-	if( imaging_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_initialize(
-		     &( imaging_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA1 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - digest context value already set.",
+		 function );
 
-			goto on_error;
-		}
-		imaging_handle->sha1_context_initialized = 1;
+		return( -1 );
 	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	if( digest_context_initialize(
+	     &( imaging_handle->digest_context ),
+	     imaging_handle->calculate_md5,
+	     imaging_handle->calculate_sha1,
+	     imaging_handle->calculate_sha256,
+	     imaging_handle->number_of_threads,
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_initialize(
-		     &( imaging_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA256 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest context.",
+		 function );
 
-			goto on_error;
-		}
-		imaging_handle->sha256_context_initialized = 1;
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( imaging_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( imaging_handle->sha1_context ),
-		 NULL );
-	}
-	if( imaging_handle->md5_context != NULL )
-	{
-		libhmac_md5_free(
-		 &( imaging_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Updates the integrity hash(es)
@@ -1412,59 +1354,20 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_update(
-		     imaging_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_update(
-		     imaging_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	if( digest_context_update(
+	     imaging_handle->digest_context,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_update(
-		     imaging_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash(es).",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
 	return( 1 );
 }
@@ -1493,6 +1396,25 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+	if( digest_context_finalize(
+	     imaging_handle->digest_context,
+	     calculated_md5_hash,
+	     LIBHMAC_MD5_HASH_SIZE,
+	     calculated_sha1_hash,
+	     LIBHMAC_SHA1_HASH_SIZE,
+	     calculated_sha256_hash,
+	     LIBHMAC_SHA256_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize digest hash(es).",
+		 function );
+
+		return( -1 );
+	}
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( imaging_handle->calculated_md5_hash_string == NULL )
@@ -1506,21 +1428,6 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_md5_finalize(
-		     imaging_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_md5_hash,
 		     LIBHMAC_MD5_HASH_SIZE,
@@ -1551,21 +1458,6 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
-		     imaging_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_sha1_hash,
 		     LIBHMAC_SHA1_HASH_SIZE,
@@ -1596,21 +1488,6 @@ int imaging_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
-		     imaging_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_sha256_hash,
 		     LIBHMAC_SHA256_HASH_SIZE,
@@ -1671,18 +1548,16 @@ int imaging_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	if( libcthreads_thread_pool_push_sorted(
-	     imaging_handle->output_thread_pool,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
+	if( storage_media_buffer_reorder_ring_insert(
+	     imaging_handle->output_reorder_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 "%s: unable to insert storage media buffer into output reorder ring.",
 		 function );
 
 		goto on_error;
@@ -1726,179 +1601,75 @@ on_error:
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for imaging
- * Callback function for the process thread pool
+/* Writes the storage media buffers in order of their sequence number
+ * Callback function for the output thread
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_output_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
+int imaging_handle_output_thread_callback(
      imaging_handle_t *imaging_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-        static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
-	ssize_t write_count                   = 0;
-	int result                            = 0;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        libcerror_error_t *error                     = NULL;
+        static char *function                        = "imaging_handle_output_thread_callback";
+	ssize_t write_count                          = 0;
+	int pop_result                               = 0;
+	int result                                   = 1;
 
 	if( imaging_handle == NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
-
-		goto on_error;
-	}
-	if( storage_media_buffer == NULL )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcdata_list_insert_value(
-	     imaging_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
-		 function );
-
-		goto on_error;
+		return( -1 );
 	}
-	storage_media_buffer = NULL;
-
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	do
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		pop_result = storage_media_buffer_reorder_ring_pop(
+		              imaging_handle->output_reorder_ring,
+		              &storage_media_buffer,
+		              &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( pop_result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 "%s: unable to pop storage media buffer from output reorder ring.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+			result = -1;
 
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
-		{
 			break;
 		}
-		write_count = imaging_handle_write_storage_media_buffer(
-			       imaging_handle,
-			       storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
+		else if( pop_result == 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
+			break;
 		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		/* After an error the remaining buffers are released without writing them
+		 * so that the threads that wait for a free storage media buffer do not block
+		 */
+		if( result == 1 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+			write_count = imaging_handle_write_storage_media_buffer(
+				       imaging_handle,
+				       storage_media_buffer,
+				       storage_media_buffer->processed_size,
+				       &error );
 
-			storage_media_buffer = NULL;
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write storage media buffer.",
+				 function );
 
-			goto on_error;
+				result = -1;
+			}
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
+		if( result == 1 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			goto on_error;
+			imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 		}
-		element = next_element;
-
 		if( storage_media_buffer_queue_release_buffer(
 		     imaging_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
@@ -1911,59 +1682,46 @@ int imaging_handle_output_storage_media_buffer_callback(
 			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			goto on_error;
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+
+			result = -1;
 		}
 		storage_media_buffer = NULL;
 
-		if( imaging_handle->acquiry_size == 0 )
-		{
-			result = process_status_update_unknown_total(
-			          imaging_handle->process_status,
-			          imaging_handle->last_offset_written,
-		        	  &error );
-		}
-		else
-		{
-			result = process_status_update(
-			          imaging_handle->process_status,
-			          imaging_handle->last_offset_written,
-			          imaging_handle->acquiry_size,
-		        	  &error );
-		}
-		if( result != 1 )
+		if( result == 1 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update process status.",
-			 function );
+			if( imaging_handle->acquiry_size == 0 )
+			{
+				result = process_status_update_unknown_total(
+				          imaging_handle->process_status,
+				          imaging_handle->last_offset_written,
+				          &error );
+			}
+			else
+			{
+				result = process_status_update(
+				          imaging_handle->process_status,
+				          imaging_handle->last_offset_written,
+				          imaging_handle->acquiry_size,
+				          &error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
 
-			goto on_error;
+				result = -1;
+			}
 		}
 	}
-	return( 1 );
-
-on_error:
-	if( storage_media_buffer != NULL )
-	{
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+	while( pop_result == 1 );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
-		}
-	}
 	if( error != NULL )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -1976,136 +1734,7 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	return( -1 );
-}
-
-/* Empties the output list
- * Returns 1 if successful or -1 on error
- */
-int imaging_handle_empty_output_list(
-     imaging_handle_t *imaging_handle,
-     libcerror_error_t **error )
-{
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "imaging_handle_empty_output_list";
-
-	if( imaging_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		return( -1 );
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			return( -1 );
-		}
-		element = next_element;
-	}
-	return( 1 );
+	return( result );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -4231,7 +3860,7 @@ int imaging_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > (uint64_t) INT32_MAX )
 		{
 			result = 0;
 		}
@@ -26,6 +26,7 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "digest_context.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -33,6 +34,7 @@
 #include "ewftools_libhmac.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_reorder_ring.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -154,17 +156,13 @@ struct imaging_handle
 	 */
 	uint64_t acquiry_size;
 
-	/* Value to indicate if the MD5 digest hash should be calculated
+	/* The digest context
 	 */
-	uint8_t calculate_md5;
+	digest_context_t *digest_context;
 
-	/* The MD5 digest context
-	 */
-	libhmac_md5_context_t *md5_context;
-
-	/* Value to indicate the MD5 digest context was initialized
+	/* Value to indicate if the MD5 digest hash should be calculated
 	 */
-	uint8_t md5_context_initialized;
+	uint8_t calculate_md5;
 
 	/* The calculated MD5 digest hash string
 	 */
@@ -174,14 +172,6 @@ struct imaging_handle
 	 */
 	uint8_t calculate_sha1;
 
-	/* The SHA1 digest context
-	 */
-	libhmac_sha1_context_t *sha1_context;
-
-	/* Value to indicate the SHA1 digest context was initialized
-	 */
-	uint8_t sha1_context_initialized;
-
 	/* The calculated SHA1 digest hash string
 	 */
 	system_character_t *calculated_sha1_hash_string;
@@ -190,14 +180,6 @@ struct imaging_handle
 	 */
 	uint8_t calculate_sha256;
 
-	/* The SHA256 digest context
-	 */
-	libhmac_sha256_context_t *sha256_context;
-
-	/* Value to indicate the SHA256 digest context was initialized
-	 */
-	uint8_t sha256_context_initialized;
-
 	/* The calculated SHA256 digest hash string
 	 */
 	system_character_t *calculated_sha256_hash_string;
@@ -206,6 +188,10 @@ struct imaging_handle
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate the segment files should be written using direct IO
+	 */
+	uint8_t use_direct_io;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -220,13 +206,13 @@ struct imaging_handle
 	 */
 	libcthreads_thread_pool_t *process_thread_pool;
 
-	/* The output thread pool
+	/* The output thread
 	 */
-	libcthreads_thread_pool_t *output_thread_pool;
+	libcthreads_thread_t *output_thread;
 
-	/* The output list
+	/* The output reorder ring
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_reorder_ring_t *output_reorder_ring;
 
 	/* The storage media buffer queue
 	 */
@@ -346,14 +332,9 @@ int imaging_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
 
-int imaging_handle_output_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
+int imaging_handle_output_thread_callback(
      imaging_handle_t *imaging_handle );
 
-int imaging_handle_empty_output_list(
-     imaging_handle_t *imaging_handle,
-     libcerror_error_t **error );
-
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int imaging_handle_get_chunk_size(
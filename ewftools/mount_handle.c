@@ -27,8 +27,10 @@
 #include <wide_string.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "mount_handle.h"
+#include "mount_path_cache.h"
 
 /* Creates a mount handle
  * Make sure the value mount_handle is referencing, is set to NULL
@@ -88,7 +90,12 @@ int mount_handle_initialize(
 		 "%s: unable to clear mount handle.",
 		 function );
 
-		goto on_error;
+		memory_free(
+		 *mount_handle );
+
+		*mount_handle = NULL;
+
+		return( -1 );
 	}
 	if( libewf_handle_initialize(
 	     &( ( *mount_handle )->input_handle ),
@@ -103,6 +110,21 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *mount_handle )->open_files_read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize open files read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *mount_handle )->input_format = MOUNT_HANDLE_INPUT_FORMAT_RAW;
 
 	return( 1 );
@@ -110,6 +132,12 @@ int mount_handle_initialize(
 on_error:
 	if( *mount_handle != NULL )
 	{
+		if( ( *mount_handle )->input_handle != NULL )
+		{
+			libewf_handle_free(
+			 &( ( *mount_handle )->input_handle ),
+			 NULL );
+		}
 		memory_free(
 		 *mount_handle );
 
@@ -126,6 +154,7 @@ int mount_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "mount_handle_free";
+	int open_file_index   = 0;
 	int result            = 1;
 
 	if( mount_handle == NULL )
@@ -141,6 +170,66 @@ int mount_handle_free(
 	}
 	if( *mount_handle != NULL )
 	{
+		if( ( *mount_handle )->open_files_array != NULL )
+		{
+			for( open_file_index = 0;
+			     open_file_index < ( *mount_handle )->number_of_open_files_entries;
+			     open_file_index++ )
+			{
+				if( ( *mount_handle )->open_files_array[ open_file_index ] == NULL )
+				{
+					continue;
+				}
+				if( mount_path_cache_release_entry(
+				     ( *mount_handle )->path_cache,
+				     &( ( *mount_handle )->open_files_array[ open_file_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to release open file: %d.",
+					 function,
+					 open_file_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *mount_handle )->open_files_array );
+		}
+		if( ( *mount_handle )->path_cache != NULL )
+		{
+			if( mount_path_cache_free(
+			     &( ( *mount_handle )->path_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free path cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *mount_handle )->open_files_read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free open files read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		if( ( *mount_handle )->root_file_entry != NULL )
 		{
 			if( libewf_file_entry_free(
@@ -465,6 +554,20 @@ int mount_handle_open_input(
 
 			return( -1 );
 		}
+		if( mount_path_cache_initialize(
+		     &( mount_handle->path_cache ),
+		     MOUNT_HANDLE_MAXIMUM_NUMBER_OF_CACHED_FILE_ENTRIES,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create path cache.",
+			 function );
+
+			return( -1 );
+		}
 	}
 	return( 1 );
 }
@@ -548,6 +651,55 @@ ssize_t mount_handle_read_buffer(
 	return( read_count );
 }
 
+/* Read a buffer at a specific offset from the input handle
+ * This function does not change the current offset and can be called
+ * concurrently from multiple threads
+ * Return the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_handle_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libewf_handle_read_buffer_at_offset(
+	              mount_handle->input_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from input handle.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
 /* Seeks a specific offset from the input handle
  * Return the offset if successful or -1 on error
  */
@@ -774,6 +926,462 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the path cache entry of a specific path
+ * The file entry is resolved and added to the path cache if not cached yet
+ * The path cache entry must be released with mount_handle_release_cached_file_entry
+ * Returns 1 if successful, 0 if no such file entry or -1 on error
+ */
+int mount_handle_get_cached_file_entry_by_path(
+     mount_handle_t *mount_handle,
+     const system_character_t *path,
+     size_t path_length,
+     system_character_t path_separator,
+     mount_path_cache_entry_t **cache_entry,
+     libcerror_error_t **error )
+{
+	libewf_file_entry_t *file_entry = NULL;
+	static char *function           = "mount_handle_get_cached_file_entry_by_path";
+	int result                      = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid mount handle - missing path cache.",
+		 function );
+
+		return( -1 );
+	}
+	result = mount_path_cache_get_entry_by_path(
+	          mount_handle->path_cache,
+	          path,
+	          path_length,
+	          cache_entry,
+	          error );
+
+	if( result != 0 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve path cache entry.",
+			 function );
+		}
+		return( result );
+	}
+	result = mount_handle_get_file_entry_by_path(
+	          mount_handle,
+	          path,
+	          path_length,
+	          path_separator,
+	          &file_entry,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry.",
+			 function );
+		}
+		return( result );
+	}
+	if( mount_path_cache_insert_entry(
+	     mount_handle->path_cache,
+	     path,
+	     path_length,
+	     &file_entry,
+	     cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert file entry into path cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a path cache entry retrieved by mount_handle_get_cached_file_entry_by_path
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_release_cached_file_entry(
+     mount_handle_t *mount_handle,
+     mount_path_cache_entry_t **cache_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_release_cached_file_entry";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_path_cache_release_entry(
+	     mount_handle->path_cache,
+	     cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release path cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds a path cache entry to the open files and retrieves its file handle
+ * The mount handle takes over the reference of the path cache entry
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_open_file(
+     mount_handle_t *mount_handle,
+     mount_path_cache_entry_t **cache_entry,
+     uint64_t *file_handle,
+     libcerror_error_t **error )
+{
+	mount_path_cache_entry_t **open_files_array = NULL;
+	static char *function                       = "mount_handle_open_file";
+	int number_of_open_files_entries            = 0;
+	int open_file_index                         = 0;
+	int result                                  = 1;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     mount_handle->open_files_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( open_file_index = 0;
+	     open_file_index < mount_handle->number_of_open_files_entries;
+	     open_file_index++ )
+	{
+		if( mount_handle->open_files_array[ open_file_index ] == NULL )
+		{
+			break;
+		}
+	}
+	if( open_file_index >= mount_handle->number_of_open_files_entries )
+	{
+		if( mount_handle->number_of_open_files_entries == 0 )
+		{
+			number_of_open_files_entries = 16;
+		}
+		else if( mount_handle->number_of_open_files_entries <= ( INT_MAX / 2 ) )
+		{
+			number_of_open_files_entries = mount_handle->number_of_open_files_entries * 2;
+		}
+		if( number_of_open_files_entries != 0 )
+		{
+			open_files_array = (mount_path_cache_entry_t **) memory_reallocate(
+			                                                  mount_handle->open_files_array,
+			                                                  sizeof( mount_path_cache_entry_t * ) * number_of_open_files_entries );
+		}
+		if( open_files_array == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize open files array.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			mount_handle->open_files_array = open_files_array;
+
+			for( open_file_index = mount_handle->number_of_open_files_entries;
+			     open_file_index < number_of_open_files_entries;
+			     open_file_index++ )
+			{
+				mount_handle->open_files_array[ open_file_index ] = NULL;
+			}
+			open_file_index = mount_handle->number_of_open_files_entries;
+
+			mount_handle->number_of_open_files_entries = number_of_open_files_entries;
+		}
+	}
+	if( result == 1 )
+	{
+		mount_handle->open_files_array[ open_file_index ] = *cache_entry;
+
+		*cache_entry = NULL;
+		*file_handle = (uint64_t) open_file_index + 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     mount_handle->open_files_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the file entry of an open file
+ * The file entry remains owned by the mount handle and is valid until the file is closed
+ * Returns 1 if successful, 0 if no such open file or -1 on error
+ */
+int mount_handle_get_open_file_entry(
+     mount_handle_t *mount_handle,
+     uint64_t file_handle,
+     libewf_file_entry_t **file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_open_file_entry";
+	int result            = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     mount_handle->open_files_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( file_handle > 0 )
+	 && ( file_handle <= (uint64_t) mount_handle->number_of_open_files_entries ) )
+	{
+		if( mount_handle->open_files_array[ file_handle - 1 ] != NULL )
+		{
+			*file_entry = mount_handle->open_files_array[ file_handle - 1 ]->file_entry;
+
+			result = 1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     mount_handle->open_files_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Removes a file from the open files and releases its path cache entry
+ * Returns 1 if successful, 0 if no such open file or -1 on error
+ */
+int mount_handle_close_file(
+     mount_handle_t *mount_handle,
+     uint64_t file_handle,
+     libcerror_error_t **error )
+{
+	mount_path_cache_entry_t *cache_entry = NULL;
+	static char *function                 = "mount_handle_close_file";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     mount_handle->open_files_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( file_handle > 0 )
+	 && ( file_handle <= (uint64_t) mount_handle->number_of_open_files_entries ) )
+	{
+		cache_entry = mount_handle->open_files_array[ file_handle - 1 ];
+
+		mount_handle->open_files_array[ file_handle - 1 ] = NULL;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     mount_handle->open_files_read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( cache_entry == NULL )
+	{
+		return( 0 );
+	}
+	if( mount_path_cache_release_entry(
+	     mount_handle->path_cache,
+	     &cache_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release path cache entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the number of input handles
  * Returns 1 if successful or -1 on error
  */
@@ -27,12 +27,18 @@
 #include <types.h>
 
 #include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
+#include "mount_path_cache.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The maximum number of file entries in the path cache
+ */
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_CACHED_FILE_ENTRIES	16384
+
 enum MOUNT_HANDLE_INPUT_FORMATS
 {
 	MOUNT_HANDLE_INPUT_FORMAT_FILES	= (int) 'f',
@@ -55,6 +61,24 @@ struct mount_handle
 	 */
 	libewf_file_entry_t *root_file_entry;
 
+	/* The path cache
+	 */
+	mount_path_cache_t *path_cache;
+
+	/* The open files array, the file handle is the array index + 1
+	 */
+	mount_path_cache_entry_t **open_files_array;
+
+	/* The number of allocated open files array entries
+	 */
+	int number_of_open_files_entries;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The open files read/write lock
+	 */
+	libcthreads_read_write_lock_t *open_files_read_write_lock;
+#endif
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -98,6 +122,13 @@ ssize_t mount_handle_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 off64_t mount_handle_seek_offset(
          mount_handle_t *mount_handle,
          off64_t offset,
@@ -117,6 +148,36 @@ int mount_handle_get_file_entry_by_path(
      libewf_file_entry_t **file_entry,
      libcerror_error_t **error );
 
+int mount_handle_get_cached_file_entry_by_path(
+     mount_handle_t *mount_handle,
+     const system_character_t *path,
+     size_t path_length,
+     system_character_t path_separator,
+     mount_path_cache_entry_t **cache_entry,
+     libcerror_error_t **error );
+
+int mount_handle_release_cached_file_entry(
+     mount_handle_t *mount_handle,
+     mount_path_cache_entry_t **cache_entry,
+     libcerror_error_t **error );
+
+int mount_handle_open_file(
+     mount_handle_t *mount_handle,
+     mount_path_cache_entry_t **cache_entry,
+     uint64_t *file_handle,
+     libcerror_error_t **error );
+
+int mount_handle_get_open_file_entry(
+     mount_handle_t *mount_handle,
+     uint64_t file_handle,
+     libewf_file_entry_t **file_entry,
+     libcerror_error_t **error );
+
+int mount_handle_close_file(
+     mount_handle_t *mount_handle,
+     uint64_t file_handle,
+     libcerror_error_t **error );
+
 int mount_handle_get_number_of_input_handles(
      mount_handle_t *mount_handle,
      int *number_of_input_handles,
@@ -0,0 +1,930 @@
+/*
+ * Mount path cache
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "ewftools_libfcache.h"
+#include "mount_path_cache.h"
+
+/* Calculates the hash of a path
+ * Uses the 64-bit Fowler-Noll-Vo (FNV-1a) hash, which is used as the offset
+ * of the cache value identifier
+ */
+static off64_t mount_path_cache_calculate_hash(
+                const system_character_t *path,
+                size_t path_length )
+{
+	size_t path_index  = 0;
+	uint64_t path_hash = 0xcbf29ce484222325ULL;
+
+	for( path_index = 0;
+	     path_index < path_length;
+	     path_index++ )
+	{
+		path_hash ^= (uint64_t) path[ path_index ];
+		path_hash *= 0x00000100000001b3ULL;
+	}
+	return( (off64_t) path_hash );
+}
+
+/* Frees a path cache entry and its file entry
+ * Returns 1 if successful or -1 on error
+ */
+static int mount_path_cache_entry_free(
+            mount_path_cache_entry_t **entry,
+            libcerror_error_t **error )
+{
+	static char *function = "mount_path_cache_entry_free";
+	int result            = 1;
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry != NULL )
+	{
+		if( ( *entry )->file_entry != NULL )
+		{
+			if( libewf_file_entry_free(
+			     &( ( *entry )->file_entry ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file entry.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *entry )->path != NULL )
+		{
+			memory_free(
+			 ( *entry )->path );
+		}
+		memory_free(
+		 *entry );
+
+		*entry = NULL;
+	}
+	return( result );
+}
+
+/* Removes a path cache entry from the cache
+ * This is the free value function of the entries cache, which is called when
+ * an entry is evicted or replaced. An entry that is still referenced is freed
+ * when its last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+static int mount_path_cache_entry_uncache(
+            mount_path_cache_entry_t **entry,
+            libcerror_error_t **error )
+{
+	static char *function = "mount_path_cache_entry_uncache";
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry == NULL )
+	{
+		return( 1 );
+	}
+	( *entry )->is_cached = 0;
+
+	if( ( *entry )->number_of_references > 0 )
+	{
+		*entry = NULL;
+
+		return( 1 );
+	}
+	return( mount_path_cache_entry_free(
+	         entry,
+	         error ) );
+}
+
+/* Retrieves the cached entry of a path
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+static int mount_path_cache_get_cached_entry(
+            mount_path_cache_t *path_cache,
+            const system_character_t *path,
+            size_t path_length,
+            off64_t path_hash,
+            mount_path_cache_entry_t **entry,
+            libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value   = NULL;
+	mount_path_cache_entry_t *cached_entry = NULL;
+	static char *function                  = "mount_path_cache_get_cached_entry";
+	int result                             = 0;
+
+	result = libfcache_cache_get_value_by_identifier(
+	          path_cache->entries_cache,
+	          0,
+	          path_hash,
+	          0,
+	          &cache_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from cache.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfcache_cache_value_get_value(
+	     cache_value,
+	     (intptr_t **) &cached_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry from cache value.",
+		 function );
+
+		return( -1 );
+	}
+	/* A different path with the same hash is handled as not cached
+	 * and is replaced when the path is inserted
+	 */
+	if( ( cached_entry == NULL )
+	 || ( cached_entry->path_length != path_length )
+	 || ( system_string_compare(
+	       cached_entry->path,
+	       path,
+	       path_length ) != 0 ) )
+	{
+		return( 0 );
+	}
+	*entry = cached_entry;
+
+	return( 1 );
+}
+
+/* Creates a path cache
+ * Make sure the value path_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int mount_path_cache_initialize(
+     mount_path_cache_t **path_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_path_cache_initialize";
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid path cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*path_cache = memory_allocate_structure(
+	               mount_path_cache_t );
+
+	if( *path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *path_cache,
+	     0,
+	     sizeof( mount_path_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear path cache.",
+		 function );
+
+		memory_free(
+		 *path_cache );
+
+		*path_cache = NULL;
+
+		return( -1 );
+	}
+	/* Every entry is stored with a value size of 1
+	 */
+	if( libfcache_cache_initialize_with_maximum_size(
+	     &( ( *path_cache )->entries_cache ),
+	     (size64_t) maximum_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create entries cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *path_cache )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *path_cache != NULL )
+	{
+		if( ( *path_cache )->entries_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *path_cache )->entries_cache ),
+			 NULL );
+		}
+		memory_free(
+		 *path_cache );
+
+		*path_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a path cache
+ * The entries must be released before the path cache is freed
+ * Returns 1 if successful or -1 on error
+ */
+int mount_path_cache_free(
+     mount_path_cache_t **path_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_path_cache_free";
+	int result            = 1;
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *path_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( ( *path_cache )->entries_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries cache.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *path_cache )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *path_cache );
+
+		*path_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a referenced entry by its path
+ * The entry must be released with mount_path_cache_release_entry
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int mount_path_cache_get_entry_by_path(
+     mount_path_cache_t *path_cache,
+     const system_character_t *path,
+     size_t path_length,
+     mount_path_cache_entry_t **entry,
+     libcerror_error_t **error )
+{
+	mount_path_cache_entry_t *cached_entry = NULL;
+	static char *function                  = "mount_path_cache_get_entry_by_path";
+	off64_t path_hash                      = 0;
+	int result                             = 0;
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	path_hash = mount_path_cache_calculate_hash(
+	             path,
+	             path_length );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     path_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = mount_path_cache_get_cached_entry(
+	          path_cache,
+	          path,
+	          path_length,
+	          path_hash,
+	          &cached_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cached entry.",
+		 function );
+	}
+	else if( result != 0 )
+	{
+		cached_entry->number_of_references += 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     path_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == 1 )
+	{
+		*entry = cached_entry;
+	}
+	return( result );
+}
+
+/* Inserts a file entry into the path cache and retrieves its referenced entry
+ * The path cache takes over the file entry. If another thread inserted the same path
+ * in the meantime the file entry is freed and the existing entry is retrieved instead.
+ * When the path cache is full the least recently used entries are evicted, entries
+ * that are still referenced are freed when they are released.
+ * The entry must be released with mount_path_cache_release_entry
+ * Returns 1 if successful or -1 on error
+ */
+int mount_path_cache_insert_entry(
+     mount_path_cache_t *path_cache,
+     const system_character_t *path,
+     size_t path_length,
+     libewf_file_entry_t **file_entry,
+     mount_path_cache_entry_t **entry,
+     libcerror_error_t **error )
+{
+	mount_path_cache_entry_t *cached_entry = NULL;
+	mount_path_cache_entry_t *new_entry    = NULL;
+	static char *function                  = "mount_path_cache_insert_entry";
+	off64_t path_hash                      = 0;
+	int result                             = 0;
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_length == 0 )
+	 || ( path_length > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	path_hash = mount_path_cache_calculate_hash(
+	             path,
+	             path_length );
+
+	new_entry = memory_allocate_structure(
+	             mount_path_cache_entry_t );
+
+	if( new_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     new_entry,
+	     0,
+	     sizeof( mount_path_cache_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry.",
+		 function );
+
+		memory_free(
+		 new_entry );
+
+		return( -1 );
+	}
+	new_entry->path = system_string_allocate(
+	                   path_length + 1 );
+
+	if( new_entry->path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     new_entry->path,
+	     path,
+	     path_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy path.",
+		 function );
+
+		goto on_error;
+	}
+	new_entry->path[ path_length ] = 0;
+
+	new_entry->path_length          = path_length;
+	new_entry->number_of_references = 1;
+	new_entry->is_cached            = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     path_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = mount_path_cache_get_cached_entry(
+	          path_cache,
+	          path,
+	          path_length,
+	          path_hash,
+	          &cached_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cached entry.",
+		 function );
+	}
+	else if( result != 0 )
+	{
+		cached_entry->number_of_references += 1;
+	}
+	else
+	{
+		new_entry->file_entry = *file_entry;
+		*file_entry           = NULL;
+
+		/* The cache frees the least recently used entries that exceed its maximum size
+		 * with mount_path_cache_entry_uncache
+		 */
+		result = libfcache_cache_set_value_by_identifier(
+		          path_cache->entries_cache,
+		          0,
+		          path_hash,
+		          0,
+		          (intptr_t *) new_entry,
+		          1,
+		          (int (*)(intptr_t **, libcerror_error_t **)) &mount_path_cache_entry_uncache,
+		          LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set entry in cache.",
+			 function );
+
+			/* The cache only takes over the entry if it was inserted
+			 */
+			if( ( mount_path_cache_get_cached_entry(
+			       path_cache,
+			       path,
+			       path_length,
+			       path_hash,
+			       &cached_entry,
+			       NULL ) == 1 )
+			 && ( cached_entry == new_entry ) )
+			{
+				new_entry->number_of_references = 0;
+
+				new_entry = NULL;
+			}
+			else
+			{
+				*file_entry           = new_entry->file_entry;
+				new_entry->file_entry = NULL;
+			}
+			cached_entry = NULL;
+			result       = -1;
+		}
+		else
+		{
+			cached_entry = new_entry;
+			new_entry    = NULL;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     path_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( new_entry != NULL )
+	{
+		/* The path was inserted by another thread or the lookup failed
+		 */
+		if( mount_path_cache_entry_free(
+		     &new_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entry.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_file_entry_free(
+		     file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file entry.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	*entry = cached_entry;
+
+	return( 1 );
+
+on_error:
+	if( new_entry != NULL )
+	{
+		if( new_entry->path != NULL )
+		{
+			memory_free(
+			 new_entry->path );
+		}
+		memory_free(
+		 new_entry );
+	}
+	return( -1 );
+}
+
+/* Releases a referenced entry
+ * An entry that was evicted from the path cache is freed when its last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int mount_path_cache_release_entry(
+     mount_path_cache_t *path_cache,
+     mount_path_cache_entry_t **entry,
+     libcerror_error_t **error )
+{
+	mount_path_cache_entry_t *evicted_entry = NULL;
+	static char *function                   = "mount_path_cache_release_entry";
+
+	if( path_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     path_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( *entry )->number_of_references > 0 )
+	{
+		( *entry )->number_of_references -= 1;
+	}
+	if( ( ( *entry )->number_of_references == 0 )
+	 && ( ( *entry )->is_cached == 0 ) )
+	{
+		evicted_entry = *entry;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     path_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*entry = NULL;
+
+	if( evicted_entry != NULL )
+	{
+		if( mount_path_cache_entry_free(
+		     &evicted_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free evicted entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,111 @@
+/*
+ * Mount path cache
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MOUNT_PATH_CACHE_H )
+#define _MOUNT_PATH_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "ewftools_libfcache.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct mount_path_cache_entry mount_path_cache_entry_t;
+
+struct mount_path_cache_entry
+{
+	/* The path
+	 */
+	system_character_t *path;
+
+	/* The path length
+	 */
+	size_t path_length;
+
+	/* The file entry
+	 */
+	libewf_file_entry_t *file_entry;
+
+	/* The number of references
+	 */
+	int number_of_references;
+
+	/* Value to indicate the entry is stored in the cache
+	 */
+	uint8_t is_cached;
+};
+
+typedef struct mount_path_cache mount_path_cache_t;
+
+struct mount_path_cache
+{
+	/* The entries cache, which is bounded by the number of entries
+	 */
+	libfcache_cache_t *entries_cache;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int mount_path_cache_initialize(
+     mount_path_cache_t **path_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int mount_path_cache_free(
+     mount_path_cache_t **path_cache,
+     libcerror_error_t **error );
+
+int mount_path_cache_get_entry_by_path(
+     mount_path_cache_t *path_cache,
+     const system_character_t *path,
+     size_t path_length,
+     mount_path_cache_entry_t **entry,
+     libcerror_error_t **error );
+
+int mount_path_cache_insert_entry(
+     mount_path_cache_t *path_cache,
+     const system_character_t *path,
+     size_t path_length,
+     libewf_file_entry_t **file_entry,
+     mount_path_cache_entry_t **entry,
+     libcerror_error_t **error );
+
+int mount_path_cache_release_entry(
+     mount_path_cache_t *path_cache,
+     mount_path_cache_entry_t **entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MOUNT_PATH_CACHE_H ) */
+
@@ -120,12 +120,13 @@ int storage_media_buffer_initialize(
 	}
 	if( size > 0 )
 	{
-/* TODO can low level functions and direct IO be combined ? */
+/* The raw buffer is aligned so the storage media can be read using direct IO
+ */
 #if defined( memory_allocate_aligned )
 		if( memory_allocate_aligned(
 		     (void **) &( ( *buffer )->raw_buffer ),
 		     size,
-		     512 ) != 0 )
+		     STORAGE_MEDIA_BUFFER_ALIGNMENT ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
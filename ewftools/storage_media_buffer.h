@@ -38,6 +38,11 @@ enum STORAGE_MEDIA_BUFFER_MODES
 	STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA	= 1
 };
 
+/* The alignment of the raw buffer, which is the largest
+ * logical block size that direct IO requires
+ */
+#define STORAGE_MEDIA_BUFFER_ALIGNMENT	4096
+
 typedef struct storage_media_buffer storage_media_buffer_t;
 
 struct storage_media_buffer
@@ -50,6 +55,10 @@ struct storage_media_buffer
 	 */
 	off64_t storage_media_offset;
 
+	/* The sequence number, used to output the buffers in order
+	 */
+	uint64_t sequence_number;
+
 	/* The raw buffer
 	 */
 	uint8_t *raw_buffer;
@@ -0,0 +1,739 @@
+/*
+ * Storage media buffer reorder ring functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder_ring.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a reorder ring
+ * Make sure the value reorder_ring is referencing, is set to NULL
+ * The number of slots should be at least the number of storage media buffers
+ * that can be in use at the same time, otherwise insert has to wait for output
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_ring_initialize(
+     storage_media_buffer_reorder_ring_t **reorder_ring,
+     int number_of_slots,
+     libcerror_error_t **error )
+{
+	static char *function     = "storage_media_buffer_reorder_ring_initialize";
+	size_t buffers_array_size = 0;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder_ring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reorder ring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_slots <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of slots value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if SIZEOF_INT <= SIZEOF_SIZE_T
+	if( (size_t) number_of_slots > (size_t) ( SSIZE_MAX / sizeof( storage_media_buffer_t * ) ) )
+#else
+	if( number_of_slots > (int) ( SSIZE_MAX / sizeof( storage_media_buffer_t * ) ) )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of slots value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*reorder_ring = memory_allocate_structure(
+	                 storage_media_buffer_reorder_ring_t );
+
+	if( *reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reorder ring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reorder_ring,
+	     0,
+	     sizeof( storage_media_buffer_reorder_ring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reorder ring.",
+		 function );
+
+		memory_free(
+		 *reorder_ring );
+
+		*reorder_ring = NULL;
+
+		return( -1 );
+	}
+	buffers_array_size = sizeof( storage_media_buffer_t * ) * number_of_slots;
+
+	( *reorder_ring )->buffers_array = (storage_media_buffer_t **) memory_allocate(
+	                                                                buffers_array_size );
+
+	if( ( *reorder_ring )->buffers_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers array.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reorder_ring )->buffers_array,
+	     0,
+	     buffers_array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffers array.",
+		 function );
+
+		goto on_error;
+	}
+	( *reorder_ring )->number_of_slots = number_of_slots;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *reorder_ring )->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *reorder_ring )->output_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create output condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *reorder_ring )->insert_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create insert condition.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *reorder_ring != NULL )
+	{
+		if( ( *reorder_ring )->output_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *reorder_ring )->output_condition ),
+			 NULL );
+		}
+		if( ( *reorder_ring )->condition_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *reorder_ring )->condition_mutex ),
+			 NULL );
+		}
+		if( ( *reorder_ring )->buffers_array != NULL )
+		{
+			memory_free(
+			 ( *reorder_ring )->buffers_array );
+		}
+		memory_free(
+		 *reorder_ring );
+
+		*reorder_ring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a reorder ring
+ * The buffers that were not output are released onto the storage media buffer queue
+ * or freed if no queue is provided
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_ring_free(
+     storage_media_buffer_reorder_ring_t **reorder_ring,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_ring_free";
+	int result            = 1;
+	int slot_index        = 0;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder_ring != NULL )
+	{
+		for( slot_index = 0;
+		     slot_index < ( *reorder_ring )->number_of_slots;
+		     slot_index++ )
+		{
+			if( ( *reorder_ring )->buffers_array[ slot_index ] == NULL )
+			{
+				continue;
+			}
+			if( storage_media_buffer_queue != NULL )
+			{
+				if( storage_media_buffer_queue_release_buffer(
+				     storage_media_buffer_queue,
+				     ( *reorder_ring )->buffers_array[ slot_index ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to release storage media buffer: %d onto queue.",
+					 function,
+					 slot_index );
+
+					result = -1;
+				}
+			}
+			else if( storage_media_buffer_free(
+			          &( ( *reorder_ring )->buffers_array[ slot_index ] ),
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free storage media buffer: %d.",
+				 function,
+				 slot_index );
+
+				result = -1;
+			}
+			( *reorder_ring )->buffers_array[ slot_index ] = NULL;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *reorder_ring )->insert_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free insert condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *reorder_ring )->output_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *reorder_ring )->condition_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *reorder_ring )->buffers_array );
+
+		memory_free(
+		 *reorder_ring );
+
+		*reorder_ring = NULL;
+	}
+	return( result );
+}
+
+/* Sets the sequence number of a storage media buffer
+ * The buffers must be submitted in storage media order by a single thread
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_ring_set_sequence_number(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_ring_set_sequence_number";
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->sequence_number = reorder_ring->next_sequence_number;
+
+	reorder_ring->next_sequence_number += 1;
+
+	return( 1 );
+}
+
+/* Inserts a storage media buffer into the slot of its sequence number
+ * Only the insert of the next buffer to output wakes up the output thread
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_ring_insert(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_ring_insert";
+	int slot_index        = 0;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     reorder_ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->sequence_number < reorder_ring->output_sequence_number )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid storage media buffer - sequence number value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* Wait until the sequence number is within the window of the ring
+	 */
+	while( ( storage_media_buffer->sequence_number - reorder_ring->output_sequence_number ) >= (uint64_t) reorder_ring->number_of_slots )
+	{
+		if( reorder_ring->is_closed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid reorder ring - ring was closed.",
+			 function );
+
+			goto on_error;
+		}
+		reorder_ring->number_of_insert_waiters += 1;
+
+		if( libcthreads_condition_wait(
+		     reorder_ring->insert_condition,
+		     reorder_ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for insert condition.",
+			 function );
+
+			reorder_ring->number_of_insert_waiters -= 1;
+
+			goto on_error;
+		}
+		reorder_ring->number_of_insert_waiters -= 1;
+	}
+	slot_index = (int) ( storage_media_buffer->sequence_number % (uint64_t) reorder_ring->number_of_slots );
+
+	if( reorder_ring->buffers_array[ slot_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reorder ring - slot: %d value already set.",
+		 function,
+		 slot_index );
+
+		goto on_error;
+	}
+	reorder_ring->buffers_array[ slot_index ] = storage_media_buffer;
+
+	if( storage_media_buffer->sequence_number == reorder_ring->output_sequence_number )
+	{
+		if( libcthreads_condition_signal(
+		     reorder_ring->output_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal output condition.",
+			 function );
+
+			reorder_ring->buffers_array[ slot_index ] = NULL;
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     reorder_ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 reorder_ring->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Pops the next storage media buffer to output off the ring
+ * Waits until the buffer with the next output sequence number was inserted
+ * Returns 1 if successful, 0 if the ring was closed and the next buffer is not available or -1 on error
+ */
+int storage_media_buffer_reorder_ring_pop(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_ring_pop";
+	int result            = 0;
+	int slot_index        = 0;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     reorder_ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	slot_index = (int) ( reorder_ring->output_sequence_number % (uint64_t) reorder_ring->number_of_slots );
+
+	while( reorder_ring->buffers_array[ slot_index ] == NULL )
+	{
+		if( reorder_ring->is_closed != 0 )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     reorder_ring->output_condition,
+		     reorder_ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for output condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( reorder_ring->buffers_array[ slot_index ] != NULL )
+	{
+		*storage_media_buffer = reorder_ring->buffers_array[ slot_index ];
+
+		reorder_ring->buffers_array[ slot_index ] = NULL;
+
+		reorder_ring->output_sequence_number += 1;
+
+		if( reorder_ring->number_of_insert_waiters > 0 )
+		{
+			if( libcthreads_condition_broadcast(
+			     reorder_ring->insert_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast insert condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		result = 1;
+	}
+	if( libcthreads_mutex_release(
+	     reorder_ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 reorder_ring->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes the reorder ring
+ * The output thread stops once the next buffer to output is not available
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_reorder_ring_close(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_reorder_ring_close";
+	int result            = 1;
+
+	if( reorder_ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     reorder_ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	reorder_ring->is_closed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     reorder_ring->output_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast output condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_condition_broadcast(
+	     reorder_ring->insert_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast insert condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     reorder_ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,116 @@
+/*
+ * Storage media buffer reorder ring functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STORAGE_MEDIA_BUFFER_REORDER_RING_H )
+#define _STORAGE_MEDIA_BUFFER_REORDER_RING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct storage_media_buffer_reorder_ring storage_media_buffer_reorder_ring_t;
+
+struct storage_media_buffer_reorder_ring
+{
+	/* The number of slots, which is the window of sequence numbers
+	 * that can be inserted ahead of the next output sequence number
+	 */
+	int number_of_slots;
+
+	/* The buffers array, a buffer is stored in slot: sequence number % number of slots
+	 */
+	storage_media_buffer_t **buffers_array;
+
+	/* The sequence number of the next buffer that is submitted
+	 */
+	uint64_t next_sequence_number;
+
+	/* The sequence number of the next buffer that is output
+	 */
+	uint64_t output_sequence_number;
+
+	/* The number of threads waiting to insert a buffer
+	 */
+	int number_of_insert_waiters;
+
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The output condition, signalled when the next buffer to output was inserted
+	 */
+	libcthreads_condition_t *output_condition;
+
+	/* The insert condition, signalled when a buffer was output
+	 */
+	libcthreads_condition_t *insert_condition;
+
+	/* Value to indicate the ring was closed
+	 */
+	uint8_t is_closed;
+};
+
+int storage_media_buffer_reorder_ring_initialize(
+     storage_media_buffer_reorder_ring_t **reorder_ring,
+     int number_of_slots,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_ring_free(
+     storage_media_buffer_reorder_ring_t **reorder_ring,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_ring_set_sequence_number(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_ring_insert(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_ring_pop(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_reorder_ring_close(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STORAGE_MEDIA_BUFFER_REORDER_RING_H ) */
+
@@ -27,6 +27,7 @@
 #include <wide_string.h>
 
 #include "byte_size_string.h"
+#include "digest_context.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -43,6 +44,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_reorder_ring.h"
 #include "verification_handle.h"
 
 #define VERIFICATION_HANDLE_VALUE_SIZE			64
@@ -289,17 +291,17 @@ int verification_handle_free(
 
 			result = -1;
 		}
-		if( ( *verification_handle )->md5_context != NULL )
+		if( ( *verification_handle )->digest_context != NULL )
 		{
-			if( libhmac_md5_free(
-			     &( ( *verification_handle )->md5_context ),
+			if( digest_context_free(
+			     &( ( *verification_handle )->digest_context ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free MD5 context.",
+				 "%s: unable to free digest context.",
 				 function );
 
 				result = -1;
@@ -315,22 +317,6 @@ int verification_handle_free(
 			memory_free(
 			 ( *verification_handle )->stored_md5_hash_string );
 		}
-		if( ( *verification_handle )->sha1_context != NULL )
-		{
-			if( libhmac_sha1_free(
-			     &( ( *verification_handle )->sha1_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA1 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *verification_handle )->calculated_sha1_hash_string != NULL )
 		{
 			memory_free(
@@ -341,22 +327,6 @@ int verification_handle_free(
 			memory_free(
 			 ( *verification_handle )->stored_sha1_hash_string );
 		}
-		if( ( *verification_handle )->sha256_context != NULL )
-		{
-			if( libhmac_sha256_free(
-			     &( ( *verification_handle )->sha256_context ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free SHA256 context.",
-				 function );
-
-				result = -1;
-			}
-		}
 		if( ( *verification_handle )->calculated_sha256_hash_string != NULL )
 		{
 			memory_free(
@@ -706,73 +676,35 @@ int verification_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( verification_handle->calculate_md5 != 0 )
+	if( verification_handle->digest_context != NULL )
 	{
-		if( libhmac_md5_initialize(
-		     &( verification_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize MD5 context.",
-			 function );
-
-			goto on_error;
-		}
-		verification_handle->md5_context_initialized = 1;
-	}
-	if( verification_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_initialize(
-		     &( verification_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA1 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - digest context value already set.",
+		 function );
 
-			goto on_error;
-		}
-		verification_handle->sha1_context_initialized = 1;
+		return( -1 );
 	}
-	if( verification_handle->calculate_sha256 != 0 )
+	if( digest_context_initialize(
+	     &( verification_handle->digest_context ),
+	     verification_handle->calculate_md5,
+	     verification_handle->calculate_sha1,
+	     verification_handle->calculate_sha256,
+	     verification_handle->number_of_threads,
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_initialize(
-		     &( verification_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA256 context.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest context.",
+		 function );
 
-			goto on_error;
-		}
-		verification_handle->sha256_context_initialized = 1;
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( verification_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( verification_handle->sha1_context ),
-		 NULL );
-	}
-	if( verification_handle->md5_context != NULL )
-	{
-		libhmac_md5_free(
-		 &( verification_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Updates the integrity hash(es)
@@ -820,59 +752,20 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( verification_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_update(
-		     verification_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( verification_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_update(
-		     verification_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( verification_handle->calculate_sha256 != 0 )
+	if( digest_context_update(
+	     verification_handle->digest_context,
+	     buffer,
+	     buffer_size,
+	     error ) != 1 )
 	{
-		if( libhmac_sha256_update(
-		     verification_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash(es).",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
 	return( 1 );
 }
@@ -901,6 +794,38 @@ int verification_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+	if( digest_context_finalize(
+	     verification_handle->digest_context,
+	     calculated_md5_hash,
+	     LIBHMAC_MD5_HASH_SIZE,
+	     calculated_sha1_hash,
+	     LIBHMAC_SHA1_HASH_SIZE,
+	     calculated_sha256_hash,
+	     LIBHMAC_SHA256_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize digest hash(es).",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context_free(
+	     &( verification_handle->digest_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free digest context.",
+		 function );
+
+		return( -1 );
+	}
 	if( verification_handle->calculate_md5 != 0 )
 	{
 		if( verification_handle->calculated_md5_hash_string == NULL )
@@ -914,34 +839,6 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_md5_finalize(
-		     verification_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_md5_free(
-		     &( verification_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free MD5 context.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_md5_hash,
 		     LIBHMAC_MD5_HASH_SIZE,
@@ -972,34 +869,6 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha1_finalize(
-		     verification_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha1_free(
-		     &( verification_handle->sha1_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free SHA1 context.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_sha1_hash,
 		     LIBHMAC_SHA1_HASH_SIZE,
@@ -1030,34 +899,6 @@ int verification_handle_finalize_integrity_hash(
 
 			return( -1 );
 		}
-		if( libhmac_sha256_finalize(
-		     verification_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( libhmac_sha256_free(
-		     &( verification_handle->sha256_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free SHA256 context.",
-			 function );
-
-			return( -1 );
-		}
 		if( digest_hash_copy_to_string(
 		     calculated_sha256_hash,
 		     LIBHMAC_SHA256_HASH_SIZE,
@@ -1094,326 +935,67 @@ int verification_handle_process_storage_media_buffer_callback(
 
 	if( storage_media_buffer == NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
-
-		goto on_error;
-	}
-	process_count = storage_media_buffer_read_process(
-			 storage_media_buffer,
-			 &error );
-
-	if( process_count < 0 )
-	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_print_error_backtrace(
-			 error );
-		}
-#endif
-		libcerror_error_free(
-		 &error );
-
-		process_count = verification_handle->chunk_size;
-
-		/* Append a read error
-		 */
-		if( verification_handle_append_read_error(
-		     verification_handle,
-		     storage_media_buffer->storage_media_offset,
-		     (size_t) verification_handle->chunk_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append read error.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libcthreads_thread_pool_push_sorted(
-	     verification_handle->output_thread_pool,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
-		 function );
-
-		goto on_error;
-	}
-	storage_media_buffer = NULL;
-
-	return( 1 );
-
-on_error:
-	if( storage_media_buffer != NULL )
-	{
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
-		}
-	}
-	if( error != NULL )
-	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_print_error_backtrace(
-			 error );
-		}
-#endif
-		libcerror_error_free(
-		 &error );
-	}
-	return( -1 );
-}
-
-/* Prepares a storage media buffer for verification
- * Callback function for the process thread pool
- * Returns 1 if successful or -1 on error
- */
-int verification_handle_output_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     verification_handle_t *verification_handle )
-{
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-	uint8_t *data                         = NULL;
-        static char *function                 = "verification_handle_process_storage_media_buffer_callback";
-	size_t data_size                      = 0;
-
-	if( verification_handle == NULL )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid verification handle.",
-		 function );
-
-		goto on_error;
-	}
-	if( storage_media_buffer == NULL )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcdata_list_insert_value(
-	     verification_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
-		 function );
-
-		goto on_error;
-	}
-	storage_media_buffer = NULL;
-
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			goto on_error;
-		}
-		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
-		{
-			break;
-		}
-		if( storage_media_buffer_get_data(
-		     storage_media_buffer,
-		     &data,
-		     &data_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine storage media buffer data.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( verification_handle_update_integrity_hash(
-		     verification_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
 
-			goto on_error;
-		}
-		element = next_element;
+		goto on_error;
+	}
+	process_count = storage_media_buffer_read_process(
+			 storage_media_buffer,
+			 &error );
 
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+	if( process_count < 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
 		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			goto on_error;
+			libcnotify_print_error_backtrace(
+			 error );
 		}
-		storage_media_buffer = NULL;
+#endif
+		libcerror_error_free(
+		 &error );
+
+		process_count = verification_handle->chunk_size;
 
-		if( process_status_update(
-		     verification_handle->process_status,
-		     verification_handle->last_offset_hashed,
-		     verification_handle->media_size,
+		/* Append a read error
+		 */
+		if( verification_handle_append_read_error(
+		     verification_handle,
+		     storage_media_buffer->storage_media_offset,
+		     (size_t) verification_handle->chunk_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update process status.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append read error.",
 			 function );
 
 			goto on_error;
 		}
 	}
+	if( storage_media_buffer_reorder_ring_insert(
+	     verification_handle->output_reorder_ring,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert storage media buffer into output reorder ring.",
+		 function );
+
+		goto on_error;
+	}
+	storage_media_buffer = NULL;
+
 	return( 1 );
 
 on_error:
@@ -1451,133 +1033,146 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Hashes the processed storage media buffers in order of their sequence number
+ * Callback function for the output thread
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_empty_output_list(
-     verification_handle_t *verification_handle,
-     libcerror_error_t **error )
+int verification_handle_output_thread_callback(
+     verification_handle_t *verification_handle )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "verification_handle_empty_output_list";
+        libcerror_error_t *error                     = NULL;
+	uint8_t *data                                = NULL;
+        static char *function                        = "verification_handle_output_thread_callback";
+	size_t data_size                             = 0;
+	int pop_result                               = 0;
+	int result                                   = 1;
 
 	if( verification_handle == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid verification handle.",
-		 function );
-
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	do
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		pop_result = storage_media_buffer_reorder_ring_pop(
+		              verification_handle->output_reorder_ring,
+		              &storage_media_buffer,
+		              &error );
 
-		return( -1 );
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
+		if( pop_result == -1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 "%s: unable to pop storage media buffer from output reorder ring.",
 			 function );
 
-			return( -1 );
+			result = -1;
+
+			break;
 		}
-		if( storage_media_buffer == NULL )
+		else if( pop_result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+			break;
+		}
+		/* After an error the remaining buffers are released without hashing them
+		 * so that the threads that wait for a free storage media buffer do not block
+		 */
+		if( result == 1 )
+		{
+			if( storage_media_buffer_get_data(
+			     storage_media_buffer,
+			     &data,
+			     &data_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine storage media buffer data.",
+				 function );
 
-			return( -1 );
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( verification_handle_update_integrity_hash(
+			     verification_handle,
+			     data,
+			     storage_media_buffer->processed_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to update integrity hash(es).",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == 1 )
+		{
+			verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 		}
 		if( storage_media_buffer_queue_release_buffer(
 		     verification_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
-		     error ) != 1 )
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+
+			result = -1;
 		}
 		storage_media_buffer = NULL;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
+		if( result == 1 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+			if( process_status_update(
+			     verification_handle->process_status,
+			     verification_handle->last_offset_hashed,
+			     verification_handle->media_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
 
-			return( -1 );
+				result = -1;
+			}
 		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+	}
+	while( pop_result == 1 );
 
-			return( -1 );
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			return( -1 );
+			libcnotify_print_error_backtrace(
+			 error );
 		}
-		element = next_element;
+#endif
+		libcerror_error_free(
+		 &error );
 	}
-	return( 1 );
+	return( result );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -1703,13 +1298,14 @@ int verification_handle_verify_input(
 	{
 		maximum_number_of_queued_items = 1 + ( ( 512 * 1024 * 1024 ) / process_buffer_size );
 
-		if( libcthreads_thread_pool_create(
+		if( libcthreads_thread_pool_create_with_flags(
 		     &( verification_handle->process_thread_pool ),
 		     NULL,
 		     verification_handle->number_of_threads,
 		     maximum_number_of_queued_items,
 		     (int (*)(intptr_t *, void *)) &verification_handle_process_storage_media_buffer_callback,
 		     (void *) verification_handle,
+		     LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1721,33 +1317,16 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
-		if( libcthreads_thread_pool_create(
-		     &( verification_handle->output_thread_pool ),
-		     NULL,
-		     1,
+		if( storage_media_buffer_reorder_ring_initialize(
+		     &( verification_handle->output_reorder_ring ),
 		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &verification_handle_output_storage_media_buffer_callback,
-		     (void *) verification_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize output thread pool.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_list_initialize(
-		     &( verification_handle->output_list ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to initialize output reorder ring.",
 			 function );
 
 			goto on_error;
@@ -1815,6 +1394,29 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		/* The output thread updates the process status hence it is created after the process status was started
+		 */
+		if( libcthreads_thread_create(
+		     &( verification_handle->output_thread ),
+		     NULL,
+		     (int (*)(void *)) &verification_handle_output_thread_callback,
+		     (void *) verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output thread.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( verification_handle->number_of_threads == 0 )
 	{
 		if( storage_media_buffer_initialize(
@@ -1914,6 +1516,20 @@ int verification_handle_verify_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
+			if( storage_media_buffer_reorder_ring_set_sequence_number(
+			     verification_handle->output_reorder_ring,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sequence number of storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
 			if( libcthreads_thread_pool_push(
 			     verification_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -2052,47 +1668,50 @@ int verification_handle_verify_input(
 			goto on_error;
 		}
 	}
-	if( verification_handle->output_thread_pool != NULL )
+	if( verification_handle->output_reorder_ring != NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( verification_handle->output_thread_pool ),
+		if( storage_media_buffer_reorder_ring_close(
+		     verification_handle->output_reorder_ring,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 "%s: unable to close output reorder ring.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_thread != NULL )
 	{
-		if( verification_handle_empty_output_list(
-		     verification_handle,
+		if( libcthreads_thread_join(
+		     &( verification_handle->output_thread ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to join output thread.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( verification_handle->output_list ),
-		     NULL,
+	}
+	if( verification_handle->output_reorder_ring != NULL )
+	{
+		if( storage_media_buffer_reorder_ring_free(
+		     &( verification_handle->output_reorder_ring ),
+		     verification_handle->storage_media_buffer_queue,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output reorder ring.",
 			 function );
 
 			goto on_error;
@@ -2344,17 +1963,6 @@ on_error:
 		 &storage_media_buffer,
 		 NULL );
 	}
-	if( verification_handle->process_status != NULL )
-	{
-		process_status_stop(
-		 verification_handle->process_status,
-		 verification_handle->last_offset_hashed,
-		 PROCESS_STATUS_FAILED,
-		 NULL );
-		process_status_free(
-		 &( verification_handle->process_status ),
-		 NULL );
-	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( verification_handle->process_thread_pool != NULL )
 	{
@@ -2362,20 +1970,23 @@ on_error:
 		 &( verification_handle->process_thread_pool ),
 		 NULL );
 	}
-	if( verification_handle->output_thread_pool != NULL )
+	if( verification_handle->output_reorder_ring != NULL )
 	{
-		libcthreads_thread_pool_join(
-		 &( verification_handle->output_thread_pool ),
+		storage_media_buffer_reorder_ring_close(
+		 verification_handle->output_reorder_ring,
 		 NULL );
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_thread != NULL )
 	{
-		verification_handle_empty_output_list(
-		 verification_handle,
+		libcthreads_thread_join(
+		 &( verification_handle->output_thread ),
 		 NULL );
-		libcdata_list_free(
-		 &( verification_handle->output_list ),
-		 NULL,
+	}
+	if( verification_handle->output_reorder_ring != NULL )
+	{
+		storage_media_buffer_reorder_ring_free(
+		 &( verification_handle->output_reorder_ring ),
+		 verification_handle->storage_media_buffer_queue,
 		 NULL );
 	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
@@ -2385,6 +1996,17 @@ on_error:
 		 NULL );
 	}
 #endif
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 verification_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -3634,7 +3256,7 @@ int verification_handle_set_number_of_threads(
 		}
 		result = 1;
 
-		if( number_of_threads > 32 )
+		if( number_of_threads > (uint64_t) INT32_MAX )
 		{
 			result = 0;
 		}
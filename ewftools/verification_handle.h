@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "digest_context.h"
 #include "digest_hash.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
@@ -34,6 +35,7 @@
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_reorder_ring.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -57,17 +59,13 @@ struct verification_handle
 	 */
 	int header_codepage;
 
-	/* Value to indicate if the MD5 digest hash should be calculated
+	/* The digest context
 	 */
-	uint8_t calculate_md5;
+	digest_context_t *digest_context;
 
-	/* The MD5 digest context
-	 */
-	libhmac_md5_context_t *md5_context;
-
-	/* Value to indicate the MD5 digest context was initialized
+	/* Value to indicate if the MD5 digest hash should be calculated
 	 */
-	uint8_t md5_context_initialized;
+	uint8_t calculate_md5;
 
 	/* The calculated MD5 digest hash string
 	 */
@@ -85,14 +83,6 @@ struct verification_handle
 	 */
 	uint8_t calculate_sha1;
 
-	/* The SHA1 digest context
-	 */
-	libhmac_sha1_context_t *sha1_context;
-
-	/* Value to indicate the SHA1 digest context was initialized
-	 */
-	uint8_t sha1_context_initialized;
-
 	/* The calculated SHA1 digest hash string
 	 */
 	system_character_t *calculated_sha1_hash_string;
@@ -109,14 +99,6 @@ struct verification_handle
 	 */
 	uint8_t calculate_sha256;
 
-	/* The SHA256 digest context
-	 */
-	libhmac_sha256_context_t *sha256_context;
-
-	/* Value to indicate the SHA256 digest context was initialized
-	 */
-	uint8_t sha256_context_initialized;
-
 	/* The calculated SHA256 digest hash string
 	 */
 	system_character_t *calculated_sha256_hash_string;
@@ -147,13 +129,13 @@ struct verification_handle
 	 */
 	libcthreads_thread_pool_t *process_thread_pool;
 
-	/* The output thread pool
+	/* The output thread
 	 */
-	libcthreads_thread_pool_t *output_thread_pool;
+	libcthreads_thread_t *output_thread;
 
-	/* The output list
+	/* The output reorder ring
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_reorder_ring_t *output_reorder_ring;
 
 	/* The storage media buffer queue
 	 */
@@ -248,14 +230,9 @@ int verification_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
 
-int verification_handle_output_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
+int verification_handle_output_thread_callback(
      verification_handle_t *verification_handle );
 
-int verification_handle_empty_output_list(
-     verification_handle_t *verification_handle,
-     libcerror_error_t **error );
-
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int verification_handle_verify_input(
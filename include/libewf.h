@@ -358,6 +358,10 @@ ssize_t libewf_handle_read_buffer(
          libewf_error_t **error );
 
 /* Reads (media) data at a specific offset
+ * This function does not change the current offset, use libewf_handle_seek_offset
+ * and libewf_handle_read_buffer to read and advance the current offset
+ * When the handle was opened for reading only, this function can be called
+ * concurrently from multiple threads
  * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
 LIBEWF_EXTERN \
@@ -380,6 +384,36 @@ ssize_t libewf_handle_write_buffer(
          size_t buffer_size,
          libewf_error_t **error );
 
+/* Retrieves a view of the (media) data of the chunk at a specific offset
+ * The view references the cached chunk data instead of copying it and remains
+ * valid until it is released with libewf_handle_release_chunk_view
+ * The data points to the offset in the chunk and the data size contains
+ * the number of bytes from the offset to the end of the chunk
+ * This function does not change the current offset
+ * Chunk views are only supported when the handle was opened for reading only
+ * and must be released before the handle is closed
+ * Chunk views of cached chunks are retrieved and released concurrently
+ * with other calls that hold the read lock
+ * Returns 1 if successful, 0 if the offset is at or beyond the end of the media data or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libewf_error_t **error );
+
+/* Releases a chunk view retrieved with libewf_handle_get_chunk_view
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_release_chunk_view(
+     libewf_handle_t *handle,
+     libewf_chunk_view_t **chunk_view,
+     libewf_error_t **error );
+
 /* Writes (media) data at a specific offset,
  * the necessary settings of the write values must have been made
  * Will initialize write if necessary
@@ -457,6 +491,98 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libewf_error_t **error );
 
+/* Retrieves the maximum size of the chunk cache in bytes
+ * A value of 0 represents the default chunk cache that is bounded by the number of chunks
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t *chunk_cache_size,
+     libewf_error_t **error );
+
+/* Sets the maximum size of the chunk cache in bytes
+ * The chunk cache retains the least recently used chunks up to
+ * the maximum size, a value of 0 restores the default chunk cache
+ * When the handle was opened for reading only, the maximum size applies
+ * to the chunk cache shared by concurrent reads
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t chunk_cache_size,
+     libewf_error_t **error );
+
+/* Sets the number of chunks to read ahead on sequential reads
+ * The chunks read ahead are unpacked by the threads set with
+ * libewf_handle_set_number_of_threads, a value of 0 disables the read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     libewf_error_t **error );
+
+/* Sets the number of threads used to unpack the chunks read ahead
+ * and to pack the chunks written by libewf_handle_write_buffer
+ * The packed chunks are written in order by the calling thread
+ * and the segment files are written with concurrent io_uring writes
+ * A value of 0 disables the additional threads
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libewf_error_t **error );
+
+/* Sets the filename of the index file
+ * The index file contains the layout of the segment files and is used
+ * to open the segment files without scanning their sections
+ * The index file is read when the handle is opened for reading and
+ * is (re)written after the sections were scanned or the write was finalized
+ * The index file is not used if the size or modification time of
+ * a segment file changed since it was written
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libewf_error_t **error );
+
+#if defined( LIBEWF_HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the filename of the index file
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libewf_error_t **error );
+
+#endif /* defined( LIBEWF_HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the value to indicate the segment files should be read on demand
+ * When set only the first and last segment files are read when the handle
+ * is opened for reading, the other segment files are read the first time
+ * the storage media data they contain is accessed
+ * Of the segment files that precede the one that contains the data only
+ * the section descriptors and table headers are read to map the data
+ * Corruption in these segment files is only detected at that time
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_read_segment_files_on_demand(
+     libewf_handle_t *handle,
+     uint8_t read_on_demand,
+     libewf_error_t **error );
+
 /* Retrieves the segment filename size
  * The filename size includes the end of string character
  * Returns 1 if successful, 0 if value not present or -1 on error
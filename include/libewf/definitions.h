@@ -35,20 +35,26 @@
  * bit 2							set to 1 for write access
  * bit 3-4							not used
  * bit 5        set to 1 to resume write
- * bit 6-8							not used
+ * bit 6        set to 1 to memory map the segment files for read
+ * bit 7        set to 1 to bypass the system cache when writing the segment files
+ * bit 8							not used
  */
 enum LIBEWF_ACCESS_FLAGS
 {
 	LIBEWF_ACCESS_FLAG_READ					= 0x01,
 	LIBEWF_ACCESS_FLAG_WRITE				= 0x02,
 
-	LIBEWF_ACCESS_FLAG_RESUME				= 0x10
+	LIBEWF_ACCESS_FLAG_RESUME				= 0x10,
+	LIBEWF_ACCESS_FLAG_MEMORY_MAP				= 0x20,
+	LIBEWF_ACCESS_FLAG_DIRECT_IO				= 0x40
 };
 
 /* The file access macros
  */
 #define LIBEWF_OPEN_READ					( LIBEWF_ACCESS_FLAG_READ )
+#define LIBEWF_OPEN_READ_MEMORY_MAPPED				( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_MEMORY_MAP )
 #define LIBEWF_OPEN_WRITE					( LIBEWF_ACCESS_FLAG_WRITE )
+#define LIBEWF_OPEN_WRITE_DIRECT_IO				( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_DIRECT_IO )
 #define LIBEWF_OPEN_WRITE_RESUME				( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME )
 
 /* The file formats
@@ -201,7 +207,12 @@ enum LIBEWF_CHUNK_DATA_ITEM_FLAGS
 
         /* The data is managed by the chunk data item
 	 */
-	LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA		= 0x01
+	LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA		= 0x01,
+
+	/* The packed data references the mapped data of a segment file
+	 * and is not managed by the chunk data item
+	 */
+	LIBEWF_CHUNK_DATA_ITEM_FLAG_MAPPED_DATA			= 0x02
 };
 
 /* The (single) file entry types
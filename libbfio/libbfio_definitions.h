@@ -64,13 +64,15 @@ enum LIBBFIO_FLAGS
  * bit 1	set to 1 for read access
  * bit 2	set to 1 for write access
  * bit 3	set to 1 to truncate an existing file on write
- * bit 4-8	not used
+ * bit 4	set to 1 to bypass the system cache using direct IO
+ * bit 5-8	not used
  */
 enum LIBBFIO_ACCESS_FLAGS
 {
 	LIBBFIO_ACCESS_FLAG_READ			= 0x01,
 	LIBBFIO_ACCESS_FLAG_WRITE			= 0x02,
-	LIBBFIO_ACCESS_FLAG_TRUNCATE			= 0x04
+	LIBBFIO_ACCESS_FLAG_TRUNCATE			= 0x04,
+	LIBBFIO_ACCESS_FLAG_DIRECT_IO			= 0x08
 };
 
 /* The file access macros
@@ -85,5 +87,18 @@ enum LIBBFIO_ACCESS_FLAGS
 
 #endif /* HAVE_LOCAL_LIBBFIO */
 
+/* The default maximum number of reads or writes the file io_uring handle submits in one batch
+ */
+#define LIBBFIO_FILE_IO_URING_DEFAULT_QUEUE_DEPTH	32
+
+/* The minimum size of a write the file io_uring handle submits
+ * a buffer of at least twice this size is written by multiple writes in one batch
+ */
+#define LIBBFIO_FILE_IO_URING_MINIMUM_WRITE_SIZE	( 512 * 1024 )
+
+/* The maximum number of writes a buffer is split into
+ */
+#define LIBBFIO_FILE_IO_URING_MAXIMUM_NUMBER_OF_WRITE_REQUESTS	16
+
 #endif
 
@@ -192,9 +192,45 @@ int libbfio_file_initialize(
 
 		goto on_error;
 	}
+	file_io_handle = NULL;
+
+	if( libbfio_handle_set_read_at_offset_function(
+	     *handle,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, off64_t, libcerror_error_t **)) libbfio_file_read_at_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read at offset function.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_set_get_modification_time_function(
+	     *handle,
+	     (int (*)(intptr_t *, uint64_t *, libcerror_error_t **)) libbfio_file_get_modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set get modification time function.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
+	if( *handle != NULL )
+	{
+		libbfio_handle_free(
+		 handle,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_file_io_handle_free(
@@ -1316,6 +1352,65 @@ ssize_t libbfio_file_read(
 	return( read_count );
 }
 
+/* Reads a buffer from the file handle at a specific offset
+ * The current offset of the file handle is not changed
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_file_read_at_offset(
+         libbfio_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_read_at_offset";
+	ssize_t read_count    = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libcfile_file_read_buffer_at_offset(
+	              file_io_handle->file,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file: %" PRIs_SYSTEM " at offset: %" PRIi64 ".",
+		 function,
+		 file_io_handle->name,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
 /* Writes a buffer to the file handle
  * Returns the number of bytes written if successful, or -1 on error
  */
@@ -1572,3 +1667,53 @@ int libbfio_file_get_size(
 	return( 1 );
 }
 
+/* Retrieves the file modification time
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_get_modification_time(
+     libbfio_file_io_handle_t *file_io_handle,
+     uint64_t *modification_time,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_get_modification_time";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_get_modification_time(
+	     file_io_handle->file,
+	     modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time of file: %" PRIs_SYSTEM ".",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -165,6 +165,13 @@ ssize_t libbfio_file_read(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t libbfio_file_read_at_offset(
+         libbfio_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libbfio_file_write(
          libbfio_file_io_handle_t *file_io_handle,
          const uint8_t *buffer,
@@ -190,6 +197,11 @@ int libbfio_file_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+int libbfio_file_get_modification_time(
+     libbfio_file_io_handle_t *file_io_handle,
+     uint64_t *modification_time,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
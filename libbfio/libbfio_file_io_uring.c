@@ -0,0 +1,2140 @@
+/*
+ * File io_uring functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_SYSCALL_H )
+#include <sys/syscall.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libbfio_definitions.h"
+#include "libbfio_file.h"
+#include "libbfio_file_io_uring.h"
+#include "libbfio_handle.h"
+#include "libbfio_libcerror.h"
+#include "libbfio_libcfile.h"
+#include "libbfio_types.h"
+
+/* Creates a file io_uring IO handle
+ * Make sure the value file_io_uring_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_io_uring_io_handle_initialize(
+     libbfio_file_io_uring_io_handle_t **file_io_uring_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_io_handle_initialize";
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_uring_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file io_uring IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_uring_io_handle = memory_allocate_structure(
+	                         libbfio_file_io_uring_io_handle_t );
+
+	if( *file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file io_uring IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_uring_io_handle,
+	     0,
+	     sizeof( libbfio_file_io_uring_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file io_uring IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_io_handle_initialize(
+	     &( ( *file_io_uring_io_handle )->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *file_io_uring_io_handle )->queue_depth = LIBBFIO_FILE_IO_URING_DEFAULT_QUEUE_DEPTH;
+
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	( *file_io_uring_io_handle )->ring_descriptor = -1;
+#endif
+	return( 1 );
+
+on_error:
+	if( *file_io_uring_io_handle != NULL )
+	{
+		memory_free(
+		 *file_io_uring_io_handle );
+
+		*file_io_uring_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a file io_uring handle
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_io_uring_initialize(
+     libbfio_handle_t **handle,
+     libcerror_error_t **error )
+{
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_io_uring_io_handle_initialize(
+	     &file_io_uring_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file io_uring IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) file_io_uring_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libbfio_file_io_uring_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libbfio_file_io_uring_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libbfio_file_io_uring_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libbfio_file_io_uring_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libbfio_file_io_uring_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libbfio_file_io_uring_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libbfio_file_io_uring_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libbfio_file_io_uring_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libbfio_file_io_uring_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libbfio_file_io_uring_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_uring_io_handle = NULL;
+
+	if( libbfio_handle_set_read_at_offset_function(
+	     *handle,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, off64_t, libcerror_error_t **)) libbfio_file_io_uring_read_at_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read at offset function.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_set_read_buffers_at_offsets_function(
+	     *handle,
+	     (int (*)(intptr_t *, libbfio_read_request_t *, int, libcerror_error_t **)) libbfio_file_io_uring_read_buffers_at_offsets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read buffers at offsets function.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_set_get_modification_time_function(
+	     *handle,
+	     (int (*)(intptr_t *, uint64_t *, libcerror_error_t **)) libbfio_file_io_uring_get_modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set get modification time function.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libbfio_handle_free(
+		 handle,
+		 NULL );
+	}
+	if( file_io_uring_io_handle != NULL )
+	{
+		libbfio_file_io_uring_io_handle_free(
+		 &file_io_uring_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a file io_uring IO handle
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_io_handle_free(
+     libbfio_file_io_uring_io_handle_t **file_io_uring_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_io_handle_free";
+	int result            = 1;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_uring_io_handle != NULL )
+	{
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+		if( ( *file_io_uring_io_handle )->ring_descriptor != -1 )
+		{
+			if( libbfio_file_io_uring_io_handle_free_ring(
+			     *file_io_uring_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free ring.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_io_uring_io_handle )->io_vectors != NULL )
+		{
+			memory_free(
+			 ( *file_io_uring_io_handle )->io_vectors );
+		}
+#endif
+		if( libbfio_file_io_handle_free(
+		     &( ( *file_io_uring_io_handle )->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *file_io_uring_io_handle );
+
+		*file_io_uring_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the file io_uring IO handle and its attributes
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_io_handle_clone(
+     libbfio_file_io_uring_io_handle_t **destination_file_io_uring_io_handle,
+     libbfio_file_io_uring_io_handle_t *source_file_io_uring_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_io_handle_clone";
+
+	if( destination_file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file_io_uring_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination file io_uring IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_io_uring_io_handle == NULL )
+	{
+		*destination_file_io_uring_io_handle = NULL;
+
+		return( 1 );
+	}
+	*destination_file_io_uring_io_handle = memory_allocate_structure(
+	                                     libbfio_file_io_uring_io_handle_t );
+
+	if( *destination_file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination file io_uring IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *destination_file_io_uring_io_handle,
+	     0,
+	     sizeof( libbfio_file_io_uring_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination file io_uring IO handle.",
+		 function );
+
+		memory_free(
+		 *destination_file_io_uring_io_handle );
+
+		*destination_file_io_uring_io_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_io_handle_clone(
+	     &( ( *destination_file_io_uring_io_handle )->file_io_handle ),
+	     source_file_io_uring_io_handle->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *destination_file_io_uring_io_handle )->queue_depth = source_file_io_uring_io_handle->queue_depth;
+
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	( *destination_file_io_uring_io_handle )->ring_descriptor = -1;
+#endif
+
+	return( 1 );
+
+on_error:
+	if( *destination_file_io_uring_io_handle != NULL )
+	{
+		libbfio_file_io_uring_io_handle_free(
+		 destination_file_io_uring_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the name size of the file io_uring handle
+ * The name size includes the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle                 = NULL;
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_get_name_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle = (libbfio_file_io_uring_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_get_name_size(
+	     file_io_uring_io_handle->file_io_handle,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name size from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of the file io_uring handle
+ * The name size should include the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle                 = NULL;
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_get_name";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle = (libbfio_file_io_uring_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_get_name(
+	     file_io_uring_io_handle->file_io_handle,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the name for the file io_uring handle
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle                 = NULL;
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_set_name";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle = (libbfio_file_io_uring_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_set_name(
+	     file_io_uring_io_handle->file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the name size of the file io_uring handle
+ * The name size includes the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle                 = NULL;
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_get_name_size_wide";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle = (libbfio_file_io_uring_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_get_name_size_wide(
+	     file_io_uring_io_handle->file_io_handle,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name size from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of the file io_uring handle
+ * The name size should include the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle                 = NULL;
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_get_name_wide";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle = (libbfio_file_io_uring_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_get_name_wide(
+	     file_io_uring_io_handle->file_io_handle,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the name for the file io_uring handle
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_set_name_wide(
+     libbfio_handle_t *handle,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle                 = NULL;
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_set_name_wide";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle = (libbfio_file_io_uring_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_set_name_wide(
+	     file_io_uring_io_handle->file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Retrieves the queue depth
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_get_queue_depth(
+     libbfio_handle_t *handle,
+     int *queue_depth,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle                 = NULL;
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_get_queue_depth";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle = (libbfio_file_io_uring_io_handle_t *) internal_handle->io_handle;
+
+	if( queue_depth == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue depth.",
+		 function );
+
+		return( -1 );
+	}
+	*queue_depth = file_io_uring_io_handle->queue_depth;
+
+	return( 1 );
+}
+
+/* Sets the queue depth
+ * The queue depth is the maximum number of reads submitted in one batch
+ * and is applied the next time the handle is opened
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_uring_set_queue_depth(
+     libbfio_handle_t *handle,
+     int queue_depth,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle                 = NULL;
+	libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle = NULL;
+	static char *function                                      = "libbfio_file_io_uring_set_queue_depth";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle = (libbfio_file_io_uring_io_handle_t *) internal_handle->io_handle;
+
+	if( ( queue_depth <= 0 )
+	 || ( queue_depth > 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_uring_io_handle->queue_depth = queue_depth;
+
+	return( 1 );
+}
+
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+
+/* Sets up the ring of the file io_uring IO handle
+ * Returns 1 if successful, 0 if io_uring is not available or -1 on error
+ */
+int libbfio_file_io_uring_io_handle_setup_ring(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error )
+{
+	struct io_uring_params parameters;
+
+	void *mapped_region   = NULL;
+	static char *function = "libbfio_file_io_uring_io_handle_setup_ring";
+	long ring_descriptor  = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_uring_io_handle->ring_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file io_uring IO handle - ring descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &parameters,
+	     0,
+	     sizeof( struct io_uring_params ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parameters.",
+		 function );
+
+		return( -1 );
+	}
+	ring_descriptor = syscall(
+	                   __NR_io_uring_setup,
+	                   (unsigned int) file_io_uring_io_handle->queue_depth,
+	                   &parameters );
+
+	if( ring_descriptor == -1 )
+	{
+		/* The kernel does not support io_uring or its use is not permitted
+		 * in which case the reads fall back to positional reads and the writes
+		 * to regular writes
+		 */
+		return( 0 );
+	}
+	file_io_uring_io_handle->ring_descriptor                    = (int) ring_descriptor;
+	file_io_uring_io_handle->number_of_submission_queue_entries = parameters.sq_entries;
+	file_io_uring_io_handle->submission_queue_offsets           = parameters.sq_off;
+	file_io_uring_io_handle->completion_queue_offsets           = parameters.cq_off;
+	file_io_uring_io_handle->submission_queue_ring_size         = parameters.sq_off.array + ( parameters.sq_entries * sizeof( uint32_t ) );
+	file_io_uring_io_handle->completion_queue_ring_size         = parameters.cq_off.cqes + ( parameters.cq_entries * sizeof( struct io_uring_cqe ) );
+	file_io_uring_io_handle->submission_queue_entries_size      = parameters.sq_entries * sizeof( struct io_uring_sqe );
+
+#if defined( IORING_FEAT_SINGLE_MMAP )
+	/* The submission and completion queue rings share a single mapped region
+	 */
+	if( ( parameters.features & IORING_FEAT_SINGLE_MMAP ) != 0 )
+	{
+		if( file_io_uring_io_handle->completion_queue_ring_size > file_io_uring_io_handle->submission_queue_ring_size )
+		{
+			file_io_uring_io_handle->submission_queue_ring_size = file_io_uring_io_handle->completion_queue_ring_size;
+		}
+		file_io_uring_io_handle->completion_queue_ring_size = 0;
+	}
+#endif
+	mapped_region = mmap(
+	                 NULL,
+	                 file_io_uring_io_handle->submission_queue_ring_size,
+	                 PROT_READ | PROT_WRITE,
+	                 MAP_SHARED | MAP_POPULATE,
+	                 file_io_uring_io_handle->ring_descriptor,
+	                 IORING_OFF_SQ_RING );
+
+	if( mapped_region == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map submission queue ring.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_uring_io_handle->submission_queue_ring = (uint8_t *) mapped_region;
+
+	if( file_io_uring_io_handle->completion_queue_ring_size == 0 )
+	{
+		file_io_uring_io_handle->completion_queue_ring = file_io_uring_io_handle->submission_queue_ring;
+	}
+	else
+	{
+		mapped_region = mmap(
+		                 NULL,
+		                 file_io_uring_io_handle->completion_queue_ring_size,
+		                 PROT_READ | PROT_WRITE,
+		                 MAP_SHARED | MAP_POPULATE,
+		                 file_io_uring_io_handle->ring_descriptor,
+		                 IORING_OFF_CQ_RING );
+
+		if( mapped_region == MAP_FAILED )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to map completion queue ring.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_uring_io_handle->completion_queue_ring = (uint8_t *) mapped_region;
+	}
+	mapped_region = mmap(
+	                 NULL,
+	                 file_io_uring_io_handle->submission_queue_entries_size,
+	                 PROT_READ | PROT_WRITE,
+	                 MAP_SHARED | MAP_POPULATE,
+	                 file_io_uring_io_handle->ring_descriptor,
+	                 IORING_OFF_SQES );
+
+	if( mapped_region == MAP_FAILED )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to map submission queue entries.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_uring_io_handle->submission_queue_entries = (struct io_uring_sqe *) mapped_region;
+
+	return( 1 );
+
+on_error:
+	libbfio_file_io_uring_io_handle_free_ring(
+	 file_io_uring_io_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees the ring of the file io_uring IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_io_uring_io_handle_free_ring(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_io_handle_free_ring";
+	int result            = 1;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_uring_io_handle->submission_queue_entries != NULL )
+	{
+		munmap(
+		 file_io_uring_io_handle->submission_queue_entries,
+		 file_io_uring_io_handle->submission_queue_entries_size );
+
+		file_io_uring_io_handle->submission_queue_entries = NULL;
+	}
+	if( ( file_io_uring_io_handle->completion_queue_ring != NULL )
+	 && ( file_io_uring_io_handle->completion_queue_ring != file_io_uring_io_handle->submission_queue_ring ) )
+	{
+		munmap(
+		 file_io_uring_io_handle->completion_queue_ring,
+		 file_io_uring_io_handle->completion_queue_ring_size );
+	}
+	file_io_uring_io_handle->completion_queue_ring = NULL;
+
+	if( file_io_uring_io_handle->submission_queue_ring != NULL )
+	{
+		munmap(
+		 file_io_uring_io_handle->submission_queue_ring,
+		 file_io_uring_io_handle->submission_queue_ring_size );
+
+		file_io_uring_io_handle->submission_queue_ring = NULL;
+	}
+	if( file_io_uring_io_handle->ring_descriptor != -1 )
+	{
+		if( close(
+		     file_io_uring_io_handle->ring_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close ring descriptor.",
+			 function );
+
+			result = -1;
+		}
+		file_io_uring_io_handle->ring_descriptor = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBBFIO_IO_URING_SUPPORT ) */
+
+/* Opens the file io_uring handle
+ * Falls back to positional reads and regular writes if io_uring is not available
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_io_uring_open(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_open";
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_open(
+	     file_io_uring_io_handle->file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	if( libbfio_file_io_uring_io_handle_setup_ring(
+	     file_io_uring_io_handle,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to set up ring.",
+		 function );
+
+		libbfio_file_close(
+		 file_io_uring_io_handle->file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Closes the file io_uring handle
+ * Returns 0 if successful or -1 on error
+ */
+int libbfio_file_io_uring_close(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_close";
+	int result            = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	if( file_io_uring_io_handle->ring_descriptor != -1 )
+	{
+		if( libbfio_file_io_uring_io_handle_free_ring(
+		     file_io_uring_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free ring.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( libbfio_file_close(
+	     file_io_uring_io_handle->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Reads a buffer from the file io_uring handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_file_io_uring_read(
+         libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_read";
+	ssize_t read_count    = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_file_read(
+	              file_io_uring_io_handle->file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads a buffer from the file io_uring handle at a specific offset
+ * A single read is not worth a submission hence a positional read is used
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_file_io_uring_read_at_offset(
+         libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_read_at_offset";
+	ssize_t read_count    = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_file_read_at_offset(
+	              file_io_uring_io_handle->file_io_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+
+/* Submits read or write requests to the ring and waits for them to complete
+ * The requests are submitted in batches of at most the queue depth and complete in any order
+ * The number of bytes read or written is stored in the read count of each request
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_io_uring_io_handle_submit_requests(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     uint8_t opcode,
+     libbfio_read_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	struct io_uring_sqe *submission_queue_entry = NULL;
+	struct iovec *io_vectors                    = NULL;
+	static char *function                       = "libbfio_file_io_uring_io_handle_submit_requests";
+	uint32_t *completion_queue_head             = NULL;
+	uint32_t *submission_queue_tail             = NULL;
+	uint32_t completion_queue_index             = 0;
+	uint32_t completion_queue_tail              = 0;
+	uint32_t submission_queue_index             = 0;
+	uint32_t submission_queue_tail_value        = 0;
+	long number_of_submitted_entries            = 0;
+	int file_descriptor                         = 0;
+	int io_error                                = LIBCERROR_IO_ERROR_READ_FAILED;
+	int number_of_pending_entries               = 0;
+	int number_of_unsubmitted_entries           = 0;
+	int request_index                           = 0;
+	int result                                  = 1;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_uring_io_handle->ring_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file io_uring IO handle - missing ring descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( opcode != IORING_OP_READV )
+	 && ( opcode != IORING_OP_WRITEV ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported opcode.",
+		 function );
+
+		return( -1 );
+	}
+	if( requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_requests < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of requests value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( opcode == IORING_OP_WRITEV )
+	{
+		io_error = LIBCERROR_IO_ERROR_WRITE_FAILED;
+	}
+	if( libcfile_file_get_descriptor(
+	     file_io_uring_io_handle->file_io_handle->file,
+	     &file_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	/* The IO vectors need to remain valid until the requests have completed
+	 * hence there is an IO vector per request
+	 */
+	if( number_of_requests > file_io_uring_io_handle->number_of_io_vectors )
+	{
+		io_vectors = (struct iovec *) memory_reallocate(
+		                               file_io_uring_io_handle->io_vectors,
+		                               sizeof( struct iovec ) * number_of_requests );
+
+		if( io_vectors == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize IO vectors.",
+			 function );
+
+			return( -1 );
+		}
+		file_io_uring_io_handle->io_vectors           = io_vectors;
+		file_io_uring_io_handle->number_of_io_vectors = number_of_requests;
+	}
+	io_vectors = file_io_uring_io_handle->io_vectors;
+
+	submission_queue_tail = (uint32_t *) &( file_io_uring_io_handle->submission_queue_ring[ file_io_uring_io_handle->submission_queue_offsets.tail ] );
+	completion_queue_head = (uint32_t *) &( file_io_uring_io_handle->completion_queue_ring[ file_io_uring_io_handle->completion_queue_offsets.head ] );
+
+	while( ( number_of_pending_entries > 0 )
+	    || ( ( result == 1 )
+	     &&  ( request_index < number_of_requests ) ) )
+	{
+		submission_queue_tail_value = *submission_queue_tail;
+
+		while( ( result == 1 )
+		    && ( request_index < number_of_requests )
+		    && ( number_of_pending_entries < (int) file_io_uring_io_handle->number_of_submission_queue_entries ) )
+		{
+			submission_queue_index = submission_queue_tail_value
+			                       & *( (uint32_t *) &( file_io_uring_io_handle->submission_queue_ring[ file_io_uring_io_handle->submission_queue_offsets.ring_mask ] ) );
+
+			submission_queue_entry = &( file_io_uring_io_handle->submission_queue_entries[ submission_queue_index ] );
+
+			if( memory_set(
+			     submission_queue_entry,
+			     0,
+			     sizeof( struct io_uring_sqe ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear submission queue entry.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			io_vectors[ request_index ].iov_base = requests[ request_index ].buffer;
+			io_vectors[ request_index ].iov_len  = requests[ request_index ].size;
+
+			submission_queue_entry->opcode    = opcode;
+			submission_queue_entry->fd        = file_descriptor;
+			submission_queue_entry->addr      = (uint64_t) (uintptr_t) &( io_vectors[ request_index ] );
+			submission_queue_entry->len       = 1;
+			submission_queue_entry->off       = (uint64_t) requests[ request_index ].offset;
+			submission_queue_entry->user_data = (uint64_t) request_index;
+
+			( (uint32_t *) &( file_io_uring_io_handle->submission_queue_ring[ file_io_uring_io_handle->submission_queue_offsets.array ] ) )[ submission_queue_index ] = submission_queue_index;
+
+			submission_queue_tail_value++;
+			request_index++;
+
+			number_of_pending_entries++;
+			number_of_unsubmitted_entries++;
+		}
+		/* Make the submission queue entries visible before the tail
+		 */
+		__atomic_store_n(
+		 submission_queue_tail,
+		 submission_queue_tail_value,
+		 __ATOMIC_RELEASE );
+
+		number_of_submitted_entries = syscall(
+		                               __NR_io_uring_enter,
+		                               file_io_uring_io_handle->ring_descriptor,
+		                               (unsigned int) number_of_unsubmitted_entries,
+		                               1,
+		                               IORING_ENTER_GETEVENTS,
+		                               NULL,
+		                               0 );
+
+		if( number_of_submitted_entries == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			/* Without any entries in flight there is nothing to wait for
+			 */
+			if( number_of_pending_entries == number_of_unsubmitted_entries )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 io_error,
+				 errno,
+				 "%s: unable to submit requests.",
+				 function );
+
+				return( -1 );
+			}
+			number_of_submitted_entries = 0;
+		}
+		number_of_unsubmitted_entries -= (int) number_of_submitted_entries;
+
+		completion_queue_index = *completion_queue_head;
+
+		completion_queue_tail = __atomic_load_n(
+		                         (uint32_t *) &( file_io_uring_io_handle->completion_queue_ring[ file_io_uring_io_handle->completion_queue_offsets.tail ] ),
+		                         __ATOMIC_ACQUIRE );
+
+		while( completion_queue_index != completion_queue_tail )
+		{
+			completion_queue_entry = &( ( (struct io_uring_cqe *) &( file_io_uring_io_handle->completion_queue_ring[ file_io_uring_io_handle->completion_queue_offsets.cqes ] ) )[ completion_queue_index & *( (uint32_t *) &( file_io_uring_io_handle->completion_queue_ring[ file_io_uring_io_handle->completion_queue_offsets.ring_mask ] ) ) ] );
+
+			if( completion_queue_entry->res < 0 )
+			{
+				if( result == 1 )
+				{
+					libcerror_system_set_error(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 io_error,
+					 -( completion_queue_entry->res ),
+					 "%s: unable to %s file at offset: %" PRIi64 ".",
+					 function,
+					 ( opcode == IORING_OP_WRITEV ) ? "write to" : "read from",
+					 requests[ completion_queue_entry->user_data ].offset );
+
+					result = -1;
+				}
+			}
+			else
+			{
+				requests[ completion_queue_entry->user_data ].read_count = (ssize_t) completion_queue_entry->res;
+			}
+			completion_queue_index++;
+
+			number_of_pending_entries--;
+		}
+		__atomic_store_n(
+		 completion_queue_head,
+		 completion_queue_index,
+		 __ATOMIC_RELEASE );
+
+		/* Entries that were never submitted are discarded after an error
+		 */
+		if( ( result != 1 )
+		 && ( number_of_pending_entries == number_of_unsubmitted_entries ) )
+		{
+			break;
+		}
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBBFIO_IO_URING_SUPPORT ) */
+
+/* Reads multiple buffers from the file io_uring handle at specific offsets
+ * The reads are submitted in batches of at most the queue depth and complete in any order
+ * The number of bytes read is stored in each read request
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_io_uring_read_buffers_at_offsets(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libbfio_read_request_t *read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	size_t remaining_size  = 0;
+	ssize_t read_count     = 0;
+#endif
+	static char *function  = "libbfio_file_io_uring_read_buffers_at_offsets";
+	int read_request_index = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_requests < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of read requests value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	if( ( file_io_uring_io_handle->ring_descriptor != -1 )
+	 && ( number_of_read_requests > 1 ) )
+	{
+		if( libbfio_file_io_uring_io_handle_submit_requests(
+		     file_io_uring_io_handle,
+		     IORING_OP_READV,
+		     read_requests,
+		     number_of_read_requests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to submit read requests.",
+			 function );
+
+			return( -1 );
+		}
+		/* A short read is completed with a positional read
+		 */
+		for( read_request_index = 0;
+		     read_request_index < number_of_read_requests;
+		     read_request_index++ )
+		{
+			if( ( read_requests[ read_request_index ].read_count <= 0 )
+			 || ( (size_t) read_requests[ read_request_index ].read_count >= read_requests[ read_request_index ].size ) )
+			{
+				continue;
+			}
+			remaining_size = read_requests[ read_request_index ].size - (size_t) read_requests[ read_request_index ].read_count;
+
+			read_count = libbfio_file_read_at_offset(
+			              file_io_uring_io_handle->file_io_handle,
+			              &( read_requests[ read_request_index ].buffer[ read_requests[ read_request_index ].read_count ] ),
+			              remaining_size,
+			              read_requests[ read_request_index ].offset + read_requests[ read_request_index ].read_count,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read remainder from file IO handle at offset: %" PRIi64 ".",
+				 function,
+				 read_requests[ read_request_index ].offset );
+
+				return( -1 );
+			}
+			read_requests[ read_request_index ].read_count += read_count;
+		}
+		return( 1 );
+	}
+#endif /* defined( HAVE_LIBBFIO_IO_URING_SUPPORT ) */
+
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		read_requests[ read_request_index ].read_count = libbfio_file_read_at_offset(
+		                                                  file_io_uring_io_handle->file_io_handle,
+		                                                  read_requests[ read_request_index ].buffer,
+		                                                  read_requests[ read_request_index ].size,
+		                                                  read_requests[ read_request_index ].offset,
+		                                                  error );
+
+		if( read_requests[ read_request_index ].read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file IO handle at offset: %" PRIi64 ".",
+			 function,
+			 read_requests[ read_request_index ].offset );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a buffer to the file io_uring handle
+ * A large buffer is split into writes at consecutive offsets that are submitted
+ * in a single batch of at most the queue depth, unless direct IO is used
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libbfio_file_io_uring_write(
+         libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	libbfio_read_request_t write_requests[ LIBBFIO_FILE_IO_URING_MAXIMUM_NUMBER_OF_WRITE_REQUESTS ];
+
+	size_t remaining_size        = 0;
+	size_t write_request_size    = 0;
+	off64_t offset               = 0;
+	int number_of_write_requests = 0;
+	int write_request_index      = 0;
+#endif
+	static char *function        = "libbfio_file_io_uring_write";
+	ssize_t write_count          = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	if( ( file_io_uring_io_handle->ring_descriptor != -1 )
+	 && ( ( file_io_uring_io_handle->file_io_handle->access_flags & LIBBFIO_ACCESS_FLAG_DIRECT_IO ) == 0 )
+	 && ( buffer != NULL )
+	 && ( size <= (size_t) SSIZE_MAX )
+	 && ( size >= ( 2 * LIBBFIO_FILE_IO_URING_MINIMUM_WRITE_SIZE ) ) )
+	{
+		number_of_write_requests = (int) ( size / LIBBFIO_FILE_IO_URING_MINIMUM_WRITE_SIZE );
+
+		if( number_of_write_requests > LIBBFIO_FILE_IO_URING_MAXIMUM_NUMBER_OF_WRITE_REQUESTS )
+		{
+			number_of_write_requests = LIBBFIO_FILE_IO_URING_MAXIMUM_NUMBER_OF_WRITE_REQUESTS;
+		}
+		if( number_of_write_requests > file_io_uring_io_handle->queue_depth )
+		{
+			number_of_write_requests = file_io_uring_io_handle->queue_depth;
+		}
+	}
+	if( number_of_write_requests > 1 )
+	{
+		offset = libbfio_file_seek_offset(
+		          file_io_uring_io_handle->file_io_handle,
+		          0,
+		          SEEK_CUR,
+		          error );
+
+		if( offset == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to retrieve current offset.",
+			 function );
+
+			return( -1 );
+		}
+		write_request_size = size / number_of_write_requests;
+
+		for( write_request_index = 0;
+		     write_request_index < number_of_write_requests;
+		     write_request_index++ )
+		{
+			write_requests[ write_request_index ].buffer     = (uint8_t *) &( buffer[ write_request_index * write_request_size ] );
+			write_requests[ write_request_index ].size       = write_request_size;
+			write_requests[ write_request_index ].offset     = offset + (off64_t) ( write_request_index * write_request_size );
+			write_requests[ write_request_index ].read_count = 0;
+		}
+		/* The last write contains the remainder of the buffer
+		 */
+		write_requests[ number_of_write_requests - 1 ].size += size % number_of_write_requests;
+
+		if( libbfio_file_io_uring_io_handle_submit_requests(
+		     file_io_uring_io_handle,
+		     IORING_OP_WRITEV,
+		     write_requests,
+		     number_of_write_requests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to submit write requests.",
+			 function );
+
+			return( -1 );
+		}
+		/* A short write is completed with a regular write
+		 */
+		for( write_request_index = 0;
+		     write_request_index < number_of_write_requests;
+		     write_request_index++ )
+		{
+			if( (size_t) write_requests[ write_request_index ].read_count >= write_requests[ write_request_index ].size )
+			{
+				continue;
+			}
+			remaining_size = write_requests[ write_request_index ].size - (size_t) write_requests[ write_request_index ].read_count;
+
+			if( libbfio_file_seek_offset(
+			     file_io_uring_io_handle->file_io_handle,
+			     write_requests[ write_request_index ].offset + write_requests[ write_request_index ].read_count,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek remainder offset.",
+				 function );
+
+				return( -1 );
+			}
+			write_count = libbfio_file_write(
+			               file_io_uring_io_handle->file_io_handle,
+			               &( write_requests[ write_request_index ].buffer[ write_requests[ write_request_index ].read_count ] ),
+			               remaining_size,
+			               error );
+
+			if( write_count != (ssize_t) remaining_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write remainder to file IO handle at offset: %" PRIi64 ".",
+				 function,
+				 write_requests[ write_request_index ].offset );
+
+				return( -1 );
+			}
+		}
+		/* The writes do not change the offset of the file
+		 */
+		if( libbfio_file_seek_offset(
+		     file_io_uring_io_handle->file_io_handle,
+		     offset + (off64_t) size,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset after writes.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) size );
+	}
+#endif /* defined( HAVE_LIBBFIO_IO_URING_SUPPORT ) */
+
+	write_count = libbfio_file_write(
+	               file_io_uring_io_handle->file_io_handle,
+	               buffer,
+	               size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Seeks a certain offset within the file io_uring handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libbfio_file_io_uring_seek_offset(
+         libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_seek_offset";
+	off64_t seek_offset   = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	seek_offset = libbfio_file_seek_offset(
+	               file_io_uring_io_handle->file_io_handle,
+	               offset,
+	               whence,
+	               error );
+
+	if( seek_offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in file IO handle.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( seek_offset );
+}
+
+/* Function to determine if a file io_uring exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libbfio_file_io_uring_exists(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_exists";
+	int result            = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_file_exists(
+	          file_io_uring_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file exists.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Check if the file io_uring is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libbfio_file_io_uring_is_open(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_is_open";
+	int result            = 0;
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_file_is_open(
+	          file_io_uring_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file is open.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the file io_uring size
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_io_uring_get_size(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_get_size";
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_get_size(
+	     file_io_uring_io_handle->file_io_handle,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file io_uring modification time
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_io_uring_get_modification_time(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     uint64_t *modification_time,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_uring_get_modification_time";
+
+	if( file_io_uring_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file io_uring IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_get_modification_time(
+	     file_io_uring_io_handle->file_io_handle,
+	     modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,271 @@
+/*
+ * File io_uring functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBFIO_FILE_IO_URING_H )
+#define _LIBBFIO_FILE_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_UIO_H )
+#include <sys/uio.h>
+#endif
+
+#if defined( HAVE_LINUX_IO_URING_H )
+#include <linux/io_uring.h>
+#endif
+
+#include "libbfio_extern.h"
+#include "libbfio_file.h"
+#include "libbfio_handle.h"
+#include "libbfio_libcerror.h"
+#include "libbfio_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LINUX_IO_URING_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_SYSCALL_H ) && defined( HAVE_SYS_UIO_H ) && !defined( WINAPI )
+#define HAVE_LIBBFIO_IO_URING_SUPPORT
+#endif
+
+typedef struct libbfio_file_io_uring_io_handle libbfio_file_io_uring_io_handle_t;
+
+struct libbfio_file_io_uring_io_handle
+{
+	/* The file IO handle
+	 */
+	libbfio_file_io_handle_t *file_io_handle;
+
+	/* The queue depth
+	 */
+	int queue_depth;
+
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	/* The ring (file) descriptor
+	 * A value of -1 represents that the reads fall back to positional reads
+	 * and the writes to regular writes
+	 */
+	int ring_descriptor;
+
+	/* The number of submission queue entries
+	 */
+	uint32_t number_of_submission_queue_entries;
+
+	/* The submission queue ring
+	 */
+	uint8_t *submission_queue_ring;
+
+	/* The size of the submission queue ring
+	 */
+	size_t submission_queue_ring_size;
+
+	/* The submission queue entries
+	 */
+	struct io_uring_sqe *submission_queue_entries;
+
+	/* The size of the submission queue entries
+	 */
+	size_t submission_queue_entries_size;
+
+	/* The completion queue ring
+	 * Equals the submission queue ring if the kernel maps both in a single region
+	 */
+	uint8_t *completion_queue_ring;
+
+	/* The size of the completion queue ring
+	 */
+	size_t completion_queue_ring_size;
+
+	/* The submission queue offsets
+	 */
+	struct io_sqring_offsets submission_queue_offsets;
+
+	/* The completion queue offsets
+	 */
+	struct io_cqring_offsets completion_queue_offsets;
+
+	/* The IO vectors of the read and write requests
+	 */
+	struct iovec *io_vectors;
+
+	/* The number of IO vectors
+	 */
+	int number_of_io_vectors;
+#endif
+};
+
+int libbfio_file_io_uring_io_handle_initialize(
+     libbfio_file_io_uring_io_handle_t **file_io_uring_io_handle,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_initialize(
+     libbfio_handle_t **handle,
+     libcerror_error_t **error );
+
+int libbfio_file_io_uring_io_handle_free(
+     libbfio_file_io_uring_io_handle_t **file_io_uring_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_io_uring_io_handle_clone(
+     libbfio_file_io_uring_io_handle_t **destination_file_io_uring_io_handle,
+     libbfio_file_io_uring_io_handle_t *source_file_io_uring_io_handle,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_set_name_wide(
+     libbfio_handle_t *handle,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_get_queue_depth(
+     libbfio_handle_t *handle,
+     int *queue_depth,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_io_uring_set_queue_depth(
+     libbfio_handle_t *handle,
+     int queue_depth,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+
+int libbfio_file_io_uring_io_handle_setup_ring(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_io_uring_io_handle_free_ring(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_io_uring_io_handle_submit_requests(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     uint8_t opcode,
+     libbfio_read_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBBFIO_IO_URING_SUPPORT ) */
+
+int libbfio_file_io_uring_open(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libbfio_file_io_uring_close(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libbfio_file_io_uring_read(
+         libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libbfio_file_io_uring_read_at_offset(
+         libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libbfio_file_io_uring_read_buffers_at_offsets(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libbfio_read_request_t *read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error );
+
+ssize_t libbfio_file_io_uring_write(
+         libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libbfio_file_io_uring_seek_offset(
+         libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libbfio_file_io_uring_exists(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_io_uring_is_open(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_io_uring_get_size(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libbfio_file_io_uring_get_modification_time(
+     libbfio_file_io_uring_io_handle_t *file_io_uring_io_handle,
+     uint64_t *modification_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBFIO_FILE_IO_URING_H ) */
+
@@ -0,0 +1,1416 @@
+/*
+ * File mmap functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#include "libbfio_definitions.h"
+#include "libbfio_file.h"
+#include "libbfio_file_mmap.h"
+#include "libbfio_handle.h"
+#include "libbfio_libcerror.h"
+#include "libbfio_libcfile.h"
+#include "libbfio_types.h"
+
+/* Creates a file mmap IO handle
+ * Make sure the value file_mmap_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_mmap_io_handle_initialize(
+     libbfio_file_mmap_io_handle_t **file_mmap_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_io_handle_initialize";
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_mmap_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file mmap IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*file_mmap_io_handle = memory_allocate_structure(
+	                        libbfio_file_mmap_io_handle_t );
+
+	if( *file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file mmap IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_mmap_io_handle,
+	     0,
+	     sizeof( libbfio_file_mmap_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file mmap IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_io_handle_initialize(
+	     &( ( *file_mmap_io_handle )->file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_mmap_io_handle != NULL )
+	{
+		memory_free(
+		 *file_mmap_io_handle );
+
+		*file_mmap_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a file mmap handle
+ * Make sure the value handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_mmap_initialize(
+     libbfio_handle_t **handle,
+     libcerror_error_t **error )
+{
+	libbfio_file_mmap_io_handle_t *file_mmap_io_handle = NULL;
+	static char *function                              = "libbfio_file_mmap_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_mmap_io_handle_initialize(
+	     &file_mmap_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file mmap IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) file_mmap_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libbfio_file_mmap_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libbfio_file_mmap_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libbfio_file_mmap_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libbfio_file_mmap_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libbfio_file_mmap_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libbfio_file_mmap_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libbfio_file_mmap_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libbfio_file_mmap_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libbfio_file_mmap_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libbfio_file_mmap_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	file_mmap_io_handle = NULL;
+
+	if( libbfio_handle_set_read_at_offset_function(
+	     *handle,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, off64_t, libcerror_error_t **)) libbfio_file_mmap_read_at_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read at offset function.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_set_get_mapped_data_at_offset_function(
+	     *handle,
+	     (int (*)(intptr_t *, off64_t, size_t, uint8_t **, libcerror_error_t **)) libbfio_file_mmap_get_mapped_data_at_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set get mapped data at offset function.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_set_get_modification_time_function(
+	     *handle,
+	     (int (*)(intptr_t *, uint64_t *, libcerror_error_t **)) libbfio_file_mmap_get_modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set get modification time function.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libbfio_handle_free(
+		 handle,
+		 NULL );
+	}
+	if( file_mmap_io_handle != NULL )
+	{
+		libbfio_file_mmap_io_handle_free(
+		 &file_mmap_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a file mmap IO handle
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_mmap_io_handle_free(
+     libbfio_file_mmap_io_handle_t **file_mmap_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_io_handle_free";
+	int result            = 1;
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_mmap_io_handle != NULL )
+	{
+#if defined( HAVE_LIBBFIO_MMAP_SUPPORT )
+		if( ( *file_mmap_io_handle )->mapped_data != NULL )
+		{
+			if( munmap(
+			     ( *file_mmap_io_handle )->mapped_data,
+			     ( *file_mmap_io_handle )->mapped_data_size ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 errno,
+				 "%s: unable to unmap data.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( libbfio_file_io_handle_free(
+		     &( ( *file_mmap_io_handle )->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *file_mmap_io_handle );
+
+		*file_mmap_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the file mmap IO handle and its attributes
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_mmap_io_handle_clone(
+     libbfio_file_mmap_io_handle_t **destination_file_mmap_io_handle,
+     libbfio_file_mmap_io_handle_t *source_file_mmap_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_io_handle_clone";
+
+	if( destination_file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file_mmap_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination file mmap IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_mmap_io_handle == NULL )
+	{
+		*destination_file_mmap_io_handle = NULL;
+
+		return( 1 );
+	}
+	*destination_file_mmap_io_handle = memory_allocate_structure(
+	                                    libbfio_file_mmap_io_handle_t );
+
+	if( *destination_file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination file mmap IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *destination_file_mmap_io_handle,
+	     0,
+	     sizeof( libbfio_file_mmap_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear destination file mmap IO handle.",
+		 function );
+
+		memory_free(
+		 *destination_file_mmap_io_handle );
+
+		*destination_file_mmap_io_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_io_handle_clone(
+	     &( ( *destination_file_mmap_io_handle )->file_io_handle ),
+	     source_file_mmap_io_handle->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_file_mmap_io_handle != NULL )
+	{
+		libbfio_file_mmap_io_handle_free(
+		 destination_file_mmap_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the name size of the file mmap handle
+ * The name size includes the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_mmap_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle         = NULL;
+	libbfio_file_mmap_io_handle_t *file_mmap_io_handle = NULL;
+	static char *function                              = "libbfio_file_mmap_get_name_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_mmap_io_handle = (libbfio_file_mmap_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_get_name_size(
+	     file_mmap_io_handle->file_io_handle,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name size from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of the file mmap handle
+ * The name size should include the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_mmap_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle         = NULL;
+	libbfio_file_mmap_io_handle_t *file_mmap_io_handle = NULL;
+	static char *function                              = "libbfio_file_mmap_get_name";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_mmap_io_handle = (libbfio_file_mmap_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_get_name(
+	     file_mmap_io_handle->file_io_handle,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the name for the file mmap handle
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_mmap_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle         = NULL;
+	libbfio_file_mmap_io_handle_t *file_mmap_io_handle = NULL;
+	static char *function                              = "libbfio_file_mmap_set_name";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_mmap_io_handle = (libbfio_file_mmap_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_set_name(
+	     file_mmap_io_handle->file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Retrieves the name size of the file mmap handle
+ * The name size includes the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_mmap_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle         = NULL;
+	libbfio_file_mmap_io_handle_t *file_mmap_io_handle = NULL;
+	static char *function                              = "libbfio_file_mmap_get_name_size_wide";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_mmap_io_handle = (libbfio_file_mmap_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_get_name_size_wide(
+	     file_mmap_io_handle->file_io_handle,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name size from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the name of the file mmap handle
+ * The name size should include the end of string character
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_mmap_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle         = NULL;
+	libbfio_file_mmap_io_handle_t *file_mmap_io_handle = NULL;
+	static char *function                              = "libbfio_file_mmap_get_name_wide";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_mmap_io_handle = (libbfio_file_mmap_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_get_name_wide(
+	     file_mmap_io_handle->file_io_handle,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the name for the file mmap handle
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_mmap_set_name_wide(
+     libbfio_handle_t *handle,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle         = NULL;
+	libbfio_file_mmap_io_handle_t *file_mmap_io_handle = NULL;
+	static char *function                              = "libbfio_file_mmap_set_name_wide";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_mmap_io_handle = (libbfio_file_mmap_io_handle_t *) internal_handle->io_handle;
+
+	if( libbfio_file_io_handle_set_name_wide(
+	     file_mmap_io_handle->file_io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Maps the file of the file mmap handle
+ * Returns 1 if successful, 0 if the file cannot be mapped or -1 on error
+ */
+int libbfio_file_mmap_io_handle_map_file(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBFIO_MMAP_SUPPORT )
+	void *mapped_data     = NULL;
+	size64_t file_size    = 0;
+	int file_descriptor   = -1;
+#endif
+	static char *function = "libbfio_file_mmap_io_handle_map_file";
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_MMAP_SUPPORT )
+	if( file_mmap_io_handle->mapped_data != NULL )
+	{
+		return( 1 );
+	}
+	if( libbfio_file_get_size(
+	     file_mmap_io_handle->file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		return( -1 );
+	}
+	/* Empty files and files that do not fit in the address space are not mapped
+	 */
+	if( ( file_size == 0 )
+	 || ( file_size > (size64_t) SSIZE_MAX ) )
+	{
+		return( 0 );
+	}
+	if( libcfile_file_get_descriptor(
+	     file_mmap_io_handle->file_io_handle->file,
+	     &file_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	mapped_data = mmap(
+	               NULL,
+	               (size_t) file_size,
+	               PROT_READ,
+	               MAP_SHARED,
+	               file_descriptor,
+	               0 );
+
+	/* Files that cannot be mapped, like character devices, are read instead
+	 */
+	if( mapped_data == MAP_FAILED )
+	{
+		return( 0 );
+	}
+	file_mmap_io_handle->mapped_data      = (uint8_t *) mapped_data;
+	file_mmap_io_handle->mapped_data_size = (size_t) file_size;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Opens the file mmap handle
+ * The file is only mapped when opened for reading only
+ * Falls back to positional reads if the file cannot be mapped
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_mmap_open(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_open";
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_open(
+	     file_mmap_io_handle->file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		if( libbfio_file_mmap_io_handle_map_file(
+		     file_mmap_io_handle,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to map file.",
+			 function );
+
+			libbfio_file_close(
+			 file_mmap_io_handle->file_io_handle,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Closes the file mmap handle
+ * The mapped data is kept until the IO handle is freed so that
+ * references to the mapped data remain valid when a pool closes the handle
+ * Returns 0 if successful or -1 on error
+ */
+int libbfio_file_mmap_close(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_close";
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_close(
+	     file_mmap_io_handle->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Reads a buffer from the file mmap handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_file_mmap_read(
+         libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_read";
+	ssize_t read_count    = 0;
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_file_read(
+	              file_mmap_io_handle->file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads a buffer from the file mmap handle at a specific offset
+ * The data is copied from the mapped data if available
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_file_mmap_read_at_offset(
+         libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_read_at_offset";
+	ssize_t read_count    = 0;
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_MMAP_SUPPORT )
+	if( file_mmap_io_handle->mapped_data != NULL )
+	{
+		if( buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid offset value less than zero.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size64_t) offset >= (size64_t) file_mmap_io_handle->mapped_data_size )
+		{
+			return( 0 );
+		}
+		if( size > ( file_mmap_io_handle->mapped_data_size - (size_t) offset ) )
+		{
+			size = file_mmap_io_handle->mapped_data_size - (size_t) offset;
+		}
+		if( memory_copy(
+		     buffer,
+		     &( file_mmap_io_handle->mapped_data[ offset ] ),
+		     size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy mapped data.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) size );
+	}
+#endif
+	read_count = libbfio_file_read_at_offset(
+	              file_mmap_io_handle->file_io_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Retrieves a reference to the mapped data of the file mmap handle at a specific offset
+ * Returns 1 if successful, 0 if the data is not mapped or -1 on error
+ */
+int libbfio_file_mmap_get_mapped_data_at_offset(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     off64_t offset,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_get_mapped_data_at_offset";
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBFIO_MMAP_SUPPORT )
+	if( file_mmap_io_handle->mapped_data == NULL )
+	{
+		return( 0 );
+	}
+	if( ( (size64_t) offset > (size64_t) file_mmap_io_handle->mapped_data_size )
+	 || ( size > ( file_mmap_io_handle->mapped_data_size - (size_t) offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset: %" PRIi64 " and size: %" PRIzu " value out of bounds.",
+		 function,
+		 offset,
+		 size );
+
+		return( -1 );
+	}
+	*data = &( file_mmap_io_handle->mapped_data[ offset ] );
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Writes a buffer to the file mmap handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libbfio_file_mmap_write(
+         libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_write";
+	ssize_t write_count   = 0;
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_file_write(
+	               file_mmap_io_handle->file_io_handle,
+	               buffer,
+	               size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Seeks a certain offset within the file mmap handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libbfio_file_mmap_seek_offset(
+         libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_seek_offset";
+	off64_t seek_offset   = 0;
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	seek_offset = libbfio_file_seek_offset(
+	               file_mmap_io_handle->file_io_handle,
+	               offset,
+	               whence,
+	               error );
+
+	if( seek_offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in file IO handle.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( seek_offset );
+}
+
+/* Function to determine if a file mmap exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libbfio_file_mmap_exists(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_exists";
+	int result            = 0;
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_file_exists(
+	          file_mmap_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file exists.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Check if the file mmap is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libbfio_file_mmap_is_open(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_is_open";
+	int result            = 0;
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_file_is_open(
+	          file_mmap_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file is open.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the file mmap size
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_mmap_get_size(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_get_size";
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_get_size(
+	     file_mmap_io_handle->file_io_handle,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file mmap modification time
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_mmap_get_modification_time(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     uint64_t *modification_time,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_mmap_get_modification_time";
+
+	if( file_mmap_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mmap IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_get_modification_time(
+	     file_mmap_io_handle->file_io_handle,
+	     modification_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
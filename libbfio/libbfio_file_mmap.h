@@ -0,0 +1,191 @@
+/*
+ * File mmap functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBFIO_FILE_MMAP_H )
+#define _LIBBFIO_FILE_MMAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbfio_extern.h"
+#include "libbfio_file.h"
+#include "libbfio_handle.h"
+#include "libbfio_libcerror.h"
+#include "libbfio_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+#define HAVE_LIBBFIO_MMAP_SUPPORT
+#endif
+
+typedef struct libbfio_file_mmap_io_handle libbfio_file_mmap_io_handle_t;
+
+struct libbfio_file_mmap_io_handle
+{
+	/* The file IO handle
+	 */
+	libbfio_file_io_handle_t *file_io_handle;
+
+#if defined( HAVE_LIBBFIO_MMAP_SUPPORT )
+	/* The mapped data
+	 * A value of NULL represents that the reads fall back to positional reads
+	 */
+	uint8_t *mapped_data;
+
+	/* The mapped data size
+	 */
+	size_t mapped_data_size;
+#endif
+};
+
+int libbfio_file_mmap_io_handle_initialize(
+     libbfio_file_mmap_io_handle_t **file_mmap_io_handle,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_mmap_initialize(
+     libbfio_handle_t **handle,
+     libcerror_error_t **error );
+
+int libbfio_file_mmap_io_handle_free(
+     libbfio_file_mmap_io_handle_t **file_mmap_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_mmap_io_handle_clone(
+     libbfio_file_mmap_io_handle_t **destination_file_mmap_io_handle,
+     libbfio_file_mmap_io_handle_t *source_file_mmap_io_handle,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_mmap_get_name_size(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_mmap_get_name(
+     libbfio_handle_t *handle,
+     char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_mmap_set_name(
+     libbfio_handle_t *handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+LIBBFIO_EXTERN \
+int libbfio_file_mmap_get_name_size_wide(
+     libbfio_handle_t *handle,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_mmap_get_name_wide(
+     libbfio_handle_t *handle,
+     wchar_t *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_file_mmap_set_name_wide(
+     libbfio_handle_t *handle,
+     const wchar_t *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libbfio_file_mmap_io_handle_map_file(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_mmap_open(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libbfio_file_mmap_close(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libbfio_file_mmap_read(
+         libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libbfio_file_mmap_read_at_offset(
+         libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libbfio_file_mmap_get_mapped_data_at_offset(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     off64_t offset,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error );
+
+ssize_t libbfio_file_mmap_write(
+         libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libbfio_file_mmap_seek_offset(
+         libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libbfio_file_mmap_exists(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_mmap_is_open(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     libcerror_error_t **error );
+
+int libbfio_file_mmap_get_size(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libbfio_file_mmap_get_modification_time(
+     libbfio_file_mmap_io_handle_t *file_mmap_io_handle,
+     uint64_t *modification_time,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBFIO_FILE_MMAP_H ) */
+
@@ -442,6 +442,11 @@ int libbfio_handle_clone(
 	}
 	destination_io_handle = NULL;
 
+	( (libbfio_internal_handle_t *) *destination_handle )->read_at_offset = internal_source_handle->read_at_offset;
+	( (libbfio_internal_handle_t *) *destination_handle )->read_buffers_at_offsets = internal_source_handle->read_buffers_at_offsets;
+	( (libbfio_internal_handle_t *) *destination_handle )->get_mapped_data_at_offset = internal_source_handle->get_mapped_data_at_offset;
+	( (libbfio_internal_handle_t *) *destination_handle )->get_modification_time     = internal_source_handle->get_modification_time;
+
 	if( libbfio_handle_open(
 	     *destination_handle,
 	     internal_source_handle->access_flags,
@@ -1213,18 +1218,22 @@ on_error:
 	return( -1 );
 }
 
-/* Writes a buffer to the handle
- * Returns the number of bytes written if successful, or -1 on error
+/* Reads a buffer from the handle at a specific offset
+ * If the IO handle provides a read at offset function the current offset
+ * is not changed and concurrent reads only need to share the read lock,
+ * otherwise the offset is sought and the buffer is read using the current offset
+ * Returns the number of bytes read if successful, or -1 on error
  */
-ssize_t libbfio_handle_write_buffer(
+ssize_t libbfio_handle_read_buffer_at_offset(
          libbfio_handle_t *handle,
-         const uint8_t *buffer,
+         uint8_t *buffer,
          size_t size,
+         off64_t offset,
          libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_write_buffer";
-	ssize_t write_count                        = 0;
+	static char *function                      = "libbfio_handle_read_buffer_at_offset";
+	ssize_t read_count                         = 0;
 
 	if( handle == NULL )
 	{
@@ -1250,30 +1259,72 @@ ssize_t libbfio_handle_write_buffer(
 
 		return( -1 );
 	}
-	if( internal_handle->write == NULL )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write function.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( size > (size_t) SSIZE_MAX )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
+	/* Opening on demand and tracking the offsets read require
+	 * the handle to be modified hence these use the sequential read
+	 */
+	if( ( internal_handle->read_at_offset == NULL )
+	 || ( internal_handle->open_on_demand != 0 )
+	 || ( internal_handle->track_offsets_read != 0 ) )
+	{
+		if( libbfio_handle_seek_offset(
+		     handle,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in handle.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		read_count = libbfio_handle_read_buffer(
+		              handle,
+		              buffer,
+		              size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from handle.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1281,37 +1332,33 @@ ssize_t libbfio_handle_write_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	write_count = internal_handle->write(
-	               internal_handle->io_handle,
-	               buffer,
-	               size,
-	               error );
+	read_count = internal_handle->read_at_offset(
+	              internal_handle->io_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
 
-	if( write_count < 0 )
+	if( read_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write to handle.",
-		 function );
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from handle at offset: %" PRIi64 ".",
+		 function,
+		 offset );
 
 		goto on_error;
 	}
-	internal_handle->current_offset += (off64_t) write_count;
-
-	if( (size64_t) internal_handle->current_offset > internal_handle->size )
-	{
-		internal_handle->size = (size64_t) internal_handle->current_offset;
-	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1319,35 +1366,39 @@ ssize_t libbfio_handle_write_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( read_count );
 
 on_error:
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	libcthreads_read_write_lock_release_for_write(
+	libcthreads_read_write_lock_release_for_read(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Seeks a certain offset within the handle
- * Returns the offset if the seek is successful or -1 on error
+/* Reads multiple buffers from the handle at specific offsets
+ * The number of bytes read is stored in each read request
+ * If the IO handle provides a read buffers at offsets function the reads can be
+ * submitted as a single batch, otherwise the buffers are read one at a time
+ * The current offset is not changed if the IO handle provides a read at offset function
+ * Returns 1 if successful or -1 on error
  */
-off64_t libbfio_handle_seek_offset(
-         libbfio_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libbfio_handle_read_buffers_at_offsets(
+     libbfio_handle_t *handle,
+     libbfio_read_request_t *read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_seek_offset";
-	off64_t seek_offset                        = 0;
+	static char *function                      = "libbfio_handle_read_buffers_at_offsets";
+	int read_request_index                     = 0;
 
 	if( handle == NULL )
 	{
@@ -1373,30 +1424,94 @@ off64_t libbfio_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->seek_offset == NULL )
+	if( read_requests == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing seek offset function.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read requests.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( number_of_read_requests < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of read requests value less than zero.",
 		 function );
 
 		return( -1 );
 	}
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		if( read_requests[ read_request_index ].size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid read request: %d size value exceeds maximum.",
+			 function,
+			 read_request_index );
+
+			return( -1 );
+		}
+		if( read_requests[ read_request_index ].offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+			 "%s: invalid read request: %d offset value less than zero.",
+			 function,
+			 read_request_index );
+
+			return( -1 );
+		}
+		read_requests[ read_request_index ].read_count = 0;
+	}
+	/* Opening on demand and tracking the offsets read require
+	 * the handle to be modified hence these use the single buffer read
+	 */
+	if( ( internal_handle->read_buffers_at_offsets == NULL )
+	 || ( internal_handle->open_on_demand != 0 )
+	 || ( internal_handle->track_offsets_read != 0 ) )
+	{
+		for( read_request_index = 0;
+		     read_request_index < number_of_read_requests;
+		     read_request_index++ )
+		{
+			read_requests[ read_request_index ].read_count = libbfio_handle_read_buffer_at_offset(
+			                                                  handle,
+			                                                  read_requests[ read_request_index ].buffer,
+			                                                  read_requests[ read_request_index ].size,
+			                                                  read_requests[ read_request_index ].offset,
+			                                                  error );
+
+			if( read_requests[ read_request_index ].read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from handle at offset: %" PRIi64 ".",
+				 function,
+				 read_requests[ read_request_index ].offset );
+
+				return( -1 );
+			}
+		}
+		return( 1 );
+	}
+	/* The batch submission state of the IO handle is not shared
+	 * hence the read/write lock is grabbed for writing
+	 */
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -1412,26 +1527,21 @@ off64_t libbfio_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	seek_offset = internal_handle->seek_offset(
-	               internal_handle->io_handle,
-	               offset,
-	               whence,
-	               error );
-
-	if( seek_offset == -1 )
+	if( internal_handle->read_buffers_at_offsets(
+	     internal_handle->io_handle,
+	     read_requests,
+	     number_of_read_requests,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 " in handle.",
-		 function,
-		 offset );
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers from handle.",
+		 function );
 
 		goto on_error;
 	}
-	internal_handle->current_offset = seek_offset;
-
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -1447,7 +1557,7 @@ off64_t libbfio_handle_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( seek_offset );
+	return( 1 );
 
 on_error:
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
@@ -1458,15 +1568,19 @@ on_error:
 	return( -1 );
 }
 
-/* Function to determine if a file object exists
- * Returns 1 if file object exists, 0 if not or -1 on error
+/* Retrieves a reference to the mapped data of the handle at a specific offset
+ * The data is owned by the IO handle and remains valid until the handle is freed
+ * Returns 1 if successful, 0 if the data is not mapped or -1 on error
  */
-int libbfio_handle_exists(
+int libbfio_handle_get_mapped_data_at_offset(
      libbfio_handle_t *handle,
+     off64_t offset,
+     size_t size,
+     uint8_t **data,
      libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_exists";
+	static char *function                      = "libbfio_handle_get_mapped_data_at_offset";
 	int result                                 = 0;
 
 	if( handle == NULL )
@@ -1493,17 +1607,48 @@ int libbfio_handle_exists(
 
 		return( -1 );
 	}
-	if( internal_handle->exists == NULL )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing exists function.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Opening on demand and tracking the offsets read require
+	 * the handle to be modified hence these use the buffer reads
+	 */
+	if( ( internal_handle->get_mapped_data_at_offset == NULL )
+	 || ( internal_handle->open_on_demand != 0 )
+	 || ( internal_handle->track_offsets_read != 0 ) )
+	{
+		return( 0 );
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -1519,8 +1664,11 @@ int libbfio_handle_exists(
 		return( -1 );
 	}
 #endif
-	result = internal_handle->exists(
+	result = internal_handle->get_mapped_data_at_offset(
 	          internal_handle->io_handle,
+	          offset,
+	          size,
+	          data,
 	          error );
 
 	if( result == -1 )
@@ -1529,8 +1677,9 @@ int libbfio_handle_exists(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if handle exists.",
-		 function );
+		 "%s: unable to retrieve mapped data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
 
 		goto on_error;
 	}
@@ -1560,16 +1709,18 @@ on_error:
 	return( -1 );
 }
 
-/* Check if the handle is open
- * Returns 1 if open, 0 if not or -1 on error
+/* Writes a buffer to the handle
+ * Returns the number of bytes written if successful, or -1 on error
  */
-int libbfio_handle_is_open(
-     libbfio_handle_t *handle,
-     libcerror_error_t **error )
+ssize_t libbfio_handle_write_buffer(
+         libbfio_handle_t *handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_is_open";
-	int result                                 = 0;
+	static char *function                      = "libbfio_handle_write_buffer";
+	ssize_t write_count                        = 0;
 
 	if( handle == NULL )
 	{
@@ -1595,19 +1746,30 @@ int libbfio_handle_is_open(
 
 		return( -1 );
 	}
-	if( internal_handle->is_open == NULL )
+	if( internal_handle->write == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing is open function.",
+		 "%s: invalid handle - missing write function.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1615,29 +1777,37 @@ int libbfio_handle_is_open(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = internal_handle->is_open(
-	          internal_handle->io_handle,
-	          error );
+	write_count = internal_handle->write(
+	               internal_handle->io_handle,
+	               buffer,
+	               size,
+	               error );
 
-	if( result == -1 )
+	if( write_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if handle is open.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to handle.",
 		 function );
 
 		goto on_error;
 	}
+	internal_handle->current_offset += (off64_t) write_count;
+
+	if( (size64_t) internal_handle->current_offset > internal_handle->size )
+	{
+		internal_handle->size = (size64_t) internal_handle->current_offset;
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1645,33 +1815,756 @@ int libbfio_handle_is_open(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( write_count );
 
 on_error:
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Retrieves the IO handle
- * Returns 1 if successful or -1 on error
+/* Seeks a certain offset within the handle
+ * Returns the offset if the seek is successful or -1 on error
  */
-int libbfio_handle_get_io_handle(
-     libbfio_handle_t *handle,
-     intptr_t **io_handle,
-     libcerror_error_t **error )
+off64_t libbfio_handle_seek_offset(
+         libbfio_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_get_io_handle";
+	static char *function                      = "libbfio_handle_seek_offset";
+	off64_t seek_offset                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->seek_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing seek offset function.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	seek_offset = internal_handle->seek_offset(
+	               internal_handle->io_handle,
+	               offset,
+	               whence,
+	               error );
+
+	if( seek_offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in handle.",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	internal_handle->current_offset = seek_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( seek_offset );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Function to determine if a file object exists
+ * Returns 1 if file object exists, 0 if not or -1 on error
+ */
+int libbfio_handle_exists(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_exists";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->exists == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing exists function.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = internal_handle->exists(
+	          internal_handle->io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if handle exists.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Check if the handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libbfio_handle_is_open(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_is_open";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->is_open == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing is open function.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = internal_handle->is_open(
+	          internal_handle->io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if handle is open.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Determines if the handle supports concurrent reads
+ * Concurrent calls of libbfio_handle_read_buffer_at_offset are only supported
+ * when the handle has a read at offset function and the handle is neither opened
+ * on demand nor tracks the offsets read, otherwise the sequential seek and read is used
+ * Returns 1 if supported, 0 if not or -1 on error
+ */
+int libbfio_handle_supports_concurrent_reads(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_supports_concurrent_reads";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->read_at_offset != NULL )
+	 && ( internal_handle->open_on_demand == 0 )
+	 && ( internal_handle->track_offsets_read == 0 ) )
+	{
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_get_io_handle(
+     libbfio_handle_t *handle,
+     intptr_t **io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_get_io_handle";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*io_handle = internal_handle->io_handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the access flags
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_get_access_flags(
+     libbfio_handle_t *handle,
+     int *access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_get_access_flags";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( access_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid access flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*access_flags = internal_handle->access_flags;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the access flags
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_set_access_flags(
+     libbfio_handle_t *handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_set_access_flags";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->access_flags = access_flags;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Returns the size of the data of the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_get_size(
+     libbfio_handle_t *handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_get_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->size_set == 0 )
+	{
+		if( internal_handle->get_size == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing get size function.",
+			 function );
+
+			goto on_error;
+		}
+		if( internal_handle->get_size(
+		     internal_handle->io_handle,
+		     &( internal_handle->size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size.",
+			 function );
+
+			goto on_error;
+		}
+		internal_handle->size_set = 1;
+	}
+	*size = internal_handle->size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the modification time
+ * The value is platform specific and is meant to detect changes of the data
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libbfio_handle_get_modification_time(
+     libbfio_handle_t *handle,
+     uint64_t *modification_time,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_get_modification_time";
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -1686,17 +2579,32 @@ int libbfio_handle_get_io_handle(
 	}
 	internal_handle = (libbfio_internal_handle_t *) handle;
 
-	if( io_handle == NULL )
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( modification_time == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid modification time.",
 		 function );
 
 		return( -1 );
 	}
+	if( internal_handle->get_modification_time == NULL )
+	{
+		return( 0 );
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -1712,8 +2620,20 @@ int libbfio_handle_get_io_handle(
 		return( -1 );
 	}
 #endif
-	*io_handle = internal_handle->io_handle;
+	result = internal_handle->get_modification_time(
+	          internal_handle->io_handle,
+	          modification_time,
+	          error );
 
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time.",
+		 function );
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -1729,19 +2649,19 @@ int libbfio_handle_get_io_handle(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves the access flags
+/* Retrieves the current offset
  * Returns 1 if successful or -1 on error
  */
-int libbfio_handle_get_access_flags(
+int libbfio_handle_get_offset(
      libbfio_handle_t *handle,
-     int *access_flags,
+     off64_t *offset,
      libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_get_access_flags";
+	static char *function                      = "libbfio_handle_get_offset";
 
 	if( handle == NULL )
 	{
@@ -1756,13 +2676,13 @@ int libbfio_handle_get_access_flags(
 	}
 	internal_handle = (libbfio_internal_handle_t *) handle;
 
-	if( access_flags == NULL )
+	if( offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid access flags.",
+		 "%s: invalid offset.",
 		 function );
 
 		return( -1 );
@@ -1782,7 +2702,7 @@ int libbfio_handle_get_access_flags(
 		return( -1 );
 	}
 #endif
-	*access_flags = internal_handle->access_flags;
+	*offset = internal_handle->current_offset;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -1802,16 +2722,18 @@ int libbfio_handle_get_access_flags(
 	return( 1 );
 }
 
-/* Sets the access flags
+/* Sets the value to have the library open and close
+ * the systems file descriptor or handle on demand
+ * 0 disables open on demand any other value enables it
  * Returns 1 if successful or -1 on error
  */
-int libbfio_handle_set_access_flags(
+int libbfio_handle_set_open_on_demand(
      libbfio_handle_t *handle,
-     int access_flags,
+     uint8_t open_on_demand,
      libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_set_access_flags";
+	static char *function                      = "libbfio_handle_set_open_on_demand";
 
 	if( handle == NULL )
 	{
@@ -1826,14 +2748,14 @@ int libbfio_handle_set_access_flags(
 	}
 	internal_handle = (libbfio_internal_handle_t *) handle;
 
-	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) == 0 )
-	 && ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 ) )
+	if( ( ( internal_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( open_on_demand != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
+		 "%s: open on demand cannot be used in combination with write access.",
 		 function );
 
 		return( -1 );
@@ -1853,7 +2775,7 @@ int libbfio_handle_set_access_flags(
 		return( -1 );
 	}
 #endif
-	internal_handle->access_flags = access_flags;
+	internal_handle->open_on_demand = open_on_demand;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -1873,16 +2795,22 @@ int libbfio_handle_set_access_flags(
 	return( 1 );
 }
 
-/* Returns the size of the data of the handle
+/* Sets the read at offset function
+ * The function is used by libbfio_handle_read_buffer_at_offset when set
  * Returns 1 if successful or -1 on error
  */
-int libbfio_handle_get_size(
+int libbfio_handle_set_read_at_offset_function(
      libbfio_handle_t *handle,
-     size64_t *size,
+     ssize_t (*read_at_offset)(
+                intptr_t *io_handle,
+                uint8_t *buffer,
+                size_t size,
+                off64_t offset,
+                libcerror_error_t **error ),
      libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_get_size";
+	static char *function                      = "libbfio_handle_set_read_at_offset_function";
 
 	if( handle == NULL )
 	{
@@ -1897,28 +2825,70 @@ int libbfio_handle_get_size(
 	}
 	internal_handle = (libbfio_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( size == NULL )
+#endif
+	internal_handle->read_at_offset = read_at_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the read buffers at offsets function
+ * The function is used by libbfio_handle_read_buffers_at_offsets when set
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_set_read_buffers_at_offsets_function(
+     libbfio_handle_t *handle,
+     int (*read_buffers_at_offsets)(
+            intptr_t *io_handle,
+            libbfio_read_request_t *read_requests,
+            int number_of_read_requests,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_set_read_buffers_at_offsets_function";
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -1934,36 +2904,7 @@ int libbfio_handle_get_size(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->size_set == 0 )
-	{
-		if( internal_handle->get_size == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing get size function.",
-			 function );
-
-			goto on_error;
-		}
-		if( internal_handle->get_size(
-		     internal_handle->io_handle,
-		     &( internal_handle->size ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve size.",
-			 function );
-
-			goto on_error;
-		}
-		internal_handle->size_set = 1;
-	}
-	*size = internal_handle->size;
+	internal_handle->read_buffers_at_offsets = read_buffers_at_offsets;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -1981,26 +2922,24 @@ int libbfio_handle_get_size(
 	}
 #endif
 	return( 1 );
-
-on_error:
-#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
 }
 
-/* Retrieves the current offset
+/* Sets the get mapped data at offset function
+ * The function is used by libbfio_handle_get_mapped_data_at_offset when set
  * Returns 1 if successful or -1 on error
  */
-int libbfio_handle_get_offset(
+int libbfio_handle_set_get_mapped_data_at_offset_function(
      libbfio_handle_t *handle,
-     off64_t *offset,
+     int (*get_mapped_data_at_offset)(
+            intptr_t *io_handle,
+            off64_t offset,
+            size_t size,
+            uint8_t **data,
+            libcerror_error_t **error ),
      libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_get_offset";
+	static char *function                      = "libbfio_handle_set_get_mapped_data_at_offset_function";
 
 	if( handle == NULL )
 	{
@@ -2015,19 +2954,8 @@ int libbfio_handle_get_offset(
 	}
 	internal_handle = (libbfio_internal_handle_t *) handle;
 
-	if( offset == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2035,16 +2963,16 @@ int libbfio_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	internal_handle->get_mapped_data_at_offset = get_mapped_data_at_offset;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2052,7 +2980,7 @@ int libbfio_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -2061,18 +2989,20 @@ int libbfio_handle_get_offset(
 	return( 1 );
 }
 
-/* Sets the value to have the library open and close
- * the systems file descriptor or handle on demand
- * 0 disables open on demand any other value enables it
+/* Sets the get modification time function
+ * The function is used by libbfio_handle_get_modification_time when set
  * Returns 1 if successful or -1 on error
  */
-int libbfio_handle_set_open_on_demand(
+int libbfio_handle_set_get_modification_time_function(
      libbfio_handle_t *handle,
-     uint8_t open_on_demand,
+     int (*get_modification_time)(
+            intptr_t *io_handle,
+            uint64_t *modification_time,
+            libcerror_error_t **error ),
      libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_set_open_on_demand";
+	static char *function                      = "libbfio_handle_set_get_modification_time_function";
 
 	if( handle == NULL )
 	{
@@ -2087,18 +3017,6 @@ int libbfio_handle_set_open_on_demand(
 	}
 	internal_handle = (libbfio_internal_handle_t *) handle;
 
-	if( ( ( internal_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
-	 && ( open_on_demand != 0 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: open on demand cannot be used in combination with write access.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -2114,7 +3032,7 @@ int libbfio_handle_set_open_on_demand(
 		return( -1 );
 	}
 #endif
-	internal_handle->open_on_demand = open_on_demand;
+	internal_handle->get_modification_time = get_modification_time;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -35,6 +35,27 @@
 extern "C" {
 #endif
 
+typedef struct libbfio_read_request libbfio_read_request_t;
+
+struct libbfio_read_request
+{
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size of the buffer
+	 */
+	size_t size;
+
+	/* The offset to read from
+	 */
+	off64_t offset;
+
+	/* The number of bytes read
+	 */
+	ssize_t read_count;
+};
+
 typedef struct libbfio_internal_handle libbfio_internal_handle_t;
 
 struct libbfio_internal_handle
@@ -118,6 +139,35 @@ struct libbfio_internal_handle
 	           size_t size,
 	           libcerror_error_t **error );
 
+	/* The read at offset function
+	 * This function is optional and does not change the current offset
+	 */
+	ssize_t (*read_at_offset)(
+	           intptr_t *io_handle,
+	           uint8_t *buffer,
+	           size_t size,
+	           off64_t offset,
+	           libcerror_error_t **error );
+
+	/* The read buffers at offsets function
+	 * This function is optional and does not change the current offset
+	 */
+	int (*read_buffers_at_offsets)(
+	       intptr_t *io_handle,
+	       libbfio_read_request_t *read_requests,
+	       int number_of_read_requests,
+	       libcerror_error_t **error );
+
+	/* The get mapped data at offset function
+	 * This function is optional and does not change the current offset
+	 */
+	int (*get_mapped_data_at_offset)(
+	       intptr_t *io_handle,
+	       off64_t offset,
+	       size_t size,
+	       uint8_t **data,
+	       libcerror_error_t **error );
+
 	/* The write function
 	 */
 	ssize_t (*write)(
@@ -153,6 +203,14 @@ struct libbfio_internal_handle
 	       size64_t *size,
 	       libcerror_error_t **error );
 
+	/* The get modification time function
+	 * This function is optional
+	 */
+	int (*get_modification_time)(
+	       intptr_t *io_handle,
+	       uint64_t *modification_time,
+	       libcerror_error_t **error );
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	/* The read/write lock
 	 */
@@ -241,6 +299,29 @@ ssize_t libbfio_handle_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+ssize_t libbfio_handle_read_buffer_at_offset(
+         libbfio_handle_t *handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_handle_read_buffers_at_offsets(
+     libbfio_handle_t *handle,
+     libbfio_read_request_t *read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_handle_get_mapped_data_at_offset(
+     libbfio_handle_t *handle,
+     off64_t offset,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 ssize_t libbfio_handle_write_buffer(
          libbfio_handle_t *handle,
@@ -265,6 +346,11 @@ int libbfio_handle_is_open(
      libbfio_handle_t *handle,
      libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+int libbfio_handle_supports_concurrent_reads(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 int libbfio_handle_get_io_handle(
      libbfio_handle_t *handle,
@@ -289,6 +375,12 @@ int libbfio_handle_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+int libbfio_handle_get_modification_time(
+     libbfio_handle_t *handle,
+     uint64_t *modification_time,
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 int libbfio_handle_get_offset(
      libbfio_handle_t *handle,
@@ -301,6 +393,43 @@ int libbfio_handle_set_open_on_demand(
      uint8_t open_on_demand,
      libcerror_error_t **error );
 
+int libbfio_handle_set_read_at_offset_function(
+     libbfio_handle_t *handle,
+     ssize_t (*read_at_offset)(
+                intptr_t *io_handle,
+                uint8_t *buffer,
+                size_t size,
+                off64_t offset,
+                libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libbfio_handle_set_read_buffers_at_offsets_function(
+     libbfio_handle_t *handle,
+     int (*read_buffers_at_offsets)(
+            intptr_t *io_handle,
+            libbfio_read_request_t *read_requests,
+            int number_of_read_requests,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libbfio_handle_set_get_mapped_data_at_offset_function(
+     libbfio_handle_t *handle,
+     int (*get_mapped_data_at_offset)(
+            intptr_t *io_handle,
+            off64_t offset,
+            size_t size,
+            uint8_t **data,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libbfio_handle_set_get_modification_time_function(
+     libbfio_handle_t *handle,
+     int (*get_modification_time)(
+            intptr_t *io_handle,
+            uint64_t *modification_time,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 int libbfio_handle_set_track_offsets_read(
      libbfio_handle_t *handle,
@@ -2333,6 +2333,415 @@ ssize_t libbfio_pool_read_buffer(
 	return( read_count );
 }
 
+/* Reads a buffer from a handle in the pool at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbfio_pool_read_buffer_at_offset(
+         libbfio_pool_t *pool,
+         int entry,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_read_buffer_at_offset";
+	ssize_t read_count                     = 0;
+	int access_flags                       = 0;
+	int is_open                            = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_pool->handles_array,
+	     entry,
+	     (intptr_t **) &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           handle,
+	           error );
+
+	if( is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_access_flags(
+		     handle,
+		     &access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve access flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     handle,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	if( internal_pool->maximum_number_of_open_handles != LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+	{
+		if( libbfio_pool_move_handle_to_front_of_last_used_list(
+		     internal_pool,
+		     handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to move handle to front of last used list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from entry: %d at offset: %" PRIi64 ".",
+		 function,
+		 entry,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads multiple buffers at specific offsets from a handle in the pool
+ * The number of bytes read is stored in each read request
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_pool_read_buffers_at_offsets(
+     libbfio_pool_t *pool,
+     int entry,
+     libbfio_read_request_t *read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_read_buffers_at_offsets";
+	int access_flags                       = 0;
+	int is_open                            = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_pool->handles_array,
+	     entry,
+	     (intptr_t **) &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           handle,
+	           error );
+
+	if( is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_access_flags(
+		     handle,
+		     &access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve access flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     handle,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	if( internal_pool->maximum_number_of_open_handles != LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+	{
+		if( libbfio_pool_move_handle_to_front_of_last_used_list(
+		     internal_pool,
+		     handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to move handle to front of last used list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbfio_handle_read_buffers_at_offsets(
+	     handle,
+	     read_requests,
+	     number_of_read_requests,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffers from entry: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a reference to the mapped data of a handle in the pool at a specific offset
+ * Returns 1 if successful, 0 if the data is not mapped or -1 on error
+ */
+int libbfio_pool_get_mapped_data_at_offset(
+     libbfio_pool_t *pool,
+     int entry,
+     off64_t offset,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_get_mapped_data_at_offset";
+	int access_flags                       = 0;
+	int is_open                            = 0;
+	int result                             = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+	if( libcdata_array_get_entry_by_index(
+	     internal_pool->handles_array,
+	     entry,
+	     (intptr_t **) &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		return( -1 );
+	}
+	/* Make sure the handle is open
+	 */
+	is_open = libbfio_handle_is_open(
+	           handle,
+	           error );
+
+	if( is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if entry: %d is open.",
+		 function,
+	         entry );
+
+		return( -1 );
+	}
+	else if( is_open == 0 )
+	{
+		if( libbfio_handle_get_access_flags(
+		     handle,
+		     &access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve access flags.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_pool_open_handle(
+		     internal_pool,
+		     handle,
+		     access_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open entry: %d.",
+			 function,
+			 entry );
+
+			return( -1 );
+		}
+	}
+	if( internal_pool->maximum_number_of_open_handles != LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+	{
+		if( libbfio_pool_move_handle_to_front_of_last_used_list(
+		     internal_pool,
+		     handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to move handle to front of last used list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = libbfio_handle_get_mapped_data_at_offset(
+	          handle,
+	          offset,
+	          size,
+	          data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapped data from entry: %d at offset: %" PRIi64 ".",
+		 function,
+		 entry,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Writes a buffer to a handle in the pool
  * Returns the number of bytes written or -1 on error
  */
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libbfio_extern.h"
+#include "libbfio_handle.h"
 #include "libbfio_libcdata.h"
 #include "libbfio_libcerror.h"
 #include "libbfio_libcthreads.h"
@@ -189,6 +190,32 @@ ssize_t libbfio_pool_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+ssize_t libbfio_pool_read_buffer_at_offset(
+         libbfio_pool_t *pool,
+         int entry,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_pool_read_buffers_at_offsets(
+     libbfio_pool_t *pool,
+     int entry,
+     libbfio_read_request_t *read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_pool_get_mapped_data_at_offset(
+     libbfio_pool_t *pool,
+     int entry,
+     off64_t offset,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 ssize_t libbfio_pool_write_buffer(
          libbfio_pool_t *pool,
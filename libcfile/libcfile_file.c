@@ -19,6 +19,13 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+
+/* Required for O_DIRECT
+ */
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <narrow_string.h>
@@ -653,6 +660,20 @@ int libcfile_file_open_with_error_code(
 	{
 		file_io_flags |= O_TRUNC;
 	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) && defined( O_DIRECT )
+	if( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		/* Partially written blocks are merged with the data in the file
+		 * which requires read access
+		 */
+		if( ( file_io_flags & O_ACCMODE ) == O_WRONLY )
+		{
+			file_io_flags &= ~O_ACCMODE;
+			file_io_flags |= O_RDWR;
+		}
+		file_io_flags |= O_DIRECT;
+	}
+#endif
 	if( error_code == NULL )
 	{
 		libcerror_error_set(
@@ -674,6 +695,22 @@ int libcfile_file_open_with_error_code(
 	                             filename,
 	                             file_io_flags,
 	                             0644 );
+#endif
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) && defined( O_DIRECT )
+	/* Not all file systems support direct IO, in which case
+	 * the file is opened without it
+	 */
+	if( ( internal_file->descriptor == -1 )
+	 && ( ( file_io_flags & O_DIRECT ) != 0 )
+	 && ( errno == EINVAL ) )
+	{
+		file_io_flags &= ~O_DIRECT;
+
+		internal_file->descriptor = open(
+		                             filename,
+		                             file_io_flags,
+		                             0644 );
+	}
 #endif
 	if( internal_file->descriptor == -1 )
 	{
@@ -720,6 +757,40 @@ int libcfile_file_open_with_error_code(
 	internal_file->access_flags   = access_flags;
 	internal_file->current_offset = 0;
 
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) && defined( O_DIRECT )
+	if( ( file_io_flags & O_DIRECT ) != 0 )
+	{
+		if( libcfile_internal_file_initialize_direct_io(
+		     internal_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize direct IO.",
+			 function );
+
+			close(
+			 internal_file->descriptor );
+
+			internal_file->descriptor = -1;
+
+			return( -1 );
+		}
+	}
+#elif defined( F_NOCACHE )
+	if( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		/* F_NOCACHE does not require aligned IO and is only a hint
+		 */
+		fcntl(
+		 internal_file->descriptor,
+		 F_NOCACHE,
+		 1 );
+	}
+#endif
+
 	return( 1 );
 }
 
@@ -1105,6 +1176,20 @@ int libcfile_file_open_wide_with_error_code(
 	{
 		file_io_flags |= O_TRUNC;
 	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) && defined( O_DIRECT )
+	if( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		/* Partially written blocks are merged with the data in the file
+		 * which requires read access
+		 */
+		if( ( file_io_flags & O_ACCMODE ) == O_WRONLY )
+		{
+			file_io_flags &= ~O_ACCMODE;
+			file_io_flags |= O_RDWR;
+		}
+		file_io_flags |= O_DIRECT;
+	}
+#endif
 	if( error_code == NULL )
 	{
 		libcerror_error_set(
@@ -1175,6 +1260,22 @@ int libcfile_file_open_wide_with_error_code(
 	                             file_io_flags,
 	                             0644 );
 #endif
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) && defined( O_DIRECT )
+	/* Not all file systems support direct IO, in which case
+	 * the file is opened without it
+	 */
+	if( ( internal_file->descriptor == -1 )
+	 && ( ( file_io_flags & O_DIRECT ) != 0 )
+	 && ( errno == EINVAL ) )
+	{
+		file_io_flags &= ~O_DIRECT;
+
+		internal_file->descriptor = open(
+		                             narrow_filename,
+		                             file_io_flags,
+		                             0644 );
+	}
+#endif
 
 	memory_free(
 	 narrow_filename );
@@ -1223,6 +1324,43 @@ int libcfile_file_open_wide_with_error_code(
 		}
 		goto on_error;
 	}
+	internal_file->access_flags   = access_flags;
+	internal_file->current_offset = 0;
+
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) && defined( O_DIRECT )
+	if( ( file_io_flags & O_DIRECT ) != 0 )
+	{
+		if( libcfile_internal_file_initialize_direct_io(
+		     internal_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize direct IO.",
+			 function );
+
+			close(
+			 internal_file->descriptor );
+
+			internal_file->descriptor = -1;
+
+			goto on_error;
+		}
+	}
+#elif defined( F_NOCACHE )
+	if( ( access_flags & LIBCFILE_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		/* F_NOCACHE does not require aligned IO and is only a hint
+		 */
+		fcntl(
+		 internal_file->descriptor,
+		 F_NOCACHE,
+		 1 );
+	}
+#endif
+
 	return( 1 );
 
 on_error:
@@ -1347,6 +1485,24 @@ int libcfile_file_close(
 
 	if( internal_file->descriptor != -1 )
 	{
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+		if( internal_file->direct_io_buffer != NULL )
+		{
+			if( libcfile_internal_file_free_direct_io(
+			     internal_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free direct IO.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
 		if( close(
 		     internal_file->descriptor ) != 0 )
 		{
@@ -1389,163 +1545,915 @@ int libcfile_file_close(
 #error Missing file close function
 #endif
 
-/* Reads a buffer from the file
- * Returns the number of bytes read if successful, or -1 on error
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+
+/* Initializes direct IO
+ * The size is retrieved before direct IO is used, since the size of the file
+ * is maintained by the direct IO functions while the file is open
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libcfile_file_read_buffer(
-         libcfile_file_t *file,
-         uint8_t *buffer,
-         size_t size,
-         libcerror_error_t **error )
+int libcfile_internal_file_initialize_direct_io(
+     libcfile_internal_file_t *internal_file,
+     libcerror_error_t **error )
 {
-	static char *function = "libcfile_file_read_buffer";
-	ssize_t read_count    = 0;
-	uint32_t error_code   = 0;
+	static char *function = "libcfile_internal_file_initialize_direct_io";
 
-	read_count = libcfile_file_read_buffer_with_error_code(
-	              file,
-	              buffer,
-	              size,
-	              &error_code,
-	              error );
-
-	if( read_count == -1 )
+	if( internal_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
 		 function );
 
 		return( -1 );
 	}
-	return( read_count );
-}
-
-#if defined( WINAPI ) && ( WINVER <= 0x0500 )
-
-/* Cross Windows safe version of GetOverlappedResult
- * Returns TRUE if successful or FALSE on error
- */
-BOOL libcfile_GetOverlappedResult(
-      HANDLE file_handle,
-      OVERLAPPED *overlapped,
-      DWORD *read_count,
-      BOOL wait_io_complete )
-{
-	FARPROC function       = NULL;
-	HMODULE library_handle = NULL;
-	BOOL result            = FALSE;
-
-	if( file_handle == NULL )
+	if( internal_file->direct_io_buffer != NULL )
 	{
-		return( FALSE );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - direct IO buffer value already set.",
+		 function );
+
+		return( -1 );
 	}
-	if( overlapped == NULL )
+	if( libcfile_file_get_size(
+	     (libcfile_file_t *) internal_file,
+	     &( internal_file->size ),
+	     error ) != 1 )
 	{
-		return( FALSE );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		return( -1 );
 	}
-	if( read_count == NULL )
+	if( memory_allocate_aligned(
+	     (void **) &( internal_file->direct_io_buffer ),
+	     LIBCFILE_DIRECT_IO_BUFFER_SIZE + LIBCFILE_DIRECT_IO_BLOCK_SIZE,
+	     LIBCFILE_DIRECT_IO_BLOCK_SIZE ) != 0 )
 	{
-		return( FALSE );
-	}
-	library_handle = LoadLibrary(
-	                  _SYSTEM_STRING( "kernel32.dll" ) );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create direct IO buffer.",
+		 function );
 
-	if( library_handle == NULL )
-	{
-		return( FALSE );
-	}
-	function = GetProcAddress(
-		    library_handle,
-		    (LPCSTR) "GetOverlappedResult" );
+		internal_file->direct_io_buffer = NULL;
 
-	if( function != NULL )
-	{
-		result = function(
-			  file_handle,
-			  overlapped,
-			  read_count,
-			  wait_io_complete );
-	}
-	/* This call should be after using the function
-	 * in most cases kernel32.dll will still be available after free
-	 */
-	if( FreeLibrary(
-	     library_handle ) != TRUE )
-	{
-		result = FALSE;
+		return( -1 );
 	}
-	return( result );
-}
-
-#endif
+	internal_file->direct_io_buffer_offset    = 0;
+	internal_file->direct_io_buffer_data_size = 0;
+	internal_file->direct_io_buffer_is_dirty  = 0;
 
-#if defined( WINAPI ) && ( WINVER <= 0x0500 )
+	return( 1 );
+}
 
-/* Cross Windows safe version of ReadFile
- * Returns TRUE if successful or FALSE on error
+/* Flushes the direct IO buffer
+ * A partially filled last block is completed with the data in the file
+ * that follows it or padded with 0-byte values otherwise
+ * Returns 1 if successful or -1 on error
  */
-BOOL libcfile_ReadFile(
-      HANDLE file_handle,
-      VOID *buffer,
-      DWORD read_size,
-      DWORD *read_count,
-      OVERLAPPED *overlapped )
+int libcfile_internal_file_flush_direct_io_buffer(
+     libcfile_internal_file_t *internal_file,
+     uint32_t *error_code,
+     libcerror_error_t **error )
 {
-	FARPROC function       = NULL;
-	HMODULE library_handle = NULL;
-	BOOL result            = FALSE;
+	uint8_t *block_data      = NULL;
+	static char *function    = "libcfile_internal_file_flush_direct_io_buffer";
+	off64_t data_end_offset  = 0;
+	size_t block_data_offset = 0;
+	size_t write_size        = 0;
+	ssize_t read_count       = 0;
+	ssize_t write_count      = 0;
 
-	if( file_handle == NULL )
-	{
-		return( FALSE );
-	}
-	if( buffer == NULL )
+	if( internal_file == NULL )
 	{
-		return( FALSE );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
 	}
-	if( read_count == NULL )
+	if( internal_file->direct_io_buffer == NULL )
 	{
-		return( FALSE );
-	}
-	library_handle = LoadLibrary(
-	                  _SYSTEM_STRING( "kernel32.dll" ) );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing direct IO buffer.",
+		 function );
 
-	if( library_handle == NULL )
-	{
-		return( FALSE );
+		return( -1 );
 	}
-	function = GetProcAddress(
-		    library_handle,
-		    (LPCSTR) "ReadFile" );
-
-	if( function != NULL )
+	if( error_code == NULL )
 	{
-		result = function(
-			  file_handle,
-			  buffer,
-			  read_size,
-			  read_count,
-			  overlapped );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid error code.",
+		 function );
+
+		return( -1 );
 	}
-	/* This call should be after using the function
-	 * in most cases kernel32.dll will still be available after free
-	 */
-	if( FreeLibrary(
-	     library_handle ) != TRUE )
+	if( internal_file->direct_io_buffer_is_dirty == 0 )
 	{
-		result = FALSE;
+		return( 1 );
 	}
-	return( result );
-}
-
-#endif /* defined( WINAPI ) && ( WINVER <= 0x0500 ) */
+	write_size        = internal_file->direct_io_buffer_data_size;
+	block_data_offset = write_size % LIBCFILE_DIRECT_IO_BLOCK_SIZE;
 
-#if defined( WINAPI )
+	if( block_data_offset != 0 )
+	{
+		write_size += LIBCFILE_DIRECT_IO_BLOCK_SIZE - block_data_offset;
 
-/* Reads a buffer from the file
+		if( memory_set(
+		     &( internal_file->direct_io_buffer[ internal_file->direct_io_buffer_data_size ] ),
+		     0,
+		     write_size - internal_file->direct_io_buffer_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear direct IO buffer.",
+			 function );
+
+			return( -1 );
+		}
+		data_end_offset = internal_file->direct_io_buffer_offset
+		                + (off64_t) internal_file->direct_io_buffer_data_size;
+
+		if( (size64_t) data_end_offset < internal_file->size )
+		{
+			/* The last block of the direct IO buffer is used to read the block from the file
+			 */
+			block_data = &( internal_file->direct_io_buffer[ LIBCFILE_DIRECT_IO_BUFFER_SIZE ] );
+
+			read_count = pread(
+			              internal_file->descriptor,
+			              (void *) block_data,
+			              LIBCFILE_DIRECT_IO_BLOCK_SIZE,
+			              (off_t) ( data_end_offset - (off64_t) block_data_offset ) );
+
+			if( read_count < 0 )
+			{
+				*error_code = (uint32_t) errno;
+
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 *error_code,
+				 "%s: unable to read block from file.",
+				 function );
+
+				return( -1 );
+			}
+			if( (size_t) read_count > block_data_offset )
+			{
+				if( memory_copy(
+				     &( internal_file->direct_io_buffer[ internal_file->direct_io_buffer_data_size ] ),
+				     &( block_data[ block_data_offset ] ),
+				     (size_t) read_count - block_data_offset ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy block data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+	}
+	write_count = pwrite(
+	               internal_file->descriptor,
+	               (void *) internal_file->direct_io_buffer,
+	               write_size,
+	               (off_t) internal_file->direct_io_buffer_offset );
+
+	if( write_count < 0 )
+	{
+		*error_code = (uint32_t) errno;
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 *error_code,
+		 "%s: unable to write direct IO buffer to file.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) write_count != write_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: invalid write count: %" PRIzd " returned.",
+		 function,
+		 write_count );
+
+		return( -1 );
+	}
+	internal_file->direct_io_buffer_is_dirty = 0;
+
+	return( 1 );
+}
+
+/* Frees direct IO
+ * Flushes the direct IO buffer and removes the padding of the last block
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_internal_file_free_direct_io(
+     libcfile_internal_file_t *internal_file,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libcfile_internal_file_free_direct_io";
+	uint32_t error_code   = 0;
+	int result            = 1;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->direct_io_buffer == NULL )
+	{
+		return( 1 );
+	}
+	if( libcfile_internal_file_flush_direct_io_buffer(
+	     internal_file,
+	     &error_code,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush direct IO buffer.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( internal_file->access_flags & LIBCFILE_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( fstat(
+		     internal_file->descriptor,
+		     &file_statistics ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 errno,
+			 "%s: unable to retrieve file statistics.",
+			 function );
+
+			result = -1;
+		}
+		else if( S_ISREG( file_statistics.st_mode )
+		      && ( (size64_t) file_statistics.st_size > internal_file->size ) )
+		{
+			if( ftruncate(
+			     internal_file->descriptor,
+			     (off_t) internal_file->size ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 errno,
+				 "%s: unable to resize file.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	memory_free(
+	 internal_file->direct_io_buffer );
+
+	internal_file->direct_io_buffer           = NULL;
+	internal_file->direct_io_buffer_offset    = 0;
+	internal_file->direct_io_buffer_data_size = 0;
+	internal_file->direct_io_buffer_is_dirty  = 0;
+
+	return( result );
+}
+
+/* Reads a buffer at a specific offset using direct IO
+ * The data is read directly into the buffer if the offset, buffer and size are aligned
+ * otherwise the blocks that contain the data are read into the direct IO buffer
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_internal_file_read_buffer_at_offset_direct_io(
+         libcfile_internal_file_t *internal_file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         uint32_t *error_code,
+         libcerror_error_t **error )
+{
+	static char *function          = "libcfile_internal_file_read_buffer_at_offset_direct_io";
+	off64_t aligned_offset         = 0;
+	size_t buffer_offset           = 0;
+	size_t direct_io_buffer_offset = 0;
+	size_t read_size               = 0;
+	ssize_t read_count             = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->direct_io_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing direct IO buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( (size64_t) offset >= internal_file->size )
+		{
+			break;
+		}
+		read_size = size - buffer_offset;
+
+		if( (size64_t) read_size > ( internal_file->size - (size64_t) offset ) )
+		{
+			read_size = (size_t) ( internal_file->size - (size64_t) offset );
+		}
+		if( ( offset >= internal_file->direct_io_buffer_offset )
+		 && ( offset < ( internal_file->direct_io_buffer_offset + (off64_t) internal_file->direct_io_buffer_data_size ) ) )
+		{
+			direct_io_buffer_offset = (size_t) ( offset - internal_file->direct_io_buffer_offset );
+
+			if( read_size > ( internal_file->direct_io_buffer_data_size - direct_io_buffer_offset ) )
+			{
+				read_size = internal_file->direct_io_buffer_data_size - direct_io_buffer_offset;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( internal_file->direct_io_buffer[ direct_io_buffer_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy direct IO buffer data.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_offset += read_size;
+			offset        += (off64_t) read_size;
+
+			continue;
+		}
+		if( libcfile_internal_file_flush_direct_io_buffer(
+		     internal_file,
+		     error_code,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush direct IO buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( ( offset % LIBCFILE_DIRECT_IO_BLOCK_SIZE ) == 0 )
+		 && ( ( (intptr_t) &( buffer[ buffer_offset ] ) % LIBCFILE_DIRECT_IO_BLOCK_SIZE ) == 0 )
+		 && ( read_size >= LIBCFILE_DIRECT_IO_BLOCK_SIZE ) )
+		{
+			read_size -= read_size % LIBCFILE_DIRECT_IO_BLOCK_SIZE;
+
+			read_count = pread(
+			              internal_file->descriptor,
+			              (void *) &( buffer[ buffer_offset ] ),
+			              read_size,
+			              (off_t) offset );
+
+			if( read_count < 0 )
+			{
+				*error_code = (uint32_t) errno;
+
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 *error_code,
+				 "%s: unable to read from file.",
+				 function );
+
+				return( -1 );
+			}
+			if( read_count == 0 )
+			{
+				break;
+			}
+			buffer_offset += (size_t) read_count;
+			offset        += (off64_t) read_count;
+
+			continue;
+		}
+		aligned_offset          = offset - ( offset % LIBCFILE_DIRECT_IO_BLOCK_SIZE );
+		direct_io_buffer_offset = (size_t) ( offset - aligned_offset );
+
+		if( read_size > ( LIBCFILE_DIRECT_IO_BUFFER_SIZE - direct_io_buffer_offset ) )
+		{
+			read_size = LIBCFILE_DIRECT_IO_BUFFER_SIZE - direct_io_buffer_offset;
+		}
+		read_size += direct_io_buffer_offset;
+
+		if( ( read_size % LIBCFILE_DIRECT_IO_BLOCK_SIZE ) != 0 )
+		{
+			read_size += LIBCFILE_DIRECT_IO_BLOCK_SIZE - ( read_size % LIBCFILE_DIRECT_IO_BLOCK_SIZE );
+		}
+		internal_file->direct_io_buffer_offset    = aligned_offset;
+		internal_file->direct_io_buffer_data_size = 0;
+
+		read_count = pread(
+		              internal_file->descriptor,
+		              (void *) internal_file->direct_io_buffer,
+		              read_size,
+		              (off_t) aligned_offset );
+
+		if( read_count < 0 )
+		{
+			*error_code = (uint32_t) errno;
+
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 *error_code,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+		if( (size64_t) ( aligned_offset + read_count ) > internal_file->size )
+		{
+			read_count = (ssize_t) ( internal_file->size - (size64_t) aligned_offset );
+		}
+		internal_file->direct_io_buffer_data_size = (size_t) read_count;
+
+		if( (size_t) read_count <= direct_io_buffer_offset )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes a buffer at a specific offset using direct IO
+ * The data is combined in the direct IO buffer, which is written to the file
+ * in aligned blocks when it is full or when data is written or read elsewhere
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libcfile_internal_file_write_buffer_at_offset_direct_io(
+         libcfile_internal_file_t *internal_file,
+         const uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         uint32_t *error_code,
+         libcerror_error_t **error )
+{
+	static char *function          = "libcfile_internal_file_write_buffer_at_offset_direct_io";
+	off64_t aligned_offset         = 0;
+	size_t buffer_offset           = 0;
+	size_t direct_io_buffer_offset = 0;
+	size_t write_size              = 0;
+	ssize_t read_count             = 0;
+
+	if( internal_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_file->direct_io_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing direct IO buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		/* The data in the direct IO buffer must be contiguous
+		 */
+		if( ( offset < internal_file->direct_io_buffer_offset )
+		 || ( offset > ( internal_file->direct_io_buffer_offset + (off64_t) internal_file->direct_io_buffer_data_size ) )
+		 || ( offset >= ( internal_file->direct_io_buffer_offset + LIBCFILE_DIRECT_IO_BUFFER_SIZE ) ) )
+		{
+			if( libcfile_internal_file_flush_direct_io_buffer(
+			     internal_file,
+			     error_code,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush direct IO buffer.",
+				 function );
+
+				return( -1 );
+			}
+			aligned_offset          = offset - ( offset % LIBCFILE_DIRECT_IO_BLOCK_SIZE );
+			direct_io_buffer_offset = (size_t) ( offset - aligned_offset );
+
+			internal_file->direct_io_buffer_offset    = aligned_offset;
+			internal_file->direct_io_buffer_data_size = 0;
+
+			if( direct_io_buffer_offset > 0 )
+			{
+				/* Preserve the data in the block before the offset
+				 */
+				read_count = 0;
+
+				if( (size64_t) aligned_offset < internal_file->size )
+				{
+					read_count = pread(
+					              internal_file->descriptor,
+					              (void *) internal_file->direct_io_buffer,
+					              LIBCFILE_DIRECT_IO_BLOCK_SIZE,
+					              (off_t) aligned_offset );
+
+					if( read_count < 0 )
+					{
+						*error_code = (uint32_t) errno;
+
+						libcerror_system_set_error(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 *error_code,
+						 "%s: unable to read block from file.",
+						 function );
+
+						return( -1 );
+					}
+					if( (size64_t) ( aligned_offset + read_count ) > internal_file->size )
+					{
+						read_count = (ssize_t) ( internal_file->size - (size64_t) aligned_offset );
+					}
+				}
+				if( (size_t) read_count < direct_io_buffer_offset )
+				{
+					if( memory_set(
+					     &( internal_file->direct_io_buffer[ read_count ] ),
+					     0,
+					     direct_io_buffer_offset - (size_t) read_count ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear direct IO buffer.",
+						 function );
+
+						return( -1 );
+					}
+					read_count = (ssize_t) direct_io_buffer_offset;
+				}
+				internal_file->direct_io_buffer_data_size = (size_t) read_count;
+			}
+		}
+		direct_io_buffer_offset = (size_t) ( offset - internal_file->direct_io_buffer_offset );
+		write_size              = size - buffer_offset;
+
+		if( write_size > ( LIBCFILE_DIRECT_IO_BUFFER_SIZE - direct_io_buffer_offset ) )
+		{
+			write_size = LIBCFILE_DIRECT_IO_BUFFER_SIZE - direct_io_buffer_offset;
+		}
+		if( memory_copy(
+		     &( internal_file->direct_io_buffer[ direct_io_buffer_offset ] ),
+		     &( buffer[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to direct IO buffer.",
+			 function );
+
+			return( -1 );
+		}
+		internal_file->direct_io_buffer_is_dirty = 1;
+
+		direct_io_buffer_offset += write_size;
+
+		if( direct_io_buffer_offset > internal_file->direct_io_buffer_data_size )
+		{
+			internal_file->direct_io_buffer_data_size = direct_io_buffer_offset;
+		}
+		buffer_offset += write_size;
+		offset        += (off64_t) write_size;
+
+		if( (size64_t) offset > internal_file->size )
+		{
+			internal_file->size = (size64_t) offset;
+		}
+		if( internal_file->direct_io_buffer_data_size == LIBCFILE_DIRECT_IO_BUFFER_SIZE )
+		{
+			if( libcfile_internal_file_flush_direct_io_buffer(
+			     internal_file,
+			     error_code,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush direct IO buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+#endif /* defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) */
+
+/* Reads a buffer from the file
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_file_read_buffer(
+         libcfile_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libcfile_file_read_buffer";
+	ssize_t read_count    = 0;
+	uint32_t error_code   = 0;
+
+	read_count = libcfile_file_read_buffer_with_error_code(
+	              file,
+	              buffer,
+	              size,
+	              &error_code,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+#if defined( WINAPI ) && ( WINVER <= 0x0500 )
+
+/* Cross Windows safe version of GetOverlappedResult
+ * Returns TRUE if successful or FALSE on error
+ */
+BOOL libcfile_GetOverlappedResult(
+      HANDLE file_handle,
+      OVERLAPPED *overlapped,
+      DWORD *read_count,
+      BOOL wait_io_complete )
+{
+	FARPROC function       = NULL;
+	HMODULE library_handle = NULL;
+	BOOL result            = FALSE;
+
+	if( file_handle == NULL )
+	{
+		return( FALSE );
+	}
+	if( overlapped == NULL )
+	{
+		return( FALSE );
+	}
+	if( read_count == NULL )
+	{
+		return( FALSE );
+	}
+	library_handle = LoadLibrary(
+	                  _SYSTEM_STRING( "kernel32.dll" ) );
+
+	if( library_handle == NULL )
+	{
+		return( FALSE );
+	}
+	function = GetProcAddress(
+		    library_handle,
+		    (LPCSTR) "GetOverlappedResult" );
+
+	if( function != NULL )
+	{
+		result = function(
+			  file_handle,
+			  overlapped,
+			  read_count,
+			  wait_io_complete );
+	}
+	/* This call should be after using the function
+	 * in most cases kernel32.dll will still be available after free
+	 */
+	if( FreeLibrary(
+	     library_handle ) != TRUE )
+	{
+		result = FALSE;
+	}
+	return( result );
+}
+
+#endif
+
+#if defined( WINAPI ) && ( WINVER <= 0x0500 )
+
+/* Cross Windows safe version of ReadFile
+ * Returns TRUE if successful or FALSE on error
+ */
+BOOL libcfile_ReadFile(
+      HANDLE file_handle,
+      VOID *buffer,
+      DWORD read_size,
+      DWORD *read_count,
+      OVERLAPPED *overlapped )
+{
+	FARPROC function       = NULL;
+	HMODULE library_handle = NULL;
+	BOOL result            = FALSE;
+
+	if( file_handle == NULL )
+	{
+		return( FALSE );
+	}
+	if( buffer == NULL )
+	{
+		return( FALSE );
+	}
+	if( read_count == NULL )
+	{
+		return( FALSE );
+	}
+	library_handle = LoadLibrary(
+	                  _SYSTEM_STRING( "kernel32.dll" ) );
+
+	if( library_handle == NULL )
+	{
+		return( FALSE );
+	}
+	function = GetProcAddress(
+		    library_handle,
+		    (LPCSTR) "ReadFile" );
+
+	if( function != NULL )
+	{
+		result = function(
+			  file_handle,
+			  buffer,
+			  read_size,
+			  read_count,
+			  overlapped );
+	}
+	/* This call should be after using the function
+	 * in most cases kernel32.dll will still be available after free
+	 */
+	if( FreeLibrary(
+	     library_handle ) != TRUE )
+	{
+		result = FALSE;
+	}
+	return( result );
+}
+
+#endif /* defined( WINAPI ) && ( WINVER <= 0x0500 ) */
+
+#if defined( WINAPI )
+
+/* Reads a buffer from the file
  * This is an internal function to wrap ReadFile in synchronous and asynchronous mode
  * the current_offset is only used in asynchronous mode.
  * Returns the number of bytes read if successful, or -1 on error
@@ -2156,6 +3064,33 @@ ssize_t libcfile_file_read_buffer_with_error_code(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+	if( internal_file->direct_io_buffer != NULL )
+	{
+		read_count = libcfile_internal_file_read_buffer_at_offset_direct_io(
+		              internal_file,
+		              buffer,
+		              size,
+		              internal_file->current_offset,
+		              error_code,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+		internal_file->current_offset += read_count;
+
+		return( read_count );
+	}
+#endif
 	if( internal_file->block_size != 0 )
 	{
 		if( internal_file->current_offset < 0 )
@@ -2361,13 +3296,261 @@ ssize_t libcfile_file_read_buffer_with_error_code(
 		internal_file->block_data_offset += read_size_remainder;
 		internal_file->current_offset    += read_size_remainder;
 	}
-	return( (ssize_t) buffer_offset );
+	return( (ssize_t) buffer_offset );
+}
+
+#else
+#error Missing file read function
+#endif
+
+/* Reads a buffer from the file at a specific offset
+ * The current offset of the file is not changed
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_file_read_buffer_at_offset(
+         libcfile_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libcfile_file_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+	uint32_t error_code   = 0;
+
+	read_count = libcfile_file_read_buffer_at_offset_with_error_code(
+	              file,
+	              buffer,
+	              size,
+	              offset,
+	              &error_code,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads a buffer from the file at a specific offset
+ * This function uses the POSIX pread function if available and no block size is set,
+ * otherwise the offset is sought, the buffer is read and the previous offset is restored
+ * The current offset of the file is not changed
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_file_read_buffer_at_offset_with_error_code(
+         libcfile_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         uint32_t *error_code,
+         libcerror_error_t **error )
+{
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_read_buffer_at_offset_with_error_code";
+	off64_t current_offset                  = 0;
+	ssize_t read_count                      = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( error_code == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid error code.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+	if( internal_file->direct_io_buffer != NULL )
+	{
+		read_count = libcfile_internal_file_read_buffer_at_offset_direct_io(
+		              internal_file,
+		              buffer,
+		              size,
+		              offset,
+		              error_code,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+#endif
+#if !defined( WINAPI ) && defined( HAVE_PREAD )
+	if( internal_file->block_size == 0 )
+	{
+		if( internal_file->descriptor == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file - missing descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		if( size == 0 )
+		{
+			return( 0 );
+		}
+		read_count = pread(
+		              internal_file->descriptor,
+		              (void *) buffer,
+		              size,
+		              (off_t) offset );
+
+		if( read_count < 0 )
+		{
+			*error_code = (uint32_t) errno;
+
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 *error_code,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+#endif /* !defined( WINAPI ) && defined( HAVE_PREAD ) */
+
+	if( libcfile_file_get_offset(
+	     file,
+	     &current_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_seek_offset(
+	     file,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	read_count = libcfile_file_read_buffer_with_error_code(
+	              file,
+	              buffer,
+	              size,
+	              error_code,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_seek_offset(
+	     file,
+	     current_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 current_offset );
+
+		return( -1 );
+	}
+	return( read_count );
 }
 
-#else
-#error Missing file read function
-#endif
-
 /* Writes a buffer to the file
  * Returns the number of bytes written if successful, or -1 on error
  */
@@ -2663,6 +3846,33 @@ ssize_t libcfile_file_write_buffer_with_error_code(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+	if( internal_file->direct_io_buffer != NULL )
+	{
+		write_count = libcfile_internal_file_write_buffer_at_offset_direct_io(
+		               internal_file,
+		               buffer,
+		               size,
+		               internal_file->current_offset,
+		               error_code,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to file.",
+			 function );
+
+			return( -1 );
+		}
+		internal_file->current_offset += write_count;
+
+		return( write_count );
+	}
+#endif
 	write_count = write(
 	               internal_file->descriptor,
 	               (void *) buffer,
@@ -3018,6 +4228,36 @@ off64_t libcfile_file_seek_offset(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+	/* The direct IO reads and writes are positional,
+	 * hence only the current offset needs to be set
+	 */
+	if( internal_file->direct_io_buffer != NULL )
+	{
+		if( whence == SEEK_CUR )
+		{
+			offset += internal_file->current_offset;
+		}
+		else if( whence == SEEK_END )
+		{
+			offset += (off64_t) internal_file->size;
+		}
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		internal_file->current_offset = offset;
+
+		return( internal_file->current_offset );
+	}
+#endif
 	if( internal_file->block_size != 0 )
 	{
 		if( whence == SEEK_CUR )
@@ -3253,6 +4493,10 @@ int libcfile_file_resize(
 	static char *function                   = "libcfile_file_resize";
 	off_t offset                            = 0;
 
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+	uint32_t error_code                     = 0;
+#endif
+
 	if( file == NULL )
 	{
 		libcerror_error_set(
@@ -3292,6 +4536,25 @@ int libcfile_file_resize(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+	if( internal_file->direct_io_buffer != NULL )
+	{
+		if( libcfile_internal_file_flush_direct_io_buffer(
+		     internal_file,
+		     &error_code,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush direct IO buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( ftruncate(
 	     internal_file->descriptor,
 	     (off_t) size ) != 0 )
@@ -3306,6 +4569,16 @@ int libcfile_file_resize(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+	if( internal_file->direct_io_buffer != NULL )
+	{
+		internal_file->size                       = size;
+		internal_file->direct_io_buffer_offset    = 0;
+		internal_file->direct_io_buffer_data_size = 0;
+
+		return( 1 );
+	}
+#endif
 	offset = lseek(
 	          internal_file->descriptor,
 	          0,
@@ -3366,6 +4639,62 @@ int libcfile_file_is_open(
 	return( 1 );
 }
 
+#if !defined( WINAPI )
+
+/* Retrieves the (file) descriptor
+ * The descriptor remains owned by the file and is only valid while the file is open
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_file_get_descriptor(
+     libcfile_file_t *file,
+     int *descriptor,
+     libcerror_error_t **error )
+{
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_get_descriptor";
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+	if( internal_file->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	*descriptor = internal_file->descriptor;
+
+	return( 1 );
+}
+
+#endif /* !defined( WINAPI ) */
+
 #if defined( WINAPI ) && ( WINVER <= 0x0500 )
 
 /* Cross Windows safe version of GetFileSizeEx
@@ -3778,6 +5107,17 @@ int libcfile_file_get_size(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+	/* The file can be larger than the data written using direct IO
+	 * until it is closed
+	 */
+	if( internal_file->direct_io_buffer != NULL )
+	{
+		*size = internal_file->size;
+
+		return( 1 );
+	}
+#endif
 	file_statistics_size = sizeof( struct stat );
 
 	if( memory_set(
@@ -4274,6 +5614,177 @@ int libcfile_file_is_device(
 #error Missing file is device function
 #endif
 
+#if defined( WINAPI )
+
+/* Retrieves the modification time of the file
+ * The modification time is a FILETIME value
+ * This function uses the WINAPI function for Windows XP (0x0501) or later
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_file_get_modification_time(
+     libcfile_file_t *file,
+     uint64_t *modification_time,
+     libcerror_error_t **error )
+{
+	FILETIME last_write_time;
+
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_get_modification_time";
+	uint32_t error_code                     = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+	if( internal_file->handle == INVALID_HANDLE_VALUE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( modification_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid modification time.",
+		 function );
+
+		return( -1 );
+	}
+	if( GetFileTime(
+	     internal_file->handle,
+	     NULL,
+	     NULL,
+	     &last_write_time ) == 0 )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 error_code,
+		 "%s: unable to retrieve file time.",
+		 function );
+
+		return( -1 );
+	}
+	*modification_time = ( (uint64_t) last_write_time.dwHighDateTime << 32 ) + last_write_time.dwLowDateTime;
+
+	return( 1 );
+}
+
+#elif defined( HAVE_FSTAT )
+
+/* Retrieves the modification time of the file
+ * The modification time is a POSIX time in nanoseconds
+ * This function uses the POSIX fstat function or equivalent
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_file_get_modification_time(
+     libcfile_file_t *file,
+     uint64_t *modification_time,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	libcfile_internal_file_t *internal_file = NULL;
+	static char *function                   = "libcfile_file_get_modification_time";
+	size_t file_statistics_size             = 0;
+
+	if( file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file.",
+		 function );
+
+		return( -1 );
+	}
+	internal_file = (libcfile_internal_file_t *) file;
+
+	if( internal_file->descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( modification_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid modification time.",
+		 function );
+
+		return( -1 );
+	}
+	file_statistics_size = sizeof( struct stat );
+
+	if( memory_set(
+	     &file_statistics,
+	     0,
+	     file_statistics_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( fstat(
+	     internal_file->descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_STRUCT_STAT_ST_MTIM )
+	*modification_time = ( (uint64_t) file_statistics.st_mtim.tv_sec * 1000000000UL )
+	                   + (uint64_t) file_statistics.st_mtim.tv_nsec;
+#else
+	*modification_time = (uint64_t) file_statistics.st_mtime * 1000000000UL;
+#endif
+	return( 1 );
+}
+
+#else
+#error Missing file get modification time function
+#endif
+
 /* Read data from a device file using IO control
  * Returns the number of bytes read if successful or -1 on error
  */
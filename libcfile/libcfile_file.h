@@ -33,6 +33,18 @@
 extern "C" {
 #endif
 
+#if defined( HAVE_POSIX_MEMALIGN ) && defined( HAVE_PREAD ) && defined( HAVE_PWRITE ) && !defined( HAVE_GLIB_H ) && !defined( WINAPI )
+#define HAVE_LIBCFILE_DIRECT_IO_SUPPORT
+#endif
+
+/* The block size used to align direct IO
+ */
+#define LIBCFILE_DIRECT_IO_BLOCK_SIZE		4096
+
+/* The size of the direct IO buffer
+ */
+#define LIBCFILE_DIRECT_IO_BUFFER_SIZE		( 1024 * 1024 )
+
 typedef struct libcfile_internal_file libcfile_internal_file_t;
 
 struct libcfile_internal_file
@@ -83,6 +95,24 @@ struct libcfile_internal_file
 	/* The block data size
 	 */
 	size_t block_data_size;
+
+	/* The direct IO buffer, which is only set when direct IO is used
+	 * it contains an additional block to merge partially written blocks
+	 */
+	uint8_t *direct_io_buffer;
+
+	/* The direct IO buffer offset
+	 */
+	off64_t direct_io_buffer_offset;
+
+	/* The direct IO buffer data size
+	 */
+	size_t direct_io_buffer_data_size;
+
+	/* Value to indicate the direct IO buffer contains data
+	 * that has not been written to the file
+	 */
+	uint8_t direct_io_buffer_is_dirty;
 };
 
 #if defined( WINAPI ) && ( WINVER <= 0x0500 )
@@ -167,6 +197,39 @@ int libcfile_file_close(
      libcfile_file_t *file,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT )
+
+int libcfile_internal_file_initialize_direct_io(
+     libcfile_internal_file_t *internal_file,
+     libcerror_error_t **error );
+
+int libcfile_internal_file_flush_direct_io_buffer(
+     libcfile_internal_file_t *internal_file,
+     uint32_t *error_code,
+     libcerror_error_t **error );
+
+int libcfile_internal_file_free_direct_io(
+     libcfile_internal_file_t *internal_file,
+     libcerror_error_t **error );
+
+ssize_t libcfile_internal_file_read_buffer_at_offset_direct_io(
+         libcfile_internal_file_t *internal_file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         uint32_t *error_code,
+         libcerror_error_t **error );
+
+ssize_t libcfile_internal_file_write_buffer_at_offset_direct_io(
+         libcfile_internal_file_t *internal_file,
+         const uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         uint32_t *error_code,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) */
+
 LIBCFILE_EXTERN \
 ssize_t libcfile_file_read_buffer(
          libcfile_file_t *file,
@@ -215,6 +278,23 @@ ssize_t libcfile_file_read_buffer_with_error_code(
          uint32_t *error_code,
          libcerror_error_t **error );
 
+LIBCFILE_EXTERN \
+ssize_t libcfile_file_read_buffer_at_offset(
+         libcfile_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBCFILE_EXTERN \
+ssize_t libcfile_file_read_buffer_at_offset_with_error_code(
+         libcfile_file_t *file,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         uint32_t *error_code,
+         libcerror_error_t **error );
+
 LIBCFILE_EXTERN \
 ssize_t libcfile_file_write_buffer(
          libcfile_file_t *file,
@@ -276,6 +356,14 @@ int libcfile_file_is_open(
      libcfile_file_t *file,
      libcerror_error_t **error );
 
+#if !defined( WINAPI )
+LIBCFILE_EXTERN \
+int libcfile_file_get_descriptor(
+     libcfile_file_t *file,
+     int *descriptor,
+     libcerror_error_t **error );
+#endif
+
 #if defined( WINAPI ) && ( WINVER <= 0x0500 )
 
 BOOL libcfile_GetFileSizeEx(
@@ -296,6 +384,12 @@ int libcfile_file_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBCFILE_EXTERN \
+int libcfile_file_get_modification_time(
+     libcfile_file_t *file,
+     uint64_t *modification_time,
+     libcerror_error_t **error );
+
 #if defined( WINAPI ) && ( WINVER <= 0x0500 )
 
 DWORD libcfile_GetFileType(
@@ -71,6 +71,21 @@ enum LIBCTHREADS_SORT_FLAGS
 	LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES		= 0x01
 };
 
+/* The thread pool flag definitions
+ */
+enum LIBCTHREADS_THREAD_POOL_FLAGS
+{
+	/* Give every thread its own queue of values, values are distributed
+	 * over the queues and a thread with an empty queue takes values
+	 * from the queues of the other threads
+	 */
+	LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING	= 0x01,
+
+	/* Pin every thread to a CPU, only supported on Linux
+	 */
+	LIBCTHREADS_THREAD_POOL_FLAG_PIN_THREADS	= 0x02
+};
+
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) */
 
 /* The status definitions
@@ -23,11 +23,10 @@
 #include <memory.h>
 #include <types.h>
 
-#include "libcthreads_condition.h"
 #include "libcthreads_definitions.h"
 #include "libcthreads_libcerror.h"
-#include "libcthreads_mutex.h"
 #include "libcthreads_queue.h"
+#include "libcthreads_ring.h"
 #include "libcthreads_types.h"
 
 #if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
@@ -43,7 +42,6 @@ int libcthreads_queue_initialize(
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_initialize";
-	size_t values_array_size                     = 0;
 
 	if( queue == NULL )
 	{
@@ -67,45 +65,17 @@ int libcthreads_queue_initialize(
 
 		return( -1 );
 	}
-	if( maximum_number_of_values < 0 )
+	if( maximum_number_of_values <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
-		 "%s: invalid maximum number of values value less than zero.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of values value zero or less.",
 		 function );
 
 		return( -1 );
 	}
-#if SIZEOF_INT <= SIZEOF_SIZE_T
-	if( (size_t) maximum_number_of_values > (size_t) ( SSIZE_MAX / sizeof( intptr_t * ) ) )
-#else
-	if( maximum_number_of_values > (int) ( SSIZE_MAX / sizeof( intptr_t * ) ) )
-#endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid maximum number of values value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	values_array_size = sizeof( intptr_t * ) * maximum_number_of_values;
-
-	if( values_array_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid values array size value exceeds maximum.",
-		 function );
-
-		goto on_error;
-	}
 	internal_queue = memory_allocate_structure(
 	                  libcthreads_internal_queue_t );
 
@@ -137,71 +107,16 @@ int libcthreads_queue_initialize(
 
 		return( -1 );
 	}
-	internal_queue->values_array = (intptr_t **) memory_allocate(
-	                                              values_array_size );
-
-	if( internal_queue->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create values array.",
-		 function );
-
-		goto on_error;
-	}
-	if( memory_set(
-	     internal_queue->values_array,
-	     0,
-	     values_array_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear values array.",
-		 function );
-
-		goto on_error;
-	}
-	internal_queue->allocated_number_of_values = maximum_number_of_values;
-
-	if( libcthreads_mutex_initialize(
-	     &( internal_queue->condition_mutex ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create condition mutex.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcthreads_condition_initialize(
-	     &( internal_queue->empty_condition ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create empty condition.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcthreads_condition_initialize(
-	     &( internal_queue->full_condition ),
+	if( libcthreads_ring_initialize(
+	     &( internal_queue->values_ring ),
+	     maximum_number_of_values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create full condition.",
+		 "%s: unable to create values ring.",
 		 function );
 
 		goto on_error;
@@ -213,23 +128,6 @@ int libcthreads_queue_initialize(
 on_error:
 	if( internal_queue != NULL )
 	{
-		if( internal_queue->empty_condition != NULL )
-		{
-			libcthreads_condition_free(
-			 &( internal_queue->empty_condition ),
-			 NULL );
-		}
-		if( internal_queue->condition_mutex != NULL )
-		{
-			libcthreads_mutex_free(
-			 &( internal_queue->condition_mutex ),
-			 NULL );
-		}
-		if( internal_queue->values_array != NULL )
-		{
-			memory_free(
-			 internal_queue->values_array );
-		}
 		memory_free(
 		 internal_queue );
 	}
@@ -250,7 +148,6 @@ int libcthreads_queue_free(
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_free";
 	int result                                   = 1;
-	int value_index                              = 0;
 
 	if( queue == NULL )
 	{
@@ -268,66 +165,16 @@ int libcthreads_queue_free(
 		internal_queue = (libcthreads_internal_queue_t *) *queue;
 		*queue         = NULL;
 
-		if( value_free_function != NULL )
-		{
-			for( value_index = 0;
-			     value_index < internal_queue->number_of_values;
-			     value_index++ )
-			{
-				if( value_free_function(
-				     &( internal_queue->values_array[ value_index ] ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free value: %d.",
-					 function,
-					 value_index );
-
-					result = -1;
-				}
-			}
-		}
-		memory_free(
-		 internal_queue->values_array );
-
-		if( libcthreads_condition_free(
-		     &( internal_queue->full_condition ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free full condition.",
-			 function );
-
-			result = -1;
-		}
-		if( libcthreads_condition_free(
-		     &( internal_queue->empty_condition ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free empty condition.",
-			 function );
-
-			result = -1;
-		}
-		if( libcthreads_mutex_free(
-		     &( internal_queue->condition_mutex ),
+		if( libcthreads_ring_free(
+		     &( internal_queue->values_ring ),
+		     value_free_function,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free condition mutex.",
+			 "%s: unable to free values ring.",
 			 function );
 
 			result = -1;
@@ -339,6 +186,7 @@ int libcthreads_queue_free(
 }
 
 /* Empties a queue
+ * Waits until all the values have been popped off the queue
  * Returns 1 if successful or -1 on error
  */
 int libcthreads_queue_empty(
@@ -347,7 +195,7 @@ int libcthreads_queue_empty(
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_empty";
-	int result                                   = 1;
+	int result                                   = 0;
 
 	if( queue == NULL )
 	{
@@ -362,68 +210,22 @@ int libcthreads_queue_empty(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
-		 function );
+	result = libcthreads_ring_wait_until_empty(
+	          internal_queue->values_ring,
+	          error );
 
-		return( -1 );
-	}
-	if( libcthreads_mutex_grab(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
-		 function );
-
-		return( -1 );
-	}
-	while( internal_queue->number_of_values != 0 )
-	{
-		if( libcthreads_condition_wait(
-		     internal_queue->full_condition,
-		     internal_queue->condition_mutex,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for full condition.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libcthreads_mutex_release(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
+		 "%s: unable to wait until values ring is empty.",
 		 function );
 
 		return( -1 );
 	}
 	return( result );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_queue->condition_mutex,
-	 NULL );
-
-	return( -1 );
 }
 
 /* Tries to pop a value off the queue
@@ -436,7 +238,7 @@ int libcthreads_queue_try_pop(
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_try_pop";
-	int result                                   = 1;
+	int result                                   = 0;
 
 	if( queue == NULL )
 	{
@@ -451,97 +253,27 @@ int libcthreads_queue_try_pop(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
-		 function );
-
-		return( -1 );
-	}
-	if( value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
-		 function );
+	result = libcthreads_ring_try_pop(
+	          internal_queue->values_ring,
+	          value,
+	          error );
 
-		return( -1 );
-	}
-	if( libcthreads_mutex_grab(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_queue->number_of_values == 0 )
-	{
-		result = 0;
-	}
-	else
-	{
-		*value = internal_queue->values_array[ internal_queue->pop_index ];
-
-		internal_queue->pop_index++;
-
-		if( internal_queue->pop_index >= internal_queue->allocated_number_of_values )
-		{
-			internal_queue->pop_index = 0;
-		}
-		internal_queue->number_of_values--;
-
-		/* The condition broadcast must be protected by the mutex for the WINAPI version
-		 */
-		if( libcthreads_condition_broadcast(
-		     internal_queue->full_condition,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast full condition.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libcthreads_mutex_release(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop value from values ring.",
 		 function );
 
 		return( -1 );
 	}
 	return( result );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_queue->condition_mutex,
-	 NULL );
-
-	return( -1 );
 }
 
 /* Pops a value off the queue
+ * Waits until a value is available if the queue is empty
  * Returns 1 if successful or -1 on error
  */
 int libcthreads_queue_pop(
@@ -551,6 +283,7 @@ int libcthreads_queue_pop(
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_pop";
+	int result                                   = 0;
 
 	if( queue == NULL )
 	{
@@ -565,104 +298,23 @@ int libcthreads_queue_pop(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
-		 function );
-
-		return( -1 );
-	}
-	if( value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
-		 function );
+	result = libcthreads_ring_pop(
+	          internal_queue->values_ring,
+	          value,
+	          error );
 
-		return( -1 );
-	}
-	if( libcthreads_mutex_grab(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to pop value from values ring.",
 		 function );
 
 		return( -1 );
 	}
-	while( internal_queue->number_of_values == 0 )
-	{
-		if( libcthreads_condition_wait(
-		     internal_queue->empty_condition,
-		     internal_queue->condition_mutex,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for empty condition.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	*value = internal_queue->values_array[ internal_queue->pop_index ];
-
-	internal_queue->pop_index++;
-
-	if( internal_queue->pop_index >= internal_queue->allocated_number_of_values )
-	{
-		internal_queue->pop_index = 0;
-	}
-	internal_queue->number_of_values--;
-
-	/* The condition broadcast must be protected by the mutex for the WINAPI version
-	 */
-	if( libcthreads_condition_broadcast(
-	     internal_queue->full_condition,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to broadcast full condition.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcthreads_mutex_release(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
-		 function );
-
-		return( -1 );
-	}
-	return( 1 );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_queue->condition_mutex,
-	 NULL );
-
-	return( -1 );
+	return( result );
 }
 
 /* Tries to push a value onto the queue
@@ -675,7 +327,7 @@ int libcthreads_queue_try_push(
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_try_push";
-	int result                                   = 1;
+	int result                                   = 0;
 
 	if( queue == NULL )
 	{
@@ -690,97 +342,27 @@ int libcthreads_queue_try_push(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
-		 function );
-
-		return( -1 );
-	}
-	if( value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
-		 function );
-
-		return( -1 );
-	}
-	if( libcthreads_mutex_grab(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_queue->number_of_values == internal_queue->allocated_number_of_values )
-	{
-		result = 0;
-	}
-	else
-	{
-		internal_queue->values_array[ internal_queue->push_index ] = value;
-
-		internal_queue->push_index++;
-
-		if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
-		{
-			internal_queue->push_index = 0;
-		}
-		internal_queue->number_of_values++;
-
-		/* The condition broadcast must be protected by the mutex for the WINAPI version
-		 */
-		if( libcthreads_condition_broadcast(
-		     internal_queue->empty_condition,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast empty condition.",
-			 function );
+	result = libcthreads_ring_try_push(
+	          internal_queue->values_ring,
+	          value,
+	          error );
 
-			goto on_error;
-		}
-	}
-	if( libcthreads_mutex_release(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto values ring.",
 		 function );
 
 		return( -1 );
 	}
 	return( result );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_queue->condition_mutex,
-	 NULL );
-
-	return( -1 );
 }
 
 /* Pushes a value onto the queue
+ * Waits until a slot is available if the queue is full
  * Returns 1 if successful or -1 on error
  */
 int libcthreads_queue_push(
@@ -790,6 +372,7 @@ int libcthreads_queue_push(
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_push";
+	int result                                   = 0;
 
 	if( queue == NULL )
 	{
@@ -804,107 +387,28 @@ int libcthreads_queue_push(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
-		 function );
-
-		return( -1 );
-	}
-	if( value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
-		 function );
-
-		return( -1 );
-	}
-	if( libcthreads_mutex_grab(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
-		 function );
+	result = libcthreads_ring_push(
+	          internal_queue->values_ring,
+	          value,
+	          error );
 
-		return( -1 );
-	}
-	while( internal_queue->number_of_values == internal_queue->allocated_number_of_values )
-	{
-		if( libcthreads_condition_wait(
-		     internal_queue->full_condition,
-		     internal_queue->condition_mutex,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for full condition.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	internal_queue->values_array[ internal_queue->push_index ] = value;
-
-	internal_queue->push_index++;
-
-	if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
-	{
-		internal_queue->push_index = 0;
-	}
-	internal_queue->number_of_values++;
-
-	/* The condition broadcast must be protected by the mutex for the WINAPI version
-	 */
-	if( libcthreads_condition_broadcast(
-	     internal_queue->empty_condition,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to broadcast empty condition.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcthreads_mutex_release(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto values ring.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_queue->condition_mutex,
-	 NULL );
-
-	return( -1 );
+	return( result );
 }
 
 /* Pushes a value onto the queue in sorted order
+ * The values are only kept sorted if they are all pushed with this function,
+ * a push with another function after a sorted push, or vice versa, fails
  *
  * Uses the value_compare_function to determine the similarity of the values
  * The value_compare_function should return LIBCTHREADS_COMPARE_LESS,
@@ -924,12 +428,7 @@ int libcthreads_queue_push_sorted(
 {
 	libcthreads_internal_queue_t *internal_queue = NULL;
 	static char *function                        = "libcthreads_queue_push_sorted";
-	int compare_result                           = 0;
-	int pop_index                                = 0;
-	int previous_push_index                      = 0;
-	int push_index                               = 0;
-	int result                                   = 1;
-	int value_index                              = 0;
+	int result                                   = 0;
 
 	if( queue == NULL )
 	{
@@ -944,206 +443,25 @@ int libcthreads_queue_push_sorted(
 	}
 	internal_queue = (libcthreads_internal_queue_t *) queue;
 
-	if( internal_queue->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
-		 function );
-
-		return( -1 );
-	}
-	if( value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
-		 function );
-
-		return( -1 );
-	}
-	if( value_compare_function == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value compare function.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( sort_flags & ~( LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES ) ) != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported sort flags: 0x%02" PRIx8 ".",
-		 function,
-		 sort_flags );
+	result = libcthreads_ring_push_sorted(
+	          internal_queue->values_ring,
+	          value,
+	          value_compare_function,
+	          sort_flags,
+	          error );
 
-		return( -1 );
-	}
-	if( libcthreads_mutex_grab(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
-		 function );
-
-		return( -1 );
-	}
-	while( internal_queue->number_of_values == internal_queue->allocated_number_of_values )
-	{
-		if( libcthreads_condition_wait(
-		     internal_queue->full_condition,
-		     internal_queue->condition_mutex,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for full condition.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	pop_index = internal_queue->pop_index;
-
-	for( value_index = 0;
-	     value_index < internal_queue->number_of_values;
-	     value_index++ )
-	{
-		compare_result = value_compare_function(
-				  value,
-				  internal_queue->values_array[ pop_index ],
-				  error );
-
-		if( compare_result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to compare value: %d.",
-			 function,
-			 value_index );
-
-			goto on_error;
-		}
-		else if( compare_result == LIBCTHREADS_COMPARE_EQUAL )
-		{
-			if( ( sort_flags & LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES ) != 0 )
-			{
-				result = 0;
-
-				break;
-			}
-		}
-		else if( compare_result == LIBCTHREADS_COMPARE_LESS )
-		{
-			result = 1;
-
-			break;
-		}
-		else if( compare_result != LIBCTHREADS_COMPARE_GREATER )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported value compare function return value: %d.",
-			 function,
-			 compare_result );
-
-			goto on_error;
-		}
-		pop_index++;
-
-		if( pop_index >= internal_queue->allocated_number_of_values )
-		{
-			pop_index = 0;
-		}
-	}
-	if( result != 0 )
-	{
-		push_index = internal_queue->push_index;
-
-		if( compare_result == LIBCTHREADS_COMPARE_LESS )
-		{
-			previous_push_index = push_index - 1;
-
-			while( push_index != pop_index )
-			{
-				if( previous_push_index < 0 )
-				{
-					previous_push_index = internal_queue->allocated_number_of_values - 1;
-				}
-				internal_queue->values_array[ push_index ] = internal_queue->values_array[ previous_push_index ];
-
-				push_index = previous_push_index;
-
-				previous_push_index--;
-			}
-		}
-		internal_queue->values_array[ push_index ] = value;
-
-		internal_queue->push_index++;
-
-		if( internal_queue->push_index >= internal_queue->allocated_number_of_values )
-		{
-			internal_queue->push_index = 0;
-		}
-		internal_queue->number_of_values++;
-
-		/* The condition broadcast must be protected by the mutex for the WINAPI version
-		 */
-		if( libcthreads_condition_broadcast(
-		     internal_queue->empty_condition,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast empty condition.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libcthreads_mutex_release(
-	     internal_queue->condition_mutex,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto values ring.",
 		 function );
 
 		return( -1 );
 	}
 	return( result );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_queue->condition_mutex,
-	 NULL );
-
-	return( -1 );
 }
 
 #endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
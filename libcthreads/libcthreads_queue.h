@@ -27,6 +27,7 @@
 
 #include "libcthreads_extern.h"
 #include "libcthreads_libcerror.h"
+#include "libcthreads_ring.h"
 #include "libcthreads_types.h"
 
 #if defined( __cplusplus )
@@ -39,37 +40,9 @@ typedef struct libcthreads_internal_queue libcthreads_internal_queue_t;
 
 struct libcthreads_internal_queue
 {
-	/* The (current) pop index
+	/* The values ring
 	 */
-	int pop_index;
-
-	/* The (current) push index
-	 */
-	int push_index;
-
-	/* The number of values
-	 */
-	int number_of_values;
-
-	/* The allocated number of values
-	 */
-	int allocated_number_of_values;
-
-	/* The values array
-	 */
-	intptr_t **values_array;
-
-	/* The condition mutex
-	 */
-	libcthreads_mutex_t *condition_mutex;
-
-	/* The queue empty condition
-	 */
-	libcthreads_condition_t *empty_condition;
-
-	/* The queue full condition
-	 */
-	libcthreads_condition_t *full_condition;
+	libcthreads_ring_t *values_ring;
 };
 
 LIBCTHREADS_EXTERN \
@@ -0,0 +1,1805 @@
+/*
+ * Bounded lock-free multi-producer multi-consumer ring functions
+ *
+ * Copyright (C) 2012-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H ) && !defined( WINAPI )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <sched.h>
+#endif
+
+#include "libcthreads_condition.h"
+#include "libcthreads_definitions.h"
+#include "libcthreads_libcerror.h"
+#include "libcthreads_mutex.h"
+#include "libcthreads_ring.h"
+#include "libcthreads_types.h"
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#if defined( HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT )
+#define libcthreads_ring_load_relaxed( pointer ) \
+	__atomic_load_n( pointer, __ATOMIC_RELAXED )
+
+#define libcthreads_ring_load_acquire( pointer ) \
+	__atomic_load_n( pointer, __ATOMIC_ACQUIRE )
+
+#define libcthreads_ring_store_release( pointer, value ) \
+	__atomic_store_n( pointer, value, __ATOMIC_RELEASE )
+
+#define libcthreads_ring_compare_exchange( pointer, expected, desired ) \
+	__atomic_compare_exchange_n( pointer, expected, desired, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED )
+
+#define libcthreads_ring_add( pointer, value ) \
+	__atomic_add_fetch( pointer, value, __ATOMIC_SEQ_CST )
+
+#define libcthreads_ring_fence() \
+	__atomic_thread_fence( __ATOMIC_SEQ_CST )
+
+#if defined( __i386__ ) || defined( __x86_64__ )
+#define libcthreads_ring_pause() \
+	__builtin_ia32_pause()
+#else
+#define libcthreads_ring_pause()
+#endif
+
+#if defined( WINAPI )
+#define libcthreads_ring_yield() \
+	SwitchToThread()
+#elif defined( HAVE_PTHREAD_H )
+#define libcthreads_ring_yield() \
+	sched_yield()
+#else
+#define libcthreads_ring_yield()
+#endif
+
+#else
+#define libcthreads_ring_load_relaxed( pointer ) \
+	*( pointer )
+
+#define libcthreads_ring_load_acquire( pointer ) \
+	*( pointer )
+
+#define libcthreads_ring_store_release( pointer, value ) \
+	*( pointer ) = value
+
+#define libcthreads_ring_compare_exchange( pointer, expected, desired ) \
+	( ( *( pointer ) = desired ), 1 )
+
+#define libcthreads_ring_add( pointer, value ) \
+	*( pointer ) += value
+
+#define libcthreads_ring_fence()
+
+#define libcthreads_ring_pause()
+
+#define libcthreads_ring_yield()
+
+#endif /* defined( HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT ) */
+
+/* Creates a ring
+ * Make sure the value ring is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_initialize(
+     libcthreads_ring_t **ring,
+     int number_of_slots,
+     libcerror_error_t **error )
+{
+	static char *function   = "libcthreads_ring_initialize";
+	size_t slots_array_size = 0;
+	int slot_index          = 0;
+
+#if defined( WINAPI )
+	SYSTEM_INFO system_info;
+#endif
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_slots <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of slots value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+#if SIZEOF_INT <= SIZEOF_SIZE_T
+	if( (size_t) number_of_slots > (size_t) ( SSIZE_MAX / sizeof( libcthreads_ring_slot_t ) ) )
+#else
+	if( number_of_slots > (int) ( SSIZE_MAX / sizeof( libcthreads_ring_slot_t ) ) )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of slots value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*ring = memory_allocate_structure(
+	         libcthreads_ring_t );
+
+	if( *ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *ring,
+	     0,
+	     sizeof( libcthreads_ring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ring.",
+		 function );
+
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+
+		return( -1 );
+	}
+	slots_array_size = sizeof( libcthreads_ring_slot_t ) * number_of_slots;
+
+	( *ring )->slots_array = (libcthreads_ring_slot_t *) memory_allocate(
+	                                                      slots_array_size );
+
+	if( ( *ring )->slots_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots array.",
+		 function );
+
+		goto on_error;
+	}
+	for( slot_index = 0;
+	     slot_index < number_of_slots;
+	     slot_index++ )
+	{
+		( *ring )->slots_array[ slot_index ].sequence = (uint64_t) slot_index * 2;
+		( *ring )->slots_array[ slot_index ].value    = NULL;
+	}
+	( *ring )->number_of_slots = number_of_slots;
+	( *ring )->spin_count      = LIBCTHREADS_RING_SPIN_COUNT;
+
+#if !defined( HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT )
+	( *ring )->use_mutex = 1;
+#endif
+
+	/* Spinning only helps if the other side of the ring runs concurrently
+	 * on another processor, on a single processor it delays the thread
+	 * the ring is waiting for, hence the processor is yielded to it instead.
+	 * Waiting on a condition directly costs a context switch per value
+	 * when the ring is full or empty
+	 */
+#if defined( WINAPI )
+	GetSystemInfo(
+	 &system_info );
+
+	if( system_info.dwNumberOfProcessors <= 1 )
+	{
+		( *ring )->spin_count    = LIBCTHREADS_RING_YIELD_COUNT;
+		( *ring )->yield_on_spin = 1;
+	}
+#elif defined( _SC_NPROCESSORS_ONLN )
+	if( sysconf(
+	     _SC_NPROCESSORS_ONLN ) == 1 )
+	{
+		( *ring )->spin_count    = LIBCTHREADS_RING_YIELD_COUNT;
+		( *ring )->yield_on_spin = 1;
+	}
+#endif
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *ring )->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *ring )->empty_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create empty condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *ring )->full_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create full condition.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *ring != NULL )
+	{
+		if( ( *ring )->empty_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *ring )->empty_condition ),
+			 NULL );
+		}
+		if( ( *ring )->condition_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *ring )->condition_mutex ),
+			 NULL );
+		}
+		if( ( *ring )->slots_array != NULL )
+		{
+			memory_free(
+			 ( *ring )->slots_array );
+		}
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a ring
+ * Uses the value_free_function to free the values that remain in the ring
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_free(
+     libcthreads_ring_t **ring,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	intptr_t *value       = NULL;
+	static char *function = "libcthreads_ring_free";
+	int result            = 1;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ring != NULL )
+	{
+		if( value_free_function != NULL )
+		{
+			while( libcthreads_ring_pop_slot(
+			        *ring,
+			        &value ) == 1 )
+			{
+				if( value_free_function(
+				     &value,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free value.",
+					 function );
+
+					result = -1;
+				}
+				value = NULL;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *ring )->full_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free full condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( ( *ring )->empty_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free empty condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *ring )->condition_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *ring )->sort_values_array != NULL )
+		{
+			memory_free(
+			 ( *ring )->sort_values_array );
+		}
+		memory_free(
+		 ( *ring )->slots_array );
+
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+	}
+	return( result );
+}
+
+/* Sets if the slots are only pushed and popped while holding the condition mutex
+ * The mutex is always used if the ring was built without lock-free support
+ * This function must be called before the ring is shared with other threads
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_set_use_mutex(
+     libcthreads_ring_t *ring,
+     int use_mutex,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_set_use_mutex";
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->push_mode != LIBCTHREADS_RING_PUSH_MODE_UNDEFINED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ring - values already pushed.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT )
+	ring->use_mutex = ( use_mutex != 0 );
+#else
+	if( use_mutex == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: lock-free ring not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Pushes a value into the next slot of the ring
+ * If the ring uses the mutex the caller must hold the condition mutex
+ * Returns 1 if successful or 0 if the ring is full
+ */
+int libcthreads_ring_push_slot(
+     libcthreads_ring_t *ring,
+     intptr_t *value )
+{
+	libcthreads_ring_slot_t *slot = NULL;
+	uint64_t position             = 0;
+	uint64_t sequence             = 0;
+	int64_t difference            = 0;
+
+	position = libcthreads_ring_load_relaxed(
+	            &( ring->push_position ) );
+
+	for( ;; )
+	{
+		slot = &( ring->slots_array[ position % (uint64_t) ring->number_of_slots ] );
+
+		sequence = libcthreads_ring_load_acquire(
+		            &( slot->sequence ) );
+
+		difference = (int64_t) ( sequence - ( position * 2 ) );
+
+		if( difference == 0 )
+		{
+			/* On failure position is updated with the current push position
+			 */
+			if( libcthreads_ring_compare_exchange(
+			     &( ring->push_position ),
+			     &position,
+			     position + 1 ) )
+			{
+				break;
+			}
+		}
+		else if( difference < 0 )
+		{
+			/* The slot still contains a value that was pushed one lap before
+			 */
+			return( 0 );
+		}
+		else
+		{
+			position = libcthreads_ring_load_relaxed(
+			            &( ring->push_position ) );
+		}
+	}
+	slot->value = value;
+
+	/* Make the value visible before the slot can be popped
+	 */
+	libcthreads_ring_store_release(
+	 &( slot->sequence ),
+	 ( position * 2 ) + 1 );
+
+	return( 1 );
+}
+
+/* Pops a value from the next slot of the ring
+ * If the ring uses the mutex the caller must hold the condition mutex
+ * Returns 1 if successful or 0 if the ring is empty
+ */
+int libcthreads_ring_pop_slot(
+     libcthreads_ring_t *ring,
+     intptr_t **value )
+{
+	libcthreads_ring_slot_t *slot = NULL;
+	uint64_t position             = 0;
+	uint64_t sequence             = 0;
+	int64_t difference            = 0;
+
+	position = libcthreads_ring_load_relaxed(
+	            &( ring->pop_position ) );
+
+	for( ;; )
+	{
+		slot = &( ring->slots_array[ position % (uint64_t) ring->number_of_slots ] );
+
+		sequence = libcthreads_ring_load_acquire(
+		            &( slot->sequence ) );
+
+		difference = (int64_t) ( sequence - ( ( position * 2 ) + 1 ) );
+
+		if( difference == 0 )
+		{
+			if( libcthreads_ring_compare_exchange(
+			     &( ring->pop_position ),
+			     &position,
+			     position + 1 ) )
+			{
+				break;
+			}
+		}
+		else if( difference < 0 )
+		{
+			/* The slot has not been pushed yet
+			 */
+			return( 0 );
+		}
+		else
+		{
+			position = libcthreads_ring_load_relaxed(
+			            &( ring->pop_position ) );
+		}
+	}
+	*value = slot->value;
+
+	slot->value = NULL;
+
+	/* Release the slot for the push of the next lap
+	 */
+	libcthreads_ring_store_release(
+	 &( slot->sequence ),
+	 ( position + (uint64_t) ring->number_of_slots ) * 2 );
+
+	return( 1 );
+}
+
+/* Sets the push mode of the ring
+ * A lock-free push does not grab the condition mutex and can push its value
+ * between the values that a sorted push pushes back, hence sorted and unsorted
+ * pushes are only mixed on a ring that uses the mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_set_push_mode(
+     libcthreads_ring_t *ring,
+     int push_mode,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_set_push_mode";
+	int current_push_mode = 0;
+	int result            = 1;
+
+	current_push_mode = libcthreads_ring_load_acquire(
+	                     &( ring->push_mode ) );
+
+	if( ( current_push_mode == push_mode )
+	 || ( ( current_push_mode != LIBCTHREADS_RING_PUSH_MODE_UNDEFINED )
+	  &&  ( ring->use_mutex != 0 ) ) )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->push_mode == LIBCTHREADS_RING_PUSH_MODE_UNDEFINED )
+	{
+		libcthreads_ring_store_release(
+		 &( ring->push_mode ),
+		 push_mode );
+	}
+	else if( ( ring->push_mode != push_mode )
+	      && ( ring->use_mutex == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unable to mix sorted and unsorted pushes on a lock-free ring.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Wakes up the threads waiting on the ring condition
+ * The condition mutex is only grabbed if there are waiting threads
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_signal_waiters(
+     libcthreads_ring_t *ring,
+     int *number_of_waiters,
+     libcthreads_condition_t *condition,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_signal_waiters";
+	int result            = 1;
+
+	/* The fence orders the update of the slot before the check of the number of waiters
+	 * while a waiting thread updates the number of waiters before it checks the slot
+	 */
+	libcthreads_ring_fence();
+
+	if( libcthreads_ring_load_relaxed(
+	     number_of_waiters ) == 0 )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( *number_of_waiters > 0 )
+	{
+		/* A single pushed value can only be popped by a single pop waiter,
+		 * while the full condition is also waited on for the ring to
+		 * become empty and is broadcast to all waiters
+		 */
+		if( condition == ring->empty_condition )
+		{
+			result = libcthreads_condition_signal(
+			          condition,
+			          error );
+		}
+		else
+		{
+			result = libcthreads_condition_broadcast(
+			          condition,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the number of values in the ring
+ * Values that are being pushed or popped concurrently might be included
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_get_number_of_values(
+     libcthreads_ring_t *ring,
+     int *number_of_values,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_get_number_of_values";
+	uint64_t pop_position = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of values.",
+		 function );
+
+		return( -1 );
+	}
+	/* The pop position is read first so that it never exceeds the push position
+	 */
+	pop_position = libcthreads_ring_load_acquire(
+	                &( ring->pop_position ) );
+
+	*number_of_values = (int) ( libcthreads_ring_load_acquire( &( ring->push_position ) ) - pop_position );
+
+	return( 1 );
+}
+
+/* Tries to push a value onto the ring
+ * Returns 1 if successful, 0 if the ring is full or -1 on error
+ */
+int libcthreads_ring_try_push(
+     libcthreads_ring_t *ring,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_try_push";
+	int result            = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_ring_set_push_mode(
+	     ring,
+	     LIBCTHREADS_RING_PUSH_MODE_UNSORTED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set push mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->use_mutex != 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = libcthreads_ring_push_slot(
+	          ring,
+	          value );
+
+	if( ring->use_mutex != 0 )
+	{
+		if( libcthreads_mutex_release(
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result == 1 )
+	{
+		if( libcthreads_ring_signal_waiters(
+		     ring,
+		     &( ring->number_of_pop_waiters ),
+		     ring->empty_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal pop waiters.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Pushes a value onto the ring while the caller holds the condition mutex
+ * Waits for the full condition if the ring is full
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_push_with_mutex(
+     libcthreads_ring_t *ring,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_push_with_mutex";
+	int result            = 1;
+
+	libcthreads_ring_add(
+	 &( ring->number_of_push_waiters ),
+	 1 );
+
+	libcthreads_ring_fence();
+
+	while( libcthreads_ring_push_slot(
+	        ring,
+	        value ) == 0 )
+	{
+		if( libcthreads_condition_wait(
+		     ring->full_condition,
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for full condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	libcthreads_ring_add(
+	 &( ring->number_of_push_waiters ),
+	 -1 );
+
+	return( result );
+}
+
+/* Pushes a value onto the ring
+ * Spins for a short while and then waits for the full condition if the ring is full
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_push(
+     libcthreads_ring_t *ring,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_push";
+	int result            = 0;
+	int spin_count        = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_ring_set_push_mode(
+	     ring,
+	     LIBCTHREADS_RING_PUSH_MODE_UNSORTED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set push mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->use_mutex == 0 )
+	{
+		for( spin_count = 0;
+		     spin_count < ring->spin_count;
+		     spin_count++ )
+		{
+			result = libcthreads_ring_push_slot(
+			          ring,
+			          value );
+
+			if( result == 1 )
+			{
+				break;
+			}
+			if( ring->yield_on_spin != 0 )
+			{
+				libcthreads_ring_yield();
+			}
+			else
+			{
+				libcthreads_ring_pause();
+			}
+		}
+	}
+	if( result == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		result = libcthreads_ring_push_with_mutex(
+		          ring,
+		          value,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push value.",
+			 function );
+		}
+		/* The condition mutex is already held so the pop waiters are woken up
+		 * without libcthreads_ring_signal_waiters grabbing it a second time
+		 */
+		else if( ring->number_of_pop_waiters > 0 )
+		{
+			if( libcthreads_condition_signal(
+			     ring->empty_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal empty condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	else if( libcthreads_ring_signal_waiters(
+	          ring,
+	          &( ring->number_of_pop_waiters ),
+	          ring->empty_condition,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal pop waiters.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pushes a value onto the ring in sorted order
+ *
+ * The values in the ring are popped, the value is inserted in sorted order
+ * and the values are pushed back while holding the condition mutex,
+ * which serializes sorted pushes but does not block concurrent lock-free pops
+ *
+ * Sorted and unsorted pushes can only be mixed on a ring that uses the mutex,
+ * on a lock-free ring the push that does not match the first push fails
+ *
+ * Uses the value_compare_function to determine the similarity of the values
+ * The value_compare_function should return LIBCTHREADS_COMPARE_LESS,
+ * LIBCTHREADS_COMPARE_EQUAL, LIBCTHREADS_COMPARE_GREATER if successful or -1 on error
+ *
+ * Returns 1 if successful, 0 if the value already exists or -1 on error
+ */
+int libcthreads_ring_push_sorted(
+     libcthreads_ring_t *ring,
+     intptr_t *value,
+     int (*value_compare_function)(
+            intptr_t *first_value,
+            intptr_t *second_value,
+            libcerror_error_t **error ),
+     uint8_t sort_flags,
+     libcerror_error_t **error )
+{
+	static char *function      = "libcthreads_ring_push_sorted";
+	size_t values_array_size   = 0;
+	int compare_result         = 0;
+	int insert_index           = 0;
+	int number_of_sort_values  = 0;
+	int number_of_values       = 0;
+	int result                 = 1;
+	int value_index            = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_compare_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value compare function.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_ring_set_push_mode(
+	     ring,
+	     LIBCTHREADS_RING_PUSH_MODE_SORTED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set push mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->sort_values_array == NULL )
+	{
+		/* Add 1 for the value that is inserted
+		 */
+		values_array_size = sizeof( intptr_t * ) * ( (size_t) ring->number_of_slots + 1 );
+
+		ring->sort_values_array = (intptr_t **) memory_allocate(
+		                                         values_array_size );
+
+		if( ring->sort_values_array == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sort values array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Wait for a free slot for the value that is inserted
+	 */
+	libcthreads_ring_add(
+	 &( ring->number_of_push_waiters ),
+	 1 );
+
+	libcthreads_ring_fence();
+
+	for( ;; )
+	{
+		if( libcthreads_ring_get_number_of_values(
+		     ring,
+		     &number_of_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of values.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		if( number_of_values < ring->number_of_slots )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     ring->full_condition,
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for full condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	libcthreads_ring_add(
+	 &( ring->number_of_push_waiters ),
+	 -1 );
+
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	while( number_of_sort_values < ring->number_of_slots )
+	{
+		if( libcthreads_ring_pop_slot(
+		     ring,
+		     &( ring->sort_values_array[ number_of_sort_values ] ) ) != 1 )
+		{
+			break;
+		}
+		number_of_sort_values++;
+	}
+	for( insert_index = 0;
+	     insert_index < number_of_sort_values;
+	     insert_index++ )
+	{
+		compare_result = value_compare_function(
+		                  value,
+		                  ring->sort_values_array[ insert_index ],
+		                  error );
+
+		if( compare_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to compare value: %d.",
+			 function,
+			 insert_index );
+
+			result = -1;
+
+			break;
+		}
+		else if( compare_result == LIBCTHREADS_COMPARE_EQUAL )
+		{
+			if( ( sort_flags & LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES ) != 0 )
+			{
+				result = 0;
+
+				break;
+			}
+		}
+		else if( compare_result == LIBCTHREADS_COMPARE_LESS )
+		{
+			break;
+		}
+		else if( compare_result != LIBCTHREADS_COMPARE_GREATER )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported value compare function return value: %d.",
+			 function,
+			 compare_result );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( result == 1 )
+	{
+		for( value_index = number_of_sort_values;
+		     value_index > insert_index;
+		     value_index-- )
+		{
+			ring->sort_values_array[ value_index ] = ring->sort_values_array[ value_index - 1 ];
+		}
+		ring->sort_values_array[ insert_index ] = value;
+
+		number_of_sort_values++;
+	}
+	/* The values that were popped are always pushed back
+	 */
+	for( value_index = 0;
+	     value_index < number_of_sort_values;
+	     value_index++ )
+	{
+		if( libcthreads_ring_push_with_mutex(
+		     ring,
+		     ring->sort_values_array[ value_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push value: %d.",
+			 function,
+			 value_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+	/* The condition mutex is held so the broadcast cannot use libcthreads_ring_signal_waiters
+	 */
+	if( ( number_of_sort_values > 0 )
+	 && ( ring->number_of_pop_waiters > 0 ) )
+	{
+		if( libcthreads_condition_broadcast(
+		     ring->empty_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast empty condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 ring->condition_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Tries to pop a value off the ring
+ * Returns 1 if successful, 0 if the ring is empty or -1 on error
+ */
+int libcthreads_ring_try_pop(
+     libcthreads_ring_t *ring,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_try_pop";
+	int result            = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->use_mutex != 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = libcthreads_ring_pop_slot(
+	          ring,
+	          value );
+
+	if( ring->use_mutex != 0 )
+	{
+		if( libcthreads_mutex_release(
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result == 1 )
+	{
+		if( libcthreads_ring_signal_waiters(
+		     ring,
+		     &( ring->number_of_push_waiters ),
+		     ring->full_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal push waiters.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Pops a value off the ring
+ * Spins for a short while and then waits for the empty condition if the ring is empty
+ * Returns 1 if successful, 0 if the ring is empty and was closed or -1 on error
+ */
+int libcthreads_ring_pop(
+     libcthreads_ring_t *ring,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_pop";
+	int result            = 0;
+	int spin_count        = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->use_mutex == 0 )
+	{
+		for( spin_count = 0;
+		     spin_count < ring->spin_count;
+		     spin_count++ )
+		{
+			result = libcthreads_ring_pop_slot(
+			          ring,
+			          value );
+
+			if( result == 1 )
+			{
+				break;
+			}
+			if( ring->yield_on_spin != 0 )
+			{
+				libcthreads_ring_yield();
+			}
+			else
+			{
+				libcthreads_ring_pause();
+			}
+		}
+	}
+	if( result == 0 )
+	{
+		if( libcthreads_mutex_grab(
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+		libcthreads_ring_add(
+		 &( ring->number_of_pop_waiters ),
+		 1 );
+
+		libcthreads_ring_fence();
+
+		for( ;; )
+		{
+			result = libcthreads_ring_pop_slot(
+			          ring,
+			          value );
+
+			if( ( result == 1 )
+			 || ( ring->is_closed != 0 ) )
+			{
+				break;
+			}
+			if( libcthreads_condition_wait(
+			     ring->empty_condition,
+			     ring->condition_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for empty condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		libcthreads_ring_add(
+		 &( ring->number_of_pop_waiters ),
+		 -1 );
+
+		/* The condition mutex is already held so the push waiters are woken up
+		 * without libcthreads_ring_signal_waiters grabbing it a second time
+		 */
+		if( ( result == 1 )
+		 && ( ring->number_of_push_waiters > 0 ) )
+		{
+			if( libcthreads_condition_broadcast(
+			     ring->full_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast full condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release condition mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( result == 1 )
+	{
+		if( libcthreads_ring_signal_waiters(
+		     ring,
+		     &( ring->number_of_push_waiters ),
+		     ring->full_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal push waiters.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Waits until all the values have been popped off the ring
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_wait_until_empty(
+     libcthreads_ring_t *ring,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_wait_until_empty";
+	int number_of_values  = 0;
+	int result            = 1;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	libcthreads_ring_add(
+	 &( ring->number_of_push_waiters ),
+	 1 );
+
+	libcthreads_ring_fence();
+
+	for( ;; )
+	{
+		if( libcthreads_ring_get_number_of_values(
+		     ring,
+		     &number_of_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of values.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		if( number_of_values == 0 )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     ring->full_condition,
+		     ring->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for full condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	libcthreads_ring_add(
+	 &( ring->number_of_push_waiters ),
+	 -1 );
+
+	if( libcthreads_mutex_release(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Closes the ring
+ * Threads waiting to pop a value from an empty ring return once the ring is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_ring_close(
+     libcthreads_ring_t *ring,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_ring_close";
+	int result            = 1;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	ring->is_closed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     ring->empty_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast empty condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     ring->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
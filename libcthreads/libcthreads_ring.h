@@ -0,0 +1,249 @@
+/*
+ * Bounded lock-free multi-producer multi-consumer ring functions
+ *
+ * Copyright (C) 2012-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBCTHREADS_RING_H )
+#define _LIBCTHREADS_RING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libcthreads_libcerror.h"
+#include "libcthreads_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The ring positions and slot sequences are updated with atomic operations
+ * if the compiler provides them, otherwise they are protected by the ring mutex
+ */
+#if defined( __GNUC__ ) && defined( __ATOMIC_ACQUIRE )
+#define HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT
+#endif
+
+/* The size of a CPU cache line
+ */
+#define LIBCTHREADS_RING_CACHE_LINE_SIZE	64
+
+/* The number of attempts to push or pop a value before waiting on a condition
+ * on a system with multiple processors
+ */
+#define LIBCTHREADS_RING_SPIN_COUNT		128
+
+/* The number of attempts to push or pop a value before waiting on a condition
+ * on a system with a single processor, where every attempt yields the processor
+ */
+#define LIBCTHREADS_RING_YIELD_COUNT		4
+
+/* The ring push modes
+ */
+enum LIBCTHREADS_RING_PUSH_MODES
+{
+	LIBCTHREADS_RING_PUSH_MODE_UNDEFINED	= 0,
+	LIBCTHREADS_RING_PUSH_MODE_UNSORTED	= 1,
+	LIBCTHREADS_RING_PUSH_MODE_SORTED	= 2
+};
+
+typedef struct libcthreads_ring_slot libcthreads_ring_slot_t;
+
+struct libcthreads_ring_slot
+{
+	/* The sequence
+	 * The slot can be pushed when the sequence equals 2 x the push position
+	 * and popped when it equals 2 x the pop position + 1, the factor 2 keeps
+	 * the filled and the free state apart for a ring of a single slot
+	 */
+	uint64_t sequence;
+
+	/* The value
+	 */
+	intptr_t *value;
+};
+
+typedef struct libcthreads_ring libcthreads_ring_t;
+
+struct libcthreads_ring
+{
+	/* The (next) push position
+	 */
+	uint64_t push_position;
+
+	/* Padding to keep the push and pop positions in separate cache lines
+	 */
+	uint8_t push_position_padding[ LIBCTHREADS_RING_CACHE_LINE_SIZE - sizeof( uint64_t ) ];
+
+	/* The (next) pop position
+	 */
+	uint64_t pop_position;
+
+	/* Padding to keep the push and pop positions in separate cache lines
+	 */
+	uint8_t pop_position_padding[ LIBCTHREADS_RING_CACHE_LINE_SIZE - sizeof( uint64_t ) ];
+
+	/* The number of slots
+	 */
+	int number_of_slots;
+
+	/* The number of attempts to push or pop a value before waiting on a condition
+	 */
+	int spin_count;
+
+	/* Value to indicate the processor is yielded between attempts instead of paused
+	 */
+	int yield_on_spin;
+
+	/* Value to indicate the slots are only pushed and popped while holding the condition mutex
+	 */
+	int use_mutex;
+
+	/* The push mode
+	 * Sorted and unsorted pushes cannot be mixed on a lock-free ring
+	 */
+	int push_mode;
+
+	/* The slots array
+	 */
+	libcthreads_ring_slot_t *slots_array;
+
+	/* The number of threads waiting to push a value
+	 * or for the ring to become empty
+	 */
+	int number_of_push_waiters;
+
+	/* The number of threads waiting to pop a value
+	 */
+	int number_of_pop_waiters;
+
+	/* Value to indicate the ring was closed
+	 */
+	int is_closed;
+
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The ring empty condition, signalled when a value was pushed
+	 */
+	libcthreads_condition_t *empty_condition;
+
+	/* The ring full condition, signalled when a value was popped
+	 */
+	libcthreads_condition_t *full_condition;
+
+	/* The values array used to push values in sorted order
+	 */
+	intptr_t **sort_values_array;
+};
+
+int libcthreads_ring_initialize(
+     libcthreads_ring_t **ring,
+     int number_of_slots,
+     libcerror_error_t **error );
+
+int libcthreads_ring_free(
+     libcthreads_ring_t **ring,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int libcthreads_ring_set_use_mutex(
+     libcthreads_ring_t *ring,
+     int use_mutex,
+     libcerror_error_t **error );
+
+int libcthreads_ring_push_slot(
+     libcthreads_ring_t *ring,
+     intptr_t *value );
+
+int libcthreads_ring_pop_slot(
+     libcthreads_ring_t *ring,
+     intptr_t **value );
+
+int libcthreads_ring_set_push_mode(
+     libcthreads_ring_t *ring,
+     int push_mode,
+     libcerror_error_t **error );
+
+int libcthreads_ring_signal_waiters(
+     libcthreads_ring_t *ring,
+     int *number_of_waiters,
+     libcthreads_condition_t *condition,
+     libcerror_error_t **error );
+
+int libcthreads_ring_get_number_of_values(
+     libcthreads_ring_t *ring,
+     int *number_of_values,
+     libcerror_error_t **error );
+
+int libcthreads_ring_try_push(
+     libcthreads_ring_t *ring,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int libcthreads_ring_push_with_mutex(
+     libcthreads_ring_t *ring,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int libcthreads_ring_push(
+     libcthreads_ring_t *ring,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int libcthreads_ring_push_sorted(
+     libcthreads_ring_t *ring,
+     intptr_t *value,
+     int (*value_compare_function)(
+            intptr_t *first_value,
+            intptr_t *second_value,
+            libcerror_error_t **error ),
+     uint8_t sort_flags,
+     libcerror_error_t **error );
+
+int libcthreads_ring_try_pop(
+     libcthreads_ring_t *ring,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libcthreads_ring_pop(
+     libcthreads_ring_t *ring,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+int libcthreads_ring_wait_until_empty(
+     libcthreads_ring_t *ring,
+     libcerror_error_t **error );
+
+int libcthreads_ring_close(
+     libcthreads_ring_t *ring,
+     libcerror_error_t **error );
+
+#endif /* !defined( HAVE_LOCAL_LIBCTHREADS ) || defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBCTHREADS_RING_H ) */
+
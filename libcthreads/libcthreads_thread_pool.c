@@ -19,19 +19,35 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+
+/* Required for pthread_setaffinity_np
+ */
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <types.h>
 
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
 #include <Threadpoolapiset.h>
+
+#elif defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+#include <pthread.h>
+#include <sched.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
 #endif
 
 #include "libcthreads_condition.h"
 #include "libcthreads_definitions.h"
 #include "libcthreads_libcerror.h"
 #include "libcthreads_mutex.h"
-#include "libcthreads_queue.h"
+#include "libcthreads_ring.h"
 #include "libcthreads_thread.h"
 #include "libcthreads_thread_attributes.h"
 #include "libcthreads_thread_pool.h"
@@ -69,6 +85,7 @@ void CALLBACK libcthreads_thread_pool_callback_function_helper(
 	}
 	pop_result = libcthreads_internal_thread_pool_pop(
 		      internal_thread_pool,
+		      0,
 		      &value,
 		      &error );
 
@@ -114,6 +131,7 @@ DWORD WINAPI libcthreads_thread_pool_callback_function_helper(
 {
 	libcerror_error_t *error                                 = NULL;
 	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	libcthreads_thread_pool_worker_t *worker                 = NULL;
 	intptr_t *value                                          = NULL;
 	DWORD result                                             = 1;
 	int callback_function_result                             = 0;
@@ -121,7 +139,8 @@ DWORD WINAPI libcthreads_thread_pool_callback_function_helper(
 
 	if( arguments != NULL )
 	{
-		internal_thread_pool = (libcthreads_internal_thread_pool_t *) arguments;
+		worker               = (libcthreads_thread_pool_worker_t *) arguments;
+		internal_thread_pool = worker->internal_thread_pool;
 
 		if( ( internal_thread_pool != NULL )
 		 && ( internal_thread_pool->callback_function != NULL ) )
@@ -132,6 +151,7 @@ DWORD WINAPI libcthreads_thread_pool_callback_function_helper(
 			{
 				pop_result = libcthreads_internal_thread_pool_pop(
 					      internal_thread_pool,
+					      worker->values_ring_index,
 					      &value,
 					      &error );
 
@@ -189,6 +209,7 @@ void *libcthreads_thread_pool_callback_function_helper(
 {
 	libcerror_error_t *error                                 = NULL;
 	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	libcthreads_thread_pool_worker_t *worker                 = NULL;
 	intptr_t *value                                          = NULL;
 	int *result                                              = NULL;
 	int callback_function_result                             = 0;
@@ -196,7 +217,8 @@ void *libcthreads_thread_pool_callback_function_helper(
 
 	if( arguments != NULL )
 	{
-		internal_thread_pool = (libcthreads_internal_thread_pool_t *) arguments;
+		worker               = (libcthreads_thread_pool_worker_t *) arguments;
+		internal_thread_pool = worker->internal_thread_pool;
 
 		if( ( internal_thread_pool != NULL )
 		 && ( internal_thread_pool->callback_function != NULL ) )
@@ -212,6 +234,7 @@ void *libcthreads_thread_pool_callback_function_helper(
 				{
 					pop_result = libcthreads_internal_thread_pool_pop(
 					              internal_thread_pool,
+					              worker->values_ring_index,
 					              &value,
 					              &error );
 
@@ -277,13 +300,61 @@ int libcthreads_thread_pool_create(
             void *arguments ),
      void *callback_function_arguments,
      libcerror_error_t **error )
+{
+	static char *function = "libcthreads_thread_pool_create";
+
+	if( libcthreads_thread_pool_create_with_flags(
+	     thread_pool,
+	     thread_attributes,
+	     number_of_threads,
+	     maximum_number_of_values,
+	     callback_function,
+	     callback_function_arguments,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates a thread pool with flags
+ * Make sure the value thread_pool is referencing, is set to NULL
+ *
+ * With LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING the maximum number of values
+ * is divided over the values rings of the threads
+ *
+ * The callback_function should return 1 if successful and -1 on error
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_pool_create_with_flags(
+     libcthreads_thread_pool_t **thread_pool,
+     const libcthreads_thread_attributes_t *thread_attributes,
+     int number_of_threads,
+     int maximum_number_of_values,
+     int (*callback_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *callback_function_arguments,
+     uint8_t flags,
+     libcerror_error_t **error )
 {
 	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
-	static char *function                                    = "libcthreads_thread_pool_create";
+	static char *function                                    = "libcthreads_thread_pool_create_with_flags";
 	size_t array_size                                        = 0;
+	int maximum_number_of_ring_values                        = 0;
+	int values_ring_index                                    = 0;
 
 #if !defined( WINAPI ) || ( WINVER < 0x0602 )
 	int thread_index                                         = 0;
+	int worker_index                                         = 0;
 #endif
 
 #if defined( WINAPI )
@@ -410,6 +481,18 @@ int libcthreads_thread_pool_create(
 
 		return( -1 );
 	}
+	if( ( flags & ~( LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING | LIBCTHREADS_THREAD_POOL_FLAG_PIN_THREADS ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported flags: 0x%02" PRIx8 ".",
+		 function,
+		 flags );
+
+		return( -1 );
+	}
 	internal_thread_pool = memory_allocate_structure(
 	                        libcthreads_internal_thread_pool_t );
 
@@ -441,35 +524,50 @@ int libcthreads_thread_pool_create(
 
 		return( -1 );
 	}
-	array_size = sizeof( intptr_t * ) * maximum_number_of_values;
+	/* The callback must be set before the callback function helper threads are created */
+	internal_thread_pool->callback_function           = callback_function;
+	internal_thread_pool->callback_function_arguments = callback_function_arguments;
+	internal_thread_pool->flags                       = flags;
+	internal_thread_pool->number_of_values_rings      = 1;
+
+#if !defined( WINAPI ) || ( WINVER < 0x0602 )
+	/* The system thread pool schedules its own work items
+	 * hence work stealing only applies to the threads created here
+	 */
+	if( ( flags & LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING ) != 0 )
+	{
+		internal_thread_pool->number_of_values_rings = number_of_threads;
+	}
+#endif
+	array_size = sizeof( libcthreads_ring_t * ) * internal_thread_pool->number_of_values_rings;
 
 	if( array_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid values array size value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid values rings array size value out of bounds.",
 		 function );
 
 		goto on_error;
 	}
-	internal_thread_pool->values_array = (intptr_t **) memory_allocate(
-	                                                    array_size );
+	internal_thread_pool->values_rings_array = (libcthreads_ring_t **) memory_allocate(
+	                                                                    array_size );
 
-	if( internal_thread_pool->values_array == NULL )
+	if( internal_thread_pool->values_rings_array == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create values array.",
+		 "%s: unable to create values rings array.",
 		 function );
 
 		goto on_error;
 	}
 	if( memory_set(
-	     internal_thread_pool->values_array,
+	     internal_thread_pool->values_rings_array,
 	     0,
 	     array_size ) == NULL )
 	{
@@ -477,56 +575,98 @@ int libcthreads_thread_pool_create(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear values array.",
+		 "%s: unable to clear values rings array.",
 		 function );
 
 		goto on_error;
 	}
-	internal_thread_pool->allocated_number_of_values = maximum_number_of_values;
+	maximum_number_of_ring_values = 1 + ( ( maximum_number_of_values - 1 ) / internal_thread_pool->number_of_values_rings );
 
-	/* The callback must be set before the callback function helper threads are created */
-	internal_thread_pool->callback_function           = callback_function;
-	internal_thread_pool->callback_function_arguments = callback_function_arguments;
+	for( values_ring_index = 0;
+	     values_ring_index < internal_thread_pool->number_of_values_rings;
+	     values_ring_index++ )
+	{
+		if( libcthreads_ring_initialize(
+		     &( internal_thread_pool->values_rings_array[ values_ring_index ] ),
+		     maximum_number_of_ring_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create values ring: %d.",
+			 function,
+			 values_ring_index );
 
-	if( libcthreads_mutex_initialize(
-	     &( internal_thread_pool->condition_mutex ),
-	     error ) != 1 )
+			goto on_error;
+		}
+	}
+	if( internal_thread_pool->number_of_values_rings > 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create condition mutex.",
-		 function );
+		if( libcthreads_mutex_initialize(
+		     &( internal_thread_pool->work_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create work mutex.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( internal_thread_pool->work_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create work condition.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	if( libcthreads_condition_initialize(
-	     &( internal_thread_pool->empty_condition ),
-	     error ) != 1 )
+#if !defined( WINAPI ) || ( WINVER < 0x0602 )
+	array_size = sizeof( libcthreads_thread_pool_worker_t ) * number_of_threads;
+
+	if( array_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create empty condition.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid workers array size value out of bounds.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcthreads_condition_initialize(
-	     &( internal_thread_pool->full_condition ),
-	     error ) != 1 )
+	internal_thread_pool->workers_array = (libcthreads_thread_pool_worker_t *) memory_allocate(
+	                                                                            array_size );
+
+	if( internal_thread_pool->workers_array == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create full condition.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers array.",
 		 function );
 
 		goto on_error;
 	}
+	for( worker_index = 0;
+	     worker_index < number_of_threads;
+	     worker_index++ )
+	{
+		internal_thread_pool->workers_array[ worker_index ].internal_thread_pool = internal_thread_pool;
+		internal_thread_pool->workers_array[ worker_index ].values_ring_index    = worker_index % internal_thread_pool->number_of_values_rings;
+	}
+#endif
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
 	InitializeThreadpoolEnvironment(
 	 &( internal_thread_pool->callback_environment ) );
@@ -692,7 +832,7 @@ int libcthreads_thread_pool_create(
 		                 security_attributes,
 		                 0, /* stack size */
 		                 &libcthreads_thread_pool_callback_function_helper,
-		                 (void *) internal_thread_pool,
+		                 (void *) &( internal_thread_pool->workers_array[ thread_index ] ),
 		                 0, /* creation flags */
 		                 &( internal_thread_pool->thread_identifiers_array[ thread_index ] ) );
 
@@ -770,7 +910,7 @@ int libcthreads_thread_pool_create(
 				  &( internal_thread_pool->threads_array[ thread_index ] ),
 				  attributes,
 				  &libcthreads_thread_pool_callback_function_helper,
-				  (void *) internal_thread_pool );
+				  (void *) &( internal_thread_pool->workers_array[ thread_index ] ) );
 
 		if( pthread_result != 0 )
 		{
@@ -786,6 +926,29 @@ int libcthreads_thread_pool_create(
 			goto on_error;
 		}
 	}
+	if( ( flags & LIBCTHREADS_THREAD_POOL_FLAG_PIN_THREADS ) != 0 )
+	{
+		for( worker_index = 0;
+		     worker_index < number_of_threads;
+		     worker_index++ )
+		{
+			if( libcthreads_internal_thread_pool_pin_thread(
+			     internal_thread_pool,
+			     worker_index,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to pin thread: %d.",
+				 function,
+				 worker_index );
+
+				goto on_error;
+			}
+		}
+	}
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 
 	*thread_pool = (libcthreads_thread_pool_t *) internal_thread_pool;
@@ -795,6 +958,31 @@ int libcthreads_thread_pool_create(
 on_error:
 	if( internal_thread_pool != NULL )
 	{
+		/* Closing the values rings stops the threads that were already created
+		 */
+		if( internal_thread_pool->values_rings_array != NULL )
+		{
+			for( values_ring_index = 0;
+			     values_ring_index < internal_thread_pool->number_of_values_rings;
+			     values_ring_index++ )
+			{
+				if( internal_thread_pool->values_rings_array[ values_ring_index ] != NULL )
+				{
+					libcthreads_ring_close(
+					 internal_thread_pool->values_rings_array[ values_ring_index ],
+					 NULL );
+				}
+			}
+		}
+		if( internal_thread_pool->work_condition != NULL )
+		{
+			internal_thread_pool->status = LIBCTHREADS_STATUS_EXIT;
+
+			libcthreads_internal_thread_pool_signal_idle_threads(
+			 internal_thread_pool,
+			 1,
+			 NULL );
+		}
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
 		if( internal_thread_pool->cleanup_group != NULL )
 		{
@@ -819,13 +1007,15 @@ on_error:
 		}
 		if( internal_thread_pool->thread_handles_array != NULL )
 		{
-			while( thread_index >= 0 )
+			/* The thread index contains the number of threads that were created
+			 */
+			while( thread_index > 0 )
 			{
+				thread_index--;
+
 				WaitForSingleObject(
 				 internal_thread_pool->thread_handles_array[ thread_index ],
 				 INFINITE );
-
-				thread_index--;
 			}
 			memory_free(
 			 internal_thread_pool->thread_handles_array );
@@ -833,8 +1023,12 @@ on_error:
 #elif defined( HAVE_PTHREAD_H )
 		if( internal_thread_pool->threads_array != NULL )
 		{
-			while( thread_index >= 0 )
+			/* The thread index contains the number of threads that were created
+			 */
+			while( thread_index > 0 )
 			{
+				thread_index--;
+
 				pthread_join(
 				 internal_thread_pool->threads_array[ thread_index ],
 				 (void **) &thread_return_value );
@@ -846,35 +1040,47 @@ on_error:
 
 					thread_return_value = NULL;
 				}
-				thread_index--;
 			}
 			memory_free(
 			 internal_thread_pool->threads_array );
 		}
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 
-		if( internal_thread_pool->full_condition != NULL )
+#if !defined( WINAPI ) || ( WINVER < 0x0602 )
+		if( internal_thread_pool->workers_array != NULL )
 		{
-			libcthreads_condition_free(
-			 &( internal_thread_pool->full_condition ),
-			 NULL );
+			memory_free(
+			 internal_thread_pool->workers_array );
 		}
-		if( internal_thread_pool->empty_condition != NULL )
+#endif
+		if( internal_thread_pool->work_condition != NULL )
 		{
 			libcthreads_condition_free(
-			 &( internal_thread_pool->empty_condition ),
+			 &( internal_thread_pool->work_condition ),
 			 NULL );
 		}
-		if( internal_thread_pool->condition_mutex != NULL )
+		if( internal_thread_pool->work_mutex != NULL )
 		{
 			libcthreads_mutex_free(
-			 &( internal_thread_pool->condition_mutex ),
+			 &( internal_thread_pool->work_mutex ),
 			 NULL );
 		}
-		if( internal_thread_pool->values_array != NULL )
+		if( internal_thread_pool->values_rings_array != NULL )
 		{
+			for( values_ring_index = 0;
+			     values_ring_index < internal_thread_pool->number_of_values_rings;
+			     values_ring_index++ )
+			{
+				if( internal_thread_pool->values_rings_array[ values_ring_index ] != NULL )
+				{
+					libcthreads_ring_free(
+					 &( internal_thread_pool->values_rings_array[ values_ring_index ] ),
+					 NULL,
+					 NULL );
+				}
+			}
 			memory_free(
-			 internal_thread_pool->values_array );
+			 internal_thread_pool->values_rings_array );
 		}
 		memory_free(
 		 internal_thread_pool );
@@ -882,16 +1088,30 @@ on_error:
 	return( -1 );
 }
 
-/* Pops a value off the queue of the thread pool
- * Returns 1 if successful, 0 if no value available or -1 on error
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+
+/* Pins a thread of the thread pool to a CPU
+ * The threads are assigned in order to the CPUs in the CPU affinity mask of the process,
+ * this keeps threads with adjacent indexes on the same NUMA node when the CPUs of a node
+ * are numbered consecutively
+ * Returns 1 if successful, 0 if not supported or -1 on error
  */
-int libcthreads_internal_thread_pool_pop(
+int libcthreads_internal_thread_pool_pin_thread(
      libcthreads_internal_thread_pool_t *internal_thread_pool,
-     intptr_t **value,
+     int thread_index,
      libcerror_error_t **error )
 {
-	static char *function = "libcthreads_internal_thread_pool_pop";
-	int result            = 0;
+	static char *function     = "libcthreads_internal_thread_pool_pin_thread";
+
+#if defined( CPU_SET )
+	cpu_set_t process_cpu_set;
+	cpu_set_t thread_cpu_set;
+
+	int cpu_index             = 0;
+	int number_of_cpus        = 0;
+	int pthread_result        = 0;
+	int remaining_cpu_indexes = 0;
+#endif
 
 	if( internal_thread_pool == NULL )
 	{
@@ -904,119 +1124,108 @@ int libcthreads_internal_thread_pool_pop(
 
 		return( -1 );
 	}
-	if( internal_thread_pool->values_array == NULL )
+	if( ( thread_index < 0 )
+	 || ( thread_index >= internal_thread_pool->number_of_threads ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid thread pool - missing values array.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid thread index value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( libcthreads_mutex_grab(
-	     internal_thread_pool->condition_mutex,
-	     error ) != 1 )
+#if defined( CPU_SET )
+	CPU_ZERO(
+	 &process_cpu_set );
+
+	if( sched_getaffinity(
+	     0,
+	     sizeof( cpu_set_t ),
+	     &process_cpu_set ) != 0 )
 	{
-		libcerror_error_set(
+		libcerror_system_set_error(
 		 error,
+		 errno,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve process CPU affinity.",
 		 function );
 
 		return( -1 );
 	}
-	while( internal_thread_pool->number_of_values == 0 )
-	{
-		if( internal_thread_pool->status == LIBCTHREADS_STATUS_EXIT )
-		{
-			break;
-		}
-		if( libcthreads_condition_wait(
-		     internal_thread_pool->empty_condition,
-		     internal_thread_pool->condition_mutex,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for empty condition.",
-			 function );
+	number_of_cpus = CPU_COUNT(
+	                  &process_cpu_set );
 
-			goto on_error;
-		}
-	}
-	if( internal_thread_pool->number_of_values > 0 )
+	if( number_of_cpus <= 0 )
 	{
-		*value = internal_thread_pool->values_array[ internal_thread_pool->pop_index ];
-
-		internal_thread_pool->pop_index++;
+		return( 0 );
+	}
+	remaining_cpu_indexes = thread_index % number_of_cpus;
 
-		if( internal_thread_pool->pop_index >= internal_thread_pool->allocated_number_of_values )
+	for( cpu_index = 0;
+	     cpu_index < CPU_SETSIZE;
+	     cpu_index++ )
+	{
+		if( CPU_ISSET(
+		     cpu_index,
+		     &process_cpu_set ) != 0 )
 		{
-			internal_thread_pool->pop_index = 0;
+			if( remaining_cpu_indexes == 0 )
+			{
+				break;
+			}
+			remaining_cpu_indexes--;
 		}
-		internal_thread_pool->number_of_values--;
+	}
+	CPU_ZERO(
+	 &thread_cpu_set );
 
-		result = 1;
+	CPU_SET(
+	 cpu_index,
+	 &thread_cpu_set );
 
-		if( libcthreads_condition_broadcast(
-		     internal_thread_pool->full_condition,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast full condition.",
-			 function );
+	pthread_result = pthread_setaffinity_np(
+	                  internal_thread_pool->threads_array[ thread_index ],
+	                  sizeof( cpu_set_t ),
+	                  &thread_cpu_set );
 
-			goto on_error;
-		}
-	}
-	if( libcthreads_mutex_release(
-	     internal_thread_pool->condition_mutex,
-	     error ) != 1 )
+	if( pthread_result != 0 )
 	{
-		libcerror_error_set(
+		libcerror_system_set_error(
 		 error,
+		 pthread_result,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
-		 function );
+		 "%s: unable to set CPU affinity of thread: %d.",
+		 function,
+		 thread_index );
 
 		return( -1 );
 	}
-	return( result );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_thread_pool->condition_mutex,
-	 NULL );
-
-	return( -1 );
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( CPU_SET ) */
 }
 
-/* Pushes a value onto the queue of the thread pool
+#endif /* defined( HAVE_PTHREAD_H ) && !defined( WINAPI ) */
+
+/* Wakes up the threads waiting on the work condition
+ * If broadcast is 0 a single thread is woken up, otherwise all threads
+ * The work mutex is only grabbed if there are idle threads
  * Returns 1 if successful or -1 on error
  */
-int libcthreads_thread_pool_push(
-     libcthreads_thread_pool_t *thread_pool,
-     intptr_t *value,
+int libcthreads_internal_thread_pool_signal_idle_threads(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     int broadcast,
      libcerror_error_t **error )
 {
-	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
-	static char *function                                    = "libcthreads_thread_pool_push";
-
-#if defined( WINAPI ) && ( WINVER >= 0x0602 )
-	TP_WORK *thread_pool_work                                = NULL;
-	DWORD error_code                                         = 0;
-#endif
+	static char *function = "libcthreads_internal_thread_pool_signal_idle_threads";
+	int result            = 1;
 
-	if( thread_pool == NULL )
+	if( internal_thread_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1027,98 +1236,454 @@ int libcthreads_thread_pool_push(
 
 		return( -1 );
 	}
-	internal_thread_pool = (libcthreads_internal_thread_pool_t *) thread_pool;
-
-	if( internal_thread_pool->values_array == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid thread pool - missing values array.",
-		 function );
+#if defined( HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT )
+	/* The fence orders the push of the value before the check of the number of idle threads
+	 * while an idle thread updates the number of idle threads before it checks the values rings
+	 */
+	__atomic_thread_fence(
+	 __ATOMIC_SEQ_CST );
 
-		return( -1 );
-	}
-	if( value == NULL )
+	if( ( broadcast == 0 )
+	 && ( __atomic_load_n( &( internal_thread_pool->number_of_idle_threads ), __ATOMIC_RELAXED ) == 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid value.",
-		 function );
-
-		return( -1 );
+		return( 1 );
 	}
+#endif
 	if( libcthreads_mutex_grab(
-	     internal_thread_pool->condition_mutex,
+	     internal_thread_pool->work_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
+		 "%s: unable to grab work mutex.",
 		 function );
 
 		return( -1 );
 	}
-	while( internal_thread_pool->number_of_values == internal_thread_pool->allocated_number_of_values )
+	if( internal_thread_pool->number_of_idle_threads > 0 )
 	{
-		if( libcthreads_condition_wait(
-		     internal_thread_pool->full_condition,
-		     internal_thread_pool->condition_mutex,
-		     error ) != 1 )
+		if( broadcast == 0 )
+		{
+			result = libcthreads_condition_signal(
+			          internal_thread_pool->work_condition,
+			          error );
+		}
+		else
+		{
+			result = libcthreads_condition_broadcast(
+			          internal_thread_pool->work_condition,
+			          error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for full condition.",
+			 "%s: unable to signal work condition.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	internal_thread_pool->values_array[ internal_thread_pool->push_index ] = value;
+	if( libcthreads_mutex_release(
+	     internal_thread_pool->work_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release work mutex.",
+		 function );
 
-	internal_thread_pool->push_index++;
+		return( -1 );
+	}
+	return( result );
+}
 
-	if( internal_thread_pool->push_index >= internal_thread_pool->allocated_number_of_values )
+/* Tries to pop a value off the queues of the thread pool without waiting
+ * The values ring with the index is tried first, after that the values
+ * rings of the other threads, from which the value is stolen
+ * Returns 1 if successful, 0 if no value available or -1 on error
+ */
+int libcthreads_internal_thread_pool_try_pop(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     int values_ring_index,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_thread_pool_try_pop";
+	int ring_index        = 0;
+	int result            = 0;
+	int steal_index       = 0;
+
+	if( internal_thread_pool == NULL )
 	{
-		internal_thread_pool->push_index = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
 	}
-	internal_thread_pool->number_of_values++;
+	if( internal_thread_pool->values_rings_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid thread pool - missing values rings array.",
+		 function );
 
-	/* The condition broadcast must be protected by the mutex for the WINAPI version
-	 */
-	if( libcthreads_condition_broadcast(
-	     internal_thread_pool->empty_condition,
+		return( -1 );
+	}
+	if( ( values_ring_index < 0 )
+	 || ( values_ring_index >= internal_thread_pool->number_of_values_rings ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid values ring index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( steal_index = 0;
+	     steal_index < internal_thread_pool->number_of_values_rings;
+	     steal_index++ )
+	{
+		ring_index = ( values_ring_index + steal_index ) % internal_thread_pool->number_of_values_rings;
+
+		result = libcthreads_ring_try_pop(
+		          internal_thread_pool->values_rings_array[ ring_index ],
+		          value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop value from values ring: %d.",
+			 function,
+			 ring_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			break;
+		}
+	}
+	return( result );
+}
+
+/* Pops a value off the queue of the thread pool
+ * Waits until a value is available if the queue is empty
+ * With work stealing a value is taken from the queues of the other threads
+ * if the values ring with the index is empty. An idle thread waits on the
+ * work condition, which is signalled by every push, and then tries all
+ * the values rings again
+ * Returns 1 if successful, 0 if no value available and the thread pool is exiting or -1 on error
+ */
+int libcthreads_internal_thread_pool_pop(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     int values_ring_index,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "libcthreads_internal_thread_pool_pop";
+	int result            = 0;
+
+	if( internal_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_thread_pool->values_rings_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid thread pool - missing values rings array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( values_ring_index < 0 )
+	 || ( values_ring_index >= internal_thread_pool->number_of_values_rings ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid values ring index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_thread_pool->number_of_values_rings == 1 )
+	{
+		/* The ring only returns 0 when it is empty and was closed by join
+		 */
+		result = libcthreads_ring_pop(
+		          internal_thread_pool->values_rings_array[ 0 ],
+		          value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop value from values ring.",
+			 function );
+
+			return( -1 );
+		}
+		return( result );
+	}
+	result = libcthreads_internal_thread_pool_try_pop(
+	          internal_thread_pool,
+	          values_ring_index,
+	          value,
+	          error );
+
+	if( result != 0 )
+	{
+		return( result );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_thread_pool->work_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to broadcast empty condition.",
+		 "%s: unable to grab work mutex.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
+	/* The thread registers itself as idle before it checks the values rings again
+	 * so that a value pushed in the meantime wakes it up
+	 */
+#if defined( HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT )
+	__atomic_add_fetch(
+	 &( internal_thread_pool->number_of_idle_threads ),
+	 1,
+	 __ATOMIC_SEQ_CST );
+#else
+	internal_thread_pool->number_of_idle_threads += 1;
+#endif
+	for( ;; )
+	{
+		/* Once the thread pool is exiting the values that remain in
+		 * the values rings are processed before the thread stops
+		 */
+		result = libcthreads_internal_thread_pool_try_pop(
+		          internal_thread_pool,
+		          values_ring_index,
+		          value,
+		          error );
+
+		if( ( result != 0 )
+		 || ( internal_thread_pool->status == LIBCTHREADS_STATUS_EXIT ) )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     internal_thread_pool->work_condition,
+		     internal_thread_pool->work_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for work condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+#if defined( HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT )
+	__atomic_sub_fetch(
+	 &( internal_thread_pool->number_of_idle_threads ),
+	 1,
+	 __ATOMIC_SEQ_CST );
+#else
+	internal_thread_pool->number_of_idle_threads -= 1;
+#endif
 	if( libcthreads_mutex_release(
-	     internal_thread_pool->condition_mutex,
+	     internal_thread_pool->work_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
+		 "%s: unable to release work mutex.",
 		 function );
 
 		return( -1 );
 	}
+	return( result );
+}
+
+/* Pushes a value onto the queue of the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libcthreads_thread_pool_push(
+     libcthreads_thread_pool_t *thread_pool,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
+	static char *function                                    = "libcthreads_thread_pool_push";
+	uint32_t push_index                                      = 0;
+	int push_offset                                          = 0;
+	int result                                               = 0;
+	int values_ring_index                                    = 0;
+
+#if defined( WINAPI ) && ( WINVER >= 0x0602 )
+	TP_WORK *thread_pool_work                                = NULL;
+	DWORD error_code                                         = 0;
+#endif
+
+	if( thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_thread_pool = (libcthreads_internal_thread_pool_t *) thread_pool;
+
+	if( internal_thread_pool->values_rings_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid thread pool - missing values rings array.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_thread_pool->number_of_values_rings > 1 )
+	{
+		/* The push index only serves to spread the values over the values rings
+		 */
+#if defined( HAVE_LIBCTHREADS_RING_LOCK_FREE_SUPPORT )
+		push_index = __atomic_fetch_add(
+		              &( internal_thread_pool->push_index ),
+		              1,
+		              __ATOMIC_RELAXED );
+#else
+		push_index = internal_thread_pool->push_index++;
+#endif
+		/* Start with the next values ring in turn and skip values rings that are full
+		 */
+		for( push_offset = 0;
+		     push_offset < internal_thread_pool->number_of_values_rings;
+		     push_offset++ )
+		{
+			values_ring_index = (int) ( ( push_index + (uint32_t) push_offset ) % (uint32_t) internal_thread_pool->number_of_values_rings );
+
+			result = libcthreads_ring_try_push(
+			          internal_thread_pool->values_rings_array[ values_ring_index ],
+			          value,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push value onto values ring: %d.",
+				 function,
+				 values_ring_index );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				break;
+			}
+		}
+		values_ring_index = (int) ( push_index % (uint32_t) internal_thread_pool->number_of_values_rings );
+	}
+	/* If all values rings are full wait until there is room in the values ring in turn
+	 */
+	if( result == 0 )
+	{
+		if( libcthreads_ring_push(
+		     internal_thread_pool->values_rings_array[ values_ring_index ],
+		     value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push value onto values ring.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_thread_pool->number_of_values_rings > 1 )
+	{
+		if( libcthreads_internal_thread_pool_signal_idle_threads(
+		     internal_thread_pool,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal idle threads.",
+			 function );
+
+			return( -1 );
+		}
+	}
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
 	thread_pool_work = CreateThreadpoolWork(
 	                    &libcthreads_thread_pool_callback_function_helper,
@@ -1145,16 +1710,11 @@ int libcthreads_thread_pool_push(
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 
 	return( 1 );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_thread_pool->condition_mutex,
-	 NULL );
-
-	return( -1 );
 }
 
 /* Pushes a value onto the thread pool in sorted order
+ * The values are only kept sorted if they are all pushed with this function,
+ * a push with another function after a sorted push, or vice versa, fails
  *
  * Uses the value_compare_function to determine the similarity of the values
  * The value_compare_function should return LIBCTHREADS_COMPARE_LESS,
@@ -1174,12 +1734,7 @@ int libcthreads_thread_pool_push_sorted(
 {
 	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
 	static char *function                                    = "libcthreads_thread_pool_push_sorted";
-	int compare_result                                       = 0;
-	int pop_index                                            = 0;
-	int previous_push_index                                  = 0;
-	int push_index                                           = 0;
-	int result                                               = 1;
-	int value_index                                          = 0;
+	int result                                               = 0;
 
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
 	TP_WORK *thread_pool_work                                = NULL;
@@ -1199,13 +1754,13 @@ int libcthreads_thread_pool_push_sorted(
 	}
 	internal_thread_pool = (libcthreads_internal_thread_pool_t *) thread_pool;
 
-	if( internal_thread_pool->values_array == NULL )
+	if( internal_thread_pool->values_rings_array == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid queue - missing values array.",
+		 "%s: invalid thread pool - missing values rings array.",
 		 function );
 
 		return( -1 );
@@ -1244,153 +1799,41 @@ int libcthreads_thread_pool_push_sorted(
 
 		return( -1 );
 	}
-	if( libcthreads_mutex_grab(
-	     internal_thread_pool->condition_mutex,
-	     error ) != 1 )
+	/* The values are only popped in sorted order from a single values ring
+	 */
+	if( internal_thread_pool->number_of_values_rings != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid thread pool - sorted push not supported with work stealing.",
 		 function );
 
 		return( -1 );
 	}
-	while( internal_thread_pool->number_of_values == internal_thread_pool->allocated_number_of_values )
-	{
-		if( libcthreads_condition_wait(
-		     internal_thread_pool->full_condition,
-		     internal_thread_pool->condition_mutex,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for full condition.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	pop_index = internal_thread_pool->pop_index;
-
-	for( value_index = 0;
-	     value_index < internal_thread_pool->number_of_values;
-	     value_index++ )
-	{
-		compare_result = value_compare_function(
-				  value,
-				  internal_thread_pool->values_array[ pop_index ],
-				  error );
-
-		if( compare_result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to compare value: %d.",
-			 function,
-			 value_index );
-
-			goto on_error;
-		}
-		else if( compare_result == LIBCTHREADS_COMPARE_EQUAL )
-		{
-			if( ( sort_flags & LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES ) != 0 )
-			{
-				result = 0;
-
-				break;
-			}
-		}
-		else if( compare_result == LIBCTHREADS_COMPARE_LESS )
-		{
-			result = 1;
-
-			break;
-		}
-		else if( compare_result != LIBCTHREADS_COMPARE_GREATER )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported value compare function return value: %d.",
-			 function,
-			 compare_result );
-
-			goto on_error;
-		}
-		pop_index++;
-
-		if( pop_index >= internal_thread_pool->allocated_number_of_values )
-		{
-			pop_index = 0;
-		}
-	}
-	if( result != 0 )
-	{
-		push_index = internal_thread_pool->push_index;
-
-		if( compare_result == LIBCTHREADS_COMPARE_LESS )
-		{
-			previous_push_index = push_index - 1;
-
-			while( push_index != pop_index )
-			{
-				if( previous_push_index < 0 )
-				{
-					previous_push_index = internal_thread_pool->allocated_number_of_values - 1;
-				}
-				internal_thread_pool->values_array[ push_index ] = internal_thread_pool->values_array[ previous_push_index ];
-
-				push_index = previous_push_index;
-
-				previous_push_index--;
-			}
-		}
-		internal_thread_pool->values_array[ push_index ] = value;
-
-		internal_thread_pool->push_index++;
-
-		if( internal_thread_pool->push_index >= internal_thread_pool->allocated_number_of_values )
-		{
-			internal_thread_pool->push_index = 0;
-		}
-		internal_thread_pool->number_of_values++;
-
-		/* The condition broadcast must be protected by the mutex for the WINAPI version
-		 */
-		if( libcthreads_condition_broadcast(
-		     internal_thread_pool->empty_condition,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to broadcast empty condition.",
-			 function );
+	result = libcthreads_ring_push_sorted(
+	          internal_thread_pool->values_rings_array[ 0 ],
+	          value,
+	          value_compare_function,
+	          sort_flags,
+	          error );
 
-			goto on_error;
-		}
-	}
-	if( libcthreads_mutex_release(
-	     internal_thread_pool->condition_mutex,
-	     error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto values ring.",
 		 function );
 
 		return( -1 );
 	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
 	thread_pool_work = CreateThreadpoolWork(
 	                    &libcthreads_thread_pool_callback_function_helper,
@@ -1417,13 +1860,6 @@ int libcthreads_thread_pool_push_sorted(
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 
 	return( result );
-
-on_error:
-	libcthreads_mutex_release(
-	 internal_thread_pool->condition_mutex,
-	 NULL );
-
-	return( -1 );
 }
 
 /* Joins the current with a specified thread pool
@@ -1437,6 +1873,7 @@ int libcthreads_thread_pool_join(
 	libcthreads_internal_thread_pool_t *internal_thread_pool = NULL;
 	static char *function                                    = "libcthreads_thread_pool_join";
 	int result                                               = 1;
+	int values_ring_index                                    = 0;
 
 #if !defined( WINAPI ) || ( WINVER < 0x0602 )
 	int thread_index                                         = 0;
@@ -1476,70 +1913,47 @@ int libcthreads_thread_pool_join(
 	internal_thread_pool = (libcthreads_internal_thread_pool_t *) *thread_pool;
 	*thread_pool         = NULL;
 
-	if( libcthreads_mutex_grab(
-	     internal_thread_pool->condition_mutex,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab condition mutex.",
-		 function );
-
-		return( -1 );
-	}
 	internal_thread_pool->status = LIBCTHREADS_STATUS_EXIT;
 
-	/* Wake up the worker threads
+	/* Wake up the worker threads, these process the values that remain
+	 * in the queues and stop once the queues are empty
 	 */
-	if( libcthreads_condition_broadcast(
-	     internal_thread_pool->empty_condition,
-	     error ) != 1 )
+	for( values_ring_index = 0;
+	     values_ring_index < internal_thread_pool->number_of_values_rings;
+	     values_ring_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to broadcast empty condition.",
-		 function );
+		if( libcthreads_ring_close(
+		     internal_thread_pool->values_rings_array[ values_ring_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to close values ring: %d.",
+			 function,
+			 values_ring_index );
 
-		result = -1;
+			result = -1;
+		}
 	}
-	while( internal_thread_pool->number_of_values != 0 )
+	if( internal_thread_pool->number_of_values_rings > 1 )
 	{
-		/* Wait here to all the values in the queue have been processed
-		 */
-		if( libcthreads_condition_wait(
-		     internal_thread_pool->full_condition,
-		     internal_thread_pool->condition_mutex,
+		if( libcthreads_internal_thread_pool_signal_idle_threads(
+		     internal_thread_pool,
+		     1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to wait for full condition.",
+			 "%s: unable to signal idle threads.",
 			 function );
 
 			result = -1;
-
-			break;
 		}
 	}
-	if( libcthreads_mutex_release(
-	     internal_thread_pool->condition_mutex,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release condition mutex.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
 	CloseThreadpoolCleanupGroupMembers(
 	 internal_thread_pool->cleanup_group,
@@ -1629,44 +2043,60 @@ int libcthreads_thread_pool_join(
 		}
 	}
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
-	if( libcthreads_condition_free(
-	     &( internal_thread_pool->full_condition ),
-	     error ) != 1 )
+	for( values_ring_index = 0;
+	     values_ring_index < internal_thread_pool->number_of_values_rings;
+	     values_ring_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free full condition.",
-		 function );
+		if( libcthreads_ring_free(
+		     &( internal_thread_pool->values_rings_array[ values_ring_index ] ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free values ring: %d.",
+			 function,
+			 values_ring_index );
 
-		result = -1;
+			result = -1;
+		}
 	}
-	if( libcthreads_condition_free(
-	     &( internal_thread_pool->empty_condition ),
-	     error ) != 1 )
+	memory_free(
+	 internal_thread_pool->values_rings_array );
+
+	if( internal_thread_pool->work_condition != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free empty condition.",
-		 function );
+		if( libcthreads_condition_free(
+		     &( internal_thread_pool->work_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free work condition.",
+			 function );
 
-		result = -1;
+			result = -1;
+		}
 	}
-	if( libcthreads_mutex_free(
-	     &( internal_thread_pool->condition_mutex ),
-	     error ) != 1 )
+	if( internal_thread_pool->work_mutex != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free condition mutex.",
-		 function );
+		if( libcthreads_mutex_free(
+		     &( internal_thread_pool->work_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free work mutex.",
+			 function );
 
-		result = -1;
+			result = -1;
+		}
 	}
 #if defined( WINAPI ) && ( WINVER < 0x0602 )
 	memory_free(
@@ -1680,8 +2110,11 @@ int libcthreads_thread_pool_join(
 	 internal_thread_pool->threads_array );
 #endif
 
+#if !defined( WINAPI ) || ( WINVER < 0x0602 )
 	memory_free(
-	 internal_thread_pool->values_array );
+	 internal_thread_pool->workers_array );
+#endif
+
 	memory_free(
 	 internal_thread_pool );
 
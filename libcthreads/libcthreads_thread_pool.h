@@ -31,6 +31,7 @@
 
 #include "libcthreads_extern.h"
 #include "libcthreads_libcerror.h"
+#include "libcthreads_ring.h"
 #include "libcthreads_types.h"
 
 #if defined( __cplusplus )
@@ -41,6 +42,23 @@ extern "C" {
 
 typedef struct libcthreads_internal_thread_pool libcthreads_internal_thread_pool_t;
 
+#if !defined( WINAPI ) || ( WINVER < 0x0602 )
+
+typedef struct libcthreads_thread_pool_worker libcthreads_thread_pool_worker_t;
+
+struct libcthreads_thread_pool_worker
+{
+	/* The thread pool
+	 */
+	libcthreads_internal_thread_pool_t *internal_thread_pool;
+
+	/* The index of the values ring the worker pops its values from
+	 */
+	int values_ring_index;
+};
+
+#endif /* !defined( WINAPI ) || ( WINVER < 0x0602 ) */
+
 struct libcthreads_internal_thread_pool
 {
 #if defined( WINAPI ) && ( WINVER >= 0x0602 )
@@ -79,6 +97,10 @@ struct libcthreads_internal_thread_pool
 #error Missing thread type
 #endif
 
+	/* The workers array
+	 */
+	libcthreads_thread_pool_worker_t *workers_array;
+
 #endif /* defined( WINAPI ) && ( WINVER >= 0x0602 ) */
 
 	/* The callback function
@@ -91,37 +113,38 @@ struct libcthreads_internal_thread_pool
 	 */
 	void *callback_function_arguments;
 
-	/* The (current) pop index
+	/* The number of values rings
+	 * This is 1 unless work stealing is enabled, in which case
+	 * every thread has its own values ring
 	 */
-	int pop_index;
+	int number_of_values_rings;
 
-	/* The (current) push index
+	/* The values rings array
 	 */
-	int push_index;
+	libcthreads_ring_t **values_rings_array;
 
-	/* The number of values
+	/* The (next) push index, used to distribute the values over the values rings
 	 */
-	int number_of_values;
+	uint32_t push_index;
 
-	/* The allocated number of values
+	/* The work mutex
+	 * With work stealing the threads wait on the work condition instead of
+	 * their own values ring, so that a value pushed onto any values ring
+	 * wakes up an idle thread
 	 */
-	int allocated_number_of_values;
+	libcthreads_mutex_t *work_mutex;
 
-	/* The values array
+	/* The work condition, signalled when a value was pushed
 	 */
-	intptr_t **values_array;
+	libcthreads_condition_t *work_condition;
 
-	/* The condition mutex
+	/* The number of threads waiting on the work condition
 	 */
-	libcthreads_mutex_t *condition_mutex;
+	int number_of_idle_threads;
 
-	/* The queue empty condition
+	/* The flags
 	 */
-	libcthreads_condition_t *empty_condition;
-
-	/* The queue full condition
-	 */
-	libcthreads_condition_t *full_condition;
+	uint8_t flags;
 
 	/* The status
 	 */
@@ -140,8 +163,42 @@ int libcthreads_thread_pool_create(
      void *callback_function_arguments,
      libcerror_error_t **error );
 
+LIBCTHREADS_EXTERN \
+int libcthreads_thread_pool_create_with_flags(
+     libcthreads_thread_pool_t **thread_pool,
+     const libcthreads_thread_attributes_t *thread_attributes,
+     int number_of_threads,
+     int maximum_number_of_values,
+     int (*callback_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *callback_function_arguments,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+#if defined( HAVE_PTHREAD_H ) && !defined( WINAPI )
+
+int libcthreads_internal_thread_pool_pin_thread(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     int thread_index,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_PTHREAD_H ) && !defined( WINAPI ) */
+
+int libcthreads_internal_thread_pool_signal_idle_threads(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     int broadcast,
+     libcerror_error_t **error );
+
+int libcthreads_internal_thread_pool_try_pop(
+     libcthreads_internal_thread_pool_t *internal_thread_pool,
+     int values_ring_index,
+     intptr_t **value,
+     libcerror_error_t **error );
+
 int libcthreads_internal_thread_pool_pop(
      libcthreads_internal_thread_pool_t *internal_thread_pool,
+     int values_ring_index,
      intptr_t **value,
      libcerror_error_t **error );
 
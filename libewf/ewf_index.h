@@ -0,0 +1,224 @@
+/*
+ * EWF index file
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_INDEX_H )
+#define _EWF_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The index file header
+ */
+typedef struct ewf_index_file_header ewf_index_file_header_t;
+
+struct ewf_index_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The number of segments
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_segments[ 4 ];
+};
+
+/* The index file segment
+ * The segment is followed by the section offsets and the chunk groups
+ */
+typedef struct ewf_index_segment ewf_index_segment_t;
+
+struct ewf_index_segment
+{
+	/* The segment file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t segment_file_size[ 8 ];
+
+	/* The segment number
+	 * Consists of 4 bytes
+	 */
+	uint8_t segment_number[ 4 ];
+
+	/* The segment file type
+	 * Consists of 1 byte
+	 */
+	uint8_t type;
+
+	/* The major version
+	 * Consists of 1 byte
+	 */
+	uint8_t major_version;
+
+	/* The minor version
+	 * Consists of 1 byte
+	 */
+	uint8_t minor_version;
+
+	/* The segment file flags
+	 * Consists of 1 byte
+	 */
+	uint8_t flags;
+
+	/* The compression method
+	 * Consists of 2 bytes
+	 */
+	uint8_t compression_method[ 2 ];
+
+	/* Padding
+	 * Consists of 2 bytes
+	 */
+	uint8_t padding1[ 2 ];
+
+	/* The set identifier
+	 * Consists of 16 bytes
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The current offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t current_offset[ 8 ];
+
+	/* The last section offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_section_offset[ 8 ];
+
+	/* The device information section index
+	 * Consists of 4 bytes
+	 */
+	uint8_t device_information_section_index[ 4 ];
+
+	/* The number of sections
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_sections[ 4 ];
+
+	/* The number of chunk groups
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunk_groups[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding2[ 4 ];
+
+	/* The storage media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t storage_media_size[ 8 ];
+
+	/* The number of chunks
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_chunks[ 8 ];
+
+	/* The previous last chunk that was filled
+	 * Consists of 8 bytes
+	 */
+	uint8_t previous_last_chunk_filled[ 8 ];
+
+	/* The last chunk that was filled
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_chunk_filled[ 8 ];
+
+	/* The last chunk that was compared
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_chunk_compared[ 8 ];
+
+	/* The segment file modification time
+	 * Consists of 8 bytes
+	 * Contains a platform specific timestamp or 0 if not available
+	 */
+	uint8_t segment_file_modification_time[ 8 ];
+};
+
+/* The index file section
+ */
+typedef struct ewf_index_section ewf_index_section_t;
+
+struct ewf_index_section
+{
+	/* The section descriptor offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+};
+
+/* The index file chunk group
+ */
+typedef struct ewf_index_chunk_group ewf_index_chunk_group_t;
+
+struct ewf_index_chunk_group
+{
+	/* The chunk group data offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* The chunk group data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t size[ 8 ];
+
+	/* The storage media size of the chunks in the group
+	 * Consists of 8 bytes
+	 */
+	uint8_t mapped_size[ 8 ];
+
+	/* The range flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t range_flags[ 4 ];
+};
+
+/* The index file footer
+ */
+typedef struct ewf_index_file_footer ewf_index_file_footer_t;
+
+struct ewf_index_file_footer
+{
+	/* The checksum of all (previous) index file data
+	 * Consists of 4 bytes
+	 */
+	uint8_t checksum[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_INDEX_H ) */
+
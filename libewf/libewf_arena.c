@@ -0,0 +1,305 @@
+/*
+ * Arena functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_arena.h"
+#include "libewf_libcerror.h"
+
+/* The alignment of the values allocated from the arena
+ */
+#define LIBEWF_ARENA_ALIGNMENT		8
+
+/* Creates an arena block with its data in the same allocation
+ * Returns 1 if successful or -1 on error
+ */
+static int libewf_arena_block_initialize(
+            libewf_arena_block_t **block,
+            size_t data_size,
+            libcerror_error_t **error )
+{
+	static char *function = "libewf_arena_block_initialize";
+
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) ( SSIZE_MAX - sizeof( libewf_arena_block_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*block = (libewf_arena_block_t *) memory_allocate(
+	                                   sizeof( libewf_arena_block_t ) + data_size );
+
+	if( *block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block.",
+		 function );
+
+		return( -1 );
+	}
+	( *block )->previous_block = NULL;
+	( *block )->data           = &( ( (uint8_t *) *block )[ sizeof( libewf_arena_block_t ) ] );
+	( *block )->data_size      = data_size;
+	( *block )->data_offset    = 0;
+
+	return( 1 );
+}
+
+/* Creates an arena
+ * Make sure the value arena is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_arena_initialize(
+     libewf_arena_t **arena,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_arena_initialize";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *arena != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid arena value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size < LIBEWF_ARENA_ALIGNMENT )
+	 || ( block_size > (size_t) ( SSIZE_MAX - sizeof( libewf_arena_block_t ) ) )
+	 || ( ( block_size % LIBEWF_ARENA_ALIGNMENT ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*arena = memory_allocate_structure(
+	          libewf_arena_t );
+
+	if( *arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create arena.",
+		 function );
+
+		return( -1 );
+	}
+	( *arena )->current_block = NULL;
+	( *arena )->block_size    = block_size;
+
+	return( 1 );
+}
+
+/* Frees an arena including all values allocated from it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_arena_free(
+     libewf_arena_t **arena,
+     libcerror_error_t **error )
+{
+	libewf_arena_block_t *block = NULL;
+	static char *function       = "libewf_arena_free";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( *arena != NULL )
+	{
+		while( ( *arena )->current_block != NULL )
+		{
+			block = ( *arena )->current_block;
+
+			( *arena )->current_block = block->previous_block;
+
+			memory_free(
+			 block );
+		}
+		memory_free(
+		 *arena );
+
+		*arena = NULL;
+	}
+	return( 1 );
+}
+
+/* Allocates a value from the arena
+ * The value is aligned and not initialized, it is freed when the arena is freed
+ * A value larger than a quarter of the block size gets a block of its own
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_arena_allocate(
+     libewf_arena_t *arena,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error )
+{
+	libewf_arena_block_t *block = NULL;
+	static char *function       = "libewf_arena_allocate";
+
+	if( arena == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid arena.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) ( SSIZE_MAX - LIBEWF_ARENA_ALIGNMENT ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size % LIBEWF_ARENA_ALIGNMENT ) != 0 )
+	{
+		size += LIBEWF_ARENA_ALIGNMENT - ( size % LIBEWF_ARENA_ALIGNMENT );
+	}
+	if( size > ( arena->block_size / 4 ) )
+	{
+		if( libewf_arena_block_initialize(
+		     &block,
+		     size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block.",
+			 function );
+
+			return( -1 );
+		}
+		/* Insert the block behind the current block so the unused data
+		 * of the current block is still used
+		 */
+		if( arena->current_block == NULL )
+		{
+			arena->current_block = block;
+		}
+		else
+		{
+			block->previous_block                = arena->current_block->previous_block;
+			arena->current_block->previous_block = block;
+		}
+		block->data_offset = size;
+
+		*data = block->data;
+
+		return( 1 );
+	}
+	if( ( arena->current_block == NULL )
+	 || ( size > ( arena->current_block->data_size - arena->current_block->data_offset ) ) )
+	{
+		if( libewf_arena_block_initialize(
+		     &block,
+		     arena->block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create block.",
+			 function );
+
+			return( -1 );
+		}
+		block->previous_block = arena->current_block;
+		arena->current_block  = block;
+	}
+	*data = &( arena->current_block->data[ arena->current_block->data_offset ] );
+
+	arena->current_block->data_offset += size;
+
+	return( 1 );
+}
+
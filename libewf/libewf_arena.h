@@ -0,0 +1,89 @@
+/*
+ * Arena functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ARENA_H )
+#define _LIBEWF_ARENA_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_arena_block libewf_arena_block_t;
+
+struct libewf_arena_block
+{
+	/* The previous block
+	 */
+	libewf_arena_block_t *previous_block;
+
+	/* The data, which directly follows the block
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The offset of the unused data
+	 */
+	size_t data_offset;
+};
+
+typedef struct libewf_arena libewf_arena_t;
+
+struct libewf_arena
+{
+	/* The block from which values are allocated
+	 * it links to the previous blocks
+	 */
+	libewf_arena_block_t *current_block;
+
+	/* The block size
+	 */
+	size_t block_size;
+};
+
+int libewf_arena_initialize(
+     libewf_arena_t **arena,
+     size_t block_size,
+     libcerror_error_t **error );
+
+int libewf_arena_free(
+     libewf_arena_t **arena,
+     libcerror_error_t **error );
+
+int libewf_arena_allocate(
+     libewf_arena_t *arena,
+     size_t size,
+     uint8_t **data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ARENA_H ) */
+
@@ -31,7 +31,13 @@
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( LIBEWF_HAVE_X86_SIMD )
+#include <immintrin.h>
+#endif
+
+/* The Adler-32 implementation selected for the CPU
+ */
+static libewf_checksum_adler32_function_t libewf_checksum_adler32_function = NULL;
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
@@ -44,7 +50,8 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_checksum_calculate_adler32";
+	libewf_checksum_adler32_function_t adler32_function = NULL;
+	static char *function                               = "libewf_checksum_calculate_adler32";
 
 	if( checksum_value == NULL )
 	{
@@ -68,7 +75,7 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	if( size > (size_t) UINT_MAX )
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
@@ -79,13 +86,428 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	*checksum_value = adler32(
-	                   (uLong) initial_value,
-	                   (const Bytef *) buffer,
-	                   (uInt) size );
+	adler32_function = libewf_checksum_adler32_function;
+
+	if( adler32_function == NULL )
+	{
+		/* Concurrent callers select the same implementation
+		 */
+		adler32_function = libewf_checksum_get_adler32_function();
+
+		libewf_checksum_adler32_function = adler32_function;
+	}
+	*checksum_value = adler32_function(
+	                   initial_value,
+	                   buffer,
+	                   size );
 
 	return( 1 );
 }
 
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+/* Retrieves the fastest Adler-32 implementation supported by the CPU
+ * Returns the Adler-32 function
+ */
+libewf_checksum_adler32_function_t libewf_checksum_get_adler32_function(
+                                    void )
+{
+#if defined( LIBEWF_HAVE_X86_SIMD )
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		return( &libewf_checksum_calculate_adler32_avx2 );
+	}
+	if( __builtin_cpu_supports( "sse2" ) )
+	{
+		return( &libewf_checksum_calculate_adler32_sse2 );
+	}
+#endif
+	return( &libewf_checksum_calculate_adler32_generic );
+}
+
+/* Calculates the little-endian Adler-32 of a buffer
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+uint32_t libewf_checksum_calculate_adler32_generic(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size )
+{
+	size_t buffer_offset = 0;
+	uint32_t lower_word  = 0;
+	uint32_t upper_word  = 0;
+	uint32_t value_32bit = 0;
+	int block_index      = 0;
+
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+	if( size <= (size_t) UINT_MAX )
+	{
+		return( (uint32_t) adler32(
+		                    (uLong) initial_value,
+		                    (const Bytef *) buffer,
+		                    (uInt) size ) );
+	}
+#endif
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( size >= 0x15b0 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 16 = 347
+		 */
+		for( block_index = 0;
+		     block_index < 347;
+		     block_index++ )
+		{
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+		}
+		/* Optimized equivalent of:
+		 * lower_word %= 0xfff1
+		 */
+		value_32bit = lower_word >> 16;
+		lower_word &= 0x0000ffffUL;
+		lower_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( lower_word > 65521 )
+		{
+			value_32bit = lower_word >> 16;
+			lower_word &= 0x0000ffffUL;
+			lower_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( lower_word >= 65521 )
+		{
+			lower_word -= 65521;
+		}
+		/* Optimized equivalent of:
+		 * upper_word %= 0xfff1
+		 */
+		value_32bit = upper_word >> 16;
+		upper_word &= 0x0000ffffUL;
+		upper_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( upper_word > 65521 )
+		{
+			value_32bit = upper_word >> 16;
+			upper_word &= 0x0000ffffUL;
+			upper_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( upper_word >= 65521 )
+		{
+			upper_word -= 65521;
+		}
+		size -= 0x15b0;
+	}
+	if( size > 0 )
+	{
+		while( size > 16 )
+		{
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			size -= 16;
+		}
+		while( size > 0 )
+		{
+			lower_word += buffer[ buffer_offset++ ];
+			upper_word += lower_word;
+
+			size--;
+		}
+		/* Optimized equivalent of:
+		 * lower_word %= 0xfff1
+		 */
+		value_32bit = lower_word >> 16;
+		lower_word &= 0x0000ffffUL;
+		lower_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( lower_word > 65521 )
+		{
+			value_32bit = lower_word >> 16;
+			lower_word &= 0x0000ffffUL;
+			lower_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( lower_word >= 65521 )
+		{
+			lower_word -= 65521;
+		}
+		/* Optimized equivalent of:
+		 * upper_word %= 0xfff1
+		 */
+		value_32bit = upper_word >> 16;
+		upper_word &= 0x0000ffffUL;
+		upper_word += ( value_32bit << 4 ) - value_32bit;
+
+		if( upper_word > 65521 )
+		{
+			value_32bit = upper_word >> 16;
+			upper_word &= 0x0000ffffUL;
+			upper_word += ( value_32bit << 4 ) - value_32bit;
+		}
+		if( upper_word >= 65521 )
+		{
+			upper_word -= 65521;
+		}
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#if defined( LIBEWF_HAVE_X86_SIMD )
+
+/* Calculates the little-endian Adler-32 of a buffer using SSE2
+ * Blocks of 16 bytes are summed in parallel, the remaining bytes are handled
+ * by libewf_checksum_calculate_adler32_generic
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+__attribute__((target("sse2")))
+uint32_t libewf_checksum_calculate_adler32_sse2(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size )
+{
+	__m128i lower_word_sums    = _mm_setzero_si128();
+	__m128i previous_sums      = _mm_setzero_si128();
+	__m128i upper_word_sums    = _mm_setzero_si128();
+	__m128i value_128bit       = _mm_setzero_si128();
+	__m128i weights_high       = _mm_set_epi16( 1, 2, 3, 4, 5, 6, 7, 8 );
+	__m128i weights_low        = _mm_set_epi16( 9, 10, 11, 12, 13, 14, 15, 16 );
+	__m128i zero_128bit        = _mm_setzero_si128();
+	uint32_t lower_word        = 0;
+	uint32_t upper_word        = 0;
+	size_t number_of_blocks    = 0;
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( size >= 16 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 16 = 347
+		 */
+		number_of_blocks = size / 16;
+
+		if( number_of_blocks > 347 )
+		{
+			number_of_blocks = 347;
+		}
+		size -= number_of_blocks * 16;
+
+		/* The lower word at the start of every block is added to the upper word
+		 * for every byte in the block, the previous sums are multiplied by 16 afterwards
+		 */
+		previous_sums   = _mm_cvtsi32_si128( (int) ( lower_word * number_of_blocks ) );
+		upper_word_sums = _mm_cvtsi32_si128( (int) upper_word );
+		lower_word_sums = _mm_setzero_si128();
+
+		while( number_of_blocks > 0 )
+		{
+			value_128bit = _mm_loadu_si128(
+			                (__m128i *) buffer );
+
+			previous_sums   = _mm_add_epi32( previous_sums, lower_word_sums );
+			lower_word_sums = _mm_add_epi32( lower_word_sums, _mm_sad_epu8( value_128bit, zero_128bit ) );
+
+			upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_madd_epi16( _mm_unpacklo_epi8( value_128bit, zero_128bit ), weights_low ) );
+			upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_madd_epi16( _mm_unpackhi_epi8( value_128bit, zero_128bit ), weights_high ) );
+
+			buffer           += 16;
+			number_of_blocks -= 1;
+		}
+		upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_slli_epi32( previous_sums, 4 ) );
+
+		lower_word_sums = _mm_add_epi32( lower_word_sums, _mm_shuffle_epi32( lower_word_sums, 0x4e ) );
+		lower_word_sums = _mm_add_epi32( lower_word_sums, _mm_shuffle_epi32( lower_word_sums, 0xb1 ) );
+		upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_shuffle_epi32( upper_word_sums, 0x4e ) );
+		upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_shuffle_epi32( upper_word_sums, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_word_sums );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( upper_word_sums );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	return( libewf_checksum_calculate_adler32_generic(
+	         ( upper_word << 16 ) | lower_word,
+	         buffer,
+	         size ) );
+}
+
+/* Calculates the little-endian Adler-32 of a buffer using AVX2
+ * Blocks of 32 bytes are summed in parallel, the remaining bytes are handled
+ * by libewf_checksum_calculate_adler32_generic
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+__attribute__((target("avx2")))
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size )
+{
+	__m256i lower_word_sums    = _mm256_setzero_si256();
+	__m256i ones_256bit        = _mm256_set1_epi16( 1 );
+	__m256i previous_sums      = _mm256_setzero_si256();
+	__m256i upper_word_sums    = _mm256_setzero_si256();
+	__m256i value_256bit       = _mm256_setzero_si256();
+	__m256i weights            = _mm256_set_epi8(
+	                              1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+	                              17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32 );
+	__m256i zero_256bit        = _mm256_setzero_si256();
+	__m128i lower_word_128bit  = _mm_setzero_si128();
+	__m128i upper_word_128bit  = _mm_setzero_si128();
+	uint32_t lower_word        = 0;
+	uint32_t upper_word        = 0;
+	size_t number_of_blocks    = 0;
+
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( size >= 32 )
+	{
+		/* The modulo calculation is needed per 5552 (0x15b0) bytes
+		 * 5552 / 32 = 173
+		 */
+		number_of_blocks = size / 32;
+
+		if( number_of_blocks > 173 )
+		{
+			number_of_blocks = 173;
+		}
+		size -= number_of_blocks * 32;
+
+		/* The lower word at the start of every block is added to the upper word
+		 * for every byte in the block, the previous sums are multiplied by 32 afterwards
+		 */
+		previous_sums   = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) ( lower_word * number_of_blocks ) );
+		upper_word_sums = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) upper_word );
+		lower_word_sums = _mm256_setzero_si256();
+
+		while( number_of_blocks > 0 )
+		{
+			value_256bit = _mm256_loadu_si256(
+			                (__m256i *) buffer );
+
+			previous_sums   = _mm256_add_epi32( previous_sums, lower_word_sums );
+			lower_word_sums = _mm256_add_epi32( lower_word_sums, _mm256_sad_epu8( value_256bit, zero_256bit ) );
+			upper_word_sums = _mm256_add_epi32( upper_word_sums, _mm256_madd_epi16( _mm256_maddubs_epi16( value_256bit, weights ), ones_256bit ) );
+
+			buffer           += 32;
+			number_of_blocks -= 1;
+		}
+		upper_word_sums = _mm256_add_epi32( upper_word_sums, _mm256_slli_epi32( previous_sums, 5 ) );
+
+		lower_word_128bit = _mm_add_epi32( _mm256_castsi256_si128( lower_word_sums ), _mm256_extracti128_si256( lower_word_sums, 1 ) );
+		upper_word_128bit = _mm_add_epi32( _mm256_castsi256_si128( upper_word_sums ), _mm256_extracti128_si256( upper_word_sums, 1 ) );
+
+		lower_word_128bit = _mm_add_epi32( lower_word_128bit, _mm_shuffle_epi32( lower_word_128bit, 0x4e ) );
+		lower_word_128bit = _mm_add_epi32( lower_word_128bit, _mm_shuffle_epi32( lower_word_128bit, 0xb1 ) );
+		upper_word_128bit = _mm_add_epi32( upper_word_128bit, _mm_shuffle_epi32( upper_word_128bit, 0x4e ) );
+		upper_word_128bit = _mm_add_epi32( upper_word_128bit, _mm_shuffle_epi32( upper_word_128bit, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_word_128bit );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( upper_word_128bit );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	return( libewf_checksum_calculate_adler32_generic(
+	         ( upper_word << 16 ) | lower_word,
+	         buffer,
+	         size ) );
+}
+
+#endif /* defined( LIBEWF_HAVE_X86_SIMD ) */
 
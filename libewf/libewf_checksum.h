@@ -25,14 +25,17 @@
 #include <common.h>
 #include <types.h>
 
-#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
+#include "libewf_simd.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+typedef uint32_t (*libewf_checksum_adler32_function_t)(
+                    uint32_t initial_value,
+                    const uint8_t *buffer,
+                    size_t size );
 
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
@@ -41,11 +44,27 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
-#else
-#define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
+libewf_checksum_adler32_function_t libewf_checksum_get_adler32_function(
+                                    void );
 
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+uint32_t libewf_checksum_calculate_adler32_generic(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size );
+
+#if defined( LIBEWF_HAVE_X86_SIMD )
+
+uint32_t libewf_checksum_calculate_adler32_sse2(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size );
+
+uint32_t libewf_checksum_calculate_adler32_avx2(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size );
+
+#endif /* defined( LIBEWF_HAVE_X86_SIMD ) */
 
 #if defined( __cplusplus )
 }
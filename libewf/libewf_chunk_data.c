@@ -33,8 +33,14 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_simd.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
+#include "libewf_write_buffer.h"
+
+#if defined( LIBEWF_HAVE_X86_SIMD )
+#include <immintrin.h>
+#endif
 
 /* Creates chunk data
  * Make sure the value chunk_data is referencing, is set to NULL
@@ -159,9 +165,10 @@ int libewf_chunk_data_initialize(
 			goto on_error;
 		}
 	}
-	( *chunk_data )->chunk_size          = chunk_size;
-	( *chunk_data )->allocated_data_size = allocated_data_size;
-	( *chunk_data )->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+	( *chunk_data )->chunk_size           = chunk_size;
+	( *chunk_data )->allocated_data_size  = allocated_data_size;
+	( *chunk_data )->flags                = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+	( *chunk_data )->number_of_references = 1;
 
 	return( 1 );
 
@@ -182,13 +189,16 @@ on_error:
 }
 
 /* Frees chunk data
+ * Releases the reference held by the caller, the chunk data is only freed
+ * when the last reference is released
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_data_free";
+	static char *function    = "libewf_chunk_data_free";
+	int number_of_references = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -203,6 +213,37 @@ int libewf_chunk_data_free(
 	}
 	if( *chunk_data != NULL )
 	{
+#if defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES )
+		number_of_references = __atomic_sub_fetch(
+		                        &( ( *chunk_data )->number_of_references ),
+		                        1,
+		                        __ATOMIC_ACQ_REL );
+#else
+		( *chunk_data )->number_of_references -= 1;
+
+		number_of_references = ( *chunk_data )->number_of_references;
+#endif
+		if( number_of_references < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk data - number of references value out of bounds.",
+			 function );
+
+			*chunk_data = NULL;
+
+			return( -1 );
+		}
+		/* The chunk data is still referenced by a chunk view
+		 */
+		if( number_of_references > 0 )
+		{
+			*chunk_data = NULL;
+
+			return( 1 );
+		}
 		if( ( ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
 			if( ( *chunk_data )->data != NULL )
@@ -211,10 +252,13 @@ int libewf_chunk_data_free(
 				 ( *chunk_data )->data );
 			}
 		}
-		if( ( *chunk_data )->compressed_data != NULL )
+		if( ( ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MAPPED_DATA ) == 0 )
 		{
-			memory_free(
-			 ( *chunk_data )->compressed_data );
+			if( ( *chunk_data )->compressed_data != NULL )
+			{
+				memory_free(
+				 ( *chunk_data )->compressed_data );
+			}
 		}
 		memory_free(
 		 *chunk_data );
@@ -224,6 +268,72 @@ int libewf_chunk_data_free(
 	return( 1 );
 }
 
+/* Grabs an additional reference to the chunk data
+ * The reference is released with libewf_chunk_data_free
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_grab_reference(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_chunk_data_grab_reference";
+	int number_of_references = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES )
+	number_of_references = __atomic_load_n(
+	                        &( chunk_data->number_of_references ),
+	                        __ATOMIC_RELAXED );
+
+	do
+	{
+		if( ( number_of_references <= 0 )
+		 || ( number_of_references == INT_MAX ) )
+		{
+			break;
+		}
+	}
+	while( __atomic_compare_exchange_n(
+	        &( chunk_data->number_of_references ),
+	        &number_of_references,
+	        number_of_references + 1,
+	        1,
+	        __ATOMIC_ACQ_REL,
+	        __ATOMIC_RELAXED ) == 0 );
+#else
+	number_of_references = chunk_data->number_of_references;
+
+	if( ( number_of_references > 0 )
+	 && ( number_of_references < INT_MAX ) )
+	{
+		chunk_data->number_of_references += 1;
+	}
+#endif
+	if( ( number_of_references <= 0 )
+	 || ( number_of_references == INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data - number of references value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Clones the chunk data
  * Returns 1 if successful or -1 on error
  */
@@ -295,8 +405,13 @@ int libewf_chunk_data_clone(
 
 		return( -1 );
 	}
-	( *destination_chunk_data )->data            = NULL;
-	( *destination_chunk_data )->compressed_data = NULL;
+	( *destination_chunk_data )->data                 = NULL;
+	( *destination_chunk_data )->compressed_data      = NULL;
+	( *destination_chunk_data )->number_of_references = 1;
+
+	/* The destination chunk data contains a copy of the mapped data
+	 */
+	( *destination_chunk_data )->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
 	if( source_chunk_data->data != NULL )
 	{
@@ -566,6 +681,7 @@ int libewf_chunk_data_pack(
 	static char *function            = "libewf_chunk_data_pack";
 	size_t safe_compressed_data_size = 0;
 	uint64_t fill_pattern            = 0;
+	uint8_t is_empty_block           = 0;
 	int result                       = 0;
 
 	if( chunk_data == NULL )
@@ -624,12 +740,15 @@ int libewf_chunk_data_pack(
 	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
 	 || ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 ) )
 	{
-		if( ( chunk_data->data_size % 8 ) == 0 )
+		result = 0;
+
+		if( chunk_data->data_size > 1 )
 		{
-			result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+			result = libewf_chunk_data_check_for_fill(
 				  chunk_data->data,
 				  chunk_data->data_size,
 				  &fill_pattern,
+				  &is_empty_block,
 				  error );
 
 			if( result == -1 )
@@ -643,7 +762,11 @@ int libewf_chunk_data_pack(
 
 				goto on_error;
 			}
-			else if( result != 0 )
+		}
+		if( result != 0 )
+		{
+			if( ( chunk_data->data_size > 8 )
+			 && ( ( chunk_data->data_size % 8 ) == 0 ) )
 			{
 				if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
 				 || ( fill_pattern == 0 ) )
@@ -661,33 +784,14 @@ int libewf_chunk_data_pack(
 					}
 				}
 			}
-		}
-		else if( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
-		{
-			result = libewf_chunk_data_check_for_empty_block(
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if chunk data is an empty block.",
-				 function );
-
-				goto on_error;
-			}
-			else if( result != 0 )
+			else if( ( ( chunk_data->data_size % 8 ) != 0 )
+			      && ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+			      && ( is_empty_block != 0 )
+			      && ( chunk_data->data[ 0 ] == 0 ) )
 			{
-				if( chunk_data->data[ 0 ] == 0 )
-				{
-					pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
-					pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
-					pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
-				}
+				pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+				pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
+				pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
 			}
 		}
 	}
@@ -1138,6 +1242,10 @@ int libewf_chunk_data_unpack(
 
 				goto on_error;
 			}
+			if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MAPPED_DATA ) != 0 )
+			{
+				chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+			}
 			if( memory_set(
 			     chunk_data->data,
 			     0,
@@ -1306,6 +1414,34 @@ int libewf_chunk_data_unpack(
 	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
 	 && ( io_handle->zero_on_error != 0 ) )
 	{
+		/* The mapped data is read-only hence the zeroed data is stored separately
+		 */
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) == 0 )
+		{
+			chunk_data->allocated_data_size = (size_t) ( chunk_data->chunk_size + 4 );
+
+			if( ( chunk_data->allocated_data_size % 16 ) != 0 )
+			{
+				chunk_data->allocated_data_size += 16;
+			}
+			chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
+
+			chunk_data->data = (uint8_t *) memory_allocate(
+			                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
+
+			if( chunk_data->data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create data.",
+				 function );
+
+				return( -1 );
+			}
+			chunk_data->flags |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		}
 		if( memory_set(
 		     chunk_data->data,
 		     0,
@@ -1334,12 +1470,21 @@ on_error:
 		chunk_data->data      = chunk_data->compressed_data;
 		chunk_data->data_size = chunk_data->compressed_data_size;
 
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MAPPED_DATA ) != 0 )
+		{
+			chunk_data->flags &= ~( LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA );
+		}
+
 		chunk_data->compressed_data      = NULL;
 		chunk_data->compressed_data_size = 0;
 	}
 	return( -1 );
 }
 
+/* The 64-bit pattern fill check implementation selected for the CPU
+ */
+static libewf_chunk_data_pattern_fill_function_t libewf_chunk_data_pattern_fill_function = NULL;
+
 /* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
  * Returns 1 if a pattern was found, 0 if not or -1 on error
  */
@@ -1348,111 +1493,108 @@ int libewf_chunk_data_check_for_empty_block(
      size_t data_size,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_empty_block";
+	static char *function  = "libewf_chunk_data_check_for_empty_block";
+	uint64_t pattern       = 0;
+	uint8_t is_empty_block = 0;
+	int result             = 0;
 
-	if( data == NULL )
+	if( data_size <= 1 )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_data_check_for_fill(
+	          data,
+	          data_size,
+	          &pattern,
+	          &is_empty_block,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if data is filled.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	else if( ( result != 0 )
+	      && ( is_empty_block != 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
+ * Returns 1 if a pattern was found, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_64_bit_pattern_fill(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *pattern,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	uint8_t is_empty_block = 0;
+	int result             = 0;
+
+	if( pattern == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pattern.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_size <= 1 )
+	if( ( data_size <= 8 )
+	 || ( data_size % 8 ) != 0 )
 	{
 		return( 0 );
 	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 1;
-
-	data_size--;
+	result = libewf_chunk_data_check_for_fill(
+	          data,
+	          data_size,
+	          pattern,
+	          &is_empty_block,
+	          error );
 
-	/* Only optimize for data larger than the alignment
-	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	if( result == -1 )
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
-
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_index++;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if data is filled.",
+		 function );
 
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_index = (uint8_t *) aligned_data_index;
-	}
-	while( data_size != 0 )
-	{
-		if( *data_start != *data_index )
-		{
-			return( 0 );
-		}
-		data_index++;
-		data_size--;
+		return( -1 );
 	}
-	return( 1 );
+	return( result );
 }
 
-/* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
+/* Checks if a buffer containing the chunk data is filled with a repeating 64-bit pattern
+ * Data filled with same value bytes (empty-block) is a special case of such a pattern,
+ * hence both are determined in a single pass over the data
+ * The pattern is set to the first 8 bytes of the data, or 0 if the data is smaller
  * Returns 1 if a pattern was found, 0 if not or -1 on error
  */
-int libewf_chunk_data_check_for_64_bit_pattern_fill(
+int libewf_chunk_data_check_for_fill(
      const uint8_t *data,
      size_t data_size,
      uint64_t *pattern,
+     uint8_t *is_empty_block,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	libewf_chunk_data_pattern_fill_function_t pattern_fill_function = NULL;
+	static char *function                                           = "libewf_chunk_data_check_for_fill";
+	size_t data_offset                                              = 0;
+	size_t pattern_size                                             = 0;
 
 	if( data == NULL )
 	{
@@ -1465,13 +1607,14 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 
 		return( -1 );
 	}
-	if( data_size > (size_t) SSIZE_MAX )
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -1487,11 +1630,102 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 
 		return( -1 );
 	}
-	if( ( data_size <= 8 )
-	 || ( data_size % 8 ) != 0 )
+	if( is_empty_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is empty block.",
+		 function );
+
+		return( -1 );
+	}
+	pattern_fill_function = libewf_chunk_data_pattern_fill_function;
+
+	if( pattern_fill_function == NULL )
+	{
+		/* Concurrent callers select the same implementation
+		 */
+		pattern_fill_function = libewf_chunk_data_get_pattern_fill_function();
+
+		libewf_chunk_data_pattern_fill_function = pattern_fill_function;
+	}
+	*pattern        = 0;
+	*is_empty_block = 0;
+
+	if( pattern_fill_function(
+	     data,
+	     data_size ) == 0 )
 	{
 		return( 0 );
 	}
+	if( data_size >= 8 )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 data,
+		 *pattern );
+
+		pattern_size = 8;
+	}
+	else
+	{
+		pattern_size = data_size;
+	}
+	for( data_offset = 1;
+	     data_offset < pattern_size;
+	     data_offset++ )
+	{
+		if( data[ data_offset ] != data[ 0 ] )
+		{
+			break;
+		}
+	}
+	if( data_offset >= pattern_size )
+	{
+		*is_empty_block = 1;
+	}
+	return( 1 );
+}
+
+/* Retrieves the fastest 64-bit pattern fill check implementation supported by the CPU
+ * Returns the 64-bit pattern fill check function
+ */
+libewf_chunk_data_pattern_fill_function_t libewf_chunk_data_get_pattern_fill_function(
+                                           void )
+{
+#if defined( LIBEWF_HAVE_X86_SIMD )
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		return( &libewf_chunk_data_check_for_pattern_fill_avx2 );
+	}
+	if( __builtin_cpu_supports( "sse2" ) )
+	{
+		return( &libewf_chunk_data_check_for_pattern_fill_sse2 );
+	}
+#endif
+	return( &libewf_chunk_data_check_for_pattern_fill_generic );
+}
+
+/* Checks if the data repeats its first 8 bytes
+ * The data is compared against a copy of itself shifted by 8 bytes
+ * Returns 1 if the data repeats its first 8 bytes or 0 if not
+ */
+int libewf_chunk_data_check_for_pattern_fill_generic(
+     const uint8_t *data,
+     size_t data_size )
+{
+	libewf_aligned_t *aligned_data_index = NULL;
+	libewf_aligned_t *aligned_data_start = NULL;
+	uint8_t *data_index                  = NULL;
+	uint8_t *data_start                  = NULL;
+
+	if( data_size <= 8 )
+	{
+		return( 1 );
+	}
 	data_start = (uint8_t *) data;
 	data_index = (uint8_t *) data + 8;
 	data_size -= 8;
@@ -1512,17 +1746,8 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 			data_index++;
 			data_size--;
 		}
-		/* Align the data index
+		/* Since data start and index are 8 bytes apart both are now aligned
 		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
 		aligned_data_start = (libewf_aligned_t *) data_start;
 		aligned_data_index = (libewf_aligned_t *) data_index;
 
@@ -1550,20 +1775,136 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 		data_index++;
 		data_size--;
 	}
-	byte_stream_copy_to_uint64_little_endian(
+	return( 1 );
+}
+
+#if defined( LIBEWF_HAVE_X86_SIMD )
+
+/* Checks if the data repeats its first 8 bytes using SSE2
+ * The data is compared against the pattern 64 bytes at a time
+ * Returns 1 if the data repeats its first 8 bytes or 0 if not
+ */
+__attribute__((target("sse2")))
+int libewf_chunk_data_check_for_pattern_fill_sse2(
+     const uint8_t *data,
+     size_t data_size )
+{
+	__m128i pattern_128bit    = _mm_setzero_si128();
+	__m128i difference_128bit = _mm_setzero_si128();
+	uint64_t pattern          = 0;
+	size_t data_offset        = 0;
+
+	if( data_size < 64 )
+	{
+		return( libewf_chunk_data_check_for_pattern_fill_generic(
+		         data,
+		         data_size ) );
+	}
+	memory_copy(
+	 &pattern,
 	 data,
-	 *pattern );
+	 8 );
 
+	pattern_128bit = _mm_set1_epi64x( (long long) pattern );
+
+	/* Since the data offset is a multiple of 8 the pattern remains aligned
+	 * with the data
+	 */
+	while( ( data_size - data_offset ) >= 64 )
+	{
+		difference_128bit = _mm_or_si128(
+		                     _mm_or_si128(
+		                      _mm_xor_si128( _mm_loadu_si128( (__m128i *) &( data[ data_offset ] ) ), pattern_128bit ),
+		                      _mm_xor_si128( _mm_loadu_si128( (__m128i *) &( data[ data_offset + 16 ] ) ), pattern_128bit ) ),
+		                     _mm_or_si128(
+		                      _mm_xor_si128( _mm_loadu_si128( (__m128i *) &( data[ data_offset + 32 ] ) ), pattern_128bit ),
+		                      _mm_xor_si128( _mm_loadu_si128( (__m128i *) &( data[ data_offset + 48 ] ) ), pattern_128bit ) ) );
+
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( difference_128bit, _mm_setzero_si128() ) ) != 0xffff )
+		{
+			return( 0 );
+		}
+		data_offset += 64;
+	}
+	while( data_offset < data_size )
+	{
+		if( data[ data_offset ] != data[ data_offset % 8 ] )
+		{
+			return( 0 );
+		}
+		data_offset++;
+	}
+	return( 1 );
+}
+
+/* Checks if the data repeats its first 8 bytes using AVX2
+ * The data is compared against the pattern 128 bytes at a time
+ * Returns 1 if the data repeats its first 8 bytes or 0 if not
+ */
+__attribute__((target("avx2")))
+int libewf_chunk_data_check_for_pattern_fill_avx2(
+     const uint8_t *data,
+     size_t data_size )
+{
+	__m256i pattern_256bit    = _mm256_setzero_si256();
+	__m256i difference_256bit = _mm256_setzero_si256();
+	uint64_t pattern          = 0;
+	size_t data_offset        = 0;
+
+	if( data_size < 128 )
+	{
+		return( libewf_chunk_data_check_for_pattern_fill_generic(
+		         data,
+		         data_size ) );
+	}
+	memory_copy(
+	 &pattern,
+	 data,
+	 8 );
+
+	pattern_256bit = _mm256_set1_epi64x( (long long) pattern );
+
+	/* Since the data offset is a multiple of 8 the pattern remains aligned
+	 * with the data
+	 */
+	while( ( data_size - data_offset ) >= 128 )
+	{
+		difference_256bit = _mm256_or_si256(
+		                     _mm256_or_si256(
+		                      _mm256_xor_si256( _mm256_loadu_si256( (__m256i *) &( data[ data_offset ] ) ), pattern_256bit ),
+		                      _mm256_xor_si256( _mm256_loadu_si256( (__m256i *) &( data[ data_offset + 32 ] ) ), pattern_256bit ) ),
+		                     _mm256_or_si256(
+		                      _mm256_xor_si256( _mm256_loadu_si256( (__m256i *) &( data[ data_offset + 64 ] ) ), pattern_256bit ),
+		                      _mm256_xor_si256( _mm256_loadu_si256( (__m256i *) &( data[ data_offset + 96 ] ) ), pattern_256bit ) ) );
+
+		if( _mm256_testz_si256( difference_256bit, difference_256bit ) == 0 )
+		{
+			return( 0 );
+		}
+		data_offset += 128;
+	}
+	while( data_offset < data_size )
+	{
+		if( data[ data_offset ] != data[ data_offset % 8 ] )
+		{
+			return( 0 );
+		}
+		data_offset++;
+	}
 	return( 1 );
 }
 
+#endif /* defined( LIBEWF_HAVE_X86_SIMD ) */
+
 /* Writes a chunk
+ * The chunk is combined with other writes in the write buffer if one is provided
  * Returns 1 if successful or -1 on error
  */
 ssize_t libewf_chunk_data_write(
          libewf_chunk_data_t *chunk_data,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
+         libewf_write_buffer_t *write_buffer,
          libcerror_error_t **error )
 {
 	uint8_t checksum_buffer[ 4 ];
@@ -1588,12 +1929,25 @@ ssize_t libewf_chunk_data_write(
 
 	/* Write the chunk data to the segment file
 	 */
-	write_count = libbfio_pool_write_buffer(
-	               file_io_pool,
-	               file_io_pool_entry,
-	               chunk_data->data,
-	               write_size,
-	               error );
+	if( write_buffer != NULL )
+	{
+		write_count = libewf_write_buffer_write(
+		               write_buffer,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               chunk_data->data,
+		               write_size,
+		               error );
+	}
+	else
+	{
+		write_count = libbfio_pool_write_buffer(
+		               file_io_pool,
+		               file_io_pool_entry,
+		               chunk_data->data,
+		               write_size,
+		               error );
+	}
 
 	if( write_count != (ssize_t) write_size )
 	{
@@ -1620,12 +1974,25 @@ ssize_t libewf_chunk_data_write(
 			 checksum_buffer,
 			 chunk_data->checksum );
 
-			write_count = libbfio_pool_write_buffer(
-				       file_io_pool,
-				       file_io_pool_entry,
-				       checksum_buffer,
-				       4,
-				       error );
+			if( write_buffer != NULL )
+			{
+				write_count = libewf_write_buffer_write(
+				               write_buffer,
+				               file_io_pool,
+				               file_io_pool_entry,
+				               checksum_buffer,
+				               4,
+				               error );
+			}
+			else
+			{
+				write_count = libbfio_pool_write_buffer(
+					       file_io_pool,
+					       file_io_pool_entry,
+					       checksum_buffer,
+					       4,
+					       error );
+			}
 
 			if( write_count != (ssize_t) 4 )
 			{
@@ -1854,6 +2221,7 @@ int libewf_chunk_data_get_checksum(
 }
 
 /* Reads chunk data from the file IO pool
+ * If the segment file is memory mapped the chunk data references the mapped data
  * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
 ssize_t libewf_chunk_data_read_from_file_io_pool(
@@ -1865,8 +2233,10 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error )
 {
+	uint8_t *mapped_data  = NULL;
 	static char *function = "libewf_chunk_data_read_from_file_io_pool";
 	ssize_t read_count    = 0;
+	int result            = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1880,7 +2250,7 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 		return( -1 );
 	}
 	if( ( chunk_data_size == (size64_t) 0 )
-	 || ( chunk_data_size > (size64_t) SSIZE_MAX ) )
+	 || ( chunk_data_size > (size64_t) chunk_data->allocated_data_size ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -1891,31 +2261,50 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( libbfio_pool_seek_offset(
-	     file_io_pool,
-	     file_io_pool_entry,
-	     chunk_data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	result = libbfio_pool_get_mapped_data_at_offset(
+	          file_io_pool,
+	          file_io_pool_entry,
+	          chunk_data_offset,
+	          (size_t) chunk_data_size,
+	          &mapped_data,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
-		 function,
-		 chunk_data_offset,
-		 file_io_pool_entry );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapped chunk data.",
+		 function );
 
 		return( -1 );
 	}
-	read_count = libbfio_pool_read_buffer(
-		      file_io_pool,
-		      file_io_pool_entry,
-		      chunk_data->data,
-		      (size_t) chunk_data_size,
-		      error );
+	else if( result != 0 )
+	{
+		/* The packed chunk data is unpacked directly from the mapped data
+		 */
+		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
+		{
+			memory_free(
+			 chunk_data->data );
+		}
+		chunk_data->data                = mapped_data;
+		chunk_data->allocated_data_size = (size_t) chunk_data_size;
+		chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MAPPED_DATA;
 
+		read_count = (ssize_t) chunk_data_size;
+	}
+	else
+	{
+		read_count = libbfio_pool_read_buffer_at_offset(
+			      file_io_pool,
+			      file_io_pool_entry,
+			      chunk_data->data,
+			      (size_t) chunk_data_size,
+			      chunk_data_offset,
+			      error );
+	}
 	if( read_count != (ssize_t) chunk_data_size )
 	{
 		libcerror_error_set(
@@ -1927,12 +2316,63 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 
 		return( -1 );
 	}
-	chunk_data->data_size = (size_t) read_count;
+	if( libewf_chunk_data_set_packed_data_read(
+	     chunk_data,
+	     (size_t) read_count,
+	     chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set packed data read.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Sets the chunk data after the packed data was read into the data buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_set_packed_data_read(
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_set_packed_data_read";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > chunk_data->allocated_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->data_size = data_size;
 
 	chunk_data->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
 	                        & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
 
-	return( read_count );
+	return( 1 );
 }
 
 /* Reads chunk data
@@ -30,11 +30,24 @@
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_simd.h"
+#include "libewf_write_buffer.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The number of references is updated with atomic operations if the compiler provides them
+ * otherwise the references are only changed while the handle read/write lock is held for writing
+ */
+#if defined( __GNUC__ ) && defined( __ATOMIC_ACQUIRE )
+#define HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES
+#endif
+
+typedef int (*libewf_chunk_data_pattern_fill_function_t)(
+               const uint8_t *data,
+               size_t data_size );
+
 typedef struct libewf_chunk_data libewf_chunk_data_t;
 
 struct libewf_chunk_data
@@ -86,6 +99,11 @@ struct libewf_chunk_data
 	/* The chunk IO flags
 	 */
 	int8_t chunk_io_flags;
+
+	/* The number of references
+	 * the creator holds the first reference and every chunk view an additional one
+	 */
+	int number_of_references;
 };
 
 int libewf_chunk_data_initialize(
@@ -98,6 +116,10 @@ int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_grab_reference(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_clone(
      libewf_chunk_data_t **destination_chunk_data,
      libewf_chunk_data_t *source_chunk_data,
@@ -139,10 +161,37 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error );
 
+int libewf_chunk_data_check_for_fill(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t *pattern,
+     uint8_t *is_empty_block,
+     libcerror_error_t **error );
+
+libewf_chunk_data_pattern_fill_function_t libewf_chunk_data_get_pattern_fill_function(
+                                           void );
+
+int libewf_chunk_data_check_for_pattern_fill_generic(
+     const uint8_t *data,
+     size_t data_size );
+
+#if defined( LIBEWF_HAVE_X86_SIMD )
+
+int libewf_chunk_data_check_for_pattern_fill_sse2(
+     const uint8_t *data,
+     size_t data_size );
+
+int libewf_chunk_data_check_for_pattern_fill_avx2(
+     const uint8_t *data,
+     size_t data_size );
+
+#endif /* defined( LIBEWF_HAVE_X86_SIMD ) */
+
 ssize_t libewf_chunk_data_write(
          libewf_chunk_data_t *chunk_data,
          libbfio_pool_t *file_io_pool,
          int file_io_pool_entry,
+         libewf_write_buffer_t *write_buffer,
          libcerror_error_t **error );
 
 int libewf_chunk_data_get_write_size(
@@ -165,6 +214,12 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error );
 
+int libewf_chunk_data_set_packed_data_read(
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
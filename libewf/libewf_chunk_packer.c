@@ -0,0 +1,708 @@
+/*
+ * Chunk packer functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_packer.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_io_handle.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a chunk packer
+ * Make sure the value chunk_packer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_packer_initialize(
+     libewf_chunk_packer_t **chunk_packer,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_packer_initialize";
+	size_t array_size     = 0;
+
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_packer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk packer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > ( INT32_MAX / LIBEWF_CHUNK_PACKER_CHUNKS_PER_THREAD ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_packer = memory_allocate_structure(
+	                 libewf_chunk_packer_t );
+
+	if( *chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk packer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_packer,
+	     0,
+	     sizeof( libewf_chunk_packer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk packer.",
+		 function );
+
+		memory_free(
+		 *chunk_packer );
+
+		*chunk_packer = NULL;
+
+		return( -1 );
+	}
+	/* Keep enough chunks queued for the threads to remain busy
+	 * while the packed chunks are written
+	 */
+	( *chunk_packer )->number_of_entries = number_of_threads * LIBEWF_CHUNK_PACKER_CHUNKS_PER_THREAD;
+
+	array_size = sizeof( libewf_chunk_packer_chunk_t ) * ( *chunk_packer )->number_of_entries;
+
+	( *chunk_packer )->chunks_array = (libewf_chunk_packer_chunk_t *) memory_allocate(
+	                                                                   array_size );
+
+	if( ( *chunk_packer )->chunks_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks array.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_packer )->chunks_array,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunks array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_packer )->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *chunk_packer )->packed_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create packed condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_packer )->io_handle       = io_handle;
+	( *chunk_packer )->write_io_handle = write_io_handle;
+
+	if( libcthreads_thread_pool_create(
+	     &( ( *chunk_packer )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *chunk_packer )->number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_chunk_packer_pack_chunk_callback,
+	     (void *) *chunk_packer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_packer != NULL )
+	{
+		if( ( *chunk_packer )->packed_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *chunk_packer )->packed_condition ),
+			 NULL );
+		}
+		if( ( *chunk_packer )->condition_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *chunk_packer )->condition_mutex ),
+			 NULL );
+		}
+		if( ( *chunk_packer )->chunks_array != NULL )
+		{
+			memory_free(
+			 ( *chunk_packer )->chunks_array );
+		}
+		memory_free(
+		 *chunk_packer );
+
+		*chunk_packer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk packer
+ * Waits for the chunks that are being packed, chunks that were not written are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_packer_free(
+     libewf_chunk_packer_t **chunk_packer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_packer_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_packer != NULL )
+	{
+		/* The thread pool processes the remaining queued chunks before it is joined
+		 */
+		if( libcthreads_thread_pool_join(
+		     &( ( *chunk_packer )->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		for( entry_index = 0;
+		     entry_index < ( *chunk_packer )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *chunk_packer )->chunks_array[ entry_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *chunk_packer )->chunks_array[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk data: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *chunk_packer )->packed_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free packed condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_packer )->condition_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *chunk_packer )->chunks_array );
+
+		memory_free(
+		 *chunk_packer );
+
+		*chunk_packer = NULL;
+	}
+	return( result );
+}
+
+/* Packs a chunk
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_packer_pack_chunk_callback(
+     libewf_chunk_packer_chunk_t *chunk_packer_chunk,
+     libewf_chunk_packer_t *chunk_packer )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_chunk_packer_pack_chunk_callback";
+	uint8_t status           = LIBEWF_CHUNK_PACKER_CHUNK_STATUS_FAILED;
+
+	if( chunk_packer_chunk == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		goto on_error;
+	}
+	/* The pack error is reported by libewf_chunk_packer_pop_packed_chunk
+	 */
+	if( libewf_chunk_data_pack(
+	     chunk_packer_chunk->chunk_data,
+	     chunk_packer->io_handle,
+	     chunk_packer->write_io_handle->compressed_zero_byte_empty_block,
+	     chunk_packer->write_io_handle->compressed_zero_byte_empty_block_size,
+	     chunk_packer->write_io_handle->pack_flags,
+	     &error ) == 1 )
+	{
+		status = LIBEWF_CHUNK_PACKER_CHUNK_STATUS_PACKED;
+	}
+	else
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     chunk_packer->condition_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_packer_chunk->status = status;
+
+	if( libcthreads_condition_broadcast(
+	     chunk_packer->packed_condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast packed condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 chunk_packer->condition_mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     chunk_packer->condition_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Pushes a chunk onto the chunk packer
+ * The chunk packer takes over management of the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_packer_push_chunk(
+     libewf_chunk_packer_t *chunk_packer,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_packer_chunk_t *chunk_packer_chunk = NULL;
+	static char *function                           = "libewf_chunk_packer_push_chunk";
+	int entry_index                                 = 0;
+
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_packer->number_of_pending_chunks >= chunk_packer->number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk packer - number of pending chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = ( chunk_packer->first_entry_index + chunk_packer->number_of_pending_chunks ) % chunk_packer->number_of_entries;
+
+	chunk_packer_chunk = &( chunk_packer->chunks_array[ entry_index ] );
+
+	chunk_packer_chunk->chunk_index     = chunk_index;
+	chunk_packer_chunk->chunk_data      = chunk_data;
+	chunk_packer_chunk->input_data_size = input_data_size;
+	chunk_packer_chunk->status          = LIBEWF_CHUNK_PACKER_CHUNK_STATUS_PENDING;
+
+	if( libcthreads_thread_pool_push(
+	     chunk_packer->thread_pool,
+	     (intptr_t *) chunk_packer_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 " onto thread pool queue.",
+		 function,
+		 chunk_index );
+
+		chunk_packer_chunk->chunk_data = NULL;
+		chunk_packer_chunk->status     = LIBEWF_CHUNK_PACKER_CHUNK_STATUS_EMPTY;
+
+		return( -1 );
+	}
+	chunk_packer->number_of_pending_chunks += 1;
+
+	return( 1 );
+}
+
+/* Pops the first pending chunk from the chunk packer if it has been packed
+ * The chunks are popped in the order they were pushed
+ * If wait for chunk is set the function waits for the chunk to be packed
+ * The caller takes over management of the chunk data
+ * A chunk that could not be packed is removed and freed
+ * Returns 1 if successful, 0 if no packed chunk is available or -1 on error
+ */
+int libewf_chunk_packer_pop_packed_chunk(
+     libewf_chunk_packer_t *chunk_packer,
+     uint8_t wait_for_chunk,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_packer_chunk_t *chunk_packer_chunk = NULL;
+	static char *function                           = "libewf_chunk_packer_pop_packed_chunk";
+	uint8_t status                                  = 0;
+	int result                                      = 1;
+
+	if( chunk_packer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk packer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_packer->number_of_pending_chunks == 0 )
+	{
+		return( 0 );
+	}
+	chunk_packer_chunk = &( chunk_packer->chunks_array[ chunk_packer->first_entry_index ] );
+
+	if( libcthreads_mutex_grab(
+	     chunk_packer->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( wait_for_chunk != 0 )
+	    && ( chunk_packer_chunk->status == LIBEWF_CHUNK_PACKER_CHUNK_STATUS_PENDING ) )
+	{
+		if( libcthreads_condition_wait(
+		     chunk_packer->packed_condition,
+		     chunk_packer->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for packed condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	status = chunk_packer_chunk->status;
+
+	if( libcthreads_mutex_release(
+	     chunk_packer->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( status == LIBEWF_CHUNK_PACKER_CHUNK_STATUS_PENDING )
+	{
+		return( 0 );
+	}
+	if( status == LIBEWF_CHUNK_PACKER_CHUNK_STATUS_FAILED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_packer_chunk->chunk_index );
+
+		libewf_chunk_data_free(
+		 &( chunk_packer_chunk->chunk_data ),
+		 NULL );
+
+		result = -1;
+	}
+	else
+	{
+		*chunk_index     = chunk_packer_chunk->chunk_index;
+		*chunk_data      = chunk_packer_chunk->chunk_data;
+		*input_data_size = chunk_packer_chunk->input_data_size;
+	}
+	chunk_packer_chunk->chunk_data = NULL;
+	chunk_packer_chunk->status     = LIBEWF_CHUNK_PACKER_CHUNK_STATUS_EMPTY;
+
+	chunk_packer->first_entry_index         = ( chunk_packer->first_entry_index + 1 ) % chunk_packer->number_of_entries;
+	chunk_packer->number_of_pending_chunks -= 1;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
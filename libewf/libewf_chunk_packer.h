@@ -0,0 +1,150 @@
+/*
+ * Chunk packer functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_PACKER_H )
+#define _LIBEWF_CHUNK_PACKER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_io_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The chunk packer chunk status
+ */
+enum LIBEWF_CHUNK_PACKER_CHUNK_STATUS
+{
+	LIBEWF_CHUNK_PACKER_CHUNK_STATUS_EMPTY		= 0,
+	LIBEWF_CHUNK_PACKER_CHUNK_STATUS_PENDING	= 1,
+	LIBEWF_CHUNK_PACKER_CHUNK_STATUS_PACKED		= 2,
+	LIBEWF_CHUNK_PACKER_CHUNK_STATUS_FAILED		= 3
+};
+
+typedef struct libewf_chunk_packer_chunk libewf_chunk_packer_chunk_t;
+
+struct libewf_chunk_packer_chunk
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data before it was packed
+	 */
+	size_t input_data_size;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct libewf_chunk_packer libewf_chunk_packer_t;
+
+struct libewf_chunk_packer
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The write IO handle
+	 */
+	libewf_write_io_handle_t *write_io_handle;
+
+	/* The chunks array
+	 * Contains the chunks in the order they were pushed
+	 */
+	libewf_chunk_packer_chunk_t *chunks_array;
+
+	/* The number of entries in the chunks array
+	 */
+	int number_of_entries;
+
+	/* The index of the entry of the first pending chunk
+	 */
+	int first_entry_index;
+
+	/* The number of pending chunks
+	 */
+	int number_of_pending_chunks;
+
+	/* The thread pool that packs the chunks
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The chunk packed condition
+	 */
+	libcthreads_condition_t *packed_condition;
+};
+
+int libewf_chunk_packer_initialize(
+     libewf_chunk_packer_t **chunk_packer,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_chunk_packer_free(
+     libewf_chunk_packer_t **chunk_packer,
+     libcerror_error_t **error );
+
+int libewf_chunk_packer_pack_chunk_callback(
+     libewf_chunk_packer_chunk_t *chunk_packer_chunk,
+     libewf_chunk_packer_t *chunk_packer );
+
+int libewf_chunk_packer_push_chunk(
+     libewf_chunk_packer_t *chunk_packer,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_packer_pop_packed_chunk(
+     libewf_chunk_packer_t *chunk_packer,
+     uint8_t wait_for_chunk,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_PACKER_H ) */
+
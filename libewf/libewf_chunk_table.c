@@ -1051,6 +1051,244 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the data range of the packed chunk data of a chunk at a specific offset
+ * Returns 1 if successful, 0 if no chunk data range is available or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group   = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_chunk_table_get_chunk_data_range_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t element_data_offset         = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &segment_number,
+		  &segment_file_data_offset,
+		  &segment_file,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group at 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk group: %d.",
+		 function,
+		 chunk_groups_list_index );
+
+		return( -1 );
+	}
+	result = libfdata_list_get_element_at_offset(
+		  chunk_group->chunks_list,
+		  chunk_group_data_offset,
+		  &chunks_list_index,
+		  &element_data_offset,
+		  file_io_pool_entry,
+		  chunk_data_offset,
+		  chunk_data_size,
+		  chunk_data_flags,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range from chunk group: %d in segment file: %" PRIu32 ".",
+		 function,
+		 chunk_index,
+		 chunk_groups_list_index,
+		 segment_number );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Reads the packed chunk data of a chunk at a specific offset
+ * The chunk data is not stored in the chunks cache and needs to be unpacked by the caller
+ * Returns 1 if successful, 0 if no chunk data is available or -1 on error
+ */
+int libewf_chunk_table_read_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_chunk_table_read_chunk_data_by_offset";
+	off64_t chunk_data_offset            = 0;
+	size64_t chunk_data_size             = 0;
+	ssize_t read_count                   = 0;
+	uint32_t chunk_data_flags            = 0;
+	int file_io_pool_entry               = 0;
+	int result                           = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+		  chunk_table,
+		  chunk_index,
+		  file_io_pool,
+		  segment_table,
+		  chunk_groups_cache,
+		  offset,
+		  &file_io_pool_entry,
+		  &chunk_data_offset,
+		  &chunk_data_size,
+		  &chunk_data_flags,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_data_initialize(
+	     &safe_chunk_data,
+	     io_handle->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+		      safe_chunk_data,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      chunk_data_offset,
+		      chunk_data_size,
+		      chunk_data_flags,
+		      error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Sets the chunk data of a chunk at a specific offset
  * Adds a checksum error if the data is corrupted
  * Returns 1 if successful or -1 on error
@@ -44,20 +44,26 @@
  * bit 2	set to 1 for write access
  * bit 3-4	not used
  * bit 5        set to 1 to resume write
- * bit 6-8	not used
+ * bit 6        set to 1 to memory map the segment files for read
+ * bit 7        set to 1 to bypass the system cache when writing the segment files
+ * bit 8	not used
  */
 enum LIBEWF_ACCESS_FLAGS
 {
 	LIBEWF_ACCESS_FLAG_READ					= 0x01,
 	LIBEWF_ACCESS_FLAG_WRITE				= 0x02,
 
-	LIBEWF_ACCESS_FLAG_RESUME				= 0x10
+	LIBEWF_ACCESS_FLAG_RESUME				= 0x10,
+	LIBEWF_ACCESS_FLAG_MEMORY_MAP				= 0x20,
+	LIBEWF_ACCESS_FLAG_DIRECT_IO				= 0x40
 };
 
 /* The file access macros
  */
 #define LIBEWF_OPEN_READ					( LIBEWF_ACCESS_FLAG_READ )
+#define LIBEWF_OPEN_READ_MEMORY_MAPPED				( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_MEMORY_MAP )
 #define LIBEWF_OPEN_WRITE					( LIBEWF_ACCESS_FLAG_WRITE )
+#define LIBEWF_OPEN_WRITE_DIRECT_IO				( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_DIRECT_IO )
 #define LIBEWF_OPEN_WRITE_RESUME				( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME )
 
 /* The file formats
@@ -211,7 +217,12 @@ enum LIBEWF_CHUNK_DATA_ITEM_FLAGS
 
         /* The data is managed by the chunk data item
 	 */
-	LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA		= 0x01
+	LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA		= 0x01,
+
+	/* The packed data references the mapped data of a segment file
+	 * and is not managed by the chunk data item
+	 */
+	LIBEWF_CHUNK_DATA_ITEM_FLAG_MAPPED_DATA			= 0x02
 };
 
 /* The (single) file entry types
@@ -297,7 +308,12 @@ enum LIBEWF_SEGMENT_TABLE_FLAGS
 {
 	/* The segment table is corrupted
 	 */
-	LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED			= 0x04
+	LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED			= 0x04,
+
+	/* The segment files are read on demand
+	 * not all segment files are mapped to the storage media
+	 */
+	LIBEWF_SEGMENT_TABLE_FLAG_READ_ON_DEMAND		= 0x08
 };
 
 /* The segment file flags definitions
@@ -425,6 +441,36 @@ enum LIBEWF_PACK_FLAGS
 #define LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS		16
 #define LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS			8
 #define LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS			4
+#define LIBEWF_MAXIMUM_CACHE_ENTRIES_SHARED_CHUNKS		256
+
+#define LIBEWF_SHARED_CHUNKS_CACHE_NUMBER_OF_SHARDS		16
+
+#define LIBEWF_MAXIMUM_READ_AHEAD_CHUNKS			1024
+#define LIBEWF_CHUNK_PACKER_CHUNKS_PER_THREAD			4
+
+#define LIBEWF_MAXIMUM_INDEX_FILE_SIZE				( 256 * 1024 * 1024 )
+
+/* The index file format version
+ * Version 2 added the segment file modification time
+ */
+#define LIBEWF_INDEX_FILE_FORMAT_VERSION			2
+
+/* The size of the buffer in which the chunk data is combined before it is written (4 MiB)
+ */
+#define LIBEWF_WRITE_BUFFER_SIZE				( 4 * 1024 * 1024 )
+
+/* The queue depth of the segment files written when threads are used
+ * a flush of the write buffer is then split into up to this number of concurrent writes
+ */
+#define LIBEWF_SEGMENT_FILE_WRITE_QUEUE_DEPTH			8
+
+/* The minimum number of sub entries of a single file entry for which a name index is used
+ */
+#define LIBEWF_SINGLE_FILE_NAME_INDEX_MINIMUM_NUMBER_OF_SUB_ENTRIES	32
+
+/* The size of the blocks of the arena the single file entries are allocated from
+ */
+#define LIBEWF_SINGLE_FILES_ARENA_BLOCK_SIZE				( 64 * 1024 )
 
 enum LIBEWF_HASH_VALUES_INDEXES
 {
@@ -24,9 +24,62 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_checksum.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
+/* Fills the bit buffer with as many bytes of the byte stream as fit
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_bit_stream_fill(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_deflate_bit_stream_fill";
+	uint64_t value_64bit  = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( bit_stream->bit_buffer_size > 56 )
+	{
+		return( 1 );
+	}
+	if( ( bit_stream->byte_stream_size - bit_stream->byte_stream_offset ) >= 8 )
+	{
+		/* Read 8 bytes at once and only account for the whole bytes that fit
+		 * the remaining bits are read again by the next fill
+		 */
+		byte_stream_copy_to_uint64_little_endian(
+		 &( bit_stream->byte_stream[ bit_stream->byte_stream_offset ] ),
+		 value_64bit );
+
+		bit_stream->bit_buffer         |= value_64bit << bit_stream->bit_buffer_size;
+		bit_stream->byte_stream_offset += ( 63 - bit_stream->bit_buffer_size ) >> 3;
+		bit_stream->bit_buffer_size    |= 56;
+	}
+	else
+	{
+		while( ( bit_stream->bit_buffer_size <= 56 )
+		    && ( bit_stream->byte_stream_offset < bit_stream->byte_stream_size ) )
+		{
+			value_64bit = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
+
+			bit_stream->bit_buffer      |= value_64bit << bit_stream->bit_buffer_size;
+			bit_stream->bit_buffer_size += 8;
+		}
+	}
+	return( 1 );
+}
+
 /* Retrieves a value from the bit stream
  * Returns 1 on success or -1 on error
  */
@@ -77,9 +130,22 @@ int libewf_deflate_bit_stream_get_value(
 
 		return( 1 );
 	}
-	while( bit_stream->bit_buffer_size < number_of_bits )
+	if( bit_stream->bit_buffer_size < number_of_bits )
 	{
-		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+		if( libewf_deflate_bit_stream_fill(
+		     bit_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill bit buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( bit_stream->bit_buffer_size < number_of_bits )
 		{
 			libcerror_error_set(
 			 error,
@@ -90,13 +156,8 @@ int libewf_deflate_bit_stream_get_value(
 
 			return( -1 );
 		}
-		*value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		*value_32bit <<= bit_stream->bit_buffer_size;
-
-		bit_stream->bit_buffer      |= *value_32bit;
-		bit_stream->bit_buffer_size += 8;
 	}
-	*value_32bit = bit_stream->bit_buffer & ~( 0xffffffffUL << number_of_bits );
+	*value_32bit = (uint32_t) ( bit_stream->bit_buffer & ( ( (uint64_t) 1 << number_of_bits ) - 1 ) );
 
 	bit_stream->bit_buffer     >>= number_of_bits;
 	bit_stream->bit_buffer_size -= number_of_bits;
@@ -117,10 +178,15 @@ int libewf_deflate_huffman_table_construct(
 
 	static char *function = "libewf_deflate_huffman_table_construct";
 	uint16_t code_size    = 0;
+	uint16_t lookup_index = 0;
+	uint16_t lookup_value = 0;
 	uint8_t bit_index     = 0;
+	int code_index        = 0;
 	int code_offset       = 0;
+	int huffman_code      = 0;
 	int left_value        = 0;
 	int symbol            = 0;
+	int value_index       = 0;
 
 	if( table == NULL )
 	{
@@ -199,13 +265,27 @@ int libewf_deflate_huffman_table_construct(
 
 		return( -1 );
 	}
+	if( memory_set(
+	     &( table->fast_lookup_table ),
+	     0,
+	     sizeof( uint16_t ) << LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_BITS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear fast lookup table.",
+		 function );
+
+		return( -1 );
+	}
 	for( symbol = 0;
 	     symbol < number_of_code_sizes;
 	     symbol++ )
 	{
 		code_size = code_sizes_array[ symbol ];
 
-		if( code_size > table->number_of_codes )
+		if( code_size > table->maximum_number_of_bits )
 		{
 			libcerror_error_set(
 			 error,
@@ -290,6 +370,40 @@ int libewf_deflate_huffman_table_construct(
 		code_offsets_array[ code_size ]  += 1;
 		table->codes_array[ code_offset ] = symbol;
 	}
+	/* Fill the fast lookup table with the codes that fit the lookup
+	 * The Huffman codes are stored most significant bit first hence the lookup
+	 * is indexed by the bit reversed code
+	 */
+	for( bit_index = 1;
+	     bit_index <= LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_BITS;
+	     bit_index++ )
+	{
+		for( value_index = 0;
+		     value_index < table->code_counts_array[ bit_index ];
+		     value_index++ )
+		{
+			lookup_index = 0;
+
+			for( code_offset = 0;
+			     code_offset < (int) bit_index;
+			     code_offset++ )
+			{
+				lookup_index <<= 1;
+				lookup_index  |= (uint16_t) ( ( huffman_code >> code_offset ) & 0x00000001UL );
+			}
+			lookup_value = (uint16_t) ( table->codes_array[ code_index ] << 4 ) | (uint16_t) bit_index;
+
+			while( lookup_index < ( 1 << LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_BITS ) )
+			{
+				table->fast_lookup_table[ lookup_index ] = lookup_value;
+
+				lookup_index += (uint16_t) 1 << bit_index;
+			}
+			code_index++;
+			huffman_code++;
+		}
+		huffman_code <<= 1;
+	}
 /* TODO only used by dynamic Huffman
 	if( left_value > 0 )
 	{
@@ -316,8 +430,10 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libcerror_error_t **error )
 {
 	static char *function  = "libewf_deflate_bit_stream_get_huffman_encoded_value";
-	uint32_t bit_buffer    = 0;
+	uint64_t bit_buffer    = 0;
+	uint16_t lookup_value  = 0;
 	uint8_t bit_index      = 0;
+	uint8_t code_size      = 0;
 	uint8_t number_of_bits = 0;
 	int code_size_count    = 0;
 	int first_huffman_code = 0;
@@ -358,20 +474,37 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 
 		return( -1 );
 	}
-	/* Try to fill the bit buffer with the maximum number of bits
-	 */
-	while( bit_stream->bit_buffer_size < table->maximum_number_of_bits )
+	if( bit_stream->bit_buffer_size < table->maximum_number_of_bits )
 	{
-		if( bit_stream->byte_stream_offset >= bit_stream->byte_stream_size )
+		if( libewf_deflate_bit_stream_fill(
+		     bit_stream,
+		     error ) != 1 )
 		{
-			break;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill bit buffer.",
+			 function );
+
+			return( -1 );
 		}
-		*value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		*value_32bit <<= bit_stream->bit_buffer_size;
+	}
+	lookup_value = table->fast_lookup_table[ bit_stream->bit_buffer & ( ( 1 << LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_BITS ) - 1 ) ];
+	code_size    = (uint8_t) ( lookup_value & 0x000fU );
 
-		bit_stream->bit_buffer      |= *value_32bit;
-		bit_stream->bit_buffer_size += 8;
+	if( ( code_size != 0 )
+	 && ( code_size <= bit_stream->bit_buffer_size ) )
+	{
+		*value_32bit = (uint32_t) ( lookup_value >> 4 );
+
+		bit_stream->bit_buffer     >>= code_size;
+		bit_stream->bit_buffer_size -= code_size;
+
+		return( 1 );
 	}
+	/* Fall back to decoding the code bit by bit for codes that are longer than the fast lookup
+	 */
 	if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
 	{
 		number_of_bits = table->maximum_number_of_bits;
@@ -775,6 +908,8 @@ int libewf_deflate_initialize_fixed_huffman_tables(
 }
 
 /* Decodes a Huffman compressed block
+ * The bit buffer is maintained in local variables while decoding and is only
+ * written back to the bit stream when a code does not fit the fast lookup
  * Returns 1 on success or -1 on error
  */
 int libewf_deflate_decode_huffman(
@@ -786,31 +921,73 @@ int libewf_deflate_decode_huffman(
      size_t *uncompressed_data_offset,
      libcerror_error_t **error )
 {
-	uint16_t literal_codes_base[ 29 ] = {
+	static const uint16_t literal_codes_base[ 29 ] = {
 		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
 		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
 
-	uint16_t literal_codes_number_of_extra_bits[ 29 ] = {
+	static const uint8_t literal_codes_number_of_extra_bits[ 29 ] = {
 		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
 		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
 
-	uint16_t distance_codes_base[ 30 ] = {
+	static const uint16_t distance_codes_base[ 30 ] = {
 		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
 		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
 		12289, 16385, 24577};
 
-	uint16_t distance_codes_number_of_extra_bits[ 30 ] = {
+	static const uint8_t distance_codes_number_of_extra_bits[ 30 ] = {
 		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
 		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
 
+	const uint8_t *byte_stream    = NULL;
 	static char *function         = "libewf_deflate_decode_huffman";
+	size_t byte_stream_offset     = 0;
+	size_t byte_stream_size       = 0;
 	size_t data_offset            = 0;
+	uint64_t bit_buffer           = 0;
+	uint64_t lookup_mask          = 0;
+	uint64_t value_64bit          = 0;
 	uint32_t code_value           = 0;
 	uint32_t extra_bits           = 0;
 	uint16_t compression_offset   = 0;
 	uint16_t compression_size     = 0;
-	uint16_t number_of_extra_bits = 0;
+	uint16_t lookup_value         = 0;
+	uint8_t bit_buffer_size       = 0;
+	uint8_t code_size             = 0;
+	uint8_t number_of_extra_bits  = 0;
+
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
 
+		return( -1 );
+	}
+	if( literals_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid literals table.",
+		 function );
+
+		return( -1 );
+	}
+	if( distances_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid distances table.",
+		 function );
+
+		return( -1 );
+	}
 	if( uncompressed_data == NULL )
 	{
 		libcerror_error_set(
@@ -845,23 +1022,78 @@ int libewf_deflate_decode_huffman(
 		return( -1 );
 	}
 	data_offset = *uncompressed_data_offset;
+	lookup_mask = ( (uint64_t) 1 << LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_BITS ) - 1;
+
+	byte_stream        = bit_stream->byte_stream;
+	byte_stream_size   = bit_stream->byte_stream_size;
+	byte_stream_offset = bit_stream->byte_stream_offset;
+	bit_buffer         = bit_stream->bit_buffer;
+	bit_buffer_size    = bit_stream->bit_buffer_size;
 
 	do
 	{
-		if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-		     bit_stream,
-		     literals_table,
-		     &code_value,
-		     error ) != 1 )
+		/* Fill the bit buffer, a literal and a length and distance pair
+		 * with their extra bits take at most 48 bits
+		 */
+		if( bit_buffer_size < 48 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve listeral value from bit stream.",
-			 function );
+			if( ( byte_stream_size - byte_stream_offset ) >= 8 )
+			{
+				byte_stream_copy_to_uint64_little_endian(
+				 &( byte_stream[ byte_stream_offset ] ),
+				 value_64bit );
 
-			return( -1 );
+				bit_buffer         |= value_64bit << bit_buffer_size;
+				byte_stream_offset += ( 63 - bit_buffer_size ) >> 3;
+				bit_buffer_size    |= 56;
+			}
+			else
+			{
+				while( ( bit_buffer_size <= 56 )
+				    && ( byte_stream_offset < byte_stream_size ) )
+				{
+					value_64bit = byte_stream[ byte_stream_offset++ ];
+
+					bit_buffer      |= value_64bit << bit_buffer_size;
+					bit_buffer_size += 8;
+				}
+			}
+		}
+		lookup_value = literals_table->fast_lookup_table[ bit_buffer & lookup_mask ];
+		code_size    = (uint8_t) ( lookup_value & 0x000fU );
+
+		if( ( code_size != 0 )
+		 && ( code_size <= bit_buffer_size ) )
+		{
+			code_value = (uint32_t) ( lookup_value >> 4 );
+
+			bit_buffer     >>= code_size;
+			bit_buffer_size -= code_size;
+		}
+		else
+		{
+			bit_stream->byte_stream_offset = byte_stream_offset;
+			bit_stream->bit_buffer         = bit_buffer;
+			bit_stream->bit_buffer_size    = bit_buffer_size;
+
+			if( libewf_deflate_bit_stream_get_huffman_encoded_value(
+			     bit_stream,
+			     literals_table,
+			     &code_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve literal value from bit stream.",
+				 function );
+
+				return( -1 );
+			}
+			byte_stream_offset = bit_stream->byte_stream_offset;
+			bit_buffer         = bit_stream->bit_buffer;
+			bit_buffer_size    = bit_stream->bit_buffer_size;
 		}
 		if( code_value < 256 )
 		{
@@ -885,55 +1117,89 @@ int libewf_deflate_decode_huffman(
 
 			number_of_extra_bits = literal_codes_number_of_extra_bits[ code_value ];
 
-			if( libewf_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			if( number_of_extra_bits > bit_buffer_size )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve literal extra value from bit stream.",
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: invalid compressed data value too small.",
 				 function );
 
 				return( -1 );
 			}
+			extra_bits = (uint32_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+			bit_buffer     >>= number_of_extra_bits;
+			bit_buffer_size -= number_of_extra_bits;
+
 			compression_size = literal_codes_base[ code_value ] + (uint16_t) extra_bits;
 
-			if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-			     bit_stream,
-			     distances_table,
-			     &code_value,
-			     error ) != 1 )
+			lookup_value = distances_table->fast_lookup_table[ bit_buffer & lookup_mask ];
+			code_size    = (uint8_t) ( lookup_value & 0x000fU );
+
+			if( ( code_size != 0 )
+			 && ( code_size <= bit_buffer_size ) )
+			{
+				code_value = (uint32_t) ( lookup_value >> 4 );
+
+				bit_buffer     >>= code_size;
+				bit_buffer_size -= code_size;
+			}
+			else
+			{
+				bit_stream->byte_stream_offset = byte_stream_offset;
+				bit_stream->bit_buffer         = bit_buffer;
+				bit_stream->bit_buffer_size    = bit_buffer_size;
+
+				if( libewf_deflate_bit_stream_get_huffman_encoded_value(
+				     bit_stream,
+				     distances_table,
+				     &code_value,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve distance value from bit stream.",
+					 function );
+
+					return( -1 );
+				}
+				byte_stream_offset = bit_stream->byte_stream_offset;
+				bit_buffer         = bit_stream->bit_buffer;
+				bit_buffer_size    = bit_stream->bit_buffer_size;
+			}
+			if( code_value >= 30 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve distance value from bit stream.",
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid distance code value out of bounds.",
 				 function );
 
 				return( -1 );
 			}
 			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
 
-			if( libewf_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			if( number_of_extra_bits > bit_buffer_size )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve distance extra value from bit stream.",
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+				 "%s: invalid compressed data value too small.",
 				 function );
 
 				return( -1 );
 			}
+			extra_bits = (uint32_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+			bit_buffer     >>= number_of_extra_bits;
+			bit_buffer_size -= number_of_extra_bits;
+
 			compression_offset = distance_codes_base[ code_value ] + (uint16_t) extra_bits;
 
 			if( compression_offset > data_offset )
@@ -947,7 +1213,7 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			if( ( data_offset + compression_size ) > uncompressed_data_size )
+			if( compression_size > ( uncompressed_data_size - data_offset ) )
 			{
 				libcerror_error_set(
 				 error,
@@ -958,12 +1224,49 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			while( compression_size > 0 )
+			if( compression_offset >= compression_size )
 			{
-				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+				/* The source and destination do not overlap
+				 */
+				memory_copy(
+				 &( uncompressed_data[ data_offset ] ),
+				 &( uncompressed_data[ data_offset - compression_offset ] ),
+				 (size_t) compression_size );
+
+				data_offset += compression_size;
+			}
+			else if( compression_offset == 1 )
+			{
+				/* A run of the previous byte
+				 */
+				memory_set(
+				 &( uncompressed_data[ data_offset ] ),
+				 uncompressed_data[ data_offset - 1 ],
+				 (size_t) compression_size );
 
-				data_offset++;
-				compression_size--;
+				data_offset += compression_size;
+			}
+			else
+			{
+				/* The source and destination overlap, copy in steps of
+				 * the compression offset to repeat the pattern
+				 */
+				while( compression_size > compression_offset )
+				{
+					memory_copy(
+					 &( uncompressed_data[ data_offset ] ),
+					 &( uncompressed_data[ data_offset - compression_offset ] ),
+					 (size_t) compression_offset );
+
+					data_offset      += compression_offset;
+					compression_size -= compression_offset;
+				}
+				memory_copy(
+				 &( uncompressed_data[ data_offset ] ),
+				 &( uncompressed_data[ data_offset - compression_offset ] ),
+				 (size_t) compression_size );
+
+				data_offset += compression_size;
 			}
 		}
 		else if( code_value != 256 )
@@ -972,7 +1275,7 @@ int libewf_deflate_decode_huffman(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: invalid code value: %" PRIu16 ".",
+			 "%s: invalid code value: %" PRIu32 ".",
 			 function,
 			 code_value );
 
@@ -981,255 +1284,11 @@ int libewf_deflate_decode_huffman(
 	}
 	while( code_value != 256 );
 
-	*uncompressed_data_offset = data_offset;
-
-	return( 1 );
-}
-
-/* Calculates the little-endian Adler-32 of a buffer
- * It uses the initial value to calculate a new Adler-32
- * Returns 1 if successful or -1 on error
- */
-int libewf_deflate_calculate_adler32(
-     uint32_t *checksum_value,
-     const uint8_t *buffer,
-     size_t size,
-     uint32_t initial_value,
-     libcerror_error_t **error )
-{
-	static char *function = "libewf_deflate_calculate_adler32";
-	size_t buffer_offset  = 0;
-	uint32_t lower_word   = 0;
-	uint32_t upper_word   = 0;
-	uint32_t value_32bit  = 0;
-	int block_index       = 0;
-
-	if( checksum_value == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid checksum value.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	lower_word = initial_value & 0xffff;
-	upper_word = ( initial_value >> 16 ) & 0xffff;
-
-	while( size >= 0x15b0 )
-	{
-		/* The modulo calculation is needed per 5552 (0x15b0) bytes
-		 * 5552 / 16 = 347
-		 */
-		for( block_index = 0;
-		     block_index < 347;
-		     block_index++ )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-		}
-		/* Optimized equivalent of:
-		 * lower_word %= 0xfff1
-		 */
-		value_32bit = lower_word >> 16;
-		lower_word &= 0x0000ffffUL;
-		lower_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( lower_word > 65521 )
-		{
-			value_32bit = lower_word >> 16;
-			lower_word &= 0x0000ffffUL;
-			lower_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( lower_word >= 65521 )
-		{
-			lower_word -= 65521;
-		}
-		/* Optimized equivalent of:
-		 * upper_word %= 0xfff1
-		 */
-		value_32bit = upper_word >> 16;
-		upper_word &= 0x0000ffffUL;
-		upper_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( upper_word > 65521 )
-		{
-			value_32bit = upper_word >> 16;
-			upper_word &= 0x0000ffffUL;
-			upper_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( upper_word >= 65521 )
-		{
-			upper_word -= 65521;
-		}
-		size -= 0x15b0;
-	}
-	if( size > 0 )
-	{
-		while( size > 16 )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
+	bit_stream->byte_stream_offset = byte_stream_offset;
+	bit_stream->bit_buffer         = bit_buffer;
+	bit_stream->bit_buffer_size    = bit_buffer_size;
 
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			size -= 16;
-		}
-		while( size > 0 )
-		{
-			lower_word += buffer[ buffer_offset++ ];
-			upper_word += lower_word;
-
-			size--;
-		}
-		/* Optimized equivalent of:
-		 * lower_word %= 0xfff1
-		 */
-		value_32bit = lower_word >> 16;
-		lower_word &= 0x0000ffffUL;
-		lower_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( lower_word > 65521 )
-		{
-			value_32bit = lower_word >> 16;
-			lower_word &= 0x0000ffffUL;
-			lower_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( lower_word >= 65521 )
-		{
-			lower_word -= 65521;
-		}
-		/* Optimized equivalent of:
-		 * upper_word %= 0xfff1
-		 */
-		value_32bit = upper_word >> 16;
-		upper_word &= 0x0000ffffUL;
-		upper_word += ( value_32bit << 4 ) - value_32bit;
-
-		if( upper_word > 65521 )
-		{
-			value_32bit = upper_word >> 16;
-			upper_word &= 0x0000ffffUL;
-			upper_word += ( value_32bit << 4 ) - value_32bit;
-		}
-		if( upper_word >= 65521 )
-		{
-			upper_word -= 65521;
-		}
-	}
-	*checksum_value = ( upper_word << 16 ) | lower_word;
+	*uncompressed_data_offset = data_offset;
 
 	return( 1 );
 }
@@ -1250,22 +1309,22 @@ int libewf_deflate_decompress(
 	libewf_deflate_huffman_table_t fixed_huffman_distances_table;
 	libewf_deflate_huffman_table_t fixed_huffman_literals_table;
 
-	static char *function                 = "libewf_deflate_decompress";
-	size_t compressed_data_offset         = 0;
-	size_t uncompressed_data_offset       = 0;
-	uint32_t block_size                   = 0;
-	uint32_t block_size_copy              = 0;
-	uint32_t compression_window_size      = 0;
-	uint32_t calculated_checksum          = 0;
-	uint32_t preset_dictionary_identifier = 0;
-	uint32_t stored_checksum              = 0;
-	uint32_t value_32bit                  = 0;
-	uint8_t block_type                    = 0;
-	uint8_t compression_information       = 0;
-	uint8_t compression_method            = 0;
-	uint8_t compression_window_bits       = 0;
-	uint8_t last_block_flag               = 0;
-	uint8_t skip_bits                     = 0;
+	static char *function                    = "libewf_deflate_decompress";
+	size_t compressed_data_offset            = 0;
+	size_t uncompressed_data_offset          = 0;
+	uint32_t block_size                      = 0;
+	uint32_t block_size_copy                 = 0;
+	uint32_t compression_window_size         = 0;
+	uint32_t calculated_checksum             = 0;
+	uint32_t preset_dictionary_identifier    = 0;
+	uint32_t stored_checksum                 = 0;
+	uint32_t value_32bit                     = 0;
+	uint8_t block_type                       = 0;
+	uint8_t compression_information          = 0;
+	uint8_t compression_method               = 0;
+	uint8_t compression_window_bits          = 0;
+	uint8_t fixed_huffman_tables_initialized = 0;
+	uint8_t last_block_flag                  = 0;
 
 	if( compressed_data == NULL )
 	{
@@ -1355,10 +1414,8 @@ int libewf_deflate_decompress(
 		 preset_dictionary_identifier );
 
 		compressed_data_offset += 4;
-		compressed_data_size   -= 4;
 	}
 	compressed_data_offset += 2;
-	compressed_data_size   -= 2;
 
 	if( compression_method != 8 )
 	{
@@ -1404,23 +1461,8 @@ int libewf_deflate_decompress(
 	bit_stream.bit_buffer         = 0;
 	bit_stream.bit_buffer_size    = 0;
 
-	if( libewf_deflate_initialize_fixed_huffman_tables(
-	     &fixed_huffman_literals_table,
-	     &fixed_huffman_distances_table,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to construct fixed Huffman tables.",
-		 function );
-
-		return( -1 );
-	}
-
-/* TODO find optimized solution to read bit stream from bytes */
-	while( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	while( ( bit_stream.byte_stream_offset < bit_stream.byte_stream_size )
+	    || ( bit_stream.bit_buffer_size >= 3 ) )
 	{
 		if( libewf_deflate_bit_stream_get_value(
 		     &bit_stream,
@@ -1445,42 +1487,29 @@ int libewf_deflate_decompress(
 		{
 			case LIBEWF_DEFLATE_BLOCK_TYPE_UNCOMPRESSED:
 				/* Ignore the bits in the buffer upto the next byte
+				 * and return the remaining whole bytes to the byte stream
 				 */
-				skip_bits = bit_stream.bit_buffer_size & 0x07;
+				bit_stream.byte_stream_offset -= bit_stream.bit_buffer_size >> 3;
+				bit_stream.bit_buffer          = 0;
+				bit_stream.bit_buffer_size     = 0;
 
-				if( skip_bits > 0 )
-				{
-					if( libewf_deflate_bit_stream_get_value(
-					     &bit_stream,
-					     skip_bits,
-					     &value_32bit,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-						 "%s: unable to retrieve value from bit stream.",
-						 function );
-
-						return( -1 );
-					}
-				}
-				if( libewf_deflate_bit_stream_get_value(
-				     &bit_stream,
-				     32,
-				     &block_size,
-				     error ) != 1 )
+				if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) < 4 )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve value from bit stream.",
+					 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+					 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+					 "%s: invalid compressed data value too small.",
 					 function );
 
 					return( -1 );
 				}
+				byte_stream_copy_to_uint32_little_endian(
+				 &( bit_stream.byte_stream[ bit_stream.byte_stream_offset ] ),
+				 block_size );
+
+				bit_stream.byte_stream_offset += 4;
+
 				block_size_copy = ( block_size >> 16 ) ^ 0x0000ffffUL;
 				block_size     &= 0x0000ffffUL;
 
@@ -1543,6 +1572,24 @@ int libewf_deflate_decompress(
 				break;
 
 			case LIBEWF_DEFLATE_BLOCK_TYPE_HUFFMAN_FIXED:
+				if( fixed_huffman_tables_initialized == 0 )
+				{
+					if( libewf_deflate_initialize_fixed_huffman_tables(
+					     &fixed_huffman_literals_table,
+					     &fixed_huffman_distances_table,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to construct fixed Huffman tables.",
+						 function );
+
+						return( -1 );
+					}
+					fixed_huffman_tables_initialized = 1;
+				}
 				if( libewf_deflate_decode_huffman(
 				     &bit_stream,
 				     &fixed_huffman_literals_table,
@@ -1615,13 +1662,19 @@ int libewf_deflate_decompress(
 			break;
 		}
 	}
+	/* Return the whole bytes remaining in the bit buffer to the byte stream
+	 */
+	bit_stream.byte_stream_offset -= bit_stream.bit_buffer_size >> 3;
+	bit_stream.bit_buffer          = 0;
+	bit_stream.bit_buffer_size     = 0;
+
 	if( ( bit_stream.byte_stream_size - bit_stream.byte_stream_offset ) >= 4 )
 	{
 		byte_stream_copy_to_uint32_big_endian(
 		 &( bit_stream.byte_stream[ bit_stream.byte_stream_offset ] ),
 		 stored_checksum );
 
-		if( libewf_deflate_calculate_adler32(
+		if( libewf_checksum_calculate_adler32(
 		     &calculated_checksum,
 		     uncompressed_data,
 		     uncompressed_data_offset,
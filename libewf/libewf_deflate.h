@@ -31,6 +31,10 @@
 extern "C" {
 #endif
 
+/* The number of bits used to index the Huffman table fast lookup
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_BITS		10
+
 /* The block types
  */
 enum LIBEWF_DEFLATE_BLOCK_TYPES
@@ -59,7 +63,7 @@ struct libewf_deflate_bit_stream
 
 	/* The bit buffer
 	 */
-	uint32_t bit_buffer;
+	uint64_t bit_buffer;
 
 	/* The number of bits remaining in the bit buffer
 	 */
@@ -86,6 +90,12 @@ struct libewf_deflate_huffman_table
 	/* The number of codes
 	 */
 	int number_of_codes;
+
+	/* The fast lookup table, indexed by the next LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_BITS bits
+	 * Each entry contains the symbol in the upper 12 bits and the code size in the lower 4 bits
+	 * An entry of 0 indicates the code is longer than the lookup
+	 */
+	uint16_t fast_lookup_table[ 1 << LIBEWF_DEFLATE_HUFFMAN_FAST_LOOKUP_BITS ];
 };
 
 int libewf_deflate_bit_stream_get_value(
@@ -94,6 +104,10 @@ int libewf_deflate_bit_stream_get_value(
      uint32_t *value_32bit,
      libcerror_error_t **error );
 
+int libewf_deflate_bit_stream_fill(
+     libewf_deflate_bit_stream_t *bit_stream,
+     libcerror_error_t **error );
+
 int libewf_deflate_huffman_table_construct(
      libewf_deflate_huffman_table_t *table,
      const uint16_t *code_sizes_array,
@@ -120,13 +134,6 @@ int libewf_deflate_bit_stream_get_huffman_encoded_codes_array(
      uint32_t number_of_codes,
      libcerror_error_t **error );
 
-int libewf_deflate_calculate_adler32(
-     uint32_t *checksum_value,
-     const uint8_t *buffer,
-     size_t size,
-     uint32_t initial_value,
-     libcerror_error_t **error );
-
 int libewf_deflate_decompress(
      const uint8_t *compressed_data,
      size_t compressed_data_size,
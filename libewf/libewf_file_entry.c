@@ -2089,26 +2089,14 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 	{
 		read_size = 1;
 	}
-	if( libewf_handle_seek_offset(
-	     (libewf_handle_t *) internal_file_entry->internal_handle,
-	     data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 ".",
-		 function,
-		 data_offset );
-
-		return( -1 );
-	}
-	read_count = libewf_handle_read_buffer(
+	/* Read at the offset so that the current offset of the handle, which is shared
+	 * with other file entries, does not need to be changed
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
 		      (libewf_handle_t *) internal_file_entry->internal_handle,
 		      buffer,
 		      read_size,
+		      data_offset,
 		      error );
 
 	if( read_count <= -1 )
@@ -2117,8 +2105,9 @@ ssize_t libewf_internal_file_entry_read_buffer_from_single_file_entry(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 data_offset );
 
 		return( -1 );
 	}
@@ -2923,6 +2912,7 @@ int libewf_file_entry_get_sub_file_entry_by_utf8_name(
 	}
 #endif
 	result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+	          internal_file_entry->internal_handle->single_files,
 	          internal_file_entry->file_entry_tree_node,
 	          utf8_string,
 	          utf8_string_length,
@@ -3152,6 +3142,7 @@ int libewf_file_entry_get_sub_file_entry_by_utf8_path(
 			goto on_error;
 		}
 		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+			  internal_file_entry->internal_handle->single_files,
 			  node,
 			  utf8_string_segment,
 			  utf8_string_segment_length,
@@ -3298,6 +3289,7 @@ int libewf_file_entry_get_sub_file_entry_by_utf16_name(
 	}
 #endif
 	result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+	          internal_file_entry->internal_handle->single_files,
 	          internal_file_entry->file_entry_tree_node,
 	          utf16_string,
 	          utf16_string_length,
@@ -3527,6 +3519,7 @@ int libewf_file_entry_get_sub_file_entry_by_utf16_path(
 			goto on_error;
 		}
 		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+			  internal_file_entry->internal_handle->single_files,
 			  node,
 			  utf16_string_segment,
 			  utf16_string_segment_length,
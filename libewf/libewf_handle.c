@@ -29,6 +29,7 @@
 #include "libewf_case_data.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_table.h"
+#include "libewf_chunk_view.h"
 #include "libewf_codepage.h"
 #include "libewf_compression.h"
 #include "libewf_data_chunk.h"
@@ -41,6 +42,7 @@
 #include "libewf_hash_values.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -208,6 +210,19 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->chunk_table_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
 	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
@@ -219,6 +234,14 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
 		if( internal_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -316,6 +339,19 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->chunk_table_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
 		if( libewf_io_handle_free(
 		     &( internal_handle->io_handle ),
@@ -385,6 +421,22 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( internal_handle->index_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( internal_handle->index_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 internal_handle );
 	}
@@ -730,6 +782,9 @@ int libewf_handle_clone(
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
 	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->chunk_cache_size               = internal_source_handle->chunk_cache_size;
+	internal_destination_handle->read_ahead_number_of_chunks    = internal_source_handle->read_ahead_number_of_chunks;
+	internal_destination_handle->number_of_threads              = internal_source_handle->number_of_threads;
 	internal_destination_handle->date_format                    = internal_source_handle->date_format;
 
 	return( 1 );
@@ -897,6 +952,7 @@ int libewf_handle_open(
 	int file_io_pool_entry                    = 0;
 	int filename_index                        = 0;
 	int maximum_number_of_open_handles        = 0;
+	int queue_depth                           = 0;
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -951,6 +1007,21 @@ int libewf_handle_open(
 #endif
 	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
 
+	/* The file IO handles batch the chunk reads of the read-ahead
+	 * unless the segment files are memory mapped
+	 */
+	if( ( internal_handle->read_ahead_number_of_chunks > 0 )
+	 && ( internal_handle->number_of_threads > 0 )
+	 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_MEMORY_MAP ) ) == 0 ) )
+	{
+		queue_depth = internal_handle->read_ahead_number_of_chunks;
+
+		if( queue_depth > 4096 )
+		{
+			queue_depth = 4096;
+		}
+	}
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -1005,9 +1076,25 @@ int libewf_handle_open(
 
 				goto on_error;
 			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+			{
+				result = libbfio_file_mmap_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else if( queue_depth > 0 )
+			{
+				result = libbfio_file_io_uring_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else
+			{
+				result = libbfio_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1018,6 +1105,23 @@ int libewf_handle_open(
 
 				goto on_error;
 			}
+			if( queue_depth > 0 )
+			{
+				if( libbfio_file_io_uring_set_queue_depth(
+				     file_io_handle,
+				     queue_depth,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set queue depth in file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libbfio_handle_set_track_offsets_read(
 			     file_io_handle,
@@ -1034,11 +1138,31 @@ int libewf_handle_open(
 				goto on_error;
 			}
 #endif
-			if( libbfio_file_set_name(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
-			     error ) != 1 )
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+			{
+				result = libbfio_file_mmap_set_name(
+				          file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			else if( queue_depth > 0 )
+			{
+				result = libbfio_file_io_uring_set_name(
+				          file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			else
+			{
+				result = libbfio_file_set_name(
+				          file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1263,6 +1387,7 @@ int libewf_handle_open_wide(
 	int file_io_pool_entry                    = 0;
 	int filename_index                        = 0;
 	int maximum_number_of_open_handles        = 0;
+	int queue_depth                           = 0;
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -1317,6 +1442,21 @@ int libewf_handle_open_wide(
 #endif
 	maximum_number_of_open_handles = internal_handle->maximum_number_of_open_handles;
 
+	/* The file IO handles batch the chunk reads of the read-ahead
+	 * unless the segment files are memory mapped
+	 */
+	if( ( internal_handle->read_ahead_number_of_chunks > 0 )
+	 && ( internal_handle->number_of_threads > 0 )
+	 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_MEMORY_MAP ) ) == 0 ) )
+	{
+		queue_depth = internal_handle->read_ahead_number_of_chunks;
+
+		if( queue_depth > 4096 )
+		{
+			queue_depth = 4096;
+		}
+	}
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -1371,9 +1511,25 @@ int libewf_handle_open_wide(
 
 				goto on_error;
 			}
-			if( libbfio_file_initialize(
-			     &file_io_handle,
-			     error ) != 1 )
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+			{
+				result = libbfio_file_mmap_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else if( queue_depth > 0 )
+			{
+				result = libbfio_file_io_uring_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			else
+			{
+				result = libbfio_file_initialize(
+				          &file_io_handle,
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1384,6 +1540,23 @@ int libewf_handle_open_wide(
 
 				goto on_error;
 			}
+			if( queue_depth > 0 )
+			{
+				if( libbfio_file_io_uring_set_queue_depth(
+				     file_io_handle,
+				     queue_depth,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set queue depth in file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libbfio_handle_set_track_offsets_read(
 			     file_io_handle,
@@ -1400,11 +1573,31 @@ int libewf_handle_open_wide(
 				goto on_error;
 			}
 #endif
-			if( libbfio_file_set_name_wide(
-			     file_io_handle,
-			     filenames[ filename_index ],
-			     filename_length,
-			     error ) != 1 )
+			if( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+			{
+				result = libbfio_file_mmap_set_name_wide(
+				          file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			else if( queue_depth > 0 )
+			{
+				result = libbfio_file_io_uring_set_name_wide(
+				          file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			else
+			{
+				result = libbfio_file_set_name_wide(
+				          file_io_handle,
+				          filenames[ filename_index ],
+				          filename_length,
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -2924,22 +3117,27 @@ on_error:
 }
 
 /* Opens the segment files for reading
+ * If index_file is not NULL the layout of the segment files is appended to it
  * Returns 1 if successful or -1 on error
  */
 int libewf_internal_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
+     libewf_index_file_t *index_file,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_read_segment_files";
-	size64_t maximum_segment_size       = 0;
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	libewf_segment_file_t *segment_file     = NULL;
+	static char *function                   = "libewf_internal_handle_open_read_segment_files";
+	size64_t maximum_segment_size           = 0;
+	size64_t segment_file_size              = 0;
+	size64_t storage_media_size             = 0;
+	uint64_t segment_file_modification_time = 0;
+	uint32_t number_of_segments             = 0;
+	uint32_t segment_number                 = 0;
+	uint8_t read_on_demand                  = 0;
+	int file_io_pool_entry                  = 0;
+	int last_segment_file                   = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -3010,6 +3208,18 @@ int libewf_internal_handle_open_read_segment_files(
 
 		return( -1 );
 	}
+	/* When the segment files are read on demand only the first and last
+	 * segment files are read, the other segment files are read when
+	 * the storage media data they contain is accessed
+	 * The index file requires all segment files to be read
+	 */
+	if( ( internal_handle->read_segment_files_on_demand != 0 )
+	 && ( internal_handle->write_io_handle == NULL )
+	 && ( index_file == NULL )
+	 && ( number_of_segments > 2 ) )
+	{
+		read_on_demand = 1;
+	}
 	for( segment_number = 0;
 	     segment_number < number_of_segments;
 	     segment_number++ )
@@ -3053,6 +3263,28 @@ int libewf_internal_handle_open_read_segment_files(
 				return( -1 );
 			}
 		}
+		if( ( read_on_demand != 0 )
+		 && ( segment_number > 0 )
+		 && ( segment_number < ( number_of_segments - 1 ) ) )
+		{
+			if( libewf_segment_table_set_segment_storage_media_size_by_index(
+			     segment_table,
+			     segment_number,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+			continue;
+		}
 		if( libewf_segment_table_get_segment_file_by_index(
 		     segment_table,
 		     segment_number,
@@ -3194,10 +3426,21 @@ int libewf_internal_handle_open_read_segment_files(
 
 			return( -1 );
 		}
+		/* The last segment file is mapped after the preceding segment files
+		 */
+		if( ( read_on_demand != 0 )
+		 && ( segment_number > 0 ) )
+		{
+			storage_media_size = 0;
+		}
+		else
+		{
+			storage_media_size = segment_file->storage_media_size;
+		}
 		if( libewf_segment_table_set_segment_storage_media_size_by_index(
 		     segment_table,
 		     segment_number,
-		     segment_file->storage_media_size,
+		     storage_media_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -3210,9 +3453,64 @@ int libewf_internal_handle_open_read_segment_files(
 
 			return( -1 );
 		}
+		if( index_file != NULL )
+		{
+			if( libewf_internal_handle_get_segment_file_modification_time(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_modification_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve modification time of segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+			if( libewf_index_file_append_segment_file(
+			     index_file,
+			     segment_file,
+			     segment_file_size,
+			     segment_file_modification_time,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append segment file: %" PRIu32 " to index file.",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+		}
 		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
 		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
 	}
+	if( read_on_demand != 0 )
+	{
+		if( memory_copy(
+		     segment_table->set_identifier,
+		     internal_handle->media_values->set_identifier,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy set identifier to segment table.",
+			 function );
+
+			return( -1 );
+		}
+		segment_table->number_of_mapped_segments = 1;
+		segment_table->flags                    |= LIBEWF_SEGMENT_TABLE_FLAG_READ_ON_DEMAND;
+	}
 	if( last_segment_file == 0 )
 	{
 		libcerror_error_set(
@@ -3241,98 +3539,412 @@ int libewf_internal_handle_open_read_segment_files(
 	return( 1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
+/* Retrieves the modification time of a segment file
+ * The modification time is set to 0 if not available
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_file_io_pool(
-     libewf_internal_handle_t *internal_handle,
+int libewf_internal_handle_get_segment_file_modification_time(
      libbfio_pool_t *file_io_pool,
-     int access_flags,
-     libewf_segment_table_t *segment_table,
+     int file_io_pool_entry,
+     uint64_t *modification_time,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle    = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_file_io_pool";
-	size64_t segment_file_size          = 0;
-	ssize_t read_count                  = 0;
-	int file_io_pool_entry              = 0;
-	int number_of_file_io_handles       = 0;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libewf_internal_handle_get_segment_file_modification_time";
+	int result                       = 0;
 
-	if( internal_handle == NULL )
+	if( modification_time == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid modification time.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->file_io_pool != NULL )
+	*modification_time = 0;
+
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	/* A handle that was closed by the pool has no modification time available
+	 */
+	result = libbfio_handle_is_open(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if file IO handle: %d is open.",
+		 function,
+		 file_io_pool_entry );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_table != NULL )
+	else if( result == 0 )
+	{
+		return( 1 );
+	}
+	if( libbfio_handle_get_modification_time(
+	     file_io_handle,
+	     modification_time,
+	     error ) == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve modification time of file IO handle: %d.",
+		 function,
+		 file_io_pool_entry );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_groups_cache != NULL )
+	return( 1 );
+}
+
+/* Reads the index file
+ * Returns 1 if successful, 0 if the index file is not available or not valid or -1 on error
+ */
+int libewf_internal_handle_open_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_open_read_index_file";
+	int result            = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks group cache value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunks_cache != NULL )
+	if( index_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks cache value already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( internal_handle->index_file_io_handle == NULL )
+	{
+		return( 0 );
+	}
+	result = libbfio_handle_exists(
+	          internal_handle->index_file_io_handle,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if index file exists.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libewf_index_file_initialize(
+	     index_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     internal_handle->index_file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_index_file_read_file_io_handle(
+	          *index_file,
+	          internal_handle->index_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file.",
+		 function );
+
+		libbfio_handle_close(
+		 internal_handle->index_file_io_handle,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     internal_handle->index_file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+		if( libewf_index_file_free(
+		     index_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( *index_file != NULL )
+	{
+		libewf_index_file_free(
+		 index_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_write_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_open_write_index_file";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->index_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing index file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_open(
+	     internal_handle->index_file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_index_file_write_file_io_handle(
+	     index_file,
+	     internal_handle->index_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file.",
+		 function );
+
+		libbfio_handle_close(
+		 internal_handle->index_file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libbfio_handle_close(
+	     internal_handle->index_file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle        = NULL;
+	libewf_index_file_t *index_file         = NULL;
+	libewf_segment_file_t *segment_file     = NULL;
+	static char *function                   = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size              = 0;
+	uint64_t segment_file_modification_time = 0;
+	ssize_t read_count                      = 0;
+	int file_io_pool_entry                  = 0;
+	int number_of_file_io_handles           = 0;
+	int result                              = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	size64_t maximum_cache_size             = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_groups_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks group cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunks_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
 		 function );
 
 		return( -1 );
@@ -3359,9 +3971,13 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME | LIBEWF_ACCESS_FLAG_MEMORY_MAP | LIBEWF_ACCESS_FLAG_DIRECT_IO ) ) != 0 )
 	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	  &&  ( ( access_flags & ( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 ) ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -3405,6 +4021,12 @@ int libewf_internal_handle_open_file_io_pool(
 
 			goto on_error;
 		}
+		/* The segment files are written with concurrent writes when threads are used
+		 */
+		if( internal_handle->number_of_threads > 0 )
+		{
+			internal_handle->write_io_handle->segment_file_queue_depth = LIBEWF_SEGMENT_FILE_WRITE_QUEUE_DEPTH;
+		}
 	}
 	if( libewf_chunk_table_initialize(
 	     &( internal_handle->chunk_table ),
@@ -3434,10 +4056,29 @@ int libewf_internal_handle_open_file_io_pool(
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunks_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-	     error ) != 1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* When opened read-only the chunk cache size applies to the shared chunks cache,
+	 * the chunks cache then only holds the chunks that bypass the shared chunks cache
+	 */
+	if( ( internal_handle->chunk_cache_size != 0 )
+	 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 ) )
+#else
+	if( internal_handle->chunk_cache_size != 0 )
+#endif
+	{
+		result = libfcache_cache_initialize_with_maximum_size(
+		          &( internal_handle->chunks_cache ),
+		          internal_handle->chunk_cache_size,
+		          error );
+	}
+	else
+	{
+		result = libfcache_cache_initialize(
+		          &( internal_handle->chunks_cache ),
+		          LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -3546,6 +4187,31 @@ int libewf_internal_handle_open_file_io_pool(
 
 			goto on_error;
 		}
+		/* The index file is only used when the segment files are opened read-only
+		 * a missing or unreadable index file is not considered an error
+		 */
+		if( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
+		{
+			if( libewf_internal_handle_open_read_index_file(
+			     internal_handle,
+			     &index_file,
+			     error ) == -1 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+			}
+		}
 		if( libewf_segment_file_initialize(
 		     &segment_file,
 		     internal_handle->io_handle,
@@ -3634,16 +4300,78 @@ int libewf_internal_handle_open_file_io_pool(
 
 				goto on_error;
 			}
-			if( libewf_segment_table_append_segment_by_segment_file(
-			     segment_table,
-			     segment_file,
-			     file_io_pool_entry,
-			     segment_file_size,
-			     error ) != 1 )
+			if( index_file != NULL )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				if( libewf_internal_handle_get_segment_file_modification_time(
+				     file_io_pool,
+				     file_io_pool_entry,
+				     &segment_file_modification_time,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve modification time of file IO pool entry: %d.",
+					 function,
+					 file_io_pool_entry );
+
+					goto on_error;
+				}
+				result = libewf_index_file_compare_segment_file(
+				          index_file,
+				          segment_file,
+				          segment_file_size,
+				          segment_file_modification_time,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to compare segment file with index file.",
+					 function );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_printf(
+						 "%s: index file does not match segment: %" PRIu32 ".\n",
+						 function,
+						 segment_file->segment_number );
+					}
+#endif
+					if( libewf_index_file_free(
+					     &index_file,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free index file.",
+						 function );
+
+						goto on_error;
+					}
+				}
+			}
+			if( libewf_segment_table_append_segment_by_segment_file(
+			     segment_table,
+			     segment_file,
+			     file_io_pool_entry,
+			     segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
 				 "%s: unable to append segment: %" PRIu32 " to segment table.",
 				 function,
@@ -3665,10 +4393,68 @@ int libewf_internal_handle_open_file_io_pool(
 
 			goto on_error;
 		}
+		if( index_file != NULL )
+		{
+			if( index_file->number_of_segments == segment_table->number_of_segments )
+			{
+				/* The segment table takes over the management of the index file
+				 */
+				if( libewf_segment_table_set_index_file(
+				     segment_table,
+				     index_file,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set index file in segment table.",
+					 function );
+
+					goto on_error;
+				}
+				index_file = NULL;
+			}
+			else if( libewf_index_file_free(
+			          &index_file,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* Without a valid index file the layout of the segment files
+		 * is collected while reading them to (re)write the index file
+		 */
+		if( ( internal_handle->index_file_io_handle != NULL )
+		 && ( segment_table->index_file == NULL )
+		 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 ) )
+		{
+			if( libewf_index_file_initialize(
+			     &index_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create index file.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libewf_internal_handle_open_read_segment_files(
 		     internal_handle,
 		     file_io_pool,
 		     segment_table,
+		     index_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -3696,6 +4482,46 @@ int libewf_internal_handle_open_file_io_pool(
 			libcerror_error_free(
 			 error );
 		}
+		if( index_file != NULL )
+		{
+			if( ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED ) == 0 )
+			{
+				/* Failing to write the index file is not considered an error
+				 */
+				if( libewf_internal_handle_open_write_index_file(
+				     internal_handle,
+				     index_file,
+				     error ) != 1 )
+				{
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( ( error != NULL )
+						 && ( *error != NULL ) )
+						{
+							libcnotify_print_error_backtrace(
+							 *error );
+						}
+					}
+#endif
+					libcerror_error_free(
+					 error );
+				}
+			}
+			if( libewf_index_file_free(
+			     &index_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( internal_handle->media_values == NULL )
 		{
 			libcerror_error_set(
@@ -3770,6 +4596,33 @@ int libewf_internal_handle_open_file_io_pool(
 		}
 	}
 			internal_handle->io_handle->chunk_size = internal_handle->media_values->chunk_size;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
+	 && ( internal_handle->media_values->chunk_size != 0 ) )
+	{
+		maximum_cache_size = (size64_t) LIBEWF_MAXIMUM_CACHE_ENTRIES_SHARED_CHUNKS * internal_handle->media_values->chunk_size;
+
+		if( internal_handle->chunk_cache_size != 0 )
+		{
+			maximum_cache_size = internal_handle->chunk_cache_size;
+		}
+		if( libewf_shared_chunks_cache_initialize(
+		     &( internal_handle->shared_chunks_cache ),
+		     maximum_cache_size,
+		     internal_handle->media_values->chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shared chunks cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	internal_handle->io_handle->access_flags = access_flags;
 	internal_handle->file_io_pool            = file_io_pool;
 	internal_handle->segment_table           = segment_table;
@@ -3777,6 +4630,12 @@ int libewf_internal_handle_open_file_io_pool(
 	return( 1 );
 
 on_error:
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -4009,6 +4868,56 @@ int libewf_handle_close(
 			result = -1;
 		}
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->read_ahead != NULL )
+	{
+		if( libewf_read_ahead_free(
+		     &( internal_handle->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->chunk_packer != NULL )
+	{
+		if( libewf_chunk_packer_free(
+		     &( internal_handle->chunk_packer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk packer.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->shared_chunks_cache != NULL )
+	{
+		if( libewf_shared_chunks_cache_free(
+		     &( internal_handle->shared_chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free shared chunks cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
 	if( internal_handle->file_io_pool_created_in_library != 0 )
 	{
 		if( libbfio_pool_close_all(
@@ -4306,24 +5215,25 @@ int libewf_handle_close(
 	return( result );
 }
 
-/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+/* Retrieves the (unpacked) chunk data of the chunk at a specific offset
+ * The chunk data is retrieved from the read-ahead if available, otherwise from the chunks cache
+ * The end chunk index is the index of the last chunk of the read and is used to read ahead
+ * The chunk data is managed by the read-ahead or the chunks cache
  * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_get_chunk_data_at_offset(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     uint64_t end_chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	uint64_t chunk_index            = 0;
-	size_t buffer_offset            = 0;
-	size_t read_size                = 0;
-	ssize_t total_read_count        = 0;
+	static char *function = "libewf_internal_handle_get_chunk_data_at_offset";
+	uint64_t chunk_index  = 0;
+	int result            = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -4347,115 +5257,334 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( chunk_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-	{
-		return( 0 );
-	}
-	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	chunk_index = (uint64_t) offset / internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunks are only read ahead when the handle is opened read-only
+	 * since a write or resume can change the chunks after they were read
+	 */
+	if( ( internal_handle->read_ahead == NULL )
+	 && ( internal_handle->read_ahead_number_of_chunks > 0 )
+	 && ( internal_handle->number_of_threads > 0 )
+	 && ( ( internal_handle->io_handle->access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 ) )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		if( libewf_read_ahead_initialize(
+		     &( internal_handle->read_ahead ),
+		     internal_handle->io_handle,
+		     internal_handle->read_ahead_number_of_chunks,
+		     internal_handle->number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead.",
+			 function );
 
-	while( buffer_size > 0 )
+			return( -1 );
+		}
+	}
+	if( internal_handle->read_ahead != NULL )
 	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
+		if( libewf_read_ahead_schedule(
+		     internal_handle->read_ahead,
 		     chunk_index,
-		     internal_handle->io_handle,
+		     end_chunk_index,
+		     internal_handle->chunk_table,
 		     file_io_pool,
 		     internal_handle->media_values,
 		     internal_handle->segment_table,
 		     internal_handle->chunk_groups_cache,
-		     internal_handle->chunks_cache,
-		     internal_handle->current_offset,
-		     &chunk_data,
-		     &chunk_data_offset,
 		     error ) != 1 )
 		{
+			/* A failure to read ahead is not fatal, the read-ahead window was reset
+			 * and the chunk is read by the chunks cache
+			 */
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 "%s: unable to read ahead chunks following chunk: %" PRIu64 ".",
 			 function,
 			 chunk_index );
 
-			return( -1 );
-		}
-		if( chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		else
+		{
+			result = libewf_read_ahead_get_chunk_data(
+			          internal_handle->read_ahead,
+			          chunk_index,
+			          chunk_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve read-ahead chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				*chunk_data_offset = offset - (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+			}
+		}
+	}
+#endif
+	/* Chunks that were not read ahead, including corrupted chunks,
+	 * are read by the chunks cache
+	 */
+	if( result == 0 )
+	{
+		if( libewf_chunk_table_get_chunk_data_by_offset(
+		     internal_handle->chunk_table,
+		     chunk_index,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->chunk_groups_cache,
+		     internal_handle->chunks_cache,
+		     offset,
+		     chunk_data,
+		     chunk_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	uint64_t chunk_index            = 0;
+	uint64_t end_chunk_index        = 0;
+	size_t buffer_offset            = 0;
+	size_t read_size                = 0;
+	ssize_t total_read_count        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index     = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+	end_chunk_index = ( internal_handle->current_offset + buffer_size - 1 ) / internal_handle->media_values->chunk_size;
+
+	while( buffer_size > 0 )
+	{
+		if( libewf_internal_handle_get_chunk_data_at_offset(
+		     internal_handle,
+		     file_io_pool,
+		     internal_handle->current_offset,
+		     end_chunk_index,
+		     &chunk_data,
+		     &chunk_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
 			 function,
 			 chunk_index );
 
@@ -4531,6 +5660,7 @@ ssize_t libewf_handle_read_buffer(
 	libewf_internal_handle_t *internal_handle = NULL;
 	static char *function                     = "libewf_handle_read_buffer";
 	ssize_t read_count                        = 0;
+	ssize_t remaining_read_count              = 0;
 
 	if( handle == NULL )
 	{
@@ -4570,24 +5700,66 @@ ssize_t libewf_handle_read_buffer(
 
 		return( -1 );
 	}
-#endif
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
+	/* When opened read-only the chunks are read using the shared chunks cache
+	 * unless they are read ahead
+	 */
+	if( ( internal_handle->shared_chunks_cache != NULL )
+	 && ( internal_handle->read_ahead_number_of_chunks == 0 ) )
+	{
+		read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+		              internal_handle,
+		              internal_handle->file_io_pool,
+		              buffer,
+		              buffer_size,
+		              internal_handle->current_offset,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+		}
+		else if( read_count > 0 )
+		{
+			internal_handle->current_offset += (off64_t) read_count;
 
-	if( read_count == -1 )
+			buffer       = &( ( (uint8_t *) buffer )[ read_count ] );
+			buffer_size -= (size_t) read_count;
+		}
+	}
+#endif
+	/* The remaining data starts with a sparse, missing or corrupted chunk
+	 * or is at or beyond the end of the media data
+	 */
+	if( ( read_count != -1 )
+	 && ( buffer_size > 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		remaining_read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		                        internal_handle,
+		                        internal_handle->file_io_pool,
+		                        buffer,
+		                        buffer_size,
+		                        error );
 
-		read_count = -1;
+		if( remaining_read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			read_count = -1;
+		}
+		else
+		{
+			read_count += remaining_read_count;
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -4607,21 +5779,42 @@ ssize_t libewf_handle_read_buffer(
 	return( read_count );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * The chunks are read and unpacked concurrently and stored in the shared chunks cache,
+ * only the lookup of the chunk data ranges is serialized by the chunk table mutex
+ * Reading stops at a chunk that is sparse, missing or corrupted, these need to be
+ * read using libewf_internal_handle_read_buffer_from_file_io_pool
+ * This function does not change the current offset and only requires the read lock
+ * Returns the number of bytes read or -1 on error
  */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
          void *buffer,
          size_t buffer_size,
          off64_t offset,
          libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
+	libewf_chunk_data_t *chunk_data    = NULL;
+	libbfio_handle_t *file_io_handle   = NULL;
+	static char *function              = "libewf_internal_handle_read_buffer_at_offset_from_file_io_pool";
+	off64_t chunk_data_offset          = 0;
+	size64_t chunk_data_size           = 0;
+	size_t buffer_offset               = 0;
+	size_t chunk_offset                = 0;
+	size_t read_size                   = 0;
+	ssize_t chunk_read_count           = 0;
+	ssize_t read_count                 = 0;
+	uint64_t chunk_index               = 0;
+	uint32_t chunk_data_flags          = 0;
+	uint8_t mutex_grabbed              = 0;
+	int file_io_pool_entry             = 0;
+	int maximum_number_of_open_handles = 0;
+	int result                         = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -4632,163 +5825,17 @@ ssize_t libewf_handle_read_buffer_at_offset(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
-
-		return( -1 );
-	}
-#endif
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		goto on_error;
-	}
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              buffer,
-	              buffer_size,
-	              error );
-
-	if( read_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		return( -1 );
-	}
-#endif
-	return( read_count );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
-	off64_t chunk_data_offset = 0;
-	size_t buffer_offset      = 0;
-	size_t input_data_size    = 0;
-	size_t write_size         = 0;
-	ssize_t write_count       = 0;
-	uint64_t chunk_index      = 0;
-	int write_chunk           = 0;
-
-	if( internal_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->current_offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
-
-			return( -1 );
-		}
-	}
 	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
@@ -4811,13 +5858,13 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( internal_handle->shared_chunks_cache == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 "%s: invalid handle - missing shared chunks cache.",
 		 function );
 
 		return( -1 );
@@ -4844,254 +5891,399 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
 	{
 		return( 0 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	if( (size64_t) ( offset + buffer_size ) >= internal_handle->media_values->media_size )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
 	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-	if( chunk_index >= (uint64_t) INT_MAX )
+	while( buffer_size > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+		chunk_index  = (uint64_t) offset / internal_handle->media_values->chunk_size;
+		chunk_offset = (size_t) ( (uint64_t) offset % internal_handle->media_values->chunk_size );
 
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
-		 function );
+		result = libewf_shared_chunks_cache_copy_chunk_data(
+		          internal_handle->shared_chunks_cache,
+		          chunk_index,
+		          chunk_offset,
+		          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		          buffer_size,
+		          &read_size,
+		          error );
 
-		return( -1 );
-	}
-	while( buffer_size > 0 )
-	{
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already set.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data from shared chunks cache.",
 			 function,
 			 chunk_index );
 
-			return( -1 );
-		}
-		if( internal_handle->write_io_handle->write_finalized != 0 )
-		{
-			break;
+			goto on_error;
 		}
-		if( internal_handle->chunk_data == NULL )
+		else if( result == 0 )
 		{
-			if( libewf_chunk_data_initialize(
-			     &( internal_handle->chunk_data ),
-			     internal_handle->media_values->chunk_size,
-			     0,
+			if( libcthreads_mutex_grab(
+			     internal_handle->chunk_table_mutex,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab chunk table mutex.",
+				 function );
+
+				goto on_error;
+			}
+			mutex_grabbed = 1;
+
+			result = libewf_chunk_table_get_chunk_data_range_by_offset(
+			          internal_handle->chunk_table,
+			          chunk_index,
+			          file_io_pool,
+			          internal_handle->segment_table,
+			          internal_handle->chunk_groups_cache,
+			          offset,
+			          &file_io_pool_entry,
+			          &chunk_data_offset,
+			          &chunk_data_size,
+			          &chunk_data_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
 				 function,
 				 chunk_index );
 
-				return( -1 );
+				goto on_error;
 			}
-		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			else if( ( result == 0 )
+			      || ( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+			{
+				break;
+			}
+			/* The chunk data can only be read outside the mutex if the file IO handle
+			 * is open, the file IO pool will not close it to open another handle
+			 * and the file IO handle reads at an offset without seeking
+			 */
+			if( libbfio_pool_get_maximum_number_of_open_handles(
+			     file_io_pool,
+			     &maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve maximum number of open handles.",
+				 function );
 
-			return( -1 );
-		}
-		if( chunk_data_offset > internal_handle->media_values->chunk_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
-			 function );
+				goto on_error;
+			}
+			if( maximum_number_of_open_handles == LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+			{
+				if( libbfio_pool_get_handle(
+				     file_io_pool,
+				     file_io_pool_entry,
+				     &file_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve file IO handle: %d from pool.",
+					 function,
+					 file_io_pool_entry );
 
-			return( -1 );
-		}
-		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+					goto on_error;
+				}
+				result = libbfio_handle_is_open(
+				          file_io_handle,
+				          error );
 
-		if( write_size > buffer_size )
-		{
-			write_size = buffer_size;
-		}
-		if( write_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     write_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to chunk data.",
-			 function );
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if file IO handle: %d is open.",
+					 function,
+					 file_io_pool_entry );
 
-			return( -1 );
-		}
-		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					result = libbfio_handle_supports_concurrent_reads(
+					          file_io_handle,
+					          error );
 
-		buffer_offset += write_size;
-		buffer_size   -= write_size;
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to determine if file IO handle: %d supports concurrent reads.",
+						 function,
+						 file_io_pool_entry );
 
-		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-		{
-			write_chunk = 1;
-		}
-		else if( ( internal_handle->media_values->media_size != 0 )
-		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-		{
-			write_chunk = 1;
-		}
-		else
-		{
-			write_chunk = 0;
-		}
-		if( write_chunk != 0 )
-		{
-			input_data_size = internal_handle->chunk_data->data_size;
+						goto on_error;
+					}
+				}
+				if( result != 0 )
+				{
+					mutex_grabbed = 0;
 
-			if( libewf_chunk_data_pack(
-			     internal_handle->chunk_data,
-			     internal_handle->io_handle,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     internal_handle->write_io_handle->pack_flags,
+					if( libcthreads_mutex_release(
+					     internal_handle->chunk_table_mutex,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to release chunk table mutex.",
+						 function );
+
+						goto on_error;
+					}
+				}
+			}
+			if( libewf_chunk_data_initialize(
+			     &chunk_data,
+			     internal_handle->io_handle->chunk_size,
+			     0,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
 				 function,
 				 chunk_index );
 
-				return( -1 );
+				goto on_error;
 			}
-			write_count = libewf_write_io_handle_write_new_chunk(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-			               file_io_pool,
-			               internal_handle->media_values,
-			               internal_handle->segment_table,
-			               internal_handle->header_values,
-			               internal_handle->hash_values,
-			               internal_handle->hash_sections,
-			               internal_handle->sessions,
-			               internal_handle->tracks,
-			               internal_handle->acquiry_errors,
-			               chunk_index,
-			               internal_handle->chunk_data,
-			               input_data_size,
-			               error );
-
-			if( write_count <= 0 )
+			chunk_read_count = libewf_chunk_data_read_from_file_io_pool(
+			                    chunk_data,
+			                    file_io_pool,
+			                    file_io_pool_entry,
+			                    chunk_data_offset,
+			                    chunk_data_size,
+			                    chunk_data_flags,
+			                    error );
+
+			if( chunk_read_count < 0 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new chunk.",
-				 function );
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
 
-				return( -1 );
+				goto on_error;
 			}
-			if( libewf_chunk_data_free(
-			     &( internal_handle->chunk_data ),
+			if( mutex_grabbed != 0 )
+			{
+				mutex_grabbed = 0;
+
+				if( libcthreads_mutex_release(
+				     internal_handle->chunk_table_mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release chunk table mutex.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libewf_chunk_data_unpack(
+			     chunk_data,
+			     internal_handle->io_handle,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free chunk data.",
-				 function );
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
 
-				return( -1 );
+				goto on_error;
 			}
-		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
+			/* Corrupted chunks need to be tracked as checksum errors
+			 */
+			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+			{
+				if( libewf_chunk_data_free(
+				     &chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
 
-		internal_handle->current_offset += (off64_t) write_size;
+					goto on_error;
+				}
+				break;
+			}
+			read_size = 0;
 
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+			if( chunk_offset < chunk_data->data_size )
+			{
+				read_size = chunk_data->data_size - chunk_offset;
+
+				if( read_size > buffer_size )
+				{
+					read_size = buffer_size;
+				}
+				if( memory_copy(
+				     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				     &( ( chunk_data->data )[ chunk_offset ] ),
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			if( libewf_shared_chunks_cache_set_chunk_data(
+			     internal_handle->shared_chunks_cache,
+			     chunk_index,
+			     chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk: %" PRIu64 " data in shared chunks cache.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			/* The shared chunks cache takes over management of chunk_data
+			 */
+			chunk_data = NULL;
+		}
+		if( read_size == 0 )
 		{
 			break;
 		}
+		buffer_offset += read_size;
+		buffer_size   -= read_size;
+		read_count    += (ssize_t) read_size;
+		offset        += (off64_t) read_size;
+
 		if( internal_handle->io_handle->abort != 0 )
 		{
 			break;
 		}
 	}
-	return( (ssize_t) buffer_offset );
+	if( mutex_grabbed != 0 )
+	{
+		mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( read_count );
+
+on_error:
+	if( mutex_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 internal_handle->chunk_table_mutex,
+		 NULL );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+#if defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES )
+
+/* Retrieves a view of the (media) data of the chunk at a specific offset from the shared chunks cache
+ * A chunk that is not cached is read into the shared chunks cache first
+ * This function does not change the current offset and only requires the read lock
+ * Returns 1 if successful, 0 if the chunk is sparse, missing or corrupted or -1 on error
  */
-ssize_t libewf_handle_write_buffer(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_get_chunk_view_from_shared_chunks_cache(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	ssize_t write_count                       = 0;
+	libewf_internal_chunk_view_t *internal_chunk_view = NULL;
+	static char *function                             = "libewf_internal_handle_get_chunk_view_from_shared_chunks_cache";
+	size_t chunk_offset                               = 0;
+	ssize_t read_count                                = 0;
+	uint64_t chunk_index                              = 0;
+	uint8_t read_byte                                 = 0;
+	int result                                        = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5102,112 +6294,179 @@ ssize_t libewf_handle_write_buffer(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	if( internal_handle->shared_chunks_cache == NULL )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing shared chunks cache.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count == -1 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( write_count );
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
 
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+		return( -1 );
+	}
+	chunk_index  = (uint64_t) offset / internal_handle->media_values->chunk_size;
+	chunk_offset = (size_t) ( (uint64_t) offset % internal_handle->media_values->chunk_size );
+
+	result = libewf_shared_chunks_cache_get_chunk_view(
+	          internal_handle->shared_chunks_cache,
+	          chunk_index,
+	          chunk_view,
+	          error );
+
+	if( result == 0 )
+	{
+		/* Reading a byte of the chunk stores the chunk in the shared chunks cache
+		 */
+		read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+		              internal_handle,
+		              file_io_pool,
+		              &read_byte,
+		              1,
+		              offset,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			return( 0 );
+		}
+		/* The chunk can be evicted by another thread before the view is retrieved
+		 */
+		result = libewf_shared_chunks_cache_get_chunk_view(
+		          internal_handle->shared_chunks_cache,
+		          chunk_index,
+		          chunk_view,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " view from shared chunks cache.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	internal_chunk_view = (libewf_internal_chunk_view_t *) *chunk_view;
+
+	if( chunk_offset >= internal_chunk_view->chunk_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_index );
+
+		libewf_chunk_view_free(
+		 chunk_view,
+		 NULL );
+
+		return( -1 );
+	}
+	*data      = &( ( internal_chunk_view->chunk_data->data )[ chunk_offset ] );
+	*data_size = internal_chunk_view->chunk_data->data_size - chunk_offset;
+
+	return( 1 );
 }
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+#endif /* defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES ) */
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads (media) data at a specific offset
+ * This function does not change the current offset
+ * When the handle was opened for reading only, chunks are read concurrently
+ * with other calls of this function that hold the read lock
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
-ssize_t libewf_handle_write_buffer_at_offset(
+ssize_t libewf_handle_read_buffer_at_offset(
          libewf_handle_t *handle,
-         const void *buffer,
+         void *buffer,
          size_t buffer_size,
          off64_t offset,
          libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer_at_offset";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	off64_t current_offset                    = 0;
+	ssize_t read_count                        = 0;
+	ssize_t remaining_read_count              = 0;
 
 	if( handle == NULL )
 	{
@@ -5233,40 +6492,105 @@ ssize_t libewf_handle_write_buffer_at_offset(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->shared_chunks_cache != NULL )
+	{
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_handle->read_write_lock,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
 			 function );
 
-			goto on_error;
+			return( -1 );
+		}
+		read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+		              internal_handle,
+		              internal_handle->file_io_pool,
+		              buffer,
+		              buffer_size,
+		              offset,
+		              error );
+
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			return( -1 );
 		}
+		/* The remaining data is at or beyond the end of the media data
+		 */
+		if( ( (size_t) read_count == buffer_size )
+		 || ( (size64_t) ( offset + read_count ) >= internal_handle->media_values->media_size ) )
+		{
+			return( read_count );
+		}
+		/* The remaining data starts with a sparse, missing or corrupted chunk
+		 */
+		buffer       = &( ( (uint8_t *) buffer )[ read_count ] );
+		buffer_size -= (size_t) read_count;
+		offset      += (off64_t) read_count;
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
+#endif
+	current_offset = internal_handle->current_offset;
+
 	if( libewf_internal_handle_seek_offset(
 	     internal_handle,
 	     offset,
@@ -5282,24 +6606,26 @@ ssize_t libewf_handle_write_buffer_at_offset(
 
 		goto on_error;
 	}
-	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
+	remaining_read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+	                        internal_handle,
+	                        internal_handle->file_io_pool,
+	                        buffer,
+	                        buffer_size,
+	                        error );
 
-	if( write_count == -1 )
+	if( remaining_read_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
+		 "%s: unable to read buffer.",
 		 function );
 
 		goto on_error;
 	}
+	internal_handle->current_offset = current_offset;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -5315,9 +6641,11 @@ ssize_t libewf_handle_write_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( read_count + remaining_read_count );
 
 on_error:
+	internal_handle->current_offset = current_offset;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
@@ -5326,16 +6654,32 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves a (media) data chunk
- * Returns 1 if successful or -1 on error
+/* Retrieves a view of the (media) data of the chunk at a specific offset
+ * The view references the cached chunk data instead of copying it and remains
+ * valid until it is released with libewf_handle_release_chunk_view
+ * The data points to the offset in the chunk and the data size contains
+ * the number of bytes from the offset to the end of the chunk
+ * This function does not change the current offset
+ * Chunk views are only supported when the handle was opened for reading only
+ * and must be released before the handle is closed
+ * Chunk views of cached chunks are retrieved and released concurrently
+ * with other calls that hold the read lock
+ * Returns 1 if successful, 0 if the offset is at or beyond the end of the media data or -1 on error
  */
-int libewf_handle_get_data_chunk(
+int libewf_handle_get_chunk_view(
      libewf_handle_t *handle,
-     libewf_data_chunk_t **data_chunk,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
      libcerror_error_t **error )
 {
+	libewf_chunk_data_t *chunk_data           = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_data_chunk";
+	static char *function                     = "libewf_handle_get_chunk_view";
+	off64_t chunk_data_offset                 = 0;
+	uint64_t chunk_index                      = 0;
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -5350,228 +6694,207 @@ int libewf_handle_get_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( data_chunk == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( *data_chunk != NULL )
+	if( ( internal_handle->io_handle->access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: data chunk value already set.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: chunk views are only supported when opened for reading only.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	if( libewf_data_chunk_initialize(
-	     data_chunk,
-	     internal_handle->io_handle,
-	     internal_handle->write_io_handle,
-	     error ) != 1 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Reads a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	ssize_t read_count              = 0;
-
-	if( internal_handle == NULL )
+	if( data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid data size.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( chunk_view == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( *chunk_view != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 "%s: invalid chunk view value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
+		return( 0 );
 	}
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+	chunk_index = (uint64_t) offset / internal_handle->media_values->chunk_size;
 
-		return( -1 );
-	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES )
+	if( internal_handle->shared_chunks_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
+		if( libcthreads_read_write_lock_grab_for_read(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for reading.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		result = libewf_internal_handle_get_chunk_view_from_shared_chunks_cache(
+		          internal_handle,
+		          internal_handle->file_io_pool,
+		          offset,
+		          data,
+		          data_size,
+		          chunk_view,
+		          error );
+
+		if( libcthreads_read_write_lock_release_for_read(
+		     internal_handle->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for reading.",
+			 function );
+
+			result = -1;
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " view from shared chunks cache.",
+			 function,
+			 chunk_index );
+
+			if( *chunk_view != NULL )
+			{
+				libewf_chunk_view_free(
+				 chunk_view,
+				 NULL );
+			}
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			return( 1 );
+		}
+		/* Sparse, missing or corrupted chunks are retrieved using the read-ahead
+		 * and the chunks cache
+		 */
 	}
-	if( internal_data_chunk == NULL )
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-	{
-		return( 0 );
-	}
-/* TODO remove need to calculate */
-	internal_handle->current_chunk_index = internal_handle->current_offset
-	                                     / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
-	                                * (off64_t) internal_handle->media_values->chunk_size;
-
-	if( libewf_chunk_table_get_chunk_data_by_offset(
-	     internal_handle->chunk_table,
-	     internal_handle->current_chunk_index,
-	     internal_handle->io_handle,
-	     file_io_pool,
-	     internal_handle->media_values,
-	     internal_handle->segment_table,
-	     internal_handle->chunk_groups_cache,
-	     internal_handle->chunks_cache,
-	     internal_handle->current_offset,
+#endif
+	if( libewf_internal_handle_get_chunk_data_at_offset(
+	     internal_handle,
+	     internal_handle->file_io_pool,
+	     offset,
+	     chunk_index,
 	     &chunk_data,
 	     &chunk_data_offset,
 	     error ) != 1 )
@@ -5582,58 +6905,92 @@ ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
 		 function,
-		 internal_handle->current_chunk_index );
+		 chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( chunk_data == NULL )
+	if( ( chunk_data_offset < 0 )
+	 || ( (size_t) chunk_data_offset > chunk_data->data_size ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk: %" PRIu64 " data.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
 		 function,
-		 internal_handle->current_chunk_index );
+		 chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	read_count = (ssize_t) chunk_data->data_size;
+	if( (size_t) chunk_data_offset < chunk_data->data_size )
+	{
+		/* The chunk view references the chunk data so that it is not freed
+		 * when it is removed from the read-ahead or the chunks cache
+		 */
+		if( libewf_chunk_view_initialize(
+		     chunk_view,
+		     chunk_index,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " view.",
+			 function,
+			 chunk_index );
 
-	if( libewf_internal_data_chunk_set_chunk_data(
-	     internal_data_chunk,
-	     internal_handle->current_chunk_index,
-	     chunk_data,
+			goto on_error;
+		}
+		*data      = &( ( chunk_data->data )[ chunk_data_offset ] );
+		*data_size = chunk_data->data_size - (size_t) chunk_data_offset;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
-		 function,
-		 internal_handle->current_chunk_index );
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle->current_offset += read_count;
-
-	internal_handle->current_chunk_index++;
+#endif
+	return( result );
 
-	return( read_count );
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	if( *chunk_view != NULL )
+	{
+		libewf_chunk_view_free(
+		 chunk_view,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Reads a (media) data chunk at the current offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Releases a chunk view retrieved with libewf_handle_get_chunk_view
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_release_chunk_view(
+     libewf_handle_t *handle,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_data_chunk";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libewf_handle_release_chunk_view";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -5648,18 +7005,32 @@ ssize_t libewf_handle_read_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+#elif defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -5674,24 +7045,34 @@ ssize_t libewf_handle_read_data_chunk(
 		return( -1 );
 	}
 #endif
-	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              (libewf_internal_data_chunk_t *) data_chunk,
-	              error );
+	if( libewf_chunk_view_free(
+	     chunk_view,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk view.",
+		 function );
 
-	if( read_count < 0 )
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) && defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		read_count = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+#elif defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -5706,23 +7087,31 @@ ssize_t libewf_handle_read_data_chunk(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Writes a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Writes the chunks packed by the chunk packer using a Basic File IO (bfio) pool
+ * The chunks are written in the order they were pushed onto the chunk packer
+ * Waits for chunks to be packed while more than the maximum number of chunks are pending
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
  */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+ssize_t libewf_internal_handle_write_packed_chunks_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
+         int maximum_number_of_pending_chunks,
          libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size      = 0;
-	ssize_t write_count   = 0;
-	int chunk_exists      = 0;
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_write_packed_chunks_to_file_io_pool";
+	size_t input_data_size          = 0;
+	ssize_t total_write_count       = 0;
+	ssize_t write_count             = 0;
+	uint64_t chunk_index            = 0;
+	uint8_t wait_for_chunk          = 0;
+	int result                      = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -5735,24 +7124,144 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->chunk_packer == NULL )
+	{
+		return( 0 );
+	}
+	while( internal_handle->chunk_packer->number_of_pending_chunks > 0 )
+	{
+		if( internal_handle->chunk_packer->number_of_pending_chunks > maximum_number_of_pending_chunks )
+		{
+			wait_for_chunk = 1;
+		}
+		else
+		{
+			wait_for_chunk = 0;
+		}
+		result = libewf_chunk_packer_pop_packed_chunk(
+		          internal_handle->chunk_packer,
+		          wait_for_chunk,
+		          &chunk_index,
+		          &chunk_data,
+		          &input_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve packed chunk from chunk packer.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               file_io_pool,
+		               internal_handle->media_values,
+		               internal_handle->segment_table,
+		               internal_handle->header_values,
+		               internal_handle->hash_values,
+		               internal_handle->hash_sections,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               chunk_index,
+		               chunk_data,
+		               input_data_size,
+		               error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		total_write_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	return( total_write_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function             = "libewf_internal_handle_write_buffer_to_file_io_pool";
+	off64_t chunk_data_offset         = 0;
+	size_t buffer_offset              = 0;
+	size_t input_data_size            = 0;
+	size_t write_size                 = 0;
+	ssize_t write_count               = 0;
+	uint64_t chunk_index              = 0;
+	uint64_t number_of_chunks_written = 0;
+	int write_chunk                   = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
@@ -5768,6 +7277,21 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
@@ -5801,131 +7325,366 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_data_chunk == NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	data_size = internal_data_chunk->data_size;
-
-	if( internal_handle->media_values->media_size != 0 )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
-		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: last data chunk size value out of bounds.",
-			 function );
-
-			return( -1 );
-		}
-	}
-/* TODO remove need to calculate */
-	internal_handle->current_chunk_index = internal_handle->current_offset
-	                                     / internal_handle->media_values->chunk_size;
-
-	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
-	                                * (off64_t) internal_handle->media_values->chunk_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
-		 function,
-		 internal_handle->current_chunk_index,
-		 data_size );
+		return( -1 );
 	}
-#endif
-	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-	                internal_handle->chunk_table,
-	                internal_handle->current_chunk_index,
-	                file_io_pool,
-	                internal_handle->segment_table,
-	                internal_handle->chunk_groups_cache,
-	                internal_handle->current_offset,
-			error );
-
-	if( chunk_exists == -1 )
+	if( internal_handle->current_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
-		 function,
-		 internal_handle->current_chunk_index );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
 
 		return( -1 );
 	}
-	else if( chunk_exists != 0 )
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: chunk: %" PRIu64 " already exists.",
-		 function,
-		 internal_handle->current_chunk_index );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
 
 		return( -1 );
 	}
-	write_count = libewf_write_io_handle_write_new_chunk(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               file_io_pool,
-	               internal_handle->media_values,
-	               internal_handle->segment_table,
-	               internal_handle->header_values,
-	               internal_handle->hash_values,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->tracks,
-	               internal_handle->acquiry_errors,
-	               internal_handle->current_chunk_index,
-	               internal_data_chunk->chunk_data,
-	               data_size,
-	               error );
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
 
-	if( write_count < 0 )
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset += (off64_t) data_size;
+	while( buffer_size > 0 )
+	{
+		number_of_chunks_written = internal_handle->write_io_handle->number_of_chunks_written;
 
-	return( write_count );
-}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->chunk_packer != NULL )
+		{
+			number_of_chunks_written += internal_handle->chunk_packer->number_of_pending_chunks;
+		}
+#endif
+		if( chunk_index < number_of_chunks_written )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already set.",
+			 function,
+			 chunk_index );
 
-/* Writes a (media) data chunk at the current offset
+			return( -1 );
+		}
+		if( internal_handle->write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			if( libewf_chunk_data_initialize(
+			     &( internal_handle->chunk_data ),
+			     internal_handle->media_values->chunk_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk offset exceeds chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+		{
+			write_chunk = 1;
+		}
+		else if( ( internal_handle->media_values->media_size != 0 )
+		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		{
+			write_chunk = 1;
+		}
+		else
+		{
+			write_chunk = 0;
+		}
+		if( write_chunk != 0 )
+		{
+			input_data_size = internal_handle->chunk_data->data_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( ( internal_handle->chunk_packer == NULL )
+			 && ( internal_handle->number_of_threads > 0 ) )
+			{
+				if( libewf_chunk_packer_initialize(
+				     &( internal_handle->chunk_packer ),
+				     internal_handle->io_handle,
+				     internal_handle->write_io_handle,
+				     internal_handle->number_of_threads,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk packer.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( internal_handle->chunk_packer != NULL )
+			{
+				/* Make room for the chunk by writing the first pending chunk
+				 */
+				write_count = libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+				               internal_handle,
+				               file_io_pool,
+				               internal_handle->chunk_packer->number_of_entries - 1,
+				               error );
+
+				if( write_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write packed chunks.",
+					 function );
+
+					return( -1 );
+				}
+				if( libewf_chunk_packer_push_chunk(
+				     internal_handle->chunk_packer,
+				     chunk_index,
+				     internal_handle->chunk_data,
+				     input_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push chunk: %" PRIu64 " onto chunk packer.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				/* The chunk packer takes over management of chunk_data
+				 */
+				internal_handle->chunk_data = NULL;
+
+				write_count = libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+				               internal_handle,
+				               file_io_pool,
+				               internal_handle->chunk_packer->number_of_entries,
+				               error );
+
+				if( write_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write packed chunks.",
+					 function );
+
+					return( -1 );
+				}
+			}
+#endif
+			if( internal_handle->chunk_data != NULL )
+			{
+				if( libewf_chunk_data_pack(
+				     internal_handle->chunk_data,
+				     internal_handle->io_handle,
+				     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+				     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+				     internal_handle->write_io_handle->pack_flags,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to pack chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				write_count = libewf_write_io_handle_write_new_chunk(
+				               internal_handle->write_io_handle,
+				               internal_handle->io_handle,
+				               file_io_pool,
+				               internal_handle->media_values,
+				               internal_handle->segment_table,
+				               internal_handle->header_values,
+				               internal_handle->hash_values,
+				               internal_handle->hash_sections,
+				               internal_handle->sessions,
+				               internal_handle->tracks,
+				               internal_handle->acquiry_errors,
+				               chunk_index,
+				               internal_handle->chunk_data,
+				               input_data_size,
+				               error );
+
+				if( write_count <= 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write new chunk.",
+					 function );
+
+					return( -1 );
+				}
+				if( libewf_chunk_data_free(
+				     &( internal_handle->chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
  * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
  */
-ssize_t libewf_handle_write_data_chunk(
+ssize_t libewf_handle_write_buffer(
          libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
+         const void *buffer,
+         size_t buffer_size,
          libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_data_chunk";
+	static char *function                     = "libewf_handle_write_buffer";
 	ssize_t write_count                       = 0;
 
 	if( handle == NULL )
@@ -5967,22 +7726,42 @@ ssize_t libewf_handle_write_data_chunk(
 		return( -1 );
 	}
 #endif
-	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
 	               internal_handle,
 	               internal_handle->file_io_pool,
-	               (libewf_internal_data_chunk_t *) data_chunk,
+	               buffer,
+	               buffer_size,
 	               error );
 
-	if( write_count < 0 )
+	if( write_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data chunk.",
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
 		 function );
 
-		write_count = -1;
+		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6000,30 +7779,33 @@ ssize_t libewf_handle_write_data_chunk(
 	}
 #endif
 	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
  */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int chunk_exists                    = 0;
-	int file_io_pool_entry              = -1;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6034,54 +7816,136 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
 	{
-		if( internal_handle->chunk_data != NULL )
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves a (media) data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_data_chunk(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_chunk";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
 	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
@@ -6093,310 +7957,1117 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( data_chunk == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
+	if( *data_chunk != NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: data chunk value already set.",
+		 function );
+
+		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-				internal_handle->chunk_table,
-				chunk_index,
-				file_io_pool,
-				internal_handle->segment_table,
-				internal_handle->chunk_groups_cache,
-				internal_handle->current_offset,
-				error );
-
-		if( chunk_exists == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( chunk_exists != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		input_data_size = internal_handle->chunk_data->data_size;
-
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
 		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
-
-		if( write_count <= 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		write_finalize_count += write_count;
+	}
+	if( libewf_data_chunk_initialize(
+	     data_chunk,
+	     internal_handle->io_handle,
+	     internal_handle->write_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data chunk.",
+		 function );
 
-		if( libfcache_cache_set_value_by_index(
-		     internal_handle->chunks_cache,
-		     chunk_index % LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-		     0,
-		     internal_handle->current_offset,
-		     0,
-		     (intptr_t *) internal_handle->chunk_data,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		/* chunks_cache takes over management of chunk_data
-		 */
-		internal_handle->chunk_data = NULL;
-	}
-	/* Check if all media data has been written
-	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
-	{
-		return( write_finalize_count );
+		goto on_error;
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
-	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
-		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
-			 function );
+#endif
+	return( 1 );
 
-			return( -1 );
-		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
-			 function );
+/* Reads a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	ssize_t read_count              = 0;
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	else
+	if( internal_handle->io_handle == NULL )
 	{
-		segment_number = number_of_segments - 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
 
-			return( -1 );
-		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
 
-			return( -1 );
-		}
-		if( segment_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	/* Set segment file to the correct offset if write is resumed
-	 */
-	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
-		if( libbfio_pool_seek_offset(
-		     file_io_pool,
-		     file_io_pool_entry,
-		     internal_handle->write_io_handle->resume_segment_file_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
-			 function,
-			 internal_handle->write_io_handle->resume_segment_file_offset,
-			 segment_number );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
 
-			return( -1 );
-		}
-		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+		return( -1 );
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	if( internal_data_chunk == NULL )
 	{
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
-		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-			               segment_file,
-			               error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
 
-			if( write_count == -1 )
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+/* TODO remove need to calculate */
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+	if( libewf_chunk_table_get_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->current_chunk_index,
+	     internal_handle->io_handle,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     internal_handle->current_offset,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	read_count = (ssize_t) chunk_data->data_size;
+
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     internal_handle->current_chunk_index,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += read_count;
+
+	internal_handle->current_chunk_index++;
+
+	return( read_count );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunk";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	size_t data_size      = 0;
+	ssize_t write_count   = 0;
+	int chunk_exists      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	data_size = internal_data_chunk->data_size;
+
+	if( internal_handle->media_values->media_size != 0 )
+	{
+		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: last data chunk size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Write the pending chunks of libewf_handle_write_buffer first to preserve the chunk order
+	 */
+	if( libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+	     internal_handle,
+	     file_io_pool,
+	     0,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+/* TODO remove need to calculate */
+	internal_handle->current_chunk_index = internal_handle->current_offset
+	                                     / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) internal_handle->current_chunk_index
+	                                * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
+		 function,
+		 internal_handle->current_chunk_index,
+		 data_size );
+	}
+#endif
+	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+	                internal_handle->chunk_table,
+	                internal_handle->current_chunk_index,
+	                file_io_pool,
+	                internal_handle->segment_table,
+	                internal_handle->chunk_groups_cache,
+	                internal_handle->current_offset,
+			error );
+
+	if( chunk_exists == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	else if( chunk_exists != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 internal_handle->current_chunk_index );
+
+		return( -1 );
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               internal_handle->current_chunk_index,
+	               internal_data_chunk->chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) data_size;
+
+	return( write_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_data_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               (libewf_internal_data_chunk_t *) data_chunk,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data chunk.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	size_t input_data_size              = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	int chunk_exists                    = 0;
+	int file_io_pool_entry              = -1;
+	int result                          = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	write_count = libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+	               internal_handle,
+	               file_io_pool,
+	               0,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	write_finalize_count += write_count;
+
+#endif
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+				internal_handle->chunk_table,
+				chunk_index,
+				file_io_pool,
+				internal_handle->segment_table,
+				internal_handle->chunk_groups_cache,
+				internal_handle->current_offset,
+				error );
+
+		if( chunk_exists == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_exists != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		input_data_size = internal_handle->chunk_data->data_size;
+
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_table,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       chunk_index,
+			       internal_handle->chunk_data,
+			       input_data_size,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( internal_handle->chunk_cache_size != 0 )
+		{
+			result = libfcache_cache_set_value_by_identifier(
+			          internal_handle->chunks_cache,
+			          0,
+			          internal_handle->current_offset,
+			          0,
+			          (intptr_t *) internal_handle->chunk_data,
+			          internal_handle->chunk_data->allocated_data_size,
+			          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+			          LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+			          error );
+		}
+		else
+		{
+			result = libfcache_cache_set_value_by_index(
+			          internal_handle->chunks_cache,
+			          chunk_index % LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+			          0,
+			          internal_handle->current_offset,
+			          0,
+			          (intptr_t *) internal_handle->chunk_data,
+			          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+			          LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		/* chunks_cache takes over management of chunk_data
+		 */
+		internal_handle->chunk_data = NULL;
+	}
+	/* Write the chunk data that is pending in the write buffer
+	 */
+	if( libewf_write_io_handle_flush(
+	     internal_handle->write_io_handle,
+	     file_io_pool,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->write_io_handle->segment_file_queue_depth,
+		     internal_handle->media_values->set_identifier,
+		     &file_io_pool_entry,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	else
+	{
+		segment_number = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	/* Set segment file to the correct offset if write is resumed
+	 */
+	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	{
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     internal_handle->write_io_handle->resume_segment_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->write_io_handle->resume_segment_file_offset,
+			 segment_number );
+
+			return( -1 );
+		}
+		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	{
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+			               segment_file,
+			               error );
+
+			if( write_count == -1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -6405,124 +9076,965 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 				 "%s: unable to write chunks section end.",
 				 function );
 
-				return( -1 );
-			}
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file.\n",
-			 function );
-		}
+				return( -1 );
+			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file.\n",
+			 function );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
+
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
+		}
+		if( internal_handle->write_io_handle->device_information != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
+		}
+		if( internal_handle->write_io_handle->data_section != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
+		}
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->write_io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->write_io_handle->write_finalized = 1;
+
+	if( internal_handle->index_file_io_handle != NULL )
+	{
+		/* Failing to write the index file is not considered an error
+		 */
+		if( libewf_internal_handle_write_finalize_index_file(
+		     internal_handle,
+		     file_io_pool,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	return( write_finalize_count );
+}
+
+/* Writes the index file of finalized segment files
+ * The segment files are reopened for reading and read by a separate handle
+ * which writes the index file with the resulting layout of the segment files
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_write_finalize_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *index_handle                   = NULL;
+	libewf_internal_handle_t *internal_index_handle = NULL;
+	static char *function                           = "libewf_internal_handle_write_finalize_index_file";
+	int file_io_pool_entry                          = 0;
+	int number_of_file_io_handles                   = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->index_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing index file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_file_io_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of handles in the pool.",
+		 function );
+
+		return( -1 );
+	}
+	/* Reopening the segment files also writes any data that is buffered
+	 * before the modification times are stored in the index file
+	 */
+	for( file_io_pool_entry = 0;
+	     file_io_pool_entry < number_of_file_io_handles;
+	     file_io_pool_entry++ )
+	{
+		if( libbfio_pool_reopen(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to reopen file IO pool entry: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+	}
+	if( libewf_handle_initialize(
+	     &index_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_index_handle = (libewf_internal_handle_t *) index_handle;
+
+	/* The index handle uses the index file IO handle of the handle
+	 * without a valid index file opening the handle writes the index file
+	 */
+	internal_index_handle->index_file_io_handle = internal_handle->index_file_io_handle;
+
+	if( libewf_handle_open_file_io_pool(
+	     index_handle,
+	     file_io_pool,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     index_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index handle.",
+		 function );
+
+		goto on_error;
+	}
+	internal_index_handle->index_file_io_handle = NULL;
+
+	if( libewf_handle_free(
+	     &index_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free index handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( index_handle != NULL )
+	{
+		internal_index_handle->index_file_io_handle = NULL;
+
+		libewf_handle_free(
+		 &index_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_finalize_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write finalize.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
 #endif
-		write_count = libewf_segment_file_write_close(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
+	*offset = internal_handle->current_offset;
 
-		if( write_count == -1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		result = libbfio_pool_set_maximum_number_of_open_handles(
+		          internal_handle->file_io_pool,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool.",
 			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum size of the chunk cache in bytes
+ * A value of 0 represents the default chunk cache that is bounded by the number of chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t *chunk_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_cache_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( chunk_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*chunk_cache_size = internal_handle->chunk_cache_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the chunk cache in bytes
+ * The chunk cache retains the least recently used chunks up to
+ * the maximum size, a value of 0 restores the default chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t chunk_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_chunk_cache_size";
+	int result                                = 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	size64_t maximum_cache_size               = 0;
+#endif
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( chunk_cache_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk cache size value exceeds maximum.",
+		 function );
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+		return( -1 );
 	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-		/* Flush the section write caches
+		return( -1 );
+	}
+	if( internal_handle->shared_chunks_cache != NULL )
+	{
+		/* When opened read-only the chunk cache size applies to the shared chunks cache
 		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
+		maximum_cache_size = chunk_cache_size;
 
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
-		}
-		if( internal_handle->write_io_handle->device_information != NULL )
+		if( maximum_cache_size == 0 )
 		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
-
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
+			maximum_cache_size = (size64_t) LIBEWF_MAXIMUM_CACHE_ENTRIES_SHARED_CHUNKS * internal_handle->media_values->chunk_size;
 		}
-		if( internal_handle->write_io_handle->data_section != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
+		result = libewf_shared_chunks_cache_set_maximum_size(
+		          internal_handle->shared_chunks_cache,
+		          maximum_cache_size,
+		          error );
 
-			internal_handle->write_io_handle->data_section = NULL;
-		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of shared chunks cache.",
 			 function );
+		}
+	}
+	else
+#endif
+	if( internal_handle->chunks_cache != NULL )
+	{
+		if( ( internal_handle->chunk_cache_size != 0 )
+		 && ( chunk_cache_size != 0 ) )
+		{
+			result = libfcache_cache_set_maximum_size(
+			          internal_handle->chunks_cache,
+			          chunk_cache_size,
+			          error );
 
-			return( -1 );
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum size of chunks cache.",
+				 function );
+			}
+		}
+		else
+		{
+			/* The chunks cache is replaced when switching between
+			 * a cache bounded by size and the default chunks cache
+			 */
+			result = libfcache_cache_free(
+			          &( internal_handle->chunks_cache ),
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunks cache.",
+				 function );
+			}
+			else
+			{
+				if( chunk_cache_size != 0 )
+				{
+					result = libfcache_cache_initialize_with_maximum_size(
+					          &( internal_handle->chunks_cache ),
+					          chunk_cache_size,
+					          error );
+				}
+				else
+				{
+					result = libfcache_cache_initialize(
+					          &( internal_handle->chunks_cache ),
+					          LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+					          error );
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunks cache.",
+					 function );
+				}
+			}
 		}
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
+	if( result == 1 )
+	{
+		internal_handle->chunk_cache_size = chunk_cache_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-	return( write_finalize_count );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Sets the number of chunks to read ahead on sequential reads
+ * The chunks read ahead are unpacked by the threads set with
+ * libewf_handle_set_number_of_threads, a value of 0 disables the read-ahead
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         libcerror_error_t **error )
+int libewf_handle_set_read_ahead(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_set_read_ahead";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6537,13 +10049,24 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( number_of_chunks < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of chunks value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks > LIBEWF_MAXIMUM_READ_AHEAD_CHUNKS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of chunks value exceeds maximum.",
 		 function );
 
 		return( -1 );
@@ -6562,22 +10085,28 @@ ssize_t libewf_handle_write_finalize(
 
 		return( -1 );
 	}
-#endif
-	write_count = libewf_internal_handle_write_finalize_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               error );
-
-	if( write_count == -1 )
+	/* The read-ahead is recreated on the next read
+	 */
+	if( internal_handle->read_ahead != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write finalize.",
-		 function );
+		result = libewf_read_ahead_free(
+		          &( internal_handle->read_ahead ),
+		          error );
 
-		write_count = -1;
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+		}
+	}
+#endif
+	if( result == 1 )
+	{
+		internal_handle->read_ahead_number_of_chunks = number_of_chunks;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6594,22 +10123,26 @@ ssize_t libewf_handle_write_finalize(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Sets the number of threads used to unpack the chunks read ahead
+ * and to pack the chunks written by libewf_handle_write_buffer
+ * The packed chunks are written in order by the calling thread
+ * and the segment files are written with concurrent io_uring writes
+ * A value of 0 disables the additional threads
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_internal_handle_seek_offset(
-         libewf_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_seek_offset";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_threads";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6620,120 +10153,176 @@ off64_t libewf_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read-ahead is recreated on the next read
+	 */
+	if( internal_handle->read_ahead != NULL )
+	{
+		result = libewf_read_ahead_free(
+		          &( internal_handle->read_ahead ),
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->number_of_threads = number_of_threads;
+
+		/* The segment files created after this call are written with concurrent writes when threads are used
+		 */
+		if( internal_handle->write_io_handle != NULL )
+		{
+			if( number_of_threads > 0 )
+			{
+				internal_handle->write_io_handle->segment_file_queue_depth = LIBEWF_SEGMENT_FILE_WRITE_QUEUE_DEPTH;
+			}
+			else
+			{
+				internal_handle->write_io_handle->segment_file_queue_depth = 0;
+			}
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#else
+	if( number_of_threads != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#endif
+	return( result );
+}
+
+/* Sets the filename of the index file
+ * The index file is read when the handle is opened for reading and
+ * is (re)written when it is missing or no longer matches the segment files
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_index_filename";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
-	}
-#endif
-	if( offset < 0 )
+	if( filename_length == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid filename length is zero.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
-}
-
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
- */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
-
-	if( handle == NULL )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
@@ -6747,23 +10336,29 @@ off64_t libewf_handle_seek_offset(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	offset = libewf_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
+	if( internal_handle->index_file_io_handle != NULL )
+	{
+		result = libbfio_handle_free(
+		          &( internal_handle->index_file_io_handle ),
+		          error );
 
-	if( offset == -1 )
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file IO handle.",
+			 function );
+		}
+	}
+	if( result == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		internal_handle->index_file_io_handle = file_io_handle;
+		file_io_handle                        = NULL;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -6777,22 +10372,40 @@ off64_t libewf_handle_seek_offset(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	return( offset );
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the current offset of the (media) data
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the filename of the index file
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_set_index_filename_wide(
      libewf_handle_t *handle,
-     off64_t *offset,
+     const wchar_t *filename,
+     size_t filename_length,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle          = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_set_index_filename_wide";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6807,19 +10420,58 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid filename length is zero.",
 		 function );
 
 		return( -1 );
 	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6827,16 +10479,35 @@ int libewf_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	if( internal_handle->index_file_io_handle != NULL )
+	{
+		result = libbfio_handle_free(
+		          &( internal_handle->index_file_io_handle ),
+		          error );
 
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file IO handle.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->index_file_io_handle = file_io_handle;
+		file_io_handle                        = NULL;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6844,26 +10515,43 @@ int libewf_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
 	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the value to indicate the segment files should be read on demand
+ * When set only the first and last segment files are read when the handle
+ * is opened for reading, the other segment files are read the first time
+ * the storage media data they contain is accessed
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_set_read_segment_files_on_demand(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     uint8_t read_on_demand,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
-	int result                                = 1;
+	static char *function                     = "libewf_handle_set_read_segment_files_on_demand";
 
 	if( handle == NULL )
 	{
@@ -6893,27 +10581,8 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	if( internal_handle->file_io_pool != NULL )
-	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->file_io_pool,
-		          maximum_number_of_open_handles,
-		          error );
+	internal_handle->read_segment_files_on_demand = read_on_demand;
 
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO pool.",
-			 function );
-		}
-	}
-	if( result == 1 )
-	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -6929,7 +10598,7 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
 }
 
 /* Determine if the segment files are corrupted
@@ -8880,6 +12549,7 @@ int libewf_internal_handle_get_file_entry_by_utf8_path(
 			return( -1 );
 		}
 		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+			  internal_handle->single_files,
 			  node,
 			  utf8_string_segment,
 			  utf8_string_segment_length,
@@ -9165,6 +12835,7 @@ int libewf_internal_handle_get_file_entry_by_utf16_path(
 			return( -1 );
 		}
 		result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+			  internal_handle->single_files,
 			  node,
 			  utf16_string_segment,
 			  utf16_string_segment_length,
@@ -27,10 +27,12 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_packer.h"
 #include "libewf_chunk_table.h"
 #include "libewf_data_chunk.h"
 #include "libewf_extern.h"
 #include "libewf_hash_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -40,8 +42,10 @@
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_read_ahead.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_table.h"
+#include "libewf_shared_chunks_cache.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
 #include "libewf_write_io_handle.h"
@@ -118,6 +122,32 @@ struct libewf_internal_handle
 	 */
 	libfcache_cache_t *chunks_cache;
 
+	/* The maximum size of the chunks cache in bytes
+	 * A value of 0 represents the default chunks cache that
+	 * is bounded by the number of chunks
+	 */
+	size64_t chunk_cache_size;
+
+	/* The number of chunks to read ahead
+	 * A value of 0 represents no read-ahead
+	 */
+	int read_ahead_number_of_chunks;
+
+	/* The number of threads used to unpack chunks that are read ahead
+	 * and to pack chunks that are written
+	 * A value of 0 represents no additional threads
+	 */
+	int number_of_threads;
+
+	/* The index file IO handle
+	 * A value of NULL represents no index file
+	 */
+	libbfio_handle_t *index_file_io_handle;
+
+	/* Value to indicate the segment files should be read on demand
+	 */
+	uint8_t read_segment_files_on_demand;
+
 	/* The current chunk data
 	 */
 	libewf_chunk_data_t *chunk_data;
@@ -151,6 +181,23 @@ struct libewf_internal_handle
 	libewf_single_files_t *single_files;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunk read-ahead
+	 */
+	libewf_read_ahead_t *read_ahead;
+
+	/* The chunk packer
+	 */
+	libewf_chunk_packer_t *chunk_packer;
+
+	/* The chunks cache shared by concurrent reads
+	 */
+	libewf_shared_chunks_cache_t *shared_chunks_cache;
+
+	/* The chunk table mutex
+	 * Serializes the chunk data range lookups of concurrent reads
+	 */
+	libcthreads_mutex_t *chunk_table_mutex;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
@@ -209,6 +256,23 @@ int libewf_internal_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_segment_file_modification_time(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t *modification_time,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_write_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libewf_index_file_t *index_file,
      libcerror_error_t **error );
 
 int libewf_internal_handle_open_file_io_pool(
@@ -230,6 +294,15 @@ int libewf_handle_close(
      libewf_handle_t *handle,
      libcerror_error_t **error );
 
+int libewf_internal_handle_get_chunk_data_at_offset(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     uint64_t end_chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -244,6 +317,31 @@ ssize_t libewf_handle_read_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES )
+
+int libewf_internal_handle_get_chunk_view_from_shared_chunks_cache(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_CHUNK_DATA_ATOMIC_REFERENCES ) */
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_read_buffer_at_offset(
          libewf_handle_t *handle,
@@ -252,6 +350,29 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_release_chunk_view(
+     libewf_handle_t *handle,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+ssize_t libewf_internal_handle_write_packed_chunks_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         int maximum_number_of_pending_chunks,
+         libcerror_error_t **error );
+#endif
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -309,6 +430,11 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
          libbfio_pool_t *file_io_pool,
          libcerror_error_t **error );
 
+int libewf_internal_handle_write_finalize_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_write_finalize(
          libewf_handle_t *handle,
@@ -339,6 +465,54 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t *chunk_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t chunk_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_segment_files_on_demand(
+     libewf_handle_t *handle,
+     uint8_t read_on_demand,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
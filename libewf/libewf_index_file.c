@@ -0,0 +1,1275 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_definitions.h"
+#include "libewf_index_file.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libfdata.h"
+#include "libewf_segment_file.h"
+
+#include "ewf_index.h"
+#include "ewf_section.h"
+
+const uint8_t ewf_index_file_signature[ 8 ] = { 0x45, 0x57, 0x46, 0x49, 0x0d, 0x0a, 0x1a, 0x00 };
+
+/* Creates an index file
+ * Make sure the value index_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_initialize";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_file = memory_allocate_structure(
+	               libewf_index_file_t );
+
+	if( *index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_file,
+	     0,
+	     sizeof( libewf_index_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index_file != NULL )
+	{
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_free";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		if( ( *index_file )->segment_data_offsets != NULL )
+		{
+			memory_free(
+			 ( *index_file )->segment_data_offsets );
+		}
+		if( ( *index_file )->data != NULL )
+		{
+			memory_free(
+			 ( *index_file )->data );
+		}
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the index file data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_resize_data(
+     libewf_index_file_t *index_file,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	void *reallocation           = NULL;
+	static char *function        = "libewf_index_file_resize_data";
+	size_t allocated_data_size   = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) LIBEWF_MAXIMUM_INDEX_FILE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size <= index_file->allocated_data_size )
+	{
+		return( 1 );
+	}
+	/* Grow the data by at least half of its size to limit
+	 * the number of reallocations when appending segments
+	 */
+	allocated_data_size = index_file->allocated_data_size + ( index_file->allocated_data_size / 2 );
+
+	if( allocated_data_size < data_size )
+	{
+		allocated_data_size = data_size;
+	}
+	if( allocated_data_size > (size_t) LIBEWF_MAXIMUM_INDEX_FILE_SIZE )
+	{
+		allocated_data_size = (size_t) LIBEWF_MAXIMUM_INDEX_FILE_SIZE;
+	}
+	reallocation = memory_reallocate(
+	                index_file->data,
+	                sizeof( uint8_t ) * allocated_data_size );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize data.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->data                = (uint8_t *) reallocation;
+	index_file->allocated_data_size = allocated_data_size;
+
+	return( 1 );
+}
+
+/* Reads the index file using a Basic File IO (bfio) handle
+ * The file IO handle must be opened for reading
+ * Returns 1 if successful, 0 if the index file is not valid or -1 on error
+ */
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_index_segment_t *index_segment = NULL;
+	static char *function              = "libewf_index_file_read_file_io_handle";
+	size64_t file_size                 = 0;
+	size_t data_offset                 = 0;
+	size_t data_size                   = 0;
+	size_t segment_data_size           = 0;
+	ssize_t read_count                 = 0;
+	uint32_t calculated_checksum       = 0;
+	uint32_t format_version            = 0;
+	uint32_t number_of_chunk_groups    = 0;
+	uint32_t number_of_sections        = 0;
+	uint32_t segment_index             = 0;
+	uint32_t segment_number            = 0;
+	uint32_t stored_checksum           = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_size < (size64_t) ( sizeof( ewf_index_file_header_t ) + sizeof( ewf_index_file_footer_t ) ) )
+	 || ( file_size > (size64_t) LIBEWF_MAXIMUM_INDEX_FILE_SIZE ) )
+	{
+		return( 0 );
+	}
+	data_size = (size_t) file_size;
+
+	if( libewf_index_file_resize_data(
+	     index_file,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize index file data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The entire index file is read at once
+	 */
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek index file start.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              index_file->data,
+	              data_size,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file data.",
+		 function );
+
+		goto on_error;
+	}
+	data_size -= sizeof( ewf_index_file_footer_t );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_footer_t *) &( index_file->data[ data_size ] ) )->checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     index_file->data,
+	     data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( stored_checksum != calculated_checksum )
+	 || ( memory_compare(
+	       ( (ewf_index_file_header_t *) index_file->data )->signature,
+	       ewf_index_file_signature,
+	       8 ) != 0 ) )
+	{
+		goto on_invalid;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) index_file->data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) index_file->data )->number_of_segments,
+	 index_file->number_of_segments );
+
+	if( ( format_version != LIBEWF_INDEX_FILE_FORMAT_VERSION )
+	 || ( index_file->number_of_segments == 0 )
+	 || ( (size_t) index_file->number_of_segments > ( data_size / sizeof( ewf_index_segment_t ) ) ) )
+	{
+		goto on_invalid;
+	}
+	index_file->segment_data_offsets = (size_t *) memory_allocate(
+	                                               sizeof( size_t ) * index_file->number_of_segments );
+
+	if( index_file->segment_data_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment data offsets.",
+		 function );
+
+		goto on_error;
+	}
+	/* Determine the offsets of the segments and make sure
+	 * the segments fill the data exactly
+	 */
+	data_offset = sizeof( ewf_index_file_header_t );
+
+	for( segment_index = 0;
+	     segment_index < index_file->number_of_segments;
+	     segment_index++ )
+	{
+		if( sizeof( ewf_index_segment_t ) > ( data_size - data_offset ) )
+		{
+			goto on_invalid;
+		}
+		index_segment = (ewf_index_segment_t *) &( index_file->data[ data_offset ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_segment->segment_number,
+		 segment_number );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_segment->number_of_sections,
+		 number_of_sections );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_segment->number_of_chunk_groups,
+		 number_of_chunk_groups );
+
+		if( ( segment_number != ( segment_index + 1 ) )
+		 || ( number_of_sections > (uint32_t) INT_MAX )
+		 || ( number_of_chunk_groups > (uint32_t) INT_MAX ) )
+		{
+			goto on_invalid;
+		}
+		segment_data_size = sizeof( ewf_index_segment_t )
+		                  + ( (size_t) number_of_sections * sizeof( ewf_index_section_t ) )
+		                  + ( (size_t) number_of_chunk_groups * sizeof( ewf_index_chunk_group_t ) );
+
+		if( segment_data_size > ( data_size - data_offset ) )
+		{
+			goto on_invalid;
+		}
+		index_file->segment_data_offsets[ segment_index ] = data_offset;
+
+		data_offset += segment_data_size;
+	}
+	if( data_offset != data_size )
+	{
+		goto on_invalid;
+	}
+	index_file->data_size = data_size;
+
+	return( 1 );
+
+on_invalid:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: invalid index file.\n",
+		 function );
+	}
+#endif
+	if( index_file->segment_data_offsets != NULL )
+	{
+		memory_free(
+		 index_file->segment_data_offsets );
+
+		index_file->segment_data_offsets = NULL;
+	}
+	index_file->number_of_segments = 0;
+	index_file->data_size          = 0;
+
+	return( 0 );
+
+on_error:
+	if( index_file->segment_data_offsets != NULL )
+	{
+		memory_free(
+		 index_file->segment_data_offsets );
+
+		index_file->segment_data_offsets = NULL;
+	}
+	index_file->number_of_segments = 0;
+	index_file->data_size          = 0;
+
+	return( -1 );
+}
+
+/* Writes the index file using a Basic File IO (bfio) handle
+ * The file IO handle must be opened for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_index_file_footer_t index_file_footer;
+
+	static char *function = "libewf_index_file_write_file_io_handle";
+	ssize_t write_count   = 0;
+	uint32_t checksum     = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( index_file->data == NULL )
+	 || ( index_file->number_of_segments == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index file - missing segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( (ewf_index_file_header_t *) index_file->data )->signature,
+	     ewf_index_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) index_file->data )->format_version,
+	 LIBEWF_INDEX_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) index_file->data )->number_of_segments,
+	 index_file->number_of_segments );
+
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     index_file->data,
+	     index_file->data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 index_file_footer.checksum,
+	 checksum );
+
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               index_file->data,
+	               index_file->data_size,
+	               error );
+
+	if( write_count != (ssize_t) index_file->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file data.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               (uint8_t *) &index_file_footer,
+	               sizeof( ewf_index_file_footer_t ),
+	               error );
+
+	if( write_count != (ssize_t) sizeof( ewf_index_file_footer_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file footer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends the layout of a segment file to the index file
+ * The segments must be appended in order of their segment number
+ * A segment file modification time of 0 represents that it is not available
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_append_segment_file(
+     libewf_index_file_t *index_file,
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     uint64_t segment_file_modification_time,
+     libcerror_error_t **error )
+{
+	ewf_index_chunk_group_t *index_chunk_group = NULL;
+	ewf_index_section_t *index_section         = NULL;
+	ewf_index_segment_t *index_segment         = NULL;
+	static char *function                      = "libewf_index_file_append_segment_file";
+	size64_t element_size                      = 0;
+	size64_t mapped_size                       = 0;
+	size_t data_offset                         = 0;
+	size_t data_size                           = 0;
+	off64_t element_offset                     = 0;
+	uint32_t element_flags                     = 0;
+	int element_file_index                     = 0;
+	int element_index                          = 0;
+	int number_of_chunk_groups                 = 0;
+	int number_of_sections                     = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->segment_data_offsets != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file - segment data offsets value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->segment_number != ( index_file->number_of_segments + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment number: %" PRIu32 ".",
+		 function,
+		 segment_file->segment_number );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sections.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk groups.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = index_file->data_size;
+
+	if( data_offset == 0 )
+	{
+		data_offset = sizeof( ewf_index_file_header_t );
+	}
+	data_size = data_offset
+	          + sizeof( ewf_index_segment_t )
+	          + ( (size_t) number_of_sections * sizeof( ewf_index_section_t ) )
+	          + ( (size_t) number_of_chunk_groups * sizeof( ewf_index_chunk_group_t ) );
+
+	if( libewf_index_file_resize_data(
+	     index_file,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize index file data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &( index_file->data[ data_offset ] ),
+	     0,
+	     data_size - data_offset ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment data.",
+		 function );
+
+		return( -1 );
+	}
+	index_segment = (ewf_index_segment_t *) &( index_file->data[ data_offset ] );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->segment_file_size,
+	 segment_file_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->segment_file_modification_time,
+	 segment_file_modification_time );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_segment->segment_number,
+	 segment_file->segment_number );
+
+	index_segment->type          = segment_file->type;
+	index_segment->major_version = segment_file->major_version;
+	index_segment->minor_version = segment_file->minor_version;
+	index_segment->flags         = segment_file->flags;
+
+	byte_stream_copy_from_uint16_little_endian(
+	 index_segment->compression_method,
+	 segment_file->compression_method );
+
+	if( memory_copy(
+	     index_segment->set_identifier,
+	     segment_file->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->current_offset,
+	 segment_file->current_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->last_section_offset,
+	 segment_file->last_section_offset );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_segment->device_information_section_index,
+	 segment_file->device_information_section_index );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_segment->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 index_segment->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->storage_media_size,
+	 segment_file->storage_media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->number_of_chunks,
+	 segment_file->number_of_chunks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->previous_last_chunk_filled,
+	 segment_file->previous_last_chunk_filled );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->last_chunk_filled,
+	 segment_file->last_chunk_filled );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 index_segment->last_chunk_compared,
+	 segment_file->last_chunk_compared );
+
+	data_offset += sizeof( ewf_index_segment_t );
+
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     element_index,
+		     &element_file_index,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		index_section = (ewf_index_section_t *) &( index_file->data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_section->offset,
+		 element_offset );
+
+		data_offset += sizeof( ewf_index_section_t );
+	}
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     element_index,
+		     &element_file_index,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group: %d.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		index_chunk_group = (ewf_index_chunk_group_t *) &( index_file->data[ data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->offset,
+		 element_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->size,
+		 element_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 index_chunk_group->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 index_chunk_group->range_flags,
+		 element_flags );
+
+		data_offset += sizeof( ewf_index_chunk_group_t );
+	}
+	index_file->data_size           = data_size;
+	index_file->number_of_segments += 1;
+
+	return( 1 );
+}
+
+/* Compares the segment file header values, the segment file size and modification time with the index file
+ * A segment file modification time of 0 represents that it is not available
+ * Returns 1 if the segment matches, 0 if not or -1 on error
+ */
+int libewf_index_file_compare_segment_file(
+     libewf_index_file_t *index_file,
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     uint64_t segment_file_modification_time,
+     libcerror_error_t **error )
+{
+	ewf_index_segment_t *index_segment = NULL;
+	static char *function              = "libewf_index_file_compare_segment_file";
+	uint64_t value_64bit               = 0;
+	uint16_t value_16bit               = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_file->segment_data_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid index file - missing segment data offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->segment_number == 0 )
+	 || ( segment_file->segment_number > index_file->number_of_segments ) )
+	{
+		return( 0 );
+	}
+	index_segment = (ewf_index_segment_t *) &( index_file->data[ index_file->segment_data_offsets[ segment_file->segment_number - 1 ] ] );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->segment_file_size,
+	 value_64bit );
+
+	if( value_64bit != (uint64_t) segment_file_size )
+	{
+		return( 0 );
+	}
+	/* A segment file that was modified after the index file was written
+	 * can have the same size but a different layout
+	 */
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->segment_file_modification_time,
+	 value_64bit );
+
+	if( value_64bit != segment_file_modification_time )
+	{
+		return( 0 );
+	}
+	/* The segment file type of EWF-S01 is only determined when the segments are read
+	 */
+	if( ( index_segment->type != segment_file->type )
+	 && ( ( index_segment->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	  ||  ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) ) )
+	{
+		return( 0 );
+	}
+	if( ( index_segment->major_version != segment_file->major_version )
+	 || ( index_segment->minor_version != segment_file->minor_version ) )
+	{
+		return( 0 );
+	}
+	if( segment_file->major_version == 2 )
+	{
+		byte_stream_copy_to_uint16_little_endian(
+		 index_segment->compression_method,
+		 value_16bit );
+
+		if( value_16bit != segment_file->compression_method )
+		{
+			return( 0 );
+		}
+		if( memory_compare(
+		     index_segment->set_identifier,
+		     segment_file->set_identifier,
+		     16 ) != 0 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Creates a segment file from the layout stored in the index file
+ * Returns 1 if successful, 0 if the segment is not stored in the index file or -1 on error
+ */
+int libewf_index_file_get_segment_file(
+     libewf_index_file_t *index_file,
+     libewf_io_handle_t *io_handle,
+     uint32_t segment_index,
+     int file_io_pool_entry,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error )
+{
+	ewf_index_chunk_group_t *index_chunk_group = NULL;
+	ewf_index_section_t *index_section         = NULL;
+	ewf_index_segment_t *index_segment         = NULL;
+	static char *function                      = "libewf_index_file_get_segment_file";
+	size64_t element_size                      = 0;
+	size64_t mapped_size                       = 0;
+	size_t data_offset                         = 0;
+	uint64_t value_64bit                       = 0;
+	uint32_t element_flags                     = 0;
+	uint32_t number_of_chunk_groups            = 0;
+	uint32_t number_of_sections                = 0;
+	uint32_t value_32bit                       = 0;
+	off64_t element_offset                     = 0;
+	int element_index                          = 0;
+	uint32_t list_index                        = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( index_file->segment_data_offsets == NULL )
+	 || ( segment_index >= index_file->number_of_segments ) )
+	{
+		return( 0 );
+	}
+	data_offset   = index_file->segment_data_offsets[ segment_index ];
+	index_segment = (ewf_index_segment_t *) &( index_file->data[ data_offset ] );
+
+	if( ( index_segment->major_version != 1 )
+	 && ( index_segment->major_version != 2 ) )
+	{
+		return( 0 );
+	}
+	if( libewf_segment_file_initialize(
+	     segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 index_segment->segment_number,
+	 ( *segment_file )->segment_number );
+
+	( *segment_file )->type          = index_segment->type;
+	( *segment_file )->major_version = index_segment->major_version;
+	( *segment_file )->minor_version = index_segment->minor_version;
+	( *segment_file )->flags         = index_segment->flags;
+
+	byte_stream_copy_to_uint16_little_endian(
+	 index_segment->compression_method,
+	 ( *segment_file )->compression_method );
+
+	if( memory_copy(
+	     ( *segment_file )->set_identifier,
+	     index_segment->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->current_offset,
+	 value_64bit );
+
+	( *segment_file )->current_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->last_section_offset,
+	 value_64bit );
+
+	( *segment_file )->last_section_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 index_segment->device_information_section_index,
+	 value_32bit );
+
+	( *segment_file )->device_information_section_index = (int) value_32bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->storage_media_size,
+	 ( *segment_file )->storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->number_of_chunks,
+	 ( *segment_file )->number_of_chunks );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->previous_last_chunk_filled,
+	 value_64bit );
+
+	( *segment_file )->previous_last_chunk_filled = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->last_chunk_filled,
+	 value_64bit );
+
+	( *segment_file )->last_chunk_filled = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 index_segment->last_chunk_compared,
+	 value_64bit );
+
+	( *segment_file )->last_chunk_compared = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 index_segment->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 index_segment->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	if( ( *segment_file )->major_version == 1 )
+	{
+		element_size = (size64_t) sizeof( ewf_section_descriptor_v1_t );
+	}
+	else
+	{
+		element_size = (size64_t) sizeof( ewf_section_descriptor_v2_t );
+	}
+	data_offset += sizeof( ewf_index_segment_t );
+
+	for( list_index = 0;
+	     list_index < number_of_sections;
+	     list_index++ )
+	{
+		index_section = (ewf_index_section_t *) &( index_file->data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_section->offset,
+		 value_64bit );
+
+		if( libfdata_list_append_element(
+		     ( *segment_file )->sections_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     (off64_t) value_64bit,
+		     element_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section to sections list.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += sizeof( ewf_index_section_t );
+	}
+	for( list_index = 0;
+	     list_index < number_of_chunk_groups;
+	     list_index++ )
+	{
+		index_chunk_group = (ewf_index_chunk_group_t *) &( index_file->data[ data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->offset,
+		 value_64bit );
+
+		element_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->size,
+		 value_64bit );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 index_chunk_group->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 index_chunk_group->range_flags,
+		 element_flags );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     ( *segment_file )->chunk_groups_list,
+		     &( ( *segment_file )->chunk_groups_index ),
+		     file_io_pool_entry,
+		     element_offset,
+		     (size64_t) value_64bit,
+		     element_flags,
+		     mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element with mapped size to chunk groups list.",
+			 function );
+
+			goto on_error;
+		}
+		data_offset += sizeof( ewf_index_chunk_group_t );
+	}
+	return( 1 );
+
+on_error:
+	if( *segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 segment_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
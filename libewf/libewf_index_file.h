@@ -0,0 +1,115 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_FILE_H )
+#define _LIBEWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_segment_file.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t ewf_index_file_signature[ 8 ];
+
+typedef struct libewf_index_file libewf_index_file_t;
+
+struct libewf_index_file
+{
+	/* The data
+	 * Contains the file header followed by the segments
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+
+	/* The number of segments
+	 */
+	uint32_t number_of_segments;
+
+	/* The offsets of the segments in the data
+	 */
+	size_t *segment_data_offsets;
+};
+
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_resize_data(
+     libewf_index_file_t *index_file,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_append_segment_file(
+     libewf_index_file_t *index_file,
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     uint64_t segment_file_modification_time,
+     libcerror_error_t **error );
+
+int libewf_index_file_compare_segment_file(
+     libewf_index_file_t *index_file,
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     uint64_t segment_file_modification_time,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_segment_file(
+     libewf_index_file_t *index_file,
+     libewf_io_handle_t *io_handle,
+     uint32_t segment_index,
+     int file_io_pool_entry,
+     libewf_segment_file_t **segment_file,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INDEX_FILE_H ) */
+
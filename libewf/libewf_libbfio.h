@@ -31,6 +31,8 @@
 #include <libbfio_definitions.h>
 #include <libbfio_file.h>
 #include <libbfio_file_pool.h>
+#include <libbfio_file_io_uring.h>
+#include <libbfio_file_mmap.h>
 #include <libbfio_file_range.h>
 #include <libbfio_handle.h>
 #include <libbfio_memory_range.h>
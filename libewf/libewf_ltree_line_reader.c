@@ -0,0 +1,484 @@
+/*
+ * Ltree line reader functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libuna.h"
+#include "libewf_ltree_line_reader.h"
+
+/* Retrieves an UTF-16 stream value
+ */
+#define libewf_ltree_line_reader_get_utf16_value( line_reader, offset ) \
+	( ( ( line_reader )->byte_order == LIBUNA_ENDIAN_BIG ) \
+	? ( ( (uint16_t) ( line_reader )->utf16_stream[ offset ] << 8 ) | ( line_reader )->utf16_stream[ ( offset ) + 1 ] ) \
+	: ( ( (uint16_t) ( line_reader )->utf16_stream[ ( offset ) + 1 ] << 8 ) | ( line_reader )->utf16_stream[ offset ] ) )
+
+/* Creates a line reader
+ * Make sure the value line_reader is referencing, is set to NULL
+ * The UTF-16 stream is referenced by the line reader and must remain available while it is used
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_line_reader_initialize(
+     libewf_ltree_line_reader_t **line_reader,
+     const uint8_t *utf16_stream,
+     size_t utf16_stream_size,
+     int byte_order,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_ltree_line_reader_initialize";
+	size_t first_line_offset  = 0;
+	size_t utf16_stream_index = 0;
+	uint16_t utf16_value      = 0;
+	int line_has_characters   = 0;
+	int number_of_lines       = 0;
+	int read_byte_order       = 0;
+
+	if( line_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *line_reader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid line reader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_stream_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 stream size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf16_stream_size < 2 )
+	 || ( ( utf16_stream_size % 2 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: missing UTF-16 stream value.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if UTF-16 stream is in big or little endian
+	 */
+	if( ( utf16_stream[ 0 ] == 0xfe )
+	 && ( utf16_stream[ 1 ] == 0xff ) )
+	{
+		read_byte_order   = LIBUNA_ENDIAN_BIG;
+		first_line_offset = 2;
+	}
+	else if( ( utf16_stream[ 0 ] == 0xff )
+	      && ( utf16_stream[ 1 ] == 0xfe ) )
+	{
+		read_byte_order   = LIBUNA_ENDIAN_LITTLE;
+		first_line_offset = 2;
+	}
+	if( byte_order == 0 )
+	{
+		byte_order = read_byte_order;
+	}
+	if( ( byte_order != LIBUNA_ENDIAN_BIG )
+	 && ( byte_order != LIBUNA_ENDIAN_LITTLE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported byte order.",
+		 function );
+
+		return( -1 );
+	}
+	*line_reader = memory_allocate_structure(
+	                libewf_ltree_line_reader_t );
+
+	if( *line_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create line reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *line_reader,
+	     0,
+	     sizeof( libewf_ltree_line_reader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear line reader.",
+		 function );
+
+		memory_free(
+		 *line_reader );
+
+		*line_reader = NULL;
+
+		return( -1 );
+	}
+	( *line_reader )->utf16_stream      = utf16_stream;
+	( *line_reader )->utf16_stream_size = utf16_stream_size;
+	( *line_reader )->byte_order        = byte_order;
+	( *line_reader )->first_line_offset = first_line_offset;
+	( *line_reader )->next_line_offset  = first_line_offset;
+
+	/* Determine the number of lines without converting the UTF-16 stream
+	 * The lines end at the first end of string character, a trailing line
+	 * feed does not start an additional empty line
+	 */
+	utf16_stream_index = first_line_offset;
+
+	while( ( utf16_stream_index + 1 ) < utf16_stream_size )
+	{
+		utf16_value = libewf_ltree_line_reader_get_utf16_value(
+		               *line_reader,
+		               utf16_stream_index );
+
+		utf16_stream_index += 2;
+
+		if( utf16_value == 0 )
+		{
+			break;
+		}
+		if( utf16_value == (uint16_t) '\n' )
+		{
+			if( number_of_lines == INT_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of lines value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			number_of_lines++;
+
+			line_has_characters = 0;
+		}
+		else
+		{
+			/* A high surrogate is always combined with the next UTF-16 value
+			 */
+			if( ( utf16_value >= 0xd800 )
+			 && ( utf16_value <= 0xdbff ) )
+			{
+				utf16_stream_index += 2;
+			}
+			line_has_characters = 1;
+		}
+	}
+	if( line_has_characters != 0 )
+	{
+		if( number_of_lines == INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of lines value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_lines++;
+	}
+	( *line_reader )->number_of_lines = number_of_lines;
+
+	return( 1 );
+
+on_error:
+	if( *line_reader != NULL )
+	{
+		memory_free(
+		 *line_reader );
+
+		*line_reader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a line reader
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_line_reader_free(
+     libewf_ltree_line_reader_t **line_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_line_reader_free";
+
+	if( line_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *line_reader != NULL )
+	{
+		/* The UTF-16 stream is referenced and freed elsewhere
+		 */
+		if( ( *line_reader )->line_string != NULL )
+		{
+			memory_free(
+			 ( *line_reader )->line_string );
+		}
+		memory_free(
+		 *line_reader );
+
+		*line_reader = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the line reader to read from the first line
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_line_reader_rewind(
+     libewf_ltree_line_reader_t *line_reader,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_line_reader_rewind";
+
+	if( line_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line reader.",
+		 function );
+
+		return( -1 );
+	}
+	line_reader->next_line_offset = line_reader->first_line_offset;
+	line_reader->next_line_index  = 0;
+
+	return( 1 );
+}
+
+/* Reads the next line
+ * The line is converted into an UTF-8 string without the line feed
+ * The line string is owned by the line reader and remains valid until the next line is read
+ * Returns 1 if successful, 0 if no more lines are available or -1 on error
+ */
+int libewf_ltree_line_reader_read_line(
+     libewf_ltree_line_reader_t *line_reader,
+     uint8_t **line_string,
+     size_t *line_string_size,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation                        = NULL;
+	static char *function                        = "libewf_ltree_line_reader_read_line";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t allocated_line_string_size            = 0;
+	size_t string_index                          = 0;
+
+	if( line_reader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line reader.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line string.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( line_reader->next_line_index >= line_reader->number_of_lines )
+	{
+		return( 0 );
+	}
+	while( ( line_reader->next_line_offset + 1 ) < line_reader->utf16_stream_size )
+	{
+		if( libuna_unicode_character_copy_from_utf16_stream(
+		     &unicode_character,
+		     line_reader->utf16_stream,
+		     line_reader->utf16_stream_size,
+		     &( line_reader->next_line_offset ),
+		     line_reader->byte_order,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-16 stream.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( unicode_character == 0 )
+		 || ( unicode_character == (libuna_unicode_character_t) '\n' ) )
+		{
+			break;
+		}
+		/* Make sure there is room for the largest UTF-8 character and the end of string character
+		 */
+		if( ( string_index + 5 ) > line_reader->allocated_line_string_size )
+		{
+			allocated_line_string_size = line_reader->allocated_line_string_size * 2;
+
+			if( allocated_line_string_size < 256 )
+			{
+				allocated_line_string_size = 256;
+			}
+			if( allocated_line_string_size > (size_t) SSIZE_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid line string size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			reallocation = (uint8_t *) memory_reallocate(
+			                            line_reader->line_string,
+			                            sizeof( uint8_t ) * allocated_line_string_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize line string.",
+				 function );
+
+				return( -1 );
+			}
+			line_reader->line_string                = reallocation;
+			line_reader->allocated_line_string_size = allocated_line_string_size;
+		}
+		if( libuna_unicode_character_copy_to_utf8(
+		     unicode_character,
+		     line_reader->line_string,
+		     line_reader->allocated_line_string_size,
+		     &string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_OUTPUT_FAILED,
+			 "%s: unable to copy Unicode character to UTF-8 line string.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( line_reader->allocated_line_string_size == 0 )
+	{
+		line_reader->line_string = (uint8_t *) memory_allocate(
+		                                        sizeof( uint8_t ) * 256 );
+
+		if( line_reader->line_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create line string.",
+			 function );
+
+			return( -1 );
+		}
+		line_reader->allocated_line_string_size = 256;
+	}
+	line_reader->line_string[ string_index ] = 0;
+
+	line_reader->line_string_size = string_index + 1;
+	line_reader->next_line_index += 1;
+
+	*line_string      = line_reader->line_string;
+	*line_string_size = line_reader->line_string_size;
+
+	return( 1 );
+}
+
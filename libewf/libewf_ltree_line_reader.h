@@ -0,0 +1,105 @@
+/*
+ * Ltree line reader functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_LTREE_LINE_READER_H )
+#define _LIBEWF_LTREE_LINE_READER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_ltree_line_reader libewf_ltree_line_reader_t;
+
+struct libewf_ltree_line_reader
+{
+	/* The UTF-16 stream
+	 */
+	const uint8_t *utf16_stream;
+
+	/* The UTF-16 stream size
+	 */
+	size_t utf16_stream_size;
+
+	/* The byte order
+	 */
+	int byte_order;
+
+	/* The offset of the first line in the UTF-16 stream
+	 */
+	size_t first_line_offset;
+
+	/* The offset of the next line in the UTF-16 stream
+	 */
+	size_t next_line_offset;
+
+	/* The number of lines
+	 */
+	int number_of_lines;
+
+	/* The index of the next line
+	 */
+	int next_line_index;
+
+	/* The line string
+	 */
+	uint8_t *line_string;
+
+	/* The line string size
+	 */
+	size_t line_string_size;
+
+	/* The allocated line string size
+	 */
+	size_t allocated_line_string_size;
+};
+
+int libewf_ltree_line_reader_initialize(
+     libewf_ltree_line_reader_t **line_reader,
+     const uint8_t *utf16_stream,
+     size_t utf16_stream_size,
+     int byte_order,
+     libcerror_error_t **error );
+
+int libewf_ltree_line_reader_free(
+     libewf_ltree_line_reader_t **line_reader,
+     libcerror_error_t **error );
+
+int libewf_ltree_line_reader_rewind(
+     libewf_ltree_line_reader_t *line_reader,
+     libcerror_error_t **error );
+
+int libewf_ltree_line_reader_read_line(
+     libewf_ltree_line_reader_t *line_reader,
+     uint8_t **line_string,
+     size_t *line_string_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_LTREE_LINE_READER_H ) */
+
@@ -0,0 +1,426 @@
+/*
+ * Ltree segments functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_ltree_segments.h"
+
+/* Creates segments
+ * Make sure the value segments is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_segments_initialize(
+     libewf_ltree_segments_t **segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_segments_initialize";
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segments != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segments value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segments = memory_allocate_structure(
+	             libewf_ltree_segments_t );
+
+	if( *segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *segments,
+	     0,
+	     sizeof( libewf_ltree_segments_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segments.",
+		 function );
+
+		memory_free(
+		 *segments );
+
+		*segments = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Frees segments
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_segments_free(
+     libewf_ltree_segments_t **segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_segments_free";
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segments != NULL )
+	{
+		if( ( *segments )->segment_sizes != NULL )
+		{
+			memory_free(
+			 ( *segments )->segment_sizes );
+		}
+		if( ( *segments )->segment_offsets != NULL )
+		{
+			memory_free(
+			 ( *segments )->segment_offsets );
+		}
+		if( ( *segments )->string != NULL )
+		{
+			memory_free(
+			 ( *segments )->string );
+		}
+		memory_free(
+		 *segments );
+
+		*segments = NULL;
+	}
+	return( 1 );
+}
+
+/* Splits an UTF-8 string into segments
+ * The string is copied into a buffer that is reused by subsequent splits,
+ * the segments of a previous split are no longer valid after this call.
+ * The last byte of the string size is considered the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_segments_split(
+     libewf_ltree_segments_t *segments,
+     const uint8_t *utf8_string,
+     size_t utf8_string_size,
+     uint8_t delimiter,
+     libcerror_error_t **error )
+{
+	void *reallocation               = NULL;
+	static char *function            = "libewf_ltree_segments_split";
+	size_t allocated_string_size     = 0;
+	size_t segment_start             = 0;
+	size_t string_index              = 0;
+	int allocated_number_of_segments = 0;
+	int at_end_of_string             = 0;
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	segments->number_of_segments = 0;
+
+	/* An empty string has no segments
+	 */
+	if( ( utf8_string_size == 0 )
+	 || ( utf8_string[ 0 ] == 0 ) )
+	{
+		return( 1 );
+	}
+	if( utf8_string_size > segments->allocated_string_size )
+	{
+		allocated_string_size = ( utf8_string_size & ~( (size_t) 255 ) ) + 256;
+
+		reallocation = memory_reallocate(
+		                segments->string,
+		                sizeof( uint8_t ) * allocated_string_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize string.",
+			 function );
+
+			return( -1 );
+		}
+		segments->string                = (uint8_t *) reallocation;
+		segments->allocated_string_size = allocated_string_size;
+	}
+	if( memory_copy(
+	     segments->string,
+	     utf8_string,
+	     utf8_string_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy string.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < utf8_string_size;
+	     string_index++ )
+	{
+		if( ( string_index == ( utf8_string_size - 1 ) )
+		 || ( segments->string[ string_index ] == 0 ) )
+		{
+			at_end_of_string = 1;
+		}
+		else if( segments->string[ string_index ] != delimiter )
+		{
+			continue;
+		}
+		if( segments->number_of_segments >= segments->allocated_number_of_segments )
+		{
+			if( segments->allocated_number_of_segments > ( INT_MAX / 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid number of segments value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			allocated_number_of_segments = segments->allocated_number_of_segments * 2;
+
+			if( allocated_number_of_segments < 32 )
+			{
+				allocated_number_of_segments = 32;
+			}
+			reallocation = memory_reallocate(
+			                segments->segment_offsets,
+			                sizeof( size_t ) * allocated_number_of_segments );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize segment offsets.",
+				 function );
+
+				return( -1 );
+			}
+			segments->segment_offsets = (size_t *) reallocation;
+
+			reallocation = memory_reallocate(
+			                segments->segment_sizes,
+			                sizeof( size_t ) * allocated_number_of_segments );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize segment sizes.",
+				 function );
+
+				return( -1 );
+			}
+			segments->segment_sizes                = (size_t *) reallocation;
+			segments->allocated_number_of_segments = allocated_number_of_segments;
+		}
+		/* Terminate the segment in place, the segment size includes the end of string character
+		 */
+		segments->string[ string_index ] = 0;
+
+		segments->segment_offsets[ segments->number_of_segments ] = segment_start;
+		segments->segment_sizes[ segments->number_of_segments ]   = string_index - segment_start + 1;
+
+		segments->number_of_segments += 1;
+
+		if( at_end_of_string != 0 )
+		{
+			break;
+		}
+		segment_start = string_index + 1;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_segments_get_number_of_segments(
+     libewf_ltree_segments_t *segments,
+     int *number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_segments_get_number_of_segments";
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_segments = segments->number_of_segments;
+
+	return( 1 );
+}
+
+/* Retrieves a specific segment
+ * The segment string is owned by the segments and remains valid until the next split
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_ltree_segments_get_segment_by_index(
+     libewf_ltree_segments_t *segments,
+     int segment_index,
+     uint8_t **segment_string,
+     size_t *segment_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_ltree_segments_get_segment_by_index";
+
+	if( segments == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_index < 0 )
+	 || ( segment_index >= segments->number_of_segments ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment string.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment string size.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_string      = &( segments->string[ segments->segment_offsets[ segment_index ] ] );
+	*segment_string_size = segments->segment_sizes[ segment_index ];
+
+	return( 1 );
+}
+
@@ -0,0 +1,95 @@
+/*
+ * Ltree segments functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_LTREE_SEGMENTS_H )
+#define _LIBEWF_LTREE_SEGMENTS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_ltree_segments libewf_ltree_segments_t;
+
+struct libewf_ltree_segments
+{
+	/* The string that contains the segments
+	 */
+	uint8_t *string;
+
+	/* The allocated string size
+	 */
+	size_t allocated_string_size;
+
+	/* The segment offsets
+	 */
+	size_t *segment_offsets;
+
+	/* The segment sizes
+	 */
+	size_t *segment_sizes;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The allocated number of segments
+	 */
+	int allocated_number_of_segments;
+};
+
+int libewf_ltree_segments_initialize(
+     libewf_ltree_segments_t **segments,
+     libcerror_error_t **error );
+
+int libewf_ltree_segments_free(
+     libewf_ltree_segments_t **segments,
+     libcerror_error_t **error );
+
+int libewf_ltree_segments_split(
+     libewf_ltree_segments_t *segments,
+     const uint8_t *utf8_string,
+     size_t utf8_string_size,
+     uint8_t delimiter,
+     libcerror_error_t **error );
+
+int libewf_ltree_segments_get_number_of_segments(
+     libewf_ltree_segments_t *segments,
+     int *number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_ltree_segments_get_segment_by_index(
+     libewf_ltree_segments_t *segments,
+     int segment_index,
+     uint8_t **segment_string,
+     size_t *segment_string_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_LTREE_SEGMENTS_H ) */
+
@@ -0,0 +1,1194 @@
+/*
+ * Chunk read-ahead functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_media_values.h"
+#include "libewf_read_ahead.h"
+#include "libewf_segment_table.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a read-ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     libewf_io_handle_t *io_handle,
+     int number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_initialize";
+	size_t array_size     = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks <= 0 )
+	 || ( number_of_chunks >= (int) ( INT32_MAX / sizeof( libewf_read_ahead_chunk_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of threads value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libewf_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libewf_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+	array_size = sizeof( libewf_read_ahead_chunk_t ) * ( number_of_chunks + 1 );
+
+	( *read_ahead )->chunks_array = (libewf_read_ahead_chunk_t *) memory_allocate(
+	                                                               array_size );
+
+	if( ( *read_ahead )->chunks_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks array.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *read_ahead )->chunks_array,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunks array.",
+		 function );
+
+		goto on_error;
+	}
+	array_size = sizeof( libbfio_read_request_t ) * ( number_of_chunks + 1 );
+
+	( *read_ahead )->read_requests = (libbfio_read_request_t *) memory_allocate(
+	                                                             array_size );
+
+	if( ( *read_ahead )->read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *read_ahead )->read_requests,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead )->condition_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_ahead )->unpacked_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create unpacked condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_ahead )->io_handle         = io_handle;
+	( *read_ahead )->number_of_chunks  = number_of_chunks;
+	( *read_ahead )->number_of_entries = number_of_chunks + 1;
+	( *read_ahead )->last_chunk_index  = (uint64_t) -1;
+
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_ahead )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *read_ahead )->number_of_entries,
+	     (int (*)(intptr_t *, void *)) &libewf_read_ahead_unpack_chunk_callback,
+	     (void *) *read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+		if( ( *read_ahead )->unpacked_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *read_ahead )->unpacked_condition ),
+			 NULL );
+		}
+		if( ( *read_ahead )->condition_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_ahead )->condition_mutex ),
+			 NULL );
+		}
+		if( ( *read_ahead )->read_requests != NULL )
+		{
+			memory_free(
+			 ( *read_ahead )->read_requests );
+		}
+		if( ( *read_ahead )->chunks_array != NULL )
+		{
+			memory_free(
+			 ( *read_ahead )->chunks_array );
+		}
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * Waits for the chunks that are being unpacked
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		/* The thread pool processes the remaining queued chunks before it is joined
+		 */
+		if( libcthreads_thread_pool_join(
+		     &( ( *read_ahead )->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		for( entry_index = 0;
+		     entry_index < ( *read_ahead )->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( *read_ahead )->chunks_array[ entry_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( ( *read_ahead )->chunks_array[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk data: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *read_ahead )->unpacked_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free unpacked condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_ahead )->condition_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *read_ahead )->read_requests );
+
+		memory_free(
+		 ( *read_ahead )->chunks_array );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Unpacks a read-ahead chunk
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_unpack_chunk_callback(
+     libewf_read_ahead_chunk_t *read_ahead_chunk,
+     libewf_read_ahead_t *read_ahead )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_read_ahead_unpack_chunk_callback";
+	uint8_t status           = LIBEWF_READ_AHEAD_CHUNK_STATUS_FAILED;
+
+	if( read_ahead_chunk == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead chunk.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	/* A chunk that fails to unpack or is corrupted is marked as failed
+	 * the reader falls back to the chunks cache which reports the error
+	 * or registers the checksum error
+	 */
+	if( libewf_chunk_data_unpack(
+	     read_ahead_chunk->chunk_data,
+	     read_ahead->io_handle,
+	     &error ) == 1 )
+	{
+		if( ( read_ahead_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 )
+		{
+			status = LIBEWF_READ_AHEAD_CHUNK_STATUS_UNPACKED;
+		}
+	}
+	else
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->condition_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	read_ahead_chunk->status = status;
+
+	if( libcthreads_condition_broadcast(
+	     read_ahead->unpacked_condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast unpacked condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 read_ahead->condition_mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->condition_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Waits for a read-ahead chunk to be unpacked
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_wait_for_chunk(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_chunk_t *read_ahead_chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_wait_for_chunk";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_ahead->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_ahead_chunk->status == LIBEWF_READ_AHEAD_CHUNK_STATUS_PENDING )
+	{
+		if( libcthreads_condition_wait(
+		     read_ahead->unpacked_condition,
+		     read_ahead->condition_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for unpacked condition.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_ahead->condition_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release condition mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Reads a batch of chunks ahead
+ * The chunks are stored in the same segment file and their read requests
+ * are set by libewf_read_ahead_schedule, the packed chunk data of all chunks
+ * is read at once and the chunks are pushed onto the thread pool to be unpacked
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_read_chunks(
+     libewf_read_ahead_t *read_ahead,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t chunk_index,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_read_ahead_chunk_t *read_ahead_chunk = NULL;
+	static char *function                       = "libewf_read_ahead_read_chunks";
+	int request_index                           = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks <= 0 )
+	 || ( number_of_chunks > read_ahead->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_read_buffers_at_offsets(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     read_ahead->read_requests,
+	     number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks: %" PRIu64 " to: %" PRIu64 " data from file IO pool entry: %d.",
+		 function,
+		 chunk_index,
+		 chunk_index + number_of_chunks - 1,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	for( request_index = 0;
+	     request_index < number_of_chunks;
+	     request_index++ )
+	{
+		read_ahead_chunk = &( read_ahead->chunks_array[ ( chunk_index + request_index ) % read_ahead->number_of_entries ] );
+
+		/* A chunk that could not be read completely, for example because
+		 * it is stored beyond the end of a truncated segment file, is not
+		 * read ahead but read by the chunks cache when it is accessed
+		 */
+		if( read_ahead->read_requests[ request_index ].read_count != (ssize_t) read_ahead->read_requests[ request_index ].size )
+		{
+			if( libewf_chunk_data_free(
+			     &( read_ahead_chunk->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index + request_index );
+
+				goto on_error;
+			}
+			read_ahead_chunk->status = LIBEWF_READ_AHEAD_CHUNK_STATUS_EMPTY;
+
+			continue;
+		}
+		if( libewf_chunk_data_set_packed_data_read(
+		     read_ahead_chunk->chunk_data,
+		     read_ahead->read_requests[ request_index ].size,
+		     read_ahead_chunk->chunk_data->range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " packed data.",
+			 function,
+			 chunk_index + request_index );
+
+			goto on_error;
+		}
+		read_ahead_chunk->status = LIBEWF_READ_AHEAD_CHUNK_STATUS_PENDING;
+
+		if( libcthreads_thread_pool_push(
+		     read_ahead->thread_pool,
+		     (intptr_t *) read_ahead_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %" PRIu64 " onto thread pool queue.",
+			 function,
+			 chunk_index + request_index );
+
+			read_ahead_chunk->status = LIBEWF_READ_AHEAD_CHUNK_STATUS_EMPTY;
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* The chunks that were not pushed onto the thread pool queue are released
+	 */
+	while( request_index < number_of_chunks )
+	{
+		read_ahead_chunk = &( read_ahead->chunks_array[ ( chunk_index + request_index ) % read_ahead->number_of_entries ] );
+
+		if( read_ahead_chunk->chunk_data != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( read_ahead_chunk->chunk_data ),
+			 NULL );
+		}
+		request_index++;
+	}
+	return( -1 );
+}
+
+/* Schedules the chunks following a chunk to be read ahead
+ * The end chunk index contains the index of the last chunk of the current read,
+ * chunks beyond the current read are only read ahead when the reads are sequential
+ * The packed chunk data of consecutive chunks is read in batches on the calling thread
+ * and unpacked by the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_schedule(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     uint64_t end_chunk_index,
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error )
+{
+	libewf_read_ahead_chunk_t *read_ahead_chunk = NULL;
+	uint8_t *mapped_data                        = NULL;
+	static char *function                       = "libewf_read_ahead_schedule";
+	size64_t chunk_data_size                    = 0;
+	off64_t chunk_data_offset                   = 0;
+	uint64_t maximum_chunk_index                = 0;
+	uint32_t chunk_data_flags                   = 0;
+	int batch_file_io_pool_entry                = -1;
+	int file_io_pool_entry                      = -1;
+	int number_of_read_requests                 = 0;
+	int result                                  = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == read_ahead->last_chunk_index )
+	{
+		/* The same chunk is accessed again
+		 */
+	}
+	else if( chunk_index == ( read_ahead->last_chunk_index + 1 ) )
+	{
+		/* The read-ahead window is only grown when a read continues where
+		 * the previous read ended so that reads at random offsets do not
+		 * read chunks ahead that are not used
+		 */
+		if( chunk_index > read_ahead->end_chunk_index )
+		{
+			if( read_ahead->window_size == 0 )
+			{
+				read_ahead->window_size = 1;
+			}
+			else if( read_ahead->window_size < read_ahead->number_of_chunks )
+			{
+				read_ahead->window_size *= 2;
+
+				if( read_ahead->window_size > read_ahead->number_of_chunks )
+				{
+					read_ahead->window_size = read_ahead->number_of_chunks;
+				}
+			}
+		}
+	}
+	else
+	{
+		/* Not a sequential access pattern
+		 */
+		read_ahead->window_size      = 0;
+		read_ahead->next_chunk_index = chunk_index + 1;
+	}
+	read_ahead->last_chunk_index = chunk_index;
+	read_ahead->end_chunk_index  = end_chunk_index;
+
+	if( read_ahead->next_chunk_index <= chunk_index )
+	{
+		read_ahead->next_chunk_index = chunk_index + 1;
+	}
+	/* The remaining chunks of the read are always read ahead
+	 */
+	maximum_chunk_index = chunk_index + read_ahead->window_size;
+
+	if( maximum_chunk_index < end_chunk_index )
+	{
+		maximum_chunk_index = end_chunk_index;
+	}
+	if( maximum_chunk_index > ( chunk_index + read_ahead->number_of_chunks ) )
+	{
+		maximum_chunk_index = chunk_index + read_ahead->number_of_chunks;
+	}
+	if( maximum_chunk_index >= media_values->number_of_chunks )
+	{
+		maximum_chunk_index = media_values->number_of_chunks - 1;
+	}
+	/* While the chunk following the current chunk is already read ahead
+	 * the chunks are read ahead in batches of at least half the window
+	 * so that their reads can be submitted at once
+	 */
+	if( ( read_ahead->next_chunk_index > ( chunk_index + 1 ) )
+	 && ( read_ahead->next_chunk_index <= maximum_chunk_index )
+	 && ( ( maximum_chunk_index - read_ahead->next_chunk_index + 1 ) < (uint64_t) ( ( read_ahead->window_size + 1 ) / 2 ) ) )
+	{
+		return( 1 );
+	}
+	while( read_ahead->next_chunk_index <= maximum_chunk_index )
+	{
+		read_ahead_chunk = &( read_ahead->chunks_array[ read_ahead->next_chunk_index % read_ahead->number_of_entries ] );
+
+		/* The entry can still be in use by a chunk that was read ahead before a seek
+		 */
+		if( libewf_read_ahead_wait_for_chunk(
+		     read_ahead,
+		     read_ahead_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for chunk: %" PRIu64 ".",
+			 function,
+			 read_ahead_chunk->chunk_index );
+
+			goto on_error;
+		}
+		if( read_ahead_chunk->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( read_ahead_chunk->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 read_ahead_chunk->chunk_index );
+
+				goto on_error;
+			}
+		}
+		read_ahead_chunk->status = LIBEWF_READ_AHEAD_CHUNK_STATUS_EMPTY;
+
+		result = libewf_chunk_table_get_chunk_data_range_by_offset(
+		          chunk_table,
+		          read_ahead->next_chunk_index,
+		          file_io_pool,
+		          segment_table,
+		          chunk_groups_cache,
+		          (off64_t) ( read_ahead->next_chunk_index * media_values->chunk_size ),
+		          &file_io_pool_entry,
+		          &chunk_data_offset,
+		          &chunk_data_size,
+		          &chunk_data_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range.",
+			 function,
+			 read_ahead->next_chunk_index );
+
+			goto on_error;
+		}
+		/* Chunks without chunk data are read by the chunks cache
+		 */
+		else if( ( result == 0 )
+		      || ( ( chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+		{
+			break;
+		}
+		result = libbfio_pool_get_mapped_data_at_offset(
+		          file_io_pool,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          (size_t) chunk_data_size,
+		          &mapped_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " mapped data.",
+			 function,
+			 read_ahead->next_chunk_index );
+
+			goto on_error;
+		}
+		/* The chunks read in a single batch are stored in the same segment file
+		 * and chunks in a memory mapped segment file are not read in a batch
+		 */
+		if( ( number_of_read_requests > 0 )
+		 && ( ( result != 0 )
+		  ||  ( file_io_pool_entry != batch_file_io_pool_entry ) ) )
+		{
+			if( libewf_read_ahead_read_chunks(
+			     read_ahead,
+			     file_io_pool,
+			     batch_file_io_pool_entry,
+			     read_ahead->next_chunk_index - number_of_read_requests,
+			     number_of_read_requests,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunks ahead.",
+				 function );
+
+				number_of_read_requests = 0;
+
+				goto on_error;
+			}
+			number_of_read_requests = 0;
+		}
+		if( libewf_chunk_data_initialize(
+		     &( read_ahead_chunk->chunk_data ),
+		     read_ahead->io_handle->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 read_ahead->next_chunk_index );
+
+			goto on_error;
+		}
+		if( ( chunk_data_size == 0 )
+		 || ( chunk_data_size > (size64_t) read_ahead_chunk->chunk_data->allocated_data_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk: %" PRIu64 " data size value out of bounds.",
+			 function,
+			 read_ahead->next_chunk_index );
+
+			goto on_error;
+		}
+		read_ahead_chunk->chunk_index = read_ahead->next_chunk_index;
+
+		/* The chunk data references the mapped data and is pushed onto
+		 * the thread pool queue directly
+		 */
+		if( result != 0 )
+		{
+			if( libewf_chunk_data_read_from_file_io_pool(
+			     read_ahead_chunk->chunk_data,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     chunk_data_offset,
+			     chunk_data_size,
+			     chunk_data_flags,
+			     error ) != (ssize_t) chunk_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 read_ahead->next_chunk_index );
+
+				goto on_error;
+			}
+			read_ahead_chunk->status = LIBEWF_READ_AHEAD_CHUNK_STATUS_PENDING;
+
+			if( libcthreads_thread_pool_push(
+			     read_ahead->thread_pool,
+			     (intptr_t *) read_ahead_chunk,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push chunk: %" PRIu64 " onto thread pool queue.",
+				 function,
+				 read_ahead->next_chunk_index );
+
+				read_ahead_chunk->status = LIBEWF_READ_AHEAD_CHUNK_STATUS_EMPTY;
+
+				goto on_error;
+			}
+			read_ahead->next_chunk_index += 1;
+
+			continue;
+		}
+		read_ahead_chunk->chunk_data->range_flags = chunk_data_flags;
+
+		read_ahead->read_requests[ number_of_read_requests ].buffer = read_ahead_chunk->chunk_data->data;
+		read_ahead->read_requests[ number_of_read_requests ].size   = (size_t) chunk_data_size;
+		read_ahead->read_requests[ number_of_read_requests ].offset = chunk_data_offset;
+
+		batch_file_io_pool_entry = file_io_pool_entry;
+
+		number_of_read_requests++;
+
+		read_ahead->next_chunk_index += 1;
+	}
+	if( number_of_read_requests > 0 )
+	{
+		if( libewf_read_ahead_read_chunks(
+		     read_ahead,
+		     file_io_pool,
+		     batch_file_io_pool_entry,
+		     read_ahead->next_chunk_index - number_of_read_requests,
+		     number_of_read_requests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunks ahead.",
+			 function );
+
+			number_of_read_requests = 0;
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	/* The chunks that were not read are released
+	 */
+	while( number_of_read_requests > 0 )
+	{
+		read_ahead_chunk = &( read_ahead->chunks_array[ ( read_ahead->next_chunk_index - number_of_read_requests ) % read_ahead->number_of_entries ] );
+
+		if( read_ahead_chunk->chunk_data != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( read_ahead_chunk->chunk_data ),
+			 NULL );
+		}
+		number_of_read_requests--;
+	}
+	/* Reset the access pattern so the read-ahead restarts from the next chunk read
+	 */
+	read_ahead->last_chunk_index = (uint64_t) -1;
+	read_ahead->next_chunk_index = 0;
+	read_ahead->end_chunk_index  = 0;
+	read_ahead->window_size      = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the unpacked chunk data of a chunk that was read ahead
+ * The chunk data remains managed by the read-ahead and is valid until the next call to
+ * libewf_read_ahead_schedule with a different chunk index
+ * Returns 1 if successful, 0 if the chunk was not read ahead or -1 on error
+ */
+int libewf_read_ahead_get_chunk_data(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_read_ahead_chunk_t *read_ahead_chunk = NULL;
+	static char *function                       = "libewf_read_ahead_get_chunk_data";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	read_ahead_chunk = &( read_ahead->chunks_array[ chunk_index % read_ahead->number_of_entries ] );
+
+	if( libewf_read_ahead_wait_for_chunk(
+	     read_ahead,
+	     read_ahead_chunk,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( read_ahead_chunk->status == LIBEWF_READ_AHEAD_CHUNK_STATUS_EMPTY )
+	 || ( read_ahead_chunk->chunk_index != chunk_index ) )
+	{
+		return( 0 );
+	}
+	if( read_ahead_chunk->status != LIBEWF_READ_AHEAD_CHUNK_STATUS_UNPACKED )
+	{
+		if( libewf_chunk_data_free(
+		     &( read_ahead_chunk->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		read_ahead_chunk->status = LIBEWF_READ_AHEAD_CHUNK_STATUS_EMPTY;
+
+		return( 0 );
+	}
+	*chunk_data = read_ahead_chunk->chunk_data;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,178 @@
+/*
+ * Chunk read-ahead functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_H )
+#define _LIBEWF_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_table.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_media_values.h"
+#include "libewf_segment_table.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* The read-ahead chunk status
+ */
+enum LIBEWF_READ_AHEAD_CHUNK_STATUS
+{
+	LIBEWF_READ_AHEAD_CHUNK_STATUS_EMPTY		= 0,
+	LIBEWF_READ_AHEAD_CHUNK_STATUS_PENDING		= 1,
+	LIBEWF_READ_AHEAD_CHUNK_STATUS_UNPACKED		= 2,
+	LIBEWF_READ_AHEAD_CHUNK_STATUS_FAILED		= 3
+};
+
+typedef struct libewf_read_ahead_chunk libewf_read_ahead_chunk_t;
+
+struct libewf_read_ahead_chunk
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct libewf_read_ahead libewf_read_ahead_t;
+
+struct libewf_read_ahead
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The number of chunks to read ahead
+	 */
+	int number_of_chunks;
+
+	/* The chunks array
+	 * Contains an entry for the chunk being read and the chunks read ahead
+	 */
+	libewf_read_ahead_chunk_t *chunks_array;
+
+	/* The number of entries in the chunks array
+	 */
+	int number_of_entries;
+
+	/* The read requests
+	 * Contains the read requests of a batch of chunks read ahead
+	 */
+	libbfio_read_request_t *read_requests;
+
+	/* The index of the chunk that was last accessed
+	 */
+	uint64_t last_chunk_index;
+
+	/* The index of the next chunk to read ahead
+	 */
+	uint64_t next_chunk_index;
+
+	/* The index of the last chunk of the current read
+	 */
+	uint64_t end_chunk_index;
+
+	/* The current number of chunks to read ahead beyond the current read
+	 */
+	int window_size;
+
+	/* The thread pool that unpacks the chunks
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The condition mutex
+	 */
+	libcthreads_mutex_t *condition_mutex;
+
+	/* The chunk unpacked condition
+	 */
+	libcthreads_condition_t *unpacked_condition;
+};
+
+int libewf_read_ahead_initialize(
+     libewf_read_ahead_t **read_ahead,
+     libewf_io_handle_t *io_handle,
+     int number_of_chunks,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_free(
+     libewf_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_unpack_chunk_callback(
+     libewf_read_ahead_chunk_t *read_ahead_chunk,
+     libewf_read_ahead_t *read_ahead );
+
+int libewf_read_ahead_wait_for_chunk(
+     libewf_read_ahead_t *read_ahead,
+     libewf_read_ahead_chunk_t *read_ahead_chunk,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_read_chunks(
+     libewf_read_ahead_t *read_ahead,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t chunk_index,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_schedule(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     uint64_t end_chunk_index,
+     libewf_chunk_table_t *chunk_table,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfcache_cache_t *chunk_groups_cache,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_get_chunk_data(
+     libewf_read_ahead_t *read_ahead,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_READ_AHEAD_H ) */
+
@@ -509,24 +509,6 @@ ssize_t libewf_section_descriptor_read(
 		 file_offset );
 	}
 #endif
-	if( libbfio_pool_seek_offset(
-	     file_io_pool,
-	     file_io_pool_entry,
-	     file_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek section descriptor offset: %" PRIi64 " in file IO pool entry: %d.",
-		 function,
-		 file_offset,
-		 file_io_pool_entry );
-
-		goto on_error;
-	}
 	section_descriptor_data = (uint8_t *) memory_allocate(
 	                                       section_descriptor_data_size );
 
@@ -541,11 +523,12 @@ ssize_t libewf_section_descriptor_read(
 
 		goto on_error;
 	}
-	read_count = libbfio_pool_read_buffer(
+	read_count = libbfio_pool_read_buffer_at_offset(
 	              file_io_pool,
 	              file_io_pool_entry,
 	              section_descriptor_data,
 	              section_descriptor_data_size,
+	              file_offset,
 	              error );
 
 	if( read_count != (ssize_t) section_descriptor_data_size )
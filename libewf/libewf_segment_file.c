@@ -35,6 +35,7 @@
 #endif
 
 #include "libewf_case_data.h"
+#include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
@@ -55,9 +56,11 @@
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_unused.h"
+#include "libewf_write_buffer.h"
 
 #include "ewf_file_header.h"
 #include "ewf_section.h"
+#include "ewf_table.h"
 #include "ewf_volume.h"
 
 const uint8_t ewf1_dvf_file_signature[ 8 ] = { 0x64, 0x76, 0x66, 0x09, 0x0d, 0x0a, 0xff, 0x00 };
@@ -3969,6 +3972,8 @@ on_error:
 }
 
 /* Write a chunk of data to a segment file and update the chunk table
+ * The chunk data is combined with other writes in the write buffer if one is provided,
+ * in which case the current offset is advanced before the data is written to the file
  * Returns the number of bytes written or -1 on error
  */
 ssize_t libewf_segment_file_write_chunk_data(
@@ -3977,6 +3982,7 @@ ssize_t libewf_segment_file_write_chunk_data(
          int file_io_pool_entry,
          uint64_t chunk_index,
          libewf_chunk_data_t *chunk_data,
+         libewf_write_buffer_t *write_buffer,
          libcerror_error_t **error )
 {
 	static char *function     = "libewf_segment_file_write_chunk_data";
@@ -4148,6 +4154,7 @@ ssize_t libewf_segment_file_write_chunk_data(
 	               chunk_data,
 	               file_io_pool,
 	               file_io_pool_entry,
+	               write_buffer,
 	               error );
 
 	if( write_count != (ssize_t) chunk_write_size )
@@ -4640,6 +4647,7 @@ ssize_t libewf_segment_file_write_close(
 	static char *function        = "libewf_segment_file_write_close";
 	ssize_t total_write_count    = 0;
 	ssize_t write_count          = 0;
+	int bfio_access_flags        = 0;
 	int element_index            = 0;
 	int number_of_acquiry_errors = 0;
 	int number_of_sessions       = 0;
@@ -5055,10 +5063,16 @@ ssize_t libewf_segment_file_write_close(
 
 	/* Make sure the next time the file is opened it is not truncated
 	 */
+	bfio_access_flags = LIBBFIO_OPEN_READ_WRITE;
+
+	if( ( segment_file->io_handle->access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		bfio_access_flags |= LIBBFIO_ACCESS_FLAG_DIRECT_IO;
+	}
 	if( libbfio_pool_reopen(
 	     file_io_pool,
 	     file_io_pool_entry,
-	     LIBBFIO_OPEN_READ_WRITE,
+	     bfio_access_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -6466,6 +6480,309 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the number of chunks of a segment file
+ * Only reads the file header, the section descriptors and the table section headers
+ * and not the table entries, this is used to map the storage media of a segment file
+ * without reading the entire segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_number_of_chunks(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error )
+{
+	uint8_t table_header_data[ sizeof( ewf_table_header_v2_t ) ];
+
+	libewf_section_t *section     = NULL;
+	static char *function         = "libewf_segment_file_read_number_of_chunks";
+	off64_t section_data_offset   = 0;
+	off64_t segment_file_offset   = 0;
+	size_t table_header_data_size = 0;
+	ssize_t read_count            = 0;
+	uint32_t calculated_checksum  = 0;
+	uint32_t number_of_entries    = 0;
+	uint32_t stored_checksum      = 0;
+	int last_section              = 0;
+	int result                    = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_chunks = 0;
+
+	read_count = libewf_segment_file_read_file_header(
+		      segment_file,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file header.",
+		 function );
+
+		goto on_error;
+	}
+	/* Read the section descriptors:
+	 * EWF version 1 read from front to back
+	 * EWF version 2 read from back to front
+	 */
+	if( segment_file->major_version == 1 )
+	{
+		segment_file_offset    = (off64_t) read_count;
+		table_header_data_size = sizeof( ewf_table_header_v1_t );
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		segment_file_offset    = (off64_t) segment_file_size - sizeof( ewf_section_descriptor_v2_t );
+		table_header_data_size = sizeof( ewf_table_header_v2_t );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_section_initialize(
+	     &section,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( segment_file_offset > 0 )
+	    && ( (size64_t) segment_file_offset < segment_file_size ) )
+	{
+		read_count = libewf_section_descriptor_read(
+			      section,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      segment_file_offset,
+			      segment_file->major_version,
+			      error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section descriptor.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( section->type == LIBEWF_SECTION_TYPE_NEXT )
+		 || ( section->type == LIBEWF_SECTION_TYPE_DONE ) )
+		{
+			last_section = 1;
+		}
+		else if( section->type == LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS )
+		{
+			segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED;
+		}
+		/* Encrypted tables are not read, see libewf_section_table_read
+		 */
+		else if( ( section->type == LIBEWF_SECTION_TYPE_SECTOR_TABLE )
+		      && ( ( section->data_flags & LIBEWF_SECTION_DATA_FLAGS_IS_ENCRYPTED ) == 0 ) )
+		{
+			result = libewf_section_get_data_offset(
+			          section,
+			          segment_file->major_version,
+			          &section_data_offset,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve table section data offset.",
+				 function );
+
+				goto on_error;
+			}
+			read_count = libbfio_pool_read_buffer_at_offset(
+			              file_io_pool,
+			              file_io_pool_entry,
+			              table_header_data,
+			              table_header_data_size,
+			              section_data_offset,
+			              error );
+
+			if( read_count != (ssize_t) table_header_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read table header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 section_data_offset,
+				 section_data_offset );
+
+				goto on_error;
+			}
+			if( segment_file->major_version == 1 )
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 ( (ewf_table_header_v1_t *) table_header_data )->number_of_entries,
+				 number_of_entries );
+
+				byte_stream_copy_to_uint32_little_endian(
+				 ( (ewf_table_header_v1_t *) table_header_data )->checksum,
+				 stored_checksum );
+
+				result = libewf_checksum_calculate_adler32(
+				          &calculated_checksum,
+				          table_header_data,
+				          sizeof( ewf_table_header_v1_t ) - 4,
+				          1,
+				          error );
+			}
+			else
+			{
+				byte_stream_copy_to_uint32_little_endian(
+				 ( (ewf_table_header_v2_t *) table_header_data )->number_of_entries,
+				 number_of_entries );
+
+				byte_stream_copy_to_uint32_little_endian(
+				 ( (ewf_table_header_v2_t *) table_header_data )->checksum,
+				 stored_checksum );
+
+				result = libewf_checksum_calculate_adler32(
+				          &calculated_checksum,
+				          table_header_data,
+				          sizeof( ewf_table_header_v2_t ) - 16,
+				          1,
+				          error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to calculate table header checksum.",
+				 function );
+
+				goto on_error;
+			}
+			if( stored_checksum != calculated_checksum )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+				 "%s: table header checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+				 function,
+				 stored_checksum,
+				 calculated_checksum );
+
+				goto on_error;
+			}
+			*number_of_chunks += number_of_entries;
+		}
+		if( ( last_section == 0 )
+		 && ( section->size == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid section size value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( segment_file->major_version == 1 )
+		{
+			segment_file_offset += section->size;
+
+			if( last_section != 0 )
+			{
+				break;
+			}
+		}
+		else
+		{
+			segment_file_offset -= section->size;
+		}
+	}
+	if( last_section == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing next or done section.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_section_free(
+	     &section,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free section.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Reads a section
  * Callback function for the sections list
  * Returns 1 if successful or -1 on error
@@ -6679,8 +6996,6 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 			goto on_error;
 		}
-		segment_file->current_offset = chunk_group_data_offset + read_count;
-
 		if( chunk_group_data_size != section->size )
 		{
 			libcerror_error_set(
@@ -6692,6 +7007,28 @@ int libewf_segment_file_read_chunk_group_element_data(
 
 			goto on_error;
 		}
+		/* The section descriptor is read without changing the current offset
+		 */
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     chunk_group_data_offset + read_count,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek chunk table data offset: %" PRIi64 " in file IO pool entry: %d.",
+			 function,
+			 chunk_group_data_offset + read_count,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		segment_file->current_offset = chunk_group_data_offset + read_count;
+
 		chunk_group_data_size -= read_count;
 	}
 	else if( segment_file->major_version == 2 )
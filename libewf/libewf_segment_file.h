@@ -47,6 +47,7 @@
 #include "libewf_media_values.h"
 #include "libewf_section.h"
 #include "libewf_single_files.h"
+#include "libewf_write_buffer.h"
 
 #include "ewf_data.h"
 #include "ewf_table.h"
@@ -317,6 +318,7 @@ ssize_t libewf_segment_file_write_chunk_data(
          int file_io_pool_entry,
          uint64_t chunk_index,
          libewf_chunk_data_t *chunk_data,
+         libewf_write_buffer_t *write_buffer,
          libcerror_error_t **error );
 
 ssize_t libewf_segment_file_write_hash_sections(
@@ -383,6 +385,14 @@ int libewf_segment_file_read_element_data(
      uint8_t read_flags,
      libcerror_error_t **error );
 
+int libewf_segment_file_read_number_of_chunks(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     uint64_t *number_of_chunks,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_section_element_data(
      libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
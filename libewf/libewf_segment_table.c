@@ -27,10 +27,12 @@
 #include <wide_string.h>
 
 #include "libewf_definitions.h"
+#include "libewf_index_file.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libclocale.h"
+#include "libewf_libcnotify.h"
 #include "libewf_libfdata.h"
 #include "libewf_libuna.h"
 #include "libewf_segment_file.h"
@@ -117,10 +119,10 @@ int libewf_segment_table_initialize(
 /* TODO add write support ? */
 	if( libfdata_list_initialize(
 	     &( ( *segment_table )->segment_files_list ),
-	     (intptr_t *) io_handle,
+	     (intptr_t *) *segment_table,
 	     NULL,
 	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfcache_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libewf_segment_file_read_element_data,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfcache_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libewf_segment_table_read_element_data,
 	     NULL,
 	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
 	     error ) != 1 )
@@ -148,6 +150,7 @@ int libewf_segment_table_initialize(
 
 		goto on_error;
 	}
+	( *segment_table )->io_handle            = io_handle;
 	( *segment_table )->maximum_segment_size = maximum_segment_size;
 
 	return( 1 );
@@ -223,6 +226,22 @@ int libewf_segment_table_free(
 
 			result = -1;
 		}
+		if( ( *segment_table )->index_file != NULL )
+		{
+			if( libewf_index_file_free(
+			     &( ( *segment_table )->index_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *segment_table );
 
@@ -362,6 +381,7 @@ int libewf_segment_table_clone(
 
 		goto on_error;
 	}
+	( *destination_segment_table )->io_handle            = source_segment_table->io_handle;
 	( *destination_segment_table )->maximum_segment_size = source_segment_table->maximum_segment_size;
 
 	return( 1 );
@@ -442,11 +462,182 @@ int libewf_segment_table_empty(
 
 		result = -1;
 	}
-	segment_table->number_of_segments = 0;
+	if( segment_table->index_file != NULL )
+	{
+		if( libewf_index_file_free(
+		     &( segment_table->index_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	segment_table->number_of_segments        = 0;
+	segment_table->number_of_mapped_segments = 0;
+	segment_table->flags                    &= ~( LIBEWF_SEGMENT_TABLE_FLAG_READ_ON_DEMAND );
 
 	return( result );
 }
 
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Uses the layout stored in the index file if available, otherwise
+ * the sections of the segment file are read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_read_element_data(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfcache_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset,
+     size64_t segment_file_size,
+     uint32_t element_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_table_read_element_data";
+	int element_index                   = 0;
+	int result                          = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->index_file != NULL )
+	{
+		if( libfdata_list_element_get_element_index(
+		     element,
+		     &element_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element index.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_index_file_get_segment_file(
+		          segment_table->index_file,
+		          segment_table->io_handle,
+		          (uint32_t) element_index,
+		          file_io_pool_entry,
+		          &segment_file,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %d from index file.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+		return( libewf_segment_file_read_element_data(
+		         segment_table->io_handle,
+		         file_io_pool,
+		         element,
+		         segment_file_cache,
+		         file_io_pool_entry,
+		         segment_file_offset,
+		         segment_file_size,
+		         element_flags,
+		         read_flags,
+		         error ) );
+	}
+	if( libfdata_list_element_set_element_value(
+	     element,
+	     (intptr_t *) file_io_pool,
+	     segment_file_cache,
+	     (intptr_t *) segment_file,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_file_free,
+	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment file as element value.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the index file
+ * The segment table takes over the management of the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_set_index_file(
+     libewf_segment_table_t *segment_table,
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_table_set_index_file";
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment table - index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	segment_table->index_file = index_file;
+
+	return( 1 );
+}
+
 /* Retrieves the size of the basename
  * Returns 1 if successful, 0 if value not present or -1 on error
  */
@@ -1751,6 +1942,299 @@ int libewf_segment_table_get_segment_file_by_index(
 	return( 1 );
 }
 
+/* Maps the next segment to the storage media
+ * The storage media size of the segment is determined from the number of chunks
+ * in its table section headers, hence the segment files that precede the segment
+ * that contains an offset are not read entirely. If the table section headers
+ * cannot be read the segment file is read entirely instead.
+ * Only used when the segment files are read on demand
+ * Returns 1 if successful, 0 if no more segments need to be mapped or -1 on error
+ */
+int libewf_segment_table_map_next_segment(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_table_map_next_segment";
+	size64_t segment_file_size          = 0;
+	size64_t storage_media_size         = 0;
+	uint64_t number_of_chunks           = 0;
+	uint32_t segment_number             = 0;
+	uint8_t read_number_of_chunks       = 0;
+	int file_io_pool_entry              = 0;
+	int result                          = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_READ_ON_DEMAND ) == 0 )
+	{
+		return( 0 );
+	}
+	segment_number = segment_table->number_of_mapped_segments;
+
+	if( segment_number >= segment_table->number_of_segments )
+	{
+		segment_table->flags &= ~( LIBEWF_SEGMENT_TABLE_FLAG_READ_ON_DEMAND );
+
+		return( 0 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: mapping segment: %" PRIu32 ".\n",
+		 function,
+		 segment_number );
+	}
+#endif
+	/* The last segment file was read when the segment files were opened
+	 */
+	if( ( segment_number + 1 ) < segment_table->number_of_segments )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     segment_table->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_segment_file_read_number_of_chunks(
+		          segment_file,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          segment_file_size,
+		          &number_of_chunks,
+		          error );
+
+		if( result == 1 )
+		{
+			read_number_of_chunks = 1;
+			storage_media_size    = (size64_t) segment_table->io_handle->chunk_size * number_of_chunks;
+		}
+		else
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			if( libewf_segment_file_free(
+			     &segment_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( read_number_of_chunks == 0 )
+	{
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		storage_media_size = segment_file->storage_media_size;
+	}
+	if( segment_file->segment_number != ( segment_number + 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+		 function,
+		 segment_file->segment_number,
+		 segment_number + 1 );
+
+		goto on_error;
+	}
+	if( ( segment_file->major_version != segment_table->io_handle->major_version )
+	 || ( segment_file->minor_version != segment_table->io_handle->minor_version ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment file format version value mismatch.",
+		 function );
+
+		goto on_error;
+	}
+	if( segment_file->major_version == 2 )
+	{
+		if( segment_file->compression_method != segment_table->io_handle->compression_method )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment file compression method value mismatch.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     segment_table->set_identifier,
+		     segment_file->set_identifier,
+		     16 ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment file set identifier value mismatch.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
+	{
+		segment_table->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
+		segment_table->io_handle->is_encrypted = 1;
+	}
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+	}
+	/* The segment file that was only used to read the number of chunks is not cached
+	 */
+	if( read_number_of_chunks != 0 )
+	{
+		if( libewf_segment_file_free(
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_segment_table_set_segment_storage_media_size_by_index(
+	     segment_table,
+	     segment_number,
+	     storage_media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	segment_table->number_of_mapped_segments += 1;
+
+	if( segment_table->number_of_mapped_segments >= segment_table->number_of_segments )
+	{
+		segment_table->flags &= ~( LIBEWF_SEGMENT_TABLE_FLAG_READ_ON_DEMAND );
+	}
+	return( 1 );
+
+on_error:
+	if( ( read_number_of_chunks != 0 )
+	 && ( segment_file != NULL ) )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Retrieves a segment file at a specific offset from the segment table
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -1789,30 +2273,65 @@ int libewf_segment_table_get_segment_file_at_offset(
 
 		return( -1 );
 	}
-	result = libfdata_list_get_element_value_at_offset(
-	          segment_table->segment_files_list,
-	          (intptr_t *) file_io_pool,
-	          segment_table->segment_files_cache,
-	          offset,
-	          &segment_files_list_index,
-	          segment_file_data_offset,
-	          (intptr_t **) segment_file,
-	          0,
-	          error );
-
-	if( result == -1 )
+	do
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from segment files list.",
-		 function,
-		 offset );
+		result = libfdata_list_get_element_value_at_offset(
+		          segment_table->segment_files_list,
+		          (intptr_t *) file_io_pool,
+		          segment_table->segment_files_cache,
+		          offset,
+		          &segment_files_list_index,
+		          segment_file_data_offset,
+		          (intptr_t **) segment_file,
+		          0,
+		          error );
 
-		return( -1 );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element at offset: 0x%08" PRIx64 " from segment files list.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			/* A segment file read on demand can be corrupted
+			 */
+			if( ( *segment_file != NULL )
+			 && ( ( ( *segment_file )->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 ) )
+			{
+				segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+			}
+			break;
+		}
+		/* If the segment files are read on demand the offset can be
+		 * beyond the segments that are mapped so far
+		 */
+		result = libewf_segment_table_map_next_segment(
+		          segment_table,
+		          file_io_pool,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to map next segment.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	else if( result != 0 )
+	while( result != 0 );
+
+	if( result != 0 )
 	{
 #if SIZEOF_INT <= 4
 		if( segment_files_list_index < 0 )
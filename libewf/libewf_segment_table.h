@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -40,6 +41,10 @@ typedef struct libewf_segment_table libewf_segment_table_t;
 
 struct libewf_segment_table
 {
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
 	/* The basename
 	 */
 	system_character_t *basename;
@@ -60,10 +65,25 @@ struct libewf_segment_table
 	 */
 	uint32_t number_of_segments;
 
+	/* The number of segments mapped to the storage media
+	 * Only used when the segment files are read on demand
+	 */
+	uint32_t number_of_mapped_segments;
+
+	/* The set identifier
+	 * Used to validate the segment files read on demand
+	 */
+	uint8_t set_identifier[ 16 ];
+
 	/* The segment files cache
 	 */
 	libfcache_cache_t *segment_files_cache;
 
+	/* The index file
+	 * Contains the layout of the segment files when available
+	 */
+	libewf_index_file_t *index_file;
+
 	/* Flags
 	 */
 	uint8_t flags;
@@ -88,6 +108,23 @@ int libewf_segment_table_empty(
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error );
 
+int libewf_segment_table_read_element_data(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfcache_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset,
+     size64_t segment_file_size,
+     uint32_t element_flags,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
+int libewf_segment_table_set_index_file(
+     libewf_segment_table_t *segment_table,
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error );
+
 int libewf_segment_table_get_basename_size(
      libewf_segment_table_t *segment_table,
      size_t *basename_size,
@@ -169,6 +206,11 @@ int libewf_segment_table_get_segment_file_by_index(
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error );
 
+int libewf_segment_table_map_next_segment(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
 int libewf_segment_table_get_segment_file_at_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
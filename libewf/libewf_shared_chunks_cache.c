@@ -0,0 +1,855 @@
+/*
+ * Shared chunks cache functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_view.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_shared_chunks_cache.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a shared chunks cache
+ * Make sure the value shared_chunks_cache is referencing, is set to NULL
+ * The maximum cache size is divided over the shards, the chunk size is used
+ * to limit the number of shards to the number of chunks that fit in the cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunks_cache_initialize(
+     libewf_shared_chunks_cache_t **shared_chunks_cache,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	libewf_shared_chunks_cache_shard_t *shard = NULL;
+	static char *function                     = "libewf_shared_chunks_cache_initialize";
+	size64_t maximum_shard_size               = 0;
+	size_t shards_array_size                  = 0;
+	int number_of_shards                      = 0;
+	int shard_index                           = 0;
+
+	if( shared_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_chunks_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid shared chunks cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum cache size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_shards = LIBEWF_SHARED_CHUNKS_CACHE_NUMBER_OF_SHARDS;
+
+	if( (size64_t) number_of_shards > ( maximum_cache_size / chunk_size ) )
+	{
+		number_of_shards = (int) ( maximum_cache_size / chunk_size );
+
+		if( number_of_shards == 0 )
+		{
+			number_of_shards = 1;
+		}
+	}
+	maximum_shard_size = maximum_cache_size / number_of_shards;
+
+	*shared_chunks_cache = memory_allocate_structure(
+	                        libewf_shared_chunks_cache_t );
+
+	if( *shared_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shared chunks cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *shared_chunks_cache,
+	     0,
+	     sizeof( libewf_shared_chunks_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shared chunks cache.",
+		 function );
+
+		memory_free(
+		 *shared_chunks_cache );
+
+		*shared_chunks_cache = NULL;
+
+		return( -1 );
+	}
+	shards_array_size = sizeof( libewf_shared_chunks_cache_shard_t ) * number_of_shards;
+
+	( *shared_chunks_cache )->shards_array = (libewf_shared_chunks_cache_shard_t *) memory_allocate(
+	                                                                                 shards_array_size );
+
+	if( ( *shared_chunks_cache )->shards_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards array.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *shared_chunks_cache )->shards_array,
+	     0,
+	     shards_array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards array.",
+		 function );
+
+		memory_free(
+		 ( *shared_chunks_cache )->shards_array );
+
+		( *shared_chunks_cache )->shards_array = NULL;
+
+		goto on_error;
+	}
+	( *shared_chunks_cache )->number_of_shards = number_of_shards;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( ( *shared_chunks_cache )->shards_array )[ shard_index ] );
+
+		if( libfcache_cache_initialize_with_maximum_size(
+		     &( shard->chunks_cache ),
+		     maximum_shard_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d chunks cache.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_initialize(
+		     &( shard->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *shared_chunks_cache != NULL )
+	{
+		libewf_shared_chunks_cache_free(
+		 shared_chunks_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a shared chunks cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunks_cache_free(
+     libewf_shared_chunks_cache_t **shared_chunks_cache,
+     libcerror_error_t **error )
+{
+	libewf_shared_chunks_cache_shard_t *shard = NULL;
+	static char *function                     = "libewf_shared_chunks_cache_free";
+	int result                                = 1;
+	int shard_index                           = 0;
+
+	if( shared_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_chunks_cache != NULL )
+	{
+		if( ( *shared_chunks_cache )->shards_array != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *shared_chunks_cache )->number_of_shards;
+			     shard_index++ )
+			{
+				shard = &( ( ( *shared_chunks_cache )->shards_array )[ shard_index ] );
+
+				if( shard->chunks_cache != NULL )
+				{
+					if( libfcache_cache_free(
+					     &( shard->chunks_cache ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d chunks cache.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+				if( shard->mutex != NULL )
+				{
+					if( libcthreads_mutex_free(
+					     &( shard->mutex ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d mutex.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+			}
+			memory_free(
+			 ( *shared_chunks_cache )->shards_array );
+		}
+		memory_free(
+		 *shared_chunks_cache );
+
+		*shared_chunks_cache = NULL;
+	}
+	return( result );
+}
+
+/* Sets the maximum cache size
+ * The maximum cache size is divided over the shards, the least recently used
+ * chunks of a shard are freed until the shard no longer exceeds its part
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunks_cache_set_maximum_size(
+     libewf_shared_chunks_cache_t *shared_chunks_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_shared_chunks_cache_shard_t *shard = NULL;
+	static char *function                     = "libewf_shared_chunks_cache_set_maximum_size";
+	size64_t maximum_shard_size               = 0;
+	int result                                = 1;
+	int shard_index                           = 0;
+
+	if( shared_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum cache size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_shard_size = maximum_cache_size / shared_chunks_cache->number_of_shards;
+
+	if( maximum_shard_size == 0 )
+	{
+		maximum_shard_size = 1;
+	}
+	for( shard_index = 0;
+	     shard_index < shared_chunks_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( shared_chunks_cache->shards_array )[ shard_index ] );
+
+		if( libcthreads_mutex_grab(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+		if( libfcache_cache_set_maximum_size(
+		     shard->chunks_cache,
+		     maximum_shard_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of shard: %d chunks cache.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+		if( result != 1 )
+		{
+			break;
+		}
+	}
+	return( result );
+}
+
+/* Copies the data of a cached chunk into a buffer
+ * The data is copied while the shard mutex is held, since the chunk data
+ * can be evicted by another thread once the mutex is released
+ * Returns 1 if the chunk was cached, 0 if not or -1 on error
+ */
+int libewf_shared_chunks_cache_copy_chunk_data(
+     libewf_shared_chunks_cache_t *shared_chunks_cache,
+     uint64_t chunk_index,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *copy_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_shared_chunks_cache_shard_t *shard = NULL;
+	libfcache_cache_value_t *cache_value      = NULL;
+	static char *function                     = "libewf_shared_chunks_cache_copy_chunk_data";
+	size_t safe_copy_size                     = 0;
+	int result                                = 0;
+
+	if( shared_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( copy_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid copy size.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( shared_chunks_cache->shards_array[ chunk_index % shared_chunks_cache->number_of_shards ] );
+
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Looking up the chunk makes it the most recently used chunk of the shard
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          shard->chunks_cache,
+	          0,
+	          (off64_t) chunk_index,
+	          0,
+	          &cache_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " cache value.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     (intptr_t **) &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data from cache value.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( chunk_data_offset < chunk_data->data_size )
+		{
+			safe_copy_size = chunk_data->data_size - chunk_data_offset;
+
+			if( safe_copy_size > buffer_size )
+			{
+				safe_copy_size = buffer_size;
+			}
+			if( memory_copy(
+			     buffer,
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     safe_copy_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*copy_size = safe_copy_size;
+
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 shard->mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Retrieves a view of the data of a cached chunk
+ * The chunk view references the chunk data so that it remains valid
+ * when the chunk is evicted from the cache
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_shared_chunks_cache_get_chunk_view(
+     libewf_shared_chunks_cache_t *shared_chunks_cache,
+     uint64_t chunk_index,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_shared_chunks_cache_shard_t *shard = NULL;
+	libfcache_cache_value_t *cache_value      = NULL;
+	static char *function                     = "libewf_shared_chunks_cache_get_chunk_view";
+	int result                                = 0;
+
+	if( shared_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( shared_chunks_cache->shards_array[ chunk_index % shared_chunks_cache->number_of_shards ] );
+
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+	result = libfcache_cache_get_value_by_identifier(
+	          shard->chunks_cache,
+	          0,
+	          (off64_t) chunk_index,
+	          0,
+	          &cache_value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " cache value.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     (intptr_t **) &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data from cache value.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* The reference is grabbed while the shard mutex is held
+		 * so that the chunk data cannot be evicted and freed in between
+		 */
+		if( libewf_chunk_view_initialize(
+		     chunk_view,
+		     chunk_index,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " view.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		libewf_chunk_view_free(
+		 chunk_view,
+		 NULL );
+
+		return( -1 );
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 shard->mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Sets the (unpacked) data of a chunk
+ * The shared chunks cache takes over management of the chunk data, the least
+ * recently used chunks of the shard are freed if the shard exceeds its part
+ * of the maximum cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_shared_chunks_cache_set_chunk_data(
+     libewf_shared_chunks_cache_t *shared_chunks_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_shared_chunks_cache_shard_t *shard = NULL;
+	static char *function                     = "libewf_shared_chunks_cache_set_chunk_data";
+	int result                                = 0;
+
+	if( shared_chunks_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared chunks cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	shard = &( shared_chunks_cache->shards_array[ chunk_index % shared_chunks_cache->number_of_shards ] );
+
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* If another thread cached the same chunk in the meantime its chunk data is replaced
+	 */
+	result = libfcache_cache_set_value_by_identifier(
+	          shard->chunks_cache,
+	          0,
+	          (off64_t) chunk_index,
+	          0,
+	          (intptr_t *) chunk_data,
+	          chunk_data->allocated_data_size,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	          LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in shard chunks cache.",
+		 function,
+		 chunk_index );
+	}
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,112 @@
+/*
+ * Shared chunks cache functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SHARED_CHUNKS_CACHE_H )
+#define _LIBEWF_SHARED_CHUNKS_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_view.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_shared_chunks_cache_shard libewf_shared_chunks_cache_shard_t;
+
+struct libewf_shared_chunks_cache_shard
+{
+	/* The chunks cache
+	 * A size bounded cache of which the least recently used chunks are evicted
+	 */
+	libfcache_cache_t *chunks_cache;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+};
+
+typedef struct libewf_shared_chunks_cache libewf_shared_chunks_cache_t;
+
+struct libewf_shared_chunks_cache
+{
+	/* The shards array
+	 * The chunks are distributed over the shards by chunk index
+	 * so that readers of different chunks rarely grab the same mutex
+	 */
+	libewf_shared_chunks_cache_shard_t *shards_array;
+
+	/* The number of shards
+	 */
+	int number_of_shards;
+};
+
+int libewf_shared_chunks_cache_initialize(
+     libewf_shared_chunks_cache_t **shared_chunks_cache,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_shared_chunks_cache_free(
+     libewf_shared_chunks_cache_t **shared_chunks_cache,
+     libcerror_error_t **error );
+
+int libewf_shared_chunks_cache_set_maximum_size(
+     libewf_shared_chunks_cache_t *shared_chunks_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_shared_chunks_cache_copy_chunk_data(
+     libewf_shared_chunks_cache_t *shared_chunks_cache,
+     uint64_t chunk_index,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *copy_size,
+     libcerror_error_t **error );
+
+int libewf_shared_chunks_cache_get_chunk_view(
+     libewf_shared_chunks_cache_t *shared_chunks_cache,
+     uint64_t chunk_index,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+int libewf_shared_chunks_cache_set_chunk_data(
+     libewf_shared_chunks_cache_t *shared_chunks_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SHARED_CHUNKS_CACHE_H ) */
+
@@ -0,0 +1,37 @@
+/*
+ * The internal SIMD definitions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INTERNAL_SIMD_H )
+#define _LIBEWF_INTERNAL_SIMD_H
+
+#include <common.h>
+
+/* The x86 SIMD implementations require GCC or Clang function target
+ * attributes and are selected at run-time using CPUID
+ */
+#if !defined( LIBEWF_HAVE_X86_SIMD )
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( ( defined( __GNUC__ ) && __GNUC__ >= 5 ) || defined( __clang__ ) )
+#define LIBEWF_HAVE_X86_SIMD
+#endif
+#endif
+
+#endif /* !defined( _LIBEWF_INTERNAL_SIMD_H ) */
+
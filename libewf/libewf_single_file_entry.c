@@ -24,10 +24,12 @@
 #include <narrow_string.h>
 #include <types.h>
 
+#include "libewf_arena.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfvalue.h"
 #include "libewf_libuna.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
 
 /* Creates a single file entry
  * Make sure the value single_file_entry is referencing, is set to NULL
@@ -113,6 +115,7 @@ int libewf_single_file_entry_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_single_file_entry_free";
+	int result            = 1;
 
 	if( single_file_entry == NULL )
 	{
@@ -142,14 +145,147 @@ int libewf_single_file_entry_free(
 			memory_free(
 			 ( *single_file_entry )->sha1_hash );
 		}
+		if( ( *single_file_entry )->sub_entries_name_index != NULL )
+		{
+			if( libewf_single_file_name_index_free(
+			     &( ( *single_file_entry )->sub_entries_name_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub entries name index.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *single_file_entry );
 
 		*single_file_entry = NULL;
 	}
+	return( result );
+}
+
+/* Creates a single file entry that is allocated from an arena
+ * The name and digest hashes set by the caller should be allocated from the same arena
+ * Make sure the value single_file_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_entry_initialize_from_arena(
+     libewf_single_file_entry_t **single_file_entry,
+     libewf_arena_t *arena,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "libewf_single_file_entry_initialize_from_arena";
+
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *single_file_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid single file entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_arena_allocate(
+	     arena,
+	     sizeof( libewf_single_file_entry_t ),
+	     &data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( libewf_single_file_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	*single_file_entry = (libewf_single_file_entry_t *) data;
+
+	( *single_file_entry )->data_offset           = -1;
+	( *single_file_entry )->duplicate_data_offset = -1;
+
 	return( 1 );
 }
 
+/* Frees a single file entry that was allocated from an arena
+ * Only the sub entries name index is freed, the rest is freed together with the arena
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_entry_free_from_arena(
+     libewf_single_file_entry_t **single_file_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_entry_free_from_arena";
+	int result            = 1;
+
+	if( single_file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *single_file_entry != NULL )
+	{
+		if( ( *single_file_entry )->sub_entries_name_index != NULL )
+		{
+			if( libewf_single_file_name_index_free(
+			     &( ( *single_file_entry )->sub_entries_name_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub entries name index.",
+				 function );
+
+				result = -1;
+			}
+		}
+		*single_file_entry = NULL;
+	}
+	return( result );
+}
+
 /* Clones the single file entry
  * Returns 1 if successful or -1 on error
  */
@@ -221,9 +357,10 @@ int libewf_single_file_entry_clone(
 
 		return( -1 );
 	}
-	( *destination_single_file_entry )->name      = NULL;
-	( *destination_single_file_entry )->md5_hash  = NULL;
-	( *destination_single_file_entry )->sha1_hash = NULL;
+	( *destination_single_file_entry )->name                   = NULL;
+	( *destination_single_file_entry )->md5_hash               = NULL;
+	( *destination_single_file_entry )->sha1_hash              = NULL;
+	( *destination_single_file_entry )->sub_entries_name_index = NULL;
 
 	if( source_single_file_entry->name != NULL )
 	{
@@ -25,8 +25,10 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_arena.h"
 #include "libewf_date_time.h"
 #include "libewf_libcerror.h"
+#include "libewf_single_file_name_index.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -103,6 +105,10 @@ struct libewf_single_file_entry
 	/* The SHA1 digest hash size
 	 */
 	size_t sha1_hash_size;
+
+	/* The name index of the sub entries, created on the first lookup by name
+	 */
+	libewf_single_file_name_index_t *sub_entries_name_index;
 };
 
 int libewf_single_file_entry_initialize(
@@ -113,6 +119,15 @@ int libewf_single_file_entry_free(
      libewf_single_file_entry_t **single_file_entry,
      libcerror_error_t **error );
 
+int libewf_single_file_entry_initialize_from_arena(
+     libewf_single_file_entry_t **single_file_entry,
+     libewf_arena_t *arena,
+     libcerror_error_t **error );
+
+int libewf_single_file_entry_free_from_arena(
+     libewf_single_file_entry_t **single_file_entry,
+     libcerror_error_t **error );
+
 int libewf_single_file_entry_clone(
      libewf_single_file_entry_t **destination_single_file_entry,
      libewf_single_file_entry_t *source_single_file_entry,
@@ -0,0 +1,1016 @@
+/*
+ * Single file name index functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+#include "libewf_libuna.h"
+#include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
+
+/* The name hash is a 64-bit Fowler-Noll-Vo (FNV-1a) hash of the Unicode characters
+ * so that UTF-8 and UTF-16 formatted names of the same characters have the same hash
+ */
+#define libewf_single_file_name_index_hash_initialize() \
+	(uint64_t) 0xcbf29ce484222325ULL
+
+#define libewf_single_file_name_index_hash_update( name_hash, unicode_character ) \
+	( ( name_hash ^ (uint64_t) unicode_character ) * (uint64_t) 0x00000100000001b3ULL )
+
+/* Frees a sub node of the sub nodes cache
+ * The sub nodes are not managed by the sub nodes cache, they are freed with the tree
+ * Returns 1 if successful or -1 on error
+ */
+static int libewf_single_file_name_index_free_sub_node(
+            libcdata_tree_node_t **sub_node,
+            libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_name_index_free_sub_node";
+
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	*sub_node = NULL;
+
+	return( 1 );
+}
+
+/* Retrieves the sub node for the specific name hash and UTF-8 or UTF-16 formatted name
+ * The sub node is stored with the name hash as offset of its cache value identifier.
+ * A sub node with a different name and the same name hash is stored with the next
+ * offset that is not used, hence the offsets are probed until one is not used.
+ * The offset is set to the offset of the sub node or the first offset that is not used
+ * Returns 1 if successful, 0 if no such sub node or -1 on error
+ */
+static int libewf_single_file_name_index_get_sub_node_by_name_hash(
+            libfcache_cache_t *sub_nodes_cache,
+            uint64_t name_hash,
+            const uint8_t *utf8_string,
+            size_t utf8_string_length,
+            const uint16_t *utf16_string,
+            size_t utf16_string_length,
+            libcdata_tree_node_t **sub_node,
+            off64_t *offset,
+            libcerror_error_t **error )
+{
+	libcdata_tree_node_t *safe_sub_node               = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libfcache_cache_value_t *cache_value              = NULL;
+	static char *function                             = "libewf_single_file_name_index_get_sub_node_by_name_hash";
+	off64_t safe_offset                               = 0;
+	int result                                        = 0;
+
+	safe_offset = (off64_t) name_hash;
+
+	do
+	{
+		result = libfcache_cache_get_value_by_identifier(
+		          sub_nodes_cache,
+		          0,
+		          safe_offset,
+		          0,
+		          &cache_value,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from cache.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     (intptr_t **) &safe_sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node from cache value.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_value(
+		     safe_sub_node,
+		     (intptr_t **) &sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( sub_single_file_entry == NULL )
+		 || ( sub_single_file_entry->name == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid sub single file entry - missing name.",
+			 function );
+
+			return( -1 );
+		}
+		if( utf8_string != NULL )
+		{
+			result = libuna_utf8_string_compare_with_utf8_stream(
+			          utf8_string,
+			          utf8_string_length,
+			          sub_single_file_entry->name,
+			          (size_t) sub_single_file_entry->name_size,
+			          error );
+		}
+		else
+		{
+			result = libuna_utf16_string_compare_with_utf8_stream(
+			          utf16_string,
+			          utf16_string_length,
+			          sub_single_file_entry->name,
+			          (size_t) sub_single_file_entry->name_size,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to compare name.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*sub_node = safe_sub_node;
+
+			break;
+		}
+		safe_offset++;
+	}
+	while( safe_offset != (off64_t) name_hash );
+
+	*offset = safe_offset;
+
+	return( result );
+}
+
+/* Creates a name index of the sub nodes of a single file entry tree node
+ * Make sure the value name_index is referencing, is set to NULL
+ * Sub nodes without a name or with a name that cannot be decoded are not indexed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_initialize(
+     libewf_single_file_name_index_t **name_index,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *existing_sub_node           = NULL;
+	libcdata_tree_node_t *sub_node                    = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	static char *function                             = "libewf_single_file_name_index_initialize";
+	uint64_t name_hash                                = 0;
+	off64_t offset                                    = 0;
+	int number_of_sub_nodes                           = 0;
+	int result                                        = 0;
+	int sub_node_index                                = 0;
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid name index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sub nodes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sub_nodes < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sub nodes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*name_index = memory_allocate_structure(
+	               libewf_single_file_name_index_t );
+
+	if( *name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *name_index,
+	     0,
+	     sizeof( libewf_single_file_name_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear name index.",
+		 function );
+
+		memory_free(
+		 *name_index );
+
+		*name_index = NULL;
+
+		return( -1 );
+	}
+	/* Every sub node is stored with a value size of 1, hence a maximum size
+	 * of the number of sub nodes makes sure no sub node is evicted
+	 */
+	if( libfcache_cache_initialize_with_maximum_size(
+	     &( ( *name_index )->sub_nodes_cache ),
+	     (size64_t) number_of_sub_nodes + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sub nodes cache.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *name_index )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( number_of_sub_nodes == 0 )
+	{
+		return( 1 );
+	}
+	if( libcdata_tree_node_get_sub_node_by_index(
+	     node,
+	     0,
+	     &sub_node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first sub node.",
+		 function );
+
+		goto on_error;
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( libcdata_tree_node_get_value(
+		     sub_node,
+		     (intptr_t **) &sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+		if( sub_single_file_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing sub single file entry: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+		result = 0;
+
+		if( sub_single_file_entry->name != NULL )
+		{
+			result = libewf_single_file_name_index_get_hash_from_utf8_stream(
+			          sub_single_file_entry->name,
+			          sub_single_file_entry->name_size,
+			          &name_hash,
+			          error );
+
+			if( result != 1 )
+			{
+				/* A name that cannot be decoded cannot match either
+				 */
+				libcerror_error_free(
+				 error );
+			}
+		}
+		if( result == 1 )
+		{
+			result = libewf_single_file_name_index_get_sub_node_by_name_hash(
+			          ( *name_index )->sub_nodes_cache,
+			          name_hash,
+			          sub_single_file_entry->name,
+			          (size_t) sub_single_file_entry->name_size,
+			          NULL,
+			          0,
+			          &existing_sub_node,
+			          &offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve sub node by name hash: 0x%016" PRIx64 ".",
+				 function,
+				 name_hash );
+
+				goto on_error;
+			}
+			/* Only the first sub node with a specific name is found, as in the sub node list
+			 */
+			else if( result == 0 )
+			{
+				if( libfcache_cache_set_value_by_identifier(
+				     ( *name_index )->sub_nodes_cache,
+				     0,
+				     offset,
+				     0,
+				     (intptr_t *) sub_node,
+				     1,
+				     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_name_index_free_sub_node,
+				     LIBFCACHE_CACHE_VALUE_FLAG_NON_MANAGED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set sub node: %d in cache.",
+					 function,
+					 sub_node_index );
+
+					goto on_error;
+				}
+			}
+		}
+		if( libcdata_tree_node_get_next_node(
+		     sub_node,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next node from sub node: %d.",
+			 function,
+			 sub_node_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 name_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a name index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_free(
+     libewf_single_file_name_index_t **name_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_name_index_free";
+	int result            = 1;
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *name_index != NULL )
+	{
+		if( ( *name_index )->sub_nodes_cache != NULL )
+		{
+			if( libfcache_cache_free(
+			     &( ( *name_index )->sub_nodes_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub nodes cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *name_index )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *name_index )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		memory_free(
+		 *name_index );
+
+		*name_index = NULL;
+	}
+	return( result );
+}
+
+/* Calculates the name hash of an UTF-8 stream
+ * The UTF-8 stream is handled the same as by libuna_utf8_string_compare_with_utf8_stream
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_get_hash_from_utf8_stream(
+     const uint8_t *utf8_stream,
+     size_t utf8_stream_size,
+     uint64_t *name_hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_single_file_name_index_get_hash_from_utf8_stream";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf8_stream_index                     = 0;
+	uint64_t safe_name_hash                      = 0;
+
+	if( utf8_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_stream_size == 0 )
+	 || ( utf8_stream_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid UTF-8 stream size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check if UTF-8 stream starts with a byte order mark (BOM)
+	 */
+	if( utf8_stream_size >= 3 )
+	{
+		if( ( utf8_stream[ 0 ] == 0x0ef )
+		 && ( utf8_stream[ 1 ] == 0x0bb )
+		 && ( utf8_stream[ 2 ] == 0x0bf ) )
+		{
+			utf8_stream_index += 3;
+		}
+	}
+	if( utf8_stream[ utf8_stream_size - 1 ] == 0 )
+	{
+		utf8_stream_size -= 1;
+	}
+	safe_name_hash = libewf_single_file_name_index_hash_initialize();
+
+	while( utf8_stream_index < utf8_stream_size )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_stream,
+		     utf8_stream_size,
+		     &utf8_stream_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-8 stream.",
+			 function );
+
+			return( -1 );
+		}
+		safe_name_hash = libewf_single_file_name_index_hash_update(
+		                  safe_name_hash,
+		                  unicode_character );
+	}
+	*name_hash = safe_name_hash;
+
+	return( 1 );
+}
+
+/* Calculates the name hash of an UTF-8 string
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_get_hash_from_utf8_string(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint64_t *name_hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_single_file_name_index_get_hash_from_utf8_string";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf8_string_index                     = 0;
+	uint64_t safe_name_hash                      = 0;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_string_length > 0 )
+	 && ( utf8_string[ utf8_string_length - 1 ] == 0 ) )
+	{
+		utf8_string_length -= 1;
+	}
+	safe_name_hash = libewf_single_file_name_index_hash_initialize();
+
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-8 string.",
+			 function );
+
+			return( -1 );
+		}
+		safe_name_hash = libewf_single_file_name_index_hash_update(
+		                  safe_name_hash,
+		                  unicode_character );
+	}
+	*name_hash = safe_name_hash;
+
+	return( 1 );
+}
+
+/* Calculates the name hash of an UTF-16 string
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_file_name_index_get_hash_from_utf16_string(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint64_t *name_hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_single_file_name_index_get_hash_from_utf16_string";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf16_string_index                    = 0;
+	uint64_t safe_name_hash                      = 0;
+
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf16_string_length > 0 )
+	 && ( utf16_string[ utf16_string_length - 1 ] == 0 ) )
+	{
+		utf16_string_length -= 1;
+	}
+	safe_name_hash = libewf_single_file_name_index_hash_initialize();
+
+	while( utf16_string_index < utf16_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf16(
+		     &unicode_character,
+		     utf16_string,
+		     utf16_string_length,
+		     &utf16_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-16 string.",
+			 function );
+
+			return( -1 );
+		}
+		safe_name_hash = libewf_single_file_name_index_hash_update(
+		                  safe_name_hash,
+		                  unicode_character );
+	}
+	*name_hash = safe_name_hash;
+
+	return( 1 );
+}
+
+/* Retrieves the sub node for the specific UTF-8 formatted name
+ * Returns 1 if successful, 0 if no such sub node or -1 on error
+ */
+int libewf_single_file_name_index_get_sub_node_by_utf8_name(
+     libewf_single_file_name_index_t *name_index,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_name_index_get_sub_node_by_utf8_name";
+	uint64_t name_hash    = 0;
+	off64_t offset        = 0;
+	int result            = 0;
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_name_index_get_hash_from_utf8_string(
+	     utf8_string,
+	     utf8_string_length,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name hash.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     name_index->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_single_file_name_index_get_sub_node_by_name_hash(
+	          name_index->sub_nodes_cache,
+	          name_hash,
+	          utf8_string,
+	          utf8_string_length,
+	          NULL,
+	          0,
+	          sub_node,
+	          &offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node by name hash: 0x%016" PRIx64 ".",
+		 function,
+		 name_hash );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     name_index->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the sub node for the specific UTF-16 formatted name
+ * Returns 1 if successful, 0 if no such sub node or -1 on error
+ */
+int libewf_single_file_name_index_get_sub_node_by_utf16_name(
+     libewf_single_file_name_index_t *name_index,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_single_file_name_index_get_sub_node_by_utf16_name";
+	uint64_t name_hash    = 0;
+	off64_t offset        = 0;
+	int result            = 0;
+
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_single_file_name_index_get_hash_from_utf16_string(
+	     utf16_string,
+	     utf16_string_length,
+	     &name_hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve name hash.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     name_index->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_single_file_name_index_get_sub_node_by_name_hash(
+	          name_index->sub_nodes_cache,
+	          name_hash,
+	          NULL,
+	          0,
+	          utf16_string,
+	          utf16_string_length,
+	          sub_node,
+	          &offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sub node by name hash: 0x%016" PRIx64 ".",
+		 function,
+		 name_hash );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     name_index->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,100 @@
+/*
+ * Single file name index functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SINGLE_FILE_NAME_INDEX_H )
+#define _LIBEWF_SINGLE_FILE_NAME_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfcache.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_single_file_name_index libewf_single_file_name_index_t;
+
+struct libewf_single_file_name_index
+{
+	/* The sub nodes cache
+	 * Contains the sub nodes by the hash of their name, sub nodes are never evicted
+	 */
+	libfcache_cache_t *sub_nodes_cache;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 * A lookup changes the least recently used order of the sub nodes cache
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_single_file_name_index_initialize(
+     libewf_single_file_name_index_t **name_index,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_free(
+     libewf_single_file_name_index_t **name_index,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_hash_from_utf8_stream(
+     const uint8_t *utf8_stream,
+     size_t utf8_stream_size,
+     uint64_t *name_hash,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_hash_from_utf8_string(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint64_t *name_hash,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_hash_from_utf16_string(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint64_t *name_hash,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_sub_node_by_utf8_name(
+     libewf_single_file_name_index_t *name_index,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error );
+
+int libewf_single_file_name_index_get_sub_node_by_utf16_name(
+     libewf_single_file_name_index_t *name_index,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SINGLE_FILE_NAME_INDEX_H ) */
+
@@ -22,16 +22,20 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_definitions.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_libuna.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
 #include "libewf_single_file_tree.h"
+#include "libewf_single_files.h"
 
 /* Retrieves the single file entry sub node for the specific UTF-8 formatted name
  * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
  */
 int libewf_single_file_tree_get_sub_node_by_utf8_name(
+     libewf_single_files_t *single_files,
      libcdata_tree_node_t *node,
      const uint8_t *utf8_string,
      size_t utf8_string_length,
@@ -39,10 +43,11 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
      libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error )
 {
-	static char *function   = "libewf_single_file_tree_get_sub_node_by_utf8_name";
-	int number_of_sub_nodes = 0;
-	int result              = 0;
-	int sub_node_index      = 0;
+	libewf_single_file_name_index_t *name_index = NULL;
+	static char *function                       = "libewf_single_file_tree_get_sub_node_by_utf8_name";
+	int number_of_sub_nodes                     = 0;
+	int result                                  = 0;
+	int sub_node_index                          = 0;
 
 	if( node == NULL )
 	{
@@ -91,6 +96,67 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
 
 		goto on_error;
 	}
+	/* Large directories are looked up by the hash of the name instead of comparing all names
+	 */
+	if( ( single_files != NULL )
+	 && ( number_of_sub_nodes >= LIBEWF_SINGLE_FILE_NAME_INDEX_MINIMUM_NUMBER_OF_SUB_ENTRIES ) )
+	{
+		if( libewf_single_files_get_sub_entries_name_index(
+		     single_files,
+		     node,
+		     &name_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub entries name index.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+		          name_index,
+		          utf8_string,
+		          utf8_string_length,
+		          sub_node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node by UTF-8 name from name index.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			*sub_node              = NULL;
+			*sub_single_file_entry = NULL;
+
+			return( 0 );
+		}
+		if( libcdata_tree_node_get_value(
+		     *sub_node,
+		     (intptr_t **) sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
 	if( libcdata_tree_node_get_sub_node_by_index(
 	     node,
 	     0,
@@ -197,6 +263,7 @@ on_error:
  * Returns 1 if successful, 0 if no such sub single file entry or -1 on error
  */
 int libewf_single_file_tree_get_sub_node_by_utf16_name(
+     libewf_single_files_t *single_files,
      libcdata_tree_node_t *node,
      const uint16_t *utf16_string,
      size_t utf16_string_length,
@@ -204,10 +271,11 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
      libewf_single_file_entry_t **sub_single_file_entry,
      libcerror_error_t **error )
 {
-	static char *function   = "libewf_single_file_tree_get_sub_node_by_utf16_name";
-	int number_of_sub_nodes = 0;
-	int result              = 0;
-	int sub_node_index      = 0;
+	libewf_single_file_name_index_t *name_index = NULL;
+	static char *function                       = "libewf_single_file_tree_get_sub_node_by_utf16_name";
+	int number_of_sub_nodes                     = 0;
+	int result                                  = 0;
+	int sub_node_index                          = 0;
 
 	if( node == NULL )
 	{
@@ -256,6 +324,67 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
 
 		goto on_error;
 	}
+	/* Large directories are looked up by the hash of the name instead of comparing all names
+	 */
+	if( ( single_files != NULL )
+	 && ( number_of_sub_nodes >= LIBEWF_SINGLE_FILE_NAME_INDEX_MINIMUM_NUMBER_OF_SUB_ENTRIES ) )
+	{
+		if( libewf_single_files_get_sub_entries_name_index(
+		     single_files,
+		     node,
+		     &name_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub entries name index.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+		          name_index,
+		          utf16_string,
+		          utf16_string_length,
+		          sub_node,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sub node by UTF-16 name from name index.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			*sub_node              = NULL;
+			*sub_single_file_entry = NULL;
+
+			return( 0 );
+		}
+		if( libcdata_tree_node_get_value(
+		     *sub_node,
+		     (intptr_t **) sub_single_file_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from sub node.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
 	if( libcdata_tree_node_get_sub_node_by_index(
 	     node,
 	     0,
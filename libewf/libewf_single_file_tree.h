@@ -28,12 +28,14 @@
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_files.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
 int libewf_single_file_tree_get_sub_node_by_utf8_name(
+     libewf_single_files_t *single_files,
      libcdata_tree_node_t *single_file_tree_node,
      const uint8_t *utf8_string,
      size_t utf8_string_length,
@@ -42,6 +44,7 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
      libcerror_error_t **error );
 
 int libewf_single_file_tree_get_sub_node_by_utf16_name(
+     libewf_single_files_t *single_files,
      libcdata_tree_node_t *single_file_tree_node,
      const uint16_t *utf16_string,
      size_t utf16_string_length,
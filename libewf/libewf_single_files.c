@@ -26,11 +26,16 @@
 
 #include "libewf_definitions.h"
 #include "libewf_libcdata.h"
+#include "libewf_arena.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfvalue.h"
 #include "libewf_libuna.h"
+#include "libewf_ltree_line_reader.h"
+#include "libewf_ltree_segments.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
 #include "libewf_single_files.h"
 
 /* Creates single files
@@ -91,13 +96,53 @@ int libewf_single_files_initialize(
 		 "%s: unable to clear single files.",
 		 function );
 
+		memory_free(
+		 *single_files );
+
+		*single_files = NULL;
+
+		return( -1 );
+	}
+	if( libewf_arena_initialize(
+	     &( ( *single_files )->arena ),
+	     LIBEWF_SINGLE_FILES_ARENA_BLOCK_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create arena.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *single_files )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
 		goto on_error;
 	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *single_files != NULL )
 	{
+		if( ( *single_files )->arena != NULL )
+		{
+			libewf_arena_free(
+			 &( ( *single_files )->arena ),
+			 NULL );
+		}
 		memory_free(
 		 *single_files );
 
@@ -138,7 +183,7 @@ int libewf_single_files_free(
 		{
 			if( libcdata_tree_node_free(
 			     &( ( *single_files )->root_file_entry_node ),
-			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free_from_arena,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -151,6 +196,36 @@ int libewf_single_files_free(
 				result = -1;
 			}
 		}
+		/* The arena is freed after the tree since the tree references the single file entries in it
+		 */
+		if( libewf_arena_free(
+		     &( ( *single_files )->arena ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free arena.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *single_files )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *single_files );
 
@@ -159,18 +234,19 @@ int libewf_single_files_free(
 	return( result );
 }
 
-/* Parse an EWF ltree for the values
+/* Retrieves the name index of the sub entries of a single file entry tree node
+ * The name index is created on the first call and remains valid until the single files are freed
  * Returns 1 if successful or -1 on error
  */
-int libewf_single_files_parse(
+int libewf_single_files_get_sub_entries_name_index(
      libewf_single_files_t *single_files,
-     size64_t *media_size,
-     uint8_t *format,
+     libcdata_tree_node_t *node,
+     libewf_single_file_name_index_t **name_index,
      libcerror_error_t **error )
 {
-	uint8_t *file_entries_string    = NULL;
-	static char *function           = "libewf_single_files_parse";
-	size_t file_entries_string_size = 0;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	static char *function                         = "libewf_single_files_get_sub_entries_name_index";
+	int result                                    = 1;
 
 	if( single_files == NULL )
 	{
@@ -183,50 +259,169 @@ int libewf_single_files_parse(
 
 		return( -1 );
 	}
-	if( single_files->ltree_data == NULL )
+	if( name_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid single files - missing ltree data.",
+		 "%s: missing single file entry.",
 		 function );
 
 		return( -1 );
 	}
-	if( libuna_utf8_string_size_from_utf16_stream(
-	     single_files->ltree_data,
-	     single_files->ltree_data_size,
-	     LIBUNA_ENDIAN_LITTLE,
-	     &file_entries_string_size,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     single_files->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to determine file entries string size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	file_entries_string = (uint8_t *) memory_allocate(
-	                                   sizeof( uint8_t ) * (size_t) file_entries_string_size );
+#endif
+	*name_index = single_file_entry->sub_entries_name_index;
 
-	if( file_entries_string == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     single_files->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create file entries string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+#endif
+	if( *name_index != NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     single_files->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* Another thread could have created the name index in the meantime
+	 */
+	if( single_file_entry->sub_entries_name_index == NULL )
+	{
+		if( libewf_single_file_name_index_initialize(
+		     &( single_file_entry->sub_entries_name_index ),
+		     node,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sub entries name index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	*name_index = single_file_entry->sub_entries_name_index;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     single_files->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Parse an EWF ltree for the values
+ * The UTF-16 ltree data is read line by line, without converting it as a whole
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_single_files_parse(
+     libewf_single_files_t *single_files,
+     size64_t *media_size,
+     uint8_t *format,
+     libcerror_error_t **error )
+{
+	libewf_ltree_line_reader_t *line_reader = NULL;
+	static char *function                   = "libewf_single_files_parse";
+
+	if( single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid single files.",
+		 function );
+
+		return( -1 );
+	}
+	if( single_files->ltree_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid single files - missing ltree data.",
+		 function );
+
+		return( -1 );
 	}
-	if( libuna_utf8_string_copy_from_utf16_stream(
-	     file_entries_string,
-	     file_entries_string_size,
+	if( libewf_ltree_line_reader_initialize(
+	     &line_reader,
 	     single_files->ltree_data,
 	     single_files->ltree_data_size,
 	     LIBUNA_ENDIAN_LITTLE,
@@ -234,9 +429,9 @@ int libewf_single_files_parse(
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-		 LIBCERROR_CONVERSION_ERROR_GENERIC,
-		 "%s: unable to set file entries string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create line reader.",
 		 function );
 
 		goto on_error;
@@ -244,8 +439,7 @@ int libewf_single_files_parse(
 	if( libewf_single_files_parse_file_entries(
 	     single_files,
 	     media_size,
-	     file_entries_string,
-	     file_entries_string_size,
+	     line_reader,
 	     format,
 	     error ) != 1 )
 	{
@@ -258,38 +452,48 @@ int libewf_single_files_parse(
 
 		goto on_error;
 	}
-	memory_free(
-	 file_entries_string );
+	if( libewf_ltree_line_reader_free(
+	     &line_reader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free line reader.",
+		 function );
 
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
-	if( file_entries_string != NULL )
+	if( line_reader != NULL )
 	{
-		memory_free(
-		 file_entries_string );
+		libewf_ltree_line_reader_free(
+		 &line_reader,
+		 NULL );
 	}
 	return( -1 );
 }
 
-/* Parse a single file entries string for the values
+/* Parse the single file entries lines for the values
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entries(
      libewf_single_files_t *single_files,
      size64_t *media_size,
-     const uint8_t *entries_string,
-     size_t entries_string_size,
+     libewf_ltree_line_reader_t *line_reader,
      uint8_t *format,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *lines = NULL;
-	libfvalue_split_utf8_string_t *types = NULL;
-	uint8_t *line_string                 = NULL;
-	static char *function                = "libewf_single_files_parse_file_entries";
-	size_t line_string_size              = 0;
-	int line_index                       = 0;
-	int number_of_lines                  = 0;
+	libewf_ltree_segments_t *offset_values = NULL;
+	libewf_ltree_segments_t *types         = NULL;
+	libewf_ltree_segments_t *values        = NULL;
+	uint8_t *line_string                   = NULL;
+	static char *function                  = "libewf_single_files_parse_file_entries";
+	size_t line_string_size                = 0;
+	int result                             = 0;
 
 	if( single_files == NULL )
 	{
@@ -302,52 +506,73 @@ int libewf_single_files_parse_file_entries(
 
 		return( -1 );
 	}
-	if( entries_string == NULL )
+	if( line_reader == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid entries string.",
+		 "%s: invalid line reader.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_utf8_string_split(
-	     entries_string,
-	     entries_string_size - 1,
-	     (uint8_t) '\n',
-	     &lines,
-	     error ) != 1 )
+	if( line_reader->number_of_lines > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split entries string into lines.",
-		 function );
+		if( libewf_ltree_segments_initialize(
+		     &types,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create types.",
+			 function );
 
-		goto on_error;
-	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines",
-		 function );
+			goto on_error;
+		}
+		if( libewf_ltree_segments_initialize(
+		     &values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create values.",
+			 function );
 
-		goto on_error;
-	}
-	if( number_of_lines > 0 )
-	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
-		     lines,
-		     0,
+			goto on_error;
+		}
+		if( libewf_ltree_segments_initialize(
+		     &offset_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create offset values.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_ltree_line_reader_rewind(
+		     line_reader,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to rewind line reader.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_ltree_line_reader_read_line(
+		     line_reader,
 		     &line_string,
 		     &line_string_size,
 		     error ) != 1 )
@@ -407,16 +632,28 @@ int libewf_single_files_parse_file_entries(
 		}
 		/* Find the line containing: "rec"
 		 */
-		for( line_index = 0;
-		     line_index < number_of_lines;
-		     line_index++ )
+		if( libewf_ltree_line_reader_rewind(
+		     line_reader,
+		     error ) != 1 )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to rewind line reader.",
+			 function );
+
+			goto on_error;
+		}
+		do
+		{
+			result = libewf_ltree_line_reader_read_line(
+			          line_reader,
+			          &line_string,
+			          &line_string_size,
+			          error );
+
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -424,38 +661,28 @@ int libewf_single_files_parse_file_entries(
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 				 "%s: unable to retrieve line string: %d.",
 				 function,
-				 line_index );
+				 line_reader->next_line_index );
 
 				goto on_error;
 			}
-			if( line_string_size == 4 )
+			else if( ( result != 0 )
+			      && ( line_string_size == 4 ) )
 			{
-				if( line_string == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing line string: %d.",
-					 function,
-					 line_index );
-
-					goto on_error;
-				}
 				if( ( line_string[ 0 ] == (uint8_t) 'r' )
 				 && ( line_string[ 1 ] == (uint8_t) 'e' )
 				 && ( line_string[ 2 ] == (uint8_t) 'c' ) )
 				{
-					line_index += 1;
-
 					break;
 				}
 			}
 		}
+		while( result != 0 );
+
 		if( libewf_single_files_parse_record_values(
 		     media_size,
-		     lines,
-		     &line_index,
+		     line_reader,
+		     types,
+		     values,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -469,16 +696,28 @@ int libewf_single_files_parse_file_entries(
 		}
 		/* Find the line containing: "entry"
 		 */
-		for( line_index = 0;
-		     line_index < number_of_lines;
-		     line_index++ )
+		if( libewf_ltree_line_reader_rewind(
+		     line_reader,
+		     error ) != 1 )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to rewind line reader.",
+			 function );
+
+			goto on_error;
+		}
+		do
+		{
+			result = libewf_ltree_line_reader_read_line(
+			          line_reader,
+			          &line_string,
+			          &line_string_size,
+			          error );
+
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -486,62 +725,63 @@ int libewf_single_files_parse_file_entries(
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 				 "%s: unable to retrieve line string: %d.",
 				 function,
-				 line_index );
+				 line_reader->next_line_index );
 
 				goto on_error;
 			}
-			if( line_string_size == 6 )
+			else if( ( result != 0 )
+			      && ( line_string_size == 6 ) )
 			{
-				if( line_string == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing line string: %d.",
-					 function,
-					 line_index );
-
-					goto on_error;
-				}
 				if( ( line_string[ 0 ] == (uint8_t) 'e' )
 				 && ( line_string[ 1 ] == (uint8_t) 'n' )
 				 && ( line_string[ 2 ] == (uint8_t) 't' )
 				 && ( line_string[ 3 ] == (uint8_t) 'r' )
 				 && ( line_string[ 4 ] == (uint8_t) 'y' ) )
 				{
-					line_index += 2;
-
 					break;
 				}
 			}
 		}
-		if( line_index < number_of_lines )
-		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
-			     &line_string,
-			     &line_string_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve line string: %d.",
-				 function,
-				 line_index );
+		while( result != 0 );
 
-				goto on_error;
-			}
-			line_index += 1;
+		/* The line containing "entry" is followed by a line that is ignored
+		 * and the line containing the types
+		 */
+		if( result != 0 )
+		{
+			result = libewf_ltree_line_reader_read_line(
+			          line_reader,
+			          &line_string,
+			          &line_string_size,
+			          error );
+		}
+		if( result == 1 )
+		{
+			result = libewf_ltree_line_reader_read_line(
+			          line_reader,
+			          &line_string,
+			          &line_string_size,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve line string: %d.",
+			 function,
+			 line_reader->next_line_index );
 
-			if( libfvalue_utf8_string_split(
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( libewf_ltree_segments_split(
+			     types,
 			     line_string,
 			     line_string_size,
 			     (uint8_t) '\t',
-			     &types,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -568,9 +808,11 @@ int libewf_single_files_parse_file_entries(
 			}
 			if( libewf_single_files_parse_file_entry(
 			     single_files->root_file_entry_node,
-			     lines,
-			     &line_index,
+			     single_files->arena,
+			     line_reader,
 			     types,
+			     values,
+			     offset_values,
 			     format,
 			     error ) != 1 )
 			{
@@ -585,9 +827,8 @@ int libewf_single_files_parse_file_entries(
 			}
 			/* The single files entries should be followed by an empty line
 			 */
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     lines,
-			     line_index,
+			if( libewf_ltree_line_reader_read_line(
+			     line_reader,
 			     &line_string,
 			     &line_string_size,
 			     error ) != 1 )
@@ -598,7 +839,7 @@ int libewf_single_files_parse_file_entries(
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 				 "%s: unable to retrieve line string: %d.",
 				 function,
-				 line_index );
+				 line_reader->next_line_index );
 
 				goto on_error;
 			}
@@ -611,78 +852,97 @@ int libewf_single_files_parse_file_entries(
 				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
 				 "%s: unsupported empty line string: %d - not empty.",
 				 function,
-				 line_index );
+				 line_reader->next_line_index - 1 );
 
 				goto on_error;
 			}
 		}
-		if( libfvalue_split_utf8_string_free(
-		     &types,
+		if( libewf_ltree_segments_free(
+		     &offset_values,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free split types.",
+			 "%s: unable to free offset values.",
 			 function );
 
 			goto on_error;
 		}
-	}
-	if( libfvalue_split_utf8_string_free(
-	     &lines,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split lines.",
-		 function );
+		if( libewf_ltree_segments_free(
+		     &values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free values.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( libewf_ltree_segments_free(
+		     &types,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free types.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	return( 1 );
 
 on_error:
-	if( types != NULL )
+	if( offset_values != NULL )
 	{
-		libfvalue_split_utf8_string_free(
-		 &types,
+		libewf_ltree_segments_free(
+		 &offset_values,
+		 NULL );
+	}
+	if( values != NULL )
+	{
+		libewf_ltree_segments_free(
+		 &values,
 		 NULL );
 	}
-	if( lines != NULL )
+	if( types != NULL )
 	{
-		libfvalue_split_utf8_string_free(
-		 &lines,
+		libewf_ltree_segments_free(
+		 &types,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Parse a record string for the values
+/* Parse the record lines for the values
+ * The types and values segments are reused to split the record lines
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_record_values(
      size64_t *media_size,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_ltree_line_reader_t *line_reader,
+     libewf_ltree_segments_t *types,
+     libewf_ltree_segments_t *values,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *types  = NULL;
-	libfvalue_split_utf8_string_t *values = NULL;
-	uint8_t *line_string                  = NULL;
-	uint8_t *type_string                  = NULL;
-	uint8_t *value_string                 = NULL;
-	static char *function                 = "libewf_single_files_parse_record_values";
-	size_t line_string_size               = 0;
-	size_t type_string_size               = 0;
-	size_t value_string_size              = 0;
-	uint64_t value_64bit                  = 0;
-	int number_of_types                   = 0;
-	int number_of_values                  = 0;
-	int value_index                       = 0;
+	uint8_t *line_string     = NULL;
+	uint8_t *type_string     = NULL;
+	uint8_t *value_string    = NULL;
+	static char *function    = "libewf_single_files_parse_record_values";
+	size_t line_string_size  = 0;
+	size_t type_string_size  = 0;
+	size_t value_string_size = 0;
+	uint64_t value_64bit     = 0;
+	int number_of_types      = 0;
+	int number_of_values     = 0;
+	int value_index          = 0;
 
 	if( media_size == NULL )
 	{
@@ -695,20 +955,19 @@ int libewf_single_files_parse_record_values(
 
 		return( -1 );
 	}
-	if( line_index == NULL )
+	if( line_reader == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 "%s: invalid line reader.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_ltree_line_reader_read_line(
+	     line_reader,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
@@ -719,17 +978,15 @@ int libewf_single_files_parse_record_values(
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve line string: %d.",
 		 function,
-		 *line_index );
+		 line_reader->next_line_index );
 
-		goto on_error;
+		return( -1 );
 	}
-	*line_index += 1;
-
-	if( libfvalue_utf8_string_split(
+	if( libewf_ltree_segments_split(
+	     types,
 	     line_string,
 	     line_string_size,
 	     (uint8_t) '\t',
-	     &types,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -739,9 +996,9 @@ int libewf_single_files_parse_record_values(
 		 "%s: unable to split entries string into types.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
+	if( libewf_ltree_segments_get_number_of_segments(
 	     types,
 	     &number_of_types,
 	     error ) != 1 )
@@ -753,11 +1010,10 @@ int libewf_single_files_parse_record_values(
 		 "%s: unable to retrieve number of types",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_ltree_line_reader_read_line(
+	     line_reader,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
@@ -768,17 +1024,15 @@ int libewf_single_files_parse_record_values(
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve line string: %d.",
 		 function,
-		 *line_index );
+		 line_reader->next_line_index );
 
-		goto on_error;
+		return( -1 );
 	}
-	*line_index += 1;
-
-	if( libfvalue_utf8_string_split(
+	if( libewf_ltree_segments_split(
+	     values,
 	     line_string,
 	     line_string_size,
 	     (uint8_t) '\t',
-	     &values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -788,9 +1042,9 @@ int libewf_single_files_parse_record_values(
 		 "%s: unable to split entries string into values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
+	if( libewf_ltree_segments_get_number_of_segments(
 	     values,
 	     &number_of_values,
 	     error ) != 1 )
@@ -802,7 +1056,7 @@ int libewf_single_files_parse_record_values(
 		 "%s: unable to retrieve number of values",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_VERBOSE_OUTPUT )
 	if( number_of_types != number_of_values )
@@ -819,7 +1073,7 @@ int libewf_single_files_parse_record_values(
 	     value_index < number_of_types;
 	     value_index++ )
 	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
+		if( libewf_ltree_segments_get_segment_by_index(
 		     types,
 		     value_index,
 		     &type_string,
@@ -834,7 +1088,7 @@ int libewf_single_files_parse_record_values(
 			 function,
 			 value_index );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( ( type_string == NULL )
 		 || ( type_string_size < 2 )
@@ -848,7 +1102,7 @@ int libewf_single_files_parse_record_values(
 			 function,
 			 value_index );
 
-			goto on_error;
+			return( -1 );
 		}
 		/* Remove trailing carriage return
 		 */
@@ -860,7 +1114,7 @@ int libewf_single_files_parse_record_values(
 		}
 		if( value_index < number_of_values )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
+			if( libewf_ltree_segments_get_segment_by_index(
 			     values,
 			     value_index,
 			     &value_string,
@@ -875,7 +1129,7 @@ int libewf_single_files_parse_record_values(
 				 function,
 				 value_index );
 
-				goto on_error;
+				return( -1 );
 			}
 			if( ( value_string == NULL )
 			 || ( value_string_size < 2 )
@@ -938,69 +1192,30 @@ int libewf_single_files_parse_record_values(
 					 "%s: unable to set media size.",
 					 function );
 
-					goto on_error;
+					return( -1 );
 				}
 				*media_size = (size64_t) value_64bit;
 			}
 		}
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split values.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfvalue_split_utf8_string_free(
-	     &types,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split types.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
-
-on_error:
-	if( values != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &values,
-		 NULL );
-	}
-	if( types != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &types,
-		 NULL );
-	}
-	return( -1 );
 }
 
+
 /* Parse a single file entry string for the values
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entry(
      libcdata_tree_node_t *parent_file_entry_node,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
-     libfvalue_split_utf8_string_t *types,
+     libewf_arena_t *arena,
+     libewf_ltree_line_reader_t *line_reader,
+     libewf_ltree_segments_t *types,
+     libewf_ltree_segments_t *values,
+     libewf_ltree_segments_t *offset_values,
      uint8_t *format,
      libcerror_error_t **error )
 {
 	libewf_single_file_entry_t *single_file_entry = NULL;
-	libfvalue_split_utf8_string_t *values         = NULL;
 	libcdata_tree_node_t *file_entry_node         = NULL;
 	uint8_t *line_string                          = NULL;
 	uint8_t *type_string                          = NULL;
@@ -1012,7 +1227,6 @@ int libewf_single_files_parse_file_entry(
 	size_t value_string_index                     = 0;
 	uint64_t number_of_sub_entries                = 0;
 	uint64_t value_64bit                          = 0;
-	int number_of_lines                           = 0;
 	int number_of_types                           = 0;
 	int number_of_values                          = 0;
 	int value_index                               = 0;
@@ -1029,13 +1243,13 @@ int libewf_single_files_parse_file_entry(
 
 		return( -1 );
 	}
-	if( line_index == NULL )
+	if( line_reader == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 "%s: invalid line reader.",
 		 function );
 
 		return( -1 );
@@ -1051,7 +1265,7 @@ int libewf_single_files_parse_file_entry(
 
 		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
+	if( libewf_ltree_segments_get_number_of_segments(
 	     types,
 	     &number_of_types,
 	     error ) != 1 )
@@ -1066,8 +1280,8 @@ int libewf_single_files_parse_file_entry(
 		goto on_error;
 	}
 	if( libewf_single_files_parse_file_entry_number_of_sub_entries(
-	     lines,
-	     line_index,
+	     line_reader,
+	     values,
 	     &number_of_sub_entries,
 	     error ) != 1 )
 	{
@@ -1080,9 +1294,8 @@ int libewf_single_files_parse_file_entry(
 
 		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_ltree_line_reader_read_line(
+	     line_reader,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
@@ -1093,17 +1306,15 @@ int libewf_single_files_parse_file_entry(
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve line string: %d.",
 		 function,
-		 *line_index );
+		 line_reader->next_line_index );
 
 		goto on_error;
 	}
-	*line_index += 1;
-
-	if( libfvalue_utf8_string_split(
+	if( libewf_ltree_segments_split(
+	     values,
 	     line_string,
 	     line_string_size,
 	     (uint8_t) '\t',
-	     &values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1115,7 +1326,7 @@ int libewf_single_files_parse_file_entry(
 
 		goto on_error;
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
+	if( libewf_ltree_segments_get_number_of_segments(
 	     values,
 	     &number_of_values,
 	     error ) != 1 )
@@ -1140,8 +1351,9 @@ int libewf_single_files_parse_file_entry(
 		}
 	}
 #endif
-	if( libewf_single_file_entry_initialize(
+	if( libewf_single_file_entry_initialize_from_arena(
 	     &single_file_entry,
+	     arena,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1157,7 +1369,7 @@ int libewf_single_files_parse_file_entry(
 	     value_index < number_of_types;
 	     value_index++ )
 	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
+		if( libewf_ltree_segments_get_segment_by_index(
 		     types,
 		     value_index,
 		     &type_string,
@@ -1198,7 +1410,7 @@ int libewf_single_files_parse_file_entry(
 		}
 		if( value_index < number_of_values )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
+			if( libewf_ltree_segments_get_segment_by_index(
 			     values,
 			     value_index,
 			     &value_string,
@@ -1306,10 +1518,11 @@ int libewf_single_files_parse_file_entry(
 			      && ( type_string[ 1 ] == (uint8_t) 'h' )
 			      && ( type_string[ 2 ] == (uint8_t) 'a' ) )
 			{
-				single_file_entry->sha1_hash = (uint8_t *) memory_allocate(
-				                                            sizeof( uint8_t ) * value_string_size );
-
-				if( single_file_entry->sha1_hash == NULL )
+				if( libewf_arena_allocate(
+				     arena,
+				     sizeof( uint8_t ) * value_string_size,
+				     &( single_file_entry->sha1_hash ),
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
@@ -1403,6 +1616,7 @@ int libewf_single_files_parse_file_entry(
 			{
 				if( libewf_single_files_parse_file_entry_offset_values(
 				     single_file_entry,
+				     offset_values,
 				     value_string,
 				     value_string_size,
 				     error ) != 1 )
@@ -1485,10 +1699,11 @@ int libewf_single_files_parse_file_entry(
 			else if( ( type_string[ 0 ] == (uint8_t) 'h' )
 			      && ( type_string[ 1 ] == (uint8_t) 'a' ) )
 			{
-				single_file_entry->md5_hash = (uint8_t *) memory_allocate(
-				                                           sizeof( uint8_t ) * value_string_size );
-
-				if( single_file_entry->md5_hash == NULL )
+				if( libewf_arena_allocate(
+				     arena,
+				     sizeof( uint8_t ) * value_string_size,
+				     &( single_file_entry->md5_hash ),
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
@@ -1640,10 +1855,11 @@ int libewf_single_files_parse_file_entry(
 			 */
 			if( type_string[ 0 ] == (uint8_t) 'n' )
 			{
-				single_file_entry->name = (uint8_t *) memory_allocate(
-								       sizeof( uint8_t ) * value_string_size );
-
-				if( single_file_entry->name == NULL )
+				if( libewf_arena_allocate(
+				     arena,
+				     sizeof( uint8_t ) * value_string_size,
+				     &( single_file_entry->name ),
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
@@ -1699,19 +1915,6 @@ int libewf_single_files_parse_file_entry(
 		 "\n" );
 	}
 #endif
-	if( libfvalue_split_utf8_string_free(
-	     &values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split values.",
-		 function );
-
-		goto on_error;
-	}
 	if( libcdata_tree_node_set_value(
 	     parent_file_entry_node,
 	     (intptr_t *) single_file_entry,
@@ -1728,21 +1931,7 @@ int libewf_single_files_parse_file_entry(
 	}
 	single_file_entry = NULL;
 
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     lines,
-	     &number_of_lines,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of lines",
-		 function );
-
-		goto on_error;
-	}
-	if( ( *line_index + number_of_sub_entries ) > (uint64_t) number_of_lines )
+	if( ( (uint64_t) line_reader->next_line_index + number_of_sub_entries ) > (uint64_t) line_reader->number_of_lines )
 	{
 		libcerror_error_set(
 		 error,
@@ -1770,9 +1959,11 @@ int libewf_single_files_parse_file_entry(
 		}
 		if( libewf_single_files_parse_file_entry(
 		     file_entry_node,
-		     lines,
-		     line_index,
+		     arena,
+		     line_reader,
 		     types,
+		     values,
+		     offset_values,
 		     format,
 		     error ) != 1 )
 		{
@@ -1810,19 +2001,7 @@ on_error:
 	{
 		libcdata_tree_node_free(
 		 &file_entry_node,
-		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
-		 NULL );
-	}
-	if( single_file_entry != NULL )
-	{
-		libewf_single_file_entry_free(
-		 &single_file_entry,
-		 NULL );
-	}
-	if( values != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &values,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free_from_arena,
 		 NULL );
 	}
 	return( -1 );
@@ -1832,33 +2011,31 @@ on_error:
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entry_number_of_sub_entries(
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_ltree_line_reader_t *line_reader,
+     libewf_ltree_segments_t *values,
      uint64_t *number_of_sub_entries,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *values = NULL;
-	uint8_t *line_string                  = NULL;
-	uint8_t *value_string                 = NULL;
-	static char *function                 = "libewf_single_files_parse_file_entry_number_of_sub_entries";
-	size_t line_string_size               = 0;
-	size_t value_string_size              = 0;
-	int number_of_values                  = 0;
+	uint8_t *line_string     = NULL;
+	uint8_t *value_string    = NULL;
+	static char *function    = "libewf_single_files_parse_file_entry_number_of_sub_entries";
+	size_t line_string_size  = 0;
+	size_t value_string_size = 0;
+	int number_of_values     = 0;
 
-	if( line_index == NULL )
+	if( line_reader == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid line index.",
+		 "%s: invalid line reader.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
-	     lines,
-	     *line_index,
+	if( libewf_ltree_line_reader_read_line(
+	     line_reader,
 	     &line_string,
 	     &line_string_size,
 	     error ) != 1 )
@@ -1869,17 +2046,15 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 		 "%s: unable to retrieve line string: %d.",
 		 function,
-		 *line_index );
+		 line_reader->next_line_index );
 
-		goto on_error;
+		return( -1 );
 	}
-	*line_index += 1;
-
-	if( libfvalue_utf8_string_split(
+	if( libewf_ltree_segments_split(
+	     values,
 	     line_string,
 	     line_string_size,
 	     (uint8_t) '\t',
-	     &values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -1889,9 +2064,9 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 		 "%s: unable to split entries string into values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
+	if( libewf_ltree_segments_get_number_of_segments(
 	     values,
 	     &number_of_values,
 	     error ) != 1 )
@@ -1903,7 +2078,7 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 		 "%s: unable to retrieve number of values",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( number_of_values != 2 )
 	{
@@ -1914,9 +2089,9 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 		 "%s: unsupported number of values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
+	if( libewf_ltree_segments_get_segment_by_index(
 	     values,
 	     0,
 	     &value_string,
@@ -1930,7 +2105,7 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 		 "%s: unable to retrieve value string: 0.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( value_string_size == 2 )
 	{
@@ -1944,7 +2119,7 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 			 function,
 			 value_string[ 0 ] );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	else if( value_string_size == 3 )
@@ -1961,7 +2136,7 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 			 value_string[ 0 ],
 			 value_string[ 1 ] );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	else
@@ -1973,9 +2148,9 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 		 "%s: unsupported first value.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_segment_by_index(
+	if( libewf_ltree_segments_get_segment_by_index(
 	     values,
 	     1,
 	     &value_string,
@@ -1989,7 +2164,7 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 		 "%s: unable to retrieve value string: 1.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( libfvalue_utf8_string_copy_to_integer(
 	     value_string,
@@ -2006,48 +2181,27 @@ int libewf_single_files_parse_file_entry_number_of_sub_entries(
 		 "%s: unable to set number fo sub entries.",
 		 function );
 
-		goto on_error;
-	}
-	if( libfvalue_split_utf8_string_free(
-	     &values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split values.",
-		 function );
-
-		goto on_error;
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( values != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &values,
-		 NULL );
-	}
-	return( -1 );
 }
 
 /* Parse a single file entry offset values string for the values
+ * The offset values segments are reused to split the offset values string
  * Returns 1 if successful or -1 on error
  */
 int libewf_single_files_parse_file_entry_offset_values(
      libewf_single_file_entry_t *single_file_entry,
+     libewf_ltree_segments_t *offset_values,
      const uint8_t *offset_values_string,
      size_t offset_values_string_size,
      libcerror_error_t **error )
 {
-	libfvalue_split_utf8_string_t *offset_values  = NULL;
-	uint8_t *offset_value_string                  = NULL;
-	static char *function                         = "libewf_single_files_parse_file_entry_offset_values";
-	size_t offset_value_string_size               = 0;
-	uint64_t value_64bit                          = 0;
-	int number_of_offset_values                   = 0;
+	uint8_t *offset_value_string    = NULL;
+	static char *function           = "libewf_single_files_parse_file_entry_offset_values";
+	size_t offset_value_string_size = 0;
+	uint64_t value_64bit            = 0;
+	int number_of_offset_values     = 0;
 
 	if( single_file_entry == NULL )
 	{
@@ -2060,11 +2214,11 @@ int libewf_single_files_parse_file_entry_offset_values(
 
 		return( -1 );
 	}
-	if( libfvalue_utf8_string_split(
+	if( libewf_ltree_segments_split(
+	     offset_values,
 	     offset_values_string,
 	     offset_values_string_size,
 	     (uint8_t) ' ',
-	     &offset_values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -2074,9 +2228,9 @@ int libewf_single_files_parse_file_entry_offset_values(
 		 "%s: unable to split string into offset values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
+	if( libewf_ltree_segments_get_number_of_segments(
 	     offset_values,
 	     &number_of_offset_values,
 	     error ) != 1 )
@@ -2088,7 +2242,7 @@ int libewf_single_files_parse_file_entry_offset_values(
 		 "%s: unable to retrieve number of offset values",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( ( number_of_offset_values != 1 )
 	 && ( number_of_offset_values != 3 ) )
@@ -2100,11 +2254,11 @@ int libewf_single_files_parse_file_entry_offset_values(
 		 "%s: unsupported number of offset values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( number_of_offset_values == 3 )
 	{
-		if( libfvalue_split_utf8_string_get_segment_by_index(
+		if( libewf_ltree_segments_get_segment_by_index(
 		     offset_values,
 		     1,
 		     &offset_value_string,
@@ -2118,7 +2272,7 @@ int libewf_single_files_parse_file_entry_offset_values(
 			 "%s: unable to retrieve offset value string: 1.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( libfvalue_utf8_string_copy_to_integer(
 		     offset_value_string,
@@ -2135,11 +2289,11 @@ int libewf_single_files_parse_file_entry_offset_values(
 			 "%s: unable to set data offset.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		single_file_entry->data_offset = (off64_t) value_64bit;
 
-		if( libfvalue_split_utf8_string_get_segment_by_index(
+		if( libewf_ltree_segments_get_segment_by_index(
 		     offset_values,
 		     2,
 		     &offset_value_string,
@@ -2153,7 +2307,7 @@ int libewf_single_files_parse_file_entry_offset_values(
 			 "%s: unable to retrieve offset value string: 2.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( libfvalue_utf8_string_copy_to_integer(
 		     offset_value_string,
@@ -2170,32 +2324,10 @@ int libewf_single_files_parse_file_entry_offset_values(
 			 "%s: unable to set data size.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		single_file_entry->data_size = (size64_t) value_64bit;
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &offset_values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split offset values.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
-
-on_error:
-	if( offset_values != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &offset_values,
-		 NULL );
-	}
-	return( -1 );
 }
 
@@ -27,9 +27,13 @@
 
 #include "libewf_extern.h"
 #include "libewf_libcdata.h"
+#include "libewf_arena.h"
 #include "libewf_libcerror.h"
-#include "libewf_libfvalue.h"
+#include "libewf_libcthreads.h"
+#include "libewf_ltree_line_reader.h"
+#include "libewf_ltree_segments.h"
 #include "libewf_single_file_entry.h"
+#include "libewf_single_file_name_index.h"
 #include "libewf_types.h"
 
 #if defined( __cplusplus )
@@ -59,6 +63,16 @@ struct libewf_single_files
 	/* The single file entry tree
 	 */
 	libcdata_tree_node_t *root_file_entry_node;
+
+	/* The arena the single file entries, their names and digest hashes are allocated from
+	 */
+	libewf_arena_t *arena;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock that protects the creation of the sub entries name indexes
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libewf_single_files_initialize(
@@ -69,6 +83,12 @@ int libewf_single_files_free(
      libewf_single_files_t **single_files,
      libcerror_error_t **error );
 
+int libewf_single_files_get_sub_entries_name_index(
+     libewf_single_files_t *single_files,
+     libcdata_tree_node_t *node,
+     libewf_single_file_name_index_t **name_index,
+     libcerror_error_t **error );
+
 int libewf_single_files_parse(
      libewf_single_files_t *single_files,
      size64_t *media_size,
@@ -78,33 +98,36 @@ int libewf_single_files_parse(
 int libewf_single_files_parse_file_entries(
      libewf_single_files_t *single_files,
      size64_t *media_size,
-     const uint8_t *file_entries_string,
-     size_t file_entries_string_size,
+     libewf_ltree_line_reader_t *line_reader,
      uint8_t *format,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_record_values(
      size64_t *media_size,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_iterator,
+     libewf_ltree_line_reader_t *line_reader,
+     libewf_ltree_segments_t *types,
+     libewf_ltree_segments_t *values,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_file_entry(
      libcdata_tree_node_t *parent_file_entry_node,
-     libfvalue_split_utf8_string_t *lines,
-     int *line_iterator,
-     libfvalue_split_utf8_string_t *types,
+     libewf_arena_t *arena,
+     libewf_ltree_line_reader_t *line_reader,
+     libewf_ltree_segments_t *types,
+     libewf_ltree_segments_t *values,
+     libewf_ltree_segments_t *offset_values,
      uint8_t *format,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_file_entry_number_of_sub_entries(
-     libfvalue_split_utf8_string_t *lines,
-     int *line_index,
+     libewf_ltree_line_reader_t *line_reader,
+     libewf_ltree_segments_t *values,
      uint64_t *number_of_sub_entries,
      libcerror_error_t **error );
 
 int libewf_single_files_parse_file_entry_offset_values(
      libewf_single_file_entry_t *single_file_entry,
+     libewf_ltree_segments_t *offset_values,
      const uint8_t *offset_values_string,
      size_t offset_values_string_size,
      libcerror_error_t **error );
@@ -34,11 +34,13 @@
 /* The following type definitions hide internal data structures
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
+typedef struct libewf_chunk_view {}	libewf_chunk_view_t;
 typedef struct libewf_data_chunk {}	libewf_data_chunk_t;
 typedef struct libewf_file_entry {}	libewf_file_entry_t;
 typedef struct libewf_handle {}		libewf_handle_t;
 
 #else
+typedef intptr_t libewf_chunk_view_t;
 typedef intptr_t libewf_data_chunk_t;
 typedef intptr_t libewf_file_entry_t;
 typedef intptr_t libewf_handle_t;
@@ -0,0 +1,427 @@
+/*
+ * Write buffer functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_write_buffer.h"
+
+/* Creates a write buffer
+ * Make sure the value write_buffer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_buffer_initialize(
+     libewf_write_buffer_t **write_buffer,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_buffer_initialize";
+
+	if( write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*write_buffer = memory_allocate_structure(
+	                 libewf_write_buffer_t );
+
+	if( *write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_buffer,
+	     0,
+	     sizeof( libewf_write_buffer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write buffer.",
+		 function );
+
+		memory_free(
+		 *write_buffer );
+
+		*write_buffer = NULL;
+
+		return( -1 );
+	}
+	( *write_buffer )->data = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * data_size );
+
+	if( ( *write_buffer )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_buffer )->data_size          = data_size;
+	( *write_buffer )->file_io_pool_entry = -1;
+
+	return( 1 );
+
+on_error:
+	if( *write_buffer != NULL )
+	{
+		memory_free(
+		 *write_buffer );
+
+		*write_buffer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write buffer
+ * Data that is pending to be written is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_buffer_free(
+     libewf_write_buffer_t **write_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_buffer_free";
+
+	if( write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_buffer != NULL )
+	{
+		if( ( *write_buffer )->data != NULL )
+		{
+			memory_free(
+			 ( *write_buffer )->data );
+		}
+		memory_free(
+		 *write_buffer );
+
+		*write_buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Writes a buffer to a file IO pool entry
+ * The data is combined with the pending data of the same file IO pool entry and written
+ * when the write buffer is full, the file IO pool entry changes or the write buffer is flushed.
+ * Buffers that are not smaller than the write buffer are written directly
+ * The data is copied instead of gathered with a vectored write, since the file IO pool
+ * entries are not necessarily files and libbfio only provides a single buffer write
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_buffer_write(
+         libewf_write_buffer_t *write_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_write_buffer_write";
+	ssize_t write_count   = 0;
+
+	if( write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_buffer->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid write buffer - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( write_buffer->pending_data_size > 0 )
+	 && ( ( write_buffer->file_io_pool_entry != file_io_pool_entry )
+	  ||  ( buffer_size > ( write_buffer->data_size - write_buffer->pending_data_size ) ) ) )
+	{
+		if( libewf_write_buffer_flush(
+		     write_buffer,
+		     file_io_pool,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffer_size >= write_buffer->data_size )
+	{
+		write_count = libbfio_pool_write_buffer(
+		               file_io_pool,
+		               file_io_pool_entry,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count != (ssize_t) buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			return( -1 );
+		}
+		write_buffer->number_of_writes        += 1;
+		write_buffer->number_of_bytes_written += buffer_size;
+
+		return( write_count );
+	}
+	if( memory_copy(
+	     &( write_buffer->data[ write_buffer->pending_data_size ] ),
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy buffer to write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	write_buffer->pending_data_size += buffer_size;
+	write_buffer->file_io_pool_entry = file_io_pool_entry;
+
+	return( (ssize_t) buffer_size );
+}
+
+/* Writes the pending data of the write buffer to its file IO pool entry
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_buffer_flush(
+         libewf_write_buffer_t *write_buffer,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_write_buffer_flush";
+	ssize_t write_count   = 0;
+
+	if( write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_buffer->pending_data_size == 0 )
+	{
+		return( 0 );
+	}
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               write_buffer->file_io_pool_entry,
+	               write_buffer->data,
+	               write_buffer->pending_data_size,
+	               error );
+
+	if( write_count != (ssize_t) write_buffer->pending_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write pending data to file IO pool entry: %d.",
+		 function,
+		 write_buffer->file_io_pool_entry );
+
+		return( -1 );
+	}
+	write_buffer->number_of_writes        += 1;
+	write_buffer->number_of_bytes_written += write_buffer->pending_data_size;
+	write_buffer->pending_data_size        = 0;
+	write_buffer->file_io_pool_entry       = -1;
+
+	return( write_count );
+}
+
+/* Retrieves the number of write calls issued to the file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_buffer_get_number_of_writes(
+     libewf_write_buffer_t *write_buffer,
+     uint64_t *number_of_writes,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_buffer_get_number_of_writes";
+
+	if( write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_writes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of writes.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_writes = write_buffer->number_of_writes;
+
+	return( 1 );
+}
+
+/* Retrieves the number of bytes written to the file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_buffer_get_number_of_bytes_written(
+     libewf_write_buffer_t *write_buffer,
+     uint64_t *number_of_bytes_written,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_buffer_get_number_of_bytes_written";
+
+	if( write_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bytes_written == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bytes written.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_bytes_written = write_buffer->number_of_bytes_written;
+
+	return( 1 );
+}
+
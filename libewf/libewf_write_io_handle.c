@@ -56,6 +56,7 @@
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 #include "libewf_unused.h"
+#include "libewf_write_buffer.h"
 #include "libewf_write_io_handle.h"
 
 #include "ewf_data.h"
@@ -153,6 +154,20 @@ int libewf_write_io_handle_initialize(
 
 		goto on_error;
 	}
+	if( libewf_write_buffer_initialize(
+	     &( ( *write_io_handle )->write_buffer ),
+	     LIBEWF_WRITE_BUFFER_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create write buffer.",
+		 function );
+
+		goto on_error;
+	}
 	( *write_io_handle )->pack_flags                  = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
 	( *write_io_handle )->section_descriptor_size     = sizeof( ewf_section_descriptor_v1_t );
 	( *write_io_handle )->table_header_size           = sizeof( ewf_table_header_v1_t );
@@ -167,6 +182,12 @@ int libewf_write_io_handle_initialize(
 on_error:
 	if( *write_io_handle != NULL )
 	{
+		if( ( *write_io_handle )->chunk_group != NULL )
+		{
+			libewf_chunk_group_free(
+			 &( ( *write_io_handle )->chunk_group ),
+			 NULL );
+		}
 		memory_free(
 		 *write_io_handle );
 
@@ -236,6 +257,19 @@ int libewf_write_io_handle_free(
 
 			result = -1;
 		}
+		if( libewf_write_buffer_free(
+		     &( ( *write_io_handle )->write_buffer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write buffer.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *write_io_handle );
 
@@ -320,6 +354,7 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_entries_data      = NULL;
 	( *destination_write_io_handle )->table_entries_data_size = 0;
 	( *destination_write_io_handle )->number_of_table_entries = 0;
+	( *destination_write_io_handle )->write_buffer            = NULL;
 
 	if( source_write_io_handle->case_data != NULL )
 	{
@@ -465,6 +500,25 @@ int libewf_write_io_handle_clone(
 
 		goto on_error;
 	}
+	/* The pending data of the source write buffer is not cloned
+	 */
+	if( source_write_io_handle->write_buffer != NULL )
+	{
+		if( libewf_write_buffer_initialize(
+		     &( ( *destination_write_io_handle )->write_buffer ),
+		     source_write_io_handle->write_buffer->data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination write buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -2299,6 +2353,7 @@ int libewf_write_io_handle_test_chunks_section_full(
 
 /* Creates a new segment file and opens it for writing
  * The necessary sections at the start of the segment file are written
+ * If the queue depth is not 0 the segment file is written using io_uring
  * Returns 1 if successful or -1 on error
  */
 int libewf_write_io_handle_create_segment_file(
@@ -2308,6 +2363,7 @@ int libewf_write_io_handle_create_segment_file(
      uint8_t segment_file_type,
      uint32_t segment_number,
      uint32_t maximum_number_of_segments,
+     int queue_depth,
      const uint8_t *set_identifier,
      int *file_io_pool_entry,
      libewf_segment_file_t **segment_file,
@@ -2318,6 +2374,7 @@ int libewf_write_io_handle_create_segment_file(
 	static char *function            = "libewf_write_io_handle_create_segment_file";
 	size_t filename_size             = 0;
 	int bfio_access_flags            = 0;
+	int result                       = 0;
 
 	if( segment_table == NULL )
 	{
@@ -2416,9 +2473,25 @@ int libewf_write_io_handle_create_segment_file(
 		 filename );
 	}
 #endif
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+	/* Direct IO writes are not batched
+	 */
+	if( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		queue_depth = 0;
+	}
+	if( queue_depth > 0 )
+	{
+		result = libbfio_file_io_uring_initialize(
+		          &file_io_handle,
+		          error );
+	}
+	else
+	{
+		result = libbfio_file_initialize(
+		          &file_io_handle,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -2429,19 +2502,53 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+	if( queue_depth > 0 )
+	{
+		if( libbfio_file_io_uring_set_queue_depth(
+		     file_io_handle,
+		     queue_depth,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set queue depth in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		result = libbfio_file_io_uring_set_name_wide(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
 #else
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		result = libbfio_file_io_uring_set_name(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
 #endif
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbfio_file_set_name_wide(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
+#else
+		result = libbfio_file_set_name(
+		          file_io_handle,
+		          filename,
+		          filename_size,
+		          error );
+#endif
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -2459,6 +2566,11 @@ int libewf_write_io_handle_create_segment_file(
 
 	bfio_access_flags = LIBBFIO_OPEN_WRITE_TRUNCATE;
 
+	if( ( io_handle->access_flags & LIBEWF_ACCESS_FLAG_DIRECT_IO ) != 0 )
+	{
+		bfio_access_flags |= LIBBFIO_ACCESS_FLAG_DIRECT_IO;
+	}
+
 	if( libbfio_pool_append_handle(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -2598,6 +2710,62 @@ on_error:
 	return( -1 );
 }
 
+/* Writes the chunk data that is pending in the write buffer
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_write_io_handle_flush(
+         libewf_write_io_handle_t *write_io_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_flush";
+	ssize_t write_count   = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->write_buffer == NULL )
+	{
+		return( 0 );
+	}
+	write_count = libewf_write_buffer_flush(
+	               write_io_handle->write_buffer,
+	               file_io_pool,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( ( libcnotify_verbose != 0 )
+	 && ( write_count > 0 ) )
+	{
+		libcnotify_printf(
+		 "%s: chunk data written in: %" PRIu64 " writes of in total: %" PRIu64 " bytes.\n",
+		 function,
+		 write_io_handle->write_buffer->number_of_writes,
+		 write_io_handle->write_buffer->number_of_bytes_written );
+	}
+#endif
+	return( write_count );
+}
+
 /* Writes the start of the chunks section
  * Returns the number of bytes written or -1 on error
  */
@@ -2758,6 +2926,22 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
 
 		return( -1 );
 	}
+	/* The chunk data needs to be written before the table and the section descriptor
+	 */
+	if( libewf_write_io_handle_flush(
+	     write_io_handle,
+	     file_io_pool,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush chunk data.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -3036,6 +3220,28 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 			segment_number++;
 		}
 	}
+	/* Make sure no chunk data is pending before a segment file is
+	 * written to directly, sought or its offset is retrieved
+	 */
+	if( ( segment_file == NULL )
+	 || ( write_io_handle->resume_segment_file_offset > 0 )
+	 || ( write_io_handle->create_chunks_section == 1 ) )
+	{
+		if( libewf_write_io_handle_flush(
+		     write_io_handle,
+		     file_io_pool,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( segment_file == NULL )
 	{
 		write_io_handle->create_chunks_section                    = 1;
@@ -3058,6 +3264,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		     io_handle->segment_file_type,
 		     segment_number,
 		     write_io_handle->maximum_number_of_segments,
+		     write_io_handle->segment_file_queue_depth,
 		     media_values->set_identifier,
 		     &file_io_pool_entry,
 		     &segment_file,
@@ -3326,6 +3533,7 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 		       file_io_pool_entry,
 		       chunk_index,
 		       chunk_data,
+		       write_io_handle->write_buffer,
 	               error );
 
 	if( write_count <= -1 )
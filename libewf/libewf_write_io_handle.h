@@ -49,6 +49,7 @@
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
+#include "libewf_write_buffer.h"
 
 #include "ewf_data.h"
 #include "ewf_table.h"
@@ -145,6 +146,11 @@ struct libewf_write_io_handle
 	 */
 	uint32_t maximum_number_of_segments;
 
+	/* The queue depth of the segment file writes
+	 * A value of 0 represents that the segment files are written without io_uring
+	 */
+	int segment_file_queue_depth;
+
 	/* The group of chunks written to the current chunks section
 	 */
 	libewf_chunk_group_t *chunk_group;
@@ -208,6 +214,10 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The write buffer in which the chunk data of a chunks section is combined
+	 */
+	libewf_write_buffer_t *write_buffer;
 };
 
 int libewf_write_io_handle_initialize(
@@ -280,11 +290,17 @@ int libewf_write_io_handle_create_segment_file(
      uint8_t segment_file_type,
      uint32_t segment_number,
      uint32_t maximum_number_of_segments,
+     int queue_depth,
      const uint8_t *set_identifier,
      int *file_io_pool_entry,
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error );
 
+ssize_t libewf_write_io_handle_flush(
+         libewf_write_io_handle_t *write_io_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error );
+
 ssize_t libewf_write_io_handle_write_chunks_section_start(
          libewf_write_io_handle_t *write_io_handle,
          libewf_io_handle_t *io_handle,
@@ -131,6 +131,118 @@ on_error:
 	return( -1 );
 }
 
+/* Creates a cache that is bounded by the size of its values
+ * The least recently used cache values are freed when the size
+ * of the cache exceeds the maximum cache size
+ * Make sure the value cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_cache_initialize_with_maximum_size(
+     libfcache_cache_t **cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_t *internal_cache = NULL;
+	static char *function                     = "libfcache_cache_initialize_with_maximum_size";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum cache size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache = memory_allocate_structure(
+	                  libfcache_internal_cache_t );
+
+	if( internal_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_cache,
+	     0,
+	     sizeof( libfcache_internal_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear cache.",
+		 function );
+
+		memory_free(
+		 internal_cache );
+
+		return( -1 );
+	}
+	internal_cache->maximum_cache_size = maximum_cache_size;
+
+	if( libfcache_internal_cache_resize_buckets(
+	     internal_cache,
+	     LIBFCACHE_CACHE_MINIMUM_NUMBER_OF_BUCKETS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize buckets.",
+		 function );
+
+		goto on_error;
+	}
+	*cache = (libfcache_cache_t *) internal_cache;
+
+	return( 1 );
+
+on_error:
+	if( internal_cache != NULL )
+	{
+		if( internal_cache->buckets != NULL )
+		{
+			memory_free(
+			 internal_cache->buckets );
+		}
+		memory_free(
+		 internal_cache );
+	}
+	return( -1 );
+}
+
 /* Frees a cache
  * Returns 1 if successful or -1 on error
  */
@@ -158,10 +270,31 @@ int libfcache_cache_free(
 		internal_cache = (libfcache_internal_cache_t *) *cache;
 		*cache         = NULL;
 
-		if( libcdata_array_free(
-		     &( internal_cache->entries ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libfcache_cache_value_free,
-		     error ) != 1 )
+		if( internal_cache->maximum_cache_size != 0 )
+		{
+			if( libfcache_internal_cache_free_values(
+			     internal_cache,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free cache values.",
+				 function );
+
+				result = -1;
+			}
+			if( internal_cache->buckets != NULL )
+			{
+				memory_free(
+				 internal_cache->buckets );
+			}
+		}
+		else if( libcdata_array_free(
+		          &( internal_cache->entries ),
+		          (int (*)(intptr_t **, libcerror_error_t **)) &libfcache_cache_value_free,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -201,10 +334,26 @@ int libfcache_cache_empty(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
-	if( libcdata_array_clear(
-	     internal_cache->entries,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libfcache_cache_value_free,
-	     error ) != 1 )
+	if( internal_cache->maximum_cache_size != 0 )
+	{
+		if( libfcache_internal_cache_free_values(
+		     internal_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache values.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( libcdata_array_clear(
+	          internal_cache->entries,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libfcache_cache_value_free,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -262,6 +411,24 @@ int libfcache_cache_clone(
 	}
 	internal_source_cache = (libfcache_internal_cache_t *) source_cache;
 
+	if( internal_source_cache->maximum_cache_size != 0 )
+	{
+		if( libfcache_cache_initialize_with_maximum_size(
+		     destination_cache,
+		     internal_source_cache->maximum_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination cache.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
 	if( libcdata_array_get_number_of_entries(
 	     internal_source_cache->entries,
 	     &number_of_cache_entries,
@@ -317,6 +484,17 @@ int libfcache_cache_resize(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
+	if( internal_cache->maximum_cache_size != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid cache - unsupported size bounded cache.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_resize(
 	     internal_cache->entries,
 	     maximum_cache_entries,
@@ -336,6 +514,7 @@ int libfcache_cache_resize(
 }
 
 /* Retrieves the number of entries of the cache
+ * For a size bounded cache this is the number of cache values
  * Returns 1 if successful or -1 on error
  */
 int libfcache_cache_get_number_of_entries(
@@ -359,6 +538,23 @@ int libfcache_cache_get_number_of_entries(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
+	if( internal_cache->maximum_cache_size != 0 )
+	{
+		if( number_of_entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid number of entries.",
+			 function );
+
+			return( -1 );
+		}
+		*number_of_entries = internal_cache->number_of_cache_values;
+
+		return( 1 );
+	}
 	if( libcdata_array_get_number_of_entries(
 	     internal_cache->entries,
 	     number_of_entries,
@@ -416,17 +612,16 @@ int libfcache_cache_get_number_of_cache_values(
 	return( 1 );
 }
 
-/* Retrieves the cache value for the specific index
- * Returns 1 if successful or -1 on error
+/* Retrieves the maximum cache size
+ * Returns 1 if successful, 0 if the cache is not size bounded or -1 on error
  */
-int libfcache_cache_get_value_by_index(
+int libfcache_cache_get_maximum_size(
      libfcache_cache_t *cache,
-     int cache_entry_index,
-     libfcache_cache_value_t **cache_value,
+     size64_t *maximum_cache_size,
      libcerror_error_t **error )
 {
 	libfcache_internal_cache_t *internal_cache = NULL;
-	static char *function                     = "libfcache_cache_get_value_by_index";
+	static char *function                     = "libfcache_cache_get_maximum_size";
 
 	if( cache == NULL )
 	{
@@ -441,44 +636,38 @@ int libfcache_cache_get_value_by_index(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_cache->entries,
-	     cache_entry_index,
-	     (intptr_t **) cache_value,
-	     error ) != 1 )
+	if( maximum_cache_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve cache value: %d from entries array.",
-		 function,
-		 cache_entry_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
+		 function );
 
 		return( -1 );
 	}
+	if( internal_cache->maximum_cache_size == 0 )
+	{
+		return( 0 );
+	}
+	*maximum_cache_size = internal_cache->maximum_cache_size;
+
 	return( 1 );
 }
 
-/* Sets the cache value for the specific index
+/* Sets the maximum cache size
+ * The least recently used cache values are freed until the size
+ * of the cache no longer exceeds the maximum cache size
  * Returns 1 if successful or -1 on error
  */
-int libfcache_cache_set_value_by_index(
+int libfcache_cache_set_maximum_size(
      libfcache_cache_t *cache,
-     int cache_entry_index,
-     int file_index,
-     off64_t offset,
-     time_t timestamp,
-     intptr_t *value,
-     int (*free_value)(
-            intptr_t **value,
-            libcerror_error_t **error ),
-     uint8_t flags,
+     size64_t maximum_cache_size,
      libcerror_error_t **error )
 {
-	libfcache_cache_value_t *cache_value       = NULL;
 	libfcache_internal_cache_t *internal_cache = NULL;
-	static char *function                     = "libfcache_cache_set_value_by_index";
+	static char *function                     = "libfcache_cache_set_maximum_size";
 
 	if( cache == NULL )
 	{
@@ -493,87 +682,918 @@ int libfcache_cache_set_value_by_index(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
-	if( libcdata_array_get_entry_by_index(
-	     internal_cache->entries,
-	     cache_entry_index,
-	     (intptr_t **) &cache_value,
-	     error ) != 1 )
+	if( internal_cache->maximum_cache_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve cache value: %d from entries array.",
-		 function,
-		 cache_entry_index );
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid cache - unsupported cache not bounded by size.",
+		 function );
 
 		return( -1 );
 	}
-	if( cache_value == NULL )
-	{
-		if( libfcache_cache_value_initialize(
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create cache value.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_array_set_entry_by_index(
-		     internal_cache->entries,
-		     cache_entry_index,
-		     (intptr_t *) cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set cache value: %d in entries array.",
-			 function,
-			 cache_entry_index );
-
-			libfcache_cache_value_free(
-			 &cache_value,
-			 NULL );
-
-			return( -1 );
-		}
-		internal_cache->number_of_cache_values++;
-	}
-	if( libfcache_cache_value_set_value(
-	     cache_value,
-	     value,
-	     free_value,
-	     flags,
-	     error ) != 1 )
+	if( maximum_cache_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set value in cache value.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum cache size value zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfcache_cache_value_set_identifier(
-	     cache_value,
-	     file_index,
-	     offset,
-	     timestamp,
+	internal_cache->maximum_cache_size = maximum_cache_size;
+
+	if( libfcache_internal_cache_evict_values(
+	     internal_cache,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set identifier in cache value.",
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to evict cache values.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the cache size
+ * The cache size is the sum of the sizes of the cache values of a size bounded cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_cache_get_size(
+     libfcache_cache_t *cache,
+     size64_t *cache_size,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_t *internal_cache = NULL;
+	static char *function                     = "libfcache_cache_get_size";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache = (libfcache_internal_cache_t *) cache;
+
+	if( cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
+		 function );
+
+		return( -1 );
+	}
+	*cache_size = internal_cache->cache_size;
+
+	return( 1 );
+}
+
+/* Retrieves the cache value for the specific index
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_cache_get_value_by_index(
+     libfcache_cache_t *cache,
+     int cache_entry_index,
+     libfcache_cache_value_t **cache_value,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_t *internal_cache = NULL;
+	static char *function                     = "libfcache_cache_get_value_by_index";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache = (libfcache_internal_cache_t *) cache;
+
+	if( internal_cache->maximum_cache_size != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid cache - unsupported size bounded cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_cache->entries,
+	     cache_entry_index,
+	     (intptr_t **) cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value: %d from entries array.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the cache value for the specific index
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_cache_set_value_by_index(
+     libfcache_cache_t *cache,
+     int cache_entry_index,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     intptr_t *value,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value       = NULL;
+	libfcache_internal_cache_t *internal_cache = NULL;
+	static char *function                     = "libfcache_cache_set_value_by_index";
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache = (libfcache_internal_cache_t *) cache;
+
+	if( internal_cache->maximum_cache_size != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid cache - unsupported size bounded cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_cache->entries,
+	     cache_entry_index,
+	     (intptr_t **) &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value: %d from entries array.",
+		 function,
+		 cache_entry_index );
+
+		return( -1 );
+	}
+	if( cache_value == NULL )
+	{
+		if( libfcache_cache_value_initialize(
+		     &cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create cache value.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcdata_array_set_entry_by_index(
+		     internal_cache->entries,
+		     cache_entry_index,
+		     (intptr_t *) cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache value: %d in entries array.",
+			 function,
+			 cache_entry_index );
+
+			libfcache_cache_value_free(
+			 &cache_value,
+			 NULL );
+
+			return( -1 );
+		}
+		internal_cache->number_of_cache_values++;
+	}
+	if( libfcache_cache_value_set_value(
+	     cache_value,
+	     value,
+	     free_value,
+	     flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value in cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_value_set_identifier(
+	     cache_value,
+	     file_index,
+	     offset,
+	     timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set identifier in cache value.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the hash of a cache value identifier
+ * Returns the identifier hash
+ */
+uint32_t libfcache_internal_cache_calculate_identifier_hash(
+          int file_index,
+          off64_t offset )
+{
+	uint32_t identifier_hash = 0;
+
+	/* Multiplicative (Fibonacci) hashing, the upper bits are the best distributed
+	 */
+	identifier_hash   = (uint32_t) ( (uint64_t) offset >> 32 );
+	identifier_hash  ^= (uint32_t) file_index;
+	identifier_hash  *= (uint32_t) 0x9e3779b1UL;
+	identifier_hash  ^= (uint32_t) offset;
+	identifier_hash  *= (uint32_t) 0x9e3779b1UL;
+	identifier_hash  ^= identifier_hash >> 16;
+
+	return( identifier_hash );
+}
+
+/* Resizes the hash buckets of a size bounded cache
+ * The number of buckets must be a power of 2
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_internal_cache_resize_buckets(
+     libfcache_internal_cache_t *internal_cache,
+     uint32_t number_of_buckets,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_value_t **buckets             = NULL;
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	static char *function                                  = "libfcache_internal_cache_resize_buckets";
+	size_t buckets_size                                    = 0;
+	uint32_t bucket_index                                  = 0;
+
+	if( internal_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buckets == 0 )
+	 || ( ( number_of_buckets & ( number_of_buckets - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buckets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_buckets > ( (size_t) SSIZE_MAX / sizeof( libfcache_internal_cache_value_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of buckets value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libfcache_internal_cache_value_t * ) * number_of_buckets;
+
+	buckets = (libfcache_internal_cache_value_t **) memory_allocate(
+	                                                 buckets_size );
+
+	if( buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		memory_free(
+		 buckets );
+
+		return( -1 );
+	}
+	/* Rehash the cache values using the least recently used list
+	 */
+	internal_cache_value = internal_cache->first_cache_value;
+
+	while( internal_cache_value != NULL )
+	{
+		bucket_index = internal_cache_value->identifier_hash & ( number_of_buckets - 1 );
+
+		internal_cache_value->next_bucket_cache_value = buckets[ bucket_index ];
+		buckets[ bucket_index ]                       = internal_cache_value;
+
+		internal_cache_value = internal_cache_value->next_cache_value;
+	}
+	if( internal_cache->buckets != NULL )
+	{
+		memory_free(
+		 internal_cache->buckets );
+	}
+	internal_cache->buckets           = buckets;
+	internal_cache->number_of_buckets = number_of_buckets;
+
+	return( 1 );
+}
+
+/* Removes a cache value from a size bounded cache
+ * This function does not free the cache value
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_internal_cache_remove_value(
+     libfcache_internal_cache_t *internal_cache,
+     libfcache_internal_cache_value_t *internal_cache_value,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_value_t **bucket_cache_value = NULL;
+	static char *function                                 = "libfcache_internal_cache_remove_value";
+	uint32_t bucket_index                                 = 0;
+
+	if( internal_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_cache->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid cache - missing buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache value.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index       = internal_cache_value->identifier_hash & ( internal_cache->number_of_buckets - 1 );
+	bucket_cache_value = &( internal_cache->buckets[ bucket_index ] );
+
+	while( *bucket_cache_value != NULL )
+	{
+		if( *bucket_cache_value == internal_cache_value )
+		{
+			break;
+		}
+		bucket_cache_value = &( ( *bucket_cache_value )->next_bucket_cache_value );
+	}
+	if( *bucket_cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing cache value in bucket: %" PRIu32 ".",
+		 function,
+		 bucket_index );
+
+		return( -1 );
+	}
+	*bucket_cache_value = internal_cache_value->next_bucket_cache_value;
+
+	if( internal_cache_value->previous_cache_value != NULL )
+	{
+		internal_cache_value->previous_cache_value->next_cache_value = internal_cache_value->next_cache_value;
+	}
+	else
+	{
+		internal_cache->first_cache_value = internal_cache_value->next_cache_value;
+	}
+	if( internal_cache_value->next_cache_value != NULL )
+	{
+		internal_cache_value->next_cache_value->previous_cache_value = internal_cache_value->previous_cache_value;
+	}
+	else
+	{
+		internal_cache->last_cache_value = internal_cache_value->previous_cache_value;
+	}
+	internal_cache_value->previous_cache_value    = NULL;
+	internal_cache_value->next_cache_value        = NULL;
+	internal_cache_value->next_bucket_cache_value = NULL;
+
+	internal_cache->cache_size -= internal_cache_value->value_size;
+	internal_cache->number_of_cache_values--;
+
+	return( 1 );
+}
+
+/* Frees all the cache values of a size bounded cache
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_internal_cache_free_values(
+     libfcache_internal_cache_t *internal_cache,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	static char *function                                  = "libfcache_internal_cache_free_values";
+	int result                                             = 1;
+
+	if( internal_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	while( internal_cache->first_cache_value != NULL )
+	{
+		internal_cache_value = internal_cache->first_cache_value;
+
+		internal_cache->first_cache_value = internal_cache_value->next_cache_value;
+
+		if( libfcache_cache_value_free(
+		     (libfcache_cache_value_t **) &internal_cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache value.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_cache->buckets != NULL )
+	{
+		if( memory_set(
+		     internal_cache->buckets,
+		     0,
+		     sizeof( libfcache_internal_cache_value_t * ) * internal_cache->number_of_buckets ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buckets.",
+			 function );
+
+			result = -1;
+		}
+	}
+	internal_cache->last_cache_value       = NULL;
+	internal_cache->cache_size             = 0;
+	internal_cache->number_of_cache_values = 0;
+
+	return( result );
+}
+
+/* Frees the least recently used cache values of a size bounded cache
+ * until the size of the cache no longer exceeds the maximum cache size
+ * The most recently used cache value is never freed
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_internal_cache_evict_values(
+     libfcache_internal_cache_t *internal_cache,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	static char *function                                  = "libfcache_internal_cache_evict_values";
+
+	if( internal_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( internal_cache->cache_size > internal_cache->maximum_cache_size )
+	    && ( internal_cache->last_cache_value != internal_cache->first_cache_value ) )
+	{
+		internal_cache_value = internal_cache->last_cache_value;
+
+		if( libfcache_internal_cache_remove_value(
+		     internal_cache,
+		     internal_cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove least recently used cache value.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfcache_cache_value_free(
+		     (libfcache_cache_value_t **) &internal_cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free least recently used cache value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the cache value for the specific identifier from a size bounded cache
+ * A cache value that is found becomes the most recently used cache value
+ * Returns 1 if successful, 0 if no such value or -1 on error
+ */
+int libfcache_cache_get_value_by_identifier(
+     libfcache_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     libfcache_cache_value_t **cache_value,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_t *internal_cache             = NULL;
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	static char *function                                  = "libfcache_cache_get_value_by_identifier";
+	uint32_t identifier_hash                               = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache = (libfcache_internal_cache_t *) cache;
+
+	if( internal_cache->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid cache - missing buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache value.",
+		 function );
+
+		return( -1 );
+	}
+	identifier_hash = libfcache_internal_cache_calculate_identifier_hash(
+	                   file_index,
+	                   offset );
+
+	internal_cache_value = internal_cache->buckets[ identifier_hash & ( internal_cache->number_of_buckets - 1 ) ];
+
+	while( internal_cache_value != NULL )
+	{
+		if( ( internal_cache_value->identifier_hash == identifier_hash )
+		 && ( internal_cache_value->file_index == file_index )
+		 && ( internal_cache_value->offset == offset ) )
+		{
+			break;
+		}
+		internal_cache_value = internal_cache_value->next_bucket_cache_value;
+	}
+	if( ( internal_cache_value == NULL )
+	 || ( internal_cache_value->timestamp != timestamp ) )
+	{
+		return( 0 );
+	}
+	/* Move the cache value to the front of the least recently used list
+	 */
+	if( internal_cache_value->previous_cache_value != NULL )
+	{
+		internal_cache_value->previous_cache_value->next_cache_value = internal_cache_value->next_cache_value;
+
+		if( internal_cache_value->next_cache_value != NULL )
+		{
+			internal_cache_value->next_cache_value->previous_cache_value = internal_cache_value->previous_cache_value;
+		}
+		else
+		{
+			internal_cache->last_cache_value = internal_cache_value->previous_cache_value;
+		}
+		internal_cache_value->previous_cache_value = NULL;
+		internal_cache_value->next_cache_value     = internal_cache->first_cache_value;
+
+		internal_cache->first_cache_value->previous_cache_value = internal_cache_value;
+		internal_cache->first_cache_value                       = internal_cache_value;
+	}
+	*cache_value = (libfcache_cache_value_t *) internal_cache_value;
+
+	return( 1 );
+}
+
+/* Sets the cache value for the specific identifier in a size bounded cache
+ * The cache value becomes the most recently used cache value and the least
+ * recently used cache values are freed if the maximum cache size is exceeded
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_cache_set_value_by_identifier(
+     libfcache_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     intptr_t *value,
+     size_t value_size,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_t *internal_cache             = NULL;
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	static char *function                                  = "libfcache_cache_set_value_by_identifier";
+	uint32_t bucket_index                                  = 0;
+	uint32_t identifier_hash                               = 0;
+
+	if( cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache = (libfcache_internal_cache_t *) cache;
+
+	if( internal_cache->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid cache - missing buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid value size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	identifier_hash = libfcache_internal_cache_calculate_identifier_hash(
+	                   file_index,
+	                   offset );
+
+	internal_cache_value = internal_cache->buckets[ identifier_hash & ( internal_cache->number_of_buckets - 1 ) ];
+
+	while( internal_cache_value != NULL )
+	{
+		if( ( internal_cache_value->identifier_hash == identifier_hash )
+		 && ( internal_cache_value->file_index == file_index )
+		 && ( internal_cache_value->offset == offset ) )
+		{
+			break;
+		}
+		internal_cache_value = internal_cache_value->next_bucket_cache_value;
+	}
+	if( internal_cache_value != NULL )
+	{
+		/* Detach the existing cache value, it is reinserted as the most recently used
+		 */
+		if( libfcache_internal_cache_remove_value(
+		     internal_cache,
+		     internal_cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove cache value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( internal_cache->number_of_cache_values >= (int) internal_cache->number_of_buckets )
+		{
+			if( internal_cache->number_of_buckets <= ( (uint32_t) INT32_MAX / 2 ) )
+			{
+				if( libfcache_internal_cache_resize_buckets(
+				     internal_cache,
+				     internal_cache->number_of_buckets * 2,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+					 "%s: unable to resize buckets.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		if( libfcache_cache_value_initialize(
+		     (libfcache_cache_value_t **) &internal_cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create cache value.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The cache value is (re)inserted before the value is set so that it is
+	 * freed with the cache if setting the value fails
+	 */
+	bucket_index = identifier_hash & ( internal_cache->number_of_buckets - 1 );
+
+	internal_cache_value->identifier_hash         = identifier_hash;
+	internal_cache_value->value_size              = value_size;
+	internal_cache_value->next_bucket_cache_value = internal_cache->buckets[ bucket_index ];
+	internal_cache->buckets[ bucket_index ]       = internal_cache_value;
+
+	internal_cache_value->previous_cache_value = NULL;
+	internal_cache_value->next_cache_value     = internal_cache->first_cache_value;
+
+	if( internal_cache->first_cache_value != NULL )
+	{
+		internal_cache->first_cache_value->previous_cache_value = internal_cache_value;
+	}
+	else
+	{
+		internal_cache->last_cache_value = internal_cache_value;
+	}
+	internal_cache->first_cache_value = internal_cache_value;
+
+	internal_cache->cache_size += value_size;
+	internal_cache->number_of_cache_values++;
+
+	if( libfcache_cache_value_set_value(
+	     (libfcache_cache_value_t *) internal_cache_value,
+	     value,
+	     free_value,
+	     flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value in cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_value_set_identifier(
+	     (libfcache_cache_value_t *) internal_cache_value,
+	     file_index,
+	     offset,
+	     timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set identifier in cache value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_internal_cache_evict_values(
+	     internal_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to evict cache values.",
 		 function );
 
 		return( -1 );
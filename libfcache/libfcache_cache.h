@@ -36,6 +36,11 @@
 extern "C" {
 #endif
 
+/* The minimum number of hash buckets of a size bounded cache
+ * The number of hash buckets is always a power of 2
+ */
+#define LIBFCACHE_CACHE_MINIMUM_NUMBER_OF_BUCKETS	64
+
 typedef struct libfcache_internal_cache libfcache_internal_cache_t;
 
 struct libfcache_internal_cache
@@ -47,6 +52,32 @@ struct libfcache_internal_cache
 	/* The number of cache values
 	 */
 	int number_of_cache_values;
+
+	/* The maximum cache size in bytes
+	 * A value of 0 represents a cache bounded by the number of entries
+	 */
+	size64_t maximum_cache_size;
+
+	/* The cache size in bytes
+	 */
+	size64_t cache_size;
+
+	/* The hash buckets of the cache values
+	 * Only used by a size bounded cache
+	 */
+	libfcache_internal_cache_value_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	uint32_t number_of_buckets;
+
+	/* The most recently used cache value
+	 */
+	libfcache_internal_cache_value_t *first_cache_value;
+
+	/* The least recently used cache value
+	 */
+	libfcache_internal_cache_value_t *last_cache_value;
 };
 
 LIBFCACHE_EXTERN \
@@ -55,6 +86,12 @@ int libfcache_cache_initialize(
      int maximum_cache_entries,
      libcerror_error_t **error );
 
+LIBFCACHE_EXTERN \
+int libfcache_cache_initialize_with_maximum_size(
+     libfcache_cache_t **cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
 LIBFCACHE_EXTERN \
 int libfcache_cache_free(
      libfcache_cache_t **cache,
@@ -89,6 +126,24 @@ int libfcache_cache_get_number_of_cache_values(
      int *number_of_values,
      libcerror_error_t **error );
 
+LIBFCACHE_EXTERN \
+int libfcache_cache_get_maximum_size(
+     libfcache_cache_t *cache,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBFCACHE_EXTERN \
+int libfcache_cache_set_maximum_size(
+     libfcache_cache_t *cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBFCACHE_EXTERN \
+int libfcache_cache_get_size(
+     libfcache_cache_t *cache,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
 /* Cache value functions
  */
 LIBFCACHE_EXTERN \
@@ -112,6 +167,51 @@ int libfcache_cache_set_value_by_index(
      uint8_t flags,
      libcerror_error_t **error );
 
+uint32_t libfcache_internal_cache_calculate_identifier_hash(
+          int file_index,
+          off64_t offset );
+
+int libfcache_internal_cache_resize_buckets(
+     libfcache_internal_cache_t *internal_cache,
+     uint32_t number_of_buckets,
+     libcerror_error_t **error );
+
+int libfcache_internal_cache_remove_value(
+     libfcache_internal_cache_t *internal_cache,
+     libfcache_internal_cache_value_t *internal_cache_value,
+     libcerror_error_t **error );
+
+int libfcache_internal_cache_free_values(
+     libfcache_internal_cache_t *internal_cache,
+     libcerror_error_t **error );
+
+int libfcache_internal_cache_evict_values(
+     libfcache_internal_cache_t *internal_cache,
+     libcerror_error_t **error );
+
+LIBFCACHE_EXTERN \
+int libfcache_cache_get_value_by_identifier(
+     libfcache_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     libfcache_cache_value_t **cache_value,
+     libcerror_error_t **error );
+
+LIBFCACHE_EXTERN \
+int libfcache_cache_set_value_by_identifier(
+     libfcache_cache_t *cache,
+     int file_index,
+     off64_t offset,
+     time_t timestamp,
+     intptr_t *value,
+     size_t value_size,
+     int (*free_value)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
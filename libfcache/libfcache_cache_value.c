@@ -177,8 +177,13 @@ int libfcache_cache_value_clear(
      libfcache_cache_value_t *cache_value,
      libcerror_error_t **error )
 {
-	libfcache_internal_cache_value_t *internal_cache_value = NULL;
-	static char *function                                  = "libfcache_cache_value_free";
+	libfcache_internal_cache_value_t *internal_cache_value    = NULL;
+	libfcache_internal_cache_value_t *previous_cache_value    = NULL;
+	libfcache_internal_cache_value_t *next_cache_value        = NULL;
+	libfcache_internal_cache_value_t *next_bucket_cache_value = NULL;
+	static char *function                                     = "libfcache_cache_value_free";
+	size_t value_size                                         = 0;
+	uint32_t identifier_hash                                  = 0;
 
 	if( cache_value == NULL )
 	{
@@ -193,6 +198,14 @@ int libfcache_cache_value_clear(
 	}
 	internal_cache_value = (libfcache_internal_cache_value_t *) cache_value;
 
+	/* The accounting and linkage of a size bounded cache is maintained by the cache
+	 */
+	value_size              = internal_cache_value->value_size;
+	identifier_hash         = internal_cache_value->identifier_hash;
+	previous_cache_value    = internal_cache_value->previous_cache_value;
+	next_cache_value        = internal_cache_value->next_cache_value;
+	next_bucket_cache_value = internal_cache_value->next_bucket_cache_value;
+
 	if( memory_set(
 	     internal_cache_value,
 	     0,
@@ -207,8 +220,13 @@ int libfcache_cache_value_clear(
 
 		return( -1 );
 	}
-	internal_cache_value->file_index = -1;
-	internal_cache_value->offset     = (off64_t) -1;
+	internal_cache_value->file_index              = -1;
+	internal_cache_value->offset                  = (off64_t) -1;
+	internal_cache_value->value_size              = value_size;
+	internal_cache_value->identifier_hash         = identifier_hash;
+	internal_cache_value->previous_cache_value    = previous_cache_value;
+	internal_cache_value->next_cache_value        = next_cache_value;
+	internal_cache_value->next_bucket_cache_value = next_bucket_cache_value;
 
 	return( 1 );
 }
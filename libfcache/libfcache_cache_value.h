@@ -63,6 +63,31 @@ struct libfcache_internal_cache_value
 	/* The flags
 	 */
 	uint8_t flags;
+
+	/* The value size
+	 * Only used by a size bounded cache
+	 */
+	size_t value_size;
+
+	/* The identifier hash
+	 * Only used by a size bounded cache
+	 */
+	uint32_t identifier_hash;
+
+	/* The previous (more recently used) cache value
+	 * Only used by a size bounded cache
+	 */
+	libfcache_internal_cache_value_t *previous_cache_value;
+
+	/* The next (less recently used) cache value
+	 * Only used by a size bounded cache
+	 */
+	libfcache_internal_cache_value_t *next_cache_value;
+
+	/* The next cache value in the same hash bucket
+	 * Only used by a size bounded cache
+	 */
+	libfcache_internal_cache_value_t *next_bucket_cache_value;
 };
 
 int libfcache_cache_value_initialize(
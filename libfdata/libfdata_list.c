@@ -3604,8 +3604,10 @@ int libfdata_list_cache_element_value(
 {
 	libfdata_internal_list_t *internal_list = NULL;
 	static char *function                   = "libfdata_list_cache_element_value";
+	size64_t maximum_cache_size             = 0;
 	int cache_entry_index                   = -1;
 	int number_of_cache_entries             = 0;
+	int result                              = 0;
 
 	if( list == NULL )
 	{
@@ -3631,6 +3633,60 @@ int libfdata_list_cache_element_value(
 
 		return( -1 );
 	}
+	result = libfcache_cache_get_maximum_size(
+	          cache,
+	          &maximum_cache_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* A size bounded cache is indexed by the element identifier
+		 * the element size is used as the size of the element value
+		 */
+		if( element_size > (size64_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid element size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( libfcache_cache_set_value_by_identifier(
+		     cache,
+		     element_file_index,
+		     element_offset,
+		     element_timestamp,
+		     element_value,
+		     (size_t) element_size,
+		     free_element_value,
+		     write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value in cache.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
 	if( libfcache_cache_get_number_of_entries(
 	     cache,
 	     &number_of_cache_entries,
@@ -3713,8 +3769,10 @@ int libfdata_list_get_element_value(
 	off64_t element_offset                  = 0;
 	size64_t element_size                   = 0;
 	time_t cache_value_timestamp            = 0;
+	size64_t maximum_cache_size             = 0;
 	time_t element_timestamp                = 0;
 	uint32_t element_flags                  = 0;
+	uint8_t cache_is_size_bounded           = 0;
 	int cache_entry_index                   = -1;
 	int cache_value_file_index              = -1;
 	int element_file_index                  = -1;
@@ -3763,6 +3821,25 @@ int libfdata_list_get_element_value(
 
 		return( -1 );
 	}
+	result = libfcache_cache_get_maximum_size(
+	          cache,
+	          &maximum_cache_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+	cache_is_size_bounded = (uint8_t) result;
+	result                = 0;
+
 	if( libfcache_cache_get_number_of_entries(
 	     cache,
 	     &number_of_cache_entries,
@@ -3791,7 +3868,8 @@ int libfdata_list_get_element_value(
 
 		return( -1 );
 	}
-	if( number_of_cache_entries <= 0 )
+	if( ( cache_is_size_bounded == 0 )
+	 && ( number_of_cache_entries <= 0 ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -3802,7 +3880,46 @@ int libfdata_list_get_element_value(
 
 		return( -1 );
 	}
-	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+	if( cache_is_size_bounded != 0 )
+	{
+		if( libfdata_list_element_get_timestamp(
+		     element,
+		     &element_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve time stamp from list element.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+		{
+			result = libfcache_cache_get_value_by_identifier(
+			          cache,
+			          element_file_index,
+			          element_offset,
+			          element_timestamp,
+			          &cache_value,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value from cache.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
 	{
 		if( internal_list->calculate_cache_entry_index == NULL )
 		{
@@ -3932,81 +4049,117 @@ int libfdata_list_get_element_value(
 
 			return( -1 );
 		}
-		if( internal_list->calculate_cache_entry_index == NULL )
+		if( cache_is_size_bounded != 0 )
 		{
-			cache_entry_index = element_index % number_of_cache_entries;
-		}
-		else
-		{
-			cache_entry_index = internal_list->calculate_cache_entry_index(
-			                     element_index,
-			                     element_file_index,
-			                     element_offset,
-			                     element_size,
-			                     element_flags,
-			                     number_of_cache_entries );
-		}
-		if( libfcache_cache_get_value_by_index(
-		     cache,
-		     cache_entry_index,
-		     &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache entry: %d from cache.",
-			 function,
-			 cache_entry_index );
-
-			return( -1 );
-		}
-		if( cache_value != NULL )
-		{
-			if( libfdata_list_element_get_timestamp(
-			     element,
-			     &element_timestamp,
-			     error ) != 1 )
+			result = libfcache_cache_get_value_by_identifier(
+			          cache,
+			          element_file_index,
+			          element_offset,
+			          element_timestamp,
+			          &cache_value,
+			          error );
+
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve time stamp from list element.",
+				 "%s: unable to retrieve cache value from cache.",
 				 function );
 
 				return( -1 );
 			}
-			if( libfcache_cache_value_get_identifier(
-			     cache_value,
-			     &cache_value_file_index,
-			     &cache_value_offset,
-			     &cache_value_timestamp,
-			     error ) != 1 )
+			else if( result == 0 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve cache value identifier.",
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing cache value.",
 				 function );
 
 				return( -1 );
 			}
 		}
-		if( ( element_file_index != cache_value_file_index )
-		 || ( element_offset != cache_value_offset )
-		 || ( element_timestamp != cache_value_timestamp ) )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing cache value.",
-			 function );
+			if( internal_list->calculate_cache_entry_index == NULL )
+			{
+				cache_entry_index = element_index % number_of_cache_entries;
+			}
+			else
+			{
+				cache_entry_index = internal_list->calculate_cache_entry_index(
+				                     element_index,
+				                     element_file_index,
+				                     element_offset,
+				                     element_size,
+				                     element_flags,
+				                     number_of_cache_entries );
+			}
+			if( libfcache_cache_get_value_by_index(
+			     cache,
+			     cache_entry_index,
+			     &cache_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache entry: %d from cache.",
+				 function,
+				 cache_entry_index );
 
-			return( -1 );
+				return( -1 );
+			}
+			if( cache_value != NULL )
+			{
+				if( libfdata_list_element_get_timestamp(
+				     element,
+				     &element_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve time stamp from list element.",
+					 function );
+
+					return( -1 );
+				}
+				if( libfcache_cache_value_get_identifier(
+				     cache_value,
+				     &cache_value_file_index,
+				     &cache_value_offset,
+				     &cache_value_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve cache value identifier.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( ( element_file_index != cache_value_file_index )
+			 || ( element_offset != cache_value_offset )
+			 || ( element_timestamp != cache_value_timestamp ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing cache value.",
+				 function );
+
+				return( -1 );
+			}
 		}
 	}
 	if( libfcache_cache_value_get_value(
@@ -4188,13 +4341,16 @@ int libfdata_list_set_element_value(
      uint8_t write_flags,
      libcerror_error_t **error )
 {
-	static char *function    = "libfdata_list_set_element_value";
-	off64_t element_offset   = 0;
-	size64_t element_size    = 0;
-	time_t element_timestamp = 0;
-	uint32_t element_flags   = 0;
-	int element_file_index   = -1;
-	int element_index        = -1;
+	static char *function       = "libfdata_list_set_element_value";
+	off64_t element_offset      = 0;
+	size64_t element_size       = 0;
+	size64_t mapped_size        = 0;
+	size64_t maximum_cache_size = 0;
+	time_t element_timestamp    = 0;
+	uint32_t element_flags      = 0;
+	int element_file_index      = -1;
+	int element_index           = -1;
+	int result                  = 0;
 
 	LIBFDATA_UNREFERENCED_PARAMETER( file_io_handle )
 
@@ -4243,6 +4399,49 @@ int libfdata_list_set_element_value(
 
 		return( -1 );
 	}
+	result = libfcache_cache_get_maximum_size(
+	          cache,
+	          &maximum_cache_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* A size bounded cache accounts for the mapped size since that
+		 * is the size of the element value e.g. after decompression
+		 */
+		result = libfdata_list_element_get_mapped_size(
+		          element,
+		          &mapped_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size from list element.",
+			 function );
+
+			return( -1 );
+		}
+		else if( ( result != 0 )
+		      && ( mapped_size > element_size ) )
+		{
+			element_size = mapped_size;
+		}
+	}
 	if( libfdata_list_cache_element_value(
 	     list,
 	     cache,
@@ -0,0 +1,105 @@
+/*
+ * CPU feature detection functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libhmac_cpu.h"
+
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+
+#include <cpuid.h>
+
+/* Value to indicate the SHA extensions are supported
+ * -1 if not yet determined, 0 if not supported or 1 if supported
+ */
+static int libhmac_cpu_sha_extensions_support = -1;
+
+/* Determines if the CPU supports the SHA extensions
+ * The SHA extensions implementations also require SSSE3 and SSE4.1
+ * Returns 1 if supported or 0 if not
+ */
+int libhmac_cpu_supports_sha_extensions(
+     void )
+{
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+	int result       = 0;
+
+	if( libhmac_cpu_sha_extensions_support != -1 )
+	{
+		return( libhmac_cpu_sha_extensions_support );
+	}
+	/* Concurrent callers determine the same value
+	 */
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) != 0 )
+	{
+		if( ( ( ecx & bit_SSSE3 ) != 0 )
+		 && ( ( ecx & bit_SSE4_1 ) != 0 ) )
+		{
+			if( __get_cpuid_count(
+			     7,
+			     0,
+			     &eax,
+			     &ebx,
+			     &ecx,
+			     &edx ) != 0 )
+			{
+				if( ( ebx & bit_SHA ) != 0 )
+				{
+					result = 1;
+				}
+			}
+		}
+	}
+	libhmac_cpu_sha_extensions_support = result;
+
+	return( result );
+}
+
+/* Enables or disables the use of the SHA extensions
+ * This is used to compare the SHA extensions and portable transforms,
+ * the SHA extensions are only enabled if the CPU supports them
+ * Returns 1 if the SHA extensions are used or 0 if not
+ */
+int libhmac_cpu_set_sha_extensions_support(
+     int enabled )
+{
+	libhmac_cpu_sha_extensions_support = -1;
+
+	if( enabled == 0 )
+	{
+		libhmac_cpu_sha_extensions_support = 0;
+
+		return( 0 );
+	}
+	return( libhmac_cpu_supports_sha_extensions() );
+}
+
+#endif /* defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS ) */
+
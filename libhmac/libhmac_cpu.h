@@ -0,0 +1,56 @@
+/*
+ * CPU feature detection functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBHMAC_CPU_H )
+#define _LIBHMAC_CPU_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The x86 SHA extensions implementations require GCC or Clang function
+ * target attributes and are selected at run-time using CPUID
+ */
+#if !defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( ( defined( __GNUC__ ) && __GNUC__ >= 5 ) || defined( __clang__ ) )
+#define LIBHMAC_HAVE_X86_SHA_EXTENSIONS
+#endif
+#endif
+
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+
+int libhmac_cpu_supports_sha_extensions(
+     void );
+
+int libhmac_cpu_set_sha_extensions_support(
+     int enabled );
+
+#endif /* defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBHMAC_CPU_H ) */
+
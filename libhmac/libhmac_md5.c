@@ -54,7 +54,7 @@ uint32_t libhmac_md5_fixed_constants[ 4 ] = {
 
 /* The first 32-bits of the sines (in radians) of the first 64 integers [ 0, 63 ]
  */
-uint32_t libhmac_md5_sines[ 64 ] = {
+const uint32_t libhmac_md5_sines[ 64 ] = {
 	0xd76aa478UL, 0xe8c7b756UL, 0x242070dbUL, 0xc1bdceeeUL,
 	0xf57c0fafUL, 0x4787c62aUL, 0xa8304613UL, 0xfd469501UL,
 	0x698098d8UL, 0x8b44f7afUL, 0xffff5bb1UL, 0x895cd7beUL,
@@ -75,7 +75,7 @@ uint32_t libhmac_md5_sines[ 64 ] = {
 
 /* The bit shifts
  */
-uint8_t libhmac_md5_bit_shifts[ 64 ] = {
+const uint8_t libhmac_md5_bit_shifts[ 64 ] = {
 	7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
 	5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
 	4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
@@ -96,8 +96,8 @@ uint8_t libhmac_md5_values_32bit_index[ 64 ] = {
 };
 
 #define libhmac_md5_transform_unfolded_calculate_hash_value_round1( values_32bit, value_32bit_index, hash_values, hash_value_index0, hash_value_index1, hash_value_index2, hash_value_index3, block_index ) \
-	hash_values[ hash_value_index0 ] += ( hash_values[ hash_value_index1 ] & hash_values[ hash_value_index2 ] ) \
-	                                  | ( ~( hash_values[ hash_value_index1 ] ) & hash_values[ hash_value_index3 ] ); \
+	hash_values[ hash_value_index0 ] += hash_values[ hash_value_index3 ] \
+	                                  ^ ( hash_values[ hash_value_index1 ] & ( hash_values[ hash_value_index2 ] ^ hash_values[ hash_value_index3 ] ) ); \
 	hash_values[ hash_value_index0 ] += values_32bit[ value_32bit_index ]; \
 	hash_values[ hash_value_index0 ] += libhmac_md5_sines[ block_index ]; \
 \
@@ -108,8 +108,8 @@ uint8_t libhmac_md5_values_32bit_index[ 64 ] = {
 	hash_values[ hash_value_index0 ] += hash_values[ hash_value_index1 ];
 
 #define libhmac_md5_transform_unfolded_calculate_hash_value_round2( values_32bit, value_32bit_index, hash_values, hash_value_index0, hash_value_index1, hash_value_index2, hash_value_index3, block_index ) \
-	hash_values[ hash_value_index0 ] += ( hash_values[ hash_value_index1 ] & hash_values[ hash_value_index3 ] ) \
-	                                  | ( hash_values[ hash_value_index2 ] & ~( hash_values[ hash_value_index3 ] ) ); \
+	hash_values[ hash_value_index0 ] += hash_values[ hash_value_index2 ] \
+	                                  ^ ( hash_values[ hash_value_index3 ] & ( hash_values[ hash_value_index1 ] ^ hash_values[ hash_value_index2 ] ) ); \
 	hash_values[ hash_value_index0 ] += values_32bit[ value_32bit_index ]; \
 	hash_values[ hash_value_index0 ] += libhmac_md5_sines[ block_index ]; \
 \
@@ -286,10 +286,18 @@ ssize_t libhmac_md5_transform(
 		}
 #if defined( LIBHMAC_UNFOLLED_LOOPS )
 		/* Break the block into 16 x 32-bit values
+		 * On a little-endian host the block can be copied as-is
 		 */
+#if defined( __BYTE_ORDER__ ) && ( __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ )
+		memory_copy(
+		 values_32bit,
+		 &( buffer[ buffer_offset ] ),
+		 LIBHMAC_MD5_BLOCK_SIZE );
+#else
 		libhmac_byte_stream_copy_to_16x_uint32_little_endian(
 		 &( buffer[ buffer_offset ] ),
 		 values_32bit );
+#endif
 
 		buffer_offset += LIBHMAC_MD5_BLOCK_SIZE;
 
@@ -37,10 +37,15 @@
 #endif
 
 #include "libhmac_byte_stream.h"
+#include "libhmac_cpu.h"
 #include "libhmac_definitions.h"
 #include "libhmac_libcerror.h"
 #include "libhmac_sha1.h"
 
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+#include <immintrin.h>
+#endif
+
 #if !defined( LIBHMAC_HAVE_SHA1_SUPPORT )
 
 /* RFC 3174/FIPS 180-1 based SHA-1 functions
@@ -321,6 +326,17 @@ ssize_t libhmac_sha1_transform(
 
 		return( -1 );
 	}
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+	if( libhmac_cpu_supports_sha_extensions() != 0 )
+	{
+		buffer_offset = libhmac_sha1_transform_sha_extensions(
+		                 internal_context->hash_values,
+		                 buffer,
+		                 size );
+
+		return( (ssize_t) buffer_offset );
+	}
+#endif
 	while( size >= LIBHMAC_SHA1_BLOCK_SIZE )
 	{
 		if( memory_copy(
@@ -492,6 +508,277 @@ on_error:
 	return( -1 );
 }
 
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+
+/* Calculates the SHA1 of 64 byte sized blocks of data in a buffer using the x86 SHA extensions
+ * Returns the number of bytes used
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+size_t libhmac_sha1_transform_sha_extensions(
+        uint32_t *hash_values,
+        const uint8_t *buffer,
+        size_t size )
+{
+	__m128i abcd_128bit            = _mm_setzero_si128();
+	__m128i byte_order_mask_128bit = _mm_set_epi64x( 0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL );
+	__m128i e0_128bit              = _mm_setzero_si128();
+	__m128i e1_128bit              = _mm_setzero_si128();
+	__m128i message0_128bit        = _mm_setzero_si128();
+	__m128i message1_128bit        = _mm_setzero_si128();
+	__m128i message2_128bit        = _mm_setzero_si128();
+	__m128i message3_128bit        = _mm_setzero_si128();
+	__m128i previous_abcd_128bit   = _mm_setzero_si128();
+	__m128i previous_e0_128bit     = _mm_setzero_si128();
+	size_t buffer_offset           = 0;
+
+	/* The SHA extensions operate on the hash values in the order: ABCD and E
+	 */
+	abcd_128bit = _mm_shuffle_epi32( _mm_loadu_si128( (__m128i *) &( hash_values[ 0 ] ) ), 0x1b );
+	e0_128bit   = _mm_set_epi32( (int) hash_values[ 4 ], 0, 0, 0 );
+
+	while( size >= LIBHMAC_SHA1_BLOCK_SIZE )
+	{
+		previous_abcd_128bit = abcd_128bit;
+		previous_e0_128bit   = e0_128bit;
+
+		/* Rounds 0 - 3
+		 */
+		message0_128bit = _mm_shuffle_epi8(
+		                  _mm_loadu_si128( (__m128i *) &( buffer[ buffer_offset ] ) ),
+		                  byte_order_mask_128bit );
+
+		e0_128bit = _mm_add_epi32( e0_128bit, message0_128bit );
+		e1_128bit = abcd_128bit;
+
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 0 );
+
+		/* Rounds 4 - 7
+		 */
+		message1_128bit = _mm_shuffle_epi8(
+		                  _mm_loadu_si128( (__m128i *) &( buffer[ buffer_offset + 16 ] ) ),
+		                  byte_order_mask_128bit );
+
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message1_128bit );
+		e0_128bit = abcd_128bit;
+
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 0 );
+
+		message0_128bit = _mm_sha1msg1_epu32( message0_128bit, message1_128bit );
+
+		/* Rounds 8 - 11
+		 */
+		message2_128bit = _mm_shuffle_epi8(
+		                  _mm_loadu_si128( (__m128i *) &( buffer[ buffer_offset + 32 ] ) ),
+		                  byte_order_mask_128bit );
+
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message2_128bit );
+		e1_128bit = abcd_128bit;
+
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 0 );
+
+		message1_128bit = _mm_sha1msg1_epu32( message1_128bit, message2_128bit );
+		message0_128bit = _mm_xor_si128( message0_128bit, message2_128bit );
+
+		/* Rounds 12 - 15
+		 */
+		message3_128bit = _mm_shuffle_epi8(
+		                  _mm_loadu_si128( (__m128i *) &( buffer[ buffer_offset + 48 ] ) ),
+		                  byte_order_mask_128bit );
+
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message3_128bit );
+		e0_128bit = abcd_128bit;
+
+		message0_128bit = _mm_sha1msg2_epu32( message0_128bit, message3_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 0 );
+
+		message2_128bit = _mm_sha1msg1_epu32( message2_128bit, message3_128bit );
+		message1_128bit = _mm_xor_si128( message1_128bit, message3_128bit );
+
+		/* Rounds 16 - 19
+		 */
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message0_128bit );
+		e1_128bit = abcd_128bit;
+
+		message1_128bit = _mm_sha1msg2_epu32( message1_128bit, message0_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 0 );
+
+		message3_128bit = _mm_sha1msg1_epu32( message3_128bit, message0_128bit );
+		message2_128bit = _mm_xor_si128( message2_128bit, message0_128bit );
+
+		/* Rounds 20 - 23
+		 */
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message1_128bit );
+		e0_128bit = abcd_128bit;
+
+		message2_128bit = _mm_sha1msg2_epu32( message2_128bit, message1_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 1 );
+
+		message0_128bit = _mm_sha1msg1_epu32( message0_128bit, message1_128bit );
+		message3_128bit = _mm_xor_si128( message3_128bit, message1_128bit );
+
+		/* Rounds 24 - 27
+		 */
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message2_128bit );
+		e1_128bit = abcd_128bit;
+
+		message3_128bit = _mm_sha1msg2_epu32( message3_128bit, message2_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 1 );
+
+		message1_128bit = _mm_sha1msg1_epu32( message1_128bit, message2_128bit );
+		message0_128bit = _mm_xor_si128( message0_128bit, message2_128bit );
+
+		/* Rounds 28 - 31
+		 */
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message3_128bit );
+		e0_128bit = abcd_128bit;
+
+		message0_128bit = _mm_sha1msg2_epu32( message0_128bit, message3_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 1 );
+
+		message2_128bit = _mm_sha1msg1_epu32( message2_128bit, message3_128bit );
+		message1_128bit = _mm_xor_si128( message1_128bit, message3_128bit );
+
+		/* Rounds 32 - 35
+		 */
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message0_128bit );
+		e1_128bit = abcd_128bit;
+
+		message1_128bit = _mm_sha1msg2_epu32( message1_128bit, message0_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 1 );
+
+		message3_128bit = _mm_sha1msg1_epu32( message3_128bit, message0_128bit );
+		message2_128bit = _mm_xor_si128( message2_128bit, message0_128bit );
+
+		/* Rounds 36 - 39
+		 */
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message1_128bit );
+		e0_128bit = abcd_128bit;
+
+		message2_128bit = _mm_sha1msg2_epu32( message2_128bit, message1_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 1 );
+
+		message0_128bit = _mm_sha1msg1_epu32( message0_128bit, message1_128bit );
+		message3_128bit = _mm_xor_si128( message3_128bit, message1_128bit );
+
+		/* Rounds 40 - 43
+		 */
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message2_128bit );
+		e1_128bit = abcd_128bit;
+
+		message3_128bit = _mm_sha1msg2_epu32( message3_128bit, message2_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 2 );
+
+		message1_128bit = _mm_sha1msg1_epu32( message1_128bit, message2_128bit );
+		message0_128bit = _mm_xor_si128( message0_128bit, message2_128bit );
+
+		/* Rounds 44 - 47
+		 */
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message3_128bit );
+		e0_128bit = abcd_128bit;
+
+		message0_128bit = _mm_sha1msg2_epu32( message0_128bit, message3_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 2 );
+
+		message2_128bit = _mm_sha1msg1_epu32( message2_128bit, message3_128bit );
+		message1_128bit = _mm_xor_si128( message1_128bit, message3_128bit );
+
+		/* Rounds 48 - 51
+		 */
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message0_128bit );
+		e1_128bit = abcd_128bit;
+
+		message1_128bit = _mm_sha1msg2_epu32( message1_128bit, message0_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 2 );
+
+		message3_128bit = _mm_sha1msg1_epu32( message3_128bit, message0_128bit );
+		message2_128bit = _mm_xor_si128( message2_128bit, message0_128bit );
+
+		/* Rounds 52 - 55
+		 */
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message1_128bit );
+		e0_128bit = abcd_128bit;
+
+		message2_128bit = _mm_sha1msg2_epu32( message2_128bit, message1_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 2 );
+
+		message0_128bit = _mm_sha1msg1_epu32( message0_128bit, message1_128bit );
+		message3_128bit = _mm_xor_si128( message3_128bit, message1_128bit );
+
+		/* Rounds 56 - 59
+		 */
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message2_128bit );
+		e1_128bit = abcd_128bit;
+
+		message3_128bit = _mm_sha1msg2_epu32( message3_128bit, message2_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 2 );
+
+		message1_128bit = _mm_sha1msg1_epu32( message1_128bit, message2_128bit );
+		message0_128bit = _mm_xor_si128( message0_128bit, message2_128bit );
+
+		/* Rounds 60 - 63
+		 */
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message3_128bit );
+		e0_128bit = abcd_128bit;
+
+		message0_128bit = _mm_sha1msg2_epu32( message0_128bit, message3_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 3 );
+
+		message2_128bit = _mm_sha1msg1_epu32( message2_128bit, message3_128bit );
+		message1_128bit = _mm_xor_si128( message1_128bit, message3_128bit );
+
+		/* Rounds 64 - 67
+		 */
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message0_128bit );
+		e1_128bit = abcd_128bit;
+
+		message1_128bit = _mm_sha1msg2_epu32( message1_128bit, message0_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 3 );
+
+		message3_128bit = _mm_sha1msg1_epu32( message3_128bit, message0_128bit );
+		message2_128bit = _mm_xor_si128( message2_128bit, message0_128bit );
+
+		/* Rounds 68 - 71
+		 */
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message1_128bit );
+		e0_128bit = abcd_128bit;
+
+		message2_128bit = _mm_sha1msg2_epu32( message2_128bit, message1_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 3 );
+
+		message3_128bit = _mm_xor_si128( message3_128bit, message1_128bit );
+
+		/* Rounds 72 - 75
+		 */
+		e0_128bit = _mm_sha1nexte_epu32( e0_128bit, message2_128bit );
+		e1_128bit = abcd_128bit;
+
+		message3_128bit = _mm_sha1msg2_epu32( message3_128bit, message2_128bit );
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e0_128bit, 3 );
+
+		/* Rounds 76 - 79
+		 */
+		e1_128bit = _mm_sha1nexte_epu32( e1_128bit, message3_128bit );
+		e0_128bit = abcd_128bit;
+
+		abcd_128bit = _mm_sha1rnds4_epu32( abcd_128bit, e1_128bit, 3 );
+
+		e0_128bit   = _mm_sha1nexte_epu32( e0_128bit, previous_e0_128bit );
+		abcd_128bit = _mm_add_epi32( abcd_128bit, previous_abcd_128bit );
+
+		buffer_offset += LIBHMAC_SHA1_BLOCK_SIZE;
+		size          -= LIBHMAC_SHA1_BLOCK_SIZE;
+	}
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 _mm_shuffle_epi32( abcd_128bit, 0x1b ) );
+
+	hash_values[ 4 ] = (uint32_t) _mm_extract_epi32( e0_128bit, 3 );
+
+	return( buffer_offset );
+}
+
+#endif /* defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS ) */
+
 #endif /* !defined( LIBHMAC_HAVE_SHA1_SUPPORT ) */
 
 /* Creates a SHA1 context
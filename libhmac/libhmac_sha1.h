@@ -36,6 +36,7 @@
 
 #endif
 
+#include "libhmac_cpu.h"
 #include "libhmac_extern.h"
 #include "libhmac_libcerror.h"
 #include "libhmac_types.h"
@@ -100,6 +101,15 @@ ssize_t libhmac_sha1_transform(
          size_t size,
          libcerror_error_t **error );
 
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+
+size_t libhmac_sha1_transform_sha_extensions(
+        uint32_t *hash_values,
+        const uint8_t *buffer,
+        size_t size );
+
+#endif /* defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS ) */
+
 #endif /* !defined( LIBHMAC_HAVE_SHA1_SUPPORT ) */
 
 LIBHMAC_EXTERN \
@@ -37,10 +37,15 @@
 #endif
 
 #include "libhmac_byte_stream.h"
+#include "libhmac_cpu.h"
 #include "libhmac_definitions.h"
 #include "libhmac_libcerror.h"
 #include "libhmac_sha256.h"
 
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+#include <immintrin.h>
+#endif
+
 #if !defined( LIBHMAC_HAVE_SHA256_SUPPORT )
 
 /* FIPS 180-2 based SHA-256 functions
@@ -282,6 +287,17 @@ ssize_t libhmac_sha256_transform(
 
 		return( -1 );
 	}
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+	if( libhmac_cpu_supports_sha_extensions() != 0 )
+	{
+		buffer_offset = libhmac_sha256_transform_sha_extensions(
+		                 internal_context->hash_values,
+		                 buffer,
+		                 size );
+
+		return( (ssize_t) buffer_offset );
+	}
+#endif
 	while( size >= LIBHMAC_SHA256_BLOCK_SIZE )
 	{
 		if( memory_copy(
@@ -451,6 +467,318 @@ on_error:
 	return( -1 );
 }
 
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+
+/* Calculates the SHA256 of 64 byte sized blocks of data in a buffer using the x86 SHA extensions
+ * Returns the number of bytes used
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+size_t libhmac_sha256_transform_sha_extensions(
+        uint32_t *hash_values,
+        const uint8_t *buffer,
+        size_t size )
+{
+	__m128i byte_order_mask_128bit = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+	__m128i message_128bit         = _mm_setzero_si128();
+	__m128i message0_128bit        = _mm_setzero_si128();
+	__m128i message1_128bit        = _mm_setzero_si128();
+	__m128i message2_128bit        = _mm_setzero_si128();
+	__m128i message3_128bit        = _mm_setzero_si128();
+	__m128i previous_state0_128bit = _mm_setzero_si128();
+	__m128i previous_state1_128bit = _mm_setzero_si128();
+	__m128i state0_128bit          = _mm_setzero_si128();
+	__m128i state1_128bit          = _mm_setzero_si128();
+	__m128i value_128bit           = _mm_setzero_si128();
+	size_t buffer_offset           = 0;
+
+	/* The SHA extensions operate on the hash values in the order: ABEF and CDGH
+	 */
+	value_128bit  = _mm_shuffle_epi32( _mm_loadu_si128( (__m128i *) &( hash_values[ 0 ] ) ), 0xb1 );
+	state1_128bit = _mm_shuffle_epi32( _mm_loadu_si128( (__m128i *) &( hash_values[ 4 ] ) ), 0x1b );
+	state0_128bit = _mm_alignr_epi8( value_128bit, state1_128bit, 8 );
+	state1_128bit = _mm_blend_epi16( state1_128bit, value_128bit, 0xf0 );
+
+	while( size >= LIBHMAC_SHA256_BLOCK_SIZE )
+	{
+		previous_state0_128bit = state0_128bit;
+		previous_state1_128bit = state1_128bit;
+
+		/* Rounds 0 - 3
+		 */
+		message0_128bit = _mm_shuffle_epi8(
+		                  _mm_loadu_si128( (__m128i *) &( buffer[ buffer_offset ] ) ),
+		                  byte_order_mask_128bit );
+
+		message_128bit = _mm_add_epi32(
+		                  message0_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 0 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		/* Rounds 4 - 7
+		 */
+		message1_128bit = _mm_shuffle_epi8(
+		                  _mm_loadu_si128( (__m128i *) &( buffer[ buffer_offset + 16 ] ) ),
+		                  byte_order_mask_128bit );
+
+		message_128bit = _mm_add_epi32(
+		                  message1_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 4 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message0_128bit = _mm_sha256msg1_epu32( message0_128bit, message1_128bit );
+
+		/* Rounds 8 - 11
+		 */
+		message2_128bit = _mm_shuffle_epi8(
+		                  _mm_loadu_si128( (__m128i *) &( buffer[ buffer_offset + 32 ] ) ),
+		                  byte_order_mask_128bit );
+
+		message_128bit = _mm_add_epi32(
+		                  message2_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 8 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message1_128bit = _mm_sha256msg1_epu32( message1_128bit, message2_128bit );
+
+		/* Rounds 12 - 15
+		 */
+		message3_128bit = _mm_shuffle_epi8(
+		                  _mm_loadu_si128( (__m128i *) &( buffer[ buffer_offset + 48 ] ) ),
+		                  byte_order_mask_128bit );
+
+		message_128bit = _mm_add_epi32(
+		                  message3_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 12 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message0_128bit = _mm_add_epi32( message0_128bit, _mm_alignr_epi8( message3_128bit, message2_128bit, 4 ) );
+		message0_128bit = _mm_sha256msg2_epu32( message0_128bit, message3_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message2_128bit = _mm_sha256msg1_epu32( message2_128bit, message3_128bit );
+
+		/* Rounds 16 - 19
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message0_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 16 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message1_128bit = _mm_add_epi32( message1_128bit, _mm_alignr_epi8( message0_128bit, message3_128bit, 4 ) );
+		message1_128bit = _mm_sha256msg2_epu32( message1_128bit, message0_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message3_128bit = _mm_sha256msg1_epu32( message3_128bit, message0_128bit );
+
+		/* Rounds 20 - 23
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message1_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 20 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message2_128bit = _mm_add_epi32( message2_128bit, _mm_alignr_epi8( message1_128bit, message0_128bit, 4 ) );
+		message2_128bit = _mm_sha256msg2_epu32( message2_128bit, message1_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message0_128bit = _mm_sha256msg1_epu32( message0_128bit, message1_128bit );
+
+		/* Rounds 24 - 27
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message2_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 24 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message3_128bit = _mm_add_epi32( message3_128bit, _mm_alignr_epi8( message2_128bit, message1_128bit, 4 ) );
+		message3_128bit = _mm_sha256msg2_epu32( message3_128bit, message2_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message1_128bit = _mm_sha256msg1_epu32( message1_128bit, message2_128bit );
+
+		/* Rounds 28 - 31
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message3_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 28 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message0_128bit = _mm_add_epi32( message0_128bit, _mm_alignr_epi8( message3_128bit, message2_128bit, 4 ) );
+		message0_128bit = _mm_sha256msg2_epu32( message0_128bit, message3_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message2_128bit = _mm_sha256msg1_epu32( message2_128bit, message3_128bit );
+
+		/* Rounds 32 - 35
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message0_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 32 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message1_128bit = _mm_add_epi32( message1_128bit, _mm_alignr_epi8( message0_128bit, message3_128bit, 4 ) );
+		message1_128bit = _mm_sha256msg2_epu32( message1_128bit, message0_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message3_128bit = _mm_sha256msg1_epu32( message3_128bit, message0_128bit );
+
+		/* Rounds 36 - 39
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message1_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 36 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message2_128bit = _mm_add_epi32( message2_128bit, _mm_alignr_epi8( message1_128bit, message0_128bit, 4 ) );
+		message2_128bit = _mm_sha256msg2_epu32( message2_128bit, message1_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message0_128bit = _mm_sha256msg1_epu32( message0_128bit, message1_128bit );
+
+		/* Rounds 40 - 43
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message2_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 40 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message3_128bit = _mm_add_epi32( message3_128bit, _mm_alignr_epi8( message2_128bit, message1_128bit, 4 ) );
+		message3_128bit = _mm_sha256msg2_epu32( message3_128bit, message2_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message1_128bit = _mm_sha256msg1_epu32( message1_128bit, message2_128bit );
+
+		/* Rounds 44 - 47
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message3_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 44 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message0_128bit = _mm_add_epi32( message0_128bit, _mm_alignr_epi8( message3_128bit, message2_128bit, 4 ) );
+		message0_128bit = _mm_sha256msg2_epu32( message0_128bit, message3_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message2_128bit = _mm_sha256msg1_epu32( message2_128bit, message3_128bit );
+
+		/* Rounds 48 - 51
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message0_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 48 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message1_128bit = _mm_add_epi32( message1_128bit, _mm_alignr_epi8( message0_128bit, message3_128bit, 4 ) );
+		message1_128bit = _mm_sha256msg2_epu32( message1_128bit, message0_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		message3_128bit = _mm_sha256msg1_epu32( message3_128bit, message0_128bit );
+
+		/* Rounds 52 - 55
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message1_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 52 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message2_128bit = _mm_add_epi32( message2_128bit, _mm_alignr_epi8( message1_128bit, message0_128bit, 4 ) );
+		message2_128bit = _mm_sha256msg2_epu32( message2_128bit, message1_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		/* Rounds 56 - 59
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message2_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 56 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message3_128bit = _mm_add_epi32( message3_128bit, _mm_alignr_epi8( message2_128bit, message1_128bit, 4 ) );
+		message3_128bit = _mm_sha256msg2_epu32( message3_128bit, message2_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		/* Rounds 60 - 63
+		 */
+		message_128bit = _mm_add_epi32(
+		                  message3_128bit,
+		                  _mm_loadu_si128( (__m128i *) &( libhmac_sha256_prime_cube_roots[ 60 ] ) ) );
+
+		state1_128bit = _mm_sha256rnds2_epu32( state1_128bit, state0_128bit, message_128bit );
+
+		message_128bit = _mm_shuffle_epi32( message_128bit, 0x0e );
+		state0_128bit  = _mm_sha256rnds2_epu32( state0_128bit, state1_128bit, message_128bit );
+
+		state0_128bit = _mm_add_epi32( state0_128bit, previous_state0_128bit );
+		state1_128bit = _mm_add_epi32( state1_128bit, previous_state1_128bit );
+
+		buffer_offset += LIBHMAC_SHA256_BLOCK_SIZE;
+		size          -= LIBHMAC_SHA256_BLOCK_SIZE;
+	}
+	value_128bit  = _mm_shuffle_epi32( state0_128bit, 0x1b );
+	state1_128bit = _mm_shuffle_epi32( state1_128bit, 0xb1 );
+	state0_128bit = _mm_blend_epi16( value_128bit, state1_128bit, 0xf0 );
+	state1_128bit = _mm_alignr_epi8( state1_128bit, value_128bit, 8 );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 state0_128bit );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 4 ] ),
+	 state1_128bit );
+
+	return( buffer_offset );
+}
+
+#endif /* defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS ) */
+
 #endif /* !defined( LIBHMAC_HAVE_SHA256_SUPPORT ) */
 
 /* Creates a SHA256 context
@@ -45,13 +45,15 @@
  * bit 1        set to 1 for read access
  * bit 2        set to 1 for write access
  * bit 3        set to 1 to truncate an existing file on write
- * bit 4-8      not used
+ * bit 4        set to 1 to bypass the system cache using direct IO
+ * bit 5-8      not used
  */
 enum LIBSMDEV_ACCESS_FLAGS
 {
 	LIBSMDEV_ACCESS_FLAG_READ			= 0x01,
 	LIBSMDEV_ACCESS_FLAG_WRITE			= 0x02,
-	LIBSMDEV_ACCESS_FLAG_TRUNCATE			= 0x04
+	LIBSMDEV_ACCESS_FLAG_TRUNCATE			= 0x04,
+	LIBSMDEV_ACCESS_FLAG_DIRECT_IO			= 0x08
 };
 
 /* The file access macros
@@ -0,0 +1,274 @@
+/*
+ * Benchmarks the Adler-32 implementations
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_bench_timer.h"
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_simd.h"
+
+#define EWF_BENCH_ADLER32_BUFFER_SIZE		( 16 * 1024 * 1024 )
+#define EWF_BENCH_ADLER32_PROCESSED_SIZE	( 1024 * 1024 * 1024 )
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+
+/* Calculates the Adler-32 of a buffer using zlib
+ * Returns the Adler-32
+ */
+uint32_t ewf_bench_adler32_calculate_zlib(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size )
+{
+	return( (uint32_t) adler32(
+	                    (uLong) initial_value,
+	                    (const Bytef *) buffer,
+	                    (uInt) size ) );
+}
+
+#endif /* defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+/* Measures the throughput of an Adler-32 implementation on blocks of a specific size
+ * Returns 1 if successful or -1 if the Adler-32 values do not match the reference values
+ */
+int ewf_bench_adler32_measure(
+     const char *name,
+     libewf_checksum_adler32_function_t adler32_function,
+     const uint8_t *buffer,
+     size_t block_size,
+     const uint32_t *reference_values )
+{
+	double seconds        = 0.0;
+	size_t block_offset   = 0;
+	size_t processed_size = 0;
+	uint32_t value        = 0;
+	int block_index       = 0;
+
+	for( block_offset = 0;
+	     block_offset < EWF_BENCH_ADLER32_BUFFER_SIZE;
+	     block_offset += block_size )
+	{
+		value = adler32_function(
+		         1,
+		         &( buffer[ block_offset ] ),
+		         block_size );
+
+		if( value != reference_values[ block_index++ ] )
+		{
+			fprintf(
+			 stderr,
+			 "%s: mismatch in Adler-32 of block at offset: %" PRIzd ".\n",
+			 name,
+			 block_offset );
+
+			return( -1 );
+		}
+	}
+	seconds = ewf_bench_timer_get_seconds();
+
+	while( processed_size < EWF_BENCH_ADLER32_PROCESSED_SIZE )
+	{
+		for( block_offset = 0;
+		     block_offset < EWF_BENCH_ADLER32_BUFFER_SIZE;
+		     block_offset += block_size )
+		{
+			adler32_function(
+			 1,
+			 &( buffer[ block_offset ] ),
+			 block_size );
+		}
+		processed_size += EWF_BENCH_ADLER32_BUFFER_SIZE;
+	}
+	seconds = ewf_bench_timer_get_seconds() - seconds;
+
+	fprintf(
+	 stdout,
+	 "%" PRIzd " KiB\t%-12s\t%8.1f MB/s\n",
+	 block_size / 1024,
+	 name,
+	 (double) processed_size / ( seconds * 1000000.0 ) );
+
+	return( 1 );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+	size_t block_sizes[ 2 ] = { 32 * 1024, 64 * 1024 };
+
+	uint32_t *reference_values = NULL;
+	uint8_t *buffer            = NULL;
+	size_t block_offset        = 0;
+	uint32_t random_value      = 0x12345678UL;
+	int block_index            = 0;
+	int block_size_index       = 0;
+	int result                 = 0;
+
+	if( argc != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Usage: %s\n",
+		 argv[ 0 ] );
+
+		return( EXIT_FAILURE );
+	}
+	buffer = (uint8_t *) malloc(
+	                      EWF_BENCH_ADLER32_BUFFER_SIZE );
+
+	reference_values = (uint32_t *) malloc(
+	                                 sizeof( uint32_t ) * ( EWF_BENCH_ADLER32_BUFFER_SIZE / ( 32 * 1024 ) ) );
+
+	if( ( buffer == NULL )
+	 || ( reference_values == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffers.\n" );
+
+		goto on_error;
+	}
+	for( block_offset = 0;
+	     block_offset < EWF_BENCH_ADLER32_BUFFER_SIZE;
+	     block_offset++ )
+	{
+		random_value = ( random_value * 1103515245UL ) + 12345;
+
+		buffer[ block_offset ] = (uint8_t) ( random_value >> 16 );
+	}
+	for( block_size_index = 0;
+	     block_size_index < 2;
+	     block_size_index++ )
+	{
+		block_index = 0;
+
+		for( block_offset = 0;
+		     block_offset < EWF_BENCH_ADLER32_BUFFER_SIZE;
+		     block_offset += block_sizes[ block_size_index ] )
+		{
+			reference_values[ block_index++ ] = libewf_checksum_calculate_adler32_generic(
+			                                     1,
+			                                     &( buffer[ block_offset ] ),
+			                                     block_sizes[ block_size_index ] );
+		}
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+		result = ewf_bench_adler32_measure(
+		          "zlib",
+		          &ewf_bench_adler32_calculate_zlib,
+		          buffer,
+		          block_sizes[ block_size_index ],
+		          reference_values );
+
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+#endif
+		result = ewf_bench_adler32_measure(
+		          "generic",
+		          &libewf_checksum_calculate_adler32_generic,
+		          buffer,
+		          block_sizes[ block_size_index ],
+		          reference_values );
+
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+#if defined( LIBEWF_HAVE_X86_SIMD )
+		__builtin_cpu_init();
+
+		if( __builtin_cpu_supports( "sse2" ) )
+		{
+			result = ewf_bench_adler32_measure(
+			          "sse2",
+			          &libewf_checksum_calculate_adler32_sse2,
+			          buffer,
+			          block_sizes[ block_size_index ],
+			          reference_values );
+
+			if( result != 1 )
+			{
+				goto on_error;
+			}
+		}
+		if( __builtin_cpu_supports( "avx2" ) )
+		{
+			result = ewf_bench_adler32_measure(
+			          "avx2",
+			          &libewf_checksum_calculate_adler32_avx2,
+			          buffer,
+			          block_sizes[ block_size_index ],
+			          reference_values );
+
+			if( result != 1 )
+			{
+				goto on_error;
+			}
+		}
+#endif
+		result = ewf_bench_adler32_measure(
+		          "dispatched",
+		          libewf_checksum_get_adler32_function(),
+		          buffer,
+		          block_sizes[ block_size_index ],
+		          reference_values );
+
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+	}
+	free(
+	 reference_values );
+	free(
+	 buffer );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( reference_values != NULL )
+	{
+		free(
+		 reference_values );
+	}
+	if( buffer != NULL )
+	{
+		free(
+		 buffer );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,399 @@
+/*
+ * Benchmarks the deflate decompression of EWF chunks
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#include "ewf_bench_timer.h"
+
+#include "../libewf/libewf_compression.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_deflate.h"
+
+#define EWF_BENCH_DEFLATE_CHUNK_SIZE		32768
+#define EWF_BENCH_DEFLATE_MAXIMUM_INPUT_SIZE	( 256 * 1024 * 1024 )
+
+/* Reads the chunks from the input file and compresses them the way
+ * libewf stores them in an EWF-E01 segment file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_deflate_read_chunks(
+     const char *filename,
+     uint8_t **compressed_chunks,
+     size_t **compressed_chunk_sizes,
+     size_t *number_of_chunks,
+     size_t *input_size )
+{
+	uint8_t chunk_data[ EWF_BENCH_DEFLATE_CHUNK_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	FILE *file_stream        = NULL;
+	size_t chunk_index       = 0;
+	size_t compressed_size   = 0;
+	size_t read_count        = 0;
+
+	file_stream = file_stream_open(
+	               filename,
+	               "rb" );
+
+	if( file_stream == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open input file: %s.\n",
+		 filename );
+
+		return( -1 );
+	}
+	*number_of_chunks = EWF_BENCH_DEFLATE_MAXIMUM_INPUT_SIZE / EWF_BENCH_DEFLATE_CHUNK_SIZE;
+
+	*compressed_chunks = (uint8_t *) malloc(
+	                                  *number_of_chunks * ( EWF_BENCH_DEFLATE_CHUNK_SIZE + 1024 ) );
+
+	*compressed_chunk_sizes = (size_t *) malloc(
+	                                      *number_of_chunks * sizeof( size_t ) );
+
+	if( ( *compressed_chunks == NULL )
+	 || ( *compressed_chunk_sizes == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create compressed chunks.\n" );
+
+		goto on_error;
+	}
+	*input_size = 0;
+
+	for( chunk_index = 0;
+	     chunk_index < *number_of_chunks;
+	     chunk_index++ )
+	{
+		read_count = file_stream_read(
+		              file_stream,
+		              chunk_data,
+		              EWF_BENCH_DEFLATE_CHUNK_SIZE );
+
+		if( read_count != EWF_BENCH_DEFLATE_CHUNK_SIZE )
+		{
+			break;
+		}
+		compressed_size = EWF_BENCH_DEFLATE_CHUNK_SIZE + 1024;
+
+		if( libewf_compress_data(
+		     &( ( *compressed_chunks )[ chunk_index * ( EWF_BENCH_DEFLATE_CHUNK_SIZE + 1024 ) ] ),
+		     &compressed_size,
+		     LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		     LIBEWF_COMPRESSION_DEFAULT,
+		     chunk_data,
+		     EWF_BENCH_DEFLATE_CHUNK_SIZE,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to compress chunk: %" PRIzd ".\n",
+			 chunk_index );
+
+			goto on_error;
+		}
+		( *compressed_chunk_sizes )[ chunk_index ] = compressed_size;
+
+		*input_size += EWF_BENCH_DEFLATE_CHUNK_SIZE;
+	}
+	*number_of_chunks = chunk_index;
+
+	file_stream_close(
+	 file_stream );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( *compressed_chunk_sizes != NULL )
+	{
+		free(
+		 *compressed_chunk_sizes );
+
+		*compressed_chunk_sizes = NULL;
+	}
+	if( *compressed_chunks != NULL )
+	{
+		free(
+		 *compressed_chunks );
+
+		*compressed_chunks = NULL;
+	}
+	file_stream_close(
+	 file_stream );
+
+	return( -1 );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+	uint8_t uncompressed_data[ EWF_BENCH_DEFLATE_CHUNK_SIZE ];
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	uint8_t zlib_uncompressed_data[ EWF_BENCH_DEFLATE_CHUNK_SIZE ];
+#endif
+
+	libcerror_error_t *error       = NULL;
+	uint8_t *compressed_chunks     = NULL;
+	size_t *compressed_chunk_sizes = NULL;
+	double libewf_seconds          = 0.0;
+	double start_seconds           = 0.0;
+	double zlib_seconds            = 0.0;
+	size_t chunk_index             = 0;
+	size_t compressed_size         = 0;
+	size_t input_size              = 0;
+	size_t number_of_chunks        = 0;
+	size_t uncompressed_data_size  = 0;
+	int iteration                  = 0;
+	int number_of_iterations       = 5;
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	uLongf zlib_uncompressed_size  = 0;
+#endif
+
+	if( ( argc < 2 )
+	 || ( argc > 3 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Usage: ewf_bench_deflate input_file [iterations]\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( argc == 3 )
+	{
+		number_of_iterations = atoi(
+		                        argv[ 2 ] );
+
+		if( number_of_iterations <= 0 )
+		{
+			number_of_iterations = 1;
+		}
+	}
+	if( ewf_bench_deflate_read_chunks(
+	     argv[ 1 ],
+	     &compressed_chunks,
+	     &compressed_chunk_sizes,
+	     &number_of_chunks,
+	     &input_size ) != 1 )
+	{
+		return( EXIT_FAILURE );
+	}
+	if( number_of_chunks == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Input file is smaller than a single chunk.\n" );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		compressed_size += compressed_chunk_sizes[ chunk_index ];
+	}
+	fprintf(
+	 stdout,
+	 "Chunks:\t\t\t%" PRIzd " of %d bytes (compressed to %" PRIzd " bytes)\n",
+	 number_of_chunks,
+	 EWF_BENCH_DEFLATE_CHUNK_SIZE,
+	 compressed_size );
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	/* Verify the decompressed data against zlib before measuring
+	 */
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		uncompressed_data_size = EWF_BENCH_DEFLATE_CHUNK_SIZE;
+		zlib_uncompressed_size = EWF_BENCH_DEFLATE_CHUNK_SIZE;
+
+		if( libewf_deflate_decompress(
+		     &( compressed_chunks[ chunk_index * ( EWF_BENCH_DEFLATE_CHUNK_SIZE + 1024 ) ] ),
+		     compressed_chunk_sizes[ chunk_index ],
+		     uncompressed_data,
+		     &uncompressed_data_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to decompress chunk: %" PRIzd ".\n",
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( uncompress(
+		     zlib_uncompressed_data,
+		     &zlib_uncompressed_size,
+		     &( compressed_chunks[ chunk_index * ( EWF_BENCH_DEFLATE_CHUNK_SIZE + 1024 ) ] ),
+		     (uLong) compressed_chunk_sizes[ chunk_index ] ) != Z_OK )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to uncompress chunk: %" PRIzd ".\n",
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( ( uncompressed_data_size != (size_t) zlib_uncompressed_size )
+		 || ( memory_compare(
+		       uncompressed_data,
+		       zlib_uncompressed_data,
+		       uncompressed_data_size ) != 0 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in decompressed data of chunk: %" PRIzd ".\n",
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+#endif
+	start_seconds = ewf_bench_timer_get_seconds();
+
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			uncompressed_data_size = EWF_BENCH_DEFLATE_CHUNK_SIZE;
+
+			if( libewf_deflate_decompress(
+			     &( compressed_chunks[ chunk_index * ( EWF_BENCH_DEFLATE_CHUNK_SIZE + 1024 ) ] ),
+			     compressed_chunk_sizes[ chunk_index ],
+			     uncompressed_data,
+			     &uncompressed_data_size,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to decompress chunk: %" PRIzd ".\n",
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( uncompressed_data_size != EWF_BENCH_DEFLATE_CHUNK_SIZE )
+			{
+				fprintf(
+				 stderr,
+				 "Invalid uncompressed size of chunk: %" PRIzd ".\n",
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	libewf_seconds = ewf_bench_timer_get_seconds() - start_seconds;
+
+	fprintf(
+	 stdout,
+	 "libewf_deflate:\t\t%.1f MB/s\n",
+	 ( (double) input_size * number_of_iterations ) / ( libewf_seconds * 1000000.0 ) );
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	start_seconds = ewf_bench_timer_get_seconds();
+
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		for( chunk_index = 0;
+		     chunk_index < number_of_chunks;
+		     chunk_index++ )
+		{
+			zlib_uncompressed_size = EWF_BENCH_DEFLATE_CHUNK_SIZE;
+
+			if( uncompress(
+			     uncompressed_data,
+			     &zlib_uncompressed_size,
+			     &( compressed_chunks[ chunk_index * ( EWF_BENCH_DEFLATE_CHUNK_SIZE + 1024 ) ] ),
+			     (uLong) compressed_chunk_sizes[ chunk_index ] ) != Z_OK )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to uncompress chunk: %" PRIzd ".\n",
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+	zlib_seconds = ewf_bench_timer_get_seconds() - start_seconds;
+
+	fprintf(
+	 stdout,
+	 "zlib uncompress:\t%.1f MB/s\n",
+	 ( (double) input_size * number_of_iterations ) / ( zlib_seconds * 1000000.0 ) );
+#endif
+	free(
+	 compressed_chunk_sizes );
+	free(
+	 compressed_chunks );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	free(
+	 compressed_chunk_sizes );
+	free(
+	 compressed_chunks );
+
+	return( EXIT_FAILURE );
+}
+
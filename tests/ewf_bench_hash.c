@@ -0,0 +1,368 @@
+/*
+ * Benchmarks the libhmac hash functions
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libhmac_cpu.h>
+#include <libhmac_definitions.h>
+#include <libhmac_md5.h>
+#include <libhmac_sha1.h>
+#include <libhmac_sha256.h>
+
+#include "ewf_bench_timer.h"
+
+#define EWF_BENCH_HASH_BLOCK_SIZE		( 32 * 1024 )
+#define EWF_BENCH_HASH_BUFFER_SIZE		( 16 * 1024 * 1024 )
+#define EWF_BENCH_HASH_PROCESSED_SIZE		( 512 * 1024 * 1024 )
+
+enum EWF_BENCH_HASH_TYPES
+{
+	EWF_BENCH_HASH_TYPE_MD5,
+	EWF_BENCH_HASH_TYPE_SHA1,
+	EWF_BENCH_HASH_TYPE_SHA256
+};
+
+/* Measures the throughput of a hash function with updates of a chunk
+ * The hash must be of size LIBHMAC_SHA256_HASH_SIZE
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_hash_measure(
+     int hash_type,
+     const char *implementation,
+     const uint8_t *buffer,
+     uint8_t *hash,
+     libcerror_error_t **error )
+{
+	libhmac_md5_context_t *md5_context       = NULL;
+	libhmac_sha1_context_t *sha1_context     = NULL;
+	libhmac_sha256_context_t *sha256_context = NULL;
+	const char *name                         = NULL;
+	double seconds                           = 0.0;
+	size_t block_offset                      = 0;
+	size_t hash_index                        = 0;
+	size_t hash_size                         = 0;
+	size_t processed_size                    = 0;
+	int result                               = 0;
+
+	switch( hash_type )
+	{
+		case EWF_BENCH_HASH_TYPE_MD5:
+			name      = "MD5";
+			hash_size = LIBHMAC_MD5_HASH_SIZE;
+			result    = libhmac_md5_initialize(
+			             &md5_context,
+			             error );
+			break;
+
+		case EWF_BENCH_HASH_TYPE_SHA1:
+			name      = "SHA1";
+			hash_size = LIBHMAC_SHA1_HASH_SIZE;
+			result    = libhmac_sha1_initialize(
+			             &sha1_context,
+			             error );
+			break;
+
+		case EWF_BENCH_HASH_TYPE_SHA256:
+			name      = "SHA256";
+			hash_size = LIBHMAC_SHA256_HASH_SIZE;
+			result    = libhmac_sha256_initialize(
+			             &sha256_context,
+			             error );
+			break;
+
+		default:
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	seconds = ewf_bench_timer_get_seconds();
+
+	while( processed_size < EWF_BENCH_HASH_PROCESSED_SIZE )
+	{
+		for( block_offset = 0;
+		     block_offset < EWF_BENCH_HASH_BUFFER_SIZE;
+		     block_offset += EWF_BENCH_HASH_BLOCK_SIZE )
+		{
+			switch( hash_type )
+			{
+				case EWF_BENCH_HASH_TYPE_MD5:
+					result = libhmac_md5_update(
+					          md5_context,
+					          &( buffer[ block_offset ] ),
+					          EWF_BENCH_HASH_BLOCK_SIZE,
+					          error );
+					break;
+
+				case EWF_BENCH_HASH_TYPE_SHA1:
+					result = libhmac_sha1_update(
+					          sha1_context,
+					          &( buffer[ block_offset ] ),
+					          EWF_BENCH_HASH_BLOCK_SIZE,
+					          error );
+					break;
+
+				case EWF_BENCH_HASH_TYPE_SHA256:
+					result = libhmac_sha256_update(
+					          sha256_context,
+					          &( buffer[ block_offset ] ),
+					          EWF_BENCH_HASH_BLOCK_SIZE,
+					          error );
+					break;
+			}
+			if( result != 1 )
+			{
+				goto on_error;
+			}
+		}
+		processed_size += EWF_BENCH_HASH_BUFFER_SIZE;
+	}
+	switch( hash_type )
+	{
+		case EWF_BENCH_HASH_TYPE_MD5:
+			result = libhmac_md5_finalize(
+			          md5_context,
+			          hash,
+			          hash_size,
+			          error );
+			break;
+
+		case EWF_BENCH_HASH_TYPE_SHA1:
+			result = libhmac_sha1_finalize(
+			          sha1_context,
+			          hash,
+			          hash_size,
+			          error );
+			break;
+
+		case EWF_BENCH_HASH_TYPE_SHA256:
+			result = libhmac_sha256_finalize(
+			          sha256_context,
+			          hash,
+			          hash_size,
+			          error );
+			break;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	seconds = ewf_bench_timer_get_seconds() - seconds;
+
+	/* The digest is printed so that it can be compared between builds
+	 */
+	fprintf(
+	 stdout,
+	 "%-8s\t%-8s\t%8.1f MB/s\t",
+	 name,
+	 implementation,
+	 (double) processed_size / ( seconds * 1000000.0 ) );
+
+	for( hash_index = 0;
+	     hash_index < hash_size;
+	     hash_index++ )
+	{
+		fprintf(
+		 stdout,
+		 "%02" PRIx8 "",
+		 hash[ hash_index ] );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	result = 1;
+
+on_error:
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	if( sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &sha1_context,
+		 NULL );
+	}
+	if( sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &sha256_context,
+		 NULL );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+	uint8_t hash[ LIBHMAC_SHA256_HASH_SIZE ];
+	uint8_t reference_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	size_t buffer_offset     = 0;
+	uint32_t random_value    = 0x12345678UL;
+	int hash_type            = 0;
+
+	if( argc != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Usage: %s\n",
+		 argv[ 0 ] );
+
+		return( EXIT_FAILURE );
+	}
+	buffer = (uint8_t *) malloc(
+	                      EWF_BENCH_HASH_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffer.\n" );
+
+		goto on_error;
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < EWF_BENCH_HASH_BUFFER_SIZE;
+	     buffer_offset++ )
+	{
+		random_value = ( random_value * 1103515245UL ) + 12345;
+
+		buffer[ buffer_offset ] = (uint8_t) ( random_value >> 16 );
+	}
+	if( ewf_bench_hash_measure(
+	     EWF_BENCH_HASH_TYPE_MD5,
+	     "portable",
+	     buffer,
+	     hash,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to measure MD5.\n" );
+
+		goto on_error;
+	}
+	for( hash_type = EWF_BENCH_HASH_TYPE_SHA1;
+	     hash_type <= EWF_BENCH_HASH_TYPE_SHA256;
+	     hash_type++ )
+	{
+		memory_set(
+		 hash,
+		 0,
+		 LIBHMAC_SHA256_HASH_SIZE );
+
+		memory_set(
+		 reference_hash,
+		 0,
+		 LIBHMAC_SHA256_HASH_SIZE );
+
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+		/* Force the portable transform to compare it with the SHA extensions
+		 */
+		libhmac_cpu_set_sha_extensions_support(
+		 0 );
+#endif
+		if( ewf_bench_hash_measure(
+		     hash_type,
+		     "portable",
+		     buffer,
+		     hash,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to measure portable hash.\n" );
+
+			goto on_error;
+		}
+#if defined( LIBHMAC_HAVE_X86_SHA_EXTENSIONS )
+		if( libhmac_cpu_set_sha_extensions_support(
+		     1 ) == 1 )
+		{
+			if( ewf_bench_hash_measure(
+			     hash_type,
+			     "sha-ext",
+			     buffer,
+			     reference_hash,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to measure SHA extensions hash.\n" );
+
+				goto on_error;
+			}
+			if( memory_compare(
+			     hash,
+			     reference_hash,
+			     LIBHMAC_SHA256_HASH_SIZE ) != 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Mismatch between portable and SHA extensions hash.\n" );
+
+				goto on_error;
+			}
+		}
+#endif
+	}
+	free(
+	 buffer );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		free(
+		 buffer );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,971 @@
+/*
+ * Benchmarks batched io_uring reads against synchronous reads
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <libbfio_definitions.h>
+#include <libbfio_file.h>
+#include <libbfio_file_io_uring.h>
+#include <libbfio_handle.h>
+
+#include <libcerror_error.h>
+
+#include "ewf_bench_timer.h"
+
+#define EWF_BENCH_IO_URING_DEFAULT_FILE_SIZE	( 256 * 1024 * 1024 )
+#define EWF_BENCH_IO_URING_READ_SIZE		( 32 * 1024 )
+#define EWF_BENCH_IO_URING_MAXIMUM_QUEUE_DEPTH	64
+#define EWF_BENCH_IO_URING_WRITE_SIZE		( 4 * 1024 * 1024 )
+
+/* Removes the pages of the file from the page cache
+ */
+void ewf_bench_io_uring_drop_cache(
+      const char *filename )
+{
+	int file_descriptor = 0;
+
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor != -1 )
+	{
+		posix_fadvise(
+		 file_descriptor,
+		 0,
+		 0,
+		 POSIX_FADV_DONTNEED );
+
+		close(
+		 file_descriptor );
+	}
+}
+
+/* Creates a test file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_io_uring_create_file(
+     const char *filename,
+     size64_t file_size )
+{
+	uint8_t buffer[ EWF_BENCH_IO_URING_READ_SIZE ];
+
+	size64_t remaining_size = file_size;
+	uint32_t value          = 0;
+	size_t buffer_index     = 0;
+	int file_descriptor     = 0;
+
+	file_descriptor = open(
+	                   filename,
+	                   O_WRONLY | O_CREAT | O_TRUNC,
+	                   0600 );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	while( remaining_size > 0 )
+	{
+		for( buffer_index = 0;
+		     buffer_index < EWF_BENCH_IO_URING_READ_SIZE;
+		     buffer_index++ )
+		{
+			value = ( value * 1103515245UL ) + 12345;
+
+			buffer[ buffer_index ] = (uint8_t) ( value >> 16 );
+		}
+		if( write(
+		     file_descriptor,
+		     buffer,
+		     EWF_BENCH_IO_URING_READ_SIZE ) != (ssize_t) EWF_BENCH_IO_URING_READ_SIZE )
+		{
+			close(
+			 file_descriptor );
+
+			return( -1 );
+		}
+		remaining_size -= EWF_BENCH_IO_URING_READ_SIZE;
+	}
+	if( fsync(
+	     file_descriptor ) != 0 )
+	{
+		close(
+		 file_descriptor );
+
+		return( -1 );
+	}
+	close(
+	 file_descriptor );
+
+	return( 1 );
+}
+
+/* Determines the size of a file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_io_uring_get_file_size(
+     const char *filename,
+     size64_t *file_size )
+{
+	off64_t offset      = 0;
+	int file_descriptor = 0;
+
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	offset = lseek(
+	          file_descriptor,
+	          0,
+	          SEEK_END );
+
+	close(
+	 file_descriptor );
+
+	if( offset < 0 )
+	{
+		return( -1 );
+	}
+	*file_size = (size64_t) offset;
+
+	return( 1 );
+}
+
+/* Determines the offsets of the reads
+ * The offsets are either sequential or a random permutation of the 32 KiB blocks of the file
+ */
+void ewf_bench_io_uring_get_offsets(
+      off64_t *offsets,
+      int number_of_offsets,
+      int random_order )
+{
+	off64_t offset   = 0;
+	uint32_t value   = 1;
+	int offset_index = 0;
+	int swap_index   = 0;
+
+	for( offset_index = 0;
+	     offset_index < number_of_offsets;
+	     offset_index++ )
+	{
+		offsets[ offset_index ] = (off64_t) offset_index * EWF_BENCH_IO_URING_READ_SIZE;
+	}
+	if( random_order != 0 )
+	{
+		for( offset_index = number_of_offsets - 1;
+		     offset_index > 0;
+		     offset_index-- )
+		{
+			value = ( value * 1103515245UL ) + 12345;
+
+			swap_index = (int) ( ( value >> 8 ) % (uint32_t) ( offset_index + 1 ) );
+
+			offset                  = offsets[ offset_index ];
+			offsets[ offset_index ] = offsets[ swap_index ];
+			offsets[ swap_index ]   = offset;
+		}
+	}
+}
+
+/* Reads the blocks one at a time with a file handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_io_uring_read_synchronous(
+     const char *filename,
+     const off64_t *offsets,
+     int number_of_offsets,
+     uint8_t *buffers,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	ssize_t read_count               = 0;
+	int offset_index                 = 0;
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length( filename ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( offset_index = 0;
+	     offset_index < number_of_offsets;
+	     offset_index++ )
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              buffers,
+		              EWF_BENCH_IO_URING_READ_SIZE,
+		              offsets[ offset_index ],
+		              error );
+
+		if( read_count != (ssize_t) EWF_BENCH_IO_URING_READ_SIZE )
+		{
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the blocks in batches of queue depth reads with an io_uring file handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_io_uring_read_batched(
+     const char *filename,
+     const off64_t *offsets,
+     int number_of_offsets,
+     int queue_depth,
+     uint8_t *buffers,
+     int *uses_io_uring,
+     libcerror_error_t **error )
+{
+	libbfio_read_request_t read_requests[ EWF_BENCH_IO_URING_MAXIMUM_QUEUE_DEPTH ];
+
+	libbfio_file_io_uring_io_handle_t *io_handle = NULL;
+	libbfio_handle_t *file_io_handle             = NULL;
+	int number_of_read_requests                  = 0;
+	int offset_index                             = 0;
+	int read_request_index                       = 0;
+
+	if( libbfio_file_io_uring_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_file_io_uring_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length( filename ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_file_io_uring_set_queue_depth(
+	     file_io_handle,
+	     queue_depth,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_get_io_handle(
+	     file_io_handle,
+	     (intptr_t **) &io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+	*uses_io_uring = ( io_handle->ring_descriptor != -1 );
+#else
+	*uses_io_uring = 0;
+#endif
+	for( offset_index = 0;
+	     offset_index < number_of_offsets;
+	     offset_index += number_of_read_requests )
+	{
+		number_of_read_requests = number_of_offsets - offset_index;
+
+		if( number_of_read_requests > queue_depth )
+		{
+			number_of_read_requests = queue_depth;
+		}
+		for( read_request_index = 0;
+		     read_request_index < number_of_read_requests;
+		     read_request_index++ )
+		{
+			read_requests[ read_request_index ].buffer     = &( buffers[ read_request_index * EWF_BENCH_IO_URING_READ_SIZE ] );
+			read_requests[ read_request_index ].size       = EWF_BENCH_IO_URING_READ_SIZE;
+			read_requests[ read_request_index ].offset     = offsets[ offset_index + read_request_index ];
+			read_requests[ read_request_index ].read_count = 0;
+		}
+		if( libbfio_handle_read_buffers_at_offsets(
+		     file_io_handle,
+		     read_requests,
+		     number_of_read_requests,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		for( read_request_index = 0;
+		     read_request_index < number_of_read_requests;
+		     read_request_index++ )
+		{
+			if( read_requests[ read_request_index ].read_count != (ssize_t) EWF_BENCH_IO_URING_READ_SIZE )
+			{
+				goto on_error;
+			}
+		}
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the file in buffers of the write size with a file handle
+ * or an io_uring file handle if the queue depth is not 0
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_io_uring_write(
+     const char *filename,
+     size64_t file_size,
+     int queue_depth,
+     const uint8_t *buffer,
+     int *uses_io_uring,
+     libcerror_error_t **error )
+{
+	libbfio_file_io_uring_io_handle_t *io_handle = NULL;
+	libbfio_handle_t *file_io_handle             = NULL;
+	size64_t remaining_size                      = 0;
+	ssize_t write_count                          = 0;
+	int file_descriptor                          = 0;
+	int result                                   = 0;
+
+	if( queue_depth == 0 )
+	{
+		result = libbfio_file_initialize(
+		          &file_io_handle,
+		          error );
+	}
+	else
+	{
+		result = libbfio_file_io_uring_initialize(
+		          &file_io_handle,
+		          error );
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( queue_depth == 0 )
+	{
+		result = libbfio_file_set_name(
+		          file_io_handle,
+		          filename,
+		          narrow_string_length( filename ),
+		          error );
+	}
+	else
+	{
+		result = libbfio_file_io_uring_set_name(
+		          file_io_handle,
+		          filename,
+		          narrow_string_length( filename ),
+		          error );
+
+		if( result == 1 )
+		{
+			result = libbfio_file_io_uring_set_queue_depth(
+			          file_io_handle,
+			          queue_depth,
+			          error );
+		}
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	*uses_io_uring = 0;
+
+	if( queue_depth != 0 )
+	{
+		if( libbfio_handle_get_io_handle(
+		     file_io_handle,
+		     (intptr_t **) &io_handle,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+#if defined( HAVE_LIBBFIO_IO_URING_SUPPORT )
+		*uses_io_uring = ( io_handle->ring_descriptor != -1 );
+#endif
+	}
+	for( remaining_size = file_size;
+	     remaining_size >= EWF_BENCH_IO_URING_WRITE_SIZE;
+	     remaining_size -= EWF_BENCH_IO_URING_WRITE_SIZE )
+	{
+		write_count = libbfio_handle_write_buffer(
+		               file_io_handle,
+		               buffer,
+		               EWF_BENCH_IO_URING_WRITE_SIZE,
+		               error );
+
+		if( write_count != (ssize_t) EWF_BENCH_IO_URING_WRITE_SIZE )
+		{
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* Make sure the data is written to the storage
+	 */
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		goto on_error;
+	}
+	fsync(
+	 file_descriptor );
+
+	close(
+	 file_descriptor );
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Verifies that the file contains the buffer repeatedly
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_io_uring_verify_written(
+     const char *filename,
+     size64_t file_size,
+     const uint8_t *buffer,
+     uint8_t *verify_buffer )
+{
+	size64_t remaining_size = 0;
+	int file_descriptor     = 0;
+
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	for( remaining_size = file_size;
+	     remaining_size >= EWF_BENCH_IO_URING_WRITE_SIZE;
+	     remaining_size -= EWF_BENCH_IO_URING_WRITE_SIZE )
+	{
+		if( read(
+		     file_descriptor,
+		     verify_buffer,
+		     EWF_BENCH_IO_URING_WRITE_SIZE ) != (ssize_t) EWF_BENCH_IO_URING_WRITE_SIZE )
+		{
+			break;
+		}
+		if( memory_compare(
+		     verify_buffer,
+		     buffer,
+		     EWF_BENCH_IO_URING_WRITE_SIZE ) != 0 )
+		{
+			break;
+		}
+	}
+	close(
+	 file_descriptor );
+
+	if( remaining_size >= EWF_BENCH_IO_URING_WRITE_SIZE )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints the throughput of a run
+ */
+void ewf_bench_io_uring_print_result(
+      const char *description,
+      int queue_depth,
+      const char *order,
+      size64_t size,
+      double seconds )
+{
+	fprintf(
+	 stdout,
+	 "%-12s\t%d\t%s\t%8.3f s\t%8.1f MB/s\n",
+	 description,
+	 queue_depth,
+	 order,
+	 seconds,
+	 (double) size / ( seconds * 1000000.0 ) );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+	char filename_buffer[ 64 ];
+	char write_filename[ 64 ];
+	char directory[ 32 ]        = "/tmp/ewf_bench_XXXXXX";
+	int queue_depths[ 4 ]       = { 4, 8, 32, 64 };
+	int write_queue_depths[ 4 ] = { 0, 2, 4, 8 };
+
+	libcerror_error_t *error    = NULL;
+	const char *description     = NULL;
+	const char *filename        = NULL;
+	const char *order           = NULL;
+	off64_t *offsets            = NULL;
+	uint8_t *buffers            = NULL;
+	uint8_t *verify_buffer      = NULL;
+	uint8_t *write_buffer       = NULL;
+	size64_t file_size          = 0;
+	double seconds              = 0.0;
+	size_t buffer_index         = 0;
+	uint32_t value              = 0;
+	int created_file            = 0;
+	int number_of_offsets       = 0;
+	int queue_depth_index       = 0;
+	int random_order            = 0;
+	int uses_io_uring           = 0;
+
+	if( argc > 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Usage: ewf_bench_io_uring [ file ]\n\n"
+		 "\tfile: the file to read, by default a 256 MiB file is created in /tmp\n"
+		 "\tthe writes are always done to a 256 MiB file in /tmp\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* The written file is always created in the temporary directory
+	 */
+	if( mkdtemp(
+	     directory ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create temporary directory.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	snprintf(
+	 write_filename,
+	 64,
+	 "%s/write.raw",
+	 directory );
+
+	if( argc == 2 )
+	{
+		filename = argv[ 1 ];
+	}
+	else
+	{
+		snprintf(
+		 filename_buffer,
+		 64,
+		 "%s/bench.raw",
+		 directory );
+
+		filename     = filename_buffer;
+		created_file = 1;
+
+		if( ewf_bench_io_uring_create_file(
+		     filename,
+		     EWF_BENCH_IO_URING_DEFAULT_FILE_SIZE ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create test file.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ewf_bench_io_uring_get_file_size(
+	     filename,
+	     &file_size ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine size of file: %s.\n",
+		 filename );
+
+		goto on_error;
+	}
+	number_of_offsets = (int) ( file_size / EWF_BENCH_IO_URING_READ_SIZE );
+
+	if( number_of_offsets == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "File: %s is too small.\n",
+		 filename );
+
+		goto on_error;
+	}
+	offsets = (off64_t *) memory_allocate(
+	                       sizeof( off64_t ) * number_of_offsets );
+
+	buffers = (uint8_t *) memory_allocate(
+	                       EWF_BENCH_IO_URING_READ_SIZE * EWF_BENCH_IO_URING_MAXIMUM_QUEUE_DEPTH );
+
+	if( ( offsets == NULL )
+	 || ( buffers == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffers.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "%d reads of %d bytes from: %s with the page cache dropped before each run\n",
+	 number_of_offsets,
+	 EWF_BENCH_IO_URING_READ_SIZE,
+	 filename );
+
+	fprintf(
+	 stdout,
+	 "handle\t\tdepth\torder\ttime\t\tthroughput\n" );
+
+	for( random_order = 0;
+	     random_order <= 1;
+	     random_order++ )
+	{
+		if( random_order == 0 )
+		{
+			order = "sequential";
+		}
+		else
+		{
+			order = "random";
+		}
+		ewf_bench_io_uring_get_offsets(
+		 offsets,
+		 number_of_offsets,
+		 random_order );
+
+		ewf_bench_io_uring_drop_cache(
+		 filename );
+
+		seconds = ewf_bench_timer_get_seconds();
+
+		if( ewf_bench_io_uring_read_synchronous(
+		     filename,
+		     offsets,
+		     number_of_offsets,
+		     buffers,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read file synchronously.\n" );
+
+			goto on_error;
+		}
+		seconds = ewf_bench_timer_get_seconds() - seconds;
+
+		ewf_bench_io_uring_print_result(
+		 "file",
+		 1,
+		 order,
+		 (size64_t) number_of_offsets * EWF_BENCH_IO_URING_READ_SIZE,
+		 seconds );
+
+		for( queue_depth_index = 0;
+		     queue_depth_index < 4;
+		     queue_depth_index++ )
+		{
+			ewf_bench_io_uring_drop_cache(
+			 filename );
+
+			seconds = ewf_bench_timer_get_seconds();
+
+			if( ewf_bench_io_uring_read_batched(
+			     filename,
+			     offsets,
+			     number_of_offsets,
+			     queue_depths[ queue_depth_index ],
+			     buffers,
+			     &uses_io_uring,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to read file in batches.\n" );
+
+				goto on_error;
+			}
+			seconds = ewf_bench_timer_get_seconds() - seconds;
+
+			ewf_bench_io_uring_print_result(
+			 uses_io_uring != 0 ? "file_io_uring" : "file_io_uring (pread fallback)",
+			 queue_depths[ queue_depth_index ],
+			 order,
+			 (size64_t) number_of_offsets * EWF_BENCH_IO_URING_READ_SIZE,
+			 seconds );
+		}
+	}
+	write_buffer = (uint8_t *) memory_allocate(
+	                            EWF_BENCH_IO_URING_WRITE_SIZE );
+
+	verify_buffer = (uint8_t *) memory_allocate(
+	                             EWF_BENCH_IO_URING_WRITE_SIZE );
+
+	if( ( write_buffer == NULL )
+	 || ( verify_buffer == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create write buffers.\n" );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < EWF_BENCH_IO_URING_WRITE_SIZE;
+	     buffer_index++ )
+	{
+		value = ( value * 1103515245UL ) + 12345;
+
+		write_buffer[ buffer_index ] = (uint8_t) ( value >> 16 );
+	}
+	fprintf(
+	 stdout,
+	 "\n%d writes of %d bytes to: %s including the flush to storage\n",
+	 (int) ( EWF_BENCH_IO_URING_DEFAULT_FILE_SIZE / EWF_BENCH_IO_URING_WRITE_SIZE ),
+	 EWF_BENCH_IO_URING_WRITE_SIZE,
+	 write_filename );
+
+	fprintf(
+	 stdout,
+	 "handle\t\tdepth\torder\ttime\t\tthroughput\n" );
+
+	for( queue_depth_index = 0;
+	     queue_depth_index < 4;
+	     queue_depth_index++ )
+	{
+		seconds = ewf_bench_timer_get_seconds();
+
+		if( ewf_bench_io_uring_write(
+		     write_filename,
+		     EWF_BENCH_IO_URING_DEFAULT_FILE_SIZE,
+		     write_queue_depths[ queue_depth_index ],
+		     write_buffer,
+		     &uses_io_uring,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to write file.\n" );
+
+			goto on_error;
+		}
+		seconds = ewf_bench_timer_get_seconds() - seconds;
+
+		if( ewf_bench_io_uring_verify_written(
+		     write_filename,
+		     EWF_BENCH_IO_URING_DEFAULT_FILE_SIZE,
+		     write_buffer,
+		     verify_buffer ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Written file does not contain the written data.\n" );
+
+			goto on_error;
+		}
+		if( write_queue_depths[ queue_depth_index ] == 0 )
+		{
+			description = "file";
+		}
+		else if( uses_io_uring != 0 )
+		{
+			description = "file_io_uring";
+		}
+		else
+		{
+			description = "file_io_uring (write fallback)";
+		}
+		ewf_bench_io_uring_print_result(
+		 description,
+		 write_queue_depths[ queue_depth_index ] == 0 ? 1 : write_queue_depths[ queue_depth_index ],
+		 "write",
+		 EWF_BENCH_IO_URING_DEFAULT_FILE_SIZE,
+		 seconds );
+	}
+	memory_free(
+	 verify_buffer );
+	memory_free(
+	 write_buffer );
+	memory_free(
+	 buffers );
+	memory_free(
+	 offsets );
+
+	unlink(
+	 write_filename );
+
+	if( created_file != 0 )
+	{
+		unlink(
+		 filename );
+	}
+	rmdir(
+	 directory );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffers != NULL )
+	{
+		memory_free(
+		 buffers );
+	}
+	if( offsets != NULL )
+	{
+		memory_free(
+		 offsets );
+	}
+	if( verify_buffer != NULL )
+	{
+		memory_free(
+		 verify_buffer );
+	}
+	if( write_buffer != NULL )
+	{
+		memory_free(
+		 write_buffer );
+	}
+	unlink(
+	 write_filename );
+
+	if( created_file != 0 )
+	{
+		unlink(
+		 filename );
+	}
+	rmdir(
+	 directory );
+
+	return( EXIT_FAILURE );
+}
+
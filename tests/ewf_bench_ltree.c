@@ -0,0 +1,238 @@
+/*
+ * Benchmarks parsing the single files ltree
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_RESOURCE_H ) || !defined( WINAPI )
+#include <sys/resource.h>
+#endif
+
+#include <libcerror_error.h>
+
+#include "ewf_bench_timer.h"
+#include "ewf_test_ltree.h"
+
+#include "../libewf/libewf_single_files.h"
+
+/* Retrieves the peak resident set size in KiB
+ */
+long ewf_bench_ltree_get_maximum_resident_set_size(
+      void )
+{
+	struct rusage resource_usage;
+
+	if( getrusage(
+	     RUSAGE_SELF,
+	     &resource_usage ) != 0 )
+	{
+		return( 0 );
+	}
+	return( resource_usage.ru_maxrss );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+	libcdata_tree_node_t *root_node      = NULL;
+	libcerror_error_t *error             = NULL;
+	libewf_single_files_t *single_files  = NULL;
+	uint8_t *ltree_data                  = NULL;
+	double seconds                       = 0.0;
+	size64_t media_size                  = 0;
+	size_t ltree_data_size               = 0;
+	long maximum_resident_set_size       = 0;
+	long resident_set_size               = 0;
+	uint8_t format                       = 0;
+	int number_of_directories            = 100;
+	int number_of_files                  = 10000;
+	int number_of_sub_nodes              = 0;
+
+	if( ( argc != 1 )
+	 && ( argc != 3 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Usage: ewf_bench_ltree [ number_of_directories number_of_files ]\n\n"
+		 "\tnumber_of_directories: the number of directories (default is 100)\n"
+		 "\tnumber_of_files: the number of files per directory (default is 10000)\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( argc == 3 )
+	{
+		number_of_directories = atoi(
+		                         argv[ 1 ] );
+
+		number_of_files = atoi(
+		                   argv[ 2 ] );
+	}
+	if( ( number_of_directories <= 0 )
+	 || ( number_of_files < 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Invalid number of directories or files.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	ewf_test_ltree_generate(
+	 NULL,
+	 &ltree_data_size,
+	 number_of_directories,
+	 number_of_files );
+
+	ltree_data = (uint8_t *) memory_allocate(
+	                          ltree_data_size );
+
+	if( ltree_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create ltree data.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	ewf_test_ltree_generate(
+	 ltree_data,
+	 &ltree_data_size,
+	 number_of_directories,
+	 number_of_files );
+
+	if( libewf_single_files_initialize(
+	     &single_files,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize single files.\n" );
+
+		goto on_error;
+	}
+	/* The single files take over management of the ltree data
+	 */
+	single_files->section_data      = ltree_data;
+	single_files->section_data_size = ltree_data_size;
+	single_files->ltree_data        = ltree_data;
+	single_files->ltree_data_size   = ltree_data_size;
+
+	ltree_data = NULL;
+
+	resident_set_size = ewf_bench_ltree_get_maximum_resident_set_size();
+
+	seconds = ewf_bench_timer_get_seconds();
+
+	if( libewf_single_files_parse(
+	     single_files,
+	     &media_size,
+	     &format,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to parse ltree.\n" );
+
+		goto on_error;
+	}
+	seconds = ewf_bench_timer_get_seconds() - seconds;
+
+	maximum_resident_set_size = ewf_bench_ltree_get_maximum_resident_set_size();
+
+	root_node = single_files->root_file_entry_node;
+
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     root_node,
+	     &number_of_sub_nodes,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve number of sub file entries.\n" );
+
+		goto on_error;
+	}
+	if( ( media_size != (size64_t) EWF_TEST_LTREE_MEDIA_SIZE )
+	 || ( number_of_sub_nodes != number_of_directories ) )
+	{
+		fprintf(
+		 stderr,
+		 "Parsed ltree does not match generated ltree.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "%d directories of %d files, %" PRIzd " MiB of ltree data\n",
+	 number_of_directories,
+	 number_of_files,
+	 ltree_data_size / ( 1024 * 1024 ) );
+
+	fprintf(
+	 stdout,
+	 "parse time: %.3f s, peak RSS: %ld MiB, peak RSS before parse: %ld MiB\n",
+	 seconds,
+	 maximum_resident_set_size / 1024,
+	 resident_set_size / 1024 );
+
+	if( libewf_single_files_free(
+	     &single_files,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free single files.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	if( ltree_data != NULL )
+	{
+		memory_free(
+		 ltree_data );
+	}
+	return( EXIT_FAILURE );
+}
+
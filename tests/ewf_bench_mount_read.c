@@ -0,0 +1,609 @@
+/*
+ * Benchmarks concurrent readers of a mount handle
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <libewf.h>
+
+#include <libcthreads_mutex.h>
+#include <libcthreads_thread.h>
+
+#include "ewf_bench_timer.h"
+#include "ewf_test_image.h"
+
+#include "mount_handle.h"
+
+#define EWF_BENCH_MOUNT_READ_MEDIA_SIZE			( 64 * 1024 * 1024 )
+#define EWF_BENCH_MOUNT_READ_SEGMENT_SIZE		( 16 * 1024 * 1024 )
+#define EWF_BENCH_MOUNT_READ_READ_SIZE			( 128 * 1024 )
+#define EWF_BENCH_MOUNT_READ_VERIFY_SIZE		4096
+#define EWF_BENCH_MOUNT_READ_MAXIMUM_NUMBER_OF_THREADS	8
+
+enum EWF_BENCH_MOUNT_READ_MODES
+{
+	EWF_BENCH_MOUNT_READ_MODE_SEEK_AND_READ		= 0,
+	EWF_BENCH_MOUNT_READ_MODE_READ_AT_OFFSET	= 1
+};
+
+typedef struct ewf_bench_mount_read_thread_values ewf_bench_mount_read_thread_values_t;
+
+struct ewf_bench_mount_read_thread_values
+{
+	/* The mount handle
+	 */
+	mount_handle_t *mount_handle;
+
+	/* The mutex that serializes the seek and read
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The read mode
+	 */
+	int mode;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* Value to indicate the data read should be compared with the test image data
+	 */
+	int verify;
+
+	/* The number of reads
+	 */
+	int number_of_reads;
+
+	/* The random seed
+	 */
+	uint32_t seed;
+
+	/* The number of read errors
+	 */
+	int number_of_errors;
+
+	/* The number of reads that returned data other than the media data
+	 */
+	int number_of_mismatches;
+};
+
+/* Reads buffers of 128 KiB, the maximum size of a fuse read, at random offsets
+ * Returns 1
+ */
+int ewf_bench_mount_read_read_callback(
+     ewf_bench_mount_read_thread_values_t *thread_values )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *expected_data   = NULL;
+	uint8_t *data            = NULL;
+	off64_t offset           = 0;
+	ssize_t read_count       = 0;
+	uint32_t seed            = thread_values->seed;
+	int read_index           = 0;
+
+	data = (uint8_t *) memory_allocate(
+	                    EWF_BENCH_MOUNT_READ_READ_SIZE );
+
+	expected_data = (uint8_t *) memory_allocate(
+	                             EWF_BENCH_MOUNT_READ_VERIFY_SIZE );
+
+	if( ( data == NULL )
+	 || ( expected_data == NULL ) )
+	{
+		thread_values->number_of_errors += 1;
+
+		goto on_error;
+	}
+	for( read_index = 0;
+	     read_index < thread_values->number_of_reads;
+	     read_index++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		/* Use offsets that are a multiple of 4096 like the page cache of the kernel does
+		 */
+		offset = (off64_t) ( ( ( seed >> 8 ) % ( ( thread_values->media_size - EWF_BENCH_MOUNT_READ_READ_SIZE ) / 4096 ) ) * 4096 );
+
+		if( thread_values->mode == EWF_BENCH_MOUNT_READ_MODE_SEEK_AND_READ )
+		{
+			read_count = -1;
+
+			if( libcthreads_mutex_grab(
+			     thread_values->mutex,
+			     &error ) == 1 )
+			{
+				if( mount_handle_seek_offset(
+				     thread_values->mount_handle,
+				     offset,
+				     SEEK_SET,
+				     &error ) == offset )
+				{
+					read_count = mount_handle_read_buffer(
+					              thread_values->mount_handle,
+					              data,
+					              EWF_BENCH_MOUNT_READ_READ_SIZE,
+					              &error );
+				}
+				if( libcthreads_mutex_release(
+				     thread_values->mutex,
+				     &error ) != 1 )
+				{
+					read_count = -1;
+				}
+			}
+		}
+		else
+		{
+			read_count = mount_handle_read_buffer_at_offset(
+			              thread_values->mount_handle,
+			              data,
+			              EWF_BENCH_MOUNT_READ_READ_SIZE,
+			              offset,
+			              &error );
+		}
+		if( read_count != (ssize_t) EWF_BENCH_MOUNT_READ_READ_SIZE )
+		{
+			if( error != NULL )
+			{
+				libcerror_error_free(
+				 &error );
+			}
+			thread_values->number_of_errors += 1;
+
+			continue;
+		}
+		/* Only the first 4 KiB are verified since generating the expected data
+		 * is more expensive than reading it
+		 */
+		if( thread_values->verify != 0 )
+		{
+			ewf_test_image_fill_buffer(
+			 expected_data,
+			 EWF_BENCH_MOUNT_READ_VERIFY_SIZE,
+			 offset,
+			 EWF_TEST_IMAGE_DATA_TYPE_TEXT );
+
+			if( memory_compare(
+			     data,
+			     expected_data,
+			     EWF_BENCH_MOUNT_READ_VERIFY_SIZE ) != 0 )
+			{
+				thread_values->number_of_mismatches += 1;
+			}
+		}
+	}
+on_error:
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 1 );
+}
+
+/* Measures concurrent readers of a mount handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_mount_read_measure(
+     mount_handle_t *mount_handle,
+     size64_t media_size,
+     int verify,
+     int mode,
+     int number_of_threads,
+     int number_of_reads,
+     libcerror_error_t **error )
+{
+	ewf_bench_mount_read_thread_values_t thread_values[ EWF_BENCH_MOUNT_READ_MAXIMUM_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ EWF_BENCH_MOUNT_READ_MAXIMUM_NUMBER_OF_THREADS ];
+
+	libcthreads_mutex_t *mutex = NULL;
+	double seconds             = 0.0;
+	int number_of_errors       = 0;
+	int number_of_mismatches   = 0;
+	int thread_index           = 0;
+
+	if( libcthreads_mutex_initialize(
+	     &mutex,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		thread_values[ thread_index ].mount_handle         = mount_handle;
+		thread_values[ thread_index ].mutex                = mutex;
+		thread_values[ thread_index ].mode                 = mode;
+		thread_values[ thread_index ].media_size           = media_size;
+		thread_values[ thread_index ].verify               = verify;
+		thread_values[ thread_index ].number_of_reads      = number_of_reads / number_of_threads;
+		thread_values[ thread_index ].seed                 = (uint32_t) ( thread_index + 1 ) * 7919;
+		thread_values[ thread_index ].number_of_errors     = 0;
+		thread_values[ thread_index ].number_of_mismatches = 0;
+
+		threads[ thread_index ] = NULL;
+	}
+	seconds = ewf_bench_timer_get_seconds();
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( threads[ thread_index ] ),
+		     NULL,
+		     (int (*)(void *)) &ewf_bench_mount_read_read_callback,
+		     (void *) &( thread_values[ thread_index ] ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		number_of_errors     += thread_values[ thread_index ].number_of_errors;
+		number_of_mismatches += thread_values[ thread_index ].number_of_mismatches;
+	}
+	seconds = ewf_bench_timer_get_seconds() - seconds;
+
+	fprintf(
+	 stdout,
+	 "%s\t%d\t%8.3f s\t%8.1f MB/s\t%d\t%d\n",
+	 mode == EWF_BENCH_MOUNT_READ_MODE_SEEK_AND_READ ? "seek and read" : "read at offset",
+	 number_of_threads,
+	 seconds,
+	 ( (double) ( number_of_reads / number_of_threads ) * number_of_threads * EWF_BENCH_MOUNT_READ_READ_SIZE ) / ( seconds * 1000000.0 ),
+	 number_of_errors,
+	 number_of_mismatches );
+
+	if( libcthreads_mutex_free(
+	     &mutex,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ( number_of_errors != 0 )
+	 || ( number_of_mismatches != 0 ) )
+	{
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &mutex,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+	char basename[ 64 ];
+	char directory[ 32 ]         = "/tmp/ewf_bench_XXXXXX";
+	char *filenames[ 1 ]         = { NULL };
+
+	libcerror_error_t *error     = NULL;
+	libewf_error_t *ewf_error    = NULL;
+	mount_handle_t *mount_handle = NULL;
+	char **image_filenames       = NULL;
+	size64_t media_size          = 0;
+	int created_image            = 0;
+	int filename_index           = 0;
+	int mode                     = 0;
+	int number_of_filenames      = 0;
+	int number_of_reads          = 4000;
+	int number_of_threads        = 0;
+	int result                   = 0;
+
+	if( argc > 3 )
+	{
+		fprintf(
+		 stderr,
+		 "Usage: ewf_bench_mount_read [ image [ number_of_reads ] ]\n\n"
+		 "\timage: the first segment file of the image to read, by default\n"
+		 "\t       a 64 MiB image is created in /tmp and the data read is verified\n"
+		 "\tnumber_of_reads: the number of 128 KiB reads per run (default is 4000)\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( argc >= 2 )
+	{
+		filenames[ 0 ] = argv[ 1 ];
+	}
+	if( argc == 3 )
+	{
+		number_of_reads = atoi(
+		                   argv[ 2 ] );
+	}
+	if( number_of_reads < EWF_BENCH_MOUNT_READ_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		number_of_reads = EWF_BENCH_MOUNT_READ_MAXIMUM_NUMBER_OF_THREADS;
+	}
+	if( filenames[ 0 ] == NULL )
+	{
+		if( mkdtemp(
+		     directory ) == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create temporary directory.\n" );
+
+			return( EXIT_FAILURE );
+		}
+		snprintf(
+		 basename,
+		 64,
+		 "%s/bench",
+		 directory );
+
+		created_image = 1;
+
+		if( ewf_test_image_create(
+		     basename,
+		     EWF_BENCH_MOUNT_READ_MEDIA_SIZE,
+		     EWF_BENCH_MOUNT_READ_SEGMENT_SIZE,
+		     LIBEWF_COMPRESSION_FAST,
+		     EWF_TEST_IMAGE_DATA_TYPE_TEXT,
+		     &ewf_error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create test image.\n" );
+
+			goto on_error;
+		}
+		narrow_string_copy(
+		 &( basename[ narrow_string_length( basename ) ] ),
+		 ".E01",
+		 5 );
+
+		if( libewf_glob(
+		     basename,
+		     narrow_string_length(
+		      basename ),
+		     LIBEWF_FORMAT_UNKNOWN,
+		     &image_filenames,
+		     &number_of_filenames,
+		     &ewf_error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to glob test image.\n" );
+
+			goto on_error;
+		}
+		filenames[ 0 ] = basename;
+	}
+	if( mount_handle_initialize(
+	     &mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize mount handle.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_open_input(
+	     mount_handle,
+	     filenames,
+	     1,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %s.\n",
+		 filenames[ 0 ] );
+
+		goto on_error;
+	}
+	if( mount_handle_get_media_size(
+	     mount_handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve media size.\n" );
+
+		goto on_error;
+	}
+	if( media_size < ( 2 * EWF_BENCH_MOUNT_READ_READ_SIZE ) )
+	{
+		fprintf(
+		 stderr,
+		 "Media size of: %s is too small.\n",
+		 filenames[ 0 ] );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "%d random reads of %d bytes from: %s\n",
+	 number_of_reads,
+	 EWF_BENCH_MOUNT_READ_READ_SIZE,
+	 filenames[ 0 ] );
+
+	fprintf(
+	 stdout,
+	 "read\t\tthreads\ttime\t\tthroughput\terrors\tmismatches\n" );
+
+	for( mode = EWF_BENCH_MOUNT_READ_MODE_SEEK_AND_READ;
+	     mode <= EWF_BENCH_MOUNT_READ_MODE_READ_AT_OFFSET;
+	     mode++ )
+	{
+		for( number_of_threads = 1;
+		     number_of_threads <= EWF_BENCH_MOUNT_READ_MAXIMUM_NUMBER_OF_THREADS;
+		     number_of_threads *= 2 )
+		{
+			if( ewf_bench_mount_read_measure(
+			     mount_handle,
+			     media_size,
+			     created_image,
+			     mode,
+			     number_of_threads,
+			     number_of_reads,
+			     &error ) != 1 )
+			{
+				result = -1;
+			}
+			if( error != NULL )
+			{
+				libcerror_error_backtrace_fprint(
+				 error,
+				 stderr );
+				libcerror_error_free(
+				 &error );
+			}
+		}
+	}
+	if( mount_handle_close(
+	     mount_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close mount handle.\n" );
+
+		goto on_error;
+	}
+	if( mount_handle_free(
+	     &mount_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free mount handle.\n" );
+
+		goto on_error;
+	}
+	if( image_filenames != NULL )
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			unlink(
+			 image_filenames[ filename_index ] );
+		}
+		libewf_glob_free(
+		 image_filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	if( created_image != 0 )
+	{
+		rmdir(
+		 directory );
+	}
+	if( result != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( mount_handle != NULL )
+	{
+		mount_handle_free(
+		 &mount_handle,
+		 NULL );
+	}
+	if( ewf_error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 ewf_error,
+		 stderr );
+		libewf_error_free(
+		 &ewf_error );
+	}
+	if( image_filenames != NULL )
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			unlink(
+			 image_filenames[ filename_index ] );
+		}
+		libewf_glob_free(
+		 image_filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	if( created_image != 0 )
+	{
+		rmdir(
+		 directory );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,317 @@
+/*
+ * Benchmarks the contended libcthreads queue ring, lock-free and with the mutex
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libcthreads_definitions.h>
+#include <libcthreads_ring.h>
+#include <libcthreads_thread.h>
+
+#include <libcerror_error.h>
+
+#include "ewf_bench_timer.h"
+
+#define EWF_BENCH_QUEUE_MAXIMUM_NUMBER_OF_THREADS	64
+
+typedef struct ewf_bench_queue_thread_values ewf_bench_queue_thread_values_t;
+
+struct ewf_bench_queue_thread_values
+{
+	/* The ring
+	 */
+	libcthreads_ring_t *ring;
+
+	/* The number of values to push or pop
+	 */
+	int number_of_values;
+
+	/* The sum of the values that were popped
+	 */
+	uint64_t sum;
+
+	/* Value to indicate an error occurred
+	 */
+	int has_error;
+};
+
+/* Pushes values onto the ring
+ * Returns 1
+ */
+int ewf_bench_queue_push_callback(
+     ewf_bench_queue_thread_values_t *thread_values )
+{
+	intptr_t value   = 0;
+	int value_index  = 0;
+
+	for( value_index = 0;
+	     value_index < thread_values->number_of_values;
+	     value_index++ )
+	{
+		/* Push the index + 1 since a value of NULL cannot be distinguished
+		 */
+		value = (intptr_t) value_index + 1;
+
+		if( libcthreads_ring_push(
+		     thread_values->ring,
+		     (intptr_t *) value,
+		     NULL ) != 1 )
+		{
+			thread_values->has_error = 1;
+
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Pops values off the ring
+ * Returns 1
+ */
+int ewf_bench_queue_pop_callback(
+     ewf_bench_queue_thread_values_t *thread_values )
+{
+	intptr_t *value  = NULL;
+	int value_index  = 0;
+
+	for( value_index = 0;
+	     value_index < thread_values->number_of_values;
+	     value_index++ )
+	{
+		if( libcthreads_ring_pop(
+		     thread_values->ring,
+		     &value,
+		     NULL ) != 1 )
+		{
+			thread_values->has_error = 1;
+
+			break;
+		}
+		thread_values->sum += (uint64_t) (intptr_t) value;
+	}
+	return( 1 );
+}
+
+/* Measures passing values from producer to consumer threads through a ring
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_queue_measure(
+     int maximum_number_of_values,
+     int number_of_threads,
+     int number_of_values,
+     int use_mutex,
+     libcerror_error_t **error )
+{
+	ewf_bench_queue_thread_values_t thread_values[ EWF_BENCH_QUEUE_MAXIMUM_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ EWF_BENCH_QUEUE_MAXIMUM_NUMBER_OF_THREADS ];
+
+	libcthreads_ring_t *ring      = NULL;
+	double seconds                = 0.0;
+	uint64_t expected_sum         = 0;
+	uint64_t sum                  = 0;
+	int has_error                 = 0;
+	int number_of_producers       = 0;
+	int thread_index              = 0;
+	int values_per_thread         = 0;
+
+	number_of_producers = number_of_threads / 2;
+	values_per_thread   = number_of_values / number_of_producers;
+
+	if( libcthreads_ring_initialize(
+	     &ring,
+	     maximum_number_of_values,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcthreads_ring_set_use_mutex(
+	     ring,
+	     use_mutex,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		thread_values[ thread_index ].ring             = ring;
+		thread_values[ thread_index ].number_of_values = values_per_thread;
+		thread_values[ thread_index ].sum              = 0;
+		thread_values[ thread_index ].has_error        = 0;
+
+		threads[ thread_index ] = NULL;
+	}
+	seconds = ewf_bench_timer_get_seconds();
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( threads[ thread_index ] ),
+		     NULL,
+		     thread_index < number_of_producers ? (int (*)(void *)) &ewf_bench_queue_push_callback : (int (*)(void *)) &ewf_bench_queue_pop_callback,
+		     (void *) &( thread_values[ thread_index ] ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		sum       += thread_values[ thread_index ].sum;
+		has_error |= thread_values[ thread_index ].has_error;
+	}
+	seconds = ewf_bench_timer_get_seconds() - seconds;
+
+	expected_sum = ( (uint64_t) values_per_thread * ( values_per_thread + 1 ) / 2 ) * number_of_producers;
+
+	fprintf(
+	 stdout,
+	 "%s\t%d\t%d\t%8.3f s\t%8.2f M values/s\t%s\n",
+	 ( use_mutex != 0 ) ? "mutex" : "lock-free",
+	 maximum_number_of_values,
+	 number_of_threads,
+	 seconds,
+	 ( (double) values_per_thread * number_of_producers ) / ( seconds * 1000000.0 ),
+	 ( ( has_error == 0 ) && ( sum == expected_sum ) ) ? "ok" : "FAILED" );
+
+	if( libcthreads_ring_free(
+	     &ring,
+	     NULL,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ( has_error != 0 )
+	 || ( sum != expected_sum ) )
+	{
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( ring != NULL )
+	{
+		libcthreads_ring_free(
+		 &ring,
+		 NULL,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+	int capacities[ 3 ]        = { 1, 7, 64 };
+	int numbers_of_threads[ 3 ] = { 2, 4, 8 };
+
+	libcerror_error_t *error   = NULL;
+	int capacity_index         = 0;
+	int number_of_values       = 1000000;
+	int result                 = 0;
+	int threads_index          = 0;
+	int use_mutex              = 0;
+
+	if( argc > 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Usage: ewf_bench_queue [ number_of_values ]\n\n"
+		 "\tnumber_of_values: the number of values passed through the ring per run (default is 1000000)\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( argc == 2 )
+	{
+		number_of_values = atoi(
+		                    argv[ 1 ] );
+	}
+	if( number_of_values < EWF_BENCH_QUEUE_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		number_of_values = EWF_BENCH_QUEUE_MAXIMUM_NUMBER_OF_THREADS;
+	}
+	fprintf(
+	 stdout,
+	 "%d values per run, half of the threads push and the other half pops\n",
+	 number_of_values );
+
+	fprintf(
+	 stdout,
+	 "mode\t\tcapacity\tthreads\ttime\t\tthroughput\n" );
+
+	for( capacity_index = 0;
+	     capacity_index < 3;
+	     capacity_index++ )
+	{
+		for( threads_index = 0;
+		     threads_index < 3;
+		     threads_index++ )
+		{
+			for( use_mutex = 0;
+			     use_mutex <= 1;
+			     use_mutex++ )
+			{
+				if( ewf_bench_queue_measure(
+				     capacities[ capacity_index ],
+				     numbers_of_threads[ threads_index ],
+				     number_of_values,
+				     use_mutex,
+				     &error ) != 1 )
+				{
+					result = -1;
+				}
+				if( error != NULL )
+				{
+					libcerror_error_backtrace_fprint(
+					 error,
+					 stderr );
+					libcerror_error_free(
+					 &error );
+				}
+			}
+		}
+	}
+	if( result != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+}
+
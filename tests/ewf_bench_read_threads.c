@@ -0,0 +1,567 @@
+/*
+ * Benchmarks concurrent random reads from a handle
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <libewf.h>
+
+#include <libbfio_definitions.h>
+#include <libbfio_file_range.h>
+#include <libbfio_pool.h>
+
+#include <libcthreads_thread.h>
+
+#include "ewf_bench_timer.h"
+#include "ewf_test_image.h"
+
+#include "../libewf/libewf_handle.h"
+
+#define EWF_BENCH_READ_THREADS_MEDIA_SIZE		( 24 * 1024 * 1024 )
+#define EWF_BENCH_READ_THREADS_SEGMENT_SIZE		( 1024 * 1024 )
+#define EWF_BENCH_READ_THREADS_READ_SIZE		4096
+#define EWF_BENCH_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS	32
+
+typedef struct ewf_bench_read_threads_thread_values ewf_bench_read_threads_thread_values_t;
+
+struct ewf_bench_read_threads_thread_values
+{
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The number of reads
+	 */
+	int number_of_reads;
+
+	/* The random seed
+	 */
+	uint32_t seed;
+
+	/* The number of read errors
+	 */
+	int number_of_errors;
+
+	/* The number of reads that returned data other than the media data
+	 */
+	int number_of_mismatches;
+};
+
+/* Reads buffers of 4 KiB at random offsets and compares them with the media data
+ * Returns 1
+ */
+int ewf_bench_read_threads_read_callback(
+     ewf_bench_read_threads_thread_values_t *thread_values )
+{
+	uint8_t expected_data[ EWF_BENCH_READ_THREADS_READ_SIZE ];
+	uint8_t data[ EWF_BENCH_READ_THREADS_READ_SIZE ];
+
+	libewf_error_t *error = NULL;
+	off64_t offset        = 0;
+	ssize_t read_count    = 0;
+	uint32_t seed         = thread_values->seed;
+	int read_index        = 0;
+
+	for( read_index = 0;
+	     read_index < thread_values->number_of_reads;
+	     read_index++ )
+	{
+		seed = ( seed * 1103515245UL ) + 12345;
+
+		offset = (off64_t) ( ( seed >> 8 ) % ( EWF_BENCH_READ_THREADS_MEDIA_SIZE - EWF_BENCH_READ_THREADS_READ_SIZE ) );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              thread_values->handle,
+		              data,
+		              EWF_BENCH_READ_THREADS_READ_SIZE,
+		              offset,
+		              &error );
+
+		if( read_count != (ssize_t) EWF_BENCH_READ_THREADS_READ_SIZE )
+		{
+			if( error != NULL )
+			{
+				libewf_error_free(
+				 &error );
+			}
+			thread_values->number_of_errors += 1;
+
+			continue;
+		}
+		ewf_test_image_fill_buffer(
+		 expected_data,
+		 EWF_BENCH_READ_THREADS_READ_SIZE,
+		 offset,
+		 EWF_TEST_IMAGE_DATA_TYPE_TEXT );
+
+		if( memory_compare(
+		     data,
+		     expected_data,
+		     EWF_BENCH_READ_THREADS_READ_SIZE ) != 0 )
+		{
+			thread_values->number_of_mismatches += 1;
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the test image with file range handles in a file IO pool
+ * File range handles do not read at an offset without seeking
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_threads_open_file_range_pool(
+     libewf_handle_t *handle,
+     char * const filenames[],
+     int number_of_filenames,
+     libbfio_pool_t **file_io_pool,
+     libewf_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	int entry                        = 0;
+	int filename_index               = 0;
+
+	if( libbfio_pool_initialize(
+	     file_io_pool,
+	     0,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		if( libbfio_file_range_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libbfio_file_range_set_name(
+		     file_io_handle,
+		     filenames[ filename_index ],
+		     narrow_string_length( filenames[ filename_index ] ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libbfio_file_range_set(
+		     file_io_handle,
+		     0,
+		     0,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libbfio_pool_append_handle(
+		     *file_io_pool,
+		     &entry,
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		file_io_handle = NULL;
+	}
+	if( libewf_handle_open_file_io_pool(
+	     handle,
+	     *file_io_pool,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( *file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Measures concurrent random reads with a specific number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_bench_read_threads_measure(
+     char * const filenames[],
+     int number_of_filenames,
+     int use_file_range,
+     int number_of_threads,
+     int number_of_reads,
+     libewf_error_t **error )
+{
+	ewf_bench_read_threads_thread_values_t thread_values[ EWF_BENCH_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ EWF_BENCH_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS ];
+
+	libbfio_pool_t *file_io_pool = NULL;
+	libewf_handle_t *handle      = NULL;
+	double seconds               = 0.0;
+	int number_of_errors         = 0;
+	int number_of_mismatches     = 0;
+	int thread_index             = 0;
+	int result                   = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( use_file_range != 0 )
+	{
+		result = ewf_bench_read_threads_open_file_range_pool(
+		          handle,
+		          filenames,
+		          number_of_filenames,
+		          &file_io_pool,
+		          error );
+	}
+	else
+	{
+		result = libewf_handle_open(
+		          handle,
+		          filenames,
+		          number_of_filenames,
+		          LIBEWF_OPEN_READ,
+		          error );
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		thread_values[ thread_index ].handle               = handle;
+		thread_values[ thread_index ].number_of_reads      = number_of_reads / number_of_threads;
+		thread_values[ thread_index ].seed                 = (uint32_t) ( thread_index + 1 ) * 7919;
+		thread_values[ thread_index ].number_of_errors     = 0;
+		thread_values[ thread_index ].number_of_mismatches = 0;
+
+		threads[ thread_index ] = NULL;
+	}
+	seconds = ewf_bench_timer_get_seconds();
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( threads[ thread_index ] ),
+		     NULL,
+		     (int (*)(void *)) &ewf_bench_read_threads_read_callback,
+		     (void *) &( thread_values[ thread_index ] ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		number_of_errors     += thread_values[ thread_index ].number_of_errors;
+		number_of_mismatches += thread_values[ thread_index ].number_of_mismatches;
+	}
+	seconds = ewf_bench_timer_get_seconds() - seconds;
+
+	fprintf(
+	 stdout,
+	 "%d\t%8.3f s\t%8.1f MB/s\t%d\t%d\n",
+	 number_of_threads,
+	 seconds,
+	 ( (double) ( number_of_reads / number_of_threads ) * number_of_threads * EWF_BENCH_READ_THREADS_READ_SIZE ) / ( seconds * 1000000.0 ),
+	 number_of_errors,
+	 number_of_mismatches );
+
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( file_io_pool != NULL )
+	{
+		if( libbfio_pool_free(
+		     &file_io_pool,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( ( number_of_errors != 0 )
+	 || ( number_of_mismatches != 0 ) )
+	{
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+int main(
+     int argc,
+     char * const argv[] )
+{
+	char basename[ 64 ];
+	char directory[ 32 ] = "/tmp/ewf_bench_XXXXXX";
+
+	libewf_error_t *error    = NULL;
+	char **filenames         = NULL;
+	int argument_index       = 0;
+	int filename_index       = 0;
+	int number_of_filenames  = 0;
+	int number_of_reads      = 80000;
+	int number_of_threads    = 0;
+	int result               = 0;
+	int use_file_range       = 0;
+
+	for( argument_index = 1;
+	     argument_index < argc;
+	     argument_index++ )
+	{
+		if( narrow_string_compare(
+		     argv[ argument_index ],
+		     "-r",
+		     3 ) == 0 )
+		{
+			use_file_range = 1;
+		}
+		else if( ( narrow_string_compare(
+		            argv[ argument_index ],
+		            "-n",
+		            3 ) == 0 )
+		      && ( ( argument_index + 1 ) < argc ) )
+		{
+			argument_index++;
+
+			number_of_reads = atoi(
+			                   argv[ argument_index ] );
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Usage: ewf_bench_read_threads [ -r ] [ -n number_of_reads ]\n\n"
+			 "\t-r: open the segment files with file range handles\n"
+			 "\t-n: the number of 4 KiB reads per run (default is 80000)\n" );
+
+			return( EXIT_FAILURE );
+		}
+	}
+	if( number_of_reads < EWF_BENCH_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		number_of_reads = EWF_BENCH_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS;
+	}
+	if( mkdtemp(
+	     directory ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create temporary directory.\n" );
+
+		return( EXIT_FAILURE );
+	}
+	snprintf(
+	 basename,
+	 64,
+	 "%s/bench",
+	 directory );
+
+	if( ewf_test_image_create(
+	     basename,
+	     EWF_BENCH_READ_THREADS_MEDIA_SIZE,
+	     EWF_BENCH_READ_THREADS_SEGMENT_SIZE,
+	     LIBEWF_COMPRESSION_FAST,
+	     EWF_TEST_IMAGE_DATA_TYPE_TEXT,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create test image.\n" );
+
+		goto on_error;
+	}
+	narrow_string_copy(
+	 &( basename[ narrow_string_length( basename ) ] ),
+	 ".E01",
+	 5 );
+
+	if( libewf_glob(
+	     basename,
+	     narrow_string_length( basename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob test image segment files.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "%d random reads of %d bytes from %d segment files using %s handles\n",
+	 number_of_reads,
+	 EWF_BENCH_READ_THREADS_READ_SIZE,
+	 number_of_filenames,
+	 use_file_range != 0 ? "file range" : "file" );
+
+	fprintf(
+	 stdout,
+	 "threads\ttime\t\tthroughput\terrors\tmismatches\n" );
+
+	for( number_of_threads = 1;
+	     number_of_threads <= EWF_BENCH_READ_THREADS_MAXIMUM_NUMBER_OF_THREADS;
+	     number_of_threads *= 2 )
+	{
+		if( ewf_bench_read_threads_measure(
+		     filenames,
+		     number_of_filenames,
+		     use_file_range,
+		     number_of_threads,
+		     number_of_reads,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+		if( error != NULL )
+		{
+			libewf_error_backtrace_fprint(
+			 error,
+			 stderr );
+			libewf_error_free(
+			 &error );
+		}
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		unlink(
+		 filenames[ filename_index ] );
+	}
+	rmdir(
+	 directory );
+
+	libewf_glob_free(
+	 filenames,
+	 number_of_filenames,
+	 NULL );
+
+	if( result != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( filenames != NULL )
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			unlink(
+			 filenames[ filename_index ] );
+		}
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	rmdir(
+	 directory );
+
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,453 @@
+/*
+ * Tests the arena the single file entries are allocated from
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libcerror_error.h>
+
+#include "../libewf/libewf_arena.h"
+
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_ARENA_BLOCK_SIZE		256
+#define EWF_TEST_ARENA_NUMBER_OF_VALUES		100
+
+/* Tests the libewf_arena_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_arena_initialize(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libewf_arena_t *arena    = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_arena_initialize(
+	          &arena,
+	          EWF_TEST_ARENA_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "arena",
+	 arena );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* An arena from which nothing was allocated has no blocks
+	 */
+	EWF_TEST_ASSERT_IS_NULL(
+	 "arena->current_block",
+	 arena->current_block );
+
+	result = libewf_arena_free(
+	          &arena,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "arena",
+	 arena );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_arena_initialize(
+	          NULL,
+	          EWF_TEST_ARENA_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* A block size that is not a multiple of the alignment is rejected
+	 */
+	result = libewf_arena_initialize(
+	          &arena,
+	          EWF_TEST_ARENA_BLOCK_SIZE + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "arena",
+	 arena );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_initialize(
+	          &arena,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( arena != NULL )
+	{
+		libewf_arena_free(
+		 &arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_arena_allocate function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_arena_allocate(
+     void )
+{
+	uint8_t *values[ EWF_TEST_ARENA_NUMBER_OF_VALUES ];
+
+	libcerror_error_t *error    = NULL;
+	libewf_arena_block_t *block = NULL;
+	libewf_arena_t *arena       = NULL;
+	uint8_t *data               = NULL;
+	size_t value_size           = 0;
+	size_t value_offset         = 0;
+	int number_of_blocks        = 0;
+	int result                  = 0;
+	int value_index             = 0;
+
+	result = libewf_arena_initialize(
+	          &arena,
+	          EWF_TEST_ARENA_BLOCK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Allocate values of varying sizes, that do not fit in a single block,
+	 * and fill each value with its index
+	 */
+	for( value_index = 0;
+	     value_index < EWF_TEST_ARENA_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		values[ value_index ] = NULL;
+
+		value_size = (size_t) ( value_index % 13 ) + 1;
+
+		result = libewf_arena_allocate(
+		          arena,
+		          value_size,
+		          &( values[ value_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "values[ value_index ]",
+		 values[ value_index ] );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "alignment",
+		 (int) ( (intptr_t) values[ value_index ] % 8 ),
+		 0 );
+
+		memory_set(
+		 values[ value_index ],
+		 value_index,
+		 value_size );
+	}
+	/* Check that no value was overwritten by a later allocation
+	 */
+	for( value_index = 0;
+	     value_index < EWF_TEST_ARENA_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		value_size = (size_t) ( value_index % 13 ) + 1;
+
+		for( value_offset = 0;
+		     value_offset < value_size;
+		     value_offset++ )
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "values[ value_index ][ value_offset ]",
+			 (int) values[ value_index ][ value_offset ],
+			 value_index );
+		}
+	}
+	/* A value larger than a quarter of the block size gets a block of its own
+	 * behind the current block, from which allocation continues
+	 */
+	result = libewf_arena_allocate(
+	          arena,
+	          8,
+	          &( values[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          EWF_TEST_ARENA_BLOCK_SIZE * 2,
+	          &data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 data,
+	 0xff,
+	 EWF_TEST_ARENA_BLOCK_SIZE * 2 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "arena->current_block->previous_block",
+	 arena->current_block->previous_block );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "arena->current_block->previous_block->data == data",
+	 (int) ( arena->current_block->previous_block->data == data ),
+	 1 );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          8,
+	          &( values[ 1 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "values[ 1 ] follows values[ 0 ]",
+	 (int) ( values[ 1 ] == &( values[ 0 ][ 8 ] ) ),
+	 1 );
+
+	/* The values, rounded up to 8 or 16 bytes, use 1104 bytes which need
+	 * 5 blocks of 256 bytes, the large value has a 6th block of its own
+	 */
+	for( block = arena->current_block;
+	     block != NULL;
+	     block = block->previous_block )
+	{
+		number_of_blocks++;
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_blocks",
+	 number_of_blocks,
+	 6 );
+
+	/* Test error cases
+	 */
+	result = libewf_arena_allocate(
+	          NULL,
+	          8,
+	          &data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          0,
+	          &data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_arena_allocate(
+	          arena,
+	          8,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_arena_free(
+	          &arena,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( arena != NULL )
+	{
+		libewf_arena_free(
+		 &arena,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_arena_initialize",
+	 ewf_test_arena_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_arena_allocate",
+	 ewf_test_arena_allocate );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
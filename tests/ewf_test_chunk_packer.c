@@ -0,0 +1,464 @@
+/*
+ * Chunk packer testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#include <libewf.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+/* The media size is a multiple of the sector size but not of the chunk size
+ * so that the last chunk is partial
+ */
+#define EWF_TEST_CHUNK_PACKER_MEDIA_SIZE	( ( 4 * 1024 * 1024 ) + ( 3 * 512 ) )
+#define EWF_TEST_CHUNK_PACKER_SEGMENT_SIZE	( 1024 * 1024 )
+
+/* A segment file that contains all the chunks, so that the write buffer is flushed
+ * in buffers that are large enough to be split into concurrent writes
+ */
+#define EWF_TEST_CHUNK_PACKER_LARGE_SEGMENT_SIZE	( 8 * 1024 * 1024 )
+
+/* The write size is not a multiple of the chunk size so that chunks are filled by multiple writes
+ */
+#define EWF_TEST_CHUNK_PACKER_WRITE_SIZE	10000
+
+/* Writes a test image with a specific number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_packer_write_image(
+     char *basename,
+     int number_of_threads,
+     int data_type,
+     size64_t segment_file_size,
+     libewf_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_set_number_of_threads(
+	     handle,
+	     number_of_threads,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_image_open_write(
+	     handle,
+	     basename,
+	     EWF_TEST_CHUNK_PACKER_MEDIA_SIZE,
+	     segment_file_size,
+	     LIBEWF_COMPRESSION_FAST,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	/* The dates are set so that the compressed header sections
+	 * do not depend on the time the image is written
+	 */
+	if( libewf_handle_set_utf8_header_value(
+	     handle,
+	     (uint8_t *) "acquiry_date",
+	     12,
+	     (uint8_t *) "2017 11 4 12 0 0",
+	     16,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_set_utf8_header_value(
+	     handle,
+	     (uint8_t *) "system_date",
+	     11,
+	     (uint8_t *) "2017 11 4 12 0 0",
+	     16,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_image_write(
+	     handle,
+	     EWF_TEST_CHUNK_PACKER_MEDIA_SIZE,
+	     EWF_TEST_CHUNK_PACKER_WRITE_SIZE,
+	     data_type,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests if chunks packed on a thread pool are written in order and
+ * produce the same segment files as chunks packed by the calling thread
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_packer_write_order(
+     int data_type,
+     size64_t segment_file_size )
+{
+	char basename[ 64 ];
+	char directory[ 32 ] = "/tmp/ewf_test_XXXXXX";
+	char threaded_basename[ 64 ];
+	struct stat file_statistics;
+	struct stat threaded_file_statistics;
+
+	libewf_error_t *error            = NULL;
+	libewf_handle_t *handle          = NULL;
+	char **filenames                 = NULL;
+	char **threaded_filenames        = NULL;
+	int filename_index               = 0;
+	int number_of_filenames          = 0;
+	int number_of_threaded_filenames = 0;
+	int result                       = 0;
+
+	basename[ 0 ]          = 0;
+	threaded_basename[ 0 ] = 0;
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory",
+	 mkdtemp( directory ) );
+
+	snprintf(
+	 basename,
+	 64,
+	 "%s/single",
+	 directory );
+
+	snprintf(
+	 threaded_basename,
+	 64,
+	 "%s/threaded",
+	 directory );
+
+	result = ewf_test_chunk_packer_write_image(
+	          basename,
+	          0,
+	          data_type,
+	          segment_file_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_chunk_packer_write_image(
+	          threaded_basename,
+	          4,
+	          data_type,
+	          segment_file_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	narrow_string_copy(
+	 &( basename[ narrow_string_length( basename ) ] ),
+	 ".E01",
+	 5 );
+
+	narrow_string_copy(
+	 &( threaded_basename[ narrow_string_length( threaded_basename ) ] ),
+	 ".E01",
+	 5 );
+
+	result = libewf_glob(
+	          basename,
+	          narrow_string_length( basename ),
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_glob(
+	          threaded_basename,
+	          narrow_string_length( threaded_basename ),
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &threaded_filenames,
+	          &number_of_threaded_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threaded_filenames",
+	 number_of_threaded_filenames,
+	 number_of_filenames );
+
+	/* The segment files have the same dates and therefore the same sizes
+	 */
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		result = stat(
+		          filenames[ filename_index ],
+		          &file_statistics );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = stat(
+		          threaded_filenames[ filename_index ],
+		          &threaded_file_statistics );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "size",
+		 (int64_t) threaded_file_statistics.st_size,
+		 (int64_t) file_statistics.st_size );
+	}
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_open(
+	          handle,
+	          threaded_filenames,
+	          number_of_threaded_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_compare(
+	          handle,
+	          EWF_TEST_CHUNK_PACKER_MEDIA_SIZE,
+	          EWF_TEST_IMAGE_CHUNK_SIZE,
+	          data_type,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libewf_glob_free(
+	 threaded_filenames,
+	 number_of_threaded_filenames,
+	 NULL );
+
+	libewf_glob_free(
+	 filenames,
+	 number_of_filenames,
+	 NULL );
+
+	ewf_test_image_remove(
+	 threaded_basename );
+
+	ewf_test_image_remove(
+	 basename );
+
+	rmdir(
+	 directory );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( threaded_filenames != NULL )
+	{
+		libewf_glob_free(
+		 threaded_filenames,
+		 number_of_threaded_filenames,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	if( threaded_basename[ 0 ] != 0 )
+	{
+		ewf_test_image_remove(
+		 threaded_basename );
+	}
+	if( basename[ 0 ] != 0 )
+	{
+		ewf_test_image_remove(
+		 basename );
+	}
+	rmdir(
+	 directory );
+
+	return( 0 );
+}
+
+/* Tests the write order with compressible chunks
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_packer_write_order_compressed(
+     void )
+{
+	return( ewf_test_chunk_packer_write_order(
+	         EWF_TEST_IMAGE_DATA_TYPE_TEXT,
+	         EWF_TEST_CHUNK_PACKER_SEGMENT_SIZE ) );
+}
+
+/* Tests the write order with chunks that are stored uncompressed
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_packer_write_order_uncompressed(
+     void )
+{
+	return( ewf_test_chunk_packer_write_order(
+	         EWF_TEST_IMAGE_DATA_TYPE_RANDOM,
+	         EWF_TEST_CHUNK_PACKER_SEGMENT_SIZE ) );
+}
+
+/* Tests the write order with chunks that are stored uncompressed in a single segment file
+ * The write buffer flushes are then split into concurrent writes
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_packer_write_order_single_segment(
+     void )
+{
+	return( ewf_test_chunk_packer_write_order(
+	         EWF_TEST_IMAGE_DATA_TYPE_RANDOM,
+	         EWF_TEST_CHUNK_PACKER_LARGE_SEGMENT_SIZE ) );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_handle_write_buffer with threads and compressed chunks",
+	 ewf_test_chunk_packer_write_order_compressed );
+
+	EWF_TEST_RUN(
+	 "libewf_handle_write_buffer with threads and uncompressed chunks",
+	 ewf_test_chunk_packer_write_order_uncompressed );
+
+	EWF_TEST_RUN(
+	 "libewf_handle_write_buffer with threads and a single segment file",
+	 ewf_test_chunk_packer_write_order_single_segment );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,454 @@
+/*
+ * Chunk view testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <libewf.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+
+/* The last chunk of the image is smaller than the chunk size
+ */
+#define EWF_TEST_CHUNK_VIEW_MEDIA_SIZE		( ( 2 * 1024 * 1024 ) + ( 3 * 512 ) )
+#define EWF_TEST_CHUNK_VIEW_SEGMENT_SIZE	( 8 * 1024 * 1024 )
+#define EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS	( ( EWF_TEST_CHUNK_VIEW_MEDIA_SIZE + EWF_TEST_IMAGE_CHUNK_SIZE - 1 ) / EWF_TEST_IMAGE_CHUNK_SIZE )
+
+/* Tests retrieving a view of every chunk of an image and comparing it with the data of the test image
+ * All views are held until the end so that their chunks are evicted from a small chunk cache
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_view_round_trip(
+     size64_t chunk_cache_size )
+{
+	const uint8_t *data_array[ EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS ];
+	size_t data_size_array[ EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS ];
+	libewf_chunk_view_t *chunk_views_array[ EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS ];
+	uint8_t buffer[ EWF_TEST_IMAGE_CHUNK_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_IMAGE_CHUNK_SIZE ];
+	char basename[ 64 ];
+	char directory[ 32 ] = "/tmp/ewf_test_XXXXXX";
+
+	libewf_chunk_view_t *chunk_view = NULL;
+	libewf_error_t *error           = NULL;
+	libewf_handle_t *handle         = NULL;
+	char **filenames                = NULL;
+	const uint8_t *data             = NULL;
+	size_t chunk_offset             = 0;
+	size_t data_size                = 0;
+	size_t expected_data_size       = 0;
+	ssize_t read_count              = 0;
+	off64_t chunk_start_offset      = 0;
+	off64_t offset                  = 0;
+	int chunk_index                 = 0;
+	int number_of_filenames         = 0;
+	int result                      = 0;
+
+	basename[ 0 ] = 0;
+
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		chunk_views_array[ chunk_index ] = NULL;
+	}
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory",
+	 mkdtemp( directory ) );
+
+	snprintf(
+	 basename,
+	 64,
+	 "%s/image",
+	 directory );
+
+	result = ewf_test_image_create(
+	          basename,
+	          EWF_TEST_CHUNK_VIEW_MEDIA_SIZE,
+	          EWF_TEST_CHUNK_VIEW_SEGMENT_SIZE,
+	          LIBEWF_COMPRESSION_FAST,
+	          EWF_TEST_IMAGE_DATA_TYPE_TEXT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	narrow_string_copy(
+	 &( basename[ narrow_string_length( basename ) ] ),
+	 ".E01",
+	 5 );
+
+	result = libewf_glob(
+	          basename,
+	          narrow_string_length( basename ),
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	if( chunk_cache_size != 0 )
+	{
+		result = libewf_handle_set_chunk_cache_size(
+		          handle,
+		          chunk_cache_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	result = libewf_handle_open(
+	          handle,
+	          filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		/* Vary the offset of the view in the chunk
+		 */
+		chunk_start_offset = (off64_t) chunk_index * EWF_TEST_IMAGE_CHUNK_SIZE;
+		chunk_offset       = (size_t) ( chunk_index % 3 ) * 512;
+
+		result = libewf_handle_get_chunk_view(
+		          handle,
+		          chunk_start_offset + chunk_offset,
+		          &( data_array[ chunk_index ] ),
+		          &( data_size_array[ chunk_index ] ),
+		          &( chunk_views_array[ chunk_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_view",
+		 chunk_views_array[ chunk_index ] );
+
+		expected_data_size = EWF_TEST_IMAGE_CHUNK_SIZE;
+
+		if( (size64_t) ( chunk_start_offset + expected_data_size ) > EWF_TEST_CHUNK_VIEW_MEDIA_SIZE )
+		{
+			expected_data_size = (size_t) ( EWF_TEST_CHUNK_VIEW_MEDIA_SIZE - chunk_start_offset );
+		}
+		expected_data_size -= chunk_offset;
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "data_size",
+		 data_size_array[ chunk_index ],
+		 expected_data_size );
+
+		/* Reading the chunk with a copy returns the same data as the view
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              expected_data_size,
+		              chunk_start_offset + chunk_offset,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) expected_data_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 memory_compare(
+		  data_array[ chunk_index ],
+		  buffer,
+		  expected_data_size ),
+		 0 );
+	}
+	/* The views remain valid after their chunks were evicted from the chunk cache
+	 */
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		chunk_start_offset = (off64_t) chunk_index * EWF_TEST_IMAGE_CHUNK_SIZE;
+		chunk_offset       = (size_t) ( chunk_index % 3 ) * 512;
+
+		ewf_test_image_fill_buffer(
+		 expected_buffer,
+		 data_size_array[ chunk_index ],
+		 chunk_start_offset + chunk_offset,
+		 EWF_TEST_IMAGE_DATA_TYPE_TEXT );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 memory_compare(
+		  data_array[ chunk_index ],
+		  expected_buffer,
+		  data_size_array[ chunk_index ] ),
+		 0 );
+
+		result = libewf_handle_release_chunk_view(
+		          handle,
+		          &( chunk_views_array[ chunk_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "chunk_view",
+		 chunk_views_array[ chunk_index ] );
+	}
+	/* A view of the same chunk can be retrieved again after its release
+	 */
+	offset = (off64_t) ( EWF_TEST_CHUNK_VIEW_MEDIA_SIZE - 512 );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          offset,
+	          &data,
+	          &data_size,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 512 );
+
+	ewf_test_image_fill_buffer(
+	 expected_buffer,
+	 512,
+	 offset,
+	 EWF_TEST_IMAGE_DATA_TYPE_TEXT );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 memory_compare(
+	  data,
+	  expected_buffer,
+	  512 ),
+	 0 );
+
+	result = libewf_handle_release_chunk_view(
+	          handle,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* There is no view at the end of the media data
+	 */
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          (off64_t) EWF_TEST_CHUNK_VIEW_MEDIA_SIZE,
+	          &data,
+	          &data_size,
+	          &chunk_view,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_view",
+	 chunk_view );
+
+	/* The sequential read path still returns all data
+	 */
+	result = ewf_test_image_compare(
+	          handle,
+	          EWF_TEST_CHUNK_VIEW_MEDIA_SIZE,
+	          EWF_TEST_IMAGE_CHUNK_SIZE,
+	          EWF_TEST_IMAGE_DATA_TYPE_TEXT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libewf_glob_free(
+	 filenames,
+	 number_of_filenames,
+	 NULL );
+
+	ewf_test_image_remove(
+	 basename );
+
+	rmdir(
+	 directory );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		if( chunk_views_array[ chunk_index ] != NULL )
+		{
+			libewf_handle_release_chunk_view(
+			 handle,
+			 &( chunk_views_array[ chunk_index ] ),
+			 NULL );
+		}
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	if( basename[ 0 ] != 0 )
+	{
+		ewf_test_image_remove(
+		 basename );
+	}
+	rmdir(
+	 directory );
+
+	return( 0 );
+}
+
+/* Tests retrieving chunk views with the default chunk cache
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_view_round_trip_default_cache(
+     void )
+{
+	return( ewf_test_chunk_view_round_trip(
+	         0 ) );
+}
+
+/* Tests retrieving chunk views with a chunk cache that holds only a few chunks
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_view_round_trip_small_cache(
+     void )
+{
+	return( ewf_test_chunk_view_round_trip(
+	         4 * EWF_TEST_IMAGE_CHUNK_SIZE ) );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_handle_get_chunk_view",
+	 ewf_test_chunk_view_round_trip_default_cache );
+
+	EWF_TEST_RUN(
+	 "libewf_handle_get_chunk_view (small cache)",
+	 ewf_test_chunk_view_round_trip_small_cache );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
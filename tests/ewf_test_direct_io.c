@@ -0,0 +1,656 @@
+/*
+ * Direct IO file testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+
+/* Required for O_DIRECT
+ */
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#include <libcfile_definitions.h>
+#include <libcfile_file.h>
+
+#include <libcerror_error.h>
+
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+/* The size of the test file, which does not end on a direct IO block boundary
+ */
+#define EWF_TEST_DIRECT_IO_FILE_SIZE		( ( 3 * 1024 * 1024 ) + 120215 )
+
+/* The sizes of the successive writes, which are mostly not block aligned
+ * and together span multiple direct IO buffers
+ */
+static size_t ewf_test_direct_io_write_sizes[ 9 ] = {
+	1000, 3096, 4096, 7, 100000, ( 1024 * 1024 ) + 13, 2 * 1024 * 1024, 8192, 3811 };
+
+/* Fills a buffer with the data expected at a specific offset in the test file
+ */
+void ewf_test_direct_io_fill_buffer(
+      uint8_t *buffer,
+      size_t size,
+      off64_t offset,
+      uint8_t seed )
+{
+	size_t buffer_offset = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( ( ( offset * 7 ) + ( offset >> 12 ) + seed ) & 0xff );
+
+		offset++;
+	}
+}
+
+/* Determines if a file uses direct IO
+ * Returns 1 if the file was opened with O_DIRECT and has a direct IO buffer,
+ * 0 if the file was opened without O_DIRECT or -1 on error
+ */
+int ewf_test_direct_io_file_uses_direct_io(
+     libcfile_file_t *file )
+{
+#if defined( HAVE_LIBCFILE_DIRECT_IO_SUPPORT ) && defined( O_DIRECT )
+	libcfile_internal_file_t *internal_file = (libcfile_internal_file_t *) file;
+	int file_io_flags                       = 0;
+
+	file_io_flags = fcntl(
+	                 internal_file->descriptor,
+	                 F_GETFL );
+
+	if( ( file_io_flags == -1 )
+	 || ( ( file_io_flags & O_DIRECT ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( internal_file->direct_io_buffer == NULL )
+	{
+		return( -1 );
+	}
+	if( ( (intptr_t) internal_file->direct_io_buffer % LIBCFILE_DIRECT_IO_BLOCK_SIZE ) != 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+#else
+	EWF_TEST_UNREFERENCED_PARAMETER( file )
+
+	return( 0 );
+#endif
+}
+
+/* Compares the contents of a file, read without direct IO, with the expected data
+ * The data in the overwritten ranges is expected to be written with seed 1
+ * Returns 1 if the data matches, 0 if not or -1 on error
+ */
+int ewf_test_direct_io_compare_file(
+     const char *filename,
+     size64_t expected_file_size,
+     off64_t *overwrite_offsets,
+     size_t *overwrite_sizes,
+     int number_of_overwrites,
+     uint8_t *buffer,
+     uint8_t *expected_buffer,
+     size_t buffer_size )
+{
+	libcfile_file_t *file = NULL;
+	size64_t file_size    = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t offset        = 0;
+	off64_t range_offset  = 0;
+	size_t range_size     = 0;
+	int overwrite_index   = 0;
+	int result            = -1;
+
+	if( libcfile_file_initialize(
+	     &file,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libcfile_file_open(
+	     file,
+	     filename,
+	     LIBCFILE_ACCESS_FLAG_READ,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     &file_size,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	result = 0;
+
+	if( file_size != expected_file_size )
+	{
+		goto on_error;
+	}
+	while( (size64_t) offset < file_size )
+	{
+		read_size = buffer_size;
+
+		if( read_size > (size_t) ( file_size - offset ) )
+		{
+			read_size = (size_t) ( file_size - offset );
+		}
+		read_count = libcfile_file_read_buffer(
+		              file,
+		              buffer,
+		              read_size,
+		              NULL );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			result = -1;
+
+			goto on_error;
+		}
+		ewf_test_direct_io_fill_buffer(
+		 expected_buffer,
+		 read_size,
+		 offset,
+		 0 );
+
+		/* Replace the parts of the buffer that were overwritten
+		 */
+		for( overwrite_index = 0;
+		     overwrite_index < number_of_overwrites;
+		     overwrite_index++ )
+		{
+			if( ( overwrite_offsets[ overwrite_index ] >= (off64_t) ( offset + read_size ) )
+			 || ( ( overwrite_offsets[ overwrite_index ] + (off64_t) overwrite_sizes[ overwrite_index ] ) <= offset ) )
+			{
+				continue;
+			}
+			range_offset = overwrite_offsets[ overwrite_index ];
+
+			if( range_offset < offset )
+			{
+				range_offset = offset;
+			}
+			range_size = (size_t) ( overwrite_offsets[ overwrite_index ] + (off64_t) overwrite_sizes[ overwrite_index ] - range_offset );
+
+			if( range_size > (size_t) ( offset + read_size - range_offset ) )
+			{
+				range_size = (size_t) ( offset + read_size - range_offset );
+			}
+			ewf_test_direct_io_fill_buffer(
+			 &( expected_buffer[ range_offset - offset ] ),
+			 range_size,
+			 range_offset,
+			 1 );
+		}
+		if( memory_compare(
+		     buffer,
+		     expected_buffer,
+		     read_size ) != 0 )
+		{
+			goto on_error;
+		}
+		offset += (off64_t) read_size;
+	}
+	result = 1;
+
+on_error:
+	libcfile_file_free(
+	 &file,
+	 NULL );
+
+	return( result );
+}
+
+/* Tests writing, reading and overwriting a file using direct IO
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_direct_io_round_trip(
+     void )
+{
+	char directory[ 32 ] = "/tmp/ewf_test_XXXXXX";
+	char filename[ 64 ];
+
+	libcerror_error_t *error = NULL;
+	libcfile_file_t *file    = NULL;
+	uint8_t *buffer          = NULL;
+	uint8_t *expected_buffer = NULL;
+	size64_t file_size       = 0;
+	size_t buffer_size       = ( 2 * 1024 * 1024 ) + 8192;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	ssize_t write_count      = 0;
+	off64_t offset           = 0;
+	off64_t result_offset    = 0;
+	int write_index          = 0;
+	int result               = 0;
+
+	/* The offsets and sizes of the reads, which are unaligned, cross the direct IO buffer
+	 * or the end of the file
+	 */
+	off64_t overwrite_offsets[ 2 ] = {
+		EWF_TEST_DIRECT_IO_FILE_SIZE - 1000, 5000 };
+	size_t overwrite_sizes[ 2 ] = {
+		5000, 300 };
+	off64_t read_offsets[ 8 ] = {
+		0, 1, 4095, 4096 + 17, ( 1024 * 1024 ) - 5, 3 * 4096, EWF_TEST_DIRECT_IO_FILE_SIZE - 100, EWF_TEST_DIRECT_IO_FILE_SIZE };
+	size_t read_sizes[ 8 ] = {
+		4096, 511, 2, 70000, 4096 + 10, 2 * 1024 * 1024, 4096, 512 };
+
+	filename[ 0 ] = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      buffer_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               buffer_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "expected_buffer",
+	 expected_buffer );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory",
+	 mkdtemp( directory ) );
+
+	snprintf(
+	 filename,
+	 64,
+	 "%s/direct_io.raw",
+	 directory );
+
+	/* Write the file in pieces that are not block aligned
+	 */
+	result = libcfile_file_initialize(
+	          &file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcfile_file_open(
+	          file,
+	          filename,
+	          LIBCFILE_ACCESS_FLAG_WRITE | LIBCFILE_ACCESS_FLAG_TRUNCATE | LIBCFILE_ACCESS_FLAG_DIRECT_IO,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_direct_io_file_uses_direct_io(
+	          file );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	offset = 0;
+
+	for( write_index = 0;
+	     write_index < 9;
+	     write_index++ )
+	{
+		ewf_test_direct_io_fill_buffer(
+		 buffer,
+		 ewf_test_direct_io_write_sizes[ write_index ],
+		 offset,
+		 0 );
+
+		write_count = libcfile_file_write_buffer(
+		               file,
+		               buffer,
+		               ewf_test_direct_io_write_sizes[ write_index ],
+		               &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) ewf_test_direct_io_write_sizes[ write_index ] );
+
+		offset += (off64_t) write_count;
+	}
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) EWF_TEST_DIRECT_IO_FILE_SIZE );
+
+	result = libcfile_file_close(
+	          file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The padding of the last block is removed when the file is closed
+	 */
+	result = ewf_test_direct_io_compare_file(
+	          filename,
+	          EWF_TEST_DIRECT_IO_FILE_SIZE,
+	          NULL,
+	          NULL,
+	          0,
+	          buffer,
+	          expected_buffer,
+	          buffer_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Read the file at offsets and sizes that are not block aligned
+	 */
+	result = libcfile_file_open(
+	          file,
+	          filename,
+	          LIBCFILE_ACCESS_FLAG_READ | LIBCFILE_ACCESS_FLAG_DIRECT_IO,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_direct_io_file_uses_direct_io(
+	          file );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	result = libcfile_file_get_size(
+	          file,
+	          &file_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "file_size",
+	 (int64_t) file_size,
+	 (int64_t) EWF_TEST_DIRECT_IO_FILE_SIZE );
+
+	for( write_index = 0;
+	     write_index < 8;
+	     write_index++ )
+	{
+		result_offset = libcfile_file_seek_offset(
+		                 file,
+		                 read_offsets[ write_index ],
+		                 SEEK_SET,
+		                 &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "result_offset",
+		 (int64_t) result_offset,
+		 (int64_t) read_offsets[ write_index ] );
+
+		read_size = read_sizes[ write_index ];
+
+		if( read_size > (size_t) ( EWF_TEST_DIRECT_IO_FILE_SIZE - read_offsets[ write_index ] ) )
+		{
+			read_size = (size_t) ( EWF_TEST_DIRECT_IO_FILE_SIZE - read_offsets[ write_index ] );
+		}
+		read_count = libcfile_file_read_buffer(
+		              file,
+		              buffer,
+		              read_sizes[ write_index ],
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		ewf_test_direct_io_fill_buffer(
+		 expected_buffer,
+		 read_size,
+		 read_offsets[ write_index ],
+		 0 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 memory_compare(
+		  buffer,
+		  expected_buffer,
+		  read_size ),
+		 0 );
+	}
+	result = libcfile_file_close(
+	          file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Overwrite a range in the middle of a block that extends the file
+	 * the partially written blocks are completed with the data in the file
+	 */
+	result = libcfile_file_open(
+	          file,
+	          filename,
+	          LIBCFILE_ACCESS_FLAG_READ | LIBCFILE_ACCESS_FLAG_WRITE | LIBCFILE_ACCESS_FLAG_DIRECT_IO,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	offset = overwrite_offsets[ 0 ];
+
+	result_offset = libcfile_file_seek_offset(
+	                 file,
+	                 offset,
+	                 SEEK_SET,
+	                 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "result_offset",
+	 (int64_t) result_offset,
+	 (int64_t) offset );
+
+	ewf_test_direct_io_fill_buffer(
+	 buffer,
+	 overwrite_sizes[ 0 ],
+	 offset,
+	 1 );
+
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               buffer,
+	               overwrite_sizes[ 0 ],
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) overwrite_sizes[ 0 ] );
+
+	/* Write a range in the middle of the file that does not start or end on a block boundary
+	 */
+	result_offset = libcfile_file_seek_offset(
+	                 file,
+	                 overwrite_offsets[ 1 ],
+	                 SEEK_SET,
+	                 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "result_offset",
+	 (int64_t) result_offset,
+	 (int64_t) overwrite_offsets[ 1 ] );
+
+	ewf_test_direct_io_fill_buffer(
+	 buffer,
+	 overwrite_sizes[ 1 ],
+	 overwrite_offsets[ 1 ],
+	 1 );
+
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               buffer,
+	               overwrite_sizes[ 1 ],
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) overwrite_sizes[ 1 ] );
+
+	result = libcfile_file_close(
+	          file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_direct_io_compare_file(
+	          filename,
+	          EWF_TEST_DIRECT_IO_FILE_SIZE + 4000,
+	          overwrite_offsets,
+	          overwrite_sizes,
+	          2,
+	          buffer,
+	          expected_buffer,
+	          buffer_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcfile_file_free(
+	          &file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	memory_free(
+	 expected_buffer );
+
+	memory_free(
+	 buffer );
+
+	unlink(
+	 filename );
+
+	rmdir(
+	 directory );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( filename[ 0 ] != 0 )
+	{
+		unlink(
+		 filename );
+	}
+	rmdir(
+	 directory );
+
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libcfile_file_open (direct IO)",
+	 ewf_test_direct_io_round_trip );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
@@ -0,0 +1,803 @@
+/*
+ * Size bounded cache testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libfcache_cache.h>
+#include <libfcache_cache_value.h>
+#include <libfcache_definitions.h>
+
+#include <libcerror_error.h>
+
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_FCACHE_CACHE_NUMBER_OF_VALUES	8
+
+/* The values stored in the cache, the cache does not allocate them
+ */
+static int ewf_test_fcache_cache_values[ EWF_TEST_FCACHE_CACHE_NUMBER_OF_VALUES ];
+
+/* The number of times a value was freed by the cache
+ */
+static int ewf_test_fcache_cache_number_of_freed_values = 0;
+
+/* Counts a value freed by the cache
+ * Returns 1
+ */
+int ewf_test_fcache_cache_free_value(
+     intptr_t **value,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( ( value != NULL )
+	 && ( *value != NULL ) )
+	{
+		ewf_test_fcache_cache_number_of_freed_values += 1;
+
+		*value = NULL;
+	}
+	return( 1 );
+}
+
+/* Stores the value with a specific index in the cache at offset index * 1000
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_fcache_cache_set_value(
+     libfcache_cache_t *cache,
+     int value_index,
+     size_t value_size,
+     libcerror_error_t **error )
+{
+	return( libfcache_cache_set_value_by_identifier(
+	         cache,
+	         0,
+	         (off64_t) value_index * 1000,
+	         0,
+	         (intptr_t *) &( ewf_test_fcache_cache_values[ value_index ] ),
+	         value_size,
+	         &ewf_test_fcache_cache_free_value,
+	         LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	         error ) );
+}
+
+/* Determines if the value with a specific index is in the cache
+ * Returns 1 if the value is in the cache, 0 if not or -1 on error
+ */
+int ewf_test_fcache_cache_has_value(
+     libfcache_cache_t *cache,
+     int value_index,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	intptr_t *value                      = NULL;
+	int result                           = 0;
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          (off64_t) value_index * 1000,
+	          0,
+	          &cache_value,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	if( libfcache_cache_value_get_value(
+	     cache_value,
+	     &value,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( value != (intptr_t *) &( ewf_test_fcache_cache_values[ value_index ] ) )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests if the least recently used value is evicted first
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_fcache_cache_eviction_order(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libfcache_cache_t *cache   = NULL;
+	size64_t cache_size        = 0;
+	int number_of_cache_values = 0;
+	int result                 = 0;
+	int value_index            = 0;
+
+	ewf_test_fcache_cache_number_of_freed_values = 0;
+
+	result = libfcache_cache_initialize_with_maximum_size(
+	          &cache,
+	          300,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( value_index = 0;
+	     value_index < 3;
+	     value_index++ )
+	{
+		result = ewf_test_fcache_cache_set_value(
+		          cache,
+		          value_index,
+		          100,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* Using value 0 makes value 1 the least recently used
+	 */
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_set_value(
+	          cache,
+	          3,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_freed_values",
+	 ewf_test_fcache_cache_number_of_freed_values,
+	 1 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Value 2 is now the least recently used
+	 */
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_set_value(
+	          cache,
+	          4,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfcache_cache_get_number_of_cache_values(
+	          cache,
+	          &number_of_cache_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_values",
+	 number_of_cache_values,
+	 3 );
+
+	result = libfcache_cache_get_size(
+	          cache,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "cache_size",
+	 cache_size,
+	 300 );
+
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_freed_values",
+	 ewf_test_fcache_cache_number_of_freed_values,
+	 5 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests if the cache is bounded by the sum of the value sizes
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_fcache_cache_size_bound(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	libfcache_cache_t *cache = NULL;
+	size64_t cache_size      = 0;
+	int result               = 0;
+	int value_index          = 0;
+
+	ewf_test_fcache_cache_number_of_freed_values = 0;
+
+	result = libfcache_cache_initialize_with_maximum_size(
+	          &cache,
+	          1000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Values of 100, 200, 300 and 400 bytes fit exactly
+	 */
+	for( value_index = 0;
+	     value_index < 4;
+	     value_index++ )
+	{
+		result = ewf_test_fcache_cache_set_value(
+		          cache,
+		          value_index,
+		          (size_t) ( value_index + 1 ) * 100,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_freed_values",
+	 ewf_test_fcache_cache_number_of_freed_values,
+	 0 );
+
+	/* A value of 250 bytes requires the values of 100 and 200 bytes to be evicted
+	 */
+	result = ewf_test_fcache_cache_set_value(
+	          cache,
+	          4,
+	          250,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_freed_values",
+	 ewf_test_fcache_cache_number_of_freed_values,
+	 2 );
+
+	result = libfcache_cache_get_size(
+	          cache,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "cache_size",
+	 cache_size,
+	 950 );
+
+	/* Replacing a value charges its new size
+	 */
+	result = ewf_test_fcache_cache_set_value(
+	          cache,
+	          3,
+	          50,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfcache_cache_get_size(
+	          cache,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "cache_size",
+	 cache_size,
+	 600 );
+
+	/* Lowering the maximum size evicts the least recently used values
+	 */
+	result = libfcache_cache_set_maximum_size(
+	          cache,
+	          300,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfcache_cache_get_size(
+	          cache,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "cache_size",
+	 cache_size,
+	 300 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests if the most recently used value is kept when it exceeds the maximum size
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_fcache_cache_keep_most_recently_used(
+     void )
+{
+	libcerror_error_t *error   = NULL;
+	libfcache_cache_t *cache   = NULL;
+	size64_t cache_size        = 0;
+	int number_of_cache_values = 0;
+	int result                 = 0;
+
+	ewf_test_fcache_cache_number_of_freed_values = 0;
+
+	result = libfcache_cache_initialize_with_maximum_size(
+	          &cache,
+	          1000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_set_value(
+	          cache,
+	          0,
+	          500,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A value larger than the maximum size evicts all other values
+	 * but is kept itself
+	 */
+	result = ewf_test_fcache_cache_set_value(
+	          cache,
+	          1,
+	          5000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfcache_cache_get_number_of_cache_values(
+	          cache,
+	          &number_of_cache_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_values",
+	 number_of_cache_values,
+	 1 );
+
+	/* Lowering the maximum size below the size of the most recently used
+	 * value keeps that value
+	 */
+	result = libfcache_cache_set_maximum_size(
+	          cache,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfcache_cache_get_size(
+	          cache,
+	          &cache_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "cache_size",
+	 cache_size,
+	 5000 );
+
+	/* The next value replaces it
+	 */
+	result = ewf_test_fcache_cache_set_value(
+	          cache,
+	          2,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_has_value(
+	          cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_freed_values",
+	 ewf_test_fcache_cache_number_of_freed_values,
+	 2 );
+
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests if a value with a different timestamp is not returned
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_fcache_cache_timestamp(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfcache_cache_t *cache             = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	int result                           = 0;
+
+	ewf_test_fcache_cache_number_of_freed_values = 0;
+
+	result = libfcache_cache_initialize_with_maximum_size(
+	          &cache,
+	          1000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_fcache_cache_set_value(
+	          cache,
+	          0,
+	          100,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          0,
+	          1,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          1,
+	          0,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libfcache_cache eviction order",
+	 ewf_test_fcache_cache_eviction_order );
+
+	EWF_TEST_RUN(
+	 "libfcache_cache size bound",
+	 ewf_test_fcache_cache_size_bound );
+
+	EWF_TEST_RUN(
+	 "libfcache_cache keep most recently used",
+	 ewf_test_fcache_cache_keep_most_recently_used );
+
+	EWF_TEST_RUN(
+	 "libfcache_cache timestamp",
+	 ewf_test_fcache_cache_timestamp );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
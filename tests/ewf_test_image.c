@@ -0,0 +1,374 @@
+/*
+ * Functions to create test images
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_STRING_H ) || defined( WINAPI )
+#include <string.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <libewf.h>
+
+#include "ewf_test_image.h"
+
+/* Fills a buffer with the media data of a test image at a specific offset
+ */
+void ewf_test_image_fill_buffer(
+      uint8_t *buffer,
+      size_t size,
+      off64_t offset,
+      int data_type )
+{
+	const char *characters = "abcdefghijklmnop";
+	uint32_t value         = 0;
+	size_t index           = 0;
+
+	for( index = 0;
+	     index < size;
+	     index++ )
+	{
+		/* Random data does not compress so that the chunks are stored as-is
+		 */
+		if( data_type == EWF_TEST_IMAGE_DATA_TYPE_RANDOM )
+		{
+			value = (uint32_t) ( ( offset + index ) * 2654435761UL );
+
+			buffer[ index ] = (uint8_t) ( ( value >> 24 ) ^ ( value >> 11 ) );
+		}
+		/* Text data consists of words of 7 characters separated by a space
+		 */
+		else if( ( ( offset + index ) % 8 ) == 7 )
+		{
+			buffer[ index ] = (uint8_t) ' ';
+		}
+		else
+		{
+			value = (uint32_t) ( ( offset + index ) * 2654435761UL );
+
+			buffer[ index ] = (uint8_t) characters[ value >> 28 ];
+		}
+	}
+}
+
+/* Opens a test image for writing
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_open_write(
+     libewf_handle_t *handle,
+     char *basename,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     libewf_error_t **error )
+{
+	char *filenames[ 1 ] = { basename };
+
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_set_format(
+	     handle,
+	     LIBEWF_FORMAT_ENCASE6,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     media_size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_set_maximum_segment_size(
+	     handle,
+	     maximum_segment_size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     0,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the media data of a test image in buffers of a specific size
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_write(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     size_t write_size,
+     int data_type,
+     libewf_error_t **error )
+{
+	uint8_t *buffer     = NULL;
+	size64_t offset     = 0;
+	size_t buffer_size  = 0;
+	ssize_t write_count = 0;
+
+	buffer = (uint8_t *) malloc(
+	                      write_size );
+
+	if( buffer == NULL )
+	{
+		return( -1 );
+	}
+	for( offset = 0;
+	     offset < media_size;
+	     offset += buffer_size )
+	{
+		buffer_size = write_size;
+
+		if( buffer_size > ( media_size - offset ) )
+		{
+			buffer_size = (size_t) ( media_size - offset );
+		}
+		ewf_test_image_fill_buffer(
+		 buffer,
+		 buffer_size,
+		 (off64_t) offset,
+		 data_type );
+
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count != (ssize_t) buffer_size )
+		{
+			free(
+			 buffer );
+
+			return( -1 );
+		}
+	}
+	free(
+	 buffer );
+
+	return( 1 );
+}
+
+/* Creates a test image
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_create(
+     char *basename,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     int data_type,
+     libewf_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_image_open_write(
+	     handle,
+	     basename,
+	     media_size,
+	     maximum_segment_size,
+	     compression_level,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_image_write(
+	     handle,
+	     media_size,
+	     EWF_TEST_IMAGE_CHUNK_SIZE,
+	     data_type,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Compares the media data read from a test image with the data it was created with
+ * The data is read with libewf_handle_read_buffer_at_offset in buffers of a specific size
+ * Returns 1 if the data matches, 0 if not or -1 on error
+ */
+int ewf_test_image_compare(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     size_t read_size,
+     int data_type,
+     libewf_error_t **error )
+{
+	uint8_t *buffer          = NULL;
+	uint8_t *expected_buffer = NULL;
+	size64_t offset          = 0;
+	size_t buffer_size       = 0;
+	ssize_t read_count       = 0;
+	int result               = 1;
+
+	buffer = (uint8_t *) malloc(
+	                      read_size );
+
+	expected_buffer = (uint8_t *) malloc(
+	                               read_size );
+
+	if( ( buffer == NULL )
+	 || ( expected_buffer == NULL ) )
+	{
+		result = -1;
+
+		goto on_exit;
+	}
+	for( offset = 0;
+	     offset < media_size;
+	     offset += buffer_size )
+	{
+		buffer_size = read_size;
+
+		if( buffer_size > ( media_size - offset ) )
+		{
+			buffer_size = (size_t) ( media_size - offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              buffer_size,
+		              (off64_t) offset,
+		              error );
+
+		if( read_count != (ssize_t) buffer_size )
+		{
+			result = -1;
+
+			break;
+		}
+		ewf_test_image_fill_buffer(
+		 expected_buffer,
+		 buffer_size,
+		 (off64_t) offset,
+		 data_type );
+
+		if( memcmp(
+		     buffer,
+		     expected_buffer,
+		     buffer_size ) != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+	}
+on_exit:
+	if( expected_buffer != NULL )
+	{
+		free(
+		 expected_buffer );
+	}
+	if( buffer != NULL )
+	{
+		free(
+		 buffer );
+	}
+	return( result );
+}
+
+/* Removes the segment files of a test image
+ * The filename is the name of the first segment file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_image_remove(
+     const char *filename )
+{
+	char **filenames        = NULL;
+	int filename_index      = 0;
+	int number_of_filenames = 0;
+
+	if( libewf_glob(
+	     filename,
+	     strlen( filename ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		unlink(
+		 filenames[ filename_index ] );
+	}
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
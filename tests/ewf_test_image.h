@@ -0,0 +1,88 @@
+/*
+ * Functions to create test images
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_TEST_IMAGE_H )
+#define _EWF_TEST_IMAGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include <libewf.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The chunk size of a test image, which is the default of libewf
+ */
+#define EWF_TEST_IMAGE_CHUNK_SIZE		32768
+
+enum EWF_TEST_IMAGE_DATA_TYPES
+{
+	EWF_TEST_IMAGE_DATA_TYPE_RANDOM		= 0,
+	EWF_TEST_IMAGE_DATA_TYPE_TEXT		= 1
+};
+
+void ewf_test_image_fill_buffer(
+      uint8_t *buffer,
+      size_t size,
+      off64_t offset,
+      int data_type );
+
+int ewf_test_image_open_write(
+     libewf_handle_t *handle,
+     char *basename,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     libewf_error_t **error );
+
+int ewf_test_image_write(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     size_t write_size,
+     int data_type,
+     libewf_error_t **error );
+
+int ewf_test_image_create(
+     char *basename,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     int8_t compression_level,
+     int data_type,
+     libewf_error_t **error );
+
+int ewf_test_image_compare(
+     libewf_handle_t *handle,
+     size64_t media_size,
+     size_t read_size,
+     int data_type,
+     libewf_error_t **error );
+
+int ewf_test_image_remove(
+     const char *filename );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_TEST_IMAGE_H ) */
+
@@ -0,0 +1,540 @@
+/*
+ * Index file testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#include <utime.h>
+
+#include <libewf.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+/* The image consists of multiple segment files
+ */
+#define EWF_TEST_INDEX_FILE_MEDIA_SIZE		( ( 4 * 1024 * 1024 ) + ( 3 * 512 ) )
+#define EWF_TEST_INDEX_FILE_SEGMENT_SIZE	( 1024 * 1024 )
+
+/* Writes a test image with an index file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_index_file_write_image(
+     char *basename,
+     const char *index_filename,
+     libewf_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_set_index_filename(
+	     handle,
+	     index_filename,
+	     narrow_string_length( index_filename ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_image_open_write(
+	     handle,
+	     basename,
+	     EWF_TEST_INDEX_FILE_MEDIA_SIZE,
+	     EWF_TEST_INDEX_FILE_SEGMENT_SIZE,
+	     LIBEWF_COMPRESSION_FAST,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_image_write(
+	     handle,
+	     EWF_TEST_INDEX_FILE_MEDIA_SIZE,
+	     EWF_TEST_IMAGE_CHUNK_SIZE,
+	     EWF_TEST_IMAGE_DATA_TYPE_RANDOM,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a test image, using the index file if not NULL, and compares its data
+ * Returns 1 if the data matches, 0 if not or -1 on error
+ */
+int ewf_test_index_file_compare_image(
+     char * const filenames[],
+     int number_of_filenames,
+     const char *index_filename,
+     libewf_error_t **error )
+{
+	libewf_handle_t *handle = NULL;
+	int result              = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( index_filename != NULL )
+	{
+		if( libewf_handle_set_index_filename(
+		     handle,
+		     index_filename,
+		     narrow_string_length( index_filename ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	result = ewf_test_image_compare(
+	          handle,
+	          EWF_TEST_INDEX_FILE_MEDIA_SIZE,
+	          EWF_TEST_IMAGE_CHUNK_SIZE,
+	          EWF_TEST_IMAGE_DATA_TYPE_RANDOM,
+	          error );
+
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the data of a file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_index_file_read_data(
+     const char *filename,
+     uint8_t **data,
+     size_t *data_size )
+{
+	struct stat file_statistics;
+
+	FILE *file_stream = NULL;
+
+	if( stat(
+	     filename,
+	     &file_statistics ) != 0 )
+	{
+		return( -1 );
+	}
+	*data_size = (size_t) file_statistics.st_size;
+
+	*data = (uint8_t *) memory_allocate(
+	                     *data_size );
+
+	if( *data == NULL )
+	{
+		return( -1 );
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               "rb" );
+
+	if( file_stream == NULL )
+	{
+		goto on_error;
+	}
+	if( file_stream_read(
+	     file_stream,
+	     *data,
+	     *data_size ) != *data_size )
+	{
+		goto on_error;
+	}
+	file_stream_close(
+	 file_stream );
+
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	memory_free(
+	 *data );
+
+	*data = NULL;
+
+	return( -1 );
+}
+
+/* Tests the index file that is written when the write is finalized
+ * and if a changed segment file modification time invalidates the index file
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_round_trip(
+     void )
+{
+	char basename[ 64 ];
+	char directory[ 32 ] = "/tmp/ewf_test_XXXXXX";
+	char index_filename[ 64 ];
+	struct utimbuf file_times;
+
+	libewf_error_t *error   = NULL;
+	uint8_t *index_data     = NULL;
+	uint8_t *reread_data    = NULL;
+	char **filenames        = NULL;
+	size_t index_data_size  = 0;
+	size_t reread_data_size = 0;
+	int number_of_filenames = 0;
+	int result              = 0;
+
+	basename[ 0 ]       = 0;
+	index_filename[ 0 ] = 0;
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory",
+	 mkdtemp( directory ) );
+
+	snprintf(
+	 basename,
+	 64,
+	 "%s/image",
+	 directory );
+
+	snprintf(
+	 index_filename,
+	 64,
+	 "%s/image.idx",
+	 directory );
+
+	result = ewf_test_index_file_write_image(
+	          basename,
+	          index_filename,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The index file is written when the write is finalized
+	 */
+	result = ewf_test_index_file_read_data(
+	          index_filename,
+	          &index_data,
+	          &index_data_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	narrow_string_copy(
+	 &( basename[ narrow_string_length( basename ) ] ),
+	 ".E01",
+	 5 );
+
+	result = libewf_glob(
+	          basename,
+	          narrow_string_length( basename ),
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_filenames",
+	 number_of_filenames,
+	 2 );
+
+	/* Read the image without and with the index file
+	 */
+	result = ewf_test_index_file_compare_image(
+	          filenames,
+	          number_of_filenames,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_index_file_compare_image(
+	          filenames,
+	          number_of_filenames,
+	          index_filename,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A valid index file is not rewritten
+	 */
+	result = ewf_test_index_file_read_data(
+	          index_filename,
+	          &reread_data,
+	          &reread_data_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "reread_data_size",
+	 reread_data_size,
+	 index_data_size );
+
+	result = memory_compare(
+	          reread_data,
+	          index_data,
+	          index_data_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_free(
+	 reread_data );
+
+	reread_data = NULL;
+
+	/* A segment file with a different modification time invalidates the index file
+	 */
+	file_times.actime  = 1000000000;
+	file_times.modtime = 1000000000;
+
+	result = utime(
+	          filenames[ 1 ],
+	          &file_times );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_index_file_compare_image(
+	          filenames,
+	          number_of_filenames,
+	          index_filename,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_index_file_read_data(
+	          index_filename,
+	          &reread_data,
+	          &reread_data_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "reread_data_size",
+	 reread_data_size,
+	 index_data_size );
+
+	result = memory_compare(
+	          reread_data,
+	          index_data,
+	          index_data_size );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The rewritten index file is used to read the image
+	 */
+	result = ewf_test_index_file_compare_image(
+	          filenames,
+	          number_of_filenames,
+	          index_filename,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	memory_free(
+	 reread_data );
+
+	memory_free(
+	 index_data );
+
+	libewf_glob_free(
+	 filenames,
+	 number_of_filenames,
+	 NULL );
+
+	unlink(
+	 index_filename );
+
+	ewf_test_image_remove(
+	 basename );
+
+	rmdir(
+	 directory );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( reread_data != NULL )
+	{
+		memory_free(
+		 reread_data );
+	}
+	if( index_data != NULL )
+	{
+		memory_free(
+		 index_data );
+	}
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	if( index_filename[ 0 ] != 0 )
+	{
+		unlink(
+		 index_filename );
+	}
+	if( basename[ 0 ] != 0 )
+	{
+		ewf_test_image_remove(
+		 basename );
+	}
+	rmdir(
+	 directory );
+
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_handle_set_index_filename",
+	 ewf_test_index_file_round_trip );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,299 @@
+/*
+ * Functions to create test ltree data
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewf_test_ltree.h"
+
+/* Appends a narrow string to the ltree data as UTF-16 little-endian
+ * If ltree_data is NULL only the ltree data offset is updated
+ */
+void ewf_test_ltree_append_string(
+      uint8_t *ltree_data,
+      size_t *ltree_data_offset,
+      const char *string )
+{
+	size_t string_index = 0;
+
+	while( string[ string_index ] != 0 )
+	{
+		if( ltree_data != NULL )
+		{
+			ltree_data[ *ltree_data_offset ]     = (uint8_t) string[ string_index ];
+			ltree_data[ *ltree_data_offset + 1 ] = 0;
+		}
+		*ltree_data_offset += 2;
+
+		string_index++;
+	}
+}
+
+/* Appends an UTF-16 value to the ltree data as little-endian
+ * If ltree_data is NULL only the ltree data offset is updated
+ */
+void ewf_test_ltree_append_value(
+      uint8_t *ltree_data,
+      size_t *ltree_data_offset,
+      uint16_t value )
+{
+	if( ltree_data != NULL )
+	{
+		ltree_data[ *ltree_data_offset ]     = (uint8_t) ( value & 0xff );
+		ltree_data[ *ltree_data_offset + 1 ] = (uint8_t) ( value >> 8 );
+	}
+	*ltree_data_offset += 2;
+}
+
+/* Appends an UTF-8 string to the ltree data as UTF-16 little-endian
+ * If use_carriage_return is set an end-of-line is appended as a carriage return and line feed
+ * If ltree_data is NULL only the ltree data offset is updated
+ */
+void ewf_test_ltree_append_utf8_string(
+      uint8_t *ltree_data,
+      size_t *ltree_data_offset,
+      const char *utf8_string,
+      uint8_t use_carriage_return )
+{
+	const uint8_t *utf8_stream = (const uint8_t *) utf8_string;
+	uint32_t unicode_character = 0;
+	size_t utf8_stream_index   = 0;
+
+	while( utf8_stream[ utf8_stream_index ] != 0 )
+	{
+		if( utf8_stream[ utf8_stream_index ] < 0x80 )
+		{
+			unicode_character = utf8_stream[ utf8_stream_index ];
+
+			utf8_stream_index += 1;
+		}
+		else if( utf8_stream[ utf8_stream_index ] < 0xe0 )
+		{
+			unicode_character  = (uint32_t) ( utf8_stream[ utf8_stream_index ] & 0x1f ) << 6;
+			unicode_character |= utf8_stream[ utf8_stream_index + 1 ] & 0x3f;
+
+			utf8_stream_index += 2;
+		}
+		else if( utf8_stream[ utf8_stream_index ] < 0xf0 )
+		{
+			unicode_character  = (uint32_t) ( utf8_stream[ utf8_stream_index ] & 0x0f ) << 12;
+			unicode_character |= (uint32_t) ( utf8_stream[ utf8_stream_index + 1 ] & 0x3f ) << 6;
+			unicode_character |= utf8_stream[ utf8_stream_index + 2 ] & 0x3f;
+
+			utf8_stream_index += 3;
+		}
+		else
+		{
+			unicode_character  = (uint32_t) ( utf8_stream[ utf8_stream_index ] & 0x07 ) << 18;
+			unicode_character |= (uint32_t) ( utf8_stream[ utf8_stream_index + 1 ] & 0x3f ) << 12;
+			unicode_character |= (uint32_t) ( utf8_stream[ utf8_stream_index + 2 ] & 0x3f ) << 6;
+			unicode_character |= utf8_stream[ utf8_stream_index + 3 ] & 0x3f;
+
+			utf8_stream_index += 4;
+		}
+		if( ( unicode_character == (uint32_t) '\n' )
+		 && ( use_carriage_return != 0 ) )
+		{
+			ewf_test_ltree_append_value(
+			 ltree_data,
+			 ltree_data_offset,
+			 (uint16_t) '\r' );
+		}
+		if( unicode_character > 0xffff )
+		{
+			unicode_character -= 0x10000;
+
+			ewf_test_ltree_append_value(
+			 ltree_data,
+			 ltree_data_offset,
+			 (uint16_t) ( 0xd800 + ( unicode_character >> 10 ) ) );
+
+			ewf_test_ltree_append_value(
+			 ltree_data,
+			 ltree_data_offset,
+			 (uint16_t) ( 0xdc00 + ( unicode_character & 0x03ff ) ) );
+		}
+		else
+		{
+			ewf_test_ltree_append_value(
+			 ltree_data,
+			 ltree_data_offset,
+			 (uint16_t) unicode_character );
+		}
+	}
+}
+
+/* Generates the ltree of a logical image with directories of files
+ * The names contain characters outside the ASCII range and the basic multilingual plane
+ * If ltree_data is NULL only the ltree data size is determined
+ */
+void ewf_test_ltree_generate(
+      uint8_t *ltree_data,
+      size_t *ltree_data_size,
+      int number_of_directories,
+      int number_of_files )
+{
+	char line[ 256 ];
+
+	uint64_t data_offset  = 0;
+	uint32_t data_size    = 0;
+	size_t offset         = 0;
+	int directory_index   = 0;
+	int file_index        = 0;
+	int identifier        = 2;
+
+	snprintf(
+	 line,
+	 256,
+	 "5\nrec\ntb\tcl\n%d\t1\n\n",
+	 EWF_TEST_LTREE_MEDIA_SIZE );
+
+	ewf_test_ltree_append_string(
+	 ltree_data,
+	 &offset,
+	 line );
+
+	ewf_test_ltree_append_string(
+	 ltree_data,
+	 &offset,
+	 "perm\n1\t1\np\tn\ts\n0\t0\n\n"
+	 "entry\n0\t1\n"
+	 "p\tn\tid\topr\tls\tbe\tmo\tha\n" );
+
+	snprintf(
+	 line,
+	 256,
+	 "0\t%d\n1\t\t1\t0\t0\t\t0\t\n",
+	 number_of_directories );
+
+	ewf_test_ltree_append_string(
+	 ltree_data,
+	 &offset,
+	 line );
+
+	for( directory_index = 0;
+	     directory_index < number_of_directories;
+	     directory_index++ )
+	{
+		snprintf(
+		 line,
+		 256,
+		 "0\t%d\n1\tdir%05d",
+		 number_of_files,
+		 directory_index );
+
+		ewf_test_ltree_append_string(
+		 ltree_data,
+		 &offset,
+		 line );
+
+		/* LATIN SMALL LETTER E WITH ACUTE
+		 */
+		ewf_test_ltree_append_value(
+		 ltree_data,
+		 &offset,
+		 0x00e9 );
+
+		snprintf(
+		 line,
+		 256,
+		 "\t%d\t0\t0\t\t%d\t\n",
+		 identifier,
+		 1500000000 + directory_index );
+
+		ewf_test_ltree_append_string(
+		 ltree_data,
+		 &offset,
+		 line );
+
+		identifier++;
+
+		for( file_index = 0;
+		     file_index < number_of_files;
+		     file_index++ )
+		{
+			data_size = (uint32_t) ( ( file_index * 37 ) % 100000 ) + 1;
+
+			snprintf(
+			 line,
+			 256,
+			 "0\t0\n\tfile%07d_",
+			 file_index );
+
+			ewf_test_ltree_append_string(
+			 ltree_data,
+			 &offset,
+			 line );
+
+			/* CJK UNIFIED IDEOGRAPH-4E2D and GRINNING FACE as a surrogate pair
+			 */
+			ewf_test_ltree_append_value(
+			 ltree_data,
+			 &offset,
+			 0x4e2d );
+
+			ewf_test_ltree_append_value(
+			 ltree_data,
+			 &offset,
+			 0xd83d );
+
+			ewf_test_ltree_append_value(
+			 ltree_data,
+			 &offset,
+			 0xde00 );
+
+			snprintf(
+			 line,
+			 256,
+			 ".txt\t%d\t4\t%" PRIu32 "\t1 %" PRIx64 " %" PRIx32 "\t%d\t%032x\n",
+			 identifier,
+			 data_size,
+			 data_offset,
+			 data_size,
+			 1500000000 + file_index,
+			 identifier );
+
+			ewf_test_ltree_append_string(
+			 ltree_data,
+			 &offset,
+			 line );
+
+			data_offset += data_size;
+
+			identifier++;
+		}
+	}
+	ewf_test_ltree_append_string(
+	 ltree_data,
+	 &offset,
+	 "\n" );
+
+	/* The end-of-string character
+	 */
+	ewf_test_ltree_append_value(
+	 ltree_data,
+	 &offset,
+	 0 );
+
+	*ltree_data_size = offset;
+}
+
@@ -0,0 +1,63 @@
+/*
+ * Functions to create test ltree data
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWF_TEST_LTREE_H )
+#define _EWF_TEST_LTREE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The media size of a generated ltree
+ */
+#define EWF_TEST_LTREE_MEDIA_SIZE	123456789
+
+void ewf_test_ltree_append_string(
+      uint8_t *ltree_data,
+      size_t *ltree_data_offset,
+      const char *string );
+
+void ewf_test_ltree_append_value(
+      uint8_t *ltree_data,
+      size_t *ltree_data_offset,
+      uint16_t value );
+
+void ewf_test_ltree_append_utf8_string(
+      uint8_t *ltree_data,
+      size_t *ltree_data_offset,
+      const char *utf8_string,
+      uint8_t use_carriage_return );
+
+void ewf_test_ltree_generate(
+      uint8_t *ltree_data,
+      size_t *ltree_data_size,
+      int number_of_directories,
+      int number_of_files );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_TEST_LTREE_H ) */
+
@@ -0,0 +1,650 @@
+/*
+ * Mount path cache testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libcerror_error.h>
+
+#include "../ewftools/mount_path_cache.h"
+#include "../libewf/libewf_file_entry.h"
+
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+/* Inserts a path with a new file entry into the path cache
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_mount_path_cache_insert_path(
+     mount_path_cache_t *path_cache,
+     const system_character_t *path,
+     mount_path_cache_entry_t **entry,
+     libcerror_error_t **error )
+{
+	libewf_file_entry_t *file_entry = NULL;
+
+	if( libewf_file_entry_initialize(
+	     &file_entry,
+	     NULL,
+	     NULL,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( mount_path_cache_insert_entry(
+	     path_cache,
+	     path,
+	     system_string_length( path ),
+	     &file_entry,
+	     entry,
+	     error ) != 1 )
+	{
+		libewf_file_entry_free(
+		 &file_entry,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Looks up a path in the path cache and releases the entry
+ * Returns 1 if the path was found, 0 if not or -1 on error
+ */
+int ewf_test_mount_path_cache_lookup_path(
+     mount_path_cache_t *path_cache,
+     const system_character_t *path,
+     libcerror_error_t **error )
+{
+	mount_path_cache_entry_t *entry = NULL;
+	int result                      = 0;
+
+	result = mount_path_cache_get_entry_by_path(
+	          path_cache,
+	          path,
+	          system_string_length( path ),
+	          &entry,
+	          error );
+
+	if( result == 1 )
+	{
+		if( mount_path_cache_release_entry(
+		     path_cache,
+		     &entry,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Tests the mount_path_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mount_path_cache_initialize(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	mount_path_cache_t *path_cache = NULL;
+	int result                     = 0;
+
+	result = mount_path_cache_initialize(
+	          &path_cache,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "path_cache",
+	 path_cache );
+
+	result = mount_path_cache_free(
+	          &path_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = mount_path_cache_initialize(
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_free(
+	 &error );
+
+	result = mount_path_cache_initialize(
+	          &path_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_cache != NULL )
+	{
+		mount_path_cache_free(
+		 &path_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_path_cache_insert_entry function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mount_path_cache_insert_entry(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libewf_file_entry_t *file_entry          = NULL;
+	mount_path_cache_entry_t *entry          = NULL;
+	mount_path_cache_entry_t *inserted_entry = NULL;
+	mount_path_cache_t *path_cache           = NULL;
+	int result                               = 0;
+
+	result = mount_path_cache_initialize(
+	          &path_cache,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_mount_path_cache_insert_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/a/b" ),
+	          &inserted_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "inserted_entry->number_of_references",
+	 inserted_entry->number_of_references,
+	 1 );
+
+	/* Test inserting a path that is already cached, the cached entry is
+	 * returned and the file entry is freed
+	 */
+	result = libewf_file_entry_initialize(
+	          &file_entry,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = mount_path_cache_insert_entry(
+	          path_cache,
+	          _SYSTEM_STRING( "/a/b" ),
+	          4,
+	          &file_entry,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_entry",
+	 file_entry );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "entry",
+	 (int) ( entry == inserted_entry ),
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "entry->number_of_references",
+	 entry->number_of_references,
+	 2 );
+
+	result = mount_path_cache_release_entry(
+	          path_cache,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = mount_path_cache_release_entry(
+	          path_cache,
+	          &inserted_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test that a released entry remains cached
+	 */
+	result = ewf_test_mount_path_cache_lookup_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/a/b" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test that a prefix of a cached path is not found
+	 */
+	result = ewf_test_mount_path_cache_lookup_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/a" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = mount_path_cache_free(
+	          &path_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_entry != NULL )
+	{
+		libewf_file_entry_free(
+		 &file_entry,
+		 NULL );
+	}
+	if( path_cache != NULL )
+	{
+		mount_path_cache_free(
+		 &path_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that the least recently used entries are evicted
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mount_path_cache_evict(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	mount_path_cache_entry_t *entry = NULL;
+	mount_path_cache_t *path_cache  = NULL;
+	int result                      = 0;
+
+	result = mount_path_cache_initialize(
+	          &path_cache,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_mount_path_cache_insert_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/a" ),
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = mount_path_cache_release_entry(
+	          path_cache,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_mount_path_cache_insert_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/b" ),
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = mount_path_cache_release_entry(
+	          path_cache,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test that a lookup makes "/a" the most recently used entry
+	 */
+	result = ewf_test_mount_path_cache_lookup_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/a" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_mount_path_cache_insert_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/c" ),
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = mount_path_cache_release_entry(
+	          path_cache,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_mount_path_cache_lookup_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/b" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_mount_path_cache_lookup_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/a" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_mount_path_cache_lookup_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/c" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	result = mount_path_cache_free(
+	          &path_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( path_cache != NULL )
+	{
+		mount_path_cache_free(
+		 &path_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that an evicted entry remains valid while it is referenced
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_mount_path_cache_evict_referenced(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	mount_path_cache_entry_t *entry            = NULL;
+	mount_path_cache_entry_t *referenced_entry = NULL;
+	mount_path_cache_t *path_cache             = NULL;
+	int result                                 = 0;
+
+	result = mount_path_cache_initialize(
+	          &path_cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_mount_path_cache_insert_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/a" ),
+	          &referenced_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_mount_path_cache_insert_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/b" ),
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = mount_path_cache_release_entry(
+	          path_cache,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "referenced_entry->is_cached",
+	 (int) referenced_entry->is_cached,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "referenced_entry->file_entry",
+	 referenced_entry->file_entry );
+
+	result = ewf_test_mount_path_cache_lookup_path(
+	          path_cache,
+	          _SYSTEM_STRING( "/a" ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The entry is freed when its last reference is released
+	 */
+	result = mount_path_cache_release_entry(
+	          path_cache,
+	          &referenced_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "referenced_entry",
+	 referenced_entry );
+
+	/* Clean up
+	 */
+	result = mount_path_cache_free(
+	          &path_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( referenced_entry != NULL )
+	{
+		mount_path_cache_release_entry(
+		 path_cache,
+		 &referenced_entry,
+		 NULL );
+	}
+	if( path_cache != NULL )
+	{
+		mount_path_cache_free(
+		 &path_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "mount_path_cache_initialize",
+	 ewf_test_mount_path_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "mount_path_cache_insert_entry",
+	 ewf_test_mount_path_cache_insert_entry );
+
+	EWF_TEST_RUN(
+	 "mount_path_cache evict",
+	 ewf_test_mount_path_cache_evict );
+
+	EWF_TEST_RUN(
+	 "mount_path_cache evict referenced",
+	 ewf_test_mount_path_cache_evict_referenced );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,417 @@
+/*
+ * Library read-ahead testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <libewf.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_READ_AHEAD_CHUNK_SIZE		EWF_TEST_IMAGE_CHUNK_SIZE
+#define EWF_TEST_READ_AHEAD_MEDIA_SIZE		( 8 * 1024 * 1024 )
+#define EWF_TEST_READ_AHEAD_SEGMENT_SIZE	( 3 * 1024 * 1024 )
+
+/* The number of chunks in the media
+ */
+#define EWF_TEST_READ_AHEAD_NUMBER_OF_CHUNKS	( EWF_TEST_READ_AHEAD_MEDIA_SIZE / EWF_TEST_READ_AHEAD_CHUNK_SIZE )
+
+/* The chunk after which the last segment file is truncated
+ */
+#define EWF_TEST_READ_AHEAD_LAST_CHUNK		( EWF_TEST_READ_AHEAD_NUMBER_OF_CHUNKS - 16 )
+
+/* The chunk where the sequential reads start, it is stored in the last segment file
+ */
+#define EWF_TEST_READ_AHEAD_FIRST_CHUNK		( EWF_TEST_READ_AHEAD_LAST_CHUNK - 16 )
+
+/* Truncates a segment file directly after the data of a chunk
+ * The chunk data is stored uncompressed and followed by a 4-byte checksum
+ * Returns 1 if successful, 0 if the chunk is not stored in the segment file or -1 on error
+ */
+int ewf_test_read_ahead_truncate_after_chunk(
+     const char *filename,
+     uint64_t chunk_index )
+{
+	uint8_t chunk_data[ EWF_TEST_READ_AHEAD_CHUNK_SIZE ];
+
+	uint8_t *segment_data = NULL;
+	FILE *file_stream     = NULL;
+	size_t read_count     = 0;
+	size_t segment_offset = 0;
+	int result            = 0;
+
+	segment_data = (uint8_t *) malloc(
+	                            2 * EWF_TEST_READ_AHEAD_SEGMENT_SIZE );
+
+	if( segment_data == NULL )
+	{
+		return( -1 );
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               "rb" );
+
+	if( file_stream == NULL )
+	{
+		free(
+		 segment_data );
+
+		return( -1 );
+	}
+	read_count = file_stream_read(
+	              file_stream,
+	              segment_data,
+	              2 * EWF_TEST_READ_AHEAD_SEGMENT_SIZE );
+
+	file_stream_close(
+	 file_stream );
+
+	ewf_test_image_fill_buffer(
+	 chunk_data,
+	 EWF_TEST_READ_AHEAD_CHUNK_SIZE,
+	 (off64_t) ( chunk_index * EWF_TEST_READ_AHEAD_CHUNK_SIZE ),
+	 EWF_TEST_IMAGE_DATA_TYPE_RANDOM );
+
+	for( segment_offset = 0;
+	     ( segment_offset + EWF_TEST_READ_AHEAD_CHUNK_SIZE ) <= read_count;
+	     segment_offset++ )
+	{
+		if( memory_compare(
+		     &( segment_data[ segment_offset ] ),
+		     chunk_data,
+		     EWF_TEST_READ_AHEAD_CHUNK_SIZE ) == 0 )
+		{
+			result = 1;
+
+			break;
+		}
+	}
+	free(
+	 segment_data );
+
+	if( result != 1 )
+	{
+		return( 0 );
+	}
+	if( truncate(
+	     filename,
+	     (off_t) ( segment_offset + EWF_TEST_READ_AHEAD_CHUNK_SIZE + 4 ) ) != 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests sequential reads with read-ahead up to the last chunk of a truncated segment file
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_ahead_truncated_segment_file(
+     void )
+{
+	uint8_t expected_data[ EWF_TEST_READ_AHEAD_CHUNK_SIZE ];
+	uint8_t data[ EWF_TEST_READ_AHEAD_CHUNK_SIZE ];
+	char basename[ 64 ];
+	char directory[ 32 ] = "/tmp/ewf_test_XXXXXX";
+
+	libewf_error_t *error     = NULL;
+	libewf_handle_t *handle   = NULL;
+	char **filenames          = NULL;
+	off64_t offset            = 0;
+	uint64_t chunk_index      = 0;
+	ssize_t read_count        = 0;
+	int filename_index        = 0;
+	int number_of_filenames   = 0;
+	int result                = 0;
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory",
+	 mkdtemp( directory ) );
+
+	snprintf(
+	 basename,
+	 64,
+	 "%s/test",
+	 directory );
+
+	result = ewf_test_image_create(
+	          basename,
+	          EWF_TEST_READ_AHEAD_MEDIA_SIZE,
+	          EWF_TEST_READ_AHEAD_SEGMENT_SIZE,
+	          LIBEWF_COMPRESSION_NONE,
+	          EWF_TEST_IMAGE_DATA_TYPE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	narrow_string_copy(
+	 &( basename[ narrow_string_length( basename ) ] ),
+	 ".E01",
+	 5 );
+
+	result = libewf_glob(
+	          basename,
+	          narrow_string_length( basename ),
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_filenames",
+	 number_of_filenames,
+	 3 );
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_set_number_of_threads(
+	          handle,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_set_read_ahead(
+	          handle,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_open(
+	          handle,
+	          filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( EWF_TEST_READ_AHEAD_FIRST_CHUNK * EWF_TEST_READ_AHEAD_CHUNK_SIZE ),
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( EWF_TEST_READ_AHEAD_FIRST_CHUNK * EWF_TEST_READ_AHEAD_CHUNK_SIZE ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The first read loads the chunk table of the last segment file
+	 * and does not read ahead since the access pattern is not yet sequential
+	 */
+	for( chunk_index = EWF_TEST_READ_AHEAD_FIRST_CHUNK;
+	     chunk_index <= EWF_TEST_READ_AHEAD_LAST_CHUNK;
+	     chunk_index++ )
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              data,
+		              EWF_TEST_READ_AHEAD_CHUNK_SIZE,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) EWF_TEST_READ_AHEAD_CHUNK_SIZE );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		ewf_test_image_fill_buffer(
+		 expected_data,
+		 EWF_TEST_READ_AHEAD_CHUNK_SIZE,
+		 (off64_t) ( chunk_index * EWF_TEST_READ_AHEAD_CHUNK_SIZE ),
+		 EWF_TEST_IMAGE_DATA_TYPE_RANDOM );
+
+		result = memory_compare(
+		          data,
+		          expected_data,
+		          EWF_TEST_READ_AHEAD_CHUNK_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Truncate the last segment file directly after the last chunk read
+		 * so that the chunks read ahead beyond it are short reads
+		 */
+		if( chunk_index == EWF_TEST_READ_AHEAD_FIRST_CHUNK )
+		{
+			result = ewf_test_read_ahead_truncate_after_chunk(
+			          filenames[ number_of_filenames - 1 ],
+			          EWF_TEST_READ_AHEAD_LAST_CHUNK );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+	}
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( filename_index = 0;
+	     filename_index < number_of_filenames;
+	     filename_index++ )
+	{
+		unlink(
+		 filenames[ filename_index ] );
+	}
+	rmdir(
+	 directory );
+
+	result = libewf_glob_free(
+	          filenames,
+	          number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+		for( filename_index = 0;
+		     filename_index < number_of_filenames;
+		     filename_index++ )
+		{
+			unlink(
+			 filenames[ filename_index ] );
+		}
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	rmdir(
+	 directory );
+
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_handle_read_buffer with a truncated segment file",
+	 ewf_test_read_ahead_truncated_segment_file );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
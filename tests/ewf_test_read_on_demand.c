@@ -0,0 +1,351 @@
+/*
+ * Segment files read on demand testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <libewf.h>
+
+#include "ewf_test_image.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+/* The image consists of multiple segment files
+ */
+#define EWF_TEST_READ_ON_DEMAND_MEDIA_SIZE	( ( 6 * 1024 * 1024 ) + ( 3 * 512 ) )
+#define EWF_TEST_READ_ON_DEMAND_SEGMENT_SIZE	( 1024 * 1024 )
+
+/* Reads data at a specific offset and compares it with the data of the test image
+ * Returns 1 if the data matches, 0 if not or -1 on error
+ */
+int ewf_test_read_on_demand_compare_at_offset(
+     libewf_handle_t *handle,
+     uint8_t *buffer,
+     uint8_t *expected_buffer,
+     size_t size,
+     off64_t offset,
+     libewf_error_t **error )
+{
+	ssize_t read_count = 0;
+
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		return( -1 );
+	}
+	ewf_test_image_fill_buffer(
+	 expected_buffer,
+	 size,
+	 offset,
+	 EWF_TEST_IMAGE_DATA_TYPE_RANDOM );
+
+	if( memory_compare(
+	     buffer,
+	     expected_buffer,
+	     size ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests reading an image of which the segment files are read on demand
+ * The data of a segment near the end is read before the data of the segments preceding it
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_read_on_demand_round_trip(
+     void )
+{
+	uint8_t buffer[ EWF_TEST_IMAGE_CHUNK_SIZE ];
+	uint8_t expected_buffer[ EWF_TEST_IMAGE_CHUNK_SIZE ];
+	char basename[ 64 ];
+	char directory[ 32 ] = "/tmp/ewf_test_XXXXXX";
+
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	char **filenames        = NULL;
+	size64_t media_size     = 0;
+	off64_t offset          = 0;
+	int number_of_filenames = 0;
+	int result              = 0;
+
+	basename[ 0 ] = 0;
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "directory",
+	 mkdtemp( directory ) );
+
+	snprintf(
+	 basename,
+	 64,
+	 "%s/image",
+	 directory );
+
+	result = ewf_test_image_create(
+	          basename,
+	          EWF_TEST_READ_ON_DEMAND_MEDIA_SIZE,
+	          EWF_TEST_READ_ON_DEMAND_SEGMENT_SIZE,
+	          LIBEWF_COMPRESSION_FAST,
+	          EWF_TEST_IMAGE_DATA_TYPE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	narrow_string_copy(
+	 &( basename[ narrow_string_length( basename ) ] ),
+	 ".E01",
+	 5 );
+
+	result = libewf_glob(
+	          basename,
+	          narrow_string_length( basename ),
+	          LIBEWF_FORMAT_UNKNOWN,
+	          &filenames,
+	          &number_of_filenames,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_filenames",
+	 number_of_filenames,
+	 4 );
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_set_read_segment_files_on_demand(
+	          handle,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_open(
+	          handle,
+	          filenames,
+	          number_of_filenames,
+	          LIBEWF_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "media_size",
+	 (int64_t) media_size,
+	 (int64_t) EWF_TEST_READ_ON_DEMAND_MEDIA_SIZE );
+
+	/* Read a chunk in one of the last segments, which maps the segments preceding it
+	 */
+	offset = (off64_t) ( EWF_TEST_READ_ON_DEMAND_MEDIA_SIZE - ( 3 * EWF_TEST_READ_ON_DEMAND_SEGMENT_SIZE / 2 ) );
+	offset = ( offset / EWF_TEST_IMAGE_CHUNK_SIZE ) * EWF_TEST_IMAGE_CHUNK_SIZE;
+
+	result = ewf_test_read_on_demand_compare_at_offset(
+	          handle,
+	          buffer,
+	          expected_buffer,
+	          EWF_TEST_IMAGE_CHUNK_SIZE,
+	          offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Read the last bytes, which are stored in the last segment
+	 */
+	result = ewf_test_read_on_demand_compare_at_offset(
+	          handle,
+	          buffer,
+	          expected_buffer,
+	          512,
+	          (off64_t) ( EWF_TEST_READ_ON_DEMAND_MEDIA_SIZE - 512 ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Read a chunk in one of the first segments, which were mapped but not read
+	 */
+	result = ewf_test_read_on_demand_compare_at_offset(
+	          handle,
+	          buffer,
+	          expected_buffer,
+	          EWF_TEST_IMAGE_CHUNK_SIZE,
+	          (off64_t) ( EWF_TEST_READ_ON_DEMAND_SEGMENT_SIZE + EWF_TEST_IMAGE_CHUNK_SIZE ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_image_compare(
+	          handle,
+	          EWF_TEST_READ_ON_DEMAND_MEDIA_SIZE,
+	          EWF_TEST_IMAGE_CHUNK_SIZE,
+	          EWF_TEST_IMAGE_DATA_TYPE_RANDOM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_handle_segment_files_corrupted(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	libewf_glob_free(
+	 filenames,
+	 number_of_filenames,
+	 NULL );
+
+	ewf_test_image_remove(
+	 basename );
+
+	rmdir(
+	 directory );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+	}
+	if( basename[ 0 ] != 0 )
+	{
+		ewf_test_image_remove(
+		 basename );
+	}
+	rmdir(
+	 directory );
+
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_handle_set_read_segment_files_on_demand",
+	 ewf_test_read_on_demand_round_trip );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
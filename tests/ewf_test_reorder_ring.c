@@ -0,0 +1,613 @@
+/*
+ * Tests the ordering of the storage media buffer reorder ring
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libcthreads_thread.h>
+
+#include <libcerror_error.h>
+
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_reorder_ring.h"
+
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_REORDER_RING_NUMBER_OF_BUFFERS	1024
+#define EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS	4
+#define EWF_TEST_REORDER_RING_NUMBER_OF_THREADS	3
+
+typedef struct ewf_test_reorder_ring_thread_values ewf_test_reorder_ring_thread_values_t;
+
+struct ewf_test_reorder_ring_thread_values
+{
+	/* The reorder ring
+	 */
+	storage_media_buffer_reorder_ring_t *reorder_ring;
+
+	/* The buffers
+	 */
+	storage_media_buffer_t **buffers;
+
+	/* The index of the first buffer the thread inserts
+	 */
+	int first_buffer_index;
+
+	/* Value to indicate an error occurred
+	 */
+	int has_error;
+};
+
+/* Inserts every number of threads-th buffer, starting at the first buffer index
+ * The threads run concurrently hence the buffers are inserted out of order
+ * Returns 1
+ */
+int ewf_test_reorder_ring_insert_callback(
+     ewf_test_reorder_ring_thread_values_t *thread_values )
+{
+	int buffer_index = 0;
+
+	for( buffer_index = thread_values->first_buffer_index;
+	     buffer_index < EWF_TEST_REORDER_RING_NUMBER_OF_BUFFERS;
+	     buffer_index += EWF_TEST_REORDER_RING_NUMBER_OF_THREADS )
+	{
+		if( storage_media_buffer_reorder_ring_insert(
+		     thread_values->reorder_ring,
+		     thread_values->buffers[ buffer_index ],
+		     NULL ) != 1 )
+		{
+			thread_values->has_error = 1;
+
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Creates buffers and assigns them consecutive sequence numbers
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_reorder_ring_create_buffers(
+     storage_media_buffer_reorder_ring_t *reorder_ring,
+     storage_media_buffer_t **buffers,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	int buffer_index = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ] = NULL;
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( storage_media_buffer_initialize(
+		     &( buffers[ buffer_index ] ),
+		     NULL,
+		     STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+		     0,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		if( storage_media_buffer_reorder_ring_set_sequence_number(
+		     reorder_ring,
+		     buffers[ buffer_index ],
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Frees the buffers
+ */
+void ewf_test_reorder_ring_free_buffers(
+     storage_media_buffer_t **buffers,
+     int number_of_buffers )
+{
+	int buffer_index = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( buffers[ buffer_index ] != NULL )
+		{
+			storage_media_buffer_free(
+			 &( buffers[ buffer_index ] ),
+			 NULL );
+		}
+	}
+}
+
+/* Tests if buffers that are inserted out of order are popped in sequence order
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_reorder_ring_insert_out_of_order(
+     void )
+{
+	storage_media_buffer_t *buffers[ EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS ];
+	int insert_order[ EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS ] = { 2, 0, 3, 1 };
+
+	libcerror_error_t *error                                  = NULL;
+	storage_media_buffer_reorder_ring_t *reorder_ring         = NULL;
+	storage_media_buffer_t *storage_media_buffer              = NULL;
+	int buffer_index                                          = 0;
+	int result                                                = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ] = NULL;
+	}
+	result = storage_media_buffer_reorder_ring_initialize(
+	          &reorder_ring,
+	          EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_reorder_ring_create_buffers(
+	          reorder_ring,
+	          buffers,
+	          EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_reorder_ring_insert(
+		          reorder_ring,
+		          buffers[ insert_order[ buffer_index ] ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* A buffer with a sequence number that is already in the ring is rejected
+	 */
+	result = storage_media_buffer_reorder_ring_insert(
+	          reorder_ring,
+	          buffers[ 1 ],
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_free(
+	 &error );
+
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_reorder_ring_pop(
+		          reorder_ring,
+		          &storage_media_buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "storage_media_buffer->sequence_number",
+		 (int) storage_media_buffer->sequence_number,
+		 buffer_index );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "storage_media_buffer == buffers[ buffer_index ]",
+		 (int) ( storage_media_buffer == buffers[ buffer_index ] ),
+		 1 );
+	}
+	/* A buffer with a sequence number that was already output is rejected
+	 */
+	result = storage_media_buffer_reorder_ring_insert(
+	          reorder_ring,
+	          buffers[ 0 ],
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_free(
+	 &error );
+
+	result = storage_media_buffer_reorder_ring_close(
+	          reorder_ring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = storage_media_buffer_reorder_ring_pop(
+	          reorder_ring,
+	          &storage_media_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = storage_media_buffer_reorder_ring_free(
+	          &reorder_ring,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	ewf_test_reorder_ring_free_buffers(
+	 buffers,
+	 EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( reorder_ring != NULL )
+	{
+		storage_media_buffer_reorder_ring_free(
+		 &reorder_ring,
+		 NULL,
+		 NULL );
+	}
+	ewf_test_reorder_ring_free_buffers(
+	 buffers,
+	 EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS );
+
+	return( 0 );
+}
+
+/* Tests if buffers that are inserted by concurrent threads are popped in sequence order
+ * The ring is smaller than the number of buffers hence the threads have to wait for the output
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_reorder_ring_insert_concurrent(
+     void )
+{
+	ewf_test_reorder_ring_thread_values_t thread_values[ EWF_TEST_REORDER_RING_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ EWF_TEST_REORDER_RING_NUMBER_OF_THREADS ];
+	storage_media_buffer_t *buffers[ EWF_TEST_REORDER_RING_NUMBER_OF_BUFFERS ];
+
+	libcerror_error_t *error                          = NULL;
+	storage_media_buffer_reorder_ring_t *reorder_ring = NULL;
+	storage_media_buffer_t *storage_media_buffer      = NULL;
+	int buffer_index                                  = 0;
+	int result                                        = 0;
+	int thread_index                                  = 0;
+
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_REORDER_RING_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_REORDER_RING_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ] = NULL;
+	}
+	result = storage_media_buffer_reorder_ring_initialize(
+	          &reorder_ring,
+	          EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_reorder_ring_create_buffers(
+	          reorder_ring,
+	          buffers,
+	          EWF_TEST_REORDER_RING_NUMBER_OF_BUFFERS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The threads are created in reverse order so that the buffers
+	 * with the lowest sequence numbers tend to be inserted last
+	 */
+	for( thread_index = EWF_TEST_REORDER_RING_NUMBER_OF_THREADS - 1;
+	     thread_index >= 0;
+	     thread_index-- )
+	{
+		thread_values[ thread_index ].reorder_ring       = reorder_ring;
+		thread_values[ thread_index ].buffers            = buffers;
+		thread_values[ thread_index ].first_buffer_index = thread_index;
+		thread_values[ thread_index ].has_error          = 0;
+
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          (int (*)(void *)) &ewf_test_reorder_ring_insert_callback,
+		          (void *) &( thread_values[ thread_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < EWF_TEST_REORDER_RING_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_reorder_ring_pop(
+		          reorder_ring,
+		          &storage_media_buffer,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "storage_media_buffer->sequence_number",
+		 (int) storage_media_buffer->sequence_number,
+		 buffer_index );
+	}
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_REORDER_RING_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "has_error",
+		 thread_values[ thread_index ].has_error,
+		 0 );
+	}
+	result = storage_media_buffer_reorder_ring_free(
+	          &reorder_ring,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	ewf_test_reorder_ring_free_buffers(
+	 buffers,
+	 EWF_TEST_REORDER_RING_NUMBER_OF_BUFFERS );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( reorder_ring != NULL )
+	{
+		/* Closing the ring makes the inserts that wait for the output fail
+		 */
+		storage_media_buffer_reorder_ring_close(
+		 reorder_ring,
+		 NULL );
+	}
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_REORDER_RING_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( reorder_ring != NULL )
+	{
+		/* The buffers remaining in the ring are freed with the buffers array
+		 */
+		for( buffer_index = 0;
+		     buffer_index < reorder_ring->number_of_slots;
+		     buffer_index++ )
+		{
+			reorder_ring->buffers_array[ buffer_index ] = NULL;
+		}
+		storage_media_buffer_reorder_ring_free(
+		 &reorder_ring,
+		 NULL,
+		 NULL );
+	}
+	ewf_test_reorder_ring_free_buffers(
+	 buffers,
+	 EWF_TEST_REORDER_RING_NUMBER_OF_BUFFERS );
+
+	return( 0 );
+}
+
+/* Tests if the buffers that were not output are freed with the ring
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_reorder_ring_free_pending(
+     void )
+{
+	storage_media_buffer_t *buffers[ 2 ];
+
+	libcerror_error_t *error                          = NULL;
+	storage_media_buffer_reorder_ring_t *reorder_ring = NULL;
+	int result                                        = 0;
+
+	buffers[ 0 ] = NULL;
+	buffers[ 1 ] = NULL;
+
+	result = storage_media_buffer_reorder_ring_initialize(
+	          &reorder_ring,
+	          EWF_TEST_REORDER_RING_NUMBER_OF_SLOTS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_reorder_ring_create_buffers(
+	          reorder_ring,
+	          buffers,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The second buffer is inserted and never output since the first buffer is missing
+	 */
+	result = storage_media_buffer_reorder_ring_insert(
+	          reorder_ring,
+	          buffers[ 1 ],
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	buffers[ 1 ] = NULL;
+
+	result = storage_media_buffer_reorder_ring_free(
+	          &reorder_ring,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	ewf_test_reorder_ring_free_buffers(
+	 buffers,
+	 2 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( reorder_ring != NULL )
+	{
+		storage_media_buffer_reorder_ring_free(
+		 &reorder_ring,
+		 NULL,
+		 NULL );
+	}
+	ewf_test_reorder_ring_free_buffers(
+	 buffers,
+	 2 );
+
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_reorder_ring_insert out of order",
+	 ewf_test_reorder_ring_insert_out_of_order );
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_reorder_ring_insert concurrent",
+	 ewf_test_reorder_ring_insert_concurrent );
+
+	EWF_TEST_RUN(
+	 "storage_media_buffer_reorder_ring_free with pending buffers",
+	 ewf_test_reorder_ring_free_pending );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
@@ -0,0 +1,539 @@
+/*
+ * Tests the sorted push of the libcthreads queue ring
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libcthreads_definitions.h>
+#include <libcthreads_ring.h>
+#include <libcthreads_thread.h>
+
+#include <libcerror_error.h>
+
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_RING_NUMBER_OF_VALUES	100000
+
+typedef struct ewf_test_ring_thread_values ewf_test_ring_thread_values_t;
+
+struct ewf_test_ring_thread_values
+{
+	/* The ring
+	 */
+	libcthreads_ring_t *ring;
+
+	/* The number of values that were popped in ascending order
+	 */
+	int number_of_sorted_values;
+
+	/* Value to indicate an error occurred
+	 */
+	int has_error;
+};
+
+/* Compares two values
+ * Returns LIBCTHREADS_COMPARE_LESS, LIBCTHREADS_COMPARE_EQUAL or LIBCTHREADS_COMPARE_GREATER
+ */
+int ewf_test_ring_value_compare(
+     intptr_t *first_value,
+     intptr_t *second_value,
+     libcerror_error_t **error EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( error )
+
+	if( (intptr_t) first_value < (intptr_t) second_value )
+	{
+		return( LIBCTHREADS_COMPARE_LESS );
+	}
+	else if( (intptr_t) first_value > (intptr_t) second_value )
+	{
+		return( LIBCTHREADS_COMPARE_GREATER );
+	}
+	return( LIBCTHREADS_COMPARE_EQUAL );
+}
+
+/* Pushes ascending values onto the ring in sorted order
+ * Returns 1
+ */
+int ewf_test_ring_push_sorted_callback(
+     ewf_test_ring_thread_values_t *thread_values )
+{
+	intptr_t value = 0;
+
+	for( value = 1;
+	     value <= EWF_TEST_RING_NUMBER_OF_VALUES;
+	     value++ )
+	{
+		if( libcthreads_ring_push_sorted(
+		     thread_values->ring,
+		     (intptr_t *) value,
+		     &ewf_test_ring_value_compare,
+		     0,
+		     NULL ) != 1 )
+		{
+			thread_values->has_error = 1;
+
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Pops values off the ring and counts the values that were popped in ascending order
+ * Returns 1
+ */
+int ewf_test_ring_pop_callback(
+     ewf_test_ring_thread_values_t *thread_values )
+{
+	intptr_t *value         = NULL;
+	intptr_t previous_value = 0;
+	int value_index         = 0;
+
+	for( value_index = 0;
+	     value_index < EWF_TEST_RING_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		if( libcthreads_ring_pop(
+		     thread_values->ring,
+		     &value,
+		     NULL ) != 1 )
+		{
+			thread_values->has_error = 1;
+
+			break;
+		}
+		if( (intptr_t) value > previous_value )
+		{
+			thread_values->number_of_sorted_values++;
+		}
+		previous_value = (intptr_t) value;
+	}
+	return( 1 );
+}
+
+/* Tests the sorted push and if mixing it with an unsorted push is rejected
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_ring_push_sorted(
+     int use_mutex )
+{
+	intptr_t expected_values[ 5 ] = { 1, 2, 3, 5, 7 };
+	intptr_t values[ 5 ]          = { 5, 2, 7, 1, 3 };
+
+	libcerror_error_t *error      = NULL;
+	libcthreads_ring_t *ring      = NULL;
+	intptr_t *value               = NULL;
+	int result                    = 0;
+	int value_index               = 0;
+
+	result = libcthreads_ring_initialize(
+	          &ring,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_ring_set_use_mutex(
+	          ring,
+	          use_mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		result = libcthreads_ring_push_sorted(
+		          ring,
+		          (intptr_t *) values[ value_index ],
+		          &ewf_test_ring_value_compare,
+		          LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	result = libcthreads_ring_push_sorted(
+	          ring,
+	          (intptr_t *) 3,
+	          &ewf_test_ring_value_compare,
+	          LIBCTHREADS_SORT_FLAG_UNIQUE_VALUES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* The mode of the ring cannot be changed after values were pushed
+	 */
+	result = libcthreads_ring_set_use_mutex(
+	          ring,
+	          use_mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	libcerror_error_free(
+	 &error );
+
+	/* An unsorted push can push its value between the values that
+	 * a concurrent sorted push pushes back on a lock-free ring
+	 */
+	result = libcthreads_ring_try_push(
+	          ring,
+	          (intptr_t *) 9,
+	          &error );
+
+	if( use_mutex == 0 )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		libcerror_error_free(
+		 &error );
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	for( value_index = 0;
+	     value_index < 5;
+	     value_index++ )
+	{
+		result = libcthreads_ring_try_pop(
+		          ring,
+		          &value,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "value",
+		 (int) (intptr_t) value,
+		 (int) expected_values[ value_index ] );
+	}
+	result = libcthreads_ring_try_pop(
+	          ring,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 use_mutex );
+
+	result = libcthreads_ring_free(
+	          &ring,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A sorted push is rejected after an unsorted push on a lock-free ring
+	 */
+	result = libcthreads_ring_initialize(
+	          &ring,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_ring_set_use_mutex(
+	          ring,
+	          use_mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_ring_push(
+	          ring,
+	          (intptr_t *) 2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_ring_push_sorted(
+	          ring,
+	          (intptr_t *) 1,
+	          &ewf_test_ring_value_compare,
+	          0,
+	          &error );
+
+	if( use_mutex == 0 )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		libcerror_error_free(
+		 &error );
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	result = libcthreads_ring_free(
+	          &ring,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( ring != NULL )
+	{
+		libcthreads_ring_free(
+		 &ring,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the sorted push with a lock-free ring
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_ring_push_sorted_lock_free(
+     void )
+{
+	return( ewf_test_ring_push_sorted(
+	         0 ) );
+}
+
+/* Tests the sorted push with a ring that uses the mutex
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_ring_push_sorted_mutex(
+     void )
+{
+	return( ewf_test_ring_push_sorted(
+	         1 ) );
+}
+
+/* Tests if values pushed in sorted order by one thread are popped in order by another
+ * while the sorted push drains the ring and pushes the values back
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_ring_push_sorted_concurrent_pop(
+     void )
+{
+	ewf_test_ring_thread_values_t thread_values;
+
+	libcerror_error_t *error               = NULL;
+	libcthreads_ring_t *ring               = NULL;
+	libcthreads_thread_t *pop_thread       = NULL;
+	libcthreads_thread_t *push_thread      = NULL;
+	int result                             = 0;
+
+	result = libcthreads_ring_initialize(
+	          &ring,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	thread_values.ring                    = ring;
+	thread_values.number_of_sorted_values = 0;
+	thread_values.has_error               = 0;
+
+	result = libcthreads_thread_create(
+	          &pop_thread,
+	          NULL,
+	          (int (*)(void *)) &ewf_test_ring_pop_callback,
+	          (void *) &thread_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_thread_create(
+	          &push_thread,
+	          NULL,
+	          (int (*)(void *)) &ewf_test_ring_push_sorted_callback,
+	          (void *) &thread_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_thread_join(
+	          &push_thread,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_thread_join(
+	          &pop_thread,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "has_error",
+	 thread_values.has_error,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sorted_values",
+	 thread_values.number_of_sorted_values,
+	 EWF_TEST_RING_NUMBER_OF_VALUES );
+
+	result = libcthreads_ring_free(
+	          &ring,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( push_thread != NULL )
+	{
+		libcthreads_thread_join(
+		 &push_thread,
+		 NULL );
+	}
+	if( pop_thread != NULL )
+	{
+		libcthreads_ring_close(
+		 ring,
+		 NULL );
+		libcthreads_thread_join(
+		 &pop_thread,
+		 NULL );
+	}
+	if( ring != NULL )
+	{
+		libcthreads_ring_free(
+		 &ring,
+		 NULL,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libcthreads_ring_push_sorted lock-free",
+	 ewf_test_ring_push_sorted_lock_free );
+
+	EWF_TEST_RUN(
+	 "libcthreads_ring_push_sorted with mutex",
+	 ewf_test_ring_push_sorted_mutex );
+
+	EWF_TEST_RUN(
+	 "libcthreads_ring_push_sorted with concurrent pop",
+	 ewf_test_ring_push_sorted_concurrent_pop );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
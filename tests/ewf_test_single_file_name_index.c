@@ -0,0 +1,997 @@
+/*
+ * Single file name index testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libcthreads_thread.h>
+
+#include <libcerror_error.h>
+
+#include "../libewf/libewf_single_file_entry.h"
+#include "../libewf/libewf_single_file_name_index.h"
+#include "../libewf/libewf_single_file_tree.h"
+
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_FILES		1000
+#define EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_THREADS	4
+
+/* The sub nodes of the tree, the files are followed by:
+ * a name with a character outside the ASCII range,
+ * a name with a character outside the basic multilingual plane,
+ * a sub node without a name and a sub node with the name of the 8th file
+ */
+#define EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_SUB_NODES	EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_FILES + 4
+
+/* "café" */
+static uint8_t ewf_test_single_file_name_index_utf8_cafe[ 6 ] = {
+	'c', 'a', 'f', 0xc3, 0xa9, 0 };
+
+static uint16_t ewf_test_single_file_name_index_utf16_cafe[ 5 ] = {
+	'c', 'a', 'f', 0x00e9, 0 };
+
+/* "U+1F600.txt" */
+static uint8_t ewf_test_single_file_name_index_utf8_smiley[ 9 ] = {
+	0xf0, 0x9f, 0x98, 0x80, '.', 't', 'x', 't', 0 };
+
+static uint16_t ewf_test_single_file_name_index_utf16_smiley[ 7 ] = {
+	0xd83d, 0xde00, '.', 't', 'x', 't', 0 };
+
+typedef struct ewf_test_single_file_name_index_thread_values ewf_test_single_file_name_index_thread_values_t;
+
+struct ewf_test_single_file_name_index_thread_values
+{
+	/* The name index
+	 */
+	libewf_single_file_name_index_t *name_index;
+
+	/* The sub nodes
+	 */
+	libcdata_tree_node_t **sub_nodes;
+
+	/* Value to indicate an error occurred
+	 */
+	int has_error;
+};
+
+/* Appends a sub node with a single file entry to a tree node
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_file_name_index_append_sub_node(
+     libcdata_tree_node_t *node,
+     const uint8_t *name,
+     size_t name_size,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *safe_sub_node           = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+
+	if( libewf_single_file_entry_initialize(
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( name != NULL )
+	{
+		single_file_entry->name = (uint8_t *) memory_allocate(
+		                                       sizeof( uint8_t ) * name_size );
+
+		if( single_file_entry->name == NULL )
+		{
+			goto on_error;
+		}
+		if( memory_copy(
+		     single_file_entry->name,
+		     name,
+		     name_size ) == NULL )
+		{
+			goto on_error;
+		}
+		single_file_entry->name_size = name_size;
+	}
+	if( libcdata_tree_node_initialize(
+	     &safe_sub_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     safe_sub_node,
+	     (intptr_t *) single_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	single_file_entry = NULL;
+
+	if( libcdata_tree_node_append_node(
+	     node,
+	     safe_sub_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	*sub_node = safe_sub_node;
+
+	return( 1 );
+
+on_error:
+	if( safe_sub_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &safe_sub_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates a tree of which the root node contains the test sub nodes
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_file_name_index_create_tree(
+     libcdata_tree_node_t **root_node,
+     libcdata_tree_node_t **sub_nodes,
+     libcerror_error_t **error )
+{
+	char name[ 16 ];
+
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	int file_index                                = 0;
+
+	if( libewf_single_file_entry_initialize(
+	     &single_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcdata_tree_node_initialize(
+	     root_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     *root_node,
+	     (intptr_t *) single_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	single_file_entry = NULL;
+
+	for( file_index = 0;
+	     file_index < EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_FILES;
+	     file_index++ )
+	{
+		snprintf(
+		 name,
+		 16,
+		 "file%04d",
+		 file_index );
+
+		if( ewf_test_single_file_name_index_append_sub_node(
+		     *root_node,
+		     (uint8_t *) name,
+		     narrow_string_length( name ) + 1,
+		     &( sub_nodes[ file_index ] ),
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( ewf_test_single_file_name_index_append_sub_node(
+	     *root_node,
+	     ewf_test_single_file_name_index_utf8_cafe,
+	     6,
+	     &( sub_nodes[ file_index++ ] ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_single_file_name_index_append_sub_node(
+	     *root_node,
+	     ewf_test_single_file_name_index_utf8_smiley,
+	     9,
+	     &( sub_nodes[ file_index++ ] ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_single_file_name_index_append_sub_node(
+	     *root_node,
+	     NULL,
+	     0,
+	     &( sub_nodes[ file_index++ ] ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_single_file_name_index_append_sub_node(
+	     *root_node,
+	     (uint8_t *) "file0007",
+	     9,
+	     &( sub_nodes[ file_index ] ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Looks up the names of all files by UTF-8 and UTF-16 name
+ * Returns 1 if all sub nodes were found or 0 if not
+ */
+int ewf_test_single_file_name_index_lookup_files(
+     libewf_single_file_name_index_t *name_index,
+     libcdata_tree_node_t **sub_nodes,
+     libcerror_error_t **error )
+{
+	uint16_t utf16_name[ 16 ];
+	char name[ 16 ];
+
+	libcdata_tree_node_t *sub_node = NULL;
+	size_t name_index_value        = 0;
+	int file_index                 = 0;
+	int result                     = 0;
+
+	for( file_index = 0;
+	     file_index < EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_FILES;
+	     file_index++ )
+	{
+		snprintf(
+		 name,
+		 16,
+		 "file%04d",
+		 file_index );
+
+		result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+		          name_index,
+		          (uint8_t *) name,
+		          8,
+		          &sub_node,
+		          error );
+
+		if( ( result != 1 )
+		 || ( sub_node != sub_nodes[ file_index ] ) )
+		{
+			return( 0 );
+		}
+		for( name_index_value = 0;
+		     name_index_value < 8;
+		     name_index_value++ )
+		{
+			utf16_name[ name_index_value ] = (uint16_t) name[ name_index_value ];
+		}
+		result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+		          name_index,
+		          utf16_name,
+		          8,
+		          &sub_node,
+		          error );
+
+		if( ( result != 1 )
+		 || ( sub_node != sub_nodes[ file_index ] ) )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Looks up the names of all files from a thread
+ * Returns 1
+ */
+int ewf_test_single_file_name_index_lookup_callback(
+     ewf_test_single_file_name_index_thread_values_t *thread_values )
+{
+	int iteration = 0;
+
+	for( iteration = 0;
+	     iteration < 8;
+	     iteration++ )
+	{
+		if( ewf_test_single_file_name_index_lookup_files(
+		     thread_values->name_index,
+		     thread_values->sub_nodes,
+		     NULL ) != 1 )
+		{
+			thread_values->has_error = 1;
+
+			break;
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the libewf_single_file_name_index_get_sub_node_by_utf8_name function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_get_sub_node_by_utf8_name(
+     void )
+{
+	libcdata_tree_node_t *sub_nodes[ EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_SUB_NODES ];
+
+	const char *missing_names[ 4 ] = {
+		"file1000", "File0001", "file000", "caf" };
+
+	libcdata_tree_node_t *root_node                   = NULL;
+	libcdata_tree_node_t *scanned_sub_node            = NULL;
+	libcdata_tree_node_t *sub_node                    = NULL;
+	libcerror_error_t *error                          = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libewf_single_file_name_index_t *name_index       = NULL;
+	int name_index_value                              = 0;
+	int result                                        = 0;
+
+	result = ewf_test_single_file_name_index_create_tree(
+	          &root_node,
+	          sub_nodes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "name_index",
+	 name_index );
+
+	/* Test the files, the sub node of a duplicate name is the first one
+	 */
+	result = ewf_test_single_file_name_index_lookup_files(
+	          name_index,
+	          sub_nodes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test names with characters outside the ASCII range
+	 */
+	result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+	          name_index,
+	          ewf_test_single_file_name_index_utf8_cafe,
+	          5,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "sub_node",
+	 (int) ( sub_node == sub_nodes[ EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_FILES ] ),
+	 1 );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+	          name_index,
+	          ewf_test_single_file_name_index_utf8_smiley,
+	          8,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "sub_node",
+	 (int) ( sub_node == sub_nodes[ EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_FILES + 1 ] ),
+	 1 );
+
+	/* Test names that are not in the index, matching is case-sensitive
+	 * as by libewf_single_file_tree_get_sub_node_by_utf8_name
+	 */
+	for( name_index_value = 0;
+	     name_index_value < 4;
+	     name_index_value++ )
+	{
+		result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+		          name_index,
+		          (uint8_t *) missing_names[ name_index_value ],
+		          narrow_string_length( missing_names[ name_index_value ] ),
+		          &sub_node,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+		          NULL,
+		          root_node,
+		          (uint8_t *) missing_names[ name_index_value ],
+		          narrow_string_length( missing_names[ name_index_value ] ),
+		          &scanned_sub_node,
+		          &sub_single_file_entry,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test that the index finds the same sub node as scanning the sub nodes
+	 */
+	result = libewf_single_file_tree_get_sub_node_by_utf8_name(
+	          NULL,
+	          root_node,
+	          (uint8_t *) "file0007",
+	          8,
+	          &scanned_sub_node,
+	          &sub_single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+	          name_index,
+	          (uint8_t *) "file0007",
+	          8,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "sub_node",
+	 (int) ( sub_node == scanned_sub_node ),
+	 1 );
+
+	/* Clean up
+	 */
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 &name_index,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_file_name_index_get_sub_node_by_utf16_name function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_get_sub_node_by_utf16_name(
+     void )
+{
+	libcdata_tree_node_t *sub_nodes[ EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_SUB_NODES ];
+
+	uint16_t utf16_cafe_with_e[ 4 ] = {
+		'c', 'a', 'f', 'e' };
+
+	libcdata_tree_node_t *root_node                   = NULL;
+	libcdata_tree_node_t *scanned_sub_node            = NULL;
+	libcdata_tree_node_t *sub_node                    = NULL;
+	libcerror_error_t *error                          = NULL;
+	libewf_single_file_entry_t *sub_single_file_entry = NULL;
+	libewf_single_file_name_index_t *name_index       = NULL;
+	int result                                        = 0;
+	int scanned_result                                = 0;
+
+	result = ewf_test_single_file_name_index_create_tree(
+	          &root_node,
+	          sub_nodes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test a name with a character outside the ASCII range
+	 */
+	result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+	          name_index,
+	          ewf_test_single_file_name_index_utf16_cafe,
+	          4,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "sub_node",
+	 (int) ( sub_node == sub_nodes[ EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_FILES ] ),
+	 1 );
+
+	/* Test a name with a surrogate pair, including the end-of-string character,
+	 * the index must find the same sub node as scanning the sub nodes
+	 */
+	result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+	          name_index,
+	          ewf_test_single_file_name_index_utf16_smiley,
+	          7,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	scanned_result = libewf_single_file_tree_get_sub_node_by_utf16_name(
+	                  NULL,
+	                  root_node,
+	                  ewf_test_single_file_name_index_utf16_smiley,
+	                  7,
+	                  &scanned_sub_node,
+	                  &sub_single_file_entry,
+	                  &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 scanned_result );
+
+	if( result == 1 )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "sub_node",
+		 (int) ( sub_node == scanned_sub_node ),
+		 1 );
+	}
+	/* Test a name that is not in the index
+	 */
+	result = libewf_single_file_name_index_get_sub_node_by_utf16_name(
+	          name_index,
+	          utf16_cafe_with_e,
+	          4,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 &name_index,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests a name index of a node without sub nodes
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_empty(
+     void )
+{
+	libcdata_tree_node_t *root_node               = NULL;
+	libcdata_tree_node_t *sub_node                = NULL;
+	libcerror_error_t *error                      = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libewf_single_file_name_index_t *name_index   = NULL;
+	int result                                    = 0;
+
+	result = libewf_single_file_entry_initialize(
+	          &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_initialize(
+	          &root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_set_value(
+	          root_node,
+	          (intptr_t *) single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	single_file_entry = NULL;
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_file_name_index_get_sub_node_by_utf8_name(
+	          name_index,
+	          (uint8_t *) "file0000",
+	          8,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 &name_index,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	if( single_file_entry != NULL )
+	{
+		libewf_single_file_entry_free(
+		 &single_file_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests looking up names from concurrent threads
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_file_name_index_concurrent_lookups(
+     void )
+{
+	libcdata_tree_node_t *sub_nodes[ EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_SUB_NODES ];
+	ewf_test_single_file_name_index_thread_values_t thread_values[ EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_THREADS ];
+	libcthreads_thread_t *threads[ EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_THREADS ];
+
+	libcdata_tree_node_t *root_node             = NULL;
+	libcerror_error_t *error                    = NULL;
+	libewf_single_file_name_index_t *name_index = NULL;
+	int result                                  = 0;
+	int thread_index                            = 0;
+
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		threads[ thread_index ] = NULL;
+	}
+	result = ewf_test_single_file_name_index_create_tree(
+	          &root_node,
+	          sub_nodes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_file_name_index_initialize(
+	          &name_index,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		thread_values[ thread_index ].name_index = name_index;
+		thread_values[ thread_index ].sub_nodes  = sub_nodes;
+		thread_values[ thread_index ].has_error  = 0;
+
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          (int (*)(void *)) &ewf_test_single_file_name_index_lookup_callback,
+		          (void *) &( thread_values[ thread_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( threads[ thread_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "has_error",
+		 thread_values[ thread_index ].has_error,
+		 0 );
+	}
+	/* Clean up
+	 */
+	result = libewf_single_file_name_index_free(
+	          &name_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( thread_index = 0;
+	     thread_index < EWF_TEST_SINGLE_FILE_NAME_INDEX_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		if( threads[ thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ thread_index ] ),
+			 NULL );
+		}
+	}
+	if( name_index != NULL )
+	{
+		libewf_single_file_name_index_free(
+		 &name_index,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_single_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index_get_sub_node_by_utf8_name",
+	 ewf_test_single_file_name_index_get_sub_node_by_utf8_name );
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index_get_sub_node_by_utf16_name",
+	 ewf_test_single_file_name_index_get_sub_node_by_utf16_name );
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index empty",
+	 ewf_test_single_file_name_index_empty );
+
+	EWF_TEST_RUN(
+	 "libewf_single_file_name_index concurrent lookups",
+	 ewf_test_single_file_name_index_concurrent_lookups );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,926 @@
+/*
+ * Single files testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libcerror_error.h>
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_single_file_entry.h"
+#include "../libewf/libewf_single_files.h"
+
+#include "ewf_test_ltree.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+/* The EnCase 5 ltree, of which the data offset ("be") is the 20th value
+ */
+static const char *ewf_test_single_files_encase5_ltree = \
+	"5\n"
+	"rec\n"
+	"tb\tcl\n"
+	"1048576\t1\n"
+	"\n"
+	"perm\n"
+	"1\t1\n"
+	"p\tn\ts\n"
+	"0\t0\n"
+	"\n"
+	"entry\n"
+	"0\t1\n"
+	"p\tn\tid\topr\tsrc\tsub\tcid\tjq\tcr\tac\twr\tmo\tdl\tls\tdu\tlo\tpo\tha\tsha\tbe\n"
+	"0\t2\n"
+	"1\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\n"
+	"0\t3\n"
+	"1\tDocuments\t2\t0\t\t\t\t\t1500000000\t1500000100\t1500000200\t1500000300\t\t\t\t\t\t\t\t\n"
+	"0\t0\n"
+	"\tcaf\xc3\xa9.txt\t3\t4\t1\t1\t0\t\t1500000001\t1500000101\t1500000201\t1500000301\t\t1234\t\t\t\t"
+	"0123456789ABCDEF0123456789abcdef\tda39a3ee5e6b4b0d3255bfef95601890afd80709\t1 0 4d2\n"
+	"0\t0\n"
+	"\t\xe4\xb8\xad\xf0\x9f\x98\x80\t4\t\t\t\t\t\t\t\t\t\t\t0\t\t\t\t00000000000000000000000000000000\t\t0\n"
+	"0\t0\n"
+	"1\tEmpty\t5\t1\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\n"
+	"0\t1\n"
+	"1\tNested\t6\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\n"
+	"0\t1\n"
+	"1\tLevel2\t7\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\n"
+	"0\t0\n"
+	"\tduplicate.bin\t8\t\t\t\t\t\t\t\t\t\t\t1234\t1234\n"
+	"\n";
+
+/* The EnCase 7 ltree, of which the data offset ("be") is the 3rd value
+ */
+static const char *ewf_test_single_files_encase7_ltree = \
+	"5\n"
+	"rec\n"
+	"tb\tcl\n"
+	"4096\t1\n"
+	"\n"
+	"entry\n"
+	"0\t1\n"
+	"p\tn\tbe\tls\tha\tsha\n"
+	"0\t1\n"
+	"1\t\t\t\t\t\n"
+	"0\t0\n"
+	"\tfile.txt\t1 200 10\t16\t\tDA39A3EE5E6B4B0D3255BFEF95601890AFD80709\n"
+	"\n";
+
+/* The ltree of which the root claims more sub entries than there are lines
+ */
+static const char *ewf_test_single_files_truncated_ltree = \
+	"5\n"
+	"rec\n"
+	"tb\tcl\n"
+	"4096\t1\n"
+	"\n"
+	"entry\n"
+	"0\t1\n"
+	"p\tn\tls\n"
+	"0\t3\n"
+	"1\t\t\n"
+	"0\t0\n"
+	"\tfile.txt\t16\n"
+	"\n";
+
+/* Calculates a 64-bit FNV-1a digest of data
+ * Returns the updated digest
+ */
+uint64_t ewf_test_single_files_digest_data(
+          uint64_t digest,
+          const uint8_t *data,
+          size_t data_size )
+{
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		digest ^= data[ data_offset ];
+		digest *= 0x00000100000001b3ULL;
+	}
+	return( digest );
+}
+
+/* Calculates a 64-bit FNV-1a digest of a value stored as 64-bit little-endian
+ * Returns the updated digest
+ */
+uint64_t ewf_test_single_files_digest_value(
+          uint64_t digest,
+          uint64_t value )
+{
+	uint8_t value_data[ 8 ];
+
+	byte_stream_copy_from_uint64_little_endian(
+	 value_data,
+	 value );
+
+	return( ewf_test_single_files_digest_data(
+	         digest,
+	         value_data,
+	         8 ) );
+}
+
+/* Calculates a digest of the single file entries of a tree in depth-first order
+ * The digest covers every value that is set by the ltree parser
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_digest_tree(
+     libcdata_tree_node_t *node,
+     int depth,
+     uint64_t *digest,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node                = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	int number_of_sub_nodes                       = 0;
+	int sub_node_index                            = 0;
+
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &single_file_entry,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( single_file_entry == NULL )
+	{
+		return( -1 );
+	}
+	if( libcdata_tree_node_get_number_of_sub_nodes(
+	     node,
+	     &number_of_sub_nodes,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) depth );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) number_of_sub_nodes );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->type );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->flags );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->data_offset );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->data_size );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->name_size );
+
+	if( single_file_entry->name != NULL )
+	{
+		*digest = ewf_test_single_files_digest_data(
+		           *digest,
+		           single_file_entry->name,
+		           single_file_entry->name_size );
+	}
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->size );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->duplicate_data_offset );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->creation_time );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->modification_time );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->access_time );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->entry_modification_time );
+
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->md5_hash_size );
+
+	if( single_file_entry->md5_hash_size > 0 )
+	{
+		*digest = ewf_test_single_files_digest_data(
+		           *digest,
+		           single_file_entry->md5_hash,
+		           single_file_entry->md5_hash_size );
+	}
+	*digest = ewf_test_single_files_digest_value(
+	           *digest,
+	           (uint64_t) single_file_entry->sha1_hash_size );
+
+	if( single_file_entry->sha1_hash_size > 0 )
+	{
+		*digest = ewf_test_single_files_digest_data(
+		           *digest,
+		           single_file_entry->sha1_hash,
+		           single_file_entry->sha1_hash_size );
+	}
+	if( number_of_sub_nodes > 0 )
+	{
+		if( libcdata_tree_node_get_sub_node_by_index(
+		     node,
+		     0,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	for( sub_node_index = 0;
+	     sub_node_index < number_of_sub_nodes;
+	     sub_node_index++ )
+	{
+		if( ewf_test_single_files_digest_tree(
+		     sub_node,
+		     depth + 1,
+		     digest,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		if( libcdata_tree_node_get_next_node(
+		     sub_node,
+		     &sub_node,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Creates single files of ltree data
+ * The single files take over management of the ltree data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_initialize_from_ltree_data(
+     libewf_single_files_t **single_files,
+     uint8_t *ltree_data,
+     size_t ltree_data_size,
+     libcerror_error_t **error )
+{
+	if( libewf_single_files_initialize(
+	     single_files,
+	     error ) != 1 )
+	{
+		memory_free(
+		 ltree_data );
+
+		return( -1 );
+	}
+	( *single_files )->section_data      = ltree_data;
+	( *single_files )->section_data_size = ltree_data_size;
+	( *single_files )->ltree_data        = ltree_data;
+	( *single_files )->ltree_data_size   = ltree_data_size;
+
+	return( 1 );
+}
+
+/* Creates single files of an UTF-8 ltree string
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_initialize_from_string(
+     libewf_single_files_t **single_files,
+     const char *ltree_string,
+     uint8_t use_carriage_return,
+     libcerror_error_t **error )
+{
+	uint8_t *ltree_data    = NULL;
+	size_t ltree_data_size = 0;
+
+	ewf_test_ltree_append_utf8_string(
+	 NULL,
+	 &ltree_data_size,
+	 ltree_string,
+	 use_carriage_return );
+
+	ewf_test_ltree_append_value(
+	 NULL,
+	 &ltree_data_size,
+	 0 );
+
+	ltree_data = (uint8_t *) memory_allocate(
+	                          ltree_data_size );
+
+	if( ltree_data == NULL )
+	{
+		return( -1 );
+	}
+	ltree_data_size = 0;
+
+	ewf_test_ltree_append_utf8_string(
+	 ltree_data,
+	 &ltree_data_size,
+	 ltree_string,
+	 use_carriage_return );
+
+	/* The end-of-string character
+	 */
+	ewf_test_ltree_append_value(
+	 ltree_data,
+	 &ltree_data_size,
+	 0 );
+
+	return( ewf_test_single_files_initialize_from_ltree_data(
+	         single_files,
+	         ltree_data,
+	         ltree_data_size,
+	         error ) );
+}
+
+/* Creates single files of a generated ltree
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_single_files_initialize_from_generated(
+     libewf_single_files_t **single_files,
+     int number_of_directories,
+     int number_of_files,
+     libcerror_error_t **error )
+{
+	uint8_t *ltree_data    = NULL;
+	size_t ltree_data_size = 0;
+
+	ewf_test_ltree_generate(
+	 NULL,
+	 &ltree_data_size,
+	 number_of_directories,
+	 number_of_files );
+
+	ltree_data = (uint8_t *) memory_allocate(
+	                          ltree_data_size );
+
+	if( ltree_data == NULL )
+	{
+		return( -1 );
+	}
+	ewf_test_ltree_generate(
+	 ltree_data,
+	 &ltree_data_size,
+	 number_of_directories,
+	 number_of_files );
+
+	return( ewf_test_single_files_initialize_from_ltree_data(
+	         single_files,
+	         ltree_data,
+	         ltree_data_size,
+	         error ) );
+}
+
+/* Parses single files and compares the result with the expected values
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_parse_and_compare(
+     libewf_single_files_t *single_files,
+     int expected_result,
+     size64_t expected_media_size,
+     uint8_t expected_format,
+     uint64_t expected_digest )
+{
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	uint64_t digest          = 0xcbf29ce484222325ULL;
+	uint8_t format           = 0;
+	int result               = 0;
+
+	result = libewf_single_files_parse(
+	          single_files,
+	          &media_size,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 expected_result );
+
+	if( result != 1 )
+	{
+		libcerror_error_free(
+		 &error );
+
+		return( 1 );
+	}
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "media_size",
+	 media_size,
+	 expected_media_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "format",
+	 (int) format,
+	 (int) expected_format );
+
+	result = ewf_test_single_files_digest_tree(
+	          single_files->root_file_entry_node,
+	          0,
+	          &digest,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "digest",
+	 digest,
+	 expected_digest );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_single_files_parse function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_parse(
+     void )
+{
+	libcdata_tree_node_t *node                    = NULL;
+	libcerror_error_t *error                      = NULL;
+	libewf_single_file_entry_t *single_file_entry = NULL;
+	libewf_single_files_t *single_files           = NULL;
+	size64_t media_size                           = 0;
+	uint8_t format                                = 0;
+	int number_of_sub_nodes                       = 0;
+	int result                                    = 0;
+
+	result = ewf_test_single_files_initialize_from_string(
+	          &single_files,
+	          ewf_test_single_files_encase5_ltree,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_files_parse(
+	          single_files,
+	          &media_size,
+	          &format,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "media_size",
+	 media_size,
+	 (uint64_t) 1048576 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "format",
+	 (int) format,
+	 LIBEWF_FORMAT_LOGICAL_ENCASE5 );
+
+	result = libcdata_tree_node_get_number_of_sub_nodes(
+	          single_files->root_file_entry_node,
+	          &number_of_sub_nodes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_sub_nodes",
+	 number_of_sub_nodes,
+	 2 );
+
+	/* Test the values of: Documents/café.txt
+	 */
+	result = libcdata_tree_node_get_sub_node_by_index(
+	          single_files->root_file_entry_node,
+	          0,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_get_sub_node_by_index(
+	          node,
+	          0,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_get_value(
+	          node,
+	          (intptr_t **) &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "single_file_entry",
+	 single_file_entry );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->type",
+	 (int) single_file_entry->type,
+	 LIBEWF_FILE_ENTRY_TYPE_FILE );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "single_file_entry->name_size",
+	 single_file_entry->name_size,
+	 (size_t) 10 );
+
+	result = memory_compare(
+	          single_file_entry->name,
+	          "caf\xc3\xa9.txt",
+	          10 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "single_file_entry->data_size",
+	 single_file_entry->data_size,
+	 (int64_t) 0x4d2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "single_file_entry->size",
+	 single_file_entry->size,
+	 (int64_t) 1234 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "single_file_entry->flags",
+	 (int) single_file_entry->flags,
+	 4 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "single_file_entry->modification_time",
+	 single_file_entry->modification_time,
+	 (int64_t) 1500000201 );
+
+	/* The MD5 hash is stored in lower case
+	 */
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "single_file_entry->md5_hash_size",
+	 single_file_entry->md5_hash_size,
+	 (size_t) 33 );
+
+	result = memory_compare(
+	          single_file_entry->md5_hash,
+	          "0123456789abcdef0123456789abcdef",
+	          33 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "single_file_entry->sha1_hash_size",
+	 single_file_entry->sha1_hash_size,
+	 (size_t) 41 );
+
+	/* Test the values of the next file, of which the MD5 hash only contains zero values
+	 */
+	result = libcdata_tree_node_get_next_node(
+	          node,
+	          &node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcdata_tree_node_get_value(
+	          node,
+	          (intptr_t **) &single_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "single_file_entry->md5_hash_size",
+	 single_file_entry->md5_hash_size,
+	 (size_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "single_file_entry->sha1_hash_size",
+	 single_file_entry->sha1_hash_size,
+	 (size_t) 0 );
+
+	/* Clean up
+	 */
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that libewf_single_files_parse creates the same tree as the previous parser
+ * The expected digests were calculated with the parser that converted the entire
+ * ltree into one UTF-8 string and split it into lines and values with libfvalue
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_single_files_parse_previous_parser(
+     void )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_single_files_t *single_files = NULL;
+	int result                          = 0;
+
+	/* Test the EnCase 5 ltree
+	 */
+	result = ewf_test_single_files_initialize_from_string(
+	          &single_files,
+	          ewf_test_single_files_encase5_ltree,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_single_files_parse_and_compare(
+	          single_files,
+	          1,
+	          1048576,
+	          LIBEWF_FORMAT_LOGICAL_ENCASE5,
+	          0x3a34437951d2fdd1ULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test the EnCase 5 ltree with carriage return and line feed end-of-lines
+	 * The previous parser does not find the "rec" line, which ends with a carriage return
+	 */
+	result = ewf_test_single_files_initialize_from_string(
+	          &single_files,
+	          ewf_test_single_files_encase5_ltree,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_single_files_parse_and_compare(
+	          single_files,
+	          -1,
+	          0,
+	          0,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test the EnCase 7 ltree
+	 */
+	result = ewf_test_single_files_initialize_from_string(
+	          &single_files,
+	          ewf_test_single_files_encase7_ltree,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_single_files_parse_and_compare(
+	          single_files,
+	          1,
+	          4096,
+	          LIBEWF_FORMAT_LOGICAL_ENCASE7,
+	          0x1c26aa3923b3e077ULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test the generated ltree
+	 */
+	result = ewf_test_single_files_initialize_from_generated(
+	          &single_files,
+	          7,
+	          50,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_single_files_parse_and_compare(
+	          single_files,
+	          1,
+	          EWF_TEST_LTREE_MEDIA_SIZE,
+	          0,
+	          0x0aa9c0ee1518ff49ULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test the ltree with more sub entries than lines
+	 */
+	result = ewf_test_single_files_initialize_from_string(
+	          &single_files,
+	          ewf_test_single_files_truncated_ltree,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_single_files_parse_and_compare(
+	          single_files,
+	          -1,
+	          0,
+	          0,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_single_files_free(
+	          &single_files,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( single_files != NULL )
+	{
+		libewf_single_files_free(
+		 &single_files,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_single_files_parse",
+	 ewf_test_single_files_parse );
+
+	EWF_TEST_RUN(
+	 "libewf_single_files_parse previous parser",
+	 ewf_test_single_files_parse_previous_parser );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
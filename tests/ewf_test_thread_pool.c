@@ -0,0 +1,213 @@
+/*
+ * Thread pool testing program
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <libcthreads_definitions.h>
+#include <libcthreads_thread_pool.h>
+
+#include <libcerror_error.h>
+
+#include "ewf_bench_timer.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#define EWF_TEST_THREAD_POOL_NUMBER_OF_THREADS	4
+
+typedef struct ewf_test_thread_pool_job ewf_test_thread_pool_job_t;
+
+struct ewf_test_thread_pool_job
+{
+	/* The duration of the job in micro seconds
+	 */
+	useconds_t duration;
+
+	/* The time the job was finished
+	 */
+	double finish_time;
+};
+
+/* Runs a job
+ * Returns 1
+ */
+int ewf_test_thread_pool_callback(
+     ewf_test_thread_pool_job_t *job,
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	usleep(
+	 job->duration );
+
+	job->finish_time = ewf_bench_timer_get_seconds();
+
+	return( 1 );
+}
+
+/* Tests if an idle thread takes over a value that was pushed onto the values ring of a busy thread
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_thread_pool_work_stealing_idle_threads(
+     void )
+{
+	ewf_test_thread_pool_job_t jobs[ EWF_TEST_THREAD_POOL_NUMBER_OF_THREADS + 1 ];
+
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int is_finished                        = 0;
+	int job_index                          = 0;
+	int result                             = 0;
+
+	/* The first job keeps its thread busy for 2 seconds, the other threads
+	 * finish their job and become idle. The last job is pushed onto the
+	 * values ring of the busy thread, since the values are handed out
+	 * round robin
+	 */
+	for( job_index = 0;
+	     job_index <= EWF_TEST_THREAD_POOL_NUMBER_OF_THREADS;
+	     job_index++ )
+	{
+		jobs[ job_index ].duration    = 1000;
+		jobs[ job_index ].finish_time = 0.0;
+	}
+	jobs[ 0 ].duration = 2000000;
+
+	result = libcthreads_thread_pool_create_with_flags(
+	          &thread_pool,
+	          NULL,
+	          EWF_TEST_THREAD_POOL_NUMBER_OF_THREADS,
+	          64,
+	          (int (*)(intptr_t *, void *)) &ewf_test_thread_pool_callback,
+	          NULL,
+	          LIBCTHREADS_THREAD_POOL_FLAG_WORK_STEALING,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Give the threads time to start and become idle, so that the first
+	 * job is taken by the thread that owns the values ring it is pushed onto
+	 */
+	usleep(
+	 200000 );
+
+	for( job_index = 0;
+	     job_index < EWF_TEST_THREAD_POOL_NUMBER_OF_THREADS;
+	     job_index++ )
+	{
+		result = libcthreads_thread_pool_push(
+		          thread_pool,
+		          (intptr_t *) &( jobs[ job_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* Give the other threads time to finish their job and become idle
+	 */
+	usleep(
+	 200000 );
+
+	result = libcthreads_thread_pool_push(
+	          thread_pool,
+	          (intptr_t *) &( jobs[ EWF_TEST_THREAD_POOL_NUMBER_OF_THREADS ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The last job must be finished by an idle thread while the busy thread
+	 * is still running, before join closes the values rings
+	 */
+	usleep(
+	 500000 );
+
+	is_finished = ( jobs[ EWF_TEST_THREAD_POOL_NUMBER_OF_THREADS ].finish_time != 0.0 );
+
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "is_finished",
+	 is_finished,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libcthreads_thread_pool_pop with idle threads and work stealing",
+	 ewf_test_thread_pool_work_stealing_idle_threads );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,457 @@
+/*
+ * Tests the flush boundaries of the chunk data write buffer
+ *
+ * Copyright (C) 2006-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <libbfio_definitions.h>
+#include <libbfio_handle.h>
+#include <libbfio_memory_range.h>
+#include <libbfio_pool.h>
+
+#include <libcerror_error.h>
+
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_write_buffer.h"
+
+/* The size of the write buffer, which is kept small to test the flush boundaries
+ */
+#define EWF_TEST_WRITE_BUFFER_SIZE	64
+
+/* The size of the memory range of a file IO pool entry
+ */
+#define EWF_TEST_WRITE_BUFFER_RANGE_SIZE	256
+
+typedef struct ewf_test_write_buffer_write_step ewf_test_write_buffer_write_step_t;
+
+struct ewf_test_write_buffer_write_step
+{
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The size of the data that is written
+	 */
+	size_t write_size;
+
+	/* The expected number of writes issued to the file IO pool after the write
+	 */
+	uint64_t number_of_writes;
+
+	/* The expected number of bytes written to the file IO pool after the write
+	 */
+	uint64_t number_of_bytes_written;
+};
+
+/* Checks the write counters of the write buffer
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_buffer_check_counters(
+     libewf_write_buffer_t *write_buffer,
+     uint64_t expected_number_of_writes,
+     uint64_t expected_number_of_bytes_written )
+{
+	libcerror_error_t *error         = NULL;
+	uint64_t number_of_bytes_written = 0;
+	uint64_t number_of_writes        = 0;
+	int result                       = 0;
+
+	result = libewf_write_buffer_get_number_of_writes(
+	          write_buffer,
+	          &number_of_writes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "number_of_writes",
+	 (int64_t) number_of_writes,
+	 (int64_t) expected_number_of_writes );
+
+	result = libewf_write_buffer_get_number_of_bytes_written(
+	          write_buffer,
+	          &number_of_bytes_written,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "number_of_bytes_written",
+	 (int64_t) number_of_bytes_written,
+	 (int64_t) expected_number_of_bytes_written );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests if the pending data is written when the write buffer is full, the file IO pool entry
+ * changes, a buffer is not smaller than the write buffer or the write buffer is flushed
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_buffer_flush_boundaries(
+     void )
+{
+	ewf_test_write_buffer_write_step_t write_steps[ 10 ] = {
+		/* The pending data fits in the write buffer
+		 */
+		{ 0, 20, 0, 0 },
+		{ 0, 20, 0, 0 },
+		{ 0, 20, 0, 0 },
+		/* The pending 60 bytes are written since 10 bytes do not fit
+		 */
+		{ 0, 10, 1, 60 },
+		/* The pending 10 bytes are written since the file IO pool entry changes
+		 */
+		{ 1, 5, 2, 70 },
+		/* The pending 5 bytes are written followed by the buffer that is not
+		 * smaller than the write buffer, without it being copied
+		 */
+		{ 1, 64, 4, 139 },
+		/* The pending data fills the write buffer exactly
+		 */
+		{ 0, 60, 4, 139 },
+		{ 0, 4, 4, 139 },
+		/* The full write buffer is written since 1 byte does not fit
+		 */
+		{ 0, 1, 5, 203 },
+		{ 0, 2, 5, 203 } };
+
+	uint8_t expected_data[ 2 ][ EWF_TEST_WRITE_BUFFER_RANGE_SIZE ];
+	uint8_t range_data[ 2 ][ EWF_TEST_WRITE_BUFFER_RANGE_SIZE ];
+	uint8_t write_data[ EWF_TEST_WRITE_BUFFER_RANGE_SIZE ];
+	size_t range_offsets[ 2 ]                      = { 0, 0 };
+
+	libbfio_handle_t *file_io_handle               = NULL;
+	libbfio_pool_t *file_io_pool                   = NULL;
+	libcerror_error_t *error                       = NULL;
+	libewf_write_buffer_t *write_buffer            = NULL;
+	ewf_test_write_buffer_write_step_t *write_step = NULL;
+	ssize_t write_count                            = 0;
+	size_t data_index                              = 0;
+	int entry                                      = 0;
+	int entry_index                                = 0;
+	int result                                     = 0;
+	int step_index                                 = 0;
+	uint8_t byte_value                             = 0;
+
+	if( memory_set(
+	     range_data,
+	     0,
+	     sizeof( range_data ) ) == NULL )
+	{
+		goto on_error;
+	}
+	if( memory_set(
+	     expected_data,
+	     0,
+	     sizeof( expected_data ) ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libbfio_pool_initialize(
+	          &file_io_pool,
+	          0,
+	          LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( entry_index = 0;
+	     entry_index < 2;
+	     entry_index++ )
+	{
+		result = libbfio_memory_range_initialize(
+		          &file_io_handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libbfio_memory_range_set(
+		          file_io_handle,
+		          range_data[ entry_index ],
+		          EWF_TEST_WRITE_BUFFER_RANGE_SIZE,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libbfio_pool_append_handle(
+		          file_io_pool,
+		          &entry,
+		          file_io_handle,
+		          LIBBFIO_OPEN_WRITE,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		file_io_handle = NULL;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "entry",
+		 entry,
+		 entry_index );
+	}
+	result = libewf_write_buffer_initialize(
+	          &write_buffer,
+	          EWF_TEST_WRITE_BUFFER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( step_index = 0;
+	     step_index < 10;
+	     step_index++ )
+	{
+		write_step = &( write_steps[ step_index ] );
+
+		for( data_index = 0;
+		     data_index < write_step->write_size;
+		     data_index++ )
+		{
+			write_data[ data_index ] = byte_value;
+
+			expected_data[ write_step->file_io_pool_entry ][ range_offsets[ write_step->file_io_pool_entry ] + data_index ] = byte_value;
+
+			byte_value++;
+		}
+		range_offsets[ write_step->file_io_pool_entry ] += write_step->write_size;
+
+		write_count = libewf_write_buffer_write(
+		               write_buffer,
+		               file_io_pool,
+		               write_step->file_io_pool_entry,
+		               write_data,
+		               write_step->write_size,
+		               &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) write_step->write_size );
+
+		result = ewf_test_write_buffer_check_counters(
+		          write_buffer,
+		          write_step->number_of_writes,
+		          write_step->number_of_bytes_written );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	/* The pending 3 bytes have not been written yet
+	 */
+	result = memory_compare(
+	          range_data[ 0 ],
+	          expected_data[ 0 ],
+	          range_offsets[ 0 ] - 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "range_data[ 0 ][ range_offsets[ 0 ] - 3 ]",
+	 (int) range_data[ 0 ][ range_offsets[ 0 ] - 3 ],
+	 0 );
+
+	write_count = libewf_write_buffer_flush(
+	               write_buffer,
+	               file_io_pool,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 3 );
+
+	result = ewf_test_write_buffer_check_counters(
+	          write_buffer,
+	          6,
+	          206 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* A flush without pending data does not write
+	 */
+	write_count = libewf_write_buffer_flush(
+	               write_buffer,
+	               file_io_pool,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 0 );
+
+	result = ewf_test_write_buffer_check_counters(
+	          write_buffer,
+	          6,
+	          206 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( entry_index = 0;
+	     entry_index < 2;
+	     entry_index++ )
+	{
+		result = memory_compare(
+		          range_data[ entry_index ],
+		          expected_data[ entry_index ],
+		          EWF_TEST_WRITE_BUFFER_RANGE_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "range_offsets[ 0 ]",
+	 range_offsets[ 0 ],
+	 (size_t) 137 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "range_offsets[ 1 ]",
+	 range_offsets[ 1 ],
+	 (size_t) 69 );
+
+	result = libewf_write_buffer_free(
+	          &write_buffer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbfio_pool_close_all(
+	          file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libbfio_pool_free(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_buffer != NULL )
+	{
+		libewf_write_buffer_free(
+		 &write_buffer,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "libewf_write_buffer_write flush boundaries",
+	 ewf_test_write_buffer_flush_boundaries );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}